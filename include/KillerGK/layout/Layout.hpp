@@ -143,6 +143,20 @@ public:
      */
     virtual Rect getChildBounds(size_t index) const = 0;
 
+    /**
+     * @brief Get the child widget at index
+     *
+     * Layouts that do not keep their widgets need not override this; hit
+     * testing skips children it returns nullptr for.
+     *
+     * @param index Child index
+     * @return The child, or nullptr if index is invalid
+     */
+    virtual Widget* getChild(size_t index) const {
+        (void)index;
+        return nullptr;
+    }
+
     /**
      * @brief Get number of children in this layout
      */
@@ -249,6 +263,7 @@ public:
     // ILayout interface
     Size layout(const LayoutConstraints& constraints) override;
     Rect getChildBounds(size_t index) const override;
+    Widget* getChild(size_t index) const override;
     size_t getChildCount() const override;
     void invalidate() override;
     bool needsLayout() const override;
@@ -295,6 +310,7 @@ public:
     // ILayout interface
     Size layout(const LayoutConstraints& constraints) override;
     Rect getChildBounds(size_t index) const override;
+    Widget* getChild(size_t index) const override;
     size_t getChildCount() const override;
     void invalidate() override;
     bool needsLayout() const override;
@@ -346,6 +362,7 @@ public:
     // ILayout interface
     Size layout(const LayoutConstraints& constraints) override;
     Rect getChildBounds(size_t index) const override;
+    Widget* getChild(size_t index) const override;
     size_t getChildCount() const override;
     void invalidate() override;
     bool needsLayout() const override;
@@ -377,6 +394,7 @@ public:
     // ILayout interface
     Size layout(const LayoutConstraints& constraints) override;
     Rect getChildBounds(size_t index) const override;
+    Widget* getChild(size_t index) const override;
     size_t getChildCount() const override;
     void invalidate() override;
     bool needsLayout() const override;
@@ -0,0 +1,65 @@
+/**
+ * @file BlockCodec.hpp
+ * @brief LZ block compression for KillerGK asset bundles
+ *
+ * A byte-oriented LZ77 codec using the LZ4 block layout: each sequence is a
+ * token (literal length, match length), the literals, and a 16-bit match
+ * offset. It favours decompression speed over ratio and needs no external
+ * dependency.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace KillerGK {
+
+/**
+ * @class BlockCodec
+ * @brief Stateless LZ block compressor/decompressor
+ *
+ * Blocks are independent: decompressing one never requires another, which
+ * lets bundles decode any block of an entry directly or in parallel.
+ */
+class BlockCodec {
+public:
+    /**
+     * @brief Default uncompressed block size used by asset bundles
+     *
+     * Matches the 64 KiB window reachable by a 16-bit match offset.
+     */
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    /**
+     * @brief Worst-case compressed size for an input of the given size
+     * @param srcSize Uncompressed size in bytes
+     * @return Buffer size that always fits the compressed output
+     */
+    static size_t compressBound(size_t srcSize);
+
+    /**
+     * @brief Compress a block
+     * @param src Uncompressed input
+     * @param srcSize Input size in bytes
+     * @param dst Output buffer
+     * @param dstCapacity Output buffer size in bytes
+     * @return Compressed size, or 0 if the output did not fit
+     */
+    static size_t compress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity);
+
+    /**
+     * @brief Decompress a block
+     *
+     * Malformed input is rejected rather than read or written out of bounds.
+     *
+     * @param src Compressed input
+     * @param srcSize Compressed size in bytes
+     * @param dst Output buffer
+     * @param dstSize Exact uncompressed size in bytes
+     * @return true if the block decoded to exactly dstSize bytes
+     */
+    static bool decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize);
+};
+
+} // namespace KillerGK
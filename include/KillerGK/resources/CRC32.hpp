@@ -0,0 +1,81 @@
+/**
+ * @file CRC32.hpp
+ * @brief CRC-32 checksums for KillerGK asset bundles
+ *
+ * Computes the standard (IEEE 802.3, reflected 0xEDB88320) CRC-32. The
+ * fastest implementation available on the running CPU is selected once at
+ * startup: carry-less multiply folding (x86 PCLMULQDQ), the ARMv8 CRC32
+ * instructions, or a portable slicing-by-8 table loop.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace KillerGK {
+
+/**
+ * @class CRC32
+ * @brief Runtime-dispatched CRC-32
+ *
+ * All backends produce identical results, so checksums written by one
+ * machine verify on any other.
+ */
+class CRC32 {
+public:
+    /**
+     * @brief CRC-32 implementations
+     */
+    enum class Backend {
+        Table,      ///< Byte-at-a-time table lookup (reference)
+        Slicing8,   ///< Eight bytes per step with eight tables (portable)
+        PCLMUL,     ///< x86 carry-less multiply folding
+        ARMv8       ///< ARMv8 CRC32 instructions
+    };
+
+    /**
+     * @brief Compute the CRC-32 of a buffer with the active backend
+     * @param data Input bytes
+     * @param size Input size in bytes
+     * @return Checksum
+     */
+    static uint32_t compute(const uint8_t* data, size_t size);
+
+    /**
+     * @brief Extend a checksum with more data
+     *
+     * update(compute(a), b) equals the checksum of a followed by b.
+     *
+     * @param crc Checksum of the preceding data (0 for none)
+     * @param data Input bytes
+     * @param size Input size in bytes
+     * @return Checksum of the combined data
+     */
+    static uint32_t update(uint32_t crc, const uint8_t* data, size_t size);
+
+    /**
+     * @brief Compute the CRC-32 with a specific backend
+     *
+     * Intended for tests and benchmarks. Unsupported backends fall back to
+     * Slicing8.
+     */
+    static uint32_t computeWith(Backend backend, const uint8_t* data, size_t size);
+
+    /**
+     * @brief Get the backend selected for this CPU
+     */
+    static Backend getActiveBackend();
+
+    /**
+     * @brief Check if a backend can run on this CPU
+     */
+    static bool isSupported(Backend backend);
+
+    /**
+     * @brief Get a display name for a backend
+     */
+    static const char* getBackendName(Backend backend);
+};
+
+} // namespace KillerGK
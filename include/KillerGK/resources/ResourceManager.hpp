@@ -12,15 +12,21 @@
 #include "../core/Error.hpp"
 #include "../rendering/Texture.hpp"
 #include "../text/Font.hpp"
+#include "BlockCodec.hpp"
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <list>
 #include <vector>
 #include <functional>
 #include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <queue>
 #include <atomic>
 #include <chrono>
 #include <filesystem>
+#include <span>
 
 namespace KillerGK {
 
@@ -202,7 +208,7 @@ using ResourceLoadCallback = std::function<void(const std::string& path, bool su
  */
 struct BundleHeader {
     char magic[4] = {'K', 'G', 'K', 'B'};  ///< Magic number "KGKB"
-    uint32_t version = 1;                   ///< Bundle format version
+    uint32_t version = 2;                   ///< Bundle format version
     uint32_t fileCount = 0;                 ///< Number of files in bundle
     uint64_t dataOffset = 0;                ///< Offset to file data
     uint64_t totalSize = 0;                 ///< Total bundle size
@@ -228,6 +234,70 @@ struct BundleEntry {
     uint64_t originalSize = 0;  ///< Original uncompressed size
     uint32_t checksum = 0;      ///< CRC32 checksum
     bool compressed = false;    ///< Whether data is compressed
+    uint32_t blockSize = 0;     ///< Uncompressed block size (version 2, compressed entries)
+    std::vector<uint32_t> blocks;  ///< Stored size of each block; high bit marks a raw block
+    bool verified = false;      ///< Checksum already checked (runtime state, not stored)
+    bool failed = false;        ///< Checksum already found not to match (runtime state, not stored)
+};
+
+/**
+ * @brief When bundle entries are checked against their CRC32
+ */
+enum class BundleVerification {
+    Always,         ///< Verify on every read
+    FirstAccess,    ///< Verify each entry once, on its first read
+    Never           ///< Trust the bundle contents
+};
+
+class AssetBundle;
+
+/**
+ * @class BundleData
+ * @brief Read-only bytes of a bundle entry
+ * 
+ * Uncompressed entries of a memory-mapped bundle point directly into the
+ * mapping; everything else owns its buffer. A view keeps the mapping
+ * alive, so it remains valid after the bundle is unmounted or edited.
+ * Move-only.
+ */
+class BundleData {
+public:
+    BundleData() = default;
+    
+    /**
+     * @brief Wrap an owned buffer
+     */
+    explicit BundleData(std::vector<uint8_t> bytes)
+        : m_owned(std::move(bytes)), m_view(m_owned) {}
+    
+    BundleData(BundleData&&) noexcept = default;
+    BundleData& operator=(BundleData&&) noexcept = default;
+    BundleData(const BundleData&) = delete;
+    BundleData& operator=(const BundleData&) = delete;
+    
+    [[nodiscard]] const uint8_t* data() const { return m_view.data(); }
+    [[nodiscard]] size_t size() const { return m_view.size(); }
+    [[nodiscard]] bool empty() const { return m_view.empty(); }
+    [[nodiscard]] std::span<const uint8_t> span() const { return m_view; }
+    
+    /**
+     * @brief Check if the bytes are borrowed from the bundle (no copy made)
+     */
+    [[nodiscard]] bool isZeroCopy() const { return m_mapping != nullptr && m_owned.empty(); }
+    
+    /**
+     * @brief Copy the bytes into a new vector
+     */
+    [[nodiscard]] std::vector<uint8_t> toVector() const {
+        return std::vector<uint8_t>(m_view.begin(), m_view.end());
+    }
+
+private:
+    friend class AssetBundle;
+    
+    std::shared_ptr<const void> m_mapping;        ///< Keeps a borrowed mapping alive
+    std::vector<uint8_t> m_owned;
+    std::span<const uint8_t> m_view;
 };
 
 /**
@@ -235,14 +305,24 @@ struct BundleEntry {
  * @brief Represents a packaged asset bundle
  * 
  * Asset bundles provide a way to package multiple resources into a single
- * archive file for efficient distribution and loading. The bundle format
- * supports optional compression using RLE (Run-Length Encoding) for
- * simple compression that works well with many asset types.
+ * archive file for efficient distribution and loading. Entries are
+ * optionally compressed with BlockCodec in independent fixed-size blocks,
+ * so a byte range can be read without decoding the whole entry. Entries
+ * are decoded outside the bundle's lock, so loader threads read several
+ * entries of one bundle at once.
  * 
  * Bundle Format (KGKB):
  * - Header: Magic number, version, file count, data offset, total size, flags
- * - Entry Table: For each file - path, offset, size, original size, checksum, compressed flag
+ * - Entry Table: For each file - path, offset, size, original size, checksum, compressed flag;
+ *   version 2 adds block size, block count and the stored size of each block
  * - Data Section: Raw or compressed file data
+ * 
+ * Version 1 bundles (whole-entry RLE compression) are still readable and
+ * are rewritten as version 2 by save().
+ * 
+ * Bundles can be read into memory (load) or memory-mapped (loadMapped).
+ * A mapped bundle parses its entry table on first use and serves
+ * uncompressed entries as views into the mapping via getView().
  */
 class AssetBundle {
 public:
@@ -255,6 +335,17 @@ public:
      */
     static std::shared_ptr<AssetBundle> load(const std::string& path);
     
+    /**
+     * @brief Memory-map a bundle file
+     * 
+     * Only the header is read up front; the entry table is parsed lazily.
+     * Falls back to load() where mapping is unavailable.
+     * 
+     * @param path Path to the bundle file
+     * @return Bundle handle or nullptr on failure
+     */
+    static std::shared_ptr<AssetBundle> loadMapped(const std::string& path);
+    
     /**
      * @brief Create a new empty bundle
      * @return New bundle handle
@@ -289,9 +380,11 @@ public:
      * @brief Save bundle to file
      * @param path Output file path
      * @param compress Whether to compress the data
+     * @param blockSize Uncompressed size of each compressed block
      * @return true if bundle was saved successfully
      */
-    bool save(const std::string& path, bool compress = true);
+    bool save(const std::string& path, bool compress = true,
+              size_t blockSize = BlockCodec::DEFAULT_BLOCK_SIZE);
     
     /**
      * @brief Check if bundle contains a file
@@ -307,6 +400,57 @@ public:
      */
     [[nodiscard]] std::vector<uint8_t> getData(const std::string& virtualPath) const;
     
+    /**
+     * @brief Get file data without copying when possible
+     * 
+     * Uncompressed entries are returned as a view into the bundle's storage
+     * (the mapping, for mapped bundles); compressed entries are decompressed
+     * into an owned buffer. Views of an in-memory bundle are invalidated by
+     * adding data to it.
+     * 
+     * @param virtualPath Virtual path of the file
+     * @return Entry bytes, empty if not found
+     */
+    [[nodiscard]] BundleData getView(const std::string& virtualPath) const;
+    
+    /**
+     * @brief Read part of a file from the bundle
+     * 
+     * Only the blocks covering the range are decompressed. The checksum
+     * covers whole files, so partial reads are not verified.
+     * 
+     * @param virtualPath Virtual path of the file
+     * @param offset Byte offset within the uncompressed file
+     * @param length Number of bytes to read (clamped to the file size)
+     * @return Range bytes, empty if not found or out of range
+     */
+    [[nodiscard]] BundleData getRange(const std::string& virtualPath, size_t offset, size_t length) const;
+    
+    /**
+     * @brief Check if the bundle is backed by a memory mapping
+     */
+    [[nodiscard]] bool isMapped() const { return m_mapping != nullptr; }
+    
+    /**
+     * @brief Set when entry checksums are verified
+     * 
+     * Defaults to FirstAccess, so loading a bundle costs nothing per entry
+     * and repeated reads of an entry are not re-hashed. Mismatches are
+     * logged as warnings; in FirstAccess mode once per entry.
+     */
+    void setVerification(BundleVerification mode);
+    
+    /**
+     * @brief Get the checksum verification mode
+     */
+    [[nodiscard]] BundleVerification getVerification() const;
+    
+    /**
+     * @brief Verify every entry not yet verified, regardless of mode
+     * @return true if all entries match their checksums
+     */
+    bool verifyAll() const;
+    
     /**
      * @brief Get list of all files in bundle
      * @return Vector of virtual paths
@@ -323,7 +467,7 @@ public:
      * @brief Get number of files in bundle
      * @return File count
      */
-    [[nodiscard]] size_t getFileCount() const { return m_entries.size(); }
+    [[nodiscard]] size_t getFileCount() const { return m_header.fileCount; }
     
     /**
      * @brief Get total uncompressed size of all files
@@ -335,7 +479,7 @@ public:
      * @brief Get compressed size of bundle data
      * @return Compressed size in bytes
      */
-    [[nodiscard]] size_t getCompressedSize() const { return m_data.size(); }
+    [[nodiscard]] size_t getCompressedSize() const { return dataSection().size(); }
     
     /**
      * @brief Check if bundle is compressed
@@ -371,14 +515,33 @@ private:
     AssetBundle() = default;
     
     // Compression utilities
-    static std::vector<uint8_t> compress(const std::vector<uint8_t>& data);
-    static std::vector<uint8_t> decompress(const std::vector<uint8_t>& data, size_t originalSize);
+    static std::vector<uint8_t> decompressLegacyRLE(std::span<const uint8_t> data, size_t originalSize);
+    static bool decompressBlocks(const BundleEntry& entry, std::span<const uint8_t> raw,
+                                 size_t firstBlock, size_t lastBlock, uint8_t* out);
     static uint32_t calculateCRC32(const std::vector<uint8_t>& data);
+    static uint32_t calculateCRC32(std::span<const uint8_t> data);
+    
+    struct MappedFile;
+    
+    bool parseEntryTable(std::span<const uint8_t> table) const;
+    bool ensureEntriesParsed() const;
+    std::span<const uint8_t> dataSection() const;
+    void detachMapping();
+    BundleData borrow(std::span<const uint8_t> bytes) const;
+    BundleData readEntry(BundleEntry& entry, bool forceVerify = false) const;
+    bool storedBytes(const BundleEntry& entry, BundleData& stored) const;
+    static bool isEncoded(const BundleEntry& entry);
+    static BundleData decodeEntry(const BundleEntry& entry, std::span<const uint8_t> raw);
+    bool needsVerification(const BundleEntry& entry, bool force) const;
+    void recordVerification(BundleEntry& entry, bool valid) const;
     
     std::string m_path;
     BundleHeader m_header;
-    std::unordered_map<std::string, BundleEntry> m_entries;
+    mutable std::unordered_map<std::string, BundleEntry> m_entries;
+    mutable bool m_entriesParsed = true;   ///< False until a mapped bundle's table is read
     std::vector<uint8_t> m_data;
+    std::shared_ptr<const MappedFile> m_mapping;   ///< Shared with the views borrowing from it
+    BundleVerification m_verification = BundleVerification::FirstAccess;
     mutable std::mutex m_mutex;
 };
 
@@ -388,6 +551,17 @@ using BundleHandle = std::shared_ptr<AssetBundle>;
 /**
  * @class FileWatcher
  * @brief Watches files for changes (hot reload support)
+ * 
+ * On Linux, changes are delivered by inotify and update() only drains the
+ * event queue. Elsewhere, or if inotify is unavailable, watched paths are
+ * polled: passes are throttled to the poll interval and each update()
+ * stats at most the poll budget of files, resuming where the previous call
+ * stopped, so large trees are scanned across several frames.
+ * 
+ * Bursts of changes to one file are coalesced and reported once the file
+ * has been quiet for the debounce interval. Callbacks run on the thread
+ * calling update(), outside the watcher's lock, so they may add or remove
+ * watches.
  */
 class FileWatcher {
 public:
@@ -448,22 +622,221 @@ public:
      * @brief Check if a specific path is being watched
      */
     [[nodiscard]] bool isWatching(const std::string& path) const;
+    
+    /**
+     * @brief Set how long a file must stay unchanged before it is reported
+     * 
+     * Zero reports changes on the next update(). Default 50 ms.
+     */
+    void setDebounceInterval(std::chrono::milliseconds interval);
+    
+    /**
+     * @brief Get the debounce interval
+     */
+    [[nodiscard]] std::chrono::milliseconds getDebounceInterval() const;
+    
+    /**
+     * @brief Set the minimum time between polling passes (polling backend)
+     * 
+     * Default 250 ms.
+     */
+    void setPollInterval(std::chrono::milliseconds interval);
+    
+    /**
+     * @brief Set how many files one update() may check (polling backend)
+     * @param filesPerUpdate File budget per call, 0 for unlimited. Default 2048.
+     */
+    void setPollBudget(size_t filesPerUpdate);
+    
+    /**
+     * @brief Use polling even where OS change events are available
+     * 
+     * Useful for network filesystems whose remote writes produce no events.
+     */
+    void setForcePolling(bool force);
+    
+    /**
+     * @brief Check if changes are delivered by OS events rather than polling
+     */
+    [[nodiscard]] bool isEventDriven() const;
 
 private:
+    using Clock = std::chrono::steady_clock;
+    
+    struct NativeWatcher;
+    
+    struct PolledFile {
+        std::filesystem::file_time_type time;
+        uint64_t walk = 0;      ///< Last walk that found the file
+    };
+    
     struct WatchEntry {
         std::string path;
+        std::string normalizedPath;
         FileChangeCallback callback;
         std::filesystem::file_time_type lastModified;
         bool isDirectory = false;
+        std::unordered_map<std::string, PolledFile> fileTimes;  ///< Polling: files under a directory
+        uint64_t walk = 0;                                      ///< Polling: walks of the directory started
+        std::vector<std::string> nativeDirectories;  ///< Events: directories watched for this entry
     };
     
+    void addWatch(const std::string& path, FileChangeCallback callback, bool isDirectory);
+    void removeWatch(const std::string& path);
+    void addNativeWatch(WatchEntry& entry);
+    void removeNativeWatch(WatchEntry& entry);
+    void collectNativeEvents(Clock::time_point now);
+    void pollStep(Clock::time_point now);
+    void resetPolling();
+    void queueChange(const std::string& normalizedPath, Clock::time_point now);
+    void resolveChange(const std::string& normalizedPath,
+                       std::vector<std::pair<FileChangeCallback, std::string>>& out) const;
+    
     std::unordered_map<std::string, WatchEntry> m_watches;
-    std::unordered_map<std::string, std::filesystem::file_time_type> m_fileTimestamps; ///< Track file timestamps within watched directories
+    std::unordered_map<std::string, std::string> m_watchKeys;  ///< Normalized path -> watch key
+    std::unordered_map<std::string, Clock::time_point> m_pendingChanges;  ///< Normalized path -> last change
+    std::unique_ptr<NativeWatcher> m_native;
+    
+    // Polling state, carried across update() calls
+    std::vector<std::string> m_pollOrder;
+    size_t m_pollIndex = 0;
+    std::filesystem::recursive_directory_iterator m_pollIterator;
+    bool m_pollIterating = false;
+    bool m_pollPassActive = false;
+    Clock::time_point m_lastPollPass{};
+    
+    std::chrono::milliseconds m_debounceInterval{50};
+    std::chrono::milliseconds m_pollInterval{250};
+    size_t m_pollBudget = 2048;
+    bool m_forcePolling = false;
     mutable std::mutex m_mutex;
     bool m_enabled = true;
 };
 
 
+/**
+ * @class EvictionIndex
+ * @brief Cached resources kept in LRU, LFU and FIFO eviction order
+ * 
+ * Every resource is linked into a recency list, a load-order list and a
+ * frequency bucket (buckets ascend by access count), so loads, accesses and
+ * removals are O(1) and eviction walks the active policy's order from its
+ * head instead of sorting every resource.
+ * 
+ * Not thread-safe; ResourceManager guards it with its cache mutex.
+ */
+class EvictionIndex {
+public:
+    /**
+     * @brief Bookkeeping for one cached resource
+     */
+    struct Entry {
+        ResourceType type = ResourceType::Unknown;
+        size_t memoryUsage = 0;
+        std::chrono::steady_clock::time_point lastAccessTime;
+        std::chrono::steady_clock::time_point loadTime;
+        size_t accessCount = 0;
+    };
+    
+    EvictionIndex() = default;
+    EvictionIndex(const EvictionIndex&) = delete;
+    EvictionIndex& operator=(const EvictionIndex&) = delete;
+    
+    /**
+     * @brief Record a newly cached resource
+     * 
+     * It becomes the most recently used and most recently loaded entry with
+     * an access count of 1. An existing entry with the same key is replaced.
+     */
+    void insert(const std::string& key, ResourceType type, size_t memoryUsage);
+    
+    /**
+     * @brief Forget a resource
+     * @return true if the key was tracked
+     */
+    bool erase(const std::string& key);
+    
+    /**
+     * @brief Record an access (moves to most recent, increments the count)
+     */
+    void touch(const std::string& key);
+    
+    /**
+     * @brief Record a reload with a new size
+     * 
+     * The entry becomes the most recently used without counting an access.
+     */
+    void refresh(const std::string& key, size_t memoryUsage);
+    
+    /**
+     * @brief Look up a resource's bookkeeping
+     * @return Entry or nullptr if not tracked
+     */
+    const Entry* find(const std::string& key) const;
+    
+    /**
+     * @brief Collect eviction candidates in policy order
+     * 
+     * Takes entries from the front of the policy's order until their
+     * combined size reaches bytesToFree. Runs in time proportional to the
+     * number of candidates returned.
+     */
+    std::vector<std::string> collect(EvictionPolicy policy, size_t bytesToFree) const;
+    
+    /**
+     * @brief Visit every entry (unordered)
+     */
+    template<typename Fn>
+    void forEach(Fn&& fn) const {
+        for (const auto& [key, node] : m_nodes) {
+            fn(key, node.entry);
+        }
+    }
+    
+    size_t size() const { return m_nodes.size(); }
+    bool empty() const { return m_nodes.empty(); }
+    void clear();
+
+private:
+    struct Node;
+    
+    struct Links {
+        Node* prev = nullptr;
+        Node* next = nullptr;
+    };
+    
+    struct List {
+        Node* head = nullptr;
+        Node* tail = nullptr;
+    };
+    
+    struct FrequencyBucket {
+        size_t accessCount = 0;
+        List members;           ///< Oldest arrival in this bucket first
+    };
+    using BucketIterator = std::list<FrequencyBucket>::iterator;
+    
+    struct Node {
+        const std::string* key = nullptr;   ///< Points at the map's own key
+        Entry entry;
+        Links recency;
+        Links arrival;
+        Links frequency;
+        BucketIterator bucket;
+    };
+    
+    static void pushBack(List& list, Node* node, Links Node::*links);
+    static void unlink(List& list, Node* node, Links Node::*links);
+    void linkToBucket(Node* node, BucketIterator hint);
+    void unlinkFromBucket(Node* node);
+    
+    std::unordered_map<std::string, Node> m_nodes;   ///< Node addresses are stable
+    List m_recency;                                  ///< Least recently used first
+    List m_arrival;                                  ///< Oldest load first
+    std::list<FrequencyBucket> m_buckets;            ///< Ascending access count
+};
+
+
 /**
  * @class ResourceManager
  * @brief Central resource management system
@@ -545,11 +918,43 @@ public:
     
     /**
      * @brief Preload resources asynchronously
+     *
+     * File I/O and CPU-side decoding run on the loader thread pool; GPU
+     * upload and the callback run on the thread that calls
+     * processPendingUploads(). Requests for a resource that is already
+     * in flight are merged into the existing request. Immediate priority
+     * loads synchronously on the calling thread.
+     *
      * @param paths List of file paths to preload
      * @param callback Optional callback for each resource
+     * @param priority Scheduling priority for decode and upload
      */
     void preloadAsync(const std::vector<std::string>& paths,
-                      ResourceLoadCallback callback = nullptr);
+                      ResourceLoadCallback callback = nullptr,
+                      LoadPriority priority = LoadPriority::Normal);
+
+    /**
+     * @brief Finish decoded async loads (call each frame on the render thread)
+     * @param maxUploads Maximum number of uploads to perform (0 = all ready)
+     * @return Number of async loads finished
+     */
+    size_t processPendingUploads(size_t maxUploads = 0);
+
+    /**
+     * @brief Get number of async loads not yet finished
+     */
+    [[nodiscard]] size_t getPendingLoadCount() const;
+
+    /**
+     * @brief Set number of loader worker threads
+     * @param count Worker count (0 = hardware concurrency - 1, at least 1)
+     */
+    void setLoaderThreadCount(size_t count);
+
+    /**
+     * @brief Get number of loader worker threads
+     */
+    [[nodiscard]] size_t getLoaderThreadCount() const;
 
     
     // ========== Cache Management ==========
@@ -706,9 +1111,10 @@ public:
     /**
      * @brief Load an asset bundle
      * @param path Bundle file path
+     * @param memoryMapped Map the file instead of reading it into memory
      * @return Bundle handle or nullptr on failure
      */
-    BundleHandle loadBundle(const std::string& path);
+    BundleHandle loadBundle(const std::string& path, bool memoryMapped = false);
     
     /**
      * @brief Create a new asset bundle
@@ -743,6 +1149,13 @@ public:
      */
     [[nodiscard]] std::vector<uint8_t> getBundleData(const std::string& path) const;
     
+    /**
+     * @brief Get data from mounted bundles without copying when possible
+     * @param path Virtual path
+     * @return Entry bytes (a view into the mapping for mapped bundles), empty if not found
+     */
+    [[nodiscard]] BundleData getBundleView(const std::string& path) const;
+    
     // ========== Statistics ==========
     
     /**
@@ -813,9 +1226,13 @@ private:
     void trackGPUMemoryUsage(size_t bytes);
     void untrackGPUMemoryUsage(size_t bytes);
     void onFileChanged(const std::string& path);
-    bool loadFromBundle(const std::string& path, std::vector<uint8_t>& data) const;
-    
-    // Memory management helpers
+    bool loadFromBundle(const std::string& path, BundleData& data) const;
+    void cacheTexture(const std::string& key, const std::string& path, const TextureHandle& texture,
+                      std::chrono::steady_clock::time_point startTime);
+    void cacheFont(const std::string& key, const std::string& path, const FontHandle& font,
+                   std::chrono::steady_clock::time_point startTime);
+
+    // Memory management helpers (callers hold m_cacheMutex)
     void trackResourceMetadata(const std::string& key, ResourceType type, size_t memoryUsage);
     void untrackResourceMetadata(const std::string& key);
     void updateResourceAccessTime(const std::string& key);
@@ -842,17 +1259,54 @@ private:
     std::atomic<size_t> m_peakGPUMemoryUsage{0};
     EvictionPolicy m_evictionPolicy = EvictionPolicy::LRU;
     
-    // Resource metadata for LRU/LFU tracking
-    struct ResourceMetadata {
+    // Resource metadata kept in LRU/LFU/FIFO order (guarded by m_cacheMutex)
+    EvictionIndex m_resourceMetadata;
+    
+    // Async loading
+    struct AsyncLoadRequest {
+        std::string path;
         std::string key;
-        ResourceType type;
-        size_t memoryUsage = 0;
-        std::chrono::steady_clock::time_point lastAccessTime;
-        std::chrono::steady_clock::time_point loadTime;
-        size_t accessCount = 0;
+        ResourceType type = ResourceType::Unknown;
+        LoadPriority priority = LoadPriority::Normal;
+        uint64_t sequence = 0;              ///< Submission order within a priority
+        std::vector<ResourceLoadCallback> callbacks;
+        BundleData fileData;                ///< Raw file bytes (fonts, audio)
+        ImageData imageData;                ///< Decoded pixels (images)
+        std::chrono::steady_clock::time_point startTime;
+        bool dispatched = false;            ///< Taken by a worker
+        bool decoded = false;               ///< Waiting for upload
     };
-    std::unordered_map<std::string, ResourceMetadata> m_resourceMetadata;
-    
+    using AsyncLoadRequestPtr = std::shared_ptr<AsyncLoadRequest>;
+
+    struct AsyncQueueEntry {
+        LoadPriority priority = LoadPriority::Normal;
+        uint64_t sequence = 0;
+        AsyncLoadRequestPtr request;
+
+        // Higher priority first, then submission order
+        bool operator<(const AsyncQueueEntry& other) const {
+            if (priority != other.priority) return priority < other.priority;
+            return sequence > other.sequence;
+        }
+    };
+
+    void startLoaderThreads();  ///< Call with m_loaderThreadsMutex held
+    void stopLoaderThreads();   ///< Call with m_loaderThreadsMutex held
+    void loaderWorkerLoop();
+    void decodeAsyncRequest(AsyncLoadRequest& request) const;
+    bool finishAsyncRequest(AsyncLoadRequest& request);
+
+    mutable std::mutex m_loaderMutex;
+    std::condition_variable m_loaderCondition;
+    std::priority_queue<AsyncQueueEntry> m_decodeQueue;
+    std::priority_queue<AsyncQueueEntry> m_uploadQueue;
+    std::unordered_map<std::string, AsyncLoadRequestPtr> m_inFlightLoads;
+    std::mutex m_loaderThreadsMutex;              ///< Taken before m_loaderMutex, never while holding it
+    std::vector<std::thread> m_loaderThreads;
+    std::atomic<size_t> m_loaderThreadCount{0};
+    uint64_t m_loadSequence = 0;
+    bool m_loaderStopping = false;
+
     // Hot reload
     bool m_hotReloadEnabled = false;
     std::unique_ptr<FileWatcher> m_fileWatcher;
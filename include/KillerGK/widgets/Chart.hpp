@@ -14,6 +14,9 @@
 
 namespace KillerGK {
 
+class ChartColumns;
+class ChartStream;
+
 /**
  * @enum ChartType
  * @brief Type of chart to render
@@ -27,6 +30,16 @@ enum class ChartType {
     Donut
 };
 
+/**
+ * @enum ChartDecimation
+ * @brief How line and area series are reduced to the points worth drawing
+ */
+enum class ChartDecimation {
+    None,       ///< Every point in the visible x-range
+    MinMax,     ///< First, lowest, highest and last point per pixel column; draws the same line
+    Lttb        ///< One point per pixel column, chosen by Largest-Triangle-Three-Buckets
+};
+
 /**
  * @struct DataPoint
  * @brief A single data point in a chart series
@@ -43,6 +56,28 @@ struct DataPoint {
         : x(xVal), y(yVal), label(lbl) {}
 };
 
+/**
+ * @struct ChartRenderPoint
+ * @brief A point to draw, referring back to its data point
+ */
+struct ChartRenderPoint {
+    double x = 0.0;
+    double y = 0.0;
+    size_t index = 0;                    ///< Index into the series data (or columns)
+};
+
+/**
+ * @struct ChartHit
+ * @brief The data point nearest a position on the chart
+ */
+struct ChartHit {
+    std::string seriesId;                ///< Series of the point; empty if no point is near
+    size_t index = 0;                    ///< Index into the series data (or columns, or stream window)
+    double x = 0.0;
+    double y = 0.0;
+    float distance = 0.0f;               ///< Pixels from the position
+};
+
 /**
  * @struct ChartSeries
  * @brief A data series in a chart
@@ -51,6 +86,7 @@ struct ChartSeries {
     std::string id;                      ///< Unique series identifier
     std::string name;                    ///< Display name for legend
     std::vector<DataPoint> data;         ///< Data points
+    std::shared_ptr<ChartColumns> columns;   ///< Compact storage used instead of data when set
     Color color;                         ///< Series color
     float lineWidth = 2.0f;              ///< Line width for line/area charts
     bool showPoints = true;              ///< Show data point markers
@@ -100,6 +136,8 @@ struct ChartAxis {
     bool showGrid = true;
     Color gridColor = Color(0.9f, 0.9f, 0.9f, 1.0f);
     Color labelColor = Color(0.3f, 0.3f, 0.3f, 1.0f);
+    
+    bool operator==(const ChartAxis& other) const = default;
 };
 
 /**
@@ -110,6 +148,8 @@ struct ChartLegend {
     bool visible = true;
     enum class Position { Top, Bottom, Left, Right } position = Position::Bottom;
     float itemSpacing = 20.0f;
+    
+    bool operator==(const ChartLegend& other) const = default;
 };
 
 /**
@@ -209,6 +249,11 @@ public:
 
     /**
      * @brief Get series by id
+     *
+     * Points may be appended to the returned series' data directly; other
+     * changes to the data should go through updateSeriesData() so cached
+     * render points are rebuilt.
+     *
      * @param id Series identifier
      * @return Pointer to series or nullptr
      */
@@ -222,6 +267,167 @@ public:
      */
     Chart& updateSeriesData(const std::string& id, const std::vector<DataPoint>& data);
 
+    /**
+     * @brief Append points to a series
+     *
+     * Cached render points are extended rather than rebuilt.
+     *
+     * @param id Series identifier
+     * @param points Points to append
+     * @return Reference to this Chart for chaining
+     */
+    Chart& appendPoints(const std::string& id, const std::vector<DataPoint>& points);
+
+    /**
+     * @brief Feed a series from a stream
+     *
+     * The series then shows the stream's window instead of its data, which
+     * is left as it was. Render points and data ranges follow the window
+     * as of the last updateStreams().
+     *
+     * @param id Series identifier
+     * @param stream Stream to show, or nullptr to go back to the series data
+     * @return Reference to this Chart for chaining
+     */
+    Chart& streamSeries(const std::string& id, std::shared_ptr<ChartStream> stream);
+
+    /**
+     * @brief Get the stream feeding a series
+     * @param id Series identifier
+     * @return Stream or nullptr if the series is not streamed
+     */
+    [[nodiscard]] std::shared_ptr<ChartStream> getStream(const std::string& id) const;
+
+    /**
+     * @brief Take in points pushed to the streams since the last call
+     *
+     * Call on the UI thread, once per frame.
+     *
+     * @return true if any stream received points
+     */
+    bool updateStreams();
+
+    // =========================================================================
+    // Rendering
+    // =========================================================================
+
+    /**
+     * @brief Set how line and area series are decimated for drawing
+     * @param mode Decimation mode
+     * @return Reference to this Chart for chaining
+     */
+    Chart& decimation(ChartDecimation mode);
+
+    /**
+     * @brief Get the decimation mode
+     * @return Decimation mode
+     */
+    [[nodiscard]] ChartDecimation getDecimation() const;
+
+    /**
+     * @brief Get the points to draw for a series
+     *
+     * For line and area charts, points are bucketed by pixel column over
+     * the visible x-range (see getVisibleXRange()) and reduced as set by
+     * decimation(); the nearest point outside the range on each side is
+     * kept so lines reach the plot edges. Results are cached for the last
+     * few zoom levels, and extended in place as points are appended while
+     * the x-range stays put (a fixed X axis rather than autoScale). Other
+     * chart types, series out of x order, and charts without a width get
+     * every point.
+     *
+     * @param id Series identifier
+     * @return Points in series order; valid until the series or view changes
+     */
+    [[nodiscard]] const std::vector<ChartRenderPoint>& getRenderPoints(const std::string& id) const;
+
+    /**
+     * @brief Get the x-range shown on the plot
+     *
+     * The X axis bounds, or the range of the data when it scales
+     * automatically.
+     *
+     * @param minX Output: lowest visible x
+     * @param maxX Output: highest visible x
+     */
+    void getVisibleXRange(double& minX, double& maxX) const;
+
+    /**
+     * @brief Get the y-range shown on the plot
+     *
+     * The Y axis bounds, or the y-range getDataRange() reports when it
+     * scales automatically.
+     *
+     * @param minY Output: lowest visible y
+     * @param maxY Output: highest visible y
+     */
+    void getVisibleYRange(double& minY, double& maxY) const;
+
+    // =========================================================================
+    // Hit Testing
+    // =========================================================================
+
+    /**
+     * @brief Set how far from a point, in pixels, the cursor still hits it
+     * @param radius Hit radius in pixels
+     * @return Reference to this Chart for chaining
+     */
+    Chart& hitRadius(float radius);
+
+    /**
+     * @brief Get the hit radius
+     * @return Hit radius in pixels
+     */
+    [[nodiscard]] float getHitRadius() const;
+
+    /**
+     * @brief Find the data point nearest a position
+     *
+     * Line, area and scatter charts map the visible x and y ranges onto
+     * the plot area (the chart's size less its padding). Each series keeps
+     * an index, built on first use and extended as points are appended,
+     * so lookups do not scan the series; streamed series are scanned, as
+     * their window is bounded.
+     *
+     * @param x Position relative to the chart's left edge
+     * @param y Position relative to the chart's top edge
+     * @return Nearest point within the hit radius (ties go to the earlier
+     *         series, then the earlier point), or a hit with an empty
+     *         seriesId
+     */
+    [[nodiscard]] ChartHit hitTest(float x, float y) const;
+
+    /**
+     * @brief Track the cursor, calling the point hover callback on changes
+     *
+     * The callback is called with false for the point the cursor left,
+     * then with true for the point it reached.
+     *
+     * @param x Position relative to the chart's left edge
+     * @param y Position relative to the chart's top edge
+     * @return true if the hovered point changed
+     */
+    bool handleMouseMove(float x, float y);
+
+    /**
+     * @brief Note that the cursor left the chart
+     */
+    void handleMouseLeave();
+
+    /**
+     * @brief Call the point click callback for the point at a position
+     * @param x Position relative to the chart's left edge
+     * @param y Position relative to the chart's top edge
+     * @return true if a point was clicked
+     */
+    bool handleMouseClick(float x, float y);
+
+    /**
+     * @brief Get the point under the cursor
+     * @return Hovered point, or a hit with an empty seriesId
+     */
+    [[nodiscard]] const ChartHit& getHoveredPoint() const;
+
     // =========================================================================
     // Axes Configuration
     // =========================================================================
@@ -508,6 +714,14 @@ public:
 protected:
     Chart();
 
+    /**
+     * @brief Get a point of a series, whatever holds it
+     * @return The point, or a default point if there is none
+     */
+    [[nodiscard]] DataPoint pointAt(const std::string& id, size_t index) const;
+
+    void notifyHover(const ChartHit& hit, bool entered);
+
     struct ChartData;
     std::shared_ptr<ChartData> m_chartData;
 };
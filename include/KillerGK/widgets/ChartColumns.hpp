@@ -0,0 +1,215 @@
+/**
+ * @file ChartColumns.hpp
+ * @brief Compact column storage for large Chart series
+ *
+ * A DataPoint carries a label string and a std::any next to its two
+ * doubles, about 70 bytes per point. ChartColumns keeps x and y in
+ * separate arrays instead, each stored as doubles, floats, or (for
+ * timestamps and other evenly spaced values) 32-bit steps from a base,
+ * with labels kept only for the points that have one. Arrays the caller
+ * already holds can be shown without copying.
+ */
+
+#pragma once
+
+#include "Chart.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace KillerGK {
+
+/**
+ * @enum ChartColumnType
+ * @brief How a column stores its values
+ */
+enum class ChartColumnType {
+    Float64,    ///< 8 bytes per value, exact
+    Float32,    ///< 4 bytes per value, about 7 significant digits
+    Delta32     ///< 4 bytes per value: whole steps of a unit from a block's first value
+};
+
+/**
+ * @class ChartColumns
+ * @brief x and y arrays of a series, with sparse labels
+ *
+ * Delta32 rounds each value to a whole number of units from the first
+ * value of its block of DELTA_BLOCK values, so millisecond timestamps with
+ * a unit of 1 are kept exactly. A value that cannot be stored that way
+ * (NaN, or below or too far above the block's first value) turns the
+ * column into Float64.
+ *
+ * Example:
+ * @code
+ * auto columns = std::make_shared<ChartColumns>(ChartColumnType::Delta32, ChartColumnType::Float32);
+ * columns->reserve(times.size());
+ * columns->append(times, values);
+ *
+ * ChartSeries series("latency", "Latency");
+ * series.columns = columns;
+ * chart.addSeries(series);
+ * @endcode
+ */
+class ChartColumns {
+public:
+    static constexpr size_t DELTA_BLOCK = 4096;
+
+    /**
+     * @brief Create empty columns
+     * @param xType Storage for x values
+     * @param yType Storage for y values
+     * @param xUnit Step size for Delta32 x values
+     * @param yUnit Step size for Delta32 y values
+     */
+    explicit ChartColumns(ChartColumnType xType = ChartColumnType::Float64,
+                          ChartColumnType yType = ChartColumnType::Float64,
+                          double xUnit = 1.0, double yUnit = 1.0);
+
+    // Shared through std::shared_ptr rather than copied
+    ChartColumns(const ChartColumns&) = delete;
+    ChartColumns& operator=(const ChartColumns&) = delete;
+    ChartColumns(ChartColumns&&) = default;
+    ChartColumns& operator=(ChartColumns&&) = default;
+
+    // =========================================================================
+    // Viewing caller-owned arrays
+    // =========================================================================
+
+    /**
+     * @brief Show an array as the x values, without copying
+     *
+     * The array must outlive the columns, or the next append or view call,
+     * and must not be resized meanwhile. Appending copies the viewed
+     * values first.
+     *
+     * @return Reference to these columns for chaining
+     */
+    ChartColumns& viewX(std::span<const double> values);
+    ChartColumns& viewX(std::span<const float> values);
+
+    /**
+     * @brief Show an array as the y values, without copying (see viewX())
+     * @return Reference to these columns for chaining
+     */
+    ChartColumns& viewY(std::span<const double> values);
+    ChartColumns& viewY(std::span<const float> values);
+
+    /**
+     * @brief Check if either column shows a caller-owned array
+     */
+    [[nodiscard]] bool isView() const { return m_x.viewed || m_y.viewed; }
+
+    // =========================================================================
+    // Appending
+    // =========================================================================
+
+    void reserve(size_t count);
+
+    void append(double x, double y);
+
+    /**
+     * @brief Append values from two arrays of the same length
+     */
+    void append(std::span<const double> x, std::span<const double> y);
+
+    /**
+     * @brief Append points, keeping their labels (userData is not kept)
+     */
+    void append(const std::vector<DataPoint>& points);
+
+    /**
+     * @brief Remove all points and labels, and stop viewing any arrays
+     */
+    void clear();
+
+    // =========================================================================
+    // Access
+    // =========================================================================
+
+    /**
+     * @brief Number of points (the shorter column's length)
+     */
+    [[nodiscard]] size_t size() const { return std::min(m_x.size, m_y.size); }
+    [[nodiscard]] bool empty() const { return size() == 0; }
+
+    [[nodiscard]] double x(size_t index) const { return m_x.at(index); }
+    [[nodiscard]] double y(size_t index) const { return m_y.at(index); }
+
+    [[nodiscard]] ChartColumnType getXType() const { return m_x.type; }
+    [[nodiscard]] ChartColumnType getYType() const { return m_y.type; }
+
+    /**
+     * @brief Get a point as a DataPoint, with its label
+     */
+    [[nodiscard]] DataPoint point(size_t index) const;
+
+    /**
+     * @brief Get the lowest and highest x and y, leaving out NaN values
+     * @return false if there are no x or no y values
+     */
+    bool getRange(double& minX, double& maxX, double& minY, double& maxY) const;
+
+    /**
+     * @brief Bytes held by the columns and labels (viewed arrays not included)
+     */
+    [[nodiscard]] size_t memoryUsage() const;
+
+    // =========================================================================
+    // Labels
+    // =========================================================================
+
+    /**
+     * @brief Label a point (an empty label removes it)
+     */
+    void setLabel(size_t index, std::string label);
+
+    /**
+     * @brief Get a point's label
+     * @return Label, or an empty string if the point has none
+     */
+    [[nodiscard]] const std::string& label(size_t index) const;
+
+    [[nodiscard]] size_t getLabelCount() const { return m_labels.size(); }
+
+private:
+    struct Column {
+        ChartColumnType type = ChartColumnType::Float64;
+        ChartColumnType storage = ChartColumnType::Float64;   ///< Type asked for, used again after clear()
+        double unit = 1.0;                      ///< Delta32 step size
+        size_t size = 0;
+        bool viewed = false;                    ///< Values are a caller-owned array
+        const double* doubles = nullptr;        ///< Float64 values (owned or viewed)
+        const float* floats = nullptr;          ///< Float32 values (owned or viewed)
+        std::vector<double> ownedDoubles;
+        std::vector<float> ownedFloats;
+        std::vector<double> bases;              ///< Delta32: first value of each block
+        std::vector<uint32_t> steps;            ///< Delta32: units from the block's first value
+
+        [[nodiscard]] double at(size_t index) const {
+            switch (type) {
+                case ChartColumnType::Float64: return doubles[index];
+                case ChartColumnType::Float32: return floats[index];
+                case ChartColumnType::Delta32:
+                    return bases[index / DELTA_BLOCK] + static_cast<double>(steps[index]) * unit;
+            }
+            return 0.0;
+        }
+
+        void reserve(size_t count);
+        void push(double value);
+        void own(size_t count);
+        void promote();
+        void clear();
+        [[nodiscard]] size_t memoryUsage() const;
+        template <typename Visit> void forEach(size_t count, Visit visit) const;
+    };
+
+    Column m_x;
+    Column m_y;
+    std::vector<std::pair<size_t, std::string>> m_labels;   ///< By point index, ascending
+};
+
+} // namespace KillerGK
@@ -0,0 +1,116 @@
+/**
+ * @file ChartDecimator.hpp
+ * @brief Viewport-aware point reduction for drawing large Chart series
+ *
+ * A line with millions of points cannot show more than a few of them per
+ * pixel column. The decimator buckets the points inside the visible
+ * x-range by pixel column and keeps either each column's first, lowest,
+ * highest and last points (MinMax), which draws the same line as the full
+ * data, or the one point per column that best keeps the line's shape
+ * (Largest-Triangle-Three-Buckets). Results are cached per view and
+ * extended in place when points are appended.
+ */
+
+#pragma once
+
+#include "Chart.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace KillerGK {
+
+class ChartColumns;
+
+/**
+ * @class ChartDecimator
+ * @brief Render point cache for one series
+ *
+ * Expects the series to change only by appending; anything else must be
+ * reported with reset(). Replacing the data is also noticed when the first
+ * point or the last point seen differ.
+ */
+class ChartDecimator {
+public:
+    static constexpr size_t MAX_CACHED_VIEWS = 4;
+    static constexpr size_t NO_POINT = static_cast<size_t>(-1);
+
+    /**
+     * @brief What part of the series is drawn, and how
+     */
+    struct View {
+        double xMin = 0.0;
+        double xMax = 0.0;
+        size_t columns = 0;                              ///< Plot width in pixels; 0 keeps every point
+        ChartDecimation mode = ChartDecimation::MinMax;
+
+        bool operator==(const View& other) const = default;
+    };
+
+    /**
+     * @brief Get the points to draw
+     *
+     * Points outside the x-range are dropped except the nearest one on
+     * each side, so lines run on to the plot edges. Series whose x values
+     * are not in ascending order are returned whole.
+     *
+     * @return Points in series order; valid until the next call
+     */
+    const std::vector<ChartRenderPoint>& points(const std::vector<DataPoint>& data, const View& view);
+    const std::vector<ChartRenderPoint>& points(const ChartColumns& data, const View& view);
+
+    /**
+     * @brief Check if the series' x values are in ascending order
+     */
+    [[nodiscard]] bool isSorted(const std::vector<DataPoint>& data);
+    [[nodiscard]] bool isSorted(const ChartColumns& data);
+
+    /**
+     * @brief Forget cached results (after the data was changed other than by appending)
+     */
+    void reset();
+
+private:
+    struct Column {
+        size_t first = 0;
+        size_t last = 0;
+        size_t low = 0;          ///< Index of the lowest point
+        size_t high = 0;         ///< Index of the highest point
+        size_t count = 0;
+        double sumX = 0.0;
+        double sumY = 0.0;
+    };
+
+    struct Cache {
+        View view;
+        size_t seen = 0;                      ///< Points taken into account
+        bool built = false;
+        size_t begin = 0;                     ///< First point with x >= xMin
+        size_t end = 0;                       ///< One past the last point with x <= xMax
+        std::vector<Column> columns;
+        size_t lastColumn = 0;                ///< Highest non-empty column
+        std::vector<size_t> selected;         ///< LTTB: chosen point per column
+        size_t dirtyColumn = 0;               ///< First column changed since the output was built
+        std::vector<ChartRenderPoint> output;
+        uint64_t lastUse = 0;
+    };
+
+    // Data is a DataPoint vector or ChartColumns
+    template <typename Data> void checkData(const Data& data);
+    template <typename Data> const std::vector<ChartRenderPoint>& decimate(const Data& data, const View& view);
+    Cache& cacheFor(const View& view);
+    template <typename Data> void update(Cache& cache, const Data& data);
+    template <typename Data> void add(Cache& cache, const Data& data, size_t index);
+    template <typename Data> void buildAll(Cache& cache, const Data& data);
+    template <typename Data> void buildMinMax(Cache& cache, const Data& data);
+    template <typename Data> void buildLttb(Cache& cache, const Data& data);
+
+    std::vector<Cache> m_caches;
+    std::vector<ChartRenderPoint> m_all;      ///< Every point, for series out of x order
+    size_t m_size = 0;                        ///< Points checked so far
+    ChartRenderPoint m_first;                 ///< First and last checked points, to notice replaced data
+    ChartRenderPoint m_last;
+    bool m_sorted = true;
+    uint64_t m_uses = 0;
+};
+
+} // namespace KillerGK
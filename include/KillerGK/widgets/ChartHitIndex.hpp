@@ -0,0 +1,105 @@
+/**
+ * @file ChartHitIndex.hpp
+ * @brief Nearest-point lookup for Chart hover and click handling
+ *
+ * Finding the point under the cursor must not scan the whole series on
+ * every mouse move. Series in x order are searched by bisection on x,
+ * widening until the x distance alone exceeds the best match. Other
+ * series (scatter plots), and series in x order whose points crowd
+ * within the hit radius in x, get k-d trees over their points, searched
+ * with the chart's current pixel scale so the nearest point on screen is
+ * found at any zoom level.
+ *
+ * Appended points are indexed as they come: they collect in a short
+ * unindexed tail, which becomes a small tree when full; trees of similar
+ * size are merged, so each point is re-indexed O(log n) times.
+ */
+
+#pragma once
+
+#include "Chart.hpp"
+#include <vector>
+
+namespace KillerGK {
+
+class ChartColumns;
+
+/**
+ * @class ChartHitIndex
+ * @brief Nearest-point index and value ranges for one series
+ *
+ * Expects the series to change only by appending, like ChartDecimator;
+ * replaced data is noticed when the first point or the last point seen
+ * differ.
+ */
+class ChartHitIndex {
+public:
+    static constexpr size_t NO_POINT = static_cast<size_t>(-1);
+    static constexpr size_t MAX_UNINDEXED = 256;    ///< Appended points scanned before forming a tree
+    static constexpr size_t MAX_SORTED_SCAN = 64;   ///< Points walked on x before using the trees instead
+
+    /**
+     * @brief A query: a position in data units and the pixel scale
+     */
+    struct Query {
+        double x = 0.0;
+        double y = 0.0;
+        double scaleX = 1.0;          ///< Pixels per x unit
+        double scaleY = 1.0;          ///< Pixels per y unit
+        double radius = 0.0;          ///< Largest distance in pixels
+    };
+
+    struct Hit {
+        size_t index = NO_POINT;      ///< Nearest point, NO_POINT if none is within the radius
+        double distance = 0.0;        ///< In pixels
+    };
+
+    /**
+     * @brief Find the point nearest a position, in pixels
+     *
+     * Points with a NaN coordinate are never hit.
+     */
+    Hit nearest(const std::vector<DataPoint>& data, const Query& query);
+    Hit nearest(const ChartColumns& data, const Query& query);
+
+    /**
+     * @brief Get the lowest and highest x and y, leaving out NaN values
+     * @return false if the series has no x or no y values
+     */
+    bool getRange(const std::vector<DataPoint>& data, double& minX, double& maxX, double& minY, double& maxY);
+    bool getRange(const ChartColumns& data, double& minX, double& maxX, double& minY, double& maxY);
+
+    /**
+     * @brief Forget the index (after the data was changed other than by appending)
+     */
+    void reset();
+
+private:
+    // Data is a DataPoint vector or ChartColumns
+    template <typename Data> void sync(const Data& data);
+    template <typename Data> void index(const Data& data);
+    template <typename Data> Hit search(const Data& data, const Query& query);
+    template <typename Data> void buildTree(const Data& data, std::vector<size_t>& tree, size_t begin, size_t end,
+                                            int axis);
+    template <typename Data> void searchTree(const Data& data, const std::vector<size_t>& tree, size_t begin,
+                                             size_t end, int axis, const Query& query, Hit& best) const;
+
+    // Data checked so far
+    size_t m_size = 0;
+    ChartRenderPoint m_first;
+    ChartRenderPoint m_last;
+    bool m_sorted = true;
+    double m_minX = 0.0;
+    double m_maxX = 0.0;
+    double m_minY = 0.0;
+    double m_maxY = 0.0;
+    bool m_hasX = false;
+    bool m_hasY = false;
+
+    // Trees for data out of x order; each is a median-split k-d tree over
+    // point indices, largest first
+    std::vector<std::vector<size_t>> m_trees;
+    size_t m_indexed = 0;             ///< Points before this are in the trees (or skipped as NaN)
+};
+
+} // namespace KillerGK
@@ -0,0 +1,175 @@
+/**
+ * @file ChartStream.hpp
+ * @brief Fixed-capacity streaming data for live Chart series
+ *
+ * A stream keeps the most recent points of a series in a ring buffer, so
+ * appending is O(1) and the oldest points fall off without moving the
+ * rest. The lowest and highest x and y in the window are tracked with
+ * monotonic queues, so axis ranges are O(1) as well.
+ *
+ * Points may be pushed from a producer thread. They wait in a lock-free
+ * staging queue until the UI thread calls update(), so neither thread
+ * blocks the other.
+ */
+
+#pragma once
+
+#include "Chart.hpp"
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace KillerGK {
+
+/**
+ * @class ChartStream
+ * @brief Sliding window of the latest points of a series
+ *
+ * push() may be called from one producer thread at a time; everything
+ * else belongs to the thread that owns the Chart.
+ *
+ * Example:
+ * @code
+ * auto stream = std::make_shared<ChartStream>(10000);
+ * chart.addSeries(ChartSeries("cpu", "CPU")).streamSeries("cpu", stream);
+ *
+ * // Producer thread
+ * stream->push(time, load);
+ *
+ * // UI thread, once per frame
+ * if (chart.updateStreams()) { ... redraw ... }
+ * @endcode
+ */
+class ChartStream {
+public:
+    /**
+     * @brief Create a stream
+     * @param capacity Number of points kept in the window (at least 1)
+     * @param stagingCapacity Points that may wait for update(); 0 uses the
+     *        window capacity. Rounded up to a power of two.
+     */
+    explicit ChartStream(size_t capacity, size_t stagingCapacity = 0);
+
+    ChartStream(const ChartStream&) = delete;
+    ChartStream& operator=(const ChartStream&) = delete;
+
+    // =========================================================================
+    // Producer
+    // =========================================================================
+
+    /**
+     * @brief Queue a point for the window
+     * @return false if the staging queue is full and the point was dropped
+     */
+    bool push(double x, double y);
+
+    /**
+     * @brief Queue a batch of points
+     * @return Number of points queued; the rest did not fit and were dropped
+     */
+    size_t push(const std::vector<DataPoint>& points);
+
+    /**
+     * @brief Number of points dropped because the staging queue was full
+     */
+    [[nodiscard]] uint64_t getDroppedCount() const { return m_dropped.load(std::memory_order_relaxed); }
+
+    // =========================================================================
+    // Window
+    // =========================================================================
+
+    /**
+     * @brief Move queued points into the window
+     * @return Number of points added
+     */
+    size_t update();
+
+    /**
+     * @brief Empty the window (points still queued arrive on the next update())
+     */
+    void clear();
+
+    [[nodiscard]] size_t size() const { return m_size; }
+    [[nodiscard]] size_t capacity() const { return m_x.size(); }
+    [[nodiscard]] bool empty() const { return m_size == 0; }
+
+    /**
+     * @brief Number of points ever added to the window
+     *
+     * Changes whenever points arrive, so it can tell if a redraw is due.
+     */
+    [[nodiscard]] uint64_t getTotalCount() const { return m_total; }
+
+    /**
+     * @brief Get a point's x value
+     * @param index Position in the window, 0 being the oldest point
+     */
+    [[nodiscard]] double x(size_t index) const { return m_x[slot(m_total - m_size + index)]; }
+
+    /**
+     * @brief Get a point's y value
+     * @param index Position in the window, 0 being the oldest point
+     */
+    [[nodiscard]] double y(size_t index) const { return m_y[slot(m_total - m_size + index)]; }
+
+    /**
+     * @brief Get the range of the points in the window, in O(1)
+     *
+     * NaN values are left out.
+     *
+     * @return false if the window holds no x or no y values
+     */
+    bool getRange(double& minX, double& maxX, double& minY, double& maxY) const;
+
+    /**
+     * @brief Copy the window, oldest point first
+     */
+    void copyTo(std::vector<DataPoint>& points) const;
+
+private:
+    /**
+     * @brief Points of the window, by sequence number, whose values are
+     *        each better than every later one's
+     */
+    struct ExtremeQueue {
+        std::vector<uint64_t> items;        ///< Ring of sequence numbers
+        size_t head = 0;
+        size_t count = 0;
+
+        [[nodiscard]] uint64_t front() const { return items[head]; }
+        [[nodiscard]] uint64_t back() const { return items[(head + count - 1) % items.size()]; }
+        void pushBack(uint64_t sequence) { items[(head + count++) % items.size()] = sequence; }
+        void popBack() { count--; }
+        void popFront() {
+            head = (head + 1) % items.size();
+            count--;
+        }
+    };
+
+    struct Sample {
+        double x;
+        double y;
+    };
+
+    [[nodiscard]] size_t slot(uint64_t sequence) const { return static_cast<size_t>(sequence % m_x.size()); }
+    void add(double x, double y);
+
+    // Window
+    std::vector<double> m_x;
+    std::vector<double> m_y;
+    uint64_t m_total = 0;                    ///< Sequence number of the next point
+    size_t m_size = 0;
+    ExtremeQueue m_lowX;
+    ExtremeQueue m_highX;
+    ExtremeQueue m_lowY;
+    ExtremeQueue m_highY;
+
+    // Staging: single producer, single consumer
+    std::vector<Sample> m_staging;
+    size_t m_stagingMask = 0;
+    alignas(64) std::atomic<size_t> m_stagingTail{0};   ///< Written by the producer
+    alignas(64) std::atomic<size_t> m_stagingHead{0};   ///< Written by update()
+    std::atomic<uint64_t> m_dropped{0};
+};
+
+} // namespace KillerGK
@@ -88,23 +88,253 @@ struct DataGridRow {
     }
 };
 
+/**
+ * @enum FilterOp
+ * @brief Operation of a DataGridFilterExpr node
+ */
+enum class FilterOp {
+    Equal,
+    NotEqual,
+    Less,
+    LessEqual,
+    Greater,
+    GreaterEqual,
+    Between,    ///< Inclusive range of two operands
+    In,         ///< Equal to any operand
+    Prefix,     ///< Text starting with the operand
+    Regex,      ///< Text containing a match of the operand (ECMAScript syntax)
+    And,        ///< All children match
+    Or          ///< Any child matches
+};
+
+/**
+ * @struct DataGridFilterExpr
+ * @brief Typed filter predicate over grid columns
+ *
+ * Number, integer and boolean operands compare numerically with number,
+ * integer and boolean cells (booleans as 0/1); text operands compare with
+ * text cells. A row whose cell is missing or holds the other kind of value
+ * does not match. Expressions are compiled per column and evaluated over
+ * whole columns at a time.
+ *
+ * Example:
+ * @code
+ * using F = DataGridFilterExpr;
+ * grid.setFilter("slow", F::greater("latency", 250) && F::prefix("host", "eu-"));
+ * @endcode
+ */
+struct DataGridFilterExpr {
+    FilterOp op = FilterOp::And;
+    std::string columnId;                     ///< Column of a comparison
+    std::vector<CellValue> operands;          ///< One, two for Between, the set for In
+    std::vector<DataGridFilterExpr> children; ///< Operands of And / Or
+
+    static DataGridFilterExpr compare(FilterOp op, std::string columnId, std::vector<CellValue> operands) {
+        DataGridFilterExpr expr;
+        expr.op = op;
+        expr.columnId = std::move(columnId);
+        expr.operands = std::move(operands);
+        return expr;
+    }
+
+    static DataGridFilterExpr equal(std::string columnId, CellValue value) {
+        return compare(FilterOp::Equal, std::move(columnId), {std::move(value)});
+    }
+    static DataGridFilterExpr notEqual(std::string columnId, CellValue value) {
+        return compare(FilterOp::NotEqual, std::move(columnId), {std::move(value)});
+    }
+    static DataGridFilterExpr less(std::string columnId, CellValue value) {
+        return compare(FilterOp::Less, std::move(columnId), {std::move(value)});
+    }
+    static DataGridFilterExpr lessEqual(std::string columnId, CellValue value) {
+        return compare(FilterOp::LessEqual, std::move(columnId), {std::move(value)});
+    }
+    static DataGridFilterExpr greater(std::string columnId, CellValue value) {
+        return compare(FilterOp::Greater, std::move(columnId), {std::move(value)});
+    }
+    static DataGridFilterExpr greaterEqual(std::string columnId, CellValue value) {
+        return compare(FilterOp::GreaterEqual, std::move(columnId), {std::move(value)});
+    }
+    static DataGridFilterExpr between(std::string columnId, CellValue low, CellValue high) {
+        return compare(FilterOp::Between, std::move(columnId), {std::move(low), std::move(high)});
+    }
+    static DataGridFilterExpr in(std::string columnId, std::vector<CellValue> values) {
+        return compare(FilterOp::In, std::move(columnId), std::move(values));
+    }
+    static DataGridFilterExpr prefix(std::string columnId, std::string text) {
+        return compare(FilterOp::Prefix, std::move(columnId), {std::move(text)});
+    }
+    static DataGridFilterExpr regex(std::string columnId, std::string pattern) {
+        return compare(FilterOp::Regex, std::move(columnId), {std::move(pattern)});
+    }
+
+    static DataGridFilterExpr allOf(std::vector<DataGridFilterExpr> children) {
+        DataGridFilterExpr expr;
+        expr.op = FilterOp::And;
+        expr.children = std::move(children);
+        return expr;
+    }
+    static DataGridFilterExpr anyOf(std::vector<DataGridFilterExpr> children) {
+        DataGridFilterExpr expr;
+        expr.op = FilterOp::Or;
+        expr.children = std::move(children);
+        return expr;
+    }
+};
+
+inline DataGridFilterExpr operator&&(DataGridFilterExpr a, DataGridFilterExpr b) {
+    return DataGridFilterExpr::allOf({std::move(a), std::move(b)});
+}
+
+inline DataGridFilterExpr operator||(DataGridFilterExpr a, DataGridFilterExpr b) {
+    return DataGridFilterExpr::anyOf({std::move(a), std::move(b)});
+}
+
 /**
  * @struct DataGridFilter
  * @brief Filter configuration for a column
+ *
+ * Exactly one of filterText, customFilter and expression is set. For an
+ * expression, columnId is the name the filter was set under.
  */
 struct DataGridFilter {
     std::string columnId;
     std::string filterText;
     std::function<bool(const CellValue&)> customFilter;
+    std::shared_ptr<const DataGridFilterExpr> expression;
+};
+
+/**
+ * @struct DataGridSortKey
+ * @brief One column of a multi-column sort
+ */
+struct DataGridSortKey {
+    std::string columnId;
+    SortDirection direction = SortDirection::Ascending;
+    
+    bool operator==(const DataGridSortKey& other) const = default;
+};
+
+/**
+ * @enum AggregateFunction
+ * @brief Summary computed over a column within each group
+ *
+ * Aggregates use numeric cells only (numbers, integers, and booleans as
+ * 0/1); text and missing cells are skipped.
+ */
+enum class AggregateFunction {
+    Count,      ///< Number of numeric cells
+    Sum,
+    Average,
+    Min,
+    Max
+};
+
+/**
+ * @struct DataGridAggregate
+ * @brief An aggregate to maintain per group
+ */
+struct DataGridAggregate {
+    std::string columnId;
+    AggregateFunction function = AggregateFunction::Sum;
+    
+    bool operator==(const DataGridAggregate& other) const = default;
+};
+
+/**
+ * @struct DataGridGroup
+ * @brief A group of displayed rows sharing a value in the group column
+ */
+struct DataGridGroup {
+    CellValue key;                   ///< Shared value (empty string if hasKey is false)
+    bool hasKey = true;              ///< false for rows without a cell in the group column
+    size_t rowCount = 0;             ///< Displayed rows in the group
+    std::vector<double> aggregates;  ///< One per aggregate; NaN when no numeric cells
+    bool collapsed = false;
+};
+
+/**
+ * @struct DataGridDisplayItem
+ * @brief A group header or a row in a grouped grid's display order
+ */
+struct DataGridDisplayItem {
+    bool isGroupHeader = false;
+    size_t groupIndex = 0;           ///< Index into getGroups()
+    DataGridRow row;                 ///< The row (data rows only)
 };
 
+/**
+ * @struct DataGridSelectionDelta
+ * @brief Rows whose selection changed in one operation
+ */
+struct DataGridSelectionDelta {
+    std::vector<std::string> added;      ///< Newly selected row ids
+    std::vector<std::string> removed;    ///< Newly deselected row ids
+};
+
+/**
+ * @struct DataGridQuery
+ * @brief Sort and filter state handed to a data source
+ */
+struct DataGridQuery {
+    std::vector<DataGridSortKey> sortKeys;   ///< In priority order; empty when unsorted
+    std::vector<DataGridFilter> filters;
+};
+
+/**
+ * @class DataGridDataSource
+ * @brief Pull-based row provider for datasets too large to hold in memory
+ *
+ * A DataGrid with a data source keeps only a window of rows around the
+ * visible range (plus a prefetch margin on each side) and asks the source
+ * for more as it scrolls. Row indices are positions in the source's current
+ * display order, after any sorting and filtering it applies.
+ */
+class DataGridDataSource {
+public:
+    static constexpr size_t NOT_FOUND = static_cast<size_t>(-1);
+
+    virtual ~DataGridDataSource() = default;
+
+    /**
+     * @brief Number of rows after the current query
+     */
+    [[nodiscard]] virtual size_t rowCount() const = 0;
+
+    /**
+     * @brief Fetch rows in display order
+     * @param first Index of the first row
+     * @param count Number of rows (may be cut short at the end)
+     */
+    virtual std::vector<DataGridRow> fetchRows(size_t first, size_t count) = 0;
+
+    /**
+     * @brief Apply the grid's sort and filters on the source side
+     *
+     * Called whenever they change. The default ignores them, in which case
+     * rows are shown in the source's own order.
+     */
+    virtual void setQuery(const DataGridQuery& query) { (void)query; }
+
+    /**
+     * @brief Find a row's index (used by scrollToRow)
+     * @return Row index or NOT_FOUND if unknown
+     */
+    [[nodiscard]] virtual size_t indexOf(const std::string& id) const {
+        (void)id;
+        return NOT_FOUND;
+    }
+};
+
+struct DataGridBatch;  // Column-form rows for bulk appends (DataGridStore.hpp)
 
 /**
  * @class DataGrid
  * @brief Table widget with sorting, filtering, column resizing, and virtual scrolling
  * 
  * Supports large datasets through virtual scrolling, multi-column sorting,
- * text filtering, and customizable cell rendering.
+ * text filtering, and customizable cell rendering. Rows are either held by
+ * the grid or pulled on demand from a DataGridDataSource.
  * 
  * Example:
  * @code
@@ -193,6 +423,9 @@ public:
 
     /**
      * @brief Set rows from a vector
+     *
+     * Detaches any data source.
+     *
      * @param rows Vector of DataGridRow
      * @return Reference to this DataGrid for chaining
      */
@@ -205,6 +438,17 @@ public:
      */
     DataGrid& addRow(const DataGridRow& row);
 
+    /**
+     * @brief Append many rows stored by column
+     *
+     * Used by bulk loaders such as DataGridCsvLoader. A sorted grid merges
+     * the new rows into its display order instead of resorting.
+     *
+     * @param batch Rows to append
+     * @return Reference to this DataGrid for chaining
+     */
+    DataGrid& appendRows(const DataGridBatch& batch);
+
     /**
      * @brief Remove row by id
      * @param id Row identifier
@@ -220,23 +464,72 @@ public:
 
     /**
      * @brief Get all rows (unfiltered, unsorted)
+     *
+     * Rows are stored by column internally; this materializes a row view,
+     * which is rebuilt after the data changes. With a data source, only the
+     * rows currently fetched are returned.
+     *
      * @return Vector of all rows
      */
     [[nodiscard]] const std::vector<DataGridRow>& getRows() const;
 
     /**
      * @brief Get displayed rows (filtered and sorted)
+     *
+     * Copies every displayed row; with a data source this fetches the whole
+     * dataset. Prefer getDisplayedRowRange() or getVisibleRows().
+     *
      * @return Vector of displayed rows
      */
     [[nodiscard]] std::vector<DataGridRow> getDisplayedRows() const;
 
+    /**
+     * @brief Get a range of displayed rows
+     * @param first Display index of the first row
+     * @param count Number of rows (cut short at the end)
+     * @return Copies of the rows in display order
+     */
+    [[nodiscard]] std::vector<DataGridRow> getDisplayedRowRange(size_t first, size_t count) const;
+
+    /**
+     * @brief Get the rows in the visible range
+     *
+     * When grouped, these are the rows among the visible display items.
+     *
+     * @return Copies of the visible rows in display order
+     */
+    [[nodiscard]] std::vector<DataGridRow> getVisibleRows() const;
+
     /**
      * @brief Get row by id
+     *
+     * Returns an editable view of the row. Changes made through it are
+     * applied by the next call that reads or changes the grid's rows, and
+     * that call also invalidates the pointer: call getRow() again to edit
+     * the row further.
+     *
      * @param id Row identifier
      * @return Pointer to row or nullptr
      */
     [[nodiscard]] DataGridRow* getRow(const std::string& id);
 
+    /**
+     * @brief Set a single cell without going through a row view
+     * @param rowId Row identifier
+     * @param columnId Column identifier
+     * @param value New cell value
+     * @return Reference to this DataGrid for chaining
+     */
+    DataGrid& setCell(const std::string& rowId, const std::string& columnId, const CellValue& value);
+
+    /**
+     * @brief Get a single cell
+     * @param rowId Row identifier
+     * @param columnId Column identifier
+     * @return Cell value, or an empty string if the row or cell does not exist
+     */
+    [[nodiscard]] CellValue getCell(const std::string& rowId, const std::string& columnId) const;
+
     /**
      * @brief Get total row count
      * @return Number of rows
@@ -249,6 +542,135 @@ public:
      */
     [[nodiscard]] size_t getFilteredRowCount() const;
 
+    // =========================================================================
+    // Grouping
+    // =========================================================================
+
+    /**
+     * @brief Group displayed rows by a column's value
+     *
+     * Groups are listed in the column's sort direction if it is a sort key,
+     * ascending otherwise; rows keep the grid's sort order within a group.
+     * Aggregates are updated as rows are added, removed, edited or filtered
+     * rather than recomputed. Grouping does not apply to data sources.
+     *
+     * @param columnId Column to group by, or empty to stop grouping
+     * @return Reference to this DataGrid for chaining
+     */
+    DataGrid& groupBy(const std::string& columnId);
+
+    /**
+     * @brief Stop grouping
+     * @return Reference to this DataGrid for chaining
+     */
+    DataGrid& clearGrouping();
+
+    /**
+     * @brief Get the group column
+     * @return Column id or empty string
+     */
+    [[nodiscard]] const std::string& getGroupColumn() const;
+
+    /**
+     * @brief Set the aggregates maintained for each group
+     * @param aggregates Aggregates, reported in this order
+     * @return Reference to this DataGrid for chaining
+     */
+    DataGrid& aggregates(const std::vector<DataGridAggregate>& aggregates);
+
+    /**
+     * @brief Get the aggregates
+     * @return Aggregates in report order
+     */
+    [[nodiscard]] const std::vector<DataGridAggregate>& getAggregates() const;
+
+    /**
+     * @brief Get the non-empty groups in display order
+     * @return Groups with their row counts and aggregates
+     */
+    [[nodiscard]] std::vector<DataGridGroup> getGroups() const;
+
+    /**
+     * @brief Collapse or expand the group with a given value
+     * @param key Group value
+     * @param collapsed Whether the group's rows are hidden
+     * @return Reference to this DataGrid for chaining
+     */
+    DataGrid& collapseGroup(const CellValue& key, bool collapsed = true);
+
+    /**
+     * @brief Expand the group with a given value
+     * @param key Group value
+     * @return Reference to this DataGrid for chaining
+     */
+    DataGrid& expandGroup(const CellValue& key);
+
+    /**
+     * @brief Check if a group is collapsed
+     * @param key Group value
+     * @return true if collapsed
+     */
+    [[nodiscard]] bool isGroupCollapsed(const CellValue& key) const;
+
+    /**
+     * @brief Get the number of display items (group headers and rows of expanded groups)
+     * @return Item count, or the displayed row count when not grouped
+     */
+    [[nodiscard]] size_t getDisplayedItemCount() const;
+
+    /**
+     * @brief Get a range of display items
+     *
+     * When not grouped every item is a row.
+     *
+     * @param first Index of the first item
+     * @param count Number of items (cut short at the end)
+     * @return Items in display order
+     */
+    [[nodiscard]] std::vector<DataGridDisplayItem> getDisplayedItems(size_t first, size_t count) const;
+
+    // =========================================================================
+    // Data Source
+    // =========================================================================
+
+    /**
+     * @brief Pull rows from a data source instead of holding them
+     *
+     * The grid then holds only the rows around the visible range, fetching
+     * more as it scrolls. Sorting and filtering are passed to the source via
+     * DataGridDataSource::setQuery(). Row editing functions (addRow, setCell,
+     * getRow edits) apply to the grid's own rows and do not reach the source.
+     *
+     * @param source Data source, or nullptr to show the grid's own rows again
+     * @return Reference to this DataGrid for chaining
+     */
+    DataGrid& dataSource(std::shared_ptr<DataGridDataSource> source);
+
+    /**
+     * @brief Get the data source
+     * @return Data source or nullptr
+     */
+    [[nodiscard]] std::shared_ptr<DataGridDataSource> getDataSource() const;
+
+    /**
+     * @brief Set how many rows to fetch beyond each side of a requested range
+     * @param count Number of rows
+     * @return Reference to this DataGrid for chaining
+     */
+    DataGrid& prefetchRows(size_t count);
+
+    /**
+     * @brief Get the prefetch margin
+     * @return Number of rows
+     */
+    [[nodiscard]] size_t getPrefetchRows() const;
+
+    /**
+     * @brief Drop fetched rows after the source's data changed
+     * @return Reference to this DataGrid for chaining
+     */
+    DataGrid& refreshDataSource();
+
     // =========================================================================
     // Sorting
     // =========================================================================
@@ -256,11 +678,31 @@ public:
     /**
      * @brief Sort by column
      * @param columnId Column to sort by
-     * @param direction Sort direction
+     * @param direction Sort direction (None clears sorting)
      * @return Reference to this DataGrid for chaining
      */
     DataGrid& sortBy(const std::string& columnId, SortDirection direction);
 
+    /**
+     * @brief Sort by several columns
+     *
+     * Rows are ordered by the first key, ties by the second, and so on;
+     * rows equal on every key keep their original order. Keys with
+     * SortDirection::None and repeated columns are ignored.
+     *
+     * @param keys Sort keys in priority order
+     * @return Reference to this DataGrid for chaining
+     */
+    DataGrid& sortBy(const std::vector<DataGridSortKey>& keys);
+
+    /**
+     * @brief Add a lower-priority sort key, or change an existing key's direction
+     * @param columnId Column to sort by
+     * @param direction Sort direction (None removes the key)
+     * @return Reference to this DataGrid for chaining
+     */
+    DataGrid& thenBy(const std::string& columnId, SortDirection direction);
+
     /**
      * @brief Clear sorting
      * @return Reference to this DataGrid for chaining
@@ -268,17 +710,36 @@ public:
     DataGrid& clearSort();
 
     /**
-     * @brief Get current sort column
+     * @brief Get current primary sort column
      * @return Column id being sorted or empty string
      */
     [[nodiscard]] const std::string& getSortColumn() const;
 
     /**
-     * @brief Get current sort direction
+     * @brief Get current primary sort direction
      * @return Current sort direction
      */
     [[nodiscard]] SortDirection getSortDirection() const;
 
+    /**
+     * @brief Get all sort keys
+     * @return Sort keys in priority order
+     */
+    [[nodiscard]] const std::vector<DataGridSortKey>& getSortKeys() const;
+
+    /**
+     * @brief Limit the threads used to sort large grids
+     * @param count Maximum threads (0 for one per core, 1 to sort on the calling thread)
+     * @return Reference to this DataGrid for chaining
+     */
+    DataGrid& sortThreads(size_t count);
+
+    /**
+     * @brief Get the sort thread limit
+     * @return Maximum threads, 0 meaning one per core
+     */
+    [[nodiscard]] size_t getSortThreads() const;
+
     // =========================================================================
     // Filtering
     // =========================================================================
@@ -299,6 +760,19 @@ public:
      */
     DataGrid& setFilter(const std::string& columnId, std::function<bool(const CellValue&)> filter);
 
+    /**
+     * @brief Set a typed filter expression
+     *
+     * Unlike text and custom filters, an expression may test several
+     * columns, and rows without a tested cell don't match it. It replaces
+     * any filter set under the same name.
+     *
+     * @param name Name to set the filter under (usually a column id)
+     * @param expression Predicate rows must match
+     * @return Reference to this DataGrid for chaining
+     */
+    DataGrid& setFilter(const std::string& name, const DataGridFilterExpr& expression);
+
     /**
      * @brief Clear filter for a column
      * @param columnId Column to clear filter for
@@ -343,6 +817,19 @@ public:
      */
     DataGrid& selectRow(const std::string& id, bool addToSelection = false);
 
+    /**
+     * @brief Select the displayed rows between two display indices (inclusive)
+     *
+     * Indices may be given in either order, as for a shift-click from an
+     * anchor row. Without multi-select only the row at lastIndex is selected.
+     *
+     * @param firstIndex Display index of one end of the range
+     * @param lastIndex Display index of the other end
+     * @param addToSelection Whether to keep rows selected outside the range
+     * @return Reference to this DataGrid for chaining
+     */
+    DataGrid& selectRange(size_t firstIndex, size_t lastIndex, bool addToSelection = false);
+
     /**
      * @brief Deselect row by id
      * @param id Row identifier
@@ -356,6 +843,13 @@ public:
      */
     DataGrid& clearSelection();
 
+    /**
+     * @brief Check if a row is selected
+     * @param id Row identifier
+     * @return true if the row is selected
+     */
+    [[nodiscard]] bool isRowSelected(const std::string& id) const;
+
     /**
      * @brief Get selected row ids
      * @return Vector of selected row ids
@@ -420,6 +914,9 @@ public:
 
     /**
      * @brief Get visible row range for virtual scrolling
+     *
+     * When grouped, the range indexes display items (see getDisplayedItems()).
+     *
      * @param startIndex Output: first visible row index
      * @param endIndex Output: last visible row index (exclusive)
      */
@@ -525,6 +1022,17 @@ public:
      */
     DataGrid& onSelectionChange(std::function<void(const std::vector<std::string>&)> callback);
 
+    /**
+     * @brief Set selection delta callback
+     *
+     * Called with only the rows whose selection changed, after each
+     * operation that changed any.
+     *
+     * @param callback Function called when selection changes
+     * @return Reference to this DataGrid for chaining
+     */
+    DataGrid& onSelectionDelta(std::function<void(const DataGridSelectionDelta&)> callback);
+
     /**
      * @brief Set row double-click callback
      * @param callback Function called on row double-click
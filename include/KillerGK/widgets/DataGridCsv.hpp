@@ -0,0 +1,116 @@
+/**
+ * @file DataGridCsv.hpp
+ * @brief Streaming CSV/TSV loading into a DataGrid
+ *
+ * The file is memory-mapped and parsed on a background thread into batches
+ * of rows stored by column. The UI thread appends finished batches to the
+ * grid as they arrive, so the first screen of a large file is shown long
+ * before the rest has been read.
+ */
+
+#pragma once
+
+#include "DataGrid.hpp"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace KillerGK {
+
+/**
+ * @struct CsvLoadOptions
+ * @brief How a delimited text file is read
+ */
+struct CsvLoadOptions {
+    char delimiter = '\0';          ///< Field separator; '\0' picks tab for .tsv/.tab files, comma otherwise
+    bool hasHeader = true;          ///< First record holds the column names
+    std::string idColumn;           ///< Column whose values become row ids; record numbers otherwise
+    size_t inferRows = 1000;        ///< Records sampled to infer column types
+    size_t chunkRows = 16384;       ///< Rows in the first batch; later ones grow with the rows loaded
+    size_t maxQueuedChunks = 4;     ///< Parsed batches held before the parser waits
+};
+
+/**
+ * @class DataGridCsvLoader
+ * @brief Loads a CSV or TSV file into a DataGrid in chunks
+ *
+ * Fields follow RFC 4180: quoted fields may contain delimiters, line breaks
+ * and doubled quotes; records end with LF or CRLF. Column types are
+ * inferred from the first records: Boolean (true/false), Number, Date
+ * (ISO 8601, kept as text so it sorts chronologically) or String. Values
+ * that don't fit their column's type later in the file are kept as text,
+ * except that a fraction in a column sampled as whole numbers turns all of
+ * that column's numbers, already loaded ones included, into doubles.
+ *
+ * Example:
+ * @code
+ * DataGridCsvLoader loader;
+ * if (loader.open("trades.csv")) {
+ *     grid.columns(loader.getColumns());
+ * }
+ * // Every frame:
+ * loader.appendTo(grid);
+ * @endcode
+ */
+class DataGridCsvLoader {
+public:
+    DataGridCsvLoader();
+    ~DataGridCsvLoader();
+
+    DataGridCsvLoader(const DataGridCsvLoader&) = delete;
+    DataGridCsvLoader& operator=(const DataGridCsvLoader&) = delete;
+
+    /**
+     * @brief Map a file, read its header, infer column types and start parsing
+     * @param path File path
+     * @param options Parsing options
+     * @return true on success; false if the file can't be opened or is empty
+     */
+    bool open(const std::string& path, const CsvLoadOptions& options = {});
+
+    /**
+     * @brief Stop parsing and release the file
+     */
+    void close();
+
+    /**
+     * @brief Get the columns found in the file, with inferred types
+     */
+    [[nodiscard]] const std::vector<DataGridColumn>& getColumns() const;
+
+    /**
+     * @brief Append the rows parsed so far to a grid, without waiting
+     * @param grid Grid to fill
+     * @return Number of rows appended by this call
+     */
+    size_t appendTo(DataGrid& grid);
+
+    /**
+     * @brief Append all remaining rows, waiting for the parser to finish
+     * @param grid Grid to fill
+     * @return Number of rows appended by this call
+     */
+    size_t finish(DataGrid& grid);
+
+    /**
+     * @brief Check if every row has been appended
+     */
+    [[nodiscard]] bool isFinished() const;
+
+    /**
+     * @brief Fraction of the file parsed so far (0 to 1)
+     */
+    [[nodiscard]] float getProgress() const;
+
+    /**
+     * @brief Number of rows appended so far
+     */
+    [[nodiscard]] size_t getRowsAppended() const;
+
+private:
+    struct LoaderData;
+    std::unique_ptr<LoaderData> m_data;
+};
+
+} // namespace KillerGK
@@ -0,0 +1,315 @@
+/**
+ * @file DataGridStore.hpp
+ * @brief Columnar cell storage backing the DataGrid widget
+ *
+ * Rows are stored column by column: each column keeps one kind tag and one
+ * 64-bit payload per row, addressed by column ordinal rather than by id.
+ * Text cells hold ids into a shared string pool, so repeated values are
+ * stored once and can be compared, filtered and ranked per distinct string.
+ */
+
+#pragma once
+
+#include "DataGrid.hpp"
+#include <any>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace KillerGK {
+
+/**
+ * @class StringPool
+ * @brief Interns strings so equal text is stored once and referenced by id
+ *
+ * Strings are reference counted. One no longer referenced keeps its id (so
+ * tables indexed by id stay valid) until compact() drops it.
+ */
+class StringPool {
+public:
+    static constexpr uint32_t DROPPED = static_cast<uint32_t>(-1);
+
+    /**
+     * @brief Get the id for a string, adding it if new, and take a reference
+     */
+    uint32_t intern(std::string_view text);
+
+    void addRef(uint32_t id);
+    void release(uint32_t id);
+
+    /**
+     * @brief Get the string for an id
+     */
+    [[nodiscard]] const std::string& get(uint32_t id) const { return m_strings[id]; }
+
+    /**
+     * @brief Number of distinct strings, including those no longer referenced
+     */
+    [[nodiscard]] size_t size() const { return m_strings.size(); }
+
+    /**
+     * @brief Number of strings no longer referenced
+     */
+    [[nodiscard]] size_t deadCount() const { return m_dead; }
+
+    /**
+     * @brief Drop the strings no longer referenced, renumbering the others
+     * @return New id per old id, DROPPED for dropped strings
+     */
+    std::vector<uint32_t> compact();
+
+    void clear();
+
+private:
+    std::deque<std::string> m_strings;                      ///< Stable addresses for the view keys
+    std::vector<uint32_t> m_refs;                           ///< Per id
+    std::unordered_map<std::string_view, uint32_t> m_ids;
+    size_t m_dead = 0;
+};
+
+/**
+ * @enum CellKind
+ * @brief Which CellValue alternative a stored cell holds
+ */
+enum class CellKind : uint8_t {
+    Empty,      ///< No value for this column in this row
+    String,
+    Number,     ///< double
+    Boolean,
+    Integer     ///< int64_t
+};
+
+/**
+ * @struct DataGridBatch
+ * @brief Rows laid out by column, for appending many rows at once
+ *
+ * Built by bulk loaders without creating a DataGridRow per record. Text
+ * cells refer to (offset, length) spans of the batch's text buffer; cells
+ * with equal text may share a span. Spans are interned when the batch is
+ * appended.
+ */
+struct DataGridBatch {
+    struct Column {
+        std::string id;
+        std::vector<CellKind> kinds;     ///< One per row
+        std::vector<uint64_t> payload;   ///< Value bits, or an index into spans for text
+        bool widened = false;            ///< Integer cells, also those already stored, become Number
+    };
+
+    std::vector<std::string> rowIds;
+    std::vector<Column> columns;
+    std::string text;                                   ///< Bytes of all text cells
+    std::vector<std::pair<size_t, size_t>> spans;       ///< (offset, length) into text
+
+    [[nodiscard]] size_t rowCount() const { return rowIds.size(); }
+
+    /**
+     * @brief Store a text cell's bytes and get its payload
+     */
+    uint64_t addText(std::string_view value) {
+        spans.emplace_back(text.size(), value.size());
+        text.append(value);
+        return spans.size() - 1;
+    }
+
+    [[nodiscard]] std::string_view getText(uint64_t payload) const {
+        const auto& [offset, length] = spans[payload];
+        return std::string_view(text).substr(offset, length);
+    }
+};
+
+/**
+ * @class DataGridStore
+ * @brief Column-oriented storage for DataGrid rows
+ *
+ * Columns are created on demand for every cell id that appears in a row,
+ * independently of the grid's visible column definitions. Row ids,
+ * selection and enabled flags and user data are stored alongside.
+ */
+class DataGridStore {
+public:
+    static constexpr size_t NO_COLUMN = static_cast<size_t>(-1);
+    static constexpr uint32_t UNRANKED = static_cast<uint32_t>(-1);
+    static constexpr size_t COMPACT_MIN_DEAD = 1024;    ///< Dead strings tolerated before compacting
+
+    /**
+     * @brief Cells of one column, one entry per row
+     */
+    struct Column {
+        std::string id;
+        std::vector<CellKind> kinds;
+        std::vector<uint64_t> payload;   ///< Bits of the value, interpreted by kind
+
+        [[nodiscard]] double number(size_t row) const;
+        [[nodiscard]] int64_t integer(size_t row) const { return static_cast<int64_t>(payload[row]); }
+        [[nodiscard]] bool boolean(size_t row) const { return payload[row] != 0; }
+        [[nodiscard]] uint32_t stringId(size_t row) const { return static_cast<uint32_t>(payload[row]); }
+    };
+
+    // =========================================================================
+    // Rows
+    // =========================================================================
+
+    [[nodiscard]] size_t rowCount() const { return m_rowIds.size(); }
+
+    /**
+     * @brief Replace all rows
+     */
+    void assign(const std::vector<DataGridRow>& rows);
+
+    /**
+     * @brief Append a row
+     */
+    void append(const DataGridRow& row);
+
+    /**
+     * @brief Append all rows of a batch
+     */
+    void append(const DataGridBatch& batch);
+
+    /**
+     * @brief Overwrite a row in place
+     * @return true if anything about the row changed
+     */
+    bool replace(size_t row, const DataGridRow& value);
+
+    /**
+     * @brief Remove every row matching a predicate, keeping the others in order
+     * @return Number of rows removed
+     */
+    size_t removeIf(const std::function<bool(size_t row)>& predicate);
+
+    void clear();
+
+    /**
+     * @brief Build a DataGridRow view of a stored row
+     */
+    [[nodiscard]] DataGridRow makeRow(size_t row) const;
+
+    [[nodiscard]] const std::string& rowId(size_t row) const { return m_rowIds[row]; }
+    [[nodiscard]] bool isSelected(size_t row) const { return m_selected[row] != 0; }
+    void setSelected(size_t row, bool selected) { m_selected[row] = selected ? 1 : 0; }
+    [[nodiscard]] bool isEnabled(size_t row) const { return m_enabled[row] != 0; }
+
+    // =========================================================================
+    // Columns and cells
+    // =========================================================================
+
+    [[nodiscard]] size_t columnCount() const { return m_columns.size(); }
+
+    /**
+     * @brief Get a column's ordinal
+     * @return Ordinal or NO_COLUMN if no row has ever had a cell for it
+     */
+    [[nodiscard]] size_t findColumn(const std::string& id) const;
+
+    /**
+     * @brief Get a column's ordinal, creating an empty column if needed
+     */
+    size_t ensureColumn(const std::string& id);
+
+    [[nodiscard]] const Column& column(size_t ordinal) const { return m_columns[ordinal]; }
+
+    [[nodiscard]] CellKind kind(size_t row, size_t ordinal) const { return m_columns[ordinal].kinds[row]; }
+
+    /**
+     * @brief Get a cell as a CellValue (empty cells read as an empty string)
+     */
+    [[nodiscard]] CellValue getCell(size_t row, size_t ordinal) const;
+
+    /**
+     * @brief Write a cell
+     * @return true if its value changed
+     */
+    bool setCell(size_t row, size_t ordinal, const CellValue& value);
+    void clearCell(size_t row, size_t ordinal);
+
+    // =========================================================================
+    // Strings
+    // =========================================================================
+
+    [[nodiscard]] const StringPool& strings() const { return m_strings; }
+
+    /**
+     * @brief Rank the distinct strings of a column in lexicographic order
+     *
+     * Returns a table indexed by string id; equal strings share a rank and
+     * ids not used by the column are UNRANKED. Sorting by rank orders rows
+     * exactly as comparing their text would, at the cost of sorting each
+     * distinct string once.
+     */
+    [[nodiscard]] std::vector<uint32_t> rankStrings(size_t ordinal) const;
+
+    /**
+     * @brief Drop strings no longer in any cell once they outnumber the live ones
+     *
+     * Overwritten and removed text otherwise stays in the pool, and tables
+     * sized to the pool (ranks, per-string filter results) grow with it.
+     *
+     * @return true if the pool was compacted: string ids have changed
+     */
+    bool compactStrings();
+
+private:
+    bool writeCell(Column& column, size_t row, const CellValue& value);  ///< true if the cell changed
+    void releaseCell(const Column& column, size_t row);
+
+    std::vector<std::string> m_rowIds;
+    std::vector<uint8_t> m_selected;
+    std::vector<uint8_t> m_enabled;
+    std::vector<std::any> m_userData;
+
+    std::vector<Column> m_columns;
+    std::unordered_map<std::string, size_t> m_columnOrdinals;
+    StringPool m_strings;
+};
+
+/**
+ * @class DataGridFilterProgram
+ * @brief A DataGridFilterExpr compiled against a store's columns
+ *
+ * Each comparison is specialised for its operation and the kind of cell it
+ * reads: numeric tests run directly on the column payload, and text tests
+ * are decided once per distinct string and then looked up by string id.
+ * Columns are bound on first use, so an expression may name columns that
+ * no row has yet.
+ */
+class DataGridFilterProgram {
+public:
+    struct Node;  ///< Compiled expression node
+
+    explicit DataGridFilterProgram(const DataGridFilterExpr& expression);
+    ~DataGridFilterProgram();
+
+    DataGridFilterProgram(DataGridFilterProgram&&) noexcept;
+    DataGridFilterProgram& operator=(DataGridFilterProgram&&) noexcept;
+
+    /**
+     * @brief Test one row
+     */
+    bool matches(const DataGridStore& store, size_t row);
+
+    /**
+     * @brief Test many rows
+     * @param rows Row indices, or nullptr for rows 0 to count - 1
+     * @param count Number of rows
+     * @param out One byte per row: 1 if it matches, 0 otherwise
+     */
+    void evaluate(const DataGridStore& store, const size_t* rows, size_t count, uint8_t* out);
+
+    /**
+     * @brief Forget per-string results (after the store's strings were cleared or compacted)
+     */
+    void reset();
+
+private:
+    std::unique_ptr<Node> m_root;
+};
+
+} // namespace KillerGK
@@ -26,6 +26,8 @@ struct TextSelection {
     [[nodiscard]] size_t length() const { return end > start ? end - start : start - end; }
     [[nodiscard]] size_t min() const { return start < end ? start : end; }
     [[nodiscard]] size_t max() const { return start > end ? start : end; }
+    
+    bool operator==(const TextSelection& other) const = default;
 };
 
 /**
@@ -0,0 +1,185 @@
+/**
+ * @file TreeNodeStore.hpp
+ * @brief Node storage with a flat id index backing the TreeView widget
+ *
+ * Nodes stay in their nested TreeNode vectors, so pointers handed out by
+ * the TreeView behave as before. Alongside, a flat table gives every node a
+ * slot holding its parent's slot and its position among its siblings, and
+ * a hash maps ids to slots. A node is found by following its slots from the
+ * root, which also checks the path is still current.
+ */
+
+#pragma once
+
+#include "TreeView.hpp"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace KillerGK {
+
+/**
+ * @class TreeNodeStore
+ * @brief Root nodes plus an id → slot index over the whole tree
+ *
+ * Structural changes made through the store keep the index up to date in
+ * time proportional to the siblings shifted (and the subtree, for inserts
+ * and removals); moving a subtree leaves its descendants' slots untouched.
+ * After edits made directly on the nodes (markEdited()), a lookup that
+ * misses or lands on a different node rebuilds the index first; the
+ * rebuild covers those edits, so later misses are answered from the index
+ * until markEdited() is called again.
+ */
+class TreeNodeStore {
+public:
+    static constexpr uint32_t NO_NODE = static_cast<uint32_t>(-1);
+
+    /**
+     * @brief Where a node sits in the tree
+     */
+    struct Entry {
+        const std::string* id = nullptr;   ///< Key in the index; nullptr for a free slot
+        uint32_t parent = NO_NODE;         ///< Parent's slot, NO_NODE for roots
+        uint32_t position = 0;             ///< Index among the parent's children (or the roots)
+    };
+
+    // =========================================================================
+    // Nodes
+    // =========================================================================
+
+    [[nodiscard]] std::vector<TreeNode>& roots() { return m_roots; }
+    [[nodiscard]] const std::vector<TreeNode>& roots() const { return m_roots; }
+
+    /**
+     * @brief Replace all nodes
+     */
+    void assign(const std::vector<TreeNode>& roots);
+
+    void clear();
+
+    /**
+     * @brief Note that nodes may have been edited directly, through pointers
+     *
+     * Call it when a mutable pointer is handed out, after any lookup made
+     * to find it (a lookup may rebuild the index, which clears the mark).
+     */
+    void markEdited() { m_edited = true; }
+
+    /**
+     * @brief Number of nodes in the index
+     */
+    [[nodiscard]] size_t size() const { return m_index.size(); }
+
+    /**
+     * @brief Number of slots, free or in use (bound for per-slot tables)
+     */
+    [[nodiscard]] size_t slotCount() const { return m_entries.size(); }
+
+    /**
+     * @brief Count of index rebuilds; slots found before a rebuild are stale
+     */
+    [[nodiscard]] uint64_t generation() const { return m_generation; }
+
+    // =========================================================================
+    // Lookup
+    // =========================================================================
+
+    /**
+     * @brief Get a node's slot
+     * @return Slot or NO_NODE if no node has the id
+     */
+    uint32_t find(const std::string& id);
+
+    /**
+     * @brief Get the slot of a node reached by walking the tree
+     * @param node The node
+     * @param parent Slot of the node's parent, NO_NODE for roots
+     * @param position Index of the node among its siblings
+     * @return Slot or NO_NODE if the index is out of date
+     */
+    [[nodiscard]] uint32_t slotOf(const TreeNode& node, uint32_t parent, size_t position) const;
+
+    /**
+     * @brief Check the index matches the nodes, as far as the store knows
+     */
+    [[nodiscard]] bool isValid() const { return m_valid; }
+
+    /**
+     * @brief Re-index now if structural changes left the index out of date
+     */
+    void validate() {
+        if (!m_valid) rebuild();
+    }
+
+    /**
+     * @brief Re-index the whole tree (after the nodes were edited directly)
+     */
+    void reindex() { rebuild(); }
+
+    /**
+     * @brief Get the node in a slot
+     * @return Node or nullptr if the slot no longer matches the tree
+     */
+    [[nodiscard]] TreeNode* node(uint32_t slot);
+
+    [[nodiscard]] uint32_t parent(uint32_t slot) const { return m_entries[slot].parent; }
+    [[nodiscard]] uint32_t position(uint32_t slot) const { return m_entries[slot].position; }
+
+    /**
+     * @brief Number of ancestors of a node (0 for roots)
+     */
+    [[nodiscard]] size_t depth(uint32_t slot) const;
+
+    /**
+     * @brief Check if a node is an ancestor of another, or the node itself
+     */
+    [[nodiscard]] bool contains(uint32_t ancestor, uint32_t slot) const;
+
+    // =========================================================================
+    // Structure
+    // =========================================================================
+
+    /**
+     * @brief Insert a node with its subtree
+     * @param parent Parent's slot, NO_NODE for a root
+     * @param index Position among the siblings; out of range appends
+     * @return Slot of the inserted node
+     */
+    uint32_t insert(uint32_t parent, size_t index, TreeNode node);
+
+    /**
+     * @brief Remove a node with its subtree
+     * @param removedIds Receives the ids of every removed node (optional)
+     */
+    void remove(uint32_t slot, std::vector<std::string>* removedIds = nullptr);
+
+    /**
+     * @brief Move a node with its subtree under another parent
+     * @param parent New parent's slot, NO_NODE for the roots
+     * @param index Position among the new siblings; out of range appends
+     * @return false if the new parent is the node itself or one of its descendants
+     */
+    bool move(uint32_t slot, uint32_t parent, size_t index);
+
+private:
+    void rebuild();
+    uint32_t allocate(const std::string& id, uint32_t parent, uint32_t position);
+    void release(uint32_t slot);
+    uint32_t indexSubtree(const TreeNode& node, uint32_t parent, uint32_t position);
+    void releaseSubtree(uint32_t slot, const TreeNode& node, std::vector<std::string>* removedIds);
+    std::vector<TreeNode>& siblings(uint32_t parent);
+    void shiftSiblings(std::vector<TreeNode>& nodes, uint32_t parent, size_t from, int delta);
+
+    std::vector<TreeNode> m_roots;
+    std::vector<Entry> m_entries;
+    std::vector<uint32_t> m_freeSlots;
+    std::unordered_map<std::string, uint32_t> m_index;
+    std::vector<uint32_t> m_path;                 ///< Scratch for node()
+    uint64_t m_generation = 0;
+    bool m_valid = true;          ///< Index matches the nodes (as far as the store knows)
+    bool m_edited = false;        ///< Nodes were handed out for editing since the last rebuild
+    bool m_duplicates = false;    ///< Some ids occur more than once; only the first is indexed
+};
+
+} // namespace KillerGK
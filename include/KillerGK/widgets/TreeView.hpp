@@ -28,6 +28,7 @@ struct TreeNode {
     bool enabled = true;                 ///< Whether node is interactive
     bool draggable = true;               ///< Whether node can be dragged
     bool droppable = true;               ///< Whether items can be dropped on this node
+    bool childrenPending = false;        ///< Children are loaded on first expand (see TreeView::childLoader)
     std::vector<TreeNode> children;      ///< Child nodes
     std::any userData;                   ///< Custom user data
 
@@ -49,9 +50,9 @@ struct TreeNode {
 
     /**
      * @brief Check if node has children
-     * @return true if node has children
+     * @return true if node has children, or children still to be loaded
      */
-    [[nodiscard]] bool hasChildren() const { return !children.empty(); }
+    [[nodiscard]] bool hasChildren() const { return !children.empty() || childrenPending; }
 
     /**
      * @brief Find child by id (recursive)
@@ -91,6 +92,16 @@ struct TreeDragData {
 };
 
 
+/**
+ * @struct TreeRow
+ * @brief A displayed row: a node whose ancestors are all expanded
+ */
+struct TreeRow {
+    const TreeNode* node = nullptr;      ///< Node shown on the row
+    int depth = 0;                       ///< Number of ancestors, for indentation
+    bool matched = false;                ///< Matches the filter (false for ancestors shown with a match)
+};
+
 /**
  * @class TreeView
  * @brief Hierarchical tree widget with expand/collapse and drag-drop support
@@ -114,6 +125,7 @@ struct TreeDragData {
 class TreeView : public Widget {
 public:
     using NodeRenderer = std::function<void(const TreeNode&, int depth, bool selected, bool hovered)>;
+    using ChildLoader = std::function<std::vector<TreeNode>(const TreeNode&)>;
 
     virtual ~TreeView() = default;
 
@@ -162,12 +174,22 @@ public:
 
     /**
      * @brief Get mutable root nodes
+     *
+     * Nodes may be edited in place, including their children; the id index
+     * catches up on later lookups.
+     *
      * @return Vector of root nodes
      */
     [[nodiscard]] std::vector<TreeNode>& getNodes();
 
     /**
-     * @brief Find node by id (searches entire tree)
+     * @brief Find node by id
+     *
+     * Nodes are indexed by id, so lookups take time proportional to the
+     * node's depth rather than to the size of the tree. The pointer stays
+     * valid until nodes are added, removed or moved. Call refreshRows()
+     * after changing a node's children or expanded flag through it.
+     *
      * @param id Node identifier
      * @return Pointer to node or nullptr
      */
@@ -187,12 +209,28 @@ public:
      */
     [[nodiscard]] TreeNode* getParent(const std::string& id);
 
+    /**
+     * @brief Set the loader for children of nodes marked childrenPending
+     *
+     * The loader is called when such a node is first expanded, and must not
+     * change the TreeView. Its result becomes the node's children, so large
+     * trees need not be built up front.
+     *
+     * @param loader Function returning the children of a node
+     * @return Reference to this TreeView for chaining
+     */
+    TreeView& childLoader(ChildLoader loader);
+
     // =========================================================================
     // Expand/Collapse
     // =========================================================================
 
     /**
      * @brief Expand node by id
+     *
+     * Loads the node's children first if they are pending. When expanding
+     * recursively, descendants with pending children stay collapsed.
+     *
      * @param id Node identifier
      * @param recursive Whether to expand children too
      * @return Reference to this TreeView for chaining
@@ -233,6 +271,133 @@ public:
      */
     [[nodiscard]] bool isExpanded(const std::string& id) const;
 
+    // =========================================================================
+    // Rows
+    // =========================================================================
+
+    /**
+     * @brief Get the number of displayed rows
+     *
+     * Rows are the nodes whose ancestors are all expanded, in display
+     * order. The row list is built on first use and then kept up to date
+     * by expand, collapse, add, remove and move, touching only the rows
+     * that change.
+     *
+     * @return Number of rows
+     */
+    [[nodiscard]] size_t getRowCount() const;
+
+    /**
+     * @brief Get a displayed row
+     * @param index Row index
+     * @return Row, with a null node if the index is out of range
+     */
+    [[nodiscard]] TreeRow getRow(size_t index) const;
+
+    /**
+     * @brief Get a range of displayed rows
+     * @param first Index of the first row
+     * @param count Number of rows (cut short at the end)
+     * @return Rows in display order; the node pointers are valid until
+     *         nodes are added, removed or moved
+     */
+    [[nodiscard]] std::vector<TreeRow> getRows(size_t first, size_t count) const;
+
+    /**
+     * @brief Get the row index of a node
+     * @param id Node identifier
+     * @return Row index, or -1 if the node does not exist or an ancestor is collapsed
+     */
+    [[nodiscard]] int getRowIndex(const std::string& id) const;
+
+    /**
+     * @brief Get visible row range for virtual scrolling
+     * @param startIndex Output: first visible row index
+     * @param endIndex Output: last visible row index (exclusive)
+     */
+    void getVisibleRowRange(int& startIndex, int& endIndex) const;
+
+    /**
+     * @brief Get the rows in the visible range
+     * @return Visible rows in display order
+     */
+    [[nodiscard]] std::vector<TreeRow> getVisibleRows() const;
+
+    /**
+     * @brief Rebuild the rows after nodes were changed directly
+     *
+     * Needed after editing children or expanded flags through a pointer
+     * from findNode() or getParent(); getNodes() rebuilds them anyway.
+     *
+     * @return Reference to this TreeView for chaining
+     */
+    TreeView& refreshRows();
+
+    // =========================================================================
+    // Filtering
+    // =========================================================================
+
+    /**
+     * @brief Show only nodes whose text contains a query, with their ancestors
+     *
+     * While filtering, the rows are the matching nodes and all of their
+     * ancestors in tree order, whatever their expanded state. Matching
+     * ignores ASCII case and covers loaded nodes only.
+     *
+     * A query that contains the previous one (as when typing ahead) is
+     * tested against the previous matches only. With at least
+     * getBackgroundFilterThreshold() nodes to test, matching runs on a
+     * worker thread; until it finishes the rows show the previous result,
+     * or none if the nodes changed in between.
+     *
+     * @param query Text to look for; empty clears the filter
+     * @return Reference to this TreeView for chaining
+     */
+    TreeView& filter(const std::string& query);
+
+    /**
+     * @brief Stop filtering and show the expanded nodes again
+     * @return Reference to this TreeView for chaining
+     */
+    TreeView& clearFilter();
+
+    /**
+     * @brief Get the current filter query
+     * @return Query, empty when not filtering
+     */
+    [[nodiscard]] const std::string& getFilter() const;
+
+    /**
+     * @brief Get the number of nodes matching the filter
+     * @return Matches in the rows currently shown (0 when not filtering)
+     */
+    [[nodiscard]] size_t getFilterMatchCount() const;
+
+    /**
+     * @brief Check if a worker thread is still matching the filter
+     * @return true if the rows do not reflect the current query yet
+     */
+    [[nodiscard]] bool isFilterPending() const;
+
+    /**
+     * @brief Wait until the rows reflect the current filter query
+     * @return Reference to this TreeView for chaining
+     */
+    TreeView& waitForFilter();
+
+    /**
+     * @brief Set how many nodes a filter must test to run on a worker thread
+     * @param nodes Minimum node count (0 to always match on the calling thread)
+     * @return Reference to this TreeView for chaining
+     */
+    TreeView& backgroundFilterThreshold(size_t nodes);
+
+    /**
+     * @brief Get the background filter threshold
+     * @return Minimum node count, 0 meaning never
+     */
+    [[nodiscard]] size_t getBackgroundFilterThreshold() const;
+
     // =========================================================================
     // Selection
     // =========================================================================
@@ -302,6 +467,10 @@ public:
 
     /**
      * @brief Move node to new parent
+     *
+     * Does nothing if either node does not exist or the new parent is the
+     * node itself or one of its descendants.
+     *
      * @param nodeId Node to move
      * @param newParentId New parent id (empty for root)
      * @param index Position in new parent's children (-1 for end)
@@ -460,6 +629,9 @@ public:
 
     /**
      * @brief Scroll to make node visible
+     *
+     * Expands the node's collapsed ancestors, then scrolls to its row.
+     *
      * @param id Node identifier
      * @return Reference to this TreeView for chaining
      */
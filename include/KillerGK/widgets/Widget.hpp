@@ -6,6 +6,8 @@
 #pragma once
 
 #include "../core/Types.hpp"
+#include "WidgetProperties.hpp"
+#include <cstdint>
 #include <string>
 #include <functional>
 #include <memory>
@@ -193,6 +195,25 @@ struct WidgetEvent {
     void preventDefault() { handled = true; }
 };
 
+/**
+ * @enum DirtyFlags
+ * @brief What a widget needs redone since it was last drawn
+ */
+enum class DirtyFlags : uint8_t {
+    None = 0,
+    Layout = 1 << 0,     ///< Its size or spacing changed: lay it out again
+    Paint = 1 << 1,      ///< Its appearance changed: draw it again
+    Subtree = 1 << 2     ///< A descendant is dirty
+};
+
+inline DirtyFlags operator|(DirtyFlags a, DirtyFlags b) {
+    return static_cast<DirtyFlags>(static_cast<uint8_t>(a) | static_cast<uint8_t>(b));
+}
+
+inline bool operator&(DirtyFlags a, DirtyFlags b) {
+    return (static_cast<uint8_t>(a) & static_cast<uint8_t>(b)) != 0;
+}
+
 
 /**
  * @class Widget
@@ -412,6 +433,9 @@ public:
     // =========================================================================
     // Generic Property Access
     // =========================================================================
+    //
+    // Each name-based call interns or looks up its name; code that accesses
+    // a property often can use an interned PropertyKey instead.
 
     /**
      * @brief Set a custom property value (float)
@@ -419,6 +443,7 @@ public:
      * @param value Property value
      */
     Widget& setPropertyFloat(const std::string& name, float value);
+    Widget& setPropertyFloat(PropertyKey key, float value);
 
     /**
      * @brief Set a custom property value (int)
@@ -426,6 +451,7 @@ public:
      * @param value Property value
      */
     Widget& setPropertyInt(const std::string& name, int value);
+    Widget& setPropertyInt(PropertyKey key, int value);
 
     /**
      * @brief Set a custom property value (bool)
@@ -433,6 +459,7 @@ public:
      * @param value Property value
      */
     Widget& setPropertyBool(const std::string& name, bool value);
+    Widget& setPropertyBool(PropertyKey key, bool value);
 
     /**
      * @brief Set a custom property value (string)
@@ -440,6 +467,7 @@ public:
      * @param value Property value
      */
     Widget& setPropertyString(const std::string& name, const std::string& value);
+    Widget& setPropertyString(PropertyKey key, const std::string& value);
 
     /**
      * @brief Get a custom property value (float)
@@ -448,6 +476,7 @@ public:
      * @return Property value or default
      */
     [[nodiscard]] float getPropertyFloat(const std::string& name, float defaultValue = 0.0f) const;
+    [[nodiscard]] float getPropertyFloat(PropertyKey key, float defaultValue = 0.0f) const;
 
     /**
      * @brief Get a custom property value (int)
@@ -456,6 +485,7 @@ public:
      * @return Property value or default
      */
     [[nodiscard]] int getPropertyInt(const std::string& name, int defaultValue = 0) const;
+    [[nodiscard]] int getPropertyInt(PropertyKey key, int defaultValue = 0) const;
 
     /**
      * @brief Get a custom property value (bool)
@@ -464,6 +494,7 @@ public:
      * @return Property value or default
      */
     [[nodiscard]] bool getPropertyBool(const std::string& name, bool defaultValue = false) const;
+    [[nodiscard]] bool getPropertyBool(PropertyKey key, bool defaultValue = false) const;
 
     /**
      * @brief Get a custom property value (string)
@@ -472,6 +503,7 @@ public:
      * @return Property value or default
      */
     [[nodiscard]] std::string getPropertyString(const std::string& name, const std::string& defaultValue = "") const;
+    [[nodiscard]] std::string getPropertyString(PropertyKey key, const std::string& defaultValue = "") const;
 
     /**
      * @brief Check if a custom property exists
@@ -479,10 +511,57 @@ public:
      * @return true if property exists
      */
     [[nodiscard]] bool hasProperty(const std::string& name) const;
+    [[nodiscard]] bool hasProperty(PropertyKey key) const;
+
+    // =========================================================================
+    // Invalidation
+    // =========================================================================
+    //
+    // Setters that change a value mark the widget: size, spacing and
+    // visibility mark Layout; styling, enabled, hover, focus, pressed and
+    // custom properties mark Paint. Subclass setters do the same, marking
+    // Layout too for content a widget is sized by (a label's text or font).
+    // Setting a value a widget already has marks nothing, so an idle tree
+    // stays clean and a frame can be skipped by checking the root alone.
+    // A widget whose layout depends on a custom
+    // property (as absolute positions do on "x" and "y") calls
+    // invalidate(DirtyFlags::Layout) itself.
+
+    /**
+     * @brief Mark the widget dirty, and its ancestors as having a dirty descendant
+     *
+     * Ancestors get Subtree, and Layout too when the widget's layout
+     * changed, since a container's layout depends on its children.
+     */
+    void invalidate(DirtyFlags flags);
+
+    /**
+     * @brief Get the flags set since the widget was last cleaned
+     *
+     * A new widget has Layout and Paint set, as it was never drawn.
+     */
+    [[nodiscard]] DirtyFlags getDirty() const;
+    [[nodiscard]] bool isDirty() const { return getDirty() != DirtyFlags::None; }
+
+    /**
+     * @brief Clear the flags of this widget and all its descendants
+     */
+    void clearDirty();
 
 protected:
     Widget();
 
+    /**
+     * @brief Assign a value, for setters that invalidate only on change
+     * @return true if it differs from the previous one
+     */
+    template <typename T>
+    static bool assign(T& field, const T& value) {
+        if (field == value) return false;
+        field = value;
+        return true;
+    }
+
     struct WidgetData;
     std::shared_ptr<WidgetData> m_data;
 };
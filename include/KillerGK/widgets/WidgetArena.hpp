@@ -0,0 +1,147 @@
+/**
+ * @file WidgetArena.hpp
+ * @brief Optional arena for the data blocks of widgets built together
+ *
+ * Every widget allocates its data block (and a widget subclass a second
+ * one) from the heap on creation, so building a large tree is bound by
+ * allocation and leaves the blocks of neighbouring widgets scattered. A
+ * WidgetArena hands out blocks from large chunks instead, one after
+ * another in creation order, and frees nothing until the arena and every
+ * widget made in it are gone: then the chunks go back to the heap at once.
+ *
+ * The containers inside a data block (children, callbacks, strings) still
+ * use the heap; most widgets leave them empty.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace KillerGK {
+
+template <typename T>
+class WidgetArenaAllocator;
+
+/**
+ * @class WidgetArena
+ * @brief Contiguous storage for the widgets of one window or tree
+ *
+ * Widgets created on a thread while a Scope is active on it are allocated
+ * from the scope's arena:
+ * @code
+ * WidgetArena arena;
+ * {
+ *     WidgetArena::Scope scope(arena);
+ *     root = buildDashboard();     // every Widget::create() uses the arena
+ * }
+ * @endcode
+ *
+ * Widgets may outlive the arena object and be destroyed on any thread;
+ * the memory stays until the last of them is gone. Creating widgets in an
+ * arena is for one thread at a time.
+ */
+class WidgetArena {
+public:
+    static constexpr size_t CHUNK_SIZE = 256 * 1024;   ///< Bytes per chunk; larger blocks get a chunk of their own
+
+    WidgetArena();
+    ~WidgetArena();
+
+    WidgetArena(const WidgetArena&) = delete;
+    WidgetArena& operator=(const WidgetArena&) = delete;
+
+    /**
+     * @class Scope
+     * @brief Makes an arena the current one on this thread while it lives
+     *
+     * Scopes nest: the previous arena (or none) is current again afterwards.
+     */
+    class Scope {
+    public:
+        explicit Scope(WidgetArena& arena);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        WidgetArena* m_previous;
+    };
+
+    /**
+     * @brief Get the arena current on this thread, or nullptr
+     */
+    [[nodiscard]] static WidgetArena* current();
+
+    /**
+     * @brief Make a shared block in the current arena, or on the heap if there is none
+     */
+    template <typename T, typename... Args>
+    static std::shared_ptr<T> makeShared(Args&&... args);
+
+    /**
+     * @brief Reuse the chunks for new widgets once every widget made in the arena is gone
+     * @return false (and nothing reused) while any of them is alive
+     */
+    bool reset();
+
+    [[nodiscard]] size_t getLiveCount() const;      ///< Blocks allocated and not yet freed
+    [[nodiscard]] size_t getUsedBytes() const;      ///< Bytes handed out since construction or reset()
+    [[nodiscard]] size_t getReservedBytes() const;  ///< Bytes held in chunks
+
+private:
+    template <typename T>
+    friend class WidgetArenaAllocator;
+
+    struct State;
+
+    static void* allocate(State& state, size_t bytes, size_t alignment);
+    static void deallocate(State& state) noexcept;
+
+    std::shared_ptr<State> m_state;     ///< Shared with every block's allocator
+};
+
+/**
+ * @class WidgetArenaAllocator
+ * @brief Allocator handing out memory from a WidgetArena, for std::allocate_shared
+ */
+template <typename T>
+class WidgetArenaAllocator {
+public:
+    using value_type = T;
+
+    explicit WidgetArenaAllocator(std::shared_ptr<WidgetArena::State> state) : m_state(std::move(state)) {}
+
+    template <typename U>
+    WidgetArenaAllocator(const WidgetArenaAllocator<U>& other) : m_state(other.m_state) {}
+
+    T* allocate(size_t count) {
+        return static_cast<T*>(WidgetArena::allocate(*m_state, count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* /*block*/, size_t /*count*/) noexcept {
+        WidgetArena::deallocate(*m_state);
+    }
+
+    template <typename U>
+    bool operator==(const WidgetArenaAllocator<U>& other) const { return m_state == other.m_state; }
+
+private:
+    template <typename U>
+    friend class WidgetArenaAllocator;
+
+    std::shared_ptr<WidgetArena::State> m_state;
+};
+
+template <typename T, typename... Args>
+std::shared_ptr<T> WidgetArena::makeShared(Args&&... args) {
+    if (WidgetArena* arena = current()) {
+        return std::allocate_shared<T>(WidgetArenaAllocator<T>(arena->m_state), std::forward<Args>(args)...);
+    }
+    return std::make_shared<T>(std::forward<Args>(args)...);
+}
+
+} // namespace KillerGK
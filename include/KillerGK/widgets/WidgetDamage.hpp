@@ -0,0 +1,103 @@
+/**
+ * @file WidgetDamage.hpp
+ * @brief Damaged window regions collected from dirty widgets, for retained redraw
+ *
+ * Widgets mark themselves dirty when a setter changes them (see
+ * Widget::invalidate()), and their ancestors record that a descendant is
+ * dirty. A frame walks down the dirty paths only, and turns each widget
+ * that has to be drawn again into damage: where it was drawn last and
+ * where it is now. Only the damaged regions need drawing, and a frame
+ * whose root is clean needs no work at all.
+ */
+
+#pragma once
+
+#include "Widget.hpp"
+#include <unordered_map>
+#include <vector>
+
+namespace KillerGK {
+
+class WidgetHitIndex;
+
+/**
+ * @class DamageTracker
+ * @brief Union of the window regions to draw again in the next frame
+ *
+ * Widget bounds come from a WidgetHitIndex, which holds the bounds of the
+ * last layout pass; widgets not in it add no damage. The tracker keeps
+ * the bounds each widget was last drawn at, so a widget that moved damages
+ * both its old and its new place.
+ *
+ * The tracker holds plain pointers: remove a widget when it leaves the
+ * tree, which also damages where it was drawn.
+ *
+ * Example:
+ * @code
+ * if (root.isDirty()) {
+ *     if (root.getDirty() & DirtyFlags::Layout) {
+ *         layout.layout(constraints);
+ *         hitIndex.update(layout);
+ *     }
+ *     if (damage.collect(root, hitIndex)) {
+ *         renderer.draw(root, damage.getRegions());
+ *         damage.clear();
+ *     }
+ * }
+ * @endcode
+ */
+class DamageTracker {
+public:
+    /// Regions kept before new damage is merged into the nearest region
+    static constexpr size_t MAX_REGIONS = 16;
+
+    /**
+     * @brief Add the damage of the dirty widgets under a root, and clean them
+     *
+     * A widget marked Paint damages its old and new bounds. Below a widget
+     * marked Layout, every widget whose bounds changed does the same.
+     *
+     * @return true if there is damage to draw
+     */
+    bool collect(Widget& root, const WidgetHitIndex& index);
+
+    /**
+     * @brief Damage a region directly (for example the whole window after a resize)
+     */
+    void add(const Rect& rect);
+
+    /**
+     * @brief Damage where a widget was last drawn, and forget it
+     */
+    void remove(Widget* widget);
+
+    /**
+     * @brief Get the damaged regions; they do not overlap
+     */
+    [[nodiscard]] const std::vector<Rect>& getRegions() const { return m_regions; }
+
+    /**
+     * @brief Get the bounding box of all damage (an empty Rect if none)
+     */
+    [[nodiscard]] Rect getBounds() const;
+
+    [[nodiscard]] bool empty() const { return m_regions.empty(); }
+
+    /**
+     * @brief Forget the damage once the frame is drawn
+     */
+    void clear() { m_regions.clear(); }
+
+    /**
+     * @brief Forget the damage and every widget's drawn bounds
+     */
+    void reset();
+
+private:
+    void collect(Widget& widget, const WidgetHitIndex& index, bool relaid);
+
+    std::vector<Rect> m_regions;
+    std::unordered_map<Widget*, Rect> m_drawn;      ///< Bounds each widget was last drawn at
+};
+
+} // namespace KillerGK
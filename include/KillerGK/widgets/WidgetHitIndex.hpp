@@ -0,0 +1,179 @@
+/**
+ * @file WidgetHitIndex.hpp
+ * @brief Spatial index over laid-out widget bounds for mouse event dispatch
+ *
+ * Finding the widget under the cursor by walking the hierarchy and testing
+ * each child's bounds costs a full walk per mouse move. The index keeps
+ * the bounds in a hierarchy of grids instead: level L has cells of
+ * BASE_CELL_SIZE * 2^L pixels, and a widget is stored at the lowest level
+ * whose cells are at least as large as the widget, so it covers at most
+ * 2 x 2 cells there. A lookup checks the one cell under the point on each
+ * level in use, so its cost grows with the logarithm of the range of
+ * widget sizes rather than with the number of widgets. Moving a widget
+ * only touches the cells it leaves and enters.
+ */
+
+#pragma once
+
+#include "Widget.hpp"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace KillerGK {
+
+class ILayout;
+
+/**
+ * @class WidgetHitIndex
+ * @brief Topmost widget at a point, and hover tracking, over window-space bounds
+ *
+ * Stacking follows the order widgets are first added: a widget added later
+ * is above those added before it (as siblings painted later are), so add
+ * containers before their children. raise() moves a widget to the top.
+ * Hidden widgets, and widgets with a hidden ancestor, are never hit.
+ *
+ * The index holds plain pointers: remove a widget before destroying it.
+ *
+ * Example:
+ * @code
+ * layout.layout(constraints);
+ * hitIndex.update(layout);        // only widgets that moved are re-indexed
+ *
+ * hitIndex.updateHover(mouseX, mouseY);
+ * if (Widget* target = hitIndex.hitTest(mouseX, mouseY)) target->triggerClick();
+ * @endcode
+ */
+class WidgetHitIndex {
+public:
+    static constexpr float BASE_CELL_SIZE = 64.0f;  ///< Cell size of level 0, in pixels
+    static constexpr int LEVELS = 24;
+
+    /**
+     * @brief Widgets the cursor left and entered with one move
+     */
+    struct HoverChange {
+        std::vector<Widget*> left;        ///< Innermost first
+        std::vector<Widget*> entered;     ///< Outermost first
+
+        [[nodiscard]] bool empty() const { return left.empty() && entered.empty(); }
+    };
+
+    // =========================================================================
+    // Bounds
+    // =========================================================================
+
+    /**
+     * @brief Add a widget, or move it to new bounds (keeping its stacking)
+     */
+    void update(Widget* widget, const Rect& bounds);
+
+    /**
+     * @brief Add or move every child of a layout to its computed bounds
+     */
+    void update(const ILayout& layout);
+
+    /**
+     * @brief Remove a widget; it leaves the hovered set without a callback
+     * @return true if it was indexed
+     */
+    bool remove(Widget* widget);
+
+    /**
+     * @brief Put a widget above all others
+     */
+    void raise(Widget* widget);
+
+    void clear();
+
+    [[nodiscard]] size_t size() const { return m_slots.size(); }
+    [[nodiscard]] bool contains(Widget* widget) const { return m_slots.count(widget) > 0; }
+
+    /**
+     * @brief Get a widget's indexed bounds (an empty Rect if not indexed)
+     */
+    [[nodiscard]] Rect getBounds(Widget* widget) const;
+
+    // =========================================================================
+    // Queries
+    // =========================================================================
+
+    /**
+     * @brief Find the topmost visible widget whose bounds contain a point
+     * @return The widget, or nullptr if there is none
+     */
+    [[nodiscard]] Widget* hitTest(float x, float y) const;
+
+    /**
+     * @brief Dispatch a mouse event to the widget under event.mouseX, event.mouseY
+     *
+     * The event bubbles to the widget's parents as Widget::dispatchEvent() does.
+     *
+     * @return true if the event was handled
+     */
+    bool dispatch(WidgetEvent& event);
+
+    // =========================================================================
+    // Hover
+    // =========================================================================
+
+    /**
+     * @brief Move the cursor, updating the hovered widgets
+     *
+     * The hovered widgets are the topmost widget at the point and those of
+     * its ancestors that are indexed. Widgets leaving the set get
+     * setHovered(false), then widgets entering it get setHovered(true).
+     *
+     * @return The widgets that left and entered the set
+     */
+    HoverChange updateHover(float x, float y);
+
+    /**
+     * @brief The cursor left the window: no widget is hovered any more
+     */
+    HoverChange clearHover();
+
+    /**
+     * @brief Get the innermost hovered widget, or nullptr
+     */
+    [[nodiscard]] Widget* getHovered() const { return m_hovered.empty() ? nullptr : m_hovered.front(); }
+
+private:
+    struct Entry {
+        Widget* widget = nullptr;
+        Rect bounds;
+        uint64_t order = 0;               ///< Higher is above
+        int level = -1;                   ///< Grid level, -1 when in no cell (empty or invalid bounds)
+        int32_t firstX = 0;               ///< Cell range covered at that level
+        int32_t firstY = 0;
+        int32_t lastX = -1;
+        int32_t lastY = -1;
+    };
+
+    struct CellKey {
+        int32_t x = 0;
+        int32_t y = 0;
+        int32_t level = 0;
+
+        bool operator==(const CellKey& other) const = default;
+    };
+
+    struct CellHash {
+        size_t operator()(const CellKey& key) const;
+    };
+
+    static void locate(Entry& entry);
+    void link(const Entry& entry, uint32_t slot);
+    void unlink(const Entry& entry, uint32_t slot);
+    HoverChange setHovered(std::vector<Widget*> hovered);
+
+    std::vector<Entry> m_entries;
+    std::vector<uint32_t> m_free;                                       ///< Unused entries
+    std::unordered_map<Widget*, uint32_t> m_slots;                      ///< Widget → entry
+    std::unordered_map<CellKey, std::vector<uint32_t>, CellHash> m_cells;
+    size_t m_levelCounts[LEVELS] = {};                                  ///< Widgets per level
+    uint64_t m_nextOrder = 0;
+    std::vector<Widget*> m_hovered;                                     ///< Innermost first
+};
+
+} // namespace KillerGK
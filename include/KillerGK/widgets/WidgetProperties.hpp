@@ -0,0 +1,154 @@
+/**
+ * @file WidgetProperties.hpp
+ * @brief Interned property keys and flat typed storage for Widget custom properties
+ *
+ * Custom properties used to live in a std::map<std::string, std::any>:
+ * every access compared strings down a tree and checked the any's type,
+ * and every property was a node of its own. Property names are now
+ * interned once into small integer keys, and a widget keeps its
+ * properties in one array of entries sorted by key. Float, int and bool
+ * values sit in the entry itself; strings are kept in a side array.
+ */
+
+#pragma once
+
+#include <any>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace KillerGK {
+
+/**
+ * @class PropertyKey
+ * @brief A property name interned into a process-wide table
+ *
+ * Each use of a name costs a hash lookup (and a lock, the first time a
+ * thread sees the name), so code that accesses a property often should
+ * intern its name once and keep the key:
+ * @code
+ * static const PropertyKey kRotation = PropertyKey::intern("rotation");
+ * widget.setPropertyFloat(kRotation, 45.0f);
+ * @endcode
+ */
+class PropertyKey {
+public:
+    static constexpr uint32_t NONE = static_cast<uint32_t>(-1);
+
+    /**
+     * @brief An invalid key, matching no property
+     */
+    constexpr PropertyKey() = default;
+
+    /**
+     * @brief Get the key for a name, adding the name to the table if needed
+     */
+    static PropertyKey intern(std::string_view name);
+
+    /**
+     * @brief Get the key for a name without adding it
+     * @return The key, or an invalid key if the name was never interned
+     */
+    static PropertyKey find(std::string_view name);
+
+    [[nodiscard]] bool isValid() const { return m_id != NONE; }
+    [[nodiscard]] uint32_t getId() const { return m_id; }
+
+    /**
+     * @brief Get the interned name (empty for an invalid key)
+     */
+    [[nodiscard]] const std::string& getName() const;
+
+    bool operator==(const PropertyKey& other) const = default;
+
+private:
+    friend class PropertyStore;
+
+    explicit constexpr PropertyKey(uint32_t id) : m_id(id) {}
+
+    uint32_t m_id = NONE;
+};
+
+/**
+ * @enum PropertyType
+ * @brief Type of a stored property value
+ */
+enum class PropertyType : uint8_t {
+    Float,
+    Int,
+    Bool,
+    String
+};
+
+/**
+ * @class PropertyStore
+ * @brief Typed property values of one widget, by key
+ *
+ * Setting a property with another type replaces it. Getting a property
+ * that is missing or holds another type returns the default value, as
+ * std::any_cast failing did before. The setters return true if the stored
+ * value changed.
+ */
+class PropertyStore {
+public:
+    bool setFloat(PropertyKey key, float value);
+    bool setInt(PropertyKey key, int value);
+    bool setBool(PropertyKey key, bool value);
+    bool setString(PropertyKey key, std::string value);
+
+    [[nodiscard]] float getFloat(PropertyKey key, float defaultValue) const;
+    [[nodiscard]] int getInt(PropertyKey key, int defaultValue) const;
+    [[nodiscard]] bool getBool(PropertyKey key, bool defaultValue) const;
+    [[nodiscard]] const std::string& getString(PropertyKey key, const std::string& defaultValue) const;
+
+    [[nodiscard]] bool has(PropertyKey key) const { return find(key) != nullptr; }
+
+    /**
+     * @brief Remove a property
+     * @return true if it existed
+     */
+    bool remove(PropertyKey key);
+
+    void clear();
+
+    [[nodiscard]] size_t size() const { return m_entries.size(); }
+    [[nodiscard]] bool empty() const { return m_entries.empty(); }
+
+    // =========================================================================
+    // WidgetState conversion
+    // =========================================================================
+
+    /**
+     * @brief Add every property to a name → value map
+     */
+    void copyTo(std::map<std::string, std::any>& properties) const;
+
+    /**
+     * @brief Set a property from a float, int, bool or std::string held in a std::any
+     * @return false (and nothing set) for any other type
+     */
+    bool set(PropertyKey key, const std::any& value);
+
+private:
+    struct Entry {
+        uint32_t key = PropertyKey::NONE;
+        PropertyType type = PropertyType::Float;
+        union {
+            float f = 0.0f;
+            int32_t i;
+            bool b;
+            uint32_t string;              ///< Index into m_strings
+        };
+    };
+
+    [[nodiscard]] const Entry* find(PropertyKey key) const;
+    Entry& slot(PropertyKey key, PropertyType type, bool& added);
+    void releaseString(uint32_t index);
+
+    std::vector<Entry> m_entries;         ///< Sorted by key
+    std::vector<std::string> m_strings;
+};
+
+} // namespace KillerGK
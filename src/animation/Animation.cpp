@@ -1421,12 +1421,22 @@ void StateTransitionManager::applyThemeDefaults(const Theme& theme) {
 // Property Value Helpers Implementation
 // ============================================================================
 
+namespace {
+
+// Custom properties read and written on every animation frame
+const PropertyKey kPropertyX = PropertyKey::intern("x");
+const PropertyKey kPropertyY = PropertyKey::intern("y");
+const PropertyKey kPropertyRotation = PropertyKey::intern("rotation");
+const PropertyKey kPropertyScale = PropertyKey::intern("scale");
+
+} // namespace
+
 float getWidgetPropertyValue(const Widget& widget, Property prop) {
     switch (prop) {
         case Property::X:
-            return widget.getPropertyFloat("x", 0.0f);
+            return widget.getPropertyFloat(kPropertyX, 0.0f);
         case Property::Y:
-            return widget.getPropertyFloat("y", 0.0f);
+            return widget.getPropertyFloat(kPropertyY, 0.0f);
         case Property::Width:
             return widget.getWidth();
         case Property::Height:
@@ -1434,9 +1444,9 @@ float getWidgetPropertyValue(const Widget& widget, Property prop) {
         case Property::Opacity:
             return widget.getOpacity();
         case Property::Rotation:
-            return widget.getPropertyFloat("rotation", 0.0f);
+            return widget.getPropertyFloat(kPropertyRotation, 0.0f);
         case Property::Scale:
-            return widget.getPropertyFloat("scale", 1.0f);
+            return widget.getPropertyFloat(kPropertyScale, 1.0f);
         case Property::BackgroundColorR:
             return widget.getBackgroundColor().r;
         case Property::BackgroundColorG:
@@ -1473,10 +1483,12 @@ float getWidgetPropertyValue(const Widget& widget, Property prop) {
 void setWidgetPropertyValue(Widget& widget, Property prop, float value) {
     switch (prop) {
         case Property::X:
-            widget.setPropertyFloat("x", value);
+            widget.setPropertyFloat(kPropertyX, value);
+            widget.invalidate(DirtyFlags::Layout);    // Read by absolute layouts
             break;
         case Property::Y:
-            widget.setPropertyFloat("y", value);
+            widget.setPropertyFloat(kPropertyY, value);
+            widget.invalidate(DirtyFlags::Layout);    // Read by absolute layouts
             break;
         case Property::Width:
             widget.width(value);
@@ -1488,10 +1500,10 @@ void setWidgetPropertyValue(Widget& widget, Property prop, float value) {
             widget.opacity(value);
             break;
         case Property::Rotation:
-            widget.setPropertyFloat("rotation", value);
+            widget.setPropertyFloat(kPropertyRotation, value);
             break;
         case Property::Scale:
-            widget.setPropertyFloat("scale", value);
+            widget.setPropertyFloat(kPropertyScale, value);
             break;
         case Property::BackgroundColorR: {
             Color bg = widget.getBackgroundColor();
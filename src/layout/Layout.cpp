@@ -181,6 +181,13 @@ Rect FlexImpl::getChildBounds(size_t index) const {
     return Rect();
 }
 
+Widget* FlexImpl::getChild(size_t index) const {
+    if (index < m_children.size()) {
+        return m_children[index];
+    }
+    return nullptr;
+}
+
 size_t FlexImpl::getChildCount() const {
     return m_children.size();
 }
@@ -370,6 +377,13 @@ Rect GridImpl::getChildBounds(size_t index) const {
     return Rect();
 }
 
+Widget* GridImpl::getChild(size_t index) const {
+    if (index < m_children.size()) {
+        return m_children[index];
+    }
+    return nullptr;
+}
+
 size_t GridImpl::getChildCount() const {
     return m_children.size();
 }
@@ -496,6 +510,13 @@ Rect StackImpl::getChildBounds(size_t index) const {
     return Rect();
 }
 
+Widget* StackImpl::getChild(size_t index) const {
+    if (index < m_children.size()) {
+        return m_children[index];
+    }
+    return nullptr;
+}
+
 size_t StackImpl::getChildCount() const {
     return m_children.size();
 }
@@ -528,6 +549,14 @@ void StackImpl::setBounds(const Rect& bounds) {
 // AbsoluteImpl Implementation
 // =============================================================================
 
+namespace {
+
+// Child positions, read for every child on every layout
+const PropertyKey kPropertyX = PropertyKey::intern("x");
+const PropertyKey kPropertyY = PropertyKey::intern("y");
+
+} // namespace
+
 AbsoluteImpl::AbsoluteImpl() = default;
 
 Size AbsoluteImpl::layout(const LayoutConstraints& constraints) {
@@ -553,8 +582,8 @@ Size AbsoluteImpl::layout(const LayoutConstraints& constraints) {
         if (!child) continue;
 
         // Get child's position from custom properties or margin
-        float childX = child->getPropertyFloat("x", child->getMargin().left);
-        float childY = child->getPropertyFloat("y", child->getMargin().top);
+        float childX = child->getPropertyFloat(kPropertyX, child->getMargin().left);
+        float childY = child->getPropertyFloat(kPropertyY, child->getMargin().top);
         float childWidth = std::max(child->getMinWidth(), std::min(child->getWidth(), child->getMaxWidth()));
         float childHeight = std::max(child->getMinHeight(), std::min(child->getHeight(), child->getMaxHeight()));
 
@@ -587,6 +616,13 @@ Rect AbsoluteImpl::getChildBounds(size_t index) const {
     return Rect();
 }
 
+Widget* AbsoluteImpl::getChild(size_t index) const {
+    if (index < m_children.size()) {
+        return m_children[index];
+    }
+    return nullptr;
+}
+
 size_t AbsoluteImpl::getChildCount() const {
     return m_children.size();
 }
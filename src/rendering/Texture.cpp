@@ -416,7 +416,8 @@ ImageData ImageLoader::loadFromFile(const std::string& path, bool flipVertically
     }
     
     // Load using stb_image
-    stbi_set_flip_vertically_on_load(flipVertically ? 1 : 0);
+    // Per-thread flag: images may be decoded on ResourceManager loader threads
+    stbi_set_flip_vertically_on_load_thread(flipVertically ? 1 : 0);
     
     int width, height, channels;
     unsigned char* data = stbi_load(path.c_str(), &width, &height, &channels, STBI_rgb_alpha);
@@ -449,7 +450,8 @@ ImageData ImageLoader::loadFromMemory(const uint8_t* data, size_t size, bool fli
 }
 
 ImageData ImageLoader::loadFromMemorySTB(const uint8_t* data, size_t size, bool flipVertically) {
-    stbi_set_flip_vertically_on_load(flipVertically ? 1 : 0);
+    // Per-thread flag: images may be decoded on ResourceManager loader threads
+    stbi_set_flip_vertically_on_load_thread(flipVertically ? 1 : 0);
     
     int width, height, channels;
     unsigned char* pixels = stbi_load_from_memory(data, static_cast<int>(size), 
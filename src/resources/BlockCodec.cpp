@@ -0,0 +1,217 @@
+/**
+ * @file BlockCodec.cpp
+ * @brief LZ block compression implementation
+ */
+
+#include "KillerGK/resources/BlockCodec.hpp"
+#include <array>
+#include <cstring>
+
+namespace KillerGK {
+
+namespace {
+
+constexpr size_t MIN_MATCH = 4;
+constexpr size_t LAST_LITERALS = 5;     ///< Trailing bytes always emitted as literals
+constexpr size_t MATCH_SAFE_LIMIT = 12; ///< No match may start this close to the end
+constexpr size_t MAX_OFFSET = 65535;
+constexpr int HASH_BITS = 14;
+
+inline uint32_t read32(const uint8_t* p) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline uint32_t hashSequence(uint32_t sequence) {
+    return (sequence * 2654435761u) >> (32 - HASH_BITS);
+}
+
+/**
+ * @brief Write a length extension (runs of 255 plus remainder)
+ */
+inline bool writeLength(uint8_t*& op, const uint8_t* opEnd, size_t length) {
+    while (length >= 255) {
+        if (op >= opEnd) return false;
+        *op++ = 255;
+        length -= 255;
+    }
+    if (op >= opEnd) return false;
+    *op++ = static_cast<uint8_t>(length);
+    return true;
+}
+
+/**
+ * @brief Read a length extension, rejecting truncated input
+ */
+inline bool readLength(const uint8_t*& ip, const uint8_t* ipEnd, size_t& length) {
+    uint8_t byte;
+    do {
+        if (ip >= ipEnd) return false;
+        byte = *ip++;
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+/**
+ * @brief Emit one sequence: literals followed by an optional match
+ */
+inline bool emitSequence(uint8_t*& op, const uint8_t* opEnd,
+                         const uint8_t* literals, size_t literalLength,
+                         size_t offset, size_t matchLength) {
+    if (op >= opEnd) return false;
+    uint8_t* token = op++;
+
+    if (literalLength >= 15) {
+        *token = 15 << 4;
+        if (!writeLength(op, opEnd, literalLength - 15)) return false;
+    } else {
+        *token = static_cast<uint8_t>(literalLength << 4);
+    }
+
+    if (static_cast<size_t>(opEnd - op) < literalLength) return false;
+    std::memcpy(op, literals, literalLength);
+    op += literalLength;
+
+    if (matchLength == 0) {
+        return true;  // Final literal-only sequence
+    }
+
+    if (opEnd - op < 2) return false;
+    *op++ = static_cast<uint8_t>(offset & 0xFF);
+    *op++ = static_cast<uint8_t>(offset >> 8);
+
+    size_t encodedMatch = matchLength - MIN_MATCH;
+    if (encodedMatch >= 15) {
+        *token |= 15;
+        if (!writeLength(op, opEnd, encodedMatch - 15)) return false;
+    } else {
+        *token |= static_cast<uint8_t>(encodedMatch);
+    }
+
+    return true;
+}
+
+} // namespace
+
+size_t BlockCodec::compressBound(size_t srcSize) {
+    return srcSize + srcSize / 255 + 16;
+}
+
+size_t BlockCodec::compress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity) {
+    uint8_t* op = dst;
+    const uint8_t* opEnd = dst + dstCapacity;
+    size_t anchor = 0;
+
+    if (srcSize > MATCH_SAFE_LIMIT) {
+        std::array<uint32_t, 1 << HASH_BITS> table{};
+        const size_t matchStartLimit = srcSize - MATCH_SAFE_LIMIT;
+        const size_t matchEndLimit = srcSize - LAST_LITERALS;
+        size_t ip = 1;
+
+        while (ip < matchStartLimit) {
+            uint32_t sequence = read32(src + ip);
+            uint32_t hash = hashSequence(sequence);
+            size_t candidate = table[hash];
+            table[hash] = static_cast<uint32_t>(ip);
+
+            if (ip - candidate > MAX_OFFSET || read32(src + candidate) != sequence) {
+                // Skip faster through incompressible data
+                ip += 1 + ((ip - anchor) >> 6);
+                continue;
+            }
+
+            // Extend backwards over bytes that also match
+            while (ip > anchor && candidate > 0 && src[ip - 1] == src[candidate - 1]) {
+                ip--;
+                candidate--;
+            }
+
+            // Extend forwards
+            size_t matchLength = MIN_MATCH;
+            while (ip + matchLength < matchEndLimit &&
+                   src[ip + matchLength] == src[candidate + matchLength]) {
+                matchLength++;
+            }
+
+            if (!emitSequence(op, opEnd, src + anchor, ip - anchor, ip - candidate, matchLength)) {
+                return 0;
+            }
+
+            ip += matchLength;
+            anchor = ip;
+
+            // Seed the table inside the match so the next search has a recent candidate
+            if (ip - 2 < matchStartLimit) {
+                table[hashSequence(read32(src + ip - 2))] = static_cast<uint32_t>(ip - 2);
+            }
+        }
+    }
+
+    if (!emitSequence(op, opEnd, src + anchor, srcSize - anchor, 0, 0)) {
+        return 0;
+    }
+
+    return static_cast<size_t>(op - dst);
+}
+
+bool BlockCodec::decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize) {
+    const uint8_t* ip = src;
+    const uint8_t* ipEnd = src + srcSize;
+    uint8_t* op = dst;
+    uint8_t* opEnd = dst + dstSize;
+
+    while (ip < ipEnd) {
+        uint8_t token = *ip++;
+
+        // Literals
+        size_t literalLength = token >> 4;
+        if (literalLength == 15 && !readLength(ip, ipEnd, literalLength)) {
+            return false;
+        }
+        if (static_cast<size_t>(ipEnd - ip) < literalLength ||
+            static_cast<size_t>(opEnd - op) < literalLength) {
+            return false;
+        }
+        std::memcpy(op, ip, literalLength);
+        ip += literalLength;
+        op += literalLength;
+
+        if (ip == ipEnd) {
+            break;  // Final sequence carries no match
+        }
+
+        // Match
+        if (ipEnd - ip < 2) return false;
+        size_t offset = static_cast<size_t>(ip[0]) | (static_cast<size_t>(ip[1]) << 8);
+        ip += 2;
+        if (offset == 0 || offset > static_cast<size_t>(op - dst)) {
+            return false;
+        }
+
+        size_t matchLength = token & 15;
+        if (matchLength == 15 && !readLength(ip, ipEnd, matchLength)) {
+            return false;
+        }
+        matchLength += MIN_MATCH;
+        if (static_cast<size_t>(opEnd - op) < matchLength) {
+            return false;
+        }
+
+        const uint8_t* match = op - offset;
+        if (offset >= matchLength) {
+            std::memcpy(op, match, matchLength);
+            op += matchLength;
+        } else {
+            // Overlapping copy replicates the last `offset` bytes
+            for (size_t i = 0; i < matchLength; ++i) {
+                *op++ = *match++;
+            }
+        }
+    }
+
+    return op == opEnd;
+}
+
+} // namespace KillerGK
@@ -0,0 +1,339 @@
+/**
+ * @file CRC32.cpp
+ * @brief CRC-32 implementation with runtime CPU dispatch
+ */
+
+#include "KillerGK/resources/CRC32.hpp"
+#include <array>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    #define KGK_CRC32_X86 1
+    #include <immintrin.h>
+    #ifdef _MSC_VER
+        #include <intrin.h>
+    #endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #define KGK_CRC32_ARM64 1
+    #ifdef _WIN32
+        #define WIN32_LEAN_AND_MEAN
+        #define NOMINMAX
+        #include <windows.h>
+        #include <arm64intr.h>
+    #else
+        #include <arm_acle.h>
+        #if defined(__linux__)
+            #include <sys/auxv.h>
+            #include <asm/hwcap.h>
+        #endif
+    #endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define KGK_TARGET(features) __attribute__((target(features)))
+#else
+    #define KGK_TARGET(features)
+#endif
+
+namespace KillerGK {
+
+namespace {
+
+constexpr uint32_t POLYNOMIAL = 0xEDB88320u;
+
+/**
+ * @brief Slicing tables: tables[0] is the classic byte table, tables[k]
+ *        advances a byte that is followed by k more bytes
+ */
+constexpr std::array<std::array<uint32_t, 256>, 8> makeTables() {
+    std::array<std::array<uint32_t, 256>, 8> tables{};
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t crc = i;
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc >> 1) ^ ((crc & 1) ? POLYNOMIAL : 0);
+        }
+        tables[0][i] = crc;
+    }
+    for (uint32_t i = 0; i < 256; ++i) {
+        for (size_t k = 1; k < 8; ++k) {
+            uint32_t previous = tables[k - 1][i];
+            tables[k][i] = (previous >> 8) ^ tables[0][previous & 0xFF];
+        }
+    }
+    return tables;
+}
+
+constexpr auto TABLES = makeTables();
+
+// All backends work on the raw register (pre- and post-inverted by callers)
+
+uint32_t crcTable(uint32_t crc, const uint8_t* data, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        crc = TABLES[0][(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+inline uint32_t readLE32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+uint32_t crcSlicing8(uint32_t crc, const uint8_t* data, size_t size) {
+    while (size >= 8) {
+        uint32_t low = readLE32(data) ^ crc;
+        uint32_t high = readLE32(data + 4);
+        crc = TABLES[7][low & 0xFF] ^ TABLES[6][(low >> 8) & 0xFF] ^
+              TABLES[5][(low >> 16) & 0xFF] ^ TABLES[4][low >> 24] ^
+              TABLES[3][high & 0xFF] ^ TABLES[2][(high >> 8) & 0xFF] ^
+              TABLES[1][(high >> 16) & 0xFF] ^ TABLES[0][high >> 24];
+        data += 8;
+        size -= 8;
+    }
+    return crcTable(crc, data, size);
+}
+
+#ifdef KGK_CRC32_X86
+
+/// Below this size the folding setup costs more than it saves
+constexpr size_t PCLMUL_MIN_SIZE = 64;
+
+KGK_TARGET("pclmul,sse4.1")
+inline __m128i loadLane(const uint8_t* p) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+
+/**
+ * @brief Multiply a 128-bit lane forward by the fold distance and add the next lane
+ */
+KGK_TARGET("pclmul,sse4.1")
+inline __m128i foldLane(__m128i acc, __m128i next, __m128i k) {
+    __m128i low = _mm_clmulepi64_si128(acc, k, 0x00);
+    __m128i high = _mm_clmulepi64_si128(acc, k, 0x11);
+    return _mm_xor_si128(_mm_xor_si128(high, next), low);
+}
+
+/**
+ * @brief Fold 16-byte lanes with carry-less multiplies, then Barrett-reduce
+ *
+ * Follows "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ"
+ * (Gopal et al., Intel) with the bit-reflected constants for 0xEDB88320.
+ * Requires size >= 64 and a multiple of 16.
+ */
+KGK_TARGET("pclmul,sse4.1")
+uint32_t crcPclmulBlocks(uint32_t crc, const uint8_t* data, size_t size) {
+    alignas(16) static const uint64_t k1k2[] = {0x0154442bd4, 0x01c6e41596};
+    alignas(16) static const uint64_t k3k4[] = {0x01751997d0, 0x00ccaa009e};
+    alignas(16) static const uint64_t k5k0[] = {0x0163cd6124, 0x0000000000};
+    alignas(16) static const uint64_t poly[] = {0x01db710641, 0x01f7011641};
+
+    __m128i x1 = loadLane(data + 0x00);
+    __m128i x2 = loadLane(data + 0x10);
+    __m128i x3 = loadLane(data + 0x20);
+    __m128i x4 = loadLane(data + 0x30);
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(static_cast<int>(crc)));
+
+    __m128i k = _mm_load_si128(reinterpret_cast<const __m128i*>(k1k2));
+    data += 64;
+    size -= 64;
+
+    // Fold four lanes in parallel
+    while (size >= 64) {
+        __m128i x5 = _mm_clmulepi64_si128(x1, k, 0x00);
+        __m128i x6 = _mm_clmulepi64_si128(x2, k, 0x00);
+        __m128i x7 = _mm_clmulepi64_si128(x3, k, 0x00);
+        __m128i x8 = _mm_clmulepi64_si128(x4, k, 0x00);
+
+        x1 = _mm_clmulepi64_si128(x1, k, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, k, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, k, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, k, 0x11);
+
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), loadLane(data + 0x00));
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), loadLane(data + 0x10));
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), loadLane(data + 0x20));
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), loadLane(data + 0x30));
+
+        data += 64;
+        size -= 64;
+    }
+
+    // Fold the four lanes into one
+    k = _mm_load_si128(reinterpret_cast<const __m128i*>(k3k4));
+    x1 = foldLane(x1, x2, k);
+    x1 = foldLane(x1, x3, k);
+    x1 = foldLane(x1, x4, k);
+
+    // Remaining 16-byte blocks
+    while (size >= 16) {
+        x1 = foldLane(x1, loadLane(data), k);
+        data += 16;
+        size -= 16;
+    }
+
+    // 128 -> 64 bits
+    __m128i mask = _mm_setr_epi32(~0, 0, ~0, 0);
+    x2 = _mm_clmulepi64_si128(x1, k, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+
+    k = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(k5k0));
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, mask);
+    x1 = _mm_clmulepi64_si128(x1, k, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    // Barrett reduction to 32 bits
+    k = _mm_load_si128(reinterpret_cast<const __m128i*>(poly));
+    x2 = _mm_and_si128(x1, mask);
+    x2 = _mm_clmulepi64_si128(x2, k, 0x10);
+    x2 = _mm_and_si128(x2, mask);
+    x2 = _mm_clmulepi64_si128(x2, k, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    return static_cast<uint32_t>(_mm_extract_epi32(x1, 1));
+}
+
+uint32_t crcPclmul(uint32_t crc, const uint8_t* data, size_t size) {
+    if (size >= PCLMUL_MIN_SIZE) {
+        size_t blocks = size & ~static_cast<size_t>(15);
+        crc = crcPclmulBlocks(crc, data, blocks);
+        data += blocks;
+        size -= blocks;
+    }
+    return crcSlicing8(crc, data, size);
+}
+
+bool cpuHasPclmul() {
+#ifdef _MSC_VER
+    int info[4] = {};
+    __cpuid(info, 1);
+    bool pclmul = (info[2] & (1 << 1)) != 0;
+    bool sse41 = (info[2] & (1 << 19)) != 0;
+    return pclmul && sse41;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1");
+#endif
+}
+
+#endif // KGK_CRC32_X86
+
+#ifdef KGK_CRC32_ARM64
+
+#if defined(__clang__)
+KGK_TARGET("crc")
+#else
+KGK_TARGET("+crc")
+#endif
+uint32_t crcArmv8(uint32_t crc, const uint8_t* data, size_t size) {
+    while (size >= 8) {
+        uint64_t word;
+        std::memcpy(&word, data, sizeof(word));
+        crc = __crc32d(crc, word);
+        data += 8;
+        size -= 8;
+    }
+    while (size > 0) {
+        crc = __crc32b(crc, *data++);
+        --size;
+    }
+    return crc;
+}
+
+bool cpuHasArmCrc() {
+#if defined(_WIN32)
+    return IsProcessorFeaturePresent(PF_ARM_V8_CRC32_INSTRUCTIONS_AVAILABLE) != 0;
+#elif defined(__APPLE__)
+    return true;  // Every Apple ARM64 core implements CRC32
+#elif defined(__linux__)
+    return (getauxval(AT_HWCAP) & HWCAP_CRC32) != 0;
+#else
+    return false;
+#endif
+}
+
+#endif // KGK_CRC32_ARM64
+
+using CrcFunction = uint32_t (*)(uint32_t, const uint8_t*, size_t);
+
+CrcFunction functionFor(CRC32::Backend backend) {
+    switch (backend) {
+        case CRC32::Backend::Table:
+            return crcTable;
+#ifdef KGK_CRC32_X86
+        case CRC32::Backend::PCLMUL:
+            return crcPclmul;
+#endif
+#ifdef KGK_CRC32_ARM64
+        case CRC32::Backend::ARMv8:
+            return crcArmv8;
+#endif
+        default:
+            return crcSlicing8;
+    }
+}
+
+CRC32::Backend detectBackend() {
+#if defined(KGK_CRC32_X86)
+    if (cpuHasPclmul()) return CRC32::Backend::PCLMUL;
+#elif defined(KGK_CRC32_ARM64)
+    if (cpuHasArmCrc()) return CRC32::Backend::ARMv8;
+#endif
+    return CRC32::Backend::Slicing8;
+}
+
+/**
+ * @brief Backend chosen once, on first use
+ */
+struct Dispatch {
+    CRC32::Backend backend = detectBackend();
+    CrcFunction function = functionFor(backend);
+};
+
+const Dispatch& dispatch() {
+    static const Dispatch instance;
+    return instance;
+}
+
+} // namespace
+
+uint32_t CRC32::compute(const uint8_t* data, size_t size) {
+    return update(0, data, size);
+}
+
+uint32_t CRC32::update(uint32_t crc, const uint8_t* data, size_t size) {
+    return ~dispatch().function(~crc, data, size);
+}
+
+uint32_t CRC32::computeWith(Backend backend, const uint8_t* data, size_t size) {
+    CrcFunction function = isSupported(backend) ? functionFor(backend) : crcSlicing8;
+    return ~function(~0u, data, size);
+}
+
+CRC32::Backend CRC32::getActiveBackend() {
+    return dispatch().backend;
+}
+
+bool CRC32::isSupported(Backend backend) {
+    switch (backend) {
+        case Backend::Table:
+        case Backend::Slicing8:
+            return true;
+        case Backend::PCLMUL:
+        case Backend::ARMv8:
+            return dispatch().backend == backend;
+    }
+    return false;
+}
+
+const char* CRC32::getBackendName(Backend backend) {
+    switch (backend) {
+        case Backend::Table:    return "table";
+        case Backend::Slicing8: return "slicing-by-8";
+        case Backend::PCLMUL:   return "pclmul";
+        case Backend::ARMv8:    return "armv8-crc";
+    }
+    return "unknown";
+}
+
+} // namespace KillerGK
@@ -5,11 +5,29 @@
 
 #include "KillerGK/resources/ResourceManager.hpp"
 #include "KillerGK/core/Error.hpp"
+#include "KillerGK/resources/CRC32.hpp"
 #include <algorithm>
 #include <fstream>
 #include <sstream>
 #include <cstring>
 #include <iomanip>
+#include <limits>
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#ifdef __linux__
+    #include <sys/inotify.h>
+    #include <cerrno>
+#endif
 
 namespace KillerGK {
 
@@ -17,72 +35,278 @@ namespace KillerGK {
 // FileWatcher Implementation
 // ============================================================================
 
-FileWatcher::FileWatcher() = default;
+namespace {
 
-FileWatcher::~FileWatcher() = default;
+/**
+ * @brief Canonical spelling of a path used to match watches with events
+ */
+std::string normalizeWatchPath(const std::string& path) {
+    std::string normalized = std::filesystem::path(path).lexically_normal().generic_string();
+    while (normalized.size() > 1 && normalized.back() == '/') {
+        normalized.pop_back();
+    }
+    return normalized.empty() ? std::string(".") : normalized;
+}
 
-void FileWatcher::watchFile(const std::string& path, FileChangeCallback callback) {
-    std::lock_guard<std::mutex> lock(m_mutex);
+std::string parentWatchPath(const std::string& normalizedPath) {
+    std::string parent = std::filesystem::path(normalizedPath).parent_path().generic_string();
+    return parent.empty() ? std::string(".") : parent;
+}
+
+} // namespace
+
+#ifdef __linux__
+
+/**
+ * @brief inotify watches on directories, reference counted by watch entries
+ * 
+ * Files are observed through their parent directory so editors that save
+ * by writing a temporary file and renaming it over the original are seen.
+ */
+struct FileWatcher::NativeWatcher {
+    struct Directory {
+        int descriptor = -1;
+        int refs = 0;
+    };
+    
+    int fd = -1;
+    std::unordered_map<std::string, Directory> directories;  ///< Normalized path -> watch
+    std::unordered_map<int, std::string> paths;             ///< Watch descriptor -> normalized path
+    
+    static std::unique_ptr<NativeWatcher> create() {
+        int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (fd < 0) {
+            return nullptr;
+        }
+        auto watcher = std::make_unique<NativeWatcher>();
+        watcher->fd = fd;
+        return watcher;
+    }
     
-    try {
-        WatchEntry entry;
-        entry.path = path;
-        entry.callback = std::move(callback);
-        entry.isDirectory = false;
+    ~NativeWatcher() {
+        if (fd >= 0) close(fd);
+    }
+    
+    bool acquire(const std::string& directory) {
+        auto it = directories.find(directory);
+        if (it != directories.end()) {
+            it->second.refs++;
+            return true;
+        }
         
-        if (std::filesystem::exists(path)) {
-            entry.lastModified = std::filesystem::last_write_time(path);
+        constexpr uint32_t mask = IN_CLOSE_WRITE | IN_MODIFY | IN_ATTRIB | IN_MOVED_TO |
+                                  IN_CREATE | IN_ONLYDIR;
+        int descriptor = inotify_add_watch(fd, directory.c_str(), mask);
+        if (descriptor < 0) {
+            // Missing directories are polled until they appear
+            log(errno == ENOENT ? LogLevel::Debug : LogLevel::Warning,
+                "Failed to add inotify watch: " + directory + " - " + std::strerror(errno));
+            return false;
         }
         
-        m_watches[path] = std::move(entry);
-    } catch (const std::exception& e) {
-        log(LogLevel::Warning, "Failed to watch file: " + path + " - " + e.what());
+        directories[directory] = {descriptor, 1};
+        paths[descriptor] = directory;
+        return true;
     }
+    
+    void release(const std::string& directory) {
+        auto it = directories.find(directory);
+        if (it == directories.end()) return;
+        if (--it->second.refs > 0) return;
+        
+        inotify_rm_watch(fd, it->second.descriptor);
+        paths.erase(it->second.descriptor);
+        directories.erase(it);
+    }
+    
+    /**
+     * @brief Drain pending events
+     * 
+     * Directories whose watch the kernel dropped (deleted or unmounted) are
+     * forgotten and reported in droppedDirectories; their references are gone.
+     * 
+     * @return false if the kernel queue overflowed and events were lost
+     */
+    bool read(std::vector<std::string>& changedFiles, std::vector<std::string>& createdDirectories,
+              std::vector<std::string>& droppedDirectories) {
+        bool complete = true;
+        alignas(inotify_event) char buffer[16 * 1024];
+        
+        for (;;) {
+            ssize_t length = ::read(fd, buffer, sizeof(buffer));
+            if (length <= 0) break;  // EAGAIN: queue drained
+            
+            for (ssize_t offset = 0; offset < length;) {
+                const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+                
+                if (event->mask & IN_Q_OVERFLOW) {
+                    complete = false;
+                    continue;
+                }
+                
+                auto it = paths.find(event->wd);
+                if (it == paths.end()) continue;
+                
+                if (event->mask & IN_IGNORED) {
+                    // Directory was deleted or unmounted; the kernel dropped the watch
+                    auto directory = directories.find(it->second);
+                    if (directory != directories.end() && directory->second.descriptor == event->wd) {
+                        directories.erase(directory);
+                        droppedDirectories.push_back(it->second);
+                    }
+                    paths.erase(it);
+                    continue;
+                }
+                
+                if (event->len == 0 || event->name[0] == '\0') continue;
+                std::string path = normalizeWatchPath(it->second + "/" + event->name);
+                
+                if (event->mask & IN_ISDIR) {
+                    if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                        createdDirectories.push_back(std::move(path));
+                    }
+                } else if (event->mask & (IN_CLOSE_WRITE | IN_MODIFY | IN_ATTRIB | IN_MOVED_TO)) {
+                    changedFiles.push_back(std::move(path));
+                }
+            }
+        }
+        
+        return complete;
+    }
+};
+
+#else
+
+/**
+ * @brief No event backend on this platform; FileWatcher polls
+ */
+struct FileWatcher::NativeWatcher {
+    static std::unique_ptr<NativeWatcher> create() { return nullptr; }
+    bool acquire(const std::string&) { return false; }
+    void release(const std::string&) {}
+    bool read(std::vector<std::string>&, std::vector<std::string>&, std::vector<std::string>&) { return true; }
+};
+
+#endif
+
+FileWatcher::FileWatcher()
+    : m_native(NativeWatcher::create()) {
+}
+
+FileWatcher::~FileWatcher() = default;
+
+void FileWatcher::watchFile(const std::string& path, FileChangeCallback callback) {
+    addWatch(path, std::move(callback), false);
 }
 
 void FileWatcher::watchDirectory(const std::string& path, FileChangeCallback callback) {
+    addWatch(path, std::move(callback), true);
+}
+
+void FileWatcher::addWatch(const std::string& path, FileChangeCallback callback, bool isDirectory) {
     std::lock_guard<std::mutex> lock(m_mutex);
     
     try {
+        auto existing = m_watches.find(path);
+        if (existing != m_watches.end()) {
+            removeNativeWatch(existing->second);
+            m_watchKeys.erase(existing->second.normalizedPath);
+            m_watches.erase(existing);
+        }
+        
         WatchEntry entry;
         entry.path = path;
+        entry.normalizedPath = normalizeWatchPath(path);
         entry.callback = std::move(callback);
-        entry.isDirectory = true;
+        entry.isDirectory = isDirectory;
         
         if (std::filesystem::exists(path)) {
             entry.lastModified = std::filesystem::last_write_time(path);
         }
         
-        m_watches[path] = std::move(entry);
+        auto& stored = m_watches[path] = std::move(entry);
+        m_watchKeys[stored.normalizedPath] = path;
+        addNativeWatch(stored);
     } catch (const std::exception& e) {
-        log(LogLevel::Warning, "Failed to watch directory: " + path + " - " + e.what());
+        log(LogLevel::Warning, std::string("Failed to watch ") + (isDirectory ? "directory: " : "file: ") +
+            path + " - " + e.what());
     }
 }
 
-
 void FileWatcher::unwatchFile(const std::string& path) {
     std::lock_guard<std::mutex> lock(m_mutex);
-    m_watches.erase(path);
+    removeWatch(path);
 }
 
 void FileWatcher::unwatchDirectory(const std::string& path) {
     std::lock_guard<std::mutex> lock(m_mutex);
-    m_watches.erase(path);
+    removeWatch(path);
+}
+
+void FileWatcher::removeWatch(const std::string& path) {
+    auto it = m_watches.find(path);
+    if (it == m_watches.end()) return;
     
-    // Also remove any tracked file timestamps for this directory
-    for (auto it = m_fileTimestamps.begin(); it != m_fileTimestamps.end();) {
-        if (it->first.find(path + "|") == 0) {
-            it = m_fileTimestamps.erase(it);
-        } else {
-            ++it;
+    removeNativeWatch(it->second);
+    m_watchKeys.erase(it->second.normalizedPath);
+    m_watches.erase(it);
+    
+    // A pass in progress may be iterating the removed directory
+    if (m_pollPassActive && m_pollIndex < m_pollOrder.size() && m_pollOrder[m_pollIndex] == path) {
+        m_pollIterating = false;
+        m_pollIndex++;
+    }
+}
+
+void FileWatcher::addNativeWatch(WatchEntry& entry) {
+    if (!m_native || m_forcePolling) return;
+    
+    if (!entry.isDirectory) {
+        std::string parent = parentWatchPath(entry.normalizedPath);
+        if (m_native->acquire(parent)) {
+            entry.nativeDirectories.push_back(std::move(parent));
+        }
+        return;
+    }
+    
+    if (!std::filesystem::is_directory(entry.normalizedPath)) return;
+    
+    // Every directory of the tree needs its own watch
+    if (m_native->acquire(entry.normalizedPath)) {
+        entry.nativeDirectories.push_back(entry.normalizedPath);
+    }
+    std::error_code ec;
+    for (std::filesystem::recursive_directory_iterator it(
+             entry.normalizedPath, std::filesystem::directory_options::skip_permission_denied, ec), end;
+         !ec && it != end; it.increment(ec)) {
+        if (it->is_directory(ec)) {
+            std::string directory = normalizeWatchPath(it->path().string());
+            if (m_native->acquire(directory)) {
+                entry.nativeDirectories.push_back(std::move(directory));
+            }
         }
     }
 }
 
+void FileWatcher::removeNativeWatch(WatchEntry& entry) {
+    if (m_native) {
+        for (const auto& directory : entry.nativeDirectories) {
+            m_native->release(directory);
+        }
+    }
+    entry.nativeDirectories.clear();
+}
+
 void FileWatcher::clearAll() {
     std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& [path, entry] : m_watches) {
+        removeNativeWatch(entry);
+    }
     m_watches.clear();
-    m_fileTimestamps.clear();
+    m_watchKeys.clear();
+    m_pendingChanges.clear();
+    resetPolling();
 }
 
 size_t FileWatcher::getWatchCount() const {
@@ -105,182 +329,362 @@ bool FileWatcher::isWatching(const std::string& path) const {
     return m_watches.find(path) != m_watches.end();
 }
 
-void FileWatcher::update() {
-    if (!m_enabled) return;
-    
+void FileWatcher::setDebounceInterval(std::chrono::milliseconds interval) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_debounceInterval = interval;
+}
+
+std::chrono::milliseconds FileWatcher::getDebounceInterval() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_debounceInterval;
+}
+
+void FileWatcher::setPollInterval(std::chrono::milliseconds interval) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_pollInterval = interval;
+}
+
+void FileWatcher::setPollBudget(size_t filesPerUpdate) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_pollBudget = filesPerUpdate;
+}
+
+void FileWatcher::setForcePolling(bool force) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (force == m_forcePolling) return;
+    
+    if (force) {
+        for (auto& [path, entry] : m_watches) {
+            removeNativeWatch(entry);
+            // Start polling from the current state rather than reporting stale changes
+            std::error_code ec;
+            auto time = std::filesystem::last_write_time(path, ec);
+            if (!ec) entry.lastModified = time;
+        }
+        m_forcePolling = true;
+        resetPolling();
+    } else {
+        m_forcePolling = false;
+        if (!m_native) {
+            m_native = NativeWatcher::create();
+        }
+        for (auto& [path, entry] : m_watches) {
+            entry.fileTimes.clear();
+            addNativeWatch(entry);
+        }
+    }
+}
+
+bool FileWatcher::isEventDriven() const {
     std::lock_guard<std::mutex> lock(m_mutex);
+    return m_native != nullptr && !m_forcePolling;
+}
+
+void FileWatcher::resetPolling() {
+    m_pollOrder.clear();
+    m_pollIndex = 0;
+    m_pollIterator = {};
+    m_pollIterating = false;
+    m_pollPassActive = false;
+    m_lastPollPass = {};
+}
+
+void FileWatcher::queueChange(const std::string& normalizedPath, Clock::time_point now) {
+    // Repeated changes to one path push its delivery back (coalescing)
+    m_pendingChanges[normalizedPath] = now;
+}
+
+void FileWatcher::resolveChange(const std::string& normalizedPath,
+                                std::vector<std::pair<FileChangeCallback, std::string>>& out) const {
+    // Watch on the file itself
+    auto key = m_watchKeys.find(normalizedPath);
+    if (key != m_watchKeys.end()) {
+        const WatchEntry& entry = m_watches.at(key->second);
+        if (!entry.isDirectory) {
+            out.emplace_back(entry.callback, entry.path);
+        }
+    }
     
-    for (auto& [path, entry] : m_watches) {
-        try {
-            if (!std::filesystem::exists(path)) continue;
-            
+    // Watches on any ancestor directory
+    std::string directory = normalizedPath;
+    for (;;) {
+        std::string parent = parentWatchPath(directory);
+        if (parent == directory) break;
+        directory = std::move(parent);
+        
+        key = m_watchKeys.find(directory);
+        if (key != m_watchKeys.end()) {
+            const WatchEntry& entry = m_watches.at(key->second);
             if (entry.isDirectory) {
-                // For directories, check all files within for changes
-                for (const auto& file : std::filesystem::recursive_directory_iterator(path)) {
-                    if (file.is_regular_file()) {
-                        auto filePath = file.path().string();
-                        auto currentTime = std::filesystem::last_write_time(file);
-                        
-                        // Check if this file has been modified since last check
-                        // We use a separate map to track individual file times within directories
-                        auto fileKey = path + "|" + filePath;
-                        auto it = m_fileTimestamps.find(fileKey);
-                        
-                        if (it == m_fileTimestamps.end()) {
-                            // First time seeing this file, record its timestamp
-                            m_fileTimestamps[fileKey] = currentTime;
-                        } else if (currentTime != it->second) {
-                            // File has been modified
-                            it->second = currentTime;
-                            entry.callback(filePath);
+                // Report the path under the directory as it was spelled when watched
+                std::string relative = directory == "." ? normalizedPath :
+                    normalizedPath.substr(directory.size() + (directory.back() == '/' ? 0 : 1));
+                out.emplace_back(entry.callback, (std::filesystem::path(entry.path) / relative).string());
+            }
+        }
+        
+        if (directory == "." || directory == "/") break;
+    }
+}
+
+void FileWatcher::collectNativeEvents(Clock::time_point now) {
+    std::vector<std::string> changedFiles;
+    std::vector<std::string> createdDirectories;
+    std::vector<std::string> droppedDirectories;
+    if (!m_native->read(changedFiles, createdDirectories, droppedDirectories)) {
+        log(LogLevel::Warning, "File change events were lost (inotify queue overflow)");
+    }
+    
+    for (const auto& file : changedFiles) {
+        queueChange(file, now);
+    }
+    
+    // Entries must not release a dropped watch, which may be acquired again
+    // under the same path. One left with no watches is polled, and watched
+    // again once its directory exists (see pollStep())
+    for (const auto& dropped : droppedDirectories) {
+        for (auto& [path, entry] : m_watches) {
+            std::erase(entry.nativeDirectories, dropped);
+        }
+    }
+    
+    // New subdirectories of a watched tree need watches of their own
+    for (const auto& created : createdDirectories) {
+        for (std::string directory = parentWatchPath(created);; directory = parentWatchPath(directory)) {
+            auto key = m_watchKeys.find(directory);
+            if (key != m_watchKeys.end()) {
+                WatchEntry& entry = m_watches.at(key->second);
+                if (entry.isDirectory) {
+                    if (m_native->acquire(created)) {
+                        entry.nativeDirectories.push_back(created);
+                    }
+                    std::error_code ec;
+                    for (std::filesystem::recursive_directory_iterator it(created, ec), end;
+                         !ec && it != end; it.increment(ec)) {
+                        if (it->is_directory(ec)) {
+                            std::string nested = normalizeWatchPath(it->path().string());
+                            if (m_native->acquire(nested)) {
+                                entry.nativeDirectories.push_back(std::move(nested));
+                            }
                         }
                     }
                 }
-            } else {
-                // For individual files
-                auto currentTime = std::filesystem::last_write_time(path);
-                
-                if (currentTime != entry.lastModified) {
-                    entry.lastModified = currentTime;
-                    entry.callback(path);
-                }
             }
-        } catch (const std::exception& e) {
-            log(LogLevel::Warning, "Error checking file: " + path + " - " + e.what());
+            if (directory == "." || directory == "/" || parentWatchPath(directory) == directory) break;
         }
     }
 }
 
-// ============================================================================
-// AssetBundle Implementation
-// ============================================================================
-
-AssetBundle::~AssetBundle() = default;
-
-// CRC32 lookup table for checksum calculation
-static const uint32_t crc32_table[256] = {
-    0x00000000, 0x77073096, 0xEE0E612C, 0x990951BA, 0x076DC419, 0x706AF48F,
-    0xE963A535, 0x9E6495A3, 0x0EDB8832, 0x79DCB8A4, 0xE0D5E91E, 0x97D2D988,
-    0x09B64C2B, 0x7EB17CBD, 0xE7B82D07, 0x90BF1D91, 0x1DB71064, 0x6AB020F2,
-    0xF3B97148, 0x84BE41DE, 0x1ADAD47D, 0x6DDDE4EB, 0xF4D4B551, 0x83D385C7,
-    0x136C9856, 0x646BA8C0, 0xFD62F97A, 0x8A65C9EC, 0x14015C4F, 0x63066CD9,
-    0xFA0F3D63, 0x8D080DF5, 0x3B6E20C8, 0x4C69105E, 0xD56041E4, 0xA2677172,
-    0x3C03E4D1, 0x4B04D447, 0xD20D85FD, 0xA50AB56B, 0x35B5A8FA, 0x42B2986C,
-    0xDBBBC9D6, 0xACBCF940, 0x32D86CE3, 0x45DF5C75, 0xDCD60DCF, 0xABD13D59,
-    0x26D930AC, 0x51DE003A, 0xC8D75180, 0xBFD06116, 0x21B4F4B5, 0x56B3C423,
-    0xCFBA9599, 0xB8BDA50F, 0x2802B89E, 0x5F058808, 0xC60CD9B2, 0xB10BE924,
-    0x2F6F7C87, 0x58684C11, 0xC1611DAB, 0xB6662D3D, 0x76DC4190, 0x01DB7106,
-    0x98D220BC, 0xEFD5102A, 0x71B18589, 0x06B6B51F, 0x9FBFE4A5, 0xE8B8D433,
-    0x7807C9A2, 0x0F00F934, 0x9609A88E, 0xE10E9818, 0x7F6A0DBB, 0x086D3D2D,
-    0x91646C97, 0xE6635C01, 0x6B6B51F4, 0x1C6C6162, 0x856530D8, 0xF262004E,
-    0x6C0695ED, 0x1B01A57B, 0x8208F4C1, 0xF50FC457, 0x65B0D9C6, 0x12B7E950,
-    0x8BBEB8EA, 0xFCB9887C, 0x62DD1DDF, 0x15DA2D49, 0x8CD37CF3, 0xFBD44C65,
-    0x4DB26158, 0x3AB551CE, 0xA3BC0074, 0xD4BB30E2, 0x4ADFA541, 0x3DD895D7,
-    0xA4D1C46D, 0xD3D6F4FB, 0x4369E96A, 0x346ED9FC, 0xAD678846, 0xDA60B8D0,
-    0x44042D73, 0x33031DE5, 0xAA0A4C5F, 0xDD0D7CC9, 0x5005713C, 0x270241AA,
-    0xBE0B1010, 0xC90C2086, 0x5768B525, 0x206F85B3, 0xB966D409, 0xCE61E49F,
-    0x5EDEF90E, 0x29D9C998, 0xB0D09822, 0xC7D7A8B4, 0x59B33D17, 0x2EB40D81,
-    0xB7BD5C3B, 0xC0BA6CAD, 0xEDB88320, 0x9ABFB3B6, 0x03B6E20C, 0x74B1D29A,
-    0xEAD54739, 0x9DD277AF, 0x04DB2615, 0x73DC1683, 0xE3630B12, 0x94643B84,
-    0x0D6D6A3E, 0x7A6A5AA8, 0xE40ECF0B, 0x9309FF9D, 0x0A00AE27, 0x7D079EB1,
-    0xF00F9344, 0x8708A3D2, 0x1E01F268, 0x6906C2FE, 0xF762575D, 0x806567CB,
-    0x196C3671, 0x6E6B06E7, 0xFED41B76, 0x89D32BE0, 0x10DA7A5A, 0x67DD4ACC,
-    0xF9B9DF6F, 0x8EBEEFF9, 0x17B7BE43, 0x60B08ED5, 0xD6D6A3E8, 0xA1D1937E,
-    0x38D8C2C4, 0x4FDFF252, 0xD1BB67F1, 0xA6BC5767, 0x3FB506DD, 0x48B2364B,
-    0xD80D2BDA, 0xAF0A1B4C, 0x36034AF6, 0x41047A60, 0xDF60EFC3, 0xA867DF55,
-    0x316E8EEF, 0x4669BE79, 0xCB61B38C, 0xBC66831A, 0x256FD2A0, 0x5268E236,
-    0xCC0C7795, 0xBB0B4703, 0x220216B9, 0x5505262F, 0xC5BA3BBE, 0xB2BD0B28,
-    0x2BB45A92, 0x5CB36A04, 0xC2D7FFA7, 0xB5D0CF31, 0x2CD99E8B, 0x5BDEAE1D,
-    0x9B64C2B0, 0xEC63F226, 0x756AA39C, 0x026D930A, 0x9C0906A9, 0xEB0E363F,
-    0x72076785, 0x05005713, 0x95BF4A82, 0xE2B87A14, 0x7BB12BAE, 0x0CB61B38,
-    0x92D28E9B, 0xE5D5BE0D, 0x7CDCEFB7, 0x0BDBDF21, 0x86D3D2D4, 0xF1D4E242,
-    0x68DDB3F8, 0x1FDA836E, 0x81BE16CD, 0xF6B9265B, 0x6FB077E1, 0x18B74777,
-    0x88085AE6, 0xFF0F6A70, 0x66063BCA, 0x11010B5C, 0x8F659EFF, 0xF862AE69,
-    0x616BFFD3, 0x166CCF45, 0xA00AE278, 0xD70DD2EE, 0x4E048354, 0x3903B3C2,
-    0xA7672661, 0xD06016F7, 0x4969474D, 0x3E6E77DB, 0xAED16A4A, 0xD9D65ADC,
-    0x40DF0B66, 0x37D83BF0, 0xA9BCAE53, 0xDEBB9EC5, 0x47B2CF7F, 0x30B5FFE9,
-    0xBDBDF21C, 0xCABAC28A, 0x53B39330, 0x24B4A3A6, 0xBAD03605, 0xCDD706B3,
-    0x54DE5729, 0x23D967BF, 0xB3667A2E, 0xC4614AB8, 0x5D681B02, 0x2A6F2B94,
-    0xB40BBE37, 0xC30C8EA1, 0x5A05DF1B, 0x2D02EF8D
-};
-
-uint32_t AssetBundle::calculateCRC32(const std::vector<uint8_t>& data) {
-    uint32_t crc = 0xFFFFFFFF;
-    for (uint8_t byte : data) {
-        crc = crc32_table[(crc ^ byte) & 0xFF] ^ (crc >> 8);
+void FileWatcher::pollStep(Clock::time_point now) {
+    if (!m_pollPassActive) {
+        if (m_lastPollPass != Clock::time_point{} && now - m_lastPollPass < m_pollInterval) {
+            return;
+        }
+        // With an event backend, only watches it could not cover are polled
+        const bool eventDriven = m_native && !m_forcePolling;
+        m_pollOrder.clear();
+        for (auto& [path, entry] : m_watches) {
+            if (eventDriven && !entry.nativeDirectories.empty()) continue;
+            if (eventDriven) {
+                addNativeWatch(entry);  // Retry; the path may exist now
+                if (entry.isDirectory && !entry.nativeDirectories.empty()) continue;
+            }
+            m_pollOrder.push_back(path);
+        }
+        m_pollIndex = 0;
+        m_pollIterating = false;
+        m_pollPassActive = true;
+        m_lastPollPass = now;
     }
-    return crc ^ 0xFFFFFFFF;
-}
-
-std::vector<uint8_t> AssetBundle::compress(const std::vector<uint8_t>& data) {
-    if (data.empty()) return {};
     
-    // Simple RLE compression
-    // Format: [count][byte] where count is 1-255
-    // If count > 127, it means (count - 128) literal bytes follow
-    std::vector<uint8_t> compressed;
-    compressed.reserve(data.size());
+    size_t budget = m_pollBudget == 0 ? std::numeric_limits<size_t>::max() : m_pollBudget;
     
-    size_t i = 0;
-    while (i < data.size()) {
-        // Count consecutive identical bytes
-        uint8_t currentByte = data[i];
-        size_t runLength = 1;
+    while (m_pollIndex < m_pollOrder.size() && budget > 0) {
+        auto watch = m_watches.find(m_pollOrder[m_pollIndex]);
+        if (watch == m_watches.end()) {
+            m_pollIndex++;
+            continue;
+        }
+        WatchEntry& entry = watch->second;
+        std::error_code ec;
         
-        while (i + runLength < data.size() && 
-               data[i + runLength] == currentByte && 
-               runLength < 127) {
-            runLength++;
+        if (!entry.isDirectory) {
+            auto currentTime = std::filesystem::last_write_time(entry.path, ec);
+            if (!ec && currentTime != entry.lastModified) {
+                entry.lastModified = currentTime;
+                queueChange(entry.normalizedPath, now);
+            }
+            budget--;
+            m_pollIndex++;
+            continue;
         }
         
-        if (runLength >= 3) {
-            // Encode as run: [count | 0x80][byte]
-            compressed.push_back(static_cast<uint8_t>(runLength | 0x80));
-            compressed.push_back(currentByte);
-            i += runLength;
-        } else {
-            // Collect literal bytes
-            size_t literalStart = i;
-            size_t literalCount = 0;
-            
-            while (i < data.size() && literalCount < 127) {
-                // Check if next bytes form a run
-                size_t nextRunLength = 1;
-                if (i + 1 < data.size()) {
-                    while (i + nextRunLength < data.size() && 
-                           data[i + nextRunLength] == data[i] && 
-                           nextRunLength < 127) {
-                        nextRunLength++;
-                    }
-                }
-                
-                if (nextRunLength >= 3) {
-                    break;  // Start a new run
-                }
-                
-                literalCount++;
-                i++;
+        if (!m_pollIterating) {
+            m_pollIterator = std::filesystem::recursive_directory_iterator(
+                entry.path, std::filesystem::directory_options::skip_permission_denied, ec);
+            if (ec) {
+                if (ec == std::errc::no_such_file_or_directory) entry.fileTimes.clear();
+                m_pollIndex++;
+                continue;
             }
+            m_pollIterating = true;
+            entry.walk++;
+        }
+        
+        // Resume the walk where the previous update stopped
+        for (; m_pollIterator != std::filesystem::recursive_directory_iterator() && budget > 0;
+             m_pollIterator.increment(ec)) {
+            if (ec) break;
+            const auto& file = *m_pollIterator;
+            if (!file.is_regular_file(ec)) continue;
             
-            if (literalCount > 0) {
-                // Encode as literals: [count][byte1][byte2]...
-                compressed.push_back(static_cast<uint8_t>(literalCount));
-                for (size_t j = 0; j < literalCount; j++) {
-                    compressed.push_back(data[literalStart + j]);
-                }
+            auto currentTime = file.last_write_time(ec);
+            if (ec) continue;
+            budget--;
+            
+            std::string filePath = normalizeWatchPath(file.path().string());
+            auto known = entry.fileTimes.find(filePath);
+            if (known == entry.fileTimes.end()) {
+                // First sighting only records the timestamp
+                entry.fileTimes.emplace(std::move(filePath), PolledFile{currentTime, entry.walk});
+                continue;
+            }
+            known->second.walk = entry.walk;
+            if (known->second.time != currentTime) {
+                known->second.time = currentTime;
+                queueChange(known->first, now);
+            }
+        }
+        
+        if (ec || m_pollIterator == std::filesystem::recursive_directory_iterator()) {
+            if (!ec) {
+                // A complete walk: files it did not find were deleted
+                std::erase_if(entry.fileTimes, [&](const auto& file) { return file.second.walk != entry.walk; });
+            }
+            m_pollIterator = {};
+            m_pollIterating = false;
+            m_pollIndex++;
+        }
+    }
+    
+    if (m_pollIndex >= m_pollOrder.size()) {
+        m_pollPassActive = false;
+    }
+}
+
+void FileWatcher::update() {
+    if (!m_enabled) return;
+    
+    std::vector<std::pair<FileChangeCallback, std::string>> notifications;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto now = Clock::now();
+        
+        try {
+            if (m_native && !m_forcePolling) {
+                collectNativeEvents(now);
+            }
+            pollStep(now);
+        } catch (const std::exception& e) {
+            log(LogLevel::Warning, std::string("Error checking watched files - ") + e.what());
+            resetPolling();
+        }
+        
+        // Deliver changes that have settled
+        for (auto it = m_pendingChanges.begin(); it != m_pendingChanges.end();) {
+            if (now - it->second >= m_debounceInterval) {
+                resolveChange(it->first, notifications);
+                it = m_pendingChanges.erase(it);
+            } else {
+                ++it;
             }
         }
     }
     
-    // Only use compression if it actually reduces size
-    if (compressed.size() >= data.size()) {
-        return data;  // Return original if compression doesn't help
+    // Callbacks may watch or unwatch paths, so they run without the lock
+    for (auto& [callback, path] : notifications) {
+        if (callback) {
+            callback(path);
+        }
+    }
+}
+
+// ============================================================================
+// AssetBundle Implementation
+// ============================================================================
+
+/**
+ * @brief Read-only memory mapping of a bundle file
+ */
+struct AssetBundle::MappedFile {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#endif
+    
+    bool open(const std::string& path) {
+#ifdef _WIN32
+        file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                           OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+        
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) return false;
+        size = static_cast<size_t>(fileSize.QuadPart);
+        
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) return false;
+        
+        data = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        return data != nullptr;
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+            ::close(fd);
+            return false;
+        }
+        size = static_cast<size_t>(st.st_size);
+        
+        void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);  // The mapping keeps its own reference to the file
+        if (mapped == MAP_FAILED) return false;
+        
+        data = static_cast<const uint8_t*>(mapped);
+        return true;
+#endif
     }
     
-    return compressed;
+    ~MappedFile() {
+#ifdef _WIN32
+        if (data) UnmapViewOfFile(data);
+        if (mapping) CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+#else
+        if (data) munmap(const_cast<uint8_t*>(data), size);
+#endif
+    }
+};
+
+AssetBundle::~AssetBundle() = default;
+
+/// Marks a version 2 block stored without compression
+static constexpr uint32_t RAW_BLOCK_FLAG = 0x80000000u;
+
+uint32_t AssetBundle::calculateCRC32(const std::vector<uint8_t>& data) {
+    return calculateCRC32(std::span<const uint8_t>(data));
+}
+
+uint32_t AssetBundle::calculateCRC32(std::span<const uint8_t> data) {
+    return CRC32::compute(data.data(), data.size());
 }
 
-std::vector<uint8_t> AssetBundle::decompress(const std::vector<uint8_t>& data, size_t originalSize) {
+std::vector<uint8_t> AssetBundle::decompressLegacyRLE(std::span<const uint8_t> data, size_t originalSize) {
+    // Version 1 entries: [count | 0x80][byte] runs and [count][bytes...] literals
     if (data.empty()) return {};
     
     std::vector<uint8_t> decompressed;
@@ -311,6 +715,44 @@ std::vector<uint8_t> AssetBundle::decompress(const std::vector<uint8_t>& data, s
     return decompressed;
 }
 
+bool AssetBundle::decompressBlocks(const BundleEntry& entry, std::span<const uint8_t> raw,
+                                   size_t firstBlock, size_t lastBlock, uint8_t* out) {
+    // Locate the stored bytes of each requested block
+    std::vector<size_t> sourceOffsets;
+    sourceOffsets.reserve(lastBlock - firstBlock);
+    size_t storedOffset = 0;
+    for (size_t i = 0; i < lastBlock; ++i) {
+        if (i >= firstBlock) {
+            sourceOffsets.push_back(storedOffset);
+        }
+        storedOffset += entry.blocks[i] & ~RAW_BLOCK_FLAG;
+    }
+    if (storedOffset > raw.size()) {
+        return false;
+    }
+    
+    auto decodeBlock = [&](size_t block) {
+        size_t begin = block * entry.blockSize;
+        size_t length = std::min<size_t>(entry.blockSize, entry.originalSize - begin);
+        size_t stored = entry.blocks[block] & ~RAW_BLOCK_FLAG;
+        const uint8_t* src = raw.data() + sourceOffsets[block - firstBlock];
+        uint8_t* dst = out + (begin - firstBlock * entry.blockSize);
+        
+        if (entry.blocks[block] & RAW_BLOCK_FLAG) {
+            if (stored != length) return false;
+            std::memcpy(dst, src, length);
+            return true;
+        }
+        return BlockCodec::decompress(src, stored, dst, length);
+    };
+    
+    // Serial: reads come from the loader pool, which already spreads entries over the cores
+    for (size_t i = firstBlock; i < lastBlock; ++i) {
+        if (!decodeBlock(i)) return false;
+    }
+    return true;
+}
+
 std::shared_ptr<AssetBundle> AssetBundle::load(const std::string& path) {
     auto bundle = std::shared_ptr<AssetBundle>(new AssetBundle());
     bundle->m_path = path;
@@ -331,35 +773,23 @@ std::shared_ptr<AssetBundle> AssetBundle::load(const std::string& path) {
     }
     
     // Validate version
-    if (bundle->m_header.version > 1) {
+    if (bundle->m_header.version > 2) {
         log(LogLevel::Warning, "Bundle version " + std::to_string(bundle->m_header.version) + 
             " may not be fully supported");
     }
     
-    // Read file entries
-    for (uint32_t i = 0; i < bundle->m_header.fileCount; ++i) {
-        BundleEntry entry;
-        
-        // Read path length and path
-        uint32_t pathLen = 0;
-        file.read(reinterpret_cast<char*>(&pathLen), sizeof(pathLen));
-        
-        if (pathLen > 4096) {  // Sanity check
-            log(LogLevel::Error, "Invalid path length in bundle: " + path);
-            return nullptr;
-        }
-        
-        entry.path.resize(pathLen);
-        file.read(entry.path.data(), pathLen);
-        
-        // Read entry metadata
-        file.read(reinterpret_cast<char*>(&entry.offset), sizeof(entry.offset));
-        file.read(reinterpret_cast<char*>(&entry.size), sizeof(entry.size));
-        file.read(reinterpret_cast<char*>(&entry.originalSize), sizeof(entry.originalSize));
-        file.read(reinterpret_cast<char*>(&entry.checksum), sizeof(entry.checksum));
-        file.read(reinterpret_cast<char*>(&entry.compressed), sizeof(entry.compressed));
-        
-        bundle->m_entries[entry.path] = entry;
+    if (bundle->m_header.dataOffset < sizeof(BundleHeader) ||
+        bundle->m_header.totalSize < bundle->m_header.dataOffset) {
+        log(LogLevel::Error, "Invalid bundle layout: " + path);
+        return nullptr;
+    }
+    
+    // Read and parse file entries
+    std::vector<uint8_t> table(bundle->m_header.dataOffset - sizeof(BundleHeader));
+    file.read(reinterpret_cast<char*>(table.data()), table.size());
+    if (!file || !bundle->parseEntryTable(table)) {
+        log(LogLevel::Error, "Invalid entry table in bundle: " + path);
+        return nullptr;
     }
     
     // Read all data
@@ -374,6 +804,155 @@ std::shared_ptr<AssetBundle> AssetBundle::load(const std::string& path) {
     return bundle;
 }
 
+std::shared_ptr<AssetBundle> AssetBundle::loadMapped(const std::string& path) {
+    auto mapping = std::make_shared<MappedFile>();
+    if (!mapping->open(path)) {
+        log(LogLevel::Warning, "Failed to map bundle, falling back to buffered load: " + path);
+        return load(path);
+    }
+    
+    auto bundle = std::shared_ptr<AssetBundle>(new AssetBundle());
+    bundle->m_path = path;
+    
+    if (mapping->size < sizeof(BundleHeader)) {
+        log(LogLevel::Error, "Invalid bundle format: " + path);
+        return nullptr;
+    }
+    std::memcpy(&bundle->m_header, mapping->data, sizeof(BundleHeader));
+    
+    if (std::memcmp(bundle->m_header.magic, "KGKB", 4) != 0) {
+        log(LogLevel::Error, "Invalid bundle format: " + path);
+        return nullptr;
+    }
+    
+    if (bundle->m_header.version > 2) {
+        log(LogLevel::Warning, "Bundle version " + std::to_string(bundle->m_header.version) + 
+            " may not be fully supported");
+    }
+    
+    if (bundle->m_header.dataOffset < sizeof(BundleHeader) ||
+        bundle->m_header.totalSize < bundle->m_header.dataOffset ||
+        bundle->m_header.totalSize > mapping->size) {
+        log(LogLevel::Error, "Invalid bundle layout: " + path);
+        return nullptr;
+    }
+    
+    // The entry table is parsed on first lookup
+    bundle->m_mapping = std::move(mapping);
+    bundle->m_entriesParsed = false;
+    
+    log(LogLevel::Info, "Mapped bundle: " + path + " with " + 
+        std::to_string(bundle->m_header.fileCount) + " files");
+    
+    return bundle;
+}
+
+bool AssetBundle::parseEntryTable(std::span<const uint8_t> table) const {
+    size_t cursor = 0;
+    auto read = [&](void* dst, size_t size) {
+        if (cursor + size > table.size()) return false;
+        std::memcpy(dst, table.data() + cursor, size);
+        cursor += size;
+        return true;
+    };
+    
+    m_entries.clear();
+    
+    // Each entry takes at least its fixed fields, so a corrupt count cannot
+    // reserve more than the table could hold
+    size_t minEntrySize = sizeof(uint32_t) + 3 * sizeof(uint64_t) + sizeof(uint32_t) + sizeof(bool);
+    if (m_header.version >= 2) minEntrySize += 2 * sizeof(uint32_t);
+    if (m_header.fileCount > table.size() / minEntrySize) {
+        return false;
+    }
+    m_entries.reserve(m_header.fileCount);
+    
+    for (uint32_t i = 0; i < m_header.fileCount; ++i) {
+        BundleEntry entry;
+        
+        // Read path length and path
+        uint32_t pathLen = 0;
+        if (!read(&pathLen, sizeof(pathLen)) || pathLen > 4096) {  // Sanity check
+            m_entries.clear();
+            return false;
+        }
+        entry.path.resize(pathLen);
+        
+        // Read entry metadata
+        if (!read(entry.path.data(), pathLen) ||
+            !read(&entry.offset, sizeof(entry.offset)) ||
+            !read(&entry.size, sizeof(entry.size)) ||
+            !read(&entry.originalSize, sizeof(entry.originalSize)) ||
+            !read(&entry.checksum, sizeof(entry.checksum)) ||
+            !read(&entry.compressed, sizeof(entry.compressed))) {
+            m_entries.clear();
+            return false;
+        }
+        
+        // Version 2: block table for compressed entries
+        if (m_header.version >= 2) {
+            uint32_t blockCount = 0;
+            if (!read(&entry.blockSize, sizeof(entry.blockSize)) ||
+                !read(&blockCount, sizeof(blockCount)) ||
+                blockCount > (table.size() - cursor) / sizeof(uint32_t)) {
+                m_entries.clear();
+                return false;
+            }
+            if (blockCount > 0) {
+                entry.blocks.resize(blockCount);
+                read(entry.blocks.data(), blockCount * sizeof(uint32_t));
+                
+                uint64_t storedTotal = 0;
+                for (uint32_t stored : entry.blocks) {
+                    storedTotal += stored & ~RAW_BLOCK_FLAG;
+                }
+                if (entry.blockSize == 0 || storedTotal != entry.size ||
+                    blockCount != (entry.originalSize + entry.blockSize - 1) / entry.blockSize) {
+                    m_entries.clear();
+                    return false;
+                }
+            }
+        }
+        
+        std::string key = entry.path;
+        m_entries[std::move(key)] = std::move(entry);
+    }
+    
+    return true;
+}
+
+bool AssetBundle::ensureEntriesParsed() const {
+    if (m_entriesParsed) return true;
+    m_entriesParsed = true;
+    
+    // Caller holds m_mutex; the layout was validated in loadMapped()
+    std::span<const uint8_t> table(m_mapping->data + sizeof(BundleHeader),
+                                   m_header.dataOffset - sizeof(BundleHeader));
+    if (!parseEntryTable(table)) {
+        log(LogLevel::Error, "Invalid entry table in bundle: " + m_path);
+        return false;
+    }
+    return true;
+}
+
+std::span<const uint8_t> AssetBundle::dataSection() const {
+    if (m_mapping) {
+        return std::span<const uint8_t>(m_mapping->data + m_header.dataOffset,
+                                        m_header.totalSize - m_header.dataOffset);
+    }
+    return std::span<const uint8_t>(m_data);
+}
+
+void AssetBundle::detachMapping() {
+    // Caller holds m_mutex. Copy the data section so the bundle can be edited;
+    // views still borrowing from the mapping keep it alive
+    if (!m_mapping) return;
+    ensureEntriesParsed();
+    auto section = dataSection();
+    m_data.assign(section.begin(), section.end());
+    m_mapping.reset();
+}
+
 
 std::shared_ptr<AssetBundle> AssetBundle::create() {
     return std::shared_ptr<AssetBundle>(new AssetBundle());
@@ -397,6 +976,7 @@ bool AssetBundle::addFile(const std::string& virtualPath, const std::string& rea
 
 bool AssetBundle::addData(const std::string& virtualPath, const std::vector<uint8_t>& data) {
     std::lock_guard<std::mutex> lock(m_mutex);
+    detachMapping();
     
     // Check if entry already exists
     if (m_entries.find(virtualPath) != m_entries.end()) {
@@ -412,8 +992,9 @@ bool AssetBundle::addData(const std::string& virtualPath, const std::vector<uint
     entry.compressed = false;  // Compression is applied during save
     entry.size = data.size();
     
-    // Calculate CRC32 checksum
+    // Calculate CRC32 checksum; the caller's bytes need no later verification
     entry.checksum = calculateCRC32(data);
+    entry.verified = true;
     
     m_entries[virtualPath] = entry;
     m_data.insert(m_data.end(), data.begin(), data.end());
@@ -460,55 +1041,78 @@ int AssetBundle::addDirectory(const std::string& virtualBasePath, const std::str
     return filesAdded;
 }
 
-bool AssetBundle::save(const std::string& path, bool compressData) {
+bool AssetBundle::save(const std::string& path, bool compressData, size_t blockSize) {
     std::lock_guard<std::mutex> lock(m_mutex);
     
+    if (blockSize == 0 || blockSize >= RAW_BLOCK_FLAG) {
+        log(LogLevel::Error, "Invalid bundle block size: " + std::to_string(blockSize));
+        return false;
+    }
+    
     std::ofstream file(path, std::ios::binary);
     if (!file.is_open()) {
         log(LogLevel::Error, "Failed to create bundle: " + path);
         return false;
     }
     
-    // Prepare data for saving - optionally compress each entry
+    // Prepare data for saving - optionally compress each entry in blocks
+    ensureEntriesParsed();
     std::vector<uint8_t> outputData;
     std::unordered_map<std::string, BundleEntry> outputEntries;
+    std::vector<uint8_t> blockBuffer(BlockCodec::compressBound(blockSize));
     
     for (auto& [vpath, entry] : m_entries) {
         BundleEntry outputEntry = entry;
         outputEntry.offset = outputData.size();
+        outputEntry.compressed = false;
+        outputEntry.blockSize = 0;
+        outputEntry.blocks.clear();
         
-        // Get original data
-        std::vector<uint8_t> originalData(entry.size);
-        if (entry.offset + entry.size <= m_data.size()) {
-            std::memcpy(originalData.data(), m_data.data() + entry.offset, entry.size);
-        }
+        // Get original data (entries loaded from a compressed bundle are decoded first)
+        BundleData originalData = readEntry(entry);
+        auto original = originalData.span();
+        outputEntry.originalSize = original.size();
         
-        if (compressData && !originalData.empty()) {
-            // Compress the data
-            std::vector<uint8_t> compressedData = compress(originalData);
+        if (compressData && !original.empty()) {
+            std::vector<uint8_t> compressedData;
+            std::vector<uint32_t> blocks;
+            
+            for (size_t begin = 0; begin < original.size(); begin += blockSize) {
+                size_t length = std::min(blockSize, original.size() - begin);
+                size_t stored = BlockCodec::compress(original.data() + begin, length,
+                                                     blockBuffer.data(), blockBuffer.size());
+                
+                if (stored > 0 && stored < length) {
+                    compressedData.insert(compressedData.end(), blockBuffer.begin(),
+                                          blockBuffer.begin() + stored);
+                    blocks.push_back(static_cast<uint32_t>(stored));
+                } else {
+                    // Incompressible block, keep it raw
+                    compressedData.insert(compressedData.end(), original.begin() + begin,
+                                          original.begin() + begin + length);
+                    blocks.push_back(static_cast<uint32_t>(length) | RAW_BLOCK_FLAG);
+                }
+            }
             
-            if (compressedData.size() < originalData.size()) {
+            if (compressedData.size() < original.size()) {
                 // Compression was beneficial
                 outputEntry.size = compressedData.size();
-                outputEntry.originalSize = originalData.size();
                 outputEntry.compressed = true;
+                outputEntry.blockSize = static_cast<uint32_t>(blockSize);
+                outputEntry.blocks = std::move(blocks);
                 outputData.insert(outputData.end(), compressedData.begin(), compressedData.end());
             } else {
-                // Compression didn't help, store uncompressed
-                outputEntry.size = originalData.size();
-                outputEntry.originalSize = originalData.size();
-                outputEntry.compressed = false;
-                outputData.insert(outputData.end(), originalData.begin(), originalData.end());
+                // Compression didn't help; stored raw, mapped reads stay zero-copy
+                outputEntry.size = original.size();
+                outputData.insert(outputData.end(), original.begin(), original.end());
             }
         } else {
             // Store uncompressed
-            outputEntry.size = originalData.size();
-            outputEntry.originalSize = originalData.size();
-            outputEntry.compressed = false;
-            outputData.insert(outputData.end(), originalData.begin(), originalData.end());
+            outputEntry.size = original.size();
+            outputData.insert(outputData.end(), original.begin(), original.end());
         }
         
-        outputEntries[vpath] = outputEntry;
+        outputEntries[vpath] = std::move(outputEntry);
     }
     
     // Calculate data offset (header + entries)
@@ -518,10 +1122,13 @@ bool AssetBundle::save(const std::string& path, bool compressData) {
         entriesSize += sizeof(entry.offset) + sizeof(entry.size) + 
                        sizeof(entry.originalSize) + sizeof(entry.checksum) + 
                        sizeof(entry.compressed);
+        entriesSize += sizeof(entry.blockSize) + sizeof(uint32_t) +  // Block size + count
+                       entry.blocks.size() * sizeof(uint32_t);
     }
     
     // Update header
     BundleHeader outputHeader = m_header;
+    outputHeader.version = BundleHeader{}.version;
     outputHeader.fileCount = static_cast<uint32_t>(outputEntries.size());
     outputHeader.dataOffset = sizeof(BundleHeader) + entriesSize;
     outputHeader.totalSize = outputHeader.dataOffset + outputData.size();
@@ -533,6 +1140,7 @@ bool AssetBundle::save(const std::string& path, bool compressData) {
     // Write entries
     for (const auto& [vpath, entry] : outputEntries) {
         uint32_t pathLen = static_cast<uint32_t>(vpath.size());
+        uint32_t blockCount = static_cast<uint32_t>(entry.blocks.size());
         file.write(reinterpret_cast<const char*>(&pathLen), sizeof(pathLen));
         file.write(vpath.data(), pathLen);
         file.write(reinterpret_cast<const char*>(&entry.offset), sizeof(entry.offset));
@@ -540,6 +1148,9 @@ bool AssetBundle::save(const std::string& path, bool compressData) {
         file.write(reinterpret_cast<const char*>(&entry.originalSize), sizeof(entry.originalSize));
         file.write(reinterpret_cast<const char*>(&entry.checksum), sizeof(entry.checksum));
         file.write(reinterpret_cast<const char*>(&entry.compressed), sizeof(entry.compressed));
+        file.write(reinterpret_cast<const char*>(&entry.blockSize), sizeof(entry.blockSize));
+        file.write(reinterpret_cast<const char*>(&blockCount), sizeof(blockCount));
+        file.write(reinterpret_cast<const char*>(entry.blocks.data()), blockCount * sizeof(uint32_t));
     }
     
     // Write data
@@ -556,53 +1167,196 @@ bool AssetBundle::save(const std::string& path, bool compressData) {
 
 bool AssetBundle::contains(const std::string& virtualPath) const {
     std::lock_guard<std::mutex> lock(m_mutex);
+    ensureEntriesParsed();
     return m_entries.find(virtualPath) != m_entries.end();
 }
 
 std::vector<uint8_t> AssetBundle::getData(const std::string& virtualPath) const {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    BundleData data = getView(virtualPath);
+    if (!data.isZeroCopy() && !data.empty()) {
+        // Decompressed buffers are already owned; hand them over without a copy
+        return std::move(data.m_owned);
+    }
+    return data.toVector();
+}
+
+BundleData AssetBundle::getView(const std::string& virtualPath) const {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    ensureEntriesParsed();
     
     auto it = m_entries.find(virtualPath);
     if (it == m_entries.end()) {
         return {};
     }
     
-    const auto& entry = it->second;
+    // Decode and hash without the lock, so other readers of the bundle
+    // (such as the other loader threads) are not held up
+    BundleEntry entry = it->second;
+    BundleData stored;
+    if (!storedBytes(entry, stored)) {
+        return {};
+    }
+    bool check = needsVerification(entry, false);
+    lock.unlock();
     
-    // Bounds check
-    if (entry.offset + entry.size > m_data.size()) {
-        log(LogLevel::Error, "Invalid entry offset/size in bundle for: " + virtualPath);
+    BundleData result = isEncoded(entry) ? decodeEntry(entry, stored.span()) : std::move(stored);
+    if (check) {
+        bool valid = calculateCRC32(result.span()) == entry.checksum;
+        lock.lock();
+        auto current = m_entries.find(virtualPath);
+        if (current != m_entries.end() && current->second.checksum == entry.checksum) {
+            recordVerification(current->second, valid);
+        }
+    }
+    return result;
+}
+
+BundleData AssetBundle::getRange(const std::string& virtualPath, size_t offset, size_t length) const {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    ensureEntriesParsed();
+    
+    auto it = m_entries.find(virtualPath);
+    if (it == m_entries.end() || offset >= it->second.originalSize) {
         return {};
     }
     
-    // Extract raw data
-    std::vector<uint8_t> rawData(entry.size);
-    std::memcpy(rawData.data(), m_data.data() + entry.offset, entry.size);
+    BundleEntry entry = it->second;
+    length = std::min<size_t>(length, entry.originalSize - offset);
+    
+    if (!isEncoded(entry)) {
+        auto section = dataSection();
+        if (entry.offset + entry.size > section.size() || offset + length > entry.size) {
+            log(LogLevel::Error, "Invalid entry offset/size in bundle for: " + entry.path);
+            return {};
+        }
+        return borrow(section.subspan(entry.offset + offset, length));
+    }
+    
+    // Decode without the lock, as getView() does
+    BundleData stored;
+    if (!storedBytes(entry, stored)) {
+        return {};
+    }
+    lock.unlock();
+    auto raw = stored.span();
     
-    // Decompress if needed
-    if (entry.compressed && entry.size != entry.originalSize) {
-        std::vector<uint8_t> decompressedData = decompress(rawData, entry.originalSize);
+    if (!entry.blocks.empty()) {
+        // Decode only the blocks covering the range
+        size_t firstBlock = offset / entry.blockSize;
+        size_t lastBlock = (offset + length + entry.blockSize - 1) / entry.blockSize;
+        size_t decodedEnd = std::min<size_t>(lastBlock * entry.blockSize, entry.originalSize);
         
-        // Verify checksum
-        uint32_t checksum = calculateCRC32(decompressedData);
-        if (checksum != entry.checksum) {
-            log(LogLevel::Warning, "Checksum mismatch for: " + virtualPath);
+        std::vector<uint8_t> decoded(decodedEnd - firstBlock * entry.blockSize);
+        if (!decompressBlocks(entry, raw, firstBlock, lastBlock, decoded.data())) {
+            log(LogLevel::Error, "Corrupt compressed data in bundle for: " + entry.path);
+            return {};
         }
         
-        return decompressedData;
+        size_t skip = offset - firstBlock * entry.blockSize;
+        decoded.erase(decoded.begin() + skip + length, decoded.end());
+        decoded.erase(decoded.begin(), decoded.begin() + skip);
+        return BundleData(std::move(decoded));
     }
     
-    // Verify checksum for uncompressed data
-    uint32_t checksum = calculateCRC32(rawData);
-    if (checksum != entry.checksum) {
-        log(LogLevel::Warning, "Checksum mismatch for: " + virtualPath);
+    // Version 1 entries are compressed as a whole
+    std::vector<uint8_t> decoded = decompressLegacyRLE(raw, entry.originalSize);
+    if (offset >= decoded.size()) return {};
+    length = std::min(length, decoded.size() - offset);
+    return BundleData(std::vector<uint8_t>(decoded.begin() + offset, decoded.begin() + offset + length));
+}
+
+BundleData AssetBundle::readEntry(BundleEntry& entry, bool forceVerify) const {
+    BundleData stored;
+    if (!storedBytes(entry, stored)) {
+        return {};
+    }
+    
+    BundleData result = isEncoded(entry) ? decodeEntry(entry, stored.span()) : std::move(stored);
+    if (needsVerification(entry, forceVerify)) {
+        recordVerification(entry, calculateCRC32(result.span()) == entry.checksum);
+    }
+    return result;
+}
+
+bool AssetBundle::storedBytes(const BundleEntry& entry, BundleData& stored) const {
+    // Caller holds m_mutex; the result stays valid once it is released
+    auto section = dataSection();
+    if (entry.offset + entry.size > section.size()) {
+        log(LogLevel::Error, "Invalid entry offset/size in bundle for: " + entry.path);
+        return false;
+    }
+    stored = borrow(section.subspan(entry.offset, entry.size));
+    return true;
+}
+
+bool AssetBundle::isEncoded(const BundleEntry& entry) {
+    return !entry.blocks.empty() || (entry.compressed && entry.size != entry.originalSize);
+}
+
+BundleData AssetBundle::decodeEntry(const BundleEntry& entry, std::span<const uint8_t> raw) {
+    if (entry.blocks.empty()) {
+        return BundleData(decompressLegacyRLE(raw, entry.originalSize));
+    }
+    std::vector<uint8_t> decoded(entry.originalSize);
+    if (!decompressBlocks(entry, raw, 0, entry.blocks.size(), decoded.data())) {
+        log(LogLevel::Error, "Corrupt compressed data in bundle for: " + entry.path);
+        return {};
+    }
+    return BundleData(std::move(decoded));
+}
+
+BundleData AssetBundle::borrow(std::span<const uint8_t> bytes) const {
+    // The mapping never changes while a view holds it; a buffered bundle's
+    // data moves when entries are added, so its bytes are copied
+    if (!m_mapping) {
+        return BundleData(std::vector<uint8_t>(bytes.begin(), bytes.end()));
+    }
+    BundleData result;
+    result.m_mapping = m_mapping;
+    result.m_view = bytes;
+    return result;
+}
+
+bool AssetBundle::needsVerification(const BundleEntry& entry, bool force) const {
+    return force || m_verification == BundleVerification::Always ||
+           (m_verification == BundleVerification::FirstAccess && !entry.verified && !entry.failed);
+}
+
+void AssetBundle::recordVerification(BundleEntry& entry, bool valid) const {
+    if (!valid) {
+        log(LogLevel::Warning, "Checksum mismatch for: " + entry.path);
     }
+    entry.verified = valid;
+    entry.failed = !valid;
+}
+
+bool AssetBundle::verifyAll() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ensureEntriesParsed();
     
-    return rawData;
+    bool allValid = true;
+    for (auto& [path, entry] : m_entries) {
+        if (!entry.verified) {
+            readEntry(entry, true);  // Leaves entry.verified false on any failure
+            allValid = allValid && entry.verified;
+        }
+    }
+    return allValid;
+}
+
+void AssetBundle::setVerification(BundleVerification mode) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_verification = mode;
+}
+
+BundleVerification AssetBundle::getVerification() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_verification;
 }
 
 std::vector<std::string> AssetBundle::getFileList() const {
     std::lock_guard<std::mutex> lock(m_mutex);
+    ensureEntriesParsed();
     
     std::vector<std::string> files;
     files.reserve(m_entries.size());
@@ -619,6 +1373,7 @@ std::vector<std::string> AssetBundle::getFileList() const {
 
 size_t AssetBundle::getTotalSize() const {
     std::lock_guard<std::mutex> lock(m_mutex);
+    ensureEntriesParsed();
     
     size_t total = 0;
     for (const auto& [path, entry] : m_entries) {
@@ -629,6 +1384,7 @@ size_t AssetBundle::getTotalSize() const {
 
 const BundleEntry* AssetBundle::getEntry(const std::string& virtualPath) const {
     std::lock_guard<std::mutex> lock(m_mutex);
+    ensureEntriesParsed();
     
     auto it = m_entries.find(virtualPath);
     if (it == m_entries.end()) {
@@ -639,6 +1395,7 @@ const BundleEntry* AssetBundle::getEntry(const std::string& virtualPath) const {
 
 int AssetBundle::extractAll(const std::string& outputDir) const {
     std::lock_guard<std::mutex> lock(m_mutex);
+    ensureEntriesParsed();
     
     int extracted = 0;
     
@@ -675,33 +1432,190 @@ int AssetBundle::extractAll(const std::string& outputDir) const {
         return -1;
     }
     
-    log(LogLevel::Info, "Extracted " + std::to_string(extracted) + " files to: " + outputDir);
-    return extracted;
+    log(LogLevel::Info, "Extracted " + std::to_string(extracted) + " files to: " + outputDir);
+    return extracted;
+}
+
+bool AssetBundle::extractFile(const std::string& virtualPath, const std::string& outputPath) const {
+    std::vector<uint8_t> data = getData(virtualPath);
+    if (data.empty()) {
+        return false;
+    }
+    
+    try {
+        // Create parent directories
+        std::filesystem::path filePath(outputPath);
+        std::filesystem::create_directories(filePath.parent_path());
+        
+        std::ofstream file(outputPath, std::ios::binary);
+        if (!file.is_open()) {
+            log(LogLevel::Error, "Failed to create output file: " + outputPath);
+            return false;
+        }
+        
+        file.write(reinterpret_cast<const char*>(data.data()), data.size());
+        return true;
+    } catch (const std::exception& e) {
+        log(LogLevel::Error, "Error extracting file: " + std::string(e.what()));
+        return false;
+    }
+}
+
+
+// ============================================================================
+// EvictionIndex Implementation
+// ============================================================================
+
+void EvictionIndex::pushBack(List& list, Node* node, Links Node::*links) {
+    (node->*links).prev = list.tail;
+    (node->*links).next = nullptr;
+    if (list.tail) {
+        (list.tail->*links).next = node;
+    } else {
+        list.head = node;
+    }
+    list.tail = node;
+}
+
+void EvictionIndex::unlink(List& list, Node* node, Links Node::*links) {
+    Links& own = node->*links;
+    if (own.prev) {
+        (own.prev->*links).next = own.next;
+    } else {
+        list.head = own.next;
+    }
+    if (own.next) {
+        (own.next->*links).prev = own.prev;
+    } else {
+        list.tail = own.prev;
+    }
+    own.prev = nullptr;
+    own.next = nullptr;
+}
+
+void EvictionIndex::linkToBucket(Node* node, BucketIterator hint) {
+    // hint is the first bucket that may hold node's count
+    size_t count = node->entry.accessCount;
+    if (hint == m_buckets.end() || hint->accessCount != count) {
+        hint = m_buckets.insert(hint, FrequencyBucket{count, {}});
+    }
+    pushBack(hint->members, node, &Node::frequency);
+    node->bucket = hint;
+}
+
+void EvictionIndex::unlinkFromBucket(Node* node) {
+    unlink(node->bucket->members, node, &Node::frequency);
+    if (!node->bucket->members.head) {
+        m_buckets.erase(node->bucket);
+    }
+}
+
+void EvictionIndex::insert(const std::string& key, ResourceType type, size_t memoryUsage) {
+    erase(key);
+    
+    auto [it, inserted] = m_nodes.try_emplace(key);
+    Node* node = &it->second;
+    node->key = &it->first;
+    node->entry.type = type;
+    node->entry.memoryUsage = memoryUsage;
+    node->entry.loadTime = std::chrono::steady_clock::now();
+    node->entry.lastAccessTime = node->entry.loadTime;
+    node->entry.accessCount = 1;
+    
+    pushBack(m_recency, node, &Node::recency);
+    pushBack(m_arrival, node, &Node::arrival);
+    linkToBucket(node, m_buckets.begin());
+}
+
+bool EvictionIndex::erase(const std::string& key) {
+    auto it = m_nodes.find(key);
+    if (it == m_nodes.end()) {
+        return false;
+    }
+    
+    Node* node = &it->second;
+    unlink(m_recency, node, &Node::recency);
+    unlink(m_arrival, node, &Node::arrival);
+    unlinkFromBucket(node);
+    m_nodes.erase(it);
+    return true;
+}
+
+void EvictionIndex::touch(const std::string& key) {
+    auto it = m_nodes.find(key);
+    if (it == m_nodes.end()) {
+        return;
+    }
+    
+    Node* node = &it->second;
+    node->entry.lastAccessTime = std::chrono::steady_clock::now();
+    unlink(m_recency, node, &Node::recency);
+    pushBack(m_recency, node, &Node::recency);
+    
+    // Move to the next bucket up; the old one may disappear once empty
+    BucketIterator next = std::next(node->bucket);
+    unlinkFromBucket(node);
+    node->entry.accessCount++;
+    linkToBucket(node, next);
+}
+
+void EvictionIndex::refresh(const std::string& key, size_t memoryUsage) {
+    auto it = m_nodes.find(key);
+    if (it == m_nodes.end()) {
+        return;
+    }
+    
+    Node* node = &it->second;
+    node->entry.memoryUsage = memoryUsage;
+    node->entry.lastAccessTime = std::chrono::steady_clock::now();
+    unlink(m_recency, node, &Node::recency);
+    pushBack(m_recency, node, &Node::recency);
 }
 
-bool AssetBundle::extractFile(const std::string& virtualPath, const std::string& outputPath) const {
-    std::vector<uint8_t> data = getData(virtualPath);
-    if (data.empty()) {
-        return false;
-    }
+const EvictionIndex::Entry* EvictionIndex::find(const std::string& key) const {
+    auto it = m_nodes.find(key);
+    return it != m_nodes.end() ? &it->second.entry : nullptr;
+}
+
+std::vector<std::string> EvictionIndex::collect(EvictionPolicy policy, size_t bytesToFree) const {
+    std::vector<std::string> candidates;
+    size_t totalToFree = 0;
     
-    try {
-        // Create parent directories
-        std::filesystem::path filePath(outputPath);
-        std::filesystem::create_directories(filePath.parent_path());
-        
-        std::ofstream file(outputPath, std::ios::binary);
-        if (!file.is_open()) {
-            log(LogLevel::Error, "Failed to create output file: " + outputPath);
-            return false;
+    auto take = [&](const List& list, Links Node::*links) {
+        for (const Node* node = list.head; node && totalToFree < bytesToFree;
+             node = (node->*links).next) {
+            candidates.push_back(*node->key);
+            totalToFree += node->entry.memoryUsage;
         }
-        
-        file.write(reinterpret_cast<const char*>(data.data()), data.size());
-        return true;
-    } catch (const std::exception& e) {
-        log(LogLevel::Error, "Error extracting file: " + std::string(e.what()));
-        return false;
+    };
+    
+    switch (policy) {
+        case EvictionPolicy::LRU:
+            take(m_recency, &Node::recency);
+            break;
+            
+        case EvictionPolicy::LFU:
+            for (const auto& bucket : m_buckets) {
+                if (totalToFree >= bytesToFree) {
+                    break;
+                }
+                take(bucket.members, &Node::frequency);
+            }
+            break;
+            
+        case EvictionPolicy::FIFO:
+            take(m_arrival, &Node::arrival);
+            break;
     }
+    
+    return candidates;
+}
+
+void EvictionIndex::clear() {
+    m_nodes.clear();
+    m_recency = {};
+    m_arrival = {};
+    m_buckets.clear();
 }
 
 
@@ -716,6 +1630,8 @@ ResourceManager& ResourceManager::instance() {
 
 ResourceManager::~ResourceManager() {
     shutdown();
+    std::lock_guard<std::mutex> threadsLock(m_loaderThreadsMutex);
+    stopLoaderThreads();
 }
 
 bool ResourceManager::initialize() {
@@ -731,6 +1647,24 @@ bool ResourceManager::initialize() {
 void ResourceManager::shutdown() {
     if (!m_initialized) return;
     
+    // Stop async loading and fail any request that never finished
+    {
+        std::lock_guard<std::mutex> threadsLock(m_loaderThreadsMutex);
+        stopLoaderThreads();
+    }
+    std::unordered_map<std::string, AsyncLoadRequestPtr> abandoned;
+    {
+        std::lock_guard<std::mutex> lock(m_loaderMutex);
+        abandoned.swap(m_inFlightLoads);
+        m_decodeQueue = {};
+        m_uploadQueue = {};
+    }
+    for (const auto& [key, request] : abandoned) {
+        for (const auto& callback : request->callbacks) {
+            callback(request->path, false);
+        }
+    }
+    
     clearCache();
     
     {
@@ -777,7 +1711,7 @@ TextureHandle ResourceManager::loadImage(const std::string& path, const TextureC
     TextureHandle texture;
     
     // Try loading from bundle first
-    std::vector<uint8_t> bundleData;
+    BundleData bundleData;
     if (loadFromBundle(path, bundleData)) {
         texture = Texture::loadFromMemory(bundleData.data(), bundleData.size(), config);
     } else {
@@ -785,34 +1719,43 @@ TextureHandle ResourceManager::loadImage(const std::string& path, const TextureC
     }
     
     if (texture) {
-        std::lock_guard<std::mutex> lock(m_cacheMutex);
-        m_textureCache[key] = texture;
-        m_stats.loadedImageCount++;
-        
-        // Track memory (CPU and GPU - textures are uploaded to GPU)
-        size_t memUsage = texture->getWidth() * texture->getHeight() * 4;
-        trackMemoryUsage(memUsage);
-        trackGPUMemoryUsage(memUsage);  // Textures are also stored on GPU
-        
-        // Track resource metadata for LRU/LFU eviction
-        trackResourceMetadata(key, ResourceType::Image, memUsage);
-        
-        // Track load time
-        auto endTime = std::chrono::steady_clock::now();
-        float loadTime = std::chrono::duration<float, std::milli>(endTime - startTime).count();
-        m_loadTimes.push_back(loadTime);
-        
-        // Watch for hot reload
-        if (m_hotReloadEnabled && !existsInBundle(path)) {
-            m_fileWatcher->watchFile(path, [this](const std::string& p) {
-                onFileChanged(p);
-            });
-        }
+        cacheTexture(key, path, texture, startTime);
     }
     
     return texture;
 }
 
+void ResourceManager::cacheTexture(const std::string& key, const std::string& path,
+                                   const TextureHandle& texture,
+                                   std::chrono::steady_clock::time_point startTime) {
+    std::unique_lock<std::mutex> lock(m_cacheMutex);
+    m_textureCache[key] = texture;
+    m_stats.loadedImageCount++;
+    
+    // Track memory (CPU and GPU - textures are uploaded to GPU)
+    size_t memUsage = texture->getWidth() * texture->getHeight() * 4;
+    trackMemoryUsage(memUsage);
+    trackGPUMemoryUsage(memUsage);  // Textures are also stored on GPU
+    
+    // Track resource metadata for LRU/LFU eviction
+    trackResourceMetadata(key, ResourceType::Image, memUsage);
+    
+    // Track load time
+    auto endTime = std::chrono::steady_clock::now();
+    float loadTime = std::chrono::duration<float, std::milli>(endTime - startTime).count();
+    m_loadTimes.push_back(loadTime);
+    
+    // Watch for hot reload
+    if (m_hotReloadEnabled && !existsInBundle(path)) {
+        m_fileWatcher->watchFile(path, [this](const std::string& p) {
+            onFileChanged(p);
+        });
+    }
+    
+    lock.unlock();
+    enforceMemoryLimit();
+}
+
 FontHandle ResourceManager::loadFont(const std::string& path, const FontConfig& config) {
     std::string key = getCacheKey(path, "_" + std::to_string(static_cast<int>(config.size)));
     
@@ -840,7 +1783,7 @@ FontHandle ResourceManager::loadFont(const std::string& path, const FontConfig&
     FontHandle font;
     
     // Try loading from bundle first
-    std::vector<uint8_t> bundleData;
+    BundleData bundleData;
     if (loadFromBundle(path, bundleData)) {
         font = Font::loadFromMemory(bundleData.data(), bundleData.size(), config);
     } else {
@@ -848,34 +1791,43 @@ FontHandle ResourceManager::loadFont(const std::string& path, const FontConfig&
     }
     
     if (font) {
-        std::lock_guard<std::mutex> lock(m_cacheMutex);
-        m_fontCache[key] = font;
-        m_stats.loadedFontCount++;
-        
-        // Track memory (atlas size - both CPU and GPU)
-        size_t memUsage = font->getAtlasWidth() * font->getAtlasHeight();
-        trackMemoryUsage(memUsage);
-        trackGPUMemoryUsage(memUsage);  // Font atlas is also stored on GPU
-        
-        // Track resource metadata for LRU/LFU eviction
-        trackResourceMetadata(key, ResourceType::Font, memUsage);
-        
-        // Track load time
-        auto endTime = std::chrono::steady_clock::now();
-        float loadTime = std::chrono::duration<float, std::milli>(endTime - startTime).count();
-        m_loadTimes.push_back(loadTime);
-        
-        // Watch for hot reload
-        if (m_hotReloadEnabled && !existsInBundle(path)) {
-            m_fileWatcher->watchFile(path, [this](const std::string& p) {
-                onFileChanged(p);
-            });
-        }
+        cacheFont(key, path, font, startTime);
     }
     
     return font;
 }
 
+void ResourceManager::cacheFont(const std::string& key, const std::string& path,
+                                const FontHandle& font,
+                                std::chrono::steady_clock::time_point startTime) {
+    std::unique_lock<std::mutex> lock(m_cacheMutex);
+    m_fontCache[key] = font;
+    m_stats.loadedFontCount++;
+    
+    // Track memory (atlas size - both CPU and GPU)
+    size_t memUsage = font->getAtlasWidth() * font->getAtlasHeight();
+    trackMemoryUsage(memUsage);
+    trackGPUMemoryUsage(memUsage);  // Font atlas is also stored on GPU
+    
+    // Track resource metadata for LRU/LFU eviction
+    trackResourceMetadata(key, ResourceType::Font, memUsage);
+    
+    // Track load time
+    auto endTime = std::chrono::steady_clock::now();
+    float loadTime = std::chrono::duration<float, std::milli>(endTime - startTime).count();
+    m_loadTimes.push_back(loadTime);
+    
+    // Watch for hot reload
+    if (m_hotReloadEnabled && !existsInBundle(path)) {
+        m_fileWatcher->watchFile(path, [this](const std::string& p) {
+            onFileChanged(p);
+        });
+    }
+    
+    lock.unlock();
+    enforceMemoryLimit();
+}
+
 
 ShaderHandle ResourceManager::loadShader(const std::string& vertPath, const std::string& fragPath) {
     std::string key = getCacheKey(vertPath + "|" + fragPath);
@@ -966,10 +1918,305 @@ void ResourceManager::preload(const std::vector<std::string>& paths, ResourceLoa
     }
 }
 
-void ResourceManager::preloadAsync(const std::vector<std::string>& paths, ResourceLoadCallback callback) {
-    // For now, just call synchronous version
-    // TODO: Implement async loading with thread pool
-    preload(paths, callback);
+void ResourceManager::preloadAsync(const std::vector<std::string>& paths, ResourceLoadCallback callback,
+                                   LoadPriority priority) {
+    if (priority == LoadPriority::Immediate) {
+        preload(paths, callback);
+        return;
+    }
+    
+    std::vector<std::pair<std::string, bool>> completed;
+    
+    {
+        std::lock_guard<std::mutex> lock(m_loaderMutex);
+        
+        for (const auto& path : paths) {
+            ResourceType type = detectResourceType(path);
+            if (type != ResourceType::Image && type != ResourceType::Font &&
+                type != ResourceType::Audio && type != ResourceType::Model) {
+                log(LogLevel::Warning, "Unknown resource type for: " + path);
+                completed.emplace_back(path, false);
+                continue;
+            }
+            
+            // Fonts are cached per size, matching loadFont() with a default config
+            std::string key = (type == ResourceType::Font)
+                ? getCacheKey(path, "_" + std::to_string(static_cast<int>(FontConfig{}.size)))
+                : getCacheKey(path);
+            
+            // Merge with an in-flight request for the same resource
+            if (auto it = m_inFlightLoads.find(key); it != m_inFlightLoads.end()) {
+                auto& request = it->second;
+                if (callback) {
+                    request->callbacks.push_back(callback);
+                }
+                if (priority > request->priority) {
+                    // Re-queue at the higher priority; the stale entry is skipped when popped
+                    request->priority = priority;
+                    if (!request->dispatched) {
+                        m_decodeQueue.push({priority, request->sequence, request});
+                    } else if (request->decoded) {
+                        m_uploadQueue.push({priority, request->sequence, request});
+                    }
+                }
+                continue;
+            }
+            
+            bool cached = false;
+            {
+                std::lock_guard<std::mutex> cacheLock(m_cacheMutex);
+                cached = m_textureCache.count(key) > 0 || m_fontCache.count(key) > 0 ||
+                         m_audioCache.count(key) > 0 || m_modelCache.count(key) > 0;
+            }
+            if (cached) {
+                m_stats.cacheHits++;
+                completed.emplace_back(path, true);
+                continue;
+            }
+            
+            auto request = std::make_shared<AsyncLoadRequest>();
+            request->path = path;
+            request->key = key;
+            request->type = type;
+            request->priority = priority;
+            request->sequence = m_loadSequence++;
+            request->startTime = std::chrono::steady_clock::now();
+            if (callback) {
+                request->callbacks.push_back(callback);
+            }
+            
+            m_inFlightLoads[key] = request;
+            m_decodeQueue.push({priority, request->sequence, request});
+        }
+    }
+    
+    {
+        std::lock_guard<std::mutex> threadsLock(m_loaderThreadsMutex);
+        if (m_loaderThreads.empty()) {
+            startLoaderThreads();
+        }
+    }
+    m_loaderCondition.notify_all();
+    
+    if (callback) {
+        for (const auto& [path, success] : completed) {
+            callback(path, success);
+        }
+    }
+}
+
+size_t ResourceManager::processPendingUploads(size_t maxUploads) {
+    size_t finished = 0;
+    
+    while (maxUploads == 0 || finished < maxUploads) {
+        AsyncLoadRequestPtr request;
+        {
+            std::lock_guard<std::mutex> lock(m_loaderMutex);
+            if (m_uploadQueue.empty()) {
+                break;
+            }
+            request = m_uploadQueue.top().request;
+            m_uploadQueue.pop();
+            
+            // Skip stale entries left behind by a priority bump
+            auto it = m_inFlightLoads.find(request->key);
+            if (it == m_inFlightLoads.end() || it->second != request) {
+                continue;
+            }
+            m_inFlightLoads.erase(it);
+        }
+        
+        bool success = finishAsyncRequest(*request);
+        for (const auto& callback : request->callbacks) {
+            callback(request->path, success);
+        }
+        finished++;
+    }
+    
+    return finished;
+}
+
+size_t ResourceManager::getPendingLoadCount() const {
+    std::lock_guard<std::mutex> lock(m_loaderMutex);
+    return m_inFlightLoads.size();
+}
+
+void ResourceManager::setLoaderThreadCount(size_t count) {
+    std::lock_guard<std::mutex> threadsLock(m_loaderThreadsMutex);
+    stopLoaderThreads();
+    m_loaderThreadCount = count;
+    
+    bool hasPendingDecodes = false;
+    {
+        std::lock_guard<std::mutex> lock(m_loaderMutex);
+        hasPendingDecodes = !m_decodeQueue.empty();
+    }
+    if (hasPendingDecodes) {
+        startLoaderThreads();
+    }
+}
+
+size_t ResourceManager::getLoaderThreadCount() const {
+    size_t count = m_loaderThreadCount.load();
+    if (count > 0) {
+        return count;
+    }
+    unsigned int hardwareThreads = std::thread::hardware_concurrency();
+    return hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+}
+
+void ResourceManager::startLoaderThreads() {
+    size_t count = getLoaderThreadCount();
+    m_loaderThreads.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        m_loaderThreads.emplace_back([this]() { loaderWorkerLoop(); });
+    }
+}
+
+void ResourceManager::stopLoaderThreads() {
+    {
+        std::lock_guard<std::mutex> lock(m_loaderMutex);
+        m_loaderStopping = true;
+    }
+    m_loaderCondition.notify_all();
+    
+    for (auto& thread : m_loaderThreads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+    m_loaderThreads.clear();
+    
+    std::lock_guard<std::mutex> lock(m_loaderMutex);
+    m_loaderStopping = false;
+}
+
+void ResourceManager::loaderWorkerLoop() {
+    while (true) {
+        AsyncLoadRequestPtr request;
+        {
+            std::unique_lock<std::mutex> lock(m_loaderMutex);
+            m_loaderCondition.wait(lock, [this]() {
+                return m_loaderStopping || !m_decodeQueue.empty();
+            });
+            if (m_loaderStopping) {
+                return;
+            }
+            
+            request = m_decodeQueue.top().request;
+            m_decodeQueue.pop();
+            if (request->dispatched) {
+                continue;  // Stale entry left behind by a priority bump
+            }
+            request->dispatched = true;
+        }
+        
+        decodeAsyncRequest(*request);
+        
+        std::lock_guard<std::mutex> lock(m_loaderMutex);
+        request->decoded = true;
+        m_uploadQueue.push({request->priority, request->sequence, request});
+    }
+}
+
+static bool readFileBytes(const std::string& path, BundleData& data) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return false;
+    }
+    
+    std::streamsize size = file.tellg();
+    if (size <= 0) {
+        return false;
+    }
+    file.seekg(0);
+    
+    std::vector<uint8_t> bytes(static_cast<size_t>(size));
+    if (!file.read(reinterpret_cast<char*>(bytes.data()), size)) {
+        return false;
+    }
+    data = BundleData(std::move(bytes));
+    return true;
+}
+
+void ResourceManager::decodeAsyncRequest(AsyncLoadRequest& request) const {
+    // Audio and models have no CPU-side decoder yet; they load on finish
+    if (request.type != ResourceType::Image && request.type != ResourceType::Font) {
+        return;
+    }
+    
+    BundleData data;
+    if (!loadFromBundle(request.path, data) && !readFileBytes(request.path, data)) {
+        return;
+    }
+    
+    if (request.type == ResourceType::Image) {
+        request.imageData = ImageLoader::loadFromMemory(data.data(), data.size(),
+                                                        TextureConfig{}.flipVertically);
+    } else {
+        request.fileData = std::move(data);
+    }
+}
+
+bool ResourceManager::finishAsyncRequest(AsyncLoadRequest& request) {
+    // Nothing to do if a synchronous load got there first
+    {
+        std::lock_guard<std::mutex> lock(m_cacheMutex);
+        if (m_textureCache.count(request.key) > 0 || m_fontCache.count(request.key) > 0) {
+            return true;
+        }
+    }
+    
+    switch (request.type) {
+        case ResourceType::Image: {
+            m_stats.cacheMisses++;
+            if (!request.imageData.isValid() || request.imageData.channels != 4) {
+                log(LogLevel::Warning, "Failed to decode image: " + request.path);
+                return false;
+            }
+            if (m_memoryLimit.load() > 0) {
+                enforceMemoryLimit();
+            }
+            
+            auto texture = Texture::createFromPixels(request.imageData.pixels.data(),
+                                                     request.imageData.width,
+                                                     request.imageData.height);
+            request.imageData = ImageData{};
+            if (!texture) {
+                return false;
+            }
+            cacheTexture(request.key, request.path, texture, request.startTime);
+            return true;
+        }
+        
+        case ResourceType::Font: {
+            m_stats.cacheMisses++;
+            if (request.fileData.empty()) {
+                log(LogLevel::Warning, "Failed to read font: " + request.path);
+                return false;
+            }
+            if (m_memoryLimit.load() > 0) {
+                enforceMemoryLimit();
+            }
+            
+            auto font = Font::loadFromMemory(request.fileData.data(), request.fileData.size());
+            request.fileData = BundleData{};
+            if (!font) {
+                return false;
+            }
+            cacheFont(request.key, request.path, font, request.startTime);
+            return true;
+        }
+        
+        case ResourceType::Audio:
+            return loadAudio(request.path) != nullptr;
+            
+        case ResourceType::Model:
+            return loadModel(request.path) != nullptr;
+            
+        default:
+            return false;
+    }
 }
 
 
@@ -1189,11 +2436,15 @@ int ResourceManager::evictToLimit(size_t targetBytes) {
     size_t bytesToFree = m_currentMemoryUsage - targetBytes;
     
     // Get eviction candidates based on current policy
-    auto candidates = getEvictionCandidates(bytesToFree);
-    
-    // Track bytes freed during eviction
-    for (const auto& key : candidates) {
-        freedBytes += getResourceMemoryUsage(key);
+    std::vector<std::string> candidates;
+    {
+        std::lock_guard<std::mutex> lock(m_cacheMutex);
+        candidates = getEvictionCandidates(bytesToFree);
+        
+        // Track bytes freed during eviction
+        for (const auto& key : candidates) {
+            freedBytes += getResourceMemoryUsage(key);
+        }
     }
     
     // Evict the candidates
@@ -1229,15 +2480,7 @@ int ResourceManager::enforceMemoryLimit() {
 }
 
 void ResourceManager::trackResourceMetadata(const std::string& key, ResourceType type, size_t memoryUsage) {
-    ResourceMetadata metadata;
-    metadata.key = key;
-    metadata.type = type;
-    metadata.memoryUsage = memoryUsage;
-    metadata.lastAccessTime = std::chrono::steady_clock::now();
-    metadata.loadTime = std::chrono::steady_clock::now();
-    metadata.accessCount = 1;
-    
-    m_resourceMetadata[key] = metadata;
+    m_resourceMetadata.insert(key, type, memoryUsage);
 }
 
 void ResourceManager::untrackResourceMetadata(const std::string& key) {
@@ -1245,60 +2488,11 @@ void ResourceManager::untrackResourceMetadata(const std::string& key) {
 }
 
 void ResourceManager::updateResourceAccessTime(const std::string& key) {
-    auto it = m_resourceMetadata.find(key);
-    if (it != m_resourceMetadata.end()) {
-        it->second.lastAccessTime = std::chrono::steady_clock::now();
-        it->second.accessCount++;
-    }
+    m_resourceMetadata.touch(key);
 }
 
 std::vector<std::string> ResourceManager::getEvictionCandidates(size_t bytesToFree) const {
-    std::vector<std::string> candidates;
-    
-    // Collect all resources with their metadata
-    std::vector<std::pair<std::string, ResourceMetadata>> resources;
-    for (const auto& [key, metadata] : m_resourceMetadata) {
-        resources.emplace_back(key, metadata);
-    }
-    
-    // Sort based on eviction policy
-    switch (m_evictionPolicy) {
-        case EvictionPolicy::LRU:
-            // Sort by last access time (oldest first)
-            std::sort(resources.begin(), resources.end(),
-                [](const auto& a, const auto& b) {
-                    return a.second.lastAccessTime < b.second.lastAccessTime;
-                });
-            break;
-            
-        case EvictionPolicy::LFU:
-            // Sort by access count (least accessed first)
-            std::sort(resources.begin(), resources.end(),
-                [](const auto& a, const auto& b) {
-                    return a.second.accessCount < b.second.accessCount;
-                });
-            break;
-            
-        case EvictionPolicy::FIFO:
-            // Sort by load time (oldest loaded first)
-            std::sort(resources.begin(), resources.end(),
-                [](const auto& a, const auto& b) {
-                    return a.second.loadTime < b.second.loadTime;
-                });
-            break;
-    }
-    
-    // Select candidates until we have enough memory to free
-    size_t totalToFree = 0;
-    for (const auto& [key, metadata] : resources) {
-        if (totalToFree >= bytesToFree) {
-            break;
-        }
-        candidates.push_back(key);
-        totalToFree += metadata.memoryUsage;
-    }
-    
-    return candidates;
+    return m_resourceMetadata.collect(m_evictionPolicy, bytesToFree);
 }
 
 int ResourceManager::evictResources(const std::vector<std::string>& keys) {
@@ -1384,11 +2578,8 @@ int ResourceManager::evictResources(const std::vector<std::string>& keys) {
 }
 
 size_t ResourceManager::getResourceMemoryUsage(const std::string& key) const {
-    auto it = m_resourceMetadata.find(key);
-    if (it != m_resourceMetadata.end()) {
-        return it->second.memoryUsage;
-    }
-    return 0;
+    const auto* entry = m_resourceMetadata.find(key);
+    return entry ? entry->memoryUsage : 0;
 }
 
 // ============================================================================
@@ -1483,10 +2674,7 @@ void ResourceManager::onFileChanged(const std::string& path) {
                         }
                         
                         // Update metadata
-                        if (auto metaIt = m_resourceMetadata.find(key); metaIt != m_resourceMetadata.end()) {
-                            metaIt->second.memoryUsage = newMemUsage;
-                            metaIt->second.lastAccessTime = std::chrono::steady_clock::now();
-                        }
+                        m_resourceMetadata.refresh(key, newMemUsage);
                         
                         reloaded = true;
                         log(LogLevel::Info, "Reloaded texture: " + path);
@@ -1521,10 +2709,7 @@ void ResourceManager::onFileChanged(const std::string& path) {
                             }
                             
                             // Update metadata
-                            if (auto metaIt = m_resourceMetadata.find(cacheKey); metaIt != m_resourceMetadata.end()) {
-                                metaIt->second.memoryUsage = newMemUsage;
-                                metaIt->second.lastAccessTime = std::chrono::steady_clock::now();
-                            }
+                            m_resourceMetadata.refresh(cacheKey, newMemUsage);
                             
                             reloaded = true;
                             log(LogLevel::Info, "Reloaded font: " + path);
@@ -1575,8 +2760,8 @@ void ResourceManager::onFileChanged(const std::string& path) {
 // Asset Bundling
 // ============================================================================
 
-BundleHandle ResourceManager::loadBundle(const std::string& path) {
-    return AssetBundle::load(path);
+BundleHandle ResourceManager::loadBundle(const std::string& path, bool memoryMapped) {
+    return memoryMapped ? AssetBundle::loadMapped(path) : AssetBundle::load(path);
 }
 
 BundleHandle ResourceManager::createBundle() {
@@ -1624,24 +2809,34 @@ bool ResourceManager::existsInBundle(const std::string& path) const {
 }
 
 std::vector<uint8_t> ResourceManager::getBundleData(const std::string& path) const {
-    std::lock_guard<std::mutex> lock(m_bundleMutex);
-    
-    for (const auto& [mountPoint, bundle] : m_mountedBundles) {
-        std::string virtualPath = path;
-        if (!mountPoint.empty() && path.find(mountPoint) == 0) {
-            virtualPath = path.substr(mountPoint.length());
-        }
-        
-        if (bundle->contains(virtualPath)) {
-            return bundle->getData(virtualPath);
+    return getBundleView(path).toVector();
+}
+
+BundleData ResourceManager::getBundleView(const std::string& path) const {
+    BundleHandle found;
+    std::string virtualPath;
+    {
+        // Only pick the bundle here; decoding below must not hold up other loaders
+        std::lock_guard<std::mutex> lock(m_bundleMutex);
+        for (const auto& [mountPoint, bundle] : m_mountedBundles) {
+            virtualPath = path;
+            if (!mountPoint.empty() && path.find(mountPoint) == 0) {
+                virtualPath = path.substr(mountPoint.length());
+            }
+            
+            if (bundle->contains(virtualPath)) {
+                found = bundle;
+                break;
+            }
         }
     }
     
-    return {};
+    if (!found) return {};
+    return found->getView(virtualPath);
 }
 
-bool ResourceManager::loadFromBundle(const std::string& path, std::vector<uint8_t>& data) const {
-    data = getBundleData(path);
+bool ResourceManager::loadFromBundle(const std::string& path, BundleData& data) const {
+    data = getBundleView(path);
     return !data.empty();
 }
 
@@ -1791,22 +2986,22 @@ ResourceTypeStats ResourceManager::getResourceTypeStats(ResourceType type) const
             stats.count = m_modelCache.size();
             // Model memory would be calculated from vertex/index buffers
             // For now, use metadata if available
-            for (const auto& [key, metadata] : m_resourceMetadata) {
+            m_resourceMetadata.forEach([&stats](const std::string&, const EvictionIndex::Entry& metadata) {
                 if (metadata.type == ResourceType::Model) {
                     stats.cpuMemoryUsage += metadata.memoryUsage;
                 }
-            }
+            });
             stats.totalSize = stats.cpuMemoryUsage;
             break;
         }
         case ResourceType::Audio: {
             stats.count = m_audioCache.size();
             // Audio memory is typically CPU-side
-            for (const auto& [key, metadata] : m_resourceMetadata) {
+            m_resourceMetadata.forEach([&stats](const std::string&, const EvictionIndex::Entry& metadata) {
                 if (metadata.type == ResourceType::Audio) {
                     stats.cpuMemoryUsage += metadata.memoryUsage;
                 }
-            }
+            });
             stats.totalSize = stats.cpuMemoryUsage;
             break;
         }
@@ -1984,11 +3179,8 @@ void ResourceManager::trackMemoryUsage(size_t bytes) {
         // Retry if another thread updated peak
     }
     
-    // Check if we need to evict
-    size_t limit = m_memoryLimit.load();
-    if (limit > 0 && m_currentMemoryUsage > limit) {
-        evictToLimit(limit);
-    }
+    // Eviction happens in enforceMemoryLimit() once the caller has released
+    // m_cacheMutex; evicting here would re-lock it
 }
 
 void ResourceManager::trackGPUMemoryUsage(size_t bytes) {
@@ -4,7 +4,9 @@
  */
 
 #include "KillerGK/widgets/Button.hpp"
+#include "KillerGK/widgets/WidgetArena.hpp"
 #include <algorithm>
+#include <cmath>
 
 namespace KillerGK {
 
@@ -33,7 +35,7 @@ struct Button::ButtonData {
 
 Button::Button() 
     : Widget()
-    , m_buttonData(std::make_shared<ButtonData>()) 
+    , m_buttonData(WidgetArena::makeShared<ButtonData>()) 
 {
     // Set default button styling
     backgroundColor(Color(0.25f, 0.47f, 0.85f, 1.0f));  // Primary blue
@@ -47,7 +49,7 @@ Button Button::create() {
 
 // Text
 Button& Button::text(const std::string& text) {
-    m_buttonData->text = text;
+    if (assign(m_buttonData->text, text)) invalidate(DirtyFlags::Layout | DirtyFlags::Paint);
     return *this;
 }
 
@@ -57,7 +59,7 @@ const std::string& Button::getText() const {
 
 // Icon
 Button& Button::icon(const std::string& iconPath) {
-    m_buttonData->iconPath = iconPath;
+    if (assign(m_buttonData->iconPath, iconPath)) invalidate(DirtyFlags::Layout | DirtyFlags::Paint);
     return *this;
 }
 
@@ -66,7 +68,7 @@ const std::string& Button::getIcon() const {
 }
 
 Button& Button::iconPosition(IconPosition pos) {
-    m_buttonData->iconPos = pos;
+    if (assign(m_buttonData->iconPos, pos)) invalidate(DirtyFlags::Layout | DirtyFlags::Paint);
     return *this;
 }
 
@@ -76,29 +78,29 @@ IconPosition Button::getIconPosition() const {
 
 // Variant
 Button& Button::variant(ButtonVariant var) {
-    m_buttonData->variant = var;
+    if (assign(m_buttonData->variant, var)) invalidate(DirtyFlags::Paint);
     
     // Apply default styling based on variant
     switch (var) {
         case ButtonVariant::Primary:
             backgroundColor(Color(0.25f, 0.47f, 0.85f, 1.0f));
-            m_buttonData->textColor = Color::White;
+            textColor(Color::White);
             borderWidth(0.0f);
             break;
         case ButtonVariant::Secondary:
             backgroundColor(Color(0.9f, 0.9f, 0.9f, 1.0f));
-            m_buttonData->textColor = Color(0.2f, 0.2f, 0.2f, 1.0f);
+            textColor(Color(0.2f, 0.2f, 0.2f, 1.0f));
             borderWidth(0.0f);
             break;
         case ButtonVariant::Outlined:
             backgroundColor(Color::Transparent);
-            m_buttonData->textColor = Color(0.25f, 0.47f, 0.85f, 1.0f);
+            textColor(Color(0.25f, 0.47f, 0.85f, 1.0f));
             borderWidth(1.0f);
             borderColor(Color(0.25f, 0.47f, 0.85f, 1.0f));
             break;
         case ButtonVariant::Text:
             backgroundColor(Color::Transparent);
-            m_buttonData->textColor = Color(0.25f, 0.47f, 0.85f, 1.0f);
+            textColor(Color(0.25f, 0.47f, 0.85f, 1.0f));
             borderWidth(0.0f);
             break;
     }
@@ -112,7 +114,7 @@ ButtonVariant Button::getVariant() const {
 
 // Loading
 Button& Button::loading(bool isLoading) {
-    m_buttonData->isLoading = isLoading;
+    if (assign(m_buttonData->isLoading, isLoading)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -141,7 +143,7 @@ const RippleEffect& Button::getRippleEffect() const {
 
 // State colors
 Button& Button::hoverColor(const Color& color) {
-    m_buttonData->hoverColor = color;
+    if (assign(m_buttonData->hoverColor, color)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -150,7 +152,7 @@ const Color& Button::getHoverColor() const {
 }
 
 Button& Button::pressedColor(const Color& color) {
-    m_buttonData->pressedColor = color;
+    if (assign(m_buttonData->pressedColor, color)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -159,7 +161,7 @@ const Color& Button::getPressedColor() const {
 }
 
 Button& Button::disabledColor(const Color& color) {
-    m_buttonData->disabledColor = color;
+    if (assign(m_buttonData->disabledColor, color)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -168,7 +170,7 @@ const Color& Button::getDisabledColor() const {
 }
 
 Button& Button::textColor(const Color& color) {
-    m_buttonData->textColor = color;
+    if (assign(m_buttonData->textColor, color)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -186,6 +188,7 @@ void Button::startRipple(float x, float y) {
     m_buttonData->rippleEffect.progress = 0.0f;
     m_buttonData->rippleEffect.originX = x;
     m_buttonData->rippleEffect.originY = y;
+    invalidate(DirtyFlags::Paint);
     
     // Calculate max radius if not set
     if (m_buttonData->rippleEffect.maxRadius <= 0.0f) {
@@ -209,6 +212,7 @@ void Button::updateRipple(float deltaTime) {
     }
     
     m_buttonData->rippleEffect.progress += deltaTime / duration;
+    invalidate(DirtyFlags::Paint);
     
     if (m_buttonData->rippleEffect.progress >= 1.0f) {
         m_buttonData->rippleEffect.active = false;
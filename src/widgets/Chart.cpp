@@ -4,9 +4,15 @@
  */
 
 #include "KillerGK/widgets/Chart.hpp"
+#include "KillerGK/widgets/ChartColumns.hpp"
+#include "KillerGK/widgets/ChartDecimator.hpp"
+#include "KillerGK/widgets/ChartHitIndex.hpp"
+#include "KillerGK/widgets/ChartStream.hpp"
+#include "KillerGK/widgets/WidgetArena.hpp"
 #include <algorithm>
 #include <cmath>
 #include <limits>
+#include <unordered_map>
 
 namespace KillerGK {
 
@@ -37,6 +43,53 @@ struct Chart::ChartData {
     float barSpacing = 4.0f;
     bool stacked = false;
     
+    // Rendering
+    ChartDecimation decimation = ChartDecimation::MinMax;
+    std::unordered_map<std::string, ChartDecimator> decimators;   ///< By series id
+    
+    // Streamed series
+    struct Stream {
+        std::shared_ptr<ChartStream> stream;
+        std::vector<ChartRenderPoint> points;    ///< Render points of the window
+        bool rendered = false;
+        uint64_t renderedTotal = 0;              ///< Stream counts when the points were taken
+        size_t renderedSize = 0;
+    };
+    std::unordered_map<std::string, Stream> streams;              ///< By series id
+    
+    const ChartStream* streamOf(const std::string& id) const {
+        auto it = streams.find(id);
+        return it != streams.end() ? it->second.stream.get() : nullptr;
+    }
+    
+    // Hit testing
+    float hitRadius = 8.0f;
+    std::unordered_map<std::string, ChartHitIndex> hitIndexes;    ///< By series id
+    ChartHit hovered;
+    
+    // Forget what was derived from a series' points
+    void pointsChanged(const std::string& id) {
+        decimators.erase(id);
+        hitIndexes.erase(id);
+    }
+    
+    void allPointsChanged() {
+        decimators.clear();
+        hitIndexes.clear();
+    }
+    
+    /**
+     * @brief Get a series' value ranges without scanning points seen before
+     */
+    bool seriesRange(const ChartSeries& series, double& minX, double& maxX, double& minY, double& maxY) {
+        if (const auto* stream = streamOf(series.id)) {
+            return stream->getRange(minX, maxX, minY, maxY);
+        }
+        auto& index = hitIndexes[series.id];
+        return series.columns ? index.getRange(*series.columns, minX, maxX, minY, maxY)
+                              : index.getRange(series.data, minX, maxX, minY, maxY);
+    }
+    
     // Appearance
     float paddingTop = 20.0f;
     float paddingRight = 20.0f;
@@ -74,7 +127,7 @@ struct Chart::ChartData {
 
 Chart::Chart()
     : Widget()
-    , m_chartData(std::make_shared<ChartData>())
+    , m_chartData(WidgetArena::makeShared<ChartData>())
 {
     backgroundColor(Color(1.0f, 1.0f, 1.0f, 1.0f));
 }
@@ -85,7 +138,7 @@ Chart Chart::create() {
 
 // Chart Type
 Chart& Chart::chartType(ChartType type) {
-    m_chartData->type = type;
+    if (assign(m_chartData->type, type)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -95,12 +148,18 @@ ChartType Chart::getChartType() const {
 
 // Data Series
 Chart& Chart::series(const std::vector<ChartSeries>& series) {
+    if (!series.empty() || !m_chartData->seriesList.empty()) invalidate(DirtyFlags::Paint);
     m_chartData->seriesList = series;
+    m_chartData->allPointsChanged();
+    m_chartData->streams.clear();
     return *this;
 }
 
 Chart& Chart::addSeries(const ChartSeries& series) {
     m_chartData->seriesList.push_back(series);
+    m_chartData->pointsChanged(series.id);
+    invalidate(DirtyFlags::Paint);
+    m_chartData->streams.erase(series.id);
     // Assign color if not set
     if (m_chartData->seriesList.back().color.a == 0) {
         m_chartData->seriesList.back().color = 
@@ -112,12 +171,19 @@ Chart& Chart::addSeries(const ChartSeries& series) {
 Chart& Chart::removeSeries(const std::string& id) {
     auto it = std::remove_if(m_chartData->seriesList.begin(), m_chartData->seriesList.end(),
         [&id](const ChartSeries& s) { return s.id == id; });
+    if (it == m_chartData->seriesList.end()) return *this;
     m_chartData->seriesList.erase(it, m_chartData->seriesList.end());
+    m_chartData->pointsChanged(id);
+    invalidate(DirtyFlags::Paint);
+    m_chartData->streams.erase(id);
     return *this;
 }
 
 Chart& Chart::clearSeries() {
+    if (!m_chartData->seriesList.empty()) invalidate(DirtyFlags::Paint);
     m_chartData->seriesList.clear();
+    m_chartData->allPointsChanged();
+    m_chartData->streams.clear();
     return *this;
 }
 
@@ -135,13 +201,282 @@ ChartSeries* Chart::getSeriesById(const std::string& id) {
 Chart& Chart::updateSeriesData(const std::string& id, const std::vector<DataPoint>& data) {
     if (auto* s = getSeriesById(id)) {
         s->data = data;
+        s->columns.reset();
+        m_chartData->pointsChanged(id);
+        invalidate(DirtyFlags::Paint);
+    }
+    return *this;
+}
+
+Chart& Chart::appendPoints(const std::string& id, const std::vector<DataPoint>& points) {
+    if (auto* s = getSeriesById(id)) {
+        if (s->columns) {
+            s->columns->append(points);
+        } else {
+            s->data.insert(s->data.end(), points.begin(), points.end());
+        }
+        if (!points.empty()) invalidate(DirtyFlags::Paint);
+    }
+    return *this;
+}
+
+Chart& Chart::streamSeries(const std::string& id, std::shared_ptr<ChartStream> stream) {
+    if (!stream) {
+        if (m_chartData->streams.erase(id) > 0) invalidate(DirtyFlags::Paint);
+    } else if (getSeriesById(id)) {
+        auto& entry = m_chartData->streams[id];
+        entry = ChartData::Stream();
+        entry.stream = std::move(stream);
+        invalidate(DirtyFlags::Paint);
+    }
+    return *this;
+}
+
+std::shared_ptr<ChartStream> Chart::getStream(const std::string& id) const {
+    auto it = m_chartData->streams.find(id);
+    return it != m_chartData->streams.end() ? it->second.stream : nullptr;
+}
+
+bool Chart::updateStreams() {
+    bool changed = false;
+    for (auto& [id, entry] : m_chartData->streams) {
+        changed = entry.stream->update() > 0 || changed;
+    }
+    if (changed) invalidate(DirtyFlags::Paint);
+    return changed;
+}
+
+// Rendering
+Chart& Chart::decimation(ChartDecimation mode) {
+    if (assign(m_chartData->decimation, mode)) invalidate(DirtyFlags::Paint);
+    return *this;
+}
+
+ChartDecimation Chart::getDecimation() const {
+    return m_chartData->decimation;
+}
+
+const std::vector<ChartRenderPoint>& Chart::getRenderPoints(const std::string& id) const {
+    static const std::vector<ChartRenderPoint> none;
+    auto& data = *m_chartData;
+    auto it = std::find_if(data.seriesList.begin(), data.seriesList.end(),
+                           [&id](const ChartSeries& s) { return s.id == id; });
+    if (it == data.seriesList.end()) return none;
+    
+    auto streamed = data.streams.find(id);
+    if (streamed != data.streams.end()) {
+        // The window is bounded by the stream's capacity: every point is drawn
+        auto& entry = streamed->second;
+        const ChartStream& stream = *entry.stream;
+        if (!entry.rendered || entry.renderedTotal != stream.getTotalCount() ||
+            entry.renderedSize != stream.size()) {
+            entry.points.resize(stream.size());
+            for (size_t i = 0; i < stream.size(); ++i) {
+                entry.points[i] = {stream.x(i), stream.y(i), i};
+            }
+            entry.rendered = true;
+            entry.renderedTotal = stream.getTotalCount();
+            entry.renderedSize = stream.size();
+        }
+        return entry.points;
+    }
+    
+    ChartDecimator::View view;
+    if (data.type == ChartType::Line || data.type == ChartType::Area) {
+        getVisibleXRange(view.xMin, view.xMax);
+        float plotWidth = getWidth() - data.paddingLeft - data.paddingRight;
+        view.columns = plotWidth >= 1.0f ? static_cast<size_t>(plotWidth) : 0;
+        view.mode = data.decimation;
+    } else {
+        view.xMin = -std::numeric_limits<double>::infinity();
+        view.xMax = std::numeric_limits<double>::infinity();
+        view.mode = ChartDecimation::None;
+    }
+    auto& decimator = data.decimators[id];
+    return it->columns ? decimator.points(*it->columns, view) : decimator.points(it->data, view);
+}
+
+void Chart::getVisibleXRange(double& minX, double& maxX) const {
+    const auto& axis = m_chartData->xAxis;
+    if (!axis.autoScale) {
+        minX = axis.min;
+        maxX = axis.max;
+        return;
+    }
+    
+    minX = std::numeric_limits<double>::max();
+    maxX = std::numeric_limits<double>::lowest();
+    for (const auto& series : m_chartData->seriesList) {
+        double lowX, highX, lowY, highY;
+        if (m_chartData->seriesRange(series, lowX, highX, lowY, highY)) {
+            minX = std::min(minX, lowX);
+            maxX = std::max(maxX, highX);
+        }
+    }
+    if (minX > maxX) {
+        minX = 0.0;
+        maxX = 100.0;
     }
+}
+
+void Chart::getVisibleYRange(double& minY, double& maxY) const {
+    const auto& axis = m_chartData->yAxis;
+    if (!axis.autoScale) {
+        minY = axis.min;
+        maxY = axis.max;
+        return;
+    }
+    
+    minY = std::numeric_limits<double>::max();
+    maxY = std::numeric_limits<double>::lowest();
+    for (const auto& series : m_chartData->seriesList) {
+        double lowX, highX, lowY, highY;
+        if (m_chartData->seriesRange(series, lowX, highX, lowY, highY)) {
+            minY = std::min(minY, lowY);
+            maxY = std::max(maxY, highY);
+        }
+    }
+    
+    // As getDataRange() pads it
+    if (minY > maxY) {
+        minY = 0.0;
+        maxY = 100.0;
+    }
+    double yRange = maxY - minY;
+    if (yRange > 0) {
+        minY = std::max(0.0, minY - yRange * 0.1);
+        maxY = maxY + yRange * 0.1;
+    }
+}
+
+// Hit Testing
+Chart& Chart::hitRadius(float radius) {
+    m_chartData->hitRadius = std::max(0.0f, radius);
     return *this;
 }
 
+float Chart::getHitRadius() const {
+    return m_chartData->hitRadius;
+}
+
+ChartHit Chart::hitTest(float x, float y) const {
+    auto& data = *m_chartData;
+    ChartHit result;
+    if (data.type != ChartType::Line && data.type != ChartType::Area && data.type != ChartType::Scatter) {
+        return result;
+    }
+    float plotWidth = getWidth() - data.paddingLeft - data.paddingRight;
+    float plotHeight = getHeight() - data.paddingTop - data.paddingBottom;
+    if (plotWidth <= 0.0f || plotHeight <= 0.0f) return result;
+    
+    // The position in data units, and pixels per unit
+    double minX, maxX, minY, maxY;
+    getVisibleXRange(minX, maxX);
+    getVisibleYRange(minY, maxY);
+    ChartHitIndex::Query query;
+    query.scaleX = maxX > minX ? plotWidth / (maxX - minX) : 0.0;
+    query.scaleY = maxY > minY ? plotHeight / (maxY - minY) : 0.0;
+    query.x = query.scaleX > 0.0 ? minX + (x - data.paddingLeft) / query.scaleX : minX;
+    query.y = query.scaleY > 0.0 ? minY + (data.paddingTop + plotHeight - y) / query.scaleY : minY;
+    query.radius = data.hitRadius;
+    
+    double best = query.radius;
+    for (const auto& series : data.seriesList) {
+        ChartHitIndex::Hit hit;
+        if (const auto* stream = data.streamOf(series.id)) {
+            for (size_t i = 0; i < stream->size(); ++i) {
+                double dx = (stream->x(i) - query.x) * query.scaleX;
+                double dy = (stream->y(i) - query.y) * query.scaleY;
+                double distance = std::sqrt(dx * dx + dy * dy);
+                if (distance <= query.radius && (hit.index == ChartHitIndex::NO_POINT || distance < hit.distance)) {
+                    hit.index = i;
+                    hit.distance = distance;
+                }
+            }
+        } else {
+            auto& index = data.hitIndexes[series.id];
+            hit = series.columns ? index.nearest(*series.columns, query) : index.nearest(series.data, query);
+        }
+        if (hit.index == ChartHitIndex::NO_POINT) continue;
+        if (result.seriesId.empty() ? hit.distance <= best : hit.distance < best) {
+            best = hit.distance;
+            result.seriesId = series.id;
+            result.index = hit.index;
+            result.distance = static_cast<float>(hit.distance);
+        }
+    }
+    
+    if (!result.seriesId.empty()) {
+        DataPoint point = pointAt(result.seriesId, result.index);
+        result.x = point.x;
+        result.y = point.y;
+    }
+    return result;
+}
+
+bool Chart::handleMouseMove(float x, float y) {
+    ChartHit hit = hitTest(x, y);
+    auto& hovered = m_chartData->hovered;
+    if (hit.seriesId == hovered.seriesId && hit.index == hovered.index) {
+        hovered = hit;
+        return false;
+    }
+    
+    ChartHit left = hovered;
+    hovered = hit;
+    invalidate(DirtyFlags::Paint);
+    notifyHover(left, false);
+    notifyHover(hit, true);
+    return true;
+}
+
+void Chart::handleMouseLeave() {
+    ChartHit left = m_chartData->hovered;
+    if (left.seriesId.empty()) return;
+    m_chartData->hovered = ChartHit();
+    invalidate(DirtyFlags::Paint);
+    notifyHover(left, false);
+}
+
+bool Chart::handleMouseClick(float x, float y) {
+    ChartHit hit = hitTest(x, y);
+    if (hit.seriesId.empty()) return false;
+    if (m_chartData->onPointClickCallback) {
+        if (const auto* series = getSeriesById(hit.seriesId)) {
+            m_chartData->onPointClickCallback(*series, pointAt(hit.seriesId, hit.index));
+        }
+    }
+    return true;
+}
+
+const ChartHit& Chart::getHoveredPoint() const {
+    return m_chartData->hovered;
+}
+
+DataPoint Chart::pointAt(const std::string& id, size_t index) const {
+    for (const auto& series : m_chartData->seriesList) {
+        if (series.id != id) continue;
+        if (const auto* stream = m_chartData->streamOf(id)) {
+            return index < stream->size() ? DataPoint(stream->x(index), stream->y(index)) : DataPoint();
+        }
+        if (series.columns) {
+            return index < series.columns->size() ? series.columns->point(index) : DataPoint();
+        }
+        return index < series.data.size() ? series.data[index] : DataPoint();
+    }
+    return DataPoint();
+}
+
+void Chart::notifyHover(const ChartHit& hit, bool entered) {
+    if (hit.seriesId.empty() || !m_chartData->onPointHoverCallback) return;
+    if (const auto* series = getSeriesById(hit.seriesId)) {
+        m_chartData->onPointHoverCallback(*series, pointAt(hit.seriesId, hit.index), entered);
+    }
+}
+
 // Axes Configuration
 Chart& Chart::xAxis(const ChartAxis& axis) {
-    m_chartData->xAxis = axis;
+    if (assign(m_chartData->xAxis, axis)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -154,7 +489,7 @@ ChartAxis& Chart::getXAxis() {
 }
 
 Chart& Chart::yAxis(const ChartAxis& axis) {
-    m_chartData->yAxis = axis;
+    if (assign(m_chartData->yAxis, axis)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -168,7 +503,7 @@ ChartAxis& Chart::getYAxis() {
 
 // Legend
 Chart& Chart::legend(const ChartLegend& legend) {
-    m_chartData->legend = legend;
+    if (assign(m_chartData->legend, legend)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -177,12 +512,12 @@ const ChartLegend& Chart::getLegend() const {
 }
 
 Chart& Chart::showLegend(bool show) {
-    m_chartData->legend.visible = show;
+    if (assign(m_chartData->legend.visible, show)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
 Chart& Chart::legendPosition(ChartLegend::Position position) {
-    m_chartData->legend.position = position;
+    if (assign(m_chartData->legend.position, position)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -229,11 +564,12 @@ float Chart::getAnimationDuration() const {
 void Chart::animate() {
     m_chartData->animating = true;
     m_chartData->animationProgress = 0.0f;
+    invalidate(DirtyFlags::Paint);
 }
 
 // Pie/Donut Specific
 Chart& Chart::innerRadius(float radius) {
-    m_chartData->innerRadius = std::clamp(radius, 0.0f, 0.95f);
+    if (assign(m_chartData->innerRadius, std::clamp(radius, 0.0f, 0.95f))) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -242,7 +578,7 @@ float Chart::getInnerRadius() const {
 }
 
 Chart& Chart::startAngle(float angle) {
-    m_chartData->startAngle = angle;
+    if (assign(m_chartData->startAngle, angle)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -252,7 +588,7 @@ float Chart::getStartAngle() const {
 
 // Bar Chart Specific
 Chart& Chart::barWidth(float width) {
-    m_chartData->barWidth = std::clamp(width, 0.1f, 1.0f);
+    if (assign(m_chartData->barWidth, std::clamp(width, 0.1f, 1.0f))) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -261,7 +597,7 @@ float Chart::getBarWidth() const {
 }
 
 Chart& Chart::barSpacing(float spacing) {
-    m_chartData->barSpacing = spacing;
+    if (assign(m_chartData->barSpacing, spacing)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -270,7 +606,7 @@ float Chart::getBarSpacing() const {
 }
 
 Chart& Chart::stacked(bool stacked) {
-    m_chartData->stacked = stacked;
+    if (assign(m_chartData->stacked, stacked)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -280,15 +616,16 @@ bool Chart::isStacked() const {
 
 // Appearance
 Chart& Chart::chartPadding(float top, float right, float bottom, float left) {
-    m_chartData->paddingTop = top;
-    m_chartData->paddingRight = right;
-    m_chartData->paddingBottom = bottom;
-    m_chartData->paddingLeft = left;
+    bool changed = assign(m_chartData->paddingTop, top);
+    changed |= assign(m_chartData->paddingRight, right);
+    changed |= assign(m_chartData->paddingBottom, bottom);
+    changed |= assign(m_chartData->paddingLeft, left);
+    if (changed) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
 Chart& Chart::colorPalette(const std::vector<Color>& colors) {
-    m_chartData->colorPalette = colors;
+    if (assign(m_chartData->colorPalette, colors)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -320,6 +657,27 @@ void Chart::getDataRange(double& minX, double& maxX, double& minY, double& maxY)
     maxY = std::numeric_limits<double>::lowest();
     
     for (const auto& series : m_chartData->seriesList) {
+        if (const auto* stream = m_chartData->streamOf(series.id)) {
+            // Tracked by the stream as points come and go
+            double lowX, highX, lowY, highY;
+            if (stream->getRange(lowX, highX, lowY, highY)) {
+                minX = std::min(minX, lowX);
+                maxX = std::max(maxX, highX);
+                minY = std::min(minY, lowY);
+                maxY = std::max(maxY, highY);
+            }
+            continue;
+        }
+        if (series.columns) {
+            double lowX, highX, lowY, highY;
+            if (series.columns->getRange(lowX, highX, lowY, highY)) {
+                minX = std::min(minX, lowX);
+                maxX = std::max(maxX, highX);
+                minY = std::min(minY, lowY);
+                maxY = std::max(maxY, highY);
+            }
+            continue;
+        }
         for (const auto& point : series.data) {
             minX = std::min(minX, point.x);
             maxX = std::max(maxX, point.x);
@@ -349,7 +707,14 @@ void Chart::getDataRange(double& minX, double& maxX, double& minY, double& maxY)
 double Chart::getTotalValue() const {
     double total = 0.0;
     if (!m_chartData->seriesList.empty()) {
-        for (const auto& point : m_chartData->seriesList[0].data) {
+        const auto& series = m_chartData->seriesList[0];
+        if (series.columns) {
+            for (size_t i = 0; i < series.columns->size(); ++i) {
+                total += std::abs(series.columns->y(i));
+            }
+            return total;
+        }
+        for (const auto& point : series.data) {
             total += std::abs(point.y);
         }
     }
@@ -0,0 +1,314 @@
+/**
+ * @file ChartColumns.cpp
+ * @brief Chart column storage implementation
+ */
+
+#include "KillerGK/widgets/ChartColumns.hpp"
+#include <cmath>
+#include <limits>
+
+namespace KillerGK {
+
+namespace {
+
+const std::string kNoLabel;
+
+double validUnit(double unit) {
+    return unit > 0.0 && std::isfinite(unit) ? unit : 1.0;
+}
+
+} // namespace
+
+// =============================================================================
+// Column
+// =============================================================================
+
+void ChartColumns::Column::reserve(size_t count) {
+    switch (type) {
+        case ChartColumnType::Float64:
+            ownedDoubles.reserve(count);
+            break;
+        case ChartColumnType::Float32:
+            ownedFloats.reserve(count);
+            break;
+        case ChartColumnType::Delta32:
+            steps.reserve(count);
+            bases.reserve(count / DELTA_BLOCK + 1);
+            break;
+    }
+    // Reserving may have moved the values
+    if (!viewed) {
+        doubles = ownedDoubles.data();
+        floats = ownedFloats.data();
+    }
+}
+
+void ChartColumns::Column::push(double value) {
+    switch (type) {
+        case ChartColumnType::Float64:
+            ownedDoubles.push_back(value);
+            doubles = ownedDoubles.data();
+            break;
+        case ChartColumnType::Float32:
+            ownedFloats.push_back(static_cast<float>(value));
+            floats = ownedFloats.data();
+            break;
+        case ChartColumnType::Delta32:
+            if (size % DELTA_BLOCK == 0) {
+                if (std::isnan(value)) {
+                    promote();
+                    push(value);
+                    return;
+                }
+                bases.push_back(value);
+                steps.push_back(0);
+            } else {
+                double step = std::round((value - bases.back()) / unit);
+                if (!(step >= 0.0 && step <= static_cast<double>(std::numeric_limits<uint32_t>::max()))) {
+                    promote();
+                    push(value);
+                    return;
+                }
+                steps.push_back(static_cast<uint32_t>(step));
+            }
+            break;
+    }
+    size++;
+}
+
+void ChartColumns::Column::own(size_t count) {
+    if (!viewed) {
+        if (size > count) {
+            // Cut to the other column's length
+            ownedDoubles.resize(std::min(ownedDoubles.size(), count));
+            ownedFloats.resize(std::min(ownedFloats.size(), count));
+            steps.resize(std::min(steps.size(), count));
+            bases.resize(std::min(bases.size(), (count + DELTA_BLOCK - 1) / DELTA_BLOCK));
+            size = count;
+        }
+        return;
+    }
+    if (type == ChartColumnType::Float64) {
+        ownedDoubles.assign(doubles, doubles + count);
+        doubles = ownedDoubles.data();
+    } else {
+        ownedFloats.assign(floats, floats + count);
+        floats = ownedFloats.data();
+    }
+    size = count;
+    viewed = false;
+}
+
+void ChartColumns::Column::promote() {
+    std::vector<double> values;
+    values.reserve(std::max(steps.capacity(), size + 1));
+    for (size_t i = 0; i < size; ++i) {
+        values.push_back(at(i));
+    }
+    bases = {};
+    steps = {};
+    ownedDoubles = std::move(values);
+    doubles = ownedDoubles.data();
+    type = ChartColumnType::Float64;
+}
+
+void ChartColumns::Column::clear() {
+    viewed = false;
+    type = storage;
+    ownedDoubles.clear();
+    ownedFloats.clear();
+    bases.clear();
+    steps.clear();
+    doubles = ownedDoubles.data();
+    floats = ownedFloats.data();
+    size = 0;
+}
+
+size_t ChartColumns::Column::memoryUsage() const {
+    return ownedDoubles.capacity() * sizeof(double) + ownedFloats.capacity() * sizeof(float) +
+           bases.capacity() * sizeof(double) + steps.capacity() * sizeof(uint32_t);
+}
+
+template <typename Visit>
+void ChartColumns::Column::forEach(size_t count, Visit visit) const {
+    // One loop per storage type, so scans run without a switch per value
+    switch (type) {
+        case ChartColumnType::Float64:
+            for (size_t i = 0; i < count; ++i) visit(doubles[i]);
+            break;
+        case ChartColumnType::Float32:
+            for (size_t i = 0; i < count; ++i) visit(static_cast<double>(floats[i]));
+            break;
+        case ChartColumnType::Delta32:
+            for (size_t block = 0; block * DELTA_BLOCK < count; ++block) {
+                double base = bases[block];
+                size_t end = std::min(count, (block + 1) * DELTA_BLOCK);
+                for (size_t i = block * DELTA_BLOCK; i < end; ++i) {
+                    visit(base + static_cast<double>(steps[i]) * unit);
+                }
+            }
+            break;
+    }
+}
+
+// =============================================================================
+// ChartColumns
+// =============================================================================
+
+ChartColumns::ChartColumns(ChartColumnType xType, ChartColumnType yType, double xUnit, double yUnit) {
+    m_x.type = m_x.storage = xType;
+    m_x.unit = validUnit(xUnit);
+    m_y.type = m_y.storage = yType;
+    m_y.unit = validUnit(yUnit);
+}
+
+ChartColumns& ChartColumns::viewX(std::span<const double> values) {
+    m_x.clear();
+    m_x.type = ChartColumnType::Float64;
+    m_x.doubles = values.data();
+    m_x.size = values.size();
+    m_x.viewed = true;
+    return *this;
+}
+
+ChartColumns& ChartColumns::viewX(std::span<const float> values) {
+    m_x.clear();
+    m_x.type = ChartColumnType::Float32;
+    m_x.floats = values.data();
+    m_x.size = values.size();
+    m_x.viewed = true;
+    return *this;
+}
+
+ChartColumns& ChartColumns::viewY(std::span<const double> values) {
+    m_y.clear();
+    m_y.type = ChartColumnType::Float64;
+    m_y.doubles = values.data();
+    m_y.size = values.size();
+    m_y.viewed = true;
+    return *this;
+}
+
+ChartColumns& ChartColumns::viewY(std::span<const float> values) {
+    m_y.clear();
+    m_y.type = ChartColumnType::Float32;
+    m_y.floats = values.data();
+    m_y.size = values.size();
+    m_y.viewed = true;
+    return *this;
+}
+
+void ChartColumns::reserve(size_t count) {
+    m_x.own(size());
+    m_y.own(size());
+    m_x.reserve(count);
+    m_y.reserve(count);
+}
+
+void ChartColumns::append(double x, double y) {
+    // Viewed arrays are copied, and cut to the same length, before growing
+    m_x.own(size());
+    m_y.own(size());
+    m_x.push(x);
+    m_y.push(y);
+}
+
+void ChartColumns::append(std::span<const double> x, std::span<const double> y) {
+    m_x.own(size());
+    m_y.own(size());
+    size_t count = std::min(x.size(), y.size());
+    for (size_t i = 0; i < count; ++i) {
+        m_x.push(x[i]);
+        m_y.push(y[i]);
+    }
+}
+
+void ChartColumns::append(const std::vector<DataPoint>& points) {
+    m_x.own(size());
+    m_y.own(size());
+    for (const auto& point : points) {
+        if (!point.label.empty()) {
+            m_labels.emplace_back(size(), point.label);
+        }
+        m_x.push(point.x);
+        m_y.push(point.y);
+    }
+}
+
+void ChartColumns::clear() {
+    m_x.clear();
+    m_y.clear();
+    m_labels.clear();
+}
+
+// =============================================================================
+// Access
+// =============================================================================
+
+DataPoint ChartColumns::point(size_t index) const {
+    return DataPoint(x(index), y(index), label(index));
+}
+
+bool ChartColumns::getRange(double& minX, double& maxX, double& minY, double& maxY) const {
+    size_t count = size();
+    double lowX = std::numeric_limits<double>::infinity();
+    double highX = -lowX;
+    double lowY = lowX;
+    double highY = -lowX;
+    bool hasX = false;
+    bool hasY = false;
+    m_x.forEach(count, [&](double value) {
+        if (std::isnan(value)) return;
+        hasX = true;
+        lowX = std::min(lowX, value);
+        highX = std::max(highX, value);
+    });
+    m_y.forEach(count, [&](double value) {
+        if (std::isnan(value)) return;
+        hasY = true;
+        lowY = std::min(lowY, value);
+        highY = std::max(highY, value);
+    });
+    if (!hasX || !hasY) return false;
+    minX = lowX;
+    maxX = highX;
+    minY = lowY;
+    maxY = highY;
+    return true;
+}
+
+size_t ChartColumns::memoryUsage() const {
+    size_t bytes = m_x.memoryUsage() + m_y.memoryUsage();
+    bytes += m_labels.capacity() * sizeof(m_labels[0]);
+    for (const auto& [index, text] : m_labels) {
+        // Short labels live inside the string itself
+        auto* inside = reinterpret_cast<const char*>(&text);
+        if (text.data() < inside || text.data() >= inside + sizeof(text)) bytes += text.capacity() + 1;
+    }
+    return bytes;
+}
+
+// =============================================================================
+// Labels
+// =============================================================================
+
+void ChartColumns::setLabel(size_t index, std::string label) {
+    auto it = std::lower_bound(m_labels.begin(), m_labels.end(), index,
+                               [](const auto& entry, size_t i) { return entry.first < i; });
+    bool found = it != m_labels.end() && it->first == index;
+    if (label.empty()) {
+        if (found) m_labels.erase(it);
+    } else if (found) {
+        it->second = std::move(label);
+    } else {
+        m_labels.emplace(it, index, std::move(label));
+    }
+}
+
+const std::string& ChartColumns::label(size_t index) const {
+    auto it = std::lower_bound(m_labels.begin(), m_labels.end(), index,
+                               [](const auto& entry, size_t i) { return entry.first < i; });
+    return it != m_labels.end() && it->first == index ? it->second : kNoLabel;
+}
+
+} // namespace KillerGK
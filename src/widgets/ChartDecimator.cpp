@@ -0,0 +1,334 @@
+/**
+ * @file ChartDecimator.cpp
+ * @brief Chart render point decimation implementation
+ */
+
+#include "KillerGK/widgets/ChartDecimator.hpp"
+#include "KillerGK/widgets/ChartColumns.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace KillerGK {
+
+namespace {
+
+// Point access for both series layouts
+size_t countOf(const std::vector<DataPoint>& data) { return data.size(); }
+double xAt(const std::vector<DataPoint>& data, size_t index) { return data[index].x; }
+double yAt(const std::vector<DataPoint>& data, size_t index) { return data[index].y; }
+size_t countOf(const ChartColumns& data) { return data.size(); }
+double xAt(const ChartColumns& data, size_t index) { return data.x(index); }
+double yAt(const ChartColumns& data, size_t index) { return data.y(index); }
+
+template <typename Data>
+bool samePoint(const ChartRenderPoint& point, const Data& data, size_t index) {
+    auto same = [](double a, double b) { return a == b || (std::isnan(a) && std::isnan(b)); };
+    return same(point.x, xAt(data, index)) && same(point.y, yAt(data, index));
+}
+
+/**
+ * @brief First index in [first, last) whose x is not below (or, if
+ *        inclusive is false, is above) a value; x must be ascending
+ */
+template <typename Data>
+size_t bisect(const Data& data, size_t first, size_t last, double x, bool inclusive) {
+    while (first < last) {
+        size_t middle = first + (last - first) / 2;
+        double value = xAt(data, middle);
+        if (inclusive ? value < x : value <= x) {
+            first = middle + 1;
+        } else {
+            last = middle;
+        }
+    }
+    return first;
+}
+
+/**
+ * @brief Append a point unless it was just appended
+ */
+template <typename Data>
+void push(std::vector<ChartRenderPoint>& output, const Data& data, size_t index) {
+    if (output.empty() || output.back().index != index) {
+        output.push_back({xAt(data, index), yAt(data, index), index});
+    }
+}
+
+} // namespace
+
+// =============================================================================
+// Cache management
+// =============================================================================
+
+void ChartDecimator::reset() {
+    m_caches.clear();
+    m_all.clear();
+    m_size = 0;
+    m_sorted = true;
+}
+
+template <typename Data>
+void ChartDecimator::checkData(const Data& data) {
+    if (countOf(data) < m_size ||
+        (m_size > 0 && (!samePoint(m_first, data, 0) || !samePoint(m_last, data, m_size - 1)))) {
+        reset();
+    }
+    if (countOf(data) == m_size) return;
+
+    for (size_t i = std::max<size_t>(m_size, 1); i < countOf(data) && m_sorted; ++i) {
+        m_sorted = xAt(data, i) >= xAt(data, i - 1);  // NaN counts as out of order
+    }
+    if (std::isnan(xAt(data, 0))) {
+        m_sorted = false;
+    }
+    m_size = countOf(data);
+    m_first = {xAt(data, 0), yAt(data, 0), 0};
+    m_last = {xAt(data, m_size - 1), yAt(data, m_size - 1), m_size - 1};
+}
+
+bool ChartDecimator::isSorted(const std::vector<DataPoint>& data) {
+    checkData(data);
+    return m_sorted;
+}
+
+bool ChartDecimator::isSorted(const ChartColumns& data) {
+    checkData(data);
+    return m_sorted;
+}
+
+ChartDecimator::Cache& ChartDecimator::cacheFor(const View& view) {
+    auto it = std::find_if(m_caches.begin(), m_caches.end(),
+                           [&view](const Cache& cache) { return cache.view == view; });
+    if (it == m_caches.end()) {
+        if (m_caches.size() < MAX_CACHED_VIEWS) {
+            it = m_caches.emplace(m_caches.end());
+        } else {
+            // Replace the view used least recently
+            it = std::min_element(m_caches.begin(), m_caches.end(),
+                                  [](const Cache& a, const Cache& b) { return a.lastUse < b.lastUse; });
+            *it = Cache{};
+        }
+        it->view = view;
+    }
+    it->lastUse = ++m_uses;
+    return *it;
+}
+
+const std::vector<ChartRenderPoint>& ChartDecimator::points(const std::vector<DataPoint>& data, const View& view) {
+    return decimate(data, view);
+}
+
+const std::vector<ChartRenderPoint>& ChartDecimator::points(const ChartColumns& data, const View& view) {
+    return decimate(data, view);
+}
+
+template <typename Data>
+const std::vector<ChartRenderPoint>& ChartDecimator::decimate(const Data& data, const View& view) {
+    checkData(data);
+
+    if (!m_sorted) {
+        for (size_t i = m_all.size(); i < countOf(data); ++i) {
+            m_all.push_back({xAt(data, i), yAt(data, i), i});
+        }
+        return m_all;
+    }
+
+    Cache& cache = cacheFor(view);
+    if (cache.built && cache.seen == countOf(data)) {
+        return cache.output;
+    }
+
+    update(cache, data);
+    cache.output.clear();
+    if (view.columns == 0 || view.mode == ChartDecimation::None) {
+        buildAll(cache, data);
+    } else if (view.mode == ChartDecimation::MinMax) {
+        buildMinMax(cache, data);
+    } else {
+        buildLttb(cache, data);
+    }
+    cache.built = true;
+    cache.dirtyColumn = cache.columns.size();
+    return cache.output;
+}
+
+// =============================================================================
+// Bucketing
+// =============================================================================
+
+template <typename Data>
+void ChartDecimator::update(Cache& cache, const Data& data) {
+    const View& view = cache.view;
+    size_t previous = cache.seen;
+
+    if (!cache.built) {
+        // Points are in x order: find the visible ones by bisection
+        cache.begin = bisect(data, 0, countOf(data), view.xMin, true);
+        cache.end = std::max(bisect(data, cache.begin, countOf(data), view.xMax, false), cache.begin);
+        cache.columns.assign(view.columns, Column{});
+        cache.selected.assign(view.columns, NO_POINT);
+        cache.lastColumn = 0;
+        cache.dirtyColumn = 0;
+        if (view.columns > 0) {
+            for (size_t i = cache.begin; i < cache.end; ++i) {
+                add(cache, data, i);
+            }
+        }
+        cache.seen = countOf(data);
+        return;
+    }
+
+    // Appended points come after every point already seen
+    for (size_t i = previous; i < countOf(data); ++i) {
+        double x = xAt(data, i);
+        if (x < view.xMin) {
+            cache.begin = cache.end = i + 1;
+        } else if (x <= view.xMax) {
+            if (view.columns > 0) {
+                add(cache, data, i);
+            }
+            cache.end = i + 1;
+        } else {
+            break;
+        }
+    }
+    cache.seen = countOf(data);
+}
+
+template <typename Data>
+void ChartDecimator::add(Cache& cache, const Data& data, size_t index) {
+    const View& view = cache.view;
+    double x = xAt(data, index);
+    double y = yAt(data, index);
+
+    size_t column = 0;
+    double span = view.xMax - view.xMin;
+    if (span > 0.0) {
+        double position = (x - view.xMin) / span * static_cast<double>(view.columns);
+        column = std::min(static_cast<size_t>(std::max(position, 0.0)), view.columns - 1);
+    }
+
+    Column& bucket = cache.columns[column];
+    if (bucket.count == 0) {
+        bucket.first = bucket.low = bucket.high = index;
+    } else {
+        if (y < yAt(data, bucket.low)) bucket.low = index;
+        if (y > yAt(data, bucket.high)) bucket.high = index;
+    }
+    bucket.last = index;
+    bucket.count++;
+    bucket.sumX += x;
+    bucket.sumY += y;
+
+    cache.lastColumn = std::max(cache.lastColumn, column);
+    cache.dirtyColumn = std::min(cache.dirtyColumn, column);
+}
+
+// =============================================================================
+// Output
+// =============================================================================
+
+template <typename Data>
+void ChartDecimator::buildAll(Cache& cache, const Data& data) {
+    size_t first = cache.begin > 0 ? cache.begin - 1 : 0;
+    size_t last = std::min(cache.end + 1, countOf(data));
+    cache.output.reserve(last - first);
+    for (size_t i = first; i < last; ++i) {
+        push(cache.output, data, i);
+    }
+}
+
+template <typename Data>
+void ChartDecimator::buildMinMax(Cache& cache, const Data& data) {
+    auto& output = cache.output;
+    if (cache.begin > 0) {
+        push(output, data, cache.begin - 1);
+    }
+
+    // First, lowest, highest and last point of each column, in series order
+    for (const Column& bucket : cache.columns) {
+        if (bucket.count == 0) continue;
+        size_t picks[4] = {bucket.first, bucket.low, bucket.high, bucket.last};
+        std::sort(picks + 1, picks + 3);
+        for (size_t index : picks) {
+            push(output, data, index);
+        }
+    }
+
+    if (cache.end < countOf(data)) {
+        push(output, data, cache.end);
+    }
+}
+
+template <typename Data>
+void ChartDecimator::buildLttb(Cache& cache, const Data& data) {
+    auto& output = cache.output;
+    if (cache.begin > 0) {
+        push(output, data, cache.begin - 1);
+    }
+    if (cache.begin == cache.end) {
+        if (cache.end < countOf(data)) push(output, data, cache.end);
+        return;
+    }
+
+    const auto& columns = cache.columns;
+    size_t count = columns.size();
+
+    // Selections before the last non-empty column ahead of the first change
+    // still hold; the last column is always redone as the point after it may
+    // have been appended
+    size_t redoFrom = std::min(cache.dirtyColumn, count);
+    while (redoFrom > 0 && columns[redoFrom - 1].count == 0) {
+        redoFrom--;
+    }
+    if (redoFrom > 0) {
+        redoFrom--;
+    }
+
+    // Each column keeps the point forming the largest triangle with the point
+    // kept before it and the average of the next column
+    size_t previous = cache.begin;
+    size_t next = 0;
+    while (next < count && columns[next].count == 0) next++;
+    for (size_t c = next; c < count; c = next) {
+        next = c + 1;
+        while (next < count && columns[next].count == 0) next++;
+
+        if (c >= redoFrom) {
+            double nextX, nextY;
+            if (next < count) {
+                nextX = columns[next].sumX / static_cast<double>(columns[next].count);
+                nextY = columns[next].sumY / static_cast<double>(columns[next].count);
+            } else {
+                size_t after = cache.end < countOf(data) ? cache.end : cache.end - 1;
+                nextX = xAt(data, after);
+                nextY = yAt(data, after);
+            }
+
+            double ax = xAt(data, previous);
+            double ay = yAt(data, previous);
+            size_t best = columns[c].first;
+            double bestArea = -1.0;
+            for (size_t i = columns[c].first; i <= columns[c].last; ++i) {
+                double area = std::abs((ax - nextX) * (yAt(data, i) - ay) - (ax - xAt(data, i)) * (nextY - ay));
+                if (area > bestArea) {
+                    bestArea = area;
+                    best = i;
+                }
+            }
+            cache.selected[c] = best;
+        }
+        previous = cache.selected[c];
+    }
+
+    push(output, data, cache.begin);
+    for (size_t c = 0; c < count; ++c) {
+        if (columns[c].count > 0) push(output, data, cache.selected[c]);
+    }
+    push(output, data, cache.end - 1);
+    if (cache.end < countOf(data)) {
+        push(output, data, cache.end);
+    }
+}
+
+} // namespace KillerGK
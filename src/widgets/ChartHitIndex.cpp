@@ -0,0 +1,242 @@
+/**
+ * @file ChartHitIndex.cpp
+ * @brief Chart nearest-point index implementation
+ */
+
+#include "KillerGK/widgets/ChartHitIndex.hpp"
+#include "KillerGK/widgets/ChartColumns.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace KillerGK {
+
+namespace {
+
+constexpr size_t kLeafSize = 8;
+
+// Point access for both series layouts
+size_t countOf(const std::vector<DataPoint>& data) { return data.size(); }
+double xAt(const std::vector<DataPoint>& data, size_t index) { return data[index].x; }
+double yAt(const std::vector<DataPoint>& data, size_t index) { return data[index].y; }
+size_t countOf(const ChartColumns& data) { return data.size(); }
+double xAt(const ChartColumns& data, size_t index) { return data.x(index); }
+double yAt(const ChartColumns& data, size_t index) { return data.y(index); }
+
+template <typename Data>
+double coordinate(const Data& data, size_t index, int axis) {
+    return axis == 0 ? xAt(data, index) : yAt(data, index);
+}
+
+template <typename Data>
+bool samePoint(const ChartRenderPoint& point, const Data& data, size_t index) {
+    auto same = [](double a, double b) { return a == b || (std::isnan(a) && std::isnan(b)); };
+    return same(point.x, xAt(data, index)) && same(point.y, yAt(data, index));
+}
+
+/**
+ * @brief Take a point as the best hit if it is nearer (or as near, and earlier)
+ */
+template <typename Data>
+void consider(const Data& data, size_t index, const ChartHitIndex::Query& query, ChartHitIndex::Hit& best) {
+    double dx = (xAt(data, index) - query.x) * query.scaleX;
+    double dy = (yAt(data, index) - query.y) * query.scaleY;
+    double distance = std::sqrt(dx * dx + dy * dy);
+    if (distance < best.distance || (distance == best.distance && index < best.index)) {
+        best.index = index;
+        best.distance = distance;
+    }
+}
+
+} // namespace
+
+// =============================================================================
+// Data tracking
+// =============================================================================
+
+void ChartHitIndex::reset() {
+    m_size = 0;
+    m_sorted = true;
+    m_hasX = false;
+    m_hasY = false;
+    m_trees.clear();
+    m_indexed = 0;
+}
+
+template <typename Data>
+void ChartHitIndex::sync(const Data& data) {
+    size_t count = countOf(data);
+    if (count < m_size ||
+        (m_size > 0 && (!samePoint(m_first, data, 0) || !samePoint(m_last, data, m_size - 1)))) {
+        reset();
+    }
+    if (count == m_size) return;
+
+    for (size_t i = m_size; i < count; ++i) {
+        double x = xAt(data, i);
+        double y = yAt(data, i);
+        if (m_sorted && (std::isnan(x) || (i > 0 && x < xAt(data, i - 1)))) {
+            m_sorted = false;
+        }
+        if (!std::isnan(x)) {
+            m_minX = m_hasX ? std::min(m_minX, x) : x;
+            m_maxX = m_hasX ? std::max(m_maxX, x) : x;
+            m_hasX = true;
+        }
+        if (!std::isnan(y)) {
+            m_minY = m_hasY ? std::min(m_minY, y) : y;
+            m_maxY = m_hasY ? std::max(m_maxY, y) : y;
+            m_hasY = true;
+        }
+    }
+    m_size = count;
+    m_first = {xAt(data, 0), yAt(data, 0), 0};
+    m_last = {xAt(data, count - 1), yAt(data, count - 1), count - 1};
+}
+
+bool ChartHitIndex::getRange(const std::vector<DataPoint>& data, double& minX, double& maxX, double& minY,
+                             double& maxY) {
+    sync(data);
+    if (!m_hasX || !m_hasY) return false;
+    minX = m_minX;
+    maxX = m_maxX;
+    minY = m_minY;
+    maxY = m_maxY;
+    return true;
+}
+
+bool ChartHitIndex::getRange(const ChartColumns& data, double& minX, double& maxX, double& minY, double& maxY) {
+    sync(data);
+    if (!m_hasX || !m_hasY) return false;
+    minX = m_minX;
+    maxX = m_maxX;
+    minY = m_minY;
+    maxY = m_maxY;
+    return true;
+}
+
+// =============================================================================
+// Trees
+// =============================================================================
+
+template <typename Data>
+void ChartHitIndex::index(const Data& data) {
+    if (m_size - m_indexed < MAX_UNINDEXED) return;
+
+    std::vector<size_t> tree;
+    tree.reserve(m_size - m_indexed);
+    for (size_t i = m_indexed; i < m_size; ++i) {
+        if (!std::isnan(xAt(data, i)) && !std::isnan(yAt(data, i))) tree.push_back(i);
+    }
+    m_indexed = m_size;
+    m_trees.push_back(std::move(tree));
+
+    // Merge trees of similar size, so there are O(log n) of them
+    while (m_trees.size() >= 2 && m_trees[m_trees.size() - 2].size() < 2 * m_trees.back().size()) {
+        auto& into = m_trees[m_trees.size() - 2];
+        into.insert(into.end(), m_trees.back().begin(), m_trees.back().end());
+        m_trees.pop_back();
+    }
+    auto& last = m_trees.back();
+    buildTree(data, last, 0, last.size(), 0);
+}
+
+template <typename Data>
+void ChartHitIndex::buildTree(const Data& data, std::vector<size_t>& tree, size_t begin, size_t end, int axis) {
+    // Median split: lower coordinates before the middle, higher after
+    while (end - begin > kLeafSize) {
+        size_t middle = begin + (end - begin) / 2;
+        std::nth_element(tree.begin() + static_cast<std::ptrdiff_t>(begin),
+                         tree.begin() + static_cast<std::ptrdiff_t>(middle),
+                         tree.begin() + static_cast<std::ptrdiff_t>(end),
+                         [&data, axis](size_t a, size_t b) {
+                             return coordinate(data, a, axis) < coordinate(data, b, axis);
+                         });
+        buildTree(data, tree, begin, middle, 1 - axis);
+        begin = middle + 1;
+        axis = 1 - axis;
+    }
+}
+
+template <typename Data>
+void ChartHitIndex::searchTree(const Data& data, const std::vector<size_t>& tree, size_t begin, size_t end, int axis,
+                               const Query& query, Hit& best) const {
+    while (end - begin > kLeafSize) {
+        size_t middle = begin + (end - begin) / 2;
+        consider(data, tree[middle], query, best);
+
+        double offset = (coordinate(data, tree[middle], axis) - (axis == 0 ? query.x : query.y)) *
+                        (axis == 0 ? query.scaleX : query.scaleY);
+        // The near side first; the far side only if it may hold a nearer point
+        bool below = offset > 0.0;
+        if (below) {
+            searchTree(data, tree, begin, middle, 1 - axis, query, best);
+            begin = middle + 1;
+        } else {
+            searchTree(data, tree, middle + 1, end, 1 - axis, query, best);
+            end = middle;
+        }
+        if (std::abs(offset) > best.distance) return;
+        axis = 1 - axis;
+    }
+    for (size_t i = begin; i < end; ++i) {
+        consider(data, tree[i], query, best);
+    }
+}
+
+// =============================================================================
+// Search
+// =============================================================================
+
+ChartHitIndex::Hit ChartHitIndex::nearest(const std::vector<DataPoint>& data, const Query& query) {
+    return search(data, query);
+}
+
+ChartHitIndex::Hit ChartHitIndex::nearest(const ChartColumns& data, const Query& query) {
+    return search(data, query);
+}
+
+template <typename Data>
+ChartHitIndex::Hit ChartHitIndex::search(const Data& data, const Query& query) {
+    sync(data);
+    Hit best{NO_POINT, query.radius};
+
+    // With no x scale every point is as near in x, so bisection narrows nothing
+    if (m_sorted && query.scaleX > 0.0) {
+        // Bisect on x, then widen toward the nearer side while x alone is near
+        // enough; where points crowd in x, leave the rest to the trees, which
+        // also prune on y
+        size_t first = 0;
+        size_t last = m_size;
+        while (first < last) {
+            size_t middle = first + (last - first) / 2;
+            if (xAt(data, middle) < query.x) {
+                first = middle + 1;
+            } else {
+                last = middle;
+            }
+        }
+        size_t up = first;
+        size_t down = first;
+        for (size_t walked = 0; walked < MAX_SORTED_SCAN; ++walked) {
+            double upGap = up < m_size ? (xAt(data, up) - query.x) * query.scaleX : best.distance + 1.0;
+            double downGap = down > 0 ? (query.x - xAt(data, down - 1)) * query.scaleX : best.distance + 1.0;
+            if (std::min(upGap, downGap) > best.distance) return best;
+            if (upGap <= downGap) {
+                consider(data, up++, query, best);
+            } else {
+                consider(data, --down, query, best);
+            }
+        }
+    }
+
+    index(data);
+    for (const auto& tree : m_trees) {
+        searchTree(data, tree, 0, tree.size(), 0, query, best);
+    }
+    for (size_t i = m_indexed; i < m_size; ++i) {
+        consider(data, i, query, best);
+    }
+    return best;
+}
+
+} // namespace KillerGK
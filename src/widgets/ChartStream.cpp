@@ -0,0 +1,143 @@
+/**
+ * @file ChartStream.cpp
+ * @brief Streaming Chart data implementation
+ */
+
+#include "KillerGK/widgets/ChartStream.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace KillerGK {
+
+namespace {
+
+/**
+ * @brief Append a point to a monotonic queue, dropping the points it beats
+ * @param better Whether a value beats another (ties go to the newer point)
+ */
+template <typename Queue, typename Better>
+void pushExtreme(Queue& queue, const std::vector<double>& values, size_t capacity, uint64_t sequence,
+                 Better better) {
+    double value = values[static_cast<size_t>(sequence % capacity)];
+    if (std::isnan(value)) return;
+    while (queue.count > 0 && !better(values[static_cast<size_t>(queue.back() % capacity)], value)) {
+        queue.popBack();
+    }
+    queue.pushBack(sequence);
+}
+
+size_t roundUpToPowerOfTwo(size_t value) {
+    size_t result = 1;
+    while (result < value) result <<= 1;
+    return result;
+}
+
+} // namespace
+
+ChartStream::ChartStream(size_t capacity, size_t stagingCapacity) {
+    capacity = std::max<size_t>(capacity, 1);
+    m_x.assign(capacity, 0.0);
+    m_y.assign(capacity, 0.0);
+    for (auto* queue : {&m_lowX, &m_highX, &m_lowY, &m_highY}) {
+        queue->items.assign(capacity, 0);
+    }
+    m_staging.resize(roundUpToPowerOfTwo(stagingCapacity > 0 ? stagingCapacity : capacity));
+    m_stagingMask = m_staging.size() - 1;
+}
+
+// =============================================================================
+// Producer
+// =============================================================================
+
+bool ChartStream::push(double x, double y) {
+    size_t tail = m_stagingTail.load(std::memory_order_relaxed);
+    size_t head = m_stagingHead.load(std::memory_order_acquire);
+    if (tail - head == m_staging.size()) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    m_staging[tail & m_stagingMask] = {x, y};
+    m_stagingTail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+size_t ChartStream::push(const std::vector<DataPoint>& points) {
+    size_t tail = m_stagingTail.load(std::memory_order_relaxed);
+    size_t head = m_stagingHead.load(std::memory_order_acquire);
+    size_t count = std::min(points.size(), m_staging.size() - (tail - head));
+    for (size_t i = 0; i < count; ++i) {
+        m_staging[(tail + i) & m_stagingMask] = {points[i].x, points[i].y};
+    }
+    // One release for the whole batch
+    m_stagingTail.store(tail + count, std::memory_order_release);
+    if (count < points.size()) {
+        m_dropped.fetch_add(points.size() - count, std::memory_order_relaxed);
+    }
+    return count;
+}
+
+// =============================================================================
+// Window
+// =============================================================================
+
+size_t ChartStream::update() {
+    size_t head = m_stagingHead.load(std::memory_order_relaxed);
+    size_t tail = m_stagingTail.load(std::memory_order_acquire);
+    for (size_t i = head; i != tail; ++i) {
+        const Sample& sample = m_staging[i & m_stagingMask];
+        add(sample.x, sample.y);
+    }
+    m_stagingHead.store(tail, std::memory_order_release);
+    return tail - head;
+}
+
+void ChartStream::add(double x, double y) {
+    size_t capacity = m_x.size();
+    if (m_size == capacity) {
+        // The oldest point leaves the window
+        uint64_t oldest = m_total - capacity;
+        for (auto* queue : {&m_lowX, &m_highX, &m_lowY, &m_highY}) {
+            if (queue->count > 0 && queue->front() == oldest) queue->popFront();
+        }
+        m_size--;
+    }
+
+    uint64_t sequence = m_total++;
+    m_x[slot(sequence)] = x;
+    m_y[slot(sequence)] = y;
+    m_size++;
+
+    auto lower = [](double a, double b) { return a < b; };
+    auto higher = [](double a, double b) { return a > b; };
+    pushExtreme(m_lowX, m_x, capacity, sequence, lower);
+    pushExtreme(m_highX, m_x, capacity, sequence, higher);
+    pushExtreme(m_lowY, m_y, capacity, sequence, lower);
+    pushExtreme(m_highY, m_y, capacity, sequence, higher);
+}
+
+void ChartStream::clear() {
+    m_size = 0;
+    for (auto* queue : {&m_lowX, &m_highX, &m_lowY, &m_highY}) {
+        queue->head = 0;
+        queue->count = 0;
+    }
+}
+
+bool ChartStream::getRange(double& minX, double& maxX, double& minY, double& maxY) const {
+    if (m_lowX.count == 0 || m_lowY.count == 0) return false;
+    minX = m_x[slot(m_lowX.front())];
+    maxX = m_x[slot(m_highX.front())];
+    minY = m_y[slot(m_lowY.front())];
+    maxY = m_y[slot(m_highY.front())];
+    return true;
+}
+
+void ChartStream::copyTo(std::vector<DataPoint>& points) const {
+    points.clear();
+    points.reserve(m_size);
+    for (size_t i = 0; i < m_size; ++i) {
+        points.emplace_back(x(i), y(i));
+    }
+}
+
+} // namespace KillerGK
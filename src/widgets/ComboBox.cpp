@@ -4,6 +4,7 @@
  */
 
 #include "KillerGK/widgets/ComboBox.hpp"
+#include "KillerGK/widgets/WidgetArena.hpp"
 #include <algorithm>
 #include <cctype>
 
@@ -42,7 +43,7 @@ struct ComboBox::ComboBoxData {
 
 ComboBox::ComboBox()
     : Widget()
-    , m_comboData(std::make_shared<ComboBoxData>())
+    , m_comboData(WidgetArena::makeShared<ComboBoxData>())
 {
     // Default styling
     backgroundColor(Color(1.0f, 1.0f, 1.0f, 1.0f));
@@ -59,6 +60,8 @@ ComboBox ComboBox::create() {
 
 // Items Management
 ComboBox& ComboBox::items(const std::vector<ComboBoxItem>& items) {
+    // Items hold user data, so lists aren't compared; only empty to empty is a no-op
+    if (!items.empty() || !m_comboData->items.empty()) invalidate(DirtyFlags::Paint);
     m_comboData->items = items;
     m_comboData->selectedIndex = -1;
     m_comboData->highlightedIndex = -1;
@@ -67,11 +70,13 @@ ComboBox& ComboBox::items(const std::vector<ComboBoxItem>& items) {
 
 ComboBox& ComboBox::addItem(const ComboBoxItem& item) {
     m_comboData->items.push_back(item);
+    invalidate(DirtyFlags::Paint);
     return *this;
 }
 
 ComboBox& ComboBox::addItem(const std::string& id, const std::string& text) {
     m_comboData->items.emplace_back(id, text);
+    invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -82,6 +87,7 @@ ComboBox& ComboBox::removeItem(const std::string& id) {
     if (it != m_comboData->items.end()) {
         size_t removedIndex = std::distance(m_comboData->items.begin(), it);
         m_comboData->items.erase(it, m_comboData->items.end());
+        invalidate(DirtyFlags::Paint);
         
         // Adjust selection if needed
         if (m_comboData->selectedIndex >= static_cast<int>(removedIndex)) {
@@ -96,6 +102,7 @@ ComboBox& ComboBox::removeItem(const std::string& id) {
 }
 
 ComboBox& ComboBox::clearItems() {
+    if (!m_comboData->items.empty()) invalidate(DirtyFlags::Paint);
     m_comboData->items.clear();
     m_comboData->selectedIndex = -1;
     m_comboData->highlightedIndex = -1;
@@ -134,7 +141,7 @@ std::vector<ComboBoxItem> ComboBox::getFilteredItems() const {
 ComboBox& ComboBox::select(const std::string& id) {
     for (size_t i = 0; i < m_comboData->items.size(); ++i) {
         if (m_comboData->items[i].id == id) {
-            m_comboData->selectedIndex = static_cast<int>(i);
+            if (assign(m_comboData->selectedIndex, static_cast<int>(i))) invalidate(DirtyFlags::Paint);
             if (m_comboData->onSelectCallback) {
                 m_comboData->onSelectCallback(m_comboData->items[i]);
             }
@@ -146,7 +153,7 @@ ComboBox& ComboBox::select(const std::string& id) {
 
 ComboBox& ComboBox::selectIndex(int index) {
     if (index >= 0 && index < static_cast<int>(m_comboData->items.size())) {
-        m_comboData->selectedIndex = index;
+        if (assign(m_comboData->selectedIndex, index)) invalidate(DirtyFlags::Paint);
         if (m_comboData->onSelectCallback) {
             m_comboData->onSelectCallback(m_comboData->items[index]);
         }
@@ -155,7 +162,7 @@ ComboBox& ComboBox::selectIndex(int index) {
 }
 
 ComboBox& ComboBox::clearSelection() {
-    m_comboData->selectedIndex = -1;
+    if (assign(m_comboData->selectedIndex, -1)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -176,6 +183,7 @@ ComboBox& ComboBox::open() {
     if (!m_comboData->isOpen) {
         m_comboData->isOpen = true;
         m_comboData->highlightedIndex = m_comboData->selectedIndex;
+        invalidate(DirtyFlags::Paint);
         if (m_comboData->onDropdownToggleCallback) {
             m_comboData->onDropdownToggleCallback(true);
         }
@@ -187,6 +195,7 @@ ComboBox& ComboBox::close() {
     if (m_comboData->isOpen) {
         m_comboData->isOpen = false;
         m_comboData->searchText.clear();
+        invalidate(DirtyFlags::Paint);
         if (m_comboData->onDropdownToggleCallback) {
             m_comboData->onDropdownToggleCallback(false);
         }
@@ -218,8 +227,9 @@ bool ComboBox::isSearchable() const {
 }
 
 ComboBox& ComboBox::searchText(const std::string& text) {
-    m_comboData->searchText = text;
-    m_comboData->highlightedIndex = 0;
+    bool changed = assign(m_comboData->searchText, text);
+    changed |= assign(m_comboData->highlightedIndex, 0);
+    if (changed) invalidate(DirtyFlags::Paint);
     if (m_comboData->onSearchCallback) {
         m_comboData->onSearchCallback(text);
     }
@@ -232,7 +242,7 @@ const std::string& ComboBox::getSearchText() const {
 
 // Appearance
 ComboBox& ComboBox::placeholder(const std::string& text) {
-    m_comboData->placeholder = text;
+    if (assign(m_comboData->placeholder, text)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -241,7 +251,7 @@ const std::string& ComboBox::getPlaceholder() const {
 }
 
 ComboBox& ComboBox::maxVisibleItems(int count) {
-    m_comboData->maxVisibleItems = count;
+    if (assign(m_comboData->maxVisibleItems, count)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -250,7 +260,7 @@ int ComboBox::getMaxVisibleItems() const {
 }
 
 ComboBox& ComboBox::itemHeight(float height) {
-    m_comboData->itemHeight = height;
+    if (assign(m_comboData->itemHeight, height)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -265,7 +275,7 @@ ComboBox& ComboBox::itemRenderer(ItemRenderer renderer) {
 
 // Colors
 ComboBox& ComboBox::dropdownColor(const Color& color) {
-    m_comboData->dropdownColor = color;
+    if (assign(m_comboData->dropdownColor, color)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -274,7 +284,7 @@ const Color& ComboBox::getDropdownColor() const {
 }
 
 ComboBox& ComboBox::hoverColor(const Color& color) {
-    m_comboData->hoverColor = color;
+    if (assign(m_comboData->hoverColor, color)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -283,7 +293,7 @@ const Color& ComboBox::getHoverColor() const {
 }
 
 ComboBox& ComboBox::selectedColor(const Color& color) {
-    m_comboData->selectedColor = color;
+    if (assign(m_comboData->selectedColor, color)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -316,22 +326,18 @@ void ComboBox::highlightPrevious() {
     auto filtered = getFilteredItems();
     if (filtered.empty()) return;
     
-    if (m_comboData->highlightedIndex <= 0) {
-        m_comboData->highlightedIndex = static_cast<int>(filtered.size()) - 1;
-    } else {
-        m_comboData->highlightedIndex--;
-    }
+    int previous = m_comboData->highlightedIndex <= 0 ? static_cast<int>(filtered.size()) - 1
+                                                      : m_comboData->highlightedIndex - 1;
+    if (assign(m_comboData->highlightedIndex, previous)) invalidate(DirtyFlags::Paint);
 }
 
 void ComboBox::highlightNext() {
     auto filtered = getFilteredItems();
     if (filtered.empty()) return;
     
-    if (m_comboData->highlightedIndex >= static_cast<int>(filtered.size()) - 1) {
-        m_comboData->highlightedIndex = 0;
-    } else {
-        m_comboData->highlightedIndex++;
-    }
+    int next = m_comboData->highlightedIndex >= static_cast<int>(filtered.size()) - 1
+                   ? 0 : m_comboData->highlightedIndex + 1;
+    if (assign(m_comboData->highlightedIndex, next)) invalidate(DirtyFlags::Paint);
 }
 
 void ComboBox::selectHighlighted() {
@@ -4,28 +4,175 @@
  */
 
 #include "KillerGK/widgets/DataGrid.hpp"
+#include "KillerGK/widgets/DataGridStore.hpp"
+#include "KillerGK/widgets/WidgetArena.hpp"
 #include <algorithm>
+#include <array>
 #include <cctype>
 #include <cmath>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace KillerGK {
 
+namespace {
+
+/// Rows per thread below which sorting stays on the calling thread
+constexpr size_t PARALLEL_SORT_MIN_ROWS = 64 * 1024;
+
+/// Appends of at least this many rows are merged into the display order
+/// together instead of being inserted one at a time
+constexpr size_t BULK_APPEND_ROWS = 256;
+
+/**
+ * @brief Sort on several threads when there is enough to sort
+ *
+ * Sorts equal slices concurrently, then merges neighbouring slices pairwise,
+ * each round's merges also running concurrently. The comparison must be a
+ * total order for the result to match a sequential sort.
+ *
+ * @param maxThreads Thread limit, 0 for one per core
+ */
+template<typename T, typename Less>
+void parallelSort(std::vector<T>& items, Less less, size_t maxThreads) {
+    size_t threads = maxThreads ? maxThreads : std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min(threads, items.size() / PARALLEL_SORT_MIN_ROWS);
+    if (threads <= 1) {
+        std::sort(items.begin(), items.end(), less);
+        return;
+    }
+    
+    // A power of two slices keeps the merge rounds balanced
+    size_t slices = 1;
+    while (slices * 2 <= threads) {
+        slices *= 2;
+    }
+    std::vector<size_t> bounds(slices + 1);
+    for (size_t i = 0; i <= slices; ++i) {
+        bounds[i] = items.size() * i / slices;
+    }
+    auto at = [&items](size_t offset) { return items.begin() + static_cast<std::ptrdiff_t>(offset); };
+    
+    auto runAll = [](size_t count, const std::function<void(size_t)>& task) {
+        std::vector<std::thread> workers;
+        workers.reserve(count - 1);
+        for (size_t i = 1; i < count; ++i) {
+            workers.emplace_back(task, i);
+        }
+        task(0);
+        for (auto& thread : workers) {
+            thread.join();
+        }
+    };
+    
+    runAll(slices, [&](size_t i) {
+        std::sort(at(bounds[i]), at(bounds[i + 1]), less);
+    });
+    for (size_t width = 1; width < slices; width *= 2) {
+        runAll(slices / (2 * width), [&](size_t pair) {
+            size_t first = pair * 2 * width;
+            std::inplace_merge(at(bounds[first]), at(bounds[first + width]),
+                               at(bounds[first + 2 * width]), less);
+        });
+    }
+}
+
+/**
+ * @brief Selected row ids in selection order
+ *
+ * Deselecting leaves a gap instead of shifting the ids after it, so it costs
+ * O(1); gaps are closed when the ids are next read, or sooner once they
+ * outnumber the selected ids.
+ */
+class SelectionList {
+public:
+    bool contains(const std::string& id) const { return m_slots.count(id) > 0; }
+    size_t size() const { return m_slots.size(); }
+    
+    /**
+     * @return false if the id was already selected
+     */
+    bool insert(const std::string& id) {
+        if (!m_slots.try_emplace(id, m_ids.size()).second) return false;
+        m_ids.push_back(id);
+        m_live.push_back(1);
+        return true;
+    }
+    
+    /**
+     * @return false if the id was not selected
+     */
+    bool erase(const std::string& id) {
+        auto it = m_slots.find(id);
+        if (it == m_slots.end()) return false;
+        m_live[it->second] = 0;
+        m_slots.erase(it);
+        if (++m_gaps > m_slots.size()) compact();
+        return true;
+    }
+    
+    void clear() {
+        m_ids.clear();
+        m_live.clear();
+        m_slots.clear();
+        m_gaps = 0;
+    }
+    
+    /**
+     * @brief The selected ids in selection order, valid until the next change
+     */
+    const std::vector<std::string>& ids() {
+        if (m_gaps > 0) compact();
+        return m_ids;
+    }
+    
+private:
+    void compact() {
+        size_t kept = 0;
+        for (size_t i = 0; i < m_ids.size(); ++i) {
+            if (!m_live[i]) continue;
+            if (kept != i) {
+                m_ids[kept] = std::move(m_ids[i]);
+                m_slots[m_ids[kept]] = kept;
+            }
+            ++kept;
+        }
+        m_ids.resize(kept);
+        m_live.assign(kept, 1);
+        m_gaps = 0;
+    }
+    
+    std::vector<std::string> m_ids;                  ///< Selection order, gaps included
+    std::vector<uint8_t> m_live;                     ///< Per slot: 0 for a gap
+    std::unordered_map<std::string, size_t> m_slots; ///< Selected id -> slot
+    size_t m_gaps = 0;
+};
+
+} // namespace
+
 // =============================================================================
 // DataGridData - Internal data structure
 // =============================================================================
 
 struct DataGrid::DataGridData {
+    static constexpr size_t NO_ROW = static_cast<size_t>(-1);
+    
     std::vector<DataGridColumn> columns;
-    std::vector<DataGridRow> rows;
+    DataGridStore store;
     std::vector<DataGridFilter> filters;
     
-    // Sorting
-    std::string sortColumnId;
-    SortDirection sortDirection = SortDirection::None;
+    // Sorting: keys in priority order, none with SortDirection::None
+    std::vector<DataGridSortKey> sortOrder;
+    size_t sortThreads = 0;                               ///< 0 = one per core
     
     // Selection
     bool multiSelectEnabled = false;
-    std::vector<std::string> selectedRowIds;
+    SelectionList selection;
     
     // Virtual scrolling
     float rowHeight = 32.0f;
@@ -47,112 +194,1211 @@ struct DataGrid::DataGridData {
     // Callbacks
     std::function<void(const std::string&, SortDirection)> onSortCallback;
     std::function<void(const std::vector<std::string>&)> onSelectionChangeCallback;
+    std::function<void(const DataGridSelectionDelta&)> onSelectionDeltaCallback;
     std::function<void(const DataGridRow&)> onRowDoubleClickCallback;
     std::function<void(const std::string&, float)> onColumnResizeCallback;
     
-    // Cached sorted/filtered data
-    mutable std::vector<size_t> displayedIndices;
-    mutable bool cacheValid = false;
+    // External data source; while set, displayed rows come from it
+    std::shared_ptr<DataGridDataSource> source;
+    size_t prefetchRows = 100;
+    size_t windowFirst = 0;
+    std::vector<DataGridRow> window;                      ///< Fetched rows, from windowFirst on
+    
+    // Row views over the columnar store
+    std::vector<DataGridRow> rowView;                     ///< Materialized by getRows()
+    bool rowViewValid = false;
+    std::unordered_map<size_t, DataGridRow> rowEdits;     ///< Editable rows from getRow(), by index
+    
+    // Row id -> index in the store (first row with that id), rebuilt lazily
+    std::unordered_map<std::string, size_t> rowIndex;
+    bool rowIndexValid = false;
+    
+    // Cached sorted/filtered data. Membership and order are tracked apart so
+    // a sort change only reorders, a narrowed filter only rechecks the rows
+    // still shown, and added or edited rows are placed one at a time.
+    std::vector<size_t> displayedIndices;
+    bool filterValid = false;                 ///< displayedIndices holds the rows passing the filters
+    bool orderValid = false;                  ///< displayedIndices is in display order
+    
+    // Store row -> index in displayedIndices, NO_ROW if hidden. Kept up to
+    // date as single rows move, rebuilt lazily after bulk changes.
+    std::vector<size_t> displayPositions;
+    bool positionsValid = false;
+    std::vector<std::string> refinedFilters;  ///< Columns whose filter narrowed since the last pass
+    
+    // Compiled filter expressions, by the expression they were compiled from
+    std::unordered_map<const DataGridFilterExpr*, DataGridFilterProgram> filterPrograms;
+    
+    // Grouping: counts and aggregates per group of displayed rows, updated as
+    // rows enter and leave the display
+    static constexpr uint32_t NO_GROUP = static_cast<uint32_t>(-1);
+    std::string groupColumnId;
+    std::vector<DataGridAggregate> aggregateSpecs;
+    std::vector<CellValue> collapsedGroups;
+    struct GroupKey {
+        CellKind kind;
+        uint64_t bits;                        ///< Cell payload (string id for text)
+        bool operator==(const GroupKey& other) const { return kind == other.kind && bits == other.bits; }
+    };
+    struct GroupKeyHash {
+        size_t operator()(const GroupKey& key) const {
+            return std::hash<uint64_t>()(key.bits * 8 + static_cast<uint64_t>(key.kind));
+        }
+    };
+    struct AggregateState {
+        double sum = 0.0;
+        size_t count = 0;
+        std::map<double, size_t> values;      ///< Value counts, for Min and Max only
+    };
+    struct GroupState {
+        GroupKey key;
+        size_t rows = 0;
+        std::vector<AggregateState> aggregates;
+    };
+    std::vector<GroupState> groups;
+    std::unordered_map<GroupKey, uint32_t, GroupKeyHash> groupIndex;
+    std::vector<uint32_t> rowGroup;           ///< Per row; NO_GROUP if not displayed
+    bool groupsValid = false;
+    
+    // Grouped display items: a header per group, then its rows unless collapsed
+    struct LayoutEntry {
+        uint32_t group;                       ///< Position in groupOrder
+        size_t row;                           ///< NO_ROW for the header
+    };
+    std::vector<uint32_t> groupOrder;         ///< Non-empty groups in display order
+    std::vector<LayoutEntry> layout;
+    bool layoutValid = false;
+    
+    // Sort key columns: an order-preserving key per row for each sort column
+    struct SortKeyColumn {
+        size_t ordinal = DataGridStore::NO_COLUMN;
+        std::vector<uint64_t> keys;
+        std::vector<uint32_t> ranks;          ///< Per string id, from DataGridStore::rankStrings
+        bool valid = false;
+    };
+    std::vector<SortKeyColumn> sortKeyColumns;  ///< In sort order, for columns rows have
+    
+    // Lowercased cell text for text filters
+    struct ColumnTextCache {
+        std::vector<std::string> text;        ///< Per row, for non-string cells
+        std::vector<uint8_t> valid;
+    };
+    std::vector<std::string> loweredStrings;  ///< Per string id (ids change only when the pool is compacted)
+    std::vector<uint8_t> loweredValid;
+    std::vector<ColumnTextCache> textCaches;  ///< Per column ordinal
     
-    void invalidateCache() { cacheValid = false; }
+    /**
+     * @brief Force the next query to refilter (and so resort) every row
+     */
+    void invalidateCache() {
+        filterValid = false;
+        refinedFilters.clear();
+        invalidateGroups();
+    }
+    
+    /**
+     * @brief Force the next query to reorder the displayed rows
+     */
+    void invalidateOrder() { orderValid = false; }
+    
+    /**
+     * @brief Note that a column's filter now admits a subset of what it did
+     */
+    void refineFilter(const std::string& columnId) {
+        if (filterValid &&
+            std::find(refinedFilters.begin(), refinedFilters.end(), columnId) == refinedFilters.end()) {
+            refinedFilters.push_back(columnId);
+        }
+    }
+    
+    // -------------------------------------------------------------------------
+    // Data change notifications
+    // -------------------------------------------------------------------------
     
-    void updateCache() const {
-        if (cacheValid) return;
+    /**
+     * @brief All rows were replaced or cleared
+     */
+    void rowsReset() {
+        rowViewValid = false;
+        rowIndexValid = false;
+        loweredStrings.clear();
+        loweredValid.clear();
+        textCaches.clear();
+        sortKeyColumns.clear();
+        for (auto& [expression, program] : filterPrograms) {
+            program.reset();
+        }
+        invalidateCache();
+    }
+    
+    /**
+     * @brief Rows from first onwards were appended
+     */
+    void rowsAppended(size_t first) {
+        rowViewValid = false;
+        for (size_t row = first; row < store.rowCount(); ++row) {
+            if (rowIndexValid) {
+                rowIndex.try_emplace(store.rowId(row), row);
+            }
+            updateSortKey(row);
+        }
+        if (!filterValid) return;
         
-        displayedIndices.clear();
+        if (store.rowCount() - first < BULK_APPEND_ROWS) {
+            for (size_t row = first; row < store.rowCount(); ++row) {
+                placeRow(row);
+            }
+            return;
+        }
+        
+        // Many rows: sort the new ones and merge them in one pass
+        positionsValid = false;
+        auto resolved = resolveFilters(nullptr, false);
+        std::vector<size_t> added(store.rowCount() - first);
+        std::iota(added.begin(), added.end(), first);
+        std::vector<uint8_t> mask;
+        bool masked = matchExpressions(nullptr, added.data(), added.size(), mask);
+        
+        size_t middle = displayedIndices.size();
+        for (size_t row = first; row < store.rowCount(); ++row) {
+            if ((masked && !mask[row - first]) || !passesAll(resolved, row)) continue;
+            groupRow(row);
+            displayedIndices.push_back(row);
+        }
+        if (orderValid) {
+            auto before = displayOrder();
+            auto shown = displayedIndices.begin() + static_cast<std::ptrdiff_t>(middle);
+            std::sort(shown, displayedIndices.end(), before);
+            if (shown == displayedIndices.end()) return;
+            // Rows already shown before the first new row stay where they are
+            auto from = std::upper_bound(displayedIndices.begin(), shown, *shown, before);
+            std::inplace_merge(from, shown, displayedIndices.end(), before);
+        }
+    }
+    
+    /**
+     * @brief A row's contents changed in place
+     */
+    void rowChanged(size_t row) {
+        rowViewValid = false;
+        for (auto& cache : textCaches) {
+            if (row < cache.valid.size()) cache.valid[row] = 0;
+        }
+        updateSortKey(row);
+        if (!filterValid) return;
+        
+        size_t from = displayPosition(row);
+        if (from == NO_ROW) {
+            placeRow(row);
+            return;
+        }
+        if (!passesFilters(row)) {
+            displayedIndices.erase(displayedIndices.begin() + static_cast<std::ptrdiff_t>(from));
+            displayPositions[row] = NO_ROW;
+            notePositions(from, displayedIndices.size());
+            return;
+        }
+        
+        groupRow(row);
+        if (!orderValid) return;  // Ordered on the next query
+        
+        // Still shown: rotate it to its new place, shifting the rows between
+        auto order = displayOrder();
+        auto at = displayedIndices.begin() + static_cast<std::ptrdiff_t>(from);
+        if (at != displayedIndices.begin() && order(row, *(at - 1))) {
+            auto to = std::lower_bound(displayedIndices.begin(), at, row, order);
+            std::rotate(to, at, at + 1);
+            notePositions(static_cast<size_t>(to - displayedIndices.begin()), from + 1);
+        } else if (at + 1 != displayedIndices.end() && order(*(at + 1), row)) {
+            auto to = std::lower_bound(at + 1, displayedIndices.end(), row, order);
+            std::rotate(at, at + 1, to);
+            notePositions(from, static_cast<size_t>(to - displayedIndices.begin()));
+        }
+    }
+    
+    /**
+     * @brief Rows were removed
+     * @param removed Indices before removal, ascending
+     */
+    void rowsRemoved(const std::vector<size_t>& removed) {
+        if (removed.empty()) return;
+        
+        rowViewValid = false;
+        rowIndexValid = false;
+        textCaches.clear();
+        
+        auto isRemoved = [&removed](size_t row) {
+            return std::binary_search(removed.begin(), removed.end(), row);
+        };
+        auto shifted = [&removed](size_t row) {
+            return row - static_cast<size_t>(
+                std::lower_bound(removed.begin(), removed.end(), row) - removed.begin());
+        };
+        
+        for (auto& keys : sortKeyColumns) {
+            if (!keys.valid) continue;
+            size_t kept = 0;
+            for (size_t row = 0; row < keys.keys.size(); ++row) {
+                if (!isRemoved(row)) keys.keys[kept++] = keys.keys[row];
+            }
+            keys.keys.resize(kept);
+        }
+        
+        if (groupsValid) {
+            size_t kept = 0;
+            for (size_t row = 0; row < rowGroup.size(); ++row) {
+                if (!isRemoved(row)) rowGroup[kept++] = rowGroup[row];
+            }
+            rowGroup.resize(kept);
+            layoutValid = false;
+        }
+        
+        if (filterValid) {
+            positionsValid = false;
+            displayedIndices.erase(
+                std::remove_if(displayedIndices.begin(), displayedIndices.end(), isRemoved),
+                displayedIndices.end());
+            for (auto& row : displayedIndices) {
+                row = shifted(row);
+            }
+        }
+    }
+    
+    /**
+     * @brief Drop overwritten and removed text from the store once enough has built up
+     *
+     * Compacting renumbers the strings, so everything keyed by string id is
+     * rebuilt; which rows are shown, and their order, stay as they are.
+     */
+    void compactStrings() {
+        if (!store.compactStrings()) return;
+        
+        loweredStrings.clear();
+        loweredValid.clear();
+        for (auto& keys : sortKeyColumns) {
+            keys.valid = false;
+        }
+        for (auto& [expression, program] : filterPrograms) {
+            program.reset();
+        }
+        invalidateGroups();
+    }
+    
+    /**
+     * @brief Write edits made through getRow() pointers back to the store
+     *
+     * Each edit is applied once and then dropped, which ends the life of the
+     * pointers getRow() handed out.
+     */
+    void applyRowEdits() {
+        if (rowEdits.empty()) return;
+        
+        auto edits = std::move(rowEdits);
+        rowEdits.clear();
+        rowViewValid = false;
+        for (const auto& [index, row] : edits) {
+            if (row.id != store.rowId(index)) {
+                rowIndexValid = false;
+            }
+            bool grouped = groupsValid && index < rowGroup.size() && rowGroup[index] != NO_GROUP;
+            ungroupRow(index);
+            if (store.replace(index, row)) {
+                rowChanged(index);
+            } else if (grouped) {
+                groupRow(index);
+            }
+        }
+        compactStrings();
+    }
+    
+    size_t findRow(const std::string& id) {
+        if (!rowIndexValid) {
+            rowIndex.clear();
+            rowIndex.reserve(store.rowCount());
+            for (size_t i = 0; i < store.rowCount(); ++i) {
+                rowIndex.try_emplace(store.rowId(i), i);
+            }
+            rowIndexValid = true;
+        }
+        auto it = rowIndex.find(id);
+        return it != rowIndex.end() ? it->second : NO_ROW;
+    }
+    
+    /**
+     * @brief A store row's index in displayedIndices, NO_ROW if it is hidden
+     *
+     * Only meaningful while filterValid.
+     */
+    size_t displayPosition(size_t row) {
+        if (!positionsValid) {
+            displayPositions.assign(store.rowCount(), NO_ROW);
+            positionsValid = true;
+            notePositions(0, displayedIndices.size());
+        }
+        return row < displayPositions.size() ? displayPositions[row] : NO_ROW;
+    }
+    
+    /**
+     * @brief Record the positions of displayedIndices[first, last) after they moved
+     */
+    void notePositions(size_t first, size_t last) {
+        if (!positionsValid) return;
+        if (displayPositions.size() < store.rowCount()) {
+            displayPositions.resize(store.rowCount(), NO_ROW);
+        }
+        for (size_t i = first; i < last; ++i) {
+            displayPositions[displayedIndices[i]] = i;
+        }
+    }
+    
+    const std::vector<DataGridRow>& materializeRows() {
+        applyRowEdits();
+        if (!rowViewValid) {
+            rowView.clear();
+            rowView.reserve(store.rowCount());
+            for (size_t i = 0; i < store.rowCount(); ++i) {
+                rowView.push_back(store.makeRow(i));
+            }
+            rowViewValid = true;
+        }
+        return rowView;
+    }
+    
+    // -------------------------------------------------------------------------
+    // Selection
+    // -------------------------------------------------------------------------
+    
+    /**
+     * @brief Set one row's selected flag in the store and in its views
+     */
+    void setSelectedFlag(const std::string& id, bool selected) {
+        if (source) {
+            for (auto& row : window) {
+                if (row.id == id) row.selected = selected;
+            }
+            return;
+        }
+        
+        size_t index = findRow(id);
+        if (index == NO_ROW) return;
+        
+        store.setSelected(index, selected);
+        if (auto edit = rowEdits.find(index); edit != rowEdits.end()) {
+            edit->second.selected = selected;
+        }
+        if (rowViewValid) {
+            rowView[index].selected = selected;
+        }
+    }
+    
+    void addSelection(const std::string& id, DataGridSelectionDelta& delta) {
+        if (!selection.insert(id)) return;
+        setSelectedFlag(id, true);
+        delta.added.push_back(id);
+    }
+    
+    /**
+     * @brief Deselect every row for which keep() is false
+     */
+    template<typename Keep>
+    void removeSelections(Keep keep, DataGridSelectionDelta& delta) {
+        size_t first = delta.removed.size();
+        for (const auto& id : selection.ids()) {
+            if (!keep(id)) delta.removed.push_back(id);
+        }
+        for (size_t i = first; i < delta.removed.size(); ++i) {
+            selection.erase(delta.removed[i]);
+            setSelectedFlag(delta.removed[i], false);
+        }
+    }
+    
+    /**
+     * @brief Report a selection change to the callbacks
+     * @return true if any row's selection changed
+     */
+    bool notifySelection(const DataGridSelectionDelta& delta) {
+        if (onSelectionChangeCallback) {
+            onSelectionChangeCallback(selection.ids());
+        }
+        bool changed = !delta.added.empty() || !delta.removed.empty();
+        if (onSelectionDeltaCallback && changed) {
+            onSelectionDeltaCallback(delta);
+        }
+        return changed;
+    }
+    
+    // -------------------------------------------------------------------------
+    // Data source window
+    // -------------------------------------------------------------------------
+    
+    size_t displayedCount() {
+        if (source) return source->rowCount();
+        updateCache();
+        return displayedIndices.size();
+    }
+    
+    void dropWindow() {
+        window.clear();
+        window.shrink_to_fit();
+        windowFirst = 0;
+    }
+    
+    /**
+     * @brief Pass the sort and filters to the source and drop stale rows
+     */
+    void sendQuery() {
+        if (!source) return;
+        dropWindow();
+        source->setQuery(DataGridQuery{sortOrder, filters});
+    }
+    
+    void markSelected(std::vector<DataGridRow>& rows) const {
+        for (auto& row : rows) {
+            row.selected = selection.contains(row.id);
+        }
+    }
+    
+    /**
+     * @brief Make sure a range is fetched, with prefetchRows either side
+     *
+     * The range must lie within the source's row count.
+     */
+    void ensureWindow(size_t first, size_t count) {
+        if (first >= windowFirst && first + count <= windowFirst + window.size()) return;
         
-        // Apply filters
-        for (size_t i = 0; i < rows.size(); ++i) {
-            bool passesAllFilters = true;
+        size_t begin = first > prefetchRows ? first - prefetchRows : 0;
+        size_t end = std::min(source->rowCount(), first + count + prefetchRows);
+        window = source->fetchRows(begin, end - begin);
+        windowFirst = begin;
+        markSelected(window);
+    }
+    
+    std::vector<DataGridRow> displayedRange(size_t first, size_t count) {
+        size_t total = displayedCount();
+        if (first >= total) return {};
+        count = std::min(count, total - first);
+        
+        if (source) {
+            ensureWindow(first, count);
+            size_t offset = std::min(first - windowFirst, window.size());
+            size_t available = std::min(count, window.size() - offset);
+            return {window.begin() + static_cast<std::ptrdiff_t>(offset),
+                    window.begin() + static_cast<std::ptrdiff_t>(offset + available)};
+        }
+        
+        std::vector<DataGridRow> result;
+        result.reserve(count);
+        for (size_t i = first; i < first + count; ++i) {
+            result.push_back(store.makeRow(displayedIndices[i]));
+        }
+        return result;
+    }
+    
+    void updateCache() {
+        applyRowEdits();
+        
+        if (!filterValid) {
+            applyFilters();
+            filterValid = true;
+            orderValid = false;
+            refinedFilters.clear();
+        } else if (!refinedFilters.empty()) {
+            refineFilters();
+            refinedFilters.clear();
+        }
+        
+        if (!orderValid) {
+            applyOrder();
+            orderValid = true;
+            layoutValid = false;
+        }
+        
+        if (isGrouped() && !groupsValid) {
+            rebuildGroups();
+        }
+    }
+    
+    // -------------------------------------------------------------------------
+    // Filtering
+    // -------------------------------------------------------------------------
+    
+    /**
+     * @brief A filter bound to its column ordinal
+     */
+    struct ResolvedFilter {
+        const DataGridFilter* filter;
+        size_t ordinal;
+        std::string needle;                 ///< Lowercased filter text
+        std::vector<int8_t> stringMatches;  ///< Per string id during a pass: -1 unknown, 0 no, 1 yes
+    };
+    
+    static std::string toLower(std::string text) {
+        std::transform(text.begin(), text.end(), text.begin(),
+            [](unsigned char c) { return std::tolower(c); });
+        return text;
+    }
+    
+    /**
+     * @brief Resolve filters to column ordinals
+     * @param only Restrict to these columns (nullptr for all)
+     * @param forPass Allocate per-string memo tables for a pass over many rows
+     */
+    std::vector<ResolvedFilter> resolveFilters(const std::vector<std::string>* only, bool forPass) const {
+        std::vector<ResolvedFilter> resolved;
+        for (const auto& filter : filters) {
+            if (only && std::find(only->begin(), only->end(), filter.columnId) == only->end()) continue;
+            if (!filter.customFilter && filter.filterText.empty()) continue;
             
-            for (const auto& filter : filters) {
-                auto cellIt = rows[i].cells.find(filter.columnId);
-                if (cellIt == rows[i].cells.end()) continue;
-                
-                if (filter.customFilter) {
-                    if (!filter.customFilter(cellIt->second)) {
-                        passesAllFilters = false;
-                        break;
-                    }
-                } else if (!filter.filterText.empty()) {
-                    // Text filter - case insensitive contains
-                    std::string cellText;
-                    if (std::holds_alternative<std::string>(cellIt->second)) {
-                        cellText = std::get<std::string>(cellIt->second);
-                    } else if (std::holds_alternative<double>(cellIt->second)) {
-                        cellText = std::to_string(std::get<double>(cellIt->second));
-                    } else if (std::holds_alternative<int64_t>(cellIt->second)) {
-                        cellText = std::to_string(std::get<int64_t>(cellIt->second));
-                    } else if (std::holds_alternative<bool>(cellIt->second)) {
-                        cellText = std::get<bool>(cellIt->second) ? "true" : "false";
-                    }
-                    
-                    std::string filterLower = filter.filterText;
-                    std::transform(filterLower.begin(), filterLower.end(), filterLower.begin(),
-                        [](unsigned char c) { return std::tolower(c); });
-                    std::transform(cellText.begin(), cellText.end(), cellText.begin(),
-                        [](unsigned char c) { return std::tolower(c); });
-                    
-                    if (cellText.find(filterLower) == std::string::npos) {
-                        passesAllFilters = false;
-                        break;
-                    }
+            size_t ordinal = store.findColumn(filter.columnId);
+            if (ordinal == DataGridStore::NO_COLUMN) continue;  // No row has this cell
+            
+            ResolvedFilter entry{&filter, ordinal, {}, {}};
+            if (!filter.customFilter) {
+                entry.needle = toLower(filter.filterText);
+                if (forPass) {
+                    entry.stringMatches.assign(store.strings().size(), -1);
                 }
             }
+            resolved.push_back(std::move(entry));
+        }
+        return resolved;
+    }
+    
+    /**
+     * @brief Lowercased text of a cell, computed once and cached
+     */
+    const std::string& lowerText(size_t row, size_t ordinal) {
+        const auto& column = store.column(ordinal);
+        
+        if (column.kinds[row] == CellKind::String) {
+            uint32_t id = column.stringId(row);
+            if (loweredValid.size() <= id) {
+                loweredStrings.resize(store.strings().size());
+                loweredValid.resize(store.strings().size(), 0);
+            }
+            if (!loweredValid[id]) {
+                loweredStrings[id] = toLower(store.strings().get(id));
+                loweredValid[id] = 1;
+            }
+            return loweredStrings[id];
+        }
+        
+        if (textCaches.size() <= ordinal) {
+            textCaches.resize(ordinal + 1);
+        }
+        auto& cache = textCaches[ordinal];
+        if (cache.valid.size() < store.rowCount()) {
+            cache.text.resize(store.rowCount());
+            cache.valid.resize(store.rowCount(), 0);
+        }
+        if (!cache.valid[row]) {
+            std::string text;
+            switch (column.kinds[row]) {
+                case CellKind::Number: text = std::to_string(column.number(row)); break;
+                case CellKind::Integer: text = std::to_string(column.integer(row)); break;
+                case CellKind::Boolean: text = column.boolean(row) ? "true" : "false"; break;
+                default: break;
+            }
+            cache.text[row] = toLower(std::move(text));
+            cache.valid[row] = 1;
+        }
+        return cache.text[row];
+    }
+    
+    bool passes(ResolvedFilter& entry, size_t row) {
+        if (store.kind(row, entry.ordinal) == CellKind::Empty) {
+            return true;  // Filters ignore rows without the cell
+        }
+        if (entry.filter->customFilter) {
+            return entry.filter->customFilter(store.getCell(row, entry.ordinal));
+        }
+        
+        // Each distinct string is searched once per pass
+        const auto& column = store.column(entry.ordinal);
+        if (!entry.stringMatches.empty() && column.kinds[row] == CellKind::String) {
+            int8_t& match = entry.stringMatches[column.stringId(row)];
+            if (match < 0) {
+                match = lowerText(row, entry.ordinal).find(entry.needle) != std::string::npos ? 1 : 0;
+            }
+            return match != 0;
+        }
+        return lowerText(row, entry.ordinal).find(entry.needle) != std::string::npos;
+    }
+    
+    bool passesAll(std::vector<ResolvedFilter>& resolved, size_t row) {
+        for (auto& entry : resolved) {
+            if (!passes(entry, row)) return false;
+        }
+        return true;
+    }
+    
+    DataGridFilterProgram& program(const DataGridFilter& filter) {
+        auto it = filterPrograms.find(filter.expression.get());
+        if (it == filterPrograms.end()) {
+            it = filterPrograms.emplace(filter.expression.get(), DataGridFilterProgram(*filter.expression)).first;
+        }
+        return it->second;
+    }
+    
+    /**
+     * @brief Test many rows against the expression filters, a column at a time
+     * @param only Restrict to these filters (nullptr for all)
+     * @param mask Set to 1 per row passing them all
+     * @return false if there were no expression filters to test
+     */
+    bool matchExpressions(const std::vector<std::string>* only, const size_t* rows, size_t count,
+                          std::vector<uint8_t>& mask) {
+        bool tested = false;
+        std::vector<uint8_t> results;
+        for (const auto& filter : filters) {
+            if (!filter.expression) continue;
+            if (only && std::find(only->begin(), only->end(), filter.columnId) == only->end()) continue;
             
-            if (passesAllFilters) {
+            if (!tested) {
+                mask.resize(count);
+                program(filter).evaluate(store, rows, count, mask.data());
+                tested = true;
+                continue;
+            }
+            results.resize(count);
+            program(filter).evaluate(store, rows, count, results.data());
+            for (size_t i = 0; i < count; ++i) {
+                mask[i] &= results[i];
+            }
+        }
+        return tested;
+    }
+    
+    bool passesExpressions(size_t row) {
+        for (const auto& filter : filters) {
+            if (filter.expression && !program(filter).matches(store, row)) return false;
+        }
+        return true;
+    }
+    
+    /**
+     * @brief Remove the filter set under a name
+     * @return true if there was one
+     */
+    bool eraseFilter(const std::string& name) {
+        auto it = std::find_if(filters.begin(), filters.end(),
+            [&name](const DataGridFilter& f) { return f.columnId == name; });
+        if (it == filters.end()) return false;
+        
+        if (it->expression) {
+            filterPrograms.erase(it->expression.get());
+        }
+        filters.erase(it);
+        return true;
+    }
+    
+    void applyFilters() {
+        positionsValid = false;
+        displayedIndices.clear();
+        displayedIndices.reserve(store.rowCount());
+        
+        auto resolved = resolveFilters(nullptr, true);
+        std::vector<uint8_t> mask;
+        bool masked = matchExpressions(nullptr, nullptr, store.rowCount(), mask);
+        for (size_t i = 0; i < store.rowCount(); ++i) {
+            if ((!masked || mask[i]) && passesAll(resolved, i)) {
                 displayedIndices.push_back(i);
             }
         }
+    }
+    
+    /**
+     * @brief Recheck only the shown rows against filters that narrowed
+     *
+     * Rows hidden before stay hidden, and removing rows keeps the order.
+     */
+    void refineFilters() {
+        auto resolved = resolveFilters(&refinedFilters, true);
+        std::vector<uint8_t> mask;
+        bool masked = matchExpressions(&refinedFilters, displayedIndices.data(), displayedIndices.size(), mask);
+        if (resolved.empty() && !masked) return;
+        
+        positionsValid = false;
+        size_t kept = 0;
+        for (size_t i = 0; i < displayedIndices.size(); ++i) {
+            size_t row = displayedIndices[i];
+            if ((!masked || mask[i]) && passesAll(resolved, row)) {
+                displayedIndices[kept++] = row;
+            } else {
+                ungroupRow(row);
+            }
+        }
+        displayedIndices.resize(kept);
+    }
+    
+    /**
+     * @brief Add a row to the displayed rows if it passes the filters
+     */
+    void placeRow(size_t row) {
+        if (!passesFilters(row)) return;
+        groupRow(row);
+        
+        if (!orderValid) {
+            displayedIndices.push_back(row);  // Ordered on the next query
+            notePositions(displayedIndices.size() - 1, displayedIndices.size());
+            return;
+        }
+        auto position = std::lower_bound(displayedIndices.begin(), displayedIndices.end(), row, displayOrder());
+        position = displayedIndices.insert(position, row);
+        notePositions(static_cast<size_t>(position - displayedIndices.begin()), displayedIndices.size());
+    }
+    
+    bool passesFilters(size_t row) {
+        auto resolved = resolveFilters(nullptr, false);
+        return passesAll(resolved, row) && passesExpressions(row);
+    }
+    
+    // -------------------------------------------------------------------------
+    // Sorting
+    // -------------------------------------------------------------------------
+    
+    /**
+     * @brief Order-preserving 64-bit key of a non-string cell
+     */
+    static uint64_t valueKey(CellKind kind, uint64_t bits) {
+        constexpr uint64_t SIGN_BIT = uint64_t(1) << 63;
+        switch (kind) {
+            case CellKind::Number: return (bits & SIGN_BIT) ? ~bits : (bits | SIGN_BIT);
+            case CellKind::Integer: return bits ^ SIGN_BIT;
+            case CellKind::Boolean: return bits;
+            default: return 0;
+        }
+    }
+    
+    /**
+     * @brief Build a sort key column: string ranks or value keys per row
+     */
+    void buildSortKeys(SortKeyColumn& keys, size_t ordinal) {
+        const auto& column = store.column(ordinal);
+        keys.ordinal = ordinal;
+        keys.ranks = store.rankStrings(ordinal);
+        keys.keys.resize(store.rowCount());
+        for (size_t row = 0; row < store.rowCount(); ++row) {
+            keys.keys[row] = column.kinds[row] == CellKind::String
+                ? keys.ranks[column.stringId(row)]
+                : valueKey(column.kinds[row], column.payload[row]);
+        }
+        keys.valid = true;
+    }
+    
+    /**
+     * @brief Keep the sort key columns current for one row
+     *
+     * A string a ranking has not seen has no key yet; that column is then
+     * rebuilt on the next full sort.
+     */
+    void updateSortKey(size_t row) {
+        for (auto& keys : sortKeyColumns) {
+            if (!keys.valid) continue;
+            
+            const auto& column = store.column(keys.ordinal);
+            if (keys.keys.size() <= row) {
+                keys.keys.resize(row + 1);
+            }
+            if (column.kinds[row] == CellKind::String) {
+                uint32_t id = column.stringId(row);
+                if (id >= keys.ranks.size() || keys.ranks[id] == DataGridStore::UNRANKED) {
+                    keys.valid = false;
+                    continue;
+                }
+                keys.keys[row] = keys.ranks[id];
+            } else {
+                keys.keys[row] = valueKey(column.kinds[row], column.payload[row]);
+            }
+        }
+    }
+    
+    /**
+     * @brief Compare two rows' sort cells: kind first, then value
+     */
+    int compareCells(size_t a, size_t b, size_t ordinal) const {
+        const auto& column = store.column(ordinal);
+        CellKind kindA = column.kinds[a];
+        CellKind kindB = column.kinds[b];
+        if (kindA != kindB) return kindA < kindB ? -1 : 1;
+        
+        if (kindA == CellKind::String) {
+            return store.strings().get(column.stringId(a)).compare(store.strings().get(column.stringId(b)));
+        }
+        uint64_t keyA = valueKey(kindA, column.payload[a]);
+        uint64_t keyB = valueKey(kindB, column.payload[b]);
+        return keyA < keyB ? -1 : (keyA > keyB ? 1 : 0);
+    }
+    
+    /**
+     * @brief Display order: by each sort key in turn, then row order (stable)
+     *
+     * A less-than comparator with the sort columns looked up once.
+     */
+    struct DisplayOrder {
+        const DataGridData* grid;
+        std::vector<std::pair<size_t, bool>> keys;  ///< (ordinal, ascending)
+        
+        bool operator()(size_t a, size_t b) const {
+            for (auto [ordinal, ascending] : keys) {
+                int order = grid->compareCells(a, b, ordinal);
+                if (order != 0) {
+                    return ascending ? order < 0 : order > 0;
+                }
+            }
+            return a < b;
+        }
+    };
+    
+    DisplayOrder displayOrder() const {
+        DisplayOrder order{this, {}};
+        for (const auto& key : sortOrder) {
+            size_t ordinal = store.findColumn(key.columnId);
+            if (ordinal == DataGridStore::NO_COLUMN) continue;  // Every row compares equal
+            order.keys.emplace_back(ordinal, key.direction == SortDirection::Ascending);
+        }
+        return order;
+    }
+    
+    /**
+     * @brief A sort key column with its direction, ready to sort with
+     */
+    struct ActiveSortKey {
+        const SortKeyColumn* keys;
+        const std::vector<CellKind>* kinds;
+        uint64_t flip;                      ///< All ones for descending, else zero
+    };
+    
+    /**
+     * @brief Resolve the sort order to key columns, building stale ones
+     */
+    std::vector<ActiveSortKey> activeSortKeys() {
+        // Keep key columns still in use, in sort order
+        std::vector<SortKeyColumn> previous = std::move(sortKeyColumns);
+        sortKeyColumns.clear();
+        sortKeyColumns.reserve(sortOrder.size());
+        
+        std::vector<std::pair<size_t, SortDirection>> resolved;
+        for (const auto& key : sortOrder) {
+            size_t ordinal = store.findColumn(key.columnId);
+            if (ordinal == DataGridStore::NO_COLUMN) continue;
+            
+            auto reuse = std::find_if(previous.begin(), previous.end(),
+                [ordinal](const SortKeyColumn& keys) { return keys.ordinal == ordinal; });
+            SortKeyColumn keys;
+            if (reuse != previous.end()) {
+                keys = std::move(*reuse);
+                reuse->ordinal = DataGridStore::NO_COLUMN;
+            }
+            if (!keys.valid || keys.keys.size() != store.rowCount()) {
+                buildSortKeys(keys, ordinal);
+            }
+            sortKeyColumns.push_back(std::move(keys));
+            resolved.emplace_back(ordinal, key.direction);
+        }
+        
+        std::vector<ActiveSortKey> active;
+        for (size_t i = 0; i < resolved.size(); ++i) {
+            uint64_t flip = resolved[i].second == SortDirection::Descending ? ~uint64_t(0) : 0;
+            active.push_back({&sortKeyColumns[i], &store.column(resolved[i].first).kinds, flip});
+        }
+        return active;
+    }
+    
+    /**
+     * @brief Sort displayed rows on packed keys for a fixed number of columns
+     *
+     * Each entry holds (kind, key) per column, inverted for descending
+     * columns, then the row index, so a plain lexicographic compare of the
+     * words gives the display order and keeps the sort stable.
+     */
+    template<size_t Columns>
+    void sortPacked(const std::vector<ActiveSortKey>& active) {
+        struct Entry {
+            std::array<uint64_t, 2 * Columns + 1> words;
+        };
+        std::vector<Entry> entries(displayedIndices.size());
+        for (size_t i = 0; i < displayedIndices.size(); ++i) {
+            size_t row = displayedIndices[i];
+            auto& words = entries[i].words;
+            for (size_t c = 0; c < Columns; ++c) {
+                const auto& key = active[c];
+                words[2 * c] = static_cast<uint64_t>((*key.kinds)[row]) ^ key.flip;
+                words[2 * c + 1] = key.keys->keys[row] ^ key.flip;
+            }
+            words[2 * Columns] = row;
+        }
         
-        // Apply sorting
-        if (!sortColumnId.empty() && sortDirection != SortDirection::None) {
-            std::sort(displayedIndices.begin(), displayedIndices.end(),
-                [this](size_t a, size_t b) {
-                    const auto& rowA = rows[a];
-                    const auto& rowB = rows[b];
-                    
-                    auto cellItA = rowA.cells.find(sortColumnId);
-                    auto cellItB = rowB.cells.find(sortColumnId);
-                    
-                    if (cellItA == rowA.cells.end() && cellItB == rowB.cells.end()) return false;
-                    if (cellItA == rowA.cells.end()) return sortDirection == SortDirection::Ascending;
-                    if (cellItB == rowB.cells.end()) return sortDirection == SortDirection::Descending;
-                    
-                    const auto& valA = cellItA->second;
-                    const auto& valB = cellItB->second;
-                    
-                    // For descending order, we swap the comparison operands instead of negating the result
-                    // This maintains strict weak ordering (returns false when a == b)
-                    if (sortDirection == SortDirection::Descending) {
-                        // Swap: compare B < A for descending
-                        if (std::holds_alternative<std::string>(valA) && std::holds_alternative<std::string>(valB)) {
-                            return std::get<std::string>(valB) < std::get<std::string>(valA);
-                        } else if (std::holds_alternative<double>(valA) && std::holds_alternative<double>(valB)) {
-                            return std::get<double>(valB) < std::get<double>(valA);
-                        } else if (std::holds_alternative<int64_t>(valA) && std::holds_alternative<int64_t>(valB)) {
-                            return std::get<int64_t>(valB) < std::get<int64_t>(valA);
-                        } else if (std::holds_alternative<bool>(valA) && std::holds_alternative<bool>(valB)) {
-                            return !std::get<bool>(valB) && std::get<bool>(valA);
-                        }
-                    } else {
-                        // Ascending: compare A < B
-                        if (std::holds_alternative<std::string>(valA) && std::holds_alternative<std::string>(valB)) {
-                            return std::get<std::string>(valA) < std::get<std::string>(valB);
-                        } else if (std::holds_alternative<double>(valA) && std::holds_alternative<double>(valB)) {
-                            return std::get<double>(valA) < std::get<double>(valB);
-                        } else if (std::holds_alternative<int64_t>(valA) && std::holds_alternative<int64_t>(valB)) {
-                            return std::get<int64_t>(valA) < std::get<int64_t>(valB);
-                        } else if (std::holds_alternative<bool>(valA) && std::holds_alternative<bool>(valB)) {
-                            return !std::get<bool>(valA) && std::get<bool>(valB);
-                        }
-                    }
-                    
-                    return false;
-                });
-        }
-        
-        cacheValid = true;
+        parallelSort(entries, [](const Entry& a, const Entry& b) { return a.words < b.words; }, sortThreads);
+        
+        for (size_t i = 0; i < entries.size(); ++i) {
+            displayedIndices[i] = static_cast<size_t>(entries[i].words[2 * Columns]);
+        }
+    }
+    
+    void applyOrder() {
+        positionsValid = false;
+        auto active = activeSortKeys();
+        
+        switch (active.size()) {
+            case 0:
+                // Unsorted, or no row has any sort column: row order
+                if (!std::is_sorted(displayedIndices.begin(), displayedIndices.end())) {
+                    std::sort(displayedIndices.begin(), displayedIndices.end());
+                }
+                return;
+            case 1: sortPacked<1>(active); return;
+            case 2: sortPacked<2>(active); return;
+            case 3: sortPacked<3>(active); return;
+            case 4: sortPacked<4>(active); return;
+            default: break;
+        }
+        
+        // Many sort columns: compare key columns in place
+        parallelSort(displayedIndices, [&active](size_t a, size_t b) {
+            for (const auto& key : active) {
+                uint64_t kindA = static_cast<uint64_t>((*key.kinds)[a]) ^ key.flip;
+                uint64_t kindB = static_cast<uint64_t>((*key.kinds)[b]) ^ key.flip;
+                if (kindA != kindB) return kindA < kindB;
+                uint64_t valueA = key.keys->keys[a] ^ key.flip;
+                uint64_t valueB = key.keys->keys[b] ^ key.flip;
+                if (valueA != valueB) return valueA < valueB;
+            }
+            return a < b;
+        }, sortThreads);
+    }
+    
+    // -------------------------------------------------------------------------
+    // Grouping
+    // -------------------------------------------------------------------------
+    
+    bool isGrouped() const { return !groupColumnId.empty() && !source; }
+    
+    void invalidateGroups() {
+        groupsValid = false;
+        layoutValid = false;
+    }
+    
+    GroupKey groupKeyOf(size_t row) const {
+        size_t ordinal = store.findColumn(groupColumnId);
+        if (ordinal == DataGridStore::NO_COLUMN) return {CellKind::Empty, 0};
+        const auto& column = store.column(ordinal);
+        return {column.kinds[row], column.payload[row]};
+    }
+    
+    CellValue groupValue(const GroupKey& key) const {
+        switch (key.kind) {
+            case CellKind::String: return store.strings().get(static_cast<uint32_t>(key.bits));
+            case CellKind::Integer: return static_cast<int64_t>(key.bits);
+            case CellKind::Boolean: return key.bits != 0;
+            case CellKind::Number: {
+                double value;
+                std::memcpy(&value, &key.bits, sizeof(value));
+                return value;
+            }
+            case CellKind::Empty: break;
+        }
+        return CellValue{std::string{}};
+    }
+    
+    /**
+     * @brief A row's value for an aggregate, if the cell is numeric
+     */
+    bool aggregateInput(size_t aggregate, size_t row, double& value) const {
+        size_t ordinal = store.findColumn(aggregateSpecs[aggregate].columnId);
+        if (ordinal == DataGridStore::NO_COLUMN) return false;
+        
+        const auto& column = store.column(ordinal);
+        switch (column.kinds[row]) {
+            case CellKind::Number: value = column.number(row); break;
+            case CellKind::Integer: value = static_cast<double>(column.integer(row)); break;
+            case CellKind::Boolean: value = column.boolean(row) ? 1.0 : 0.0; break;
+            default: return false;
+        }
+        return !std::isnan(value);
+    }
+    
+    static bool tracksValues(AggregateFunction function) {
+        return function == AggregateFunction::Min || function == AggregateFunction::Max;
+    }
+    
+    /**
+     * @brief Add a displayed row to its group
+     */
+    void groupRow(size_t row) {
+        if (!groupsValid) return;
+        
+        GroupKey key = groupKeyOf(row);
+        auto [it, inserted] = groupIndex.try_emplace(key, static_cast<uint32_t>(groups.size()));
+        if (inserted) {
+            groups.push_back(GroupState{key, 0, std::vector<AggregateState>(aggregateSpecs.size())});
+        }
+        
+        auto& group = groups[it->second];
+        group.rows++;
+        for (size_t a = 0; a < aggregateSpecs.size(); ++a) {
+            double value;
+            if (!aggregateInput(a, row, value)) continue;
+            auto& state = group.aggregates[a];
+            state.sum += value;
+            state.count++;
+            if (tracksValues(aggregateSpecs[a].function)) {
+                state.values[value]++;
+            }
+        }
+        
+        if (rowGroup.size() <= row) {
+            rowGroup.resize(store.rowCount(), NO_GROUP);
+        }
+        rowGroup[row] = it->second;
+        layoutValid = false;
+    }
+    
+    /**
+     * @brief Take a row out of its group
+     *
+     * Must run while the row still holds the values it was grouped with,
+     * i.e. before it is edited or removed.
+     */
+    void ungroupRow(size_t row) {
+        if (!groupsValid || row >= rowGroup.size() || rowGroup[row] == NO_GROUP) return;
+        
+        auto& group = groups[rowGroup[row]];
+        group.rows--;
+        for (size_t a = 0; a < aggregateSpecs.size(); ++a) {
+            double value;
+            if (!aggregateInput(a, row, value)) continue;
+            auto& state = group.aggregates[a];
+            state.count--;
+            state.sum = state.count ? state.sum - value : 0.0;  // Drop rounding drift when empty
+            if (tracksValues(aggregateSpecs[a].function)) {
+                auto it = state.values.find(value);
+                if (it != state.values.end() && --it->second == 0) {
+                    state.values.erase(it);
+                }
+            }
+        }
+        
+        rowGroup[row] = NO_GROUP;
+        layoutValid = false;
+    }
+    
+    void rebuildGroups() {
+        groups.clear();
+        groupIndex.clear();
+        rowGroup.assign(store.rowCount(), NO_GROUP);
+        groupsValid = true;
+        layoutValid = false;
+        for (size_t row : displayedIndices) {
+            groupRow(row);
+        }
+    }
+    
+    bool isCollapsed(const CellValue& value) const {
+        return std::find(collapsedGroups.begin(), collapsedGroups.end(), value) != collapsedGroups.end();
+    }
+    
+    /**
+     * @brief List the non-empty groups in display order
+     */
+    void orderGroups() {
+        groupOrder.clear();
+        for (uint32_t g = 0; g < groups.size(); ++g) {
+            if (groups[g].rows > 0) groupOrder.push_back(g);
+        }
+        
+        // Groups follow the group column's sort direction, if it is sorted
+        bool descending = std::any_of(sortOrder.begin(), sortOrder.end(), [this](const DataGridSortKey& key) {
+            return key.columnId == groupColumnId && key.direction == SortDirection::Descending;
+        });
+        std::sort(groupOrder.begin(), groupOrder.end(), [&](uint32_t a, uint32_t b) {
+            const GroupKey& keyA = descending ? groups[b].key : groups[a].key;
+            const GroupKey& keyB = descending ? groups[a].key : groups[b].key;
+            if (keyA.kind != keyB.kind) return keyA.kind < keyB.kind;
+            if (keyA.kind == CellKind::String) {
+                return store.strings().get(static_cast<uint32_t>(keyA.bits)) <
+                       store.strings().get(static_cast<uint32_t>(keyB.bits));
+            }
+            return valueKey(keyA.kind, keyA.bits) < valueKey(keyB.kind, keyB.bits);
+        });
+    }
+    
+    /**
+     * @brief Order groups and lay out headers and rows
+     */
+    void updateLayout() {
+        if (layoutValid) return;
+        orderGroups();
+        
+        // Reserve a header and (unless collapsed) a slot per row for each
+        // group, then drop rows into their group's slots in display order
+        std::vector<size_t> nextSlot(groups.size(), NO_ROW);
+        std::vector<uint32_t> position(groups.size(), NO_GROUP);
+        size_t total = 0;
+        for (uint32_t i = 0; i < groupOrder.size(); ++i) {
+            uint32_t g = groupOrder[i];
+            position[g] = i;
+            bool collapsed = isCollapsed(groupValue(groups[g].key));
+            if (!collapsed) nextSlot[g] = total + 1;
+            total += 1 + (collapsed ? 0 : groups[g].rows);
+        }
+        
+        layout.resize(total);
+        size_t slot = 0;
+        for (uint32_t i = 0; i < groupOrder.size(); ++i) {
+            uint32_t g = groupOrder[i];
+            layout[slot] = {i, NO_ROW};
+            slot += 1 + (nextSlot[g] != NO_ROW ? groups[g].rows : 0);
+        }
+        for (size_t row : displayedIndices) {
+            uint32_t g = rowGroup[row];
+            if (nextSlot[g] != NO_ROW) {
+                layout[nextSlot[g]++] = {position[g], row};
+            }
+        }
+        layoutValid = true;
+    }
+    
+    DataGridGroup makeGroup(uint32_t g) const {
+        const auto& state = groups[g];
+        DataGridGroup group;
+        group.key = groupValue(state.key);
+        group.hasKey = state.key.kind != CellKind::Empty;
+        group.rowCount = state.rows;
+        group.collapsed = isCollapsed(group.key);
+        
+        constexpr double NONE = std::numeric_limits<double>::quiet_NaN();
+        for (size_t a = 0; a < aggregateSpecs.size(); ++a) {
+            const auto& aggregate = state.aggregates[a];
+            switch (aggregateSpecs[a].function) {
+                case AggregateFunction::Count:
+                    group.aggregates.push_back(static_cast<double>(aggregate.count));
+                    break;
+                case AggregateFunction::Sum:
+                    group.aggregates.push_back(aggregate.sum);
+                    break;
+                case AggregateFunction::Average:
+                    group.aggregates.push_back(aggregate.count ? aggregate.sum / aggregate.count : NONE);
+                    break;
+                case AggregateFunction::Min:
+                    group.aggregates.push_back(aggregate.values.empty() ? NONE : aggregate.values.begin()->first);
+                    break;
+                case AggregateFunction::Max:
+                    group.aggregates.push_back(aggregate.values.empty() ? NONE : aggregate.values.rbegin()->first);
+                    break;
+            }
+        }
+        return group;
+    }
+    
+    /**
+     * @brief Rows or display items, whichever scrolling runs over
+     */
+    size_t scrollableCount() {
+        if (!isGrouped()) return displayedCount();
+        updateCache();
+        updateLayout();
+        return layout.size();
     }
 };
 
@@ -163,7 +1409,7 @@ struct DataGrid::DataGridData {
 
 DataGrid::DataGrid()
     : Widget()
-    , m_gridData(std::make_shared<DataGridData>())
+    , m_gridData(WidgetArena::makeShared<DataGridData>())
 {
     backgroundColor(Color(1.0f, 1.0f, 1.0f, 1.0f));
     borderWidth(1.0f);
@@ -176,24 +1422,29 @@ DataGrid DataGrid::create() {
 
 // Column Management
 DataGrid& DataGrid::columns(const std::vector<DataGridColumn>& columns) {
+    if (!columns.empty() || !m_gridData->columns.empty()) invalidate(DirtyFlags::Paint);
     m_gridData->columns = columns;
     return *this;
 }
 
 DataGrid& DataGrid::addColumn(const DataGridColumn& column) {
     m_gridData->columns.push_back(column);
+    invalidate(DirtyFlags::Paint);
     return *this;
 }
 
 DataGrid& DataGrid::addColumn(const std::string& id, const std::string& header, float width) {
     m_gridData->columns.emplace_back(id, header, width);
+    invalidate(DirtyFlags::Paint);
     return *this;
 }
 
 DataGrid& DataGrid::removeColumn(const std::string& id) {
     auto it = std::remove_if(m_gridData->columns.begin(), m_gridData->columns.end(),
         [&id](const DataGridColumn& col) { return col.id == id; });
+    if (it == m_gridData->columns.end()) return *this;
     m_gridData->columns.erase(it, m_gridData->columns.end());
+    invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -210,7 +1461,7 @@ DataGridColumn* DataGrid::getColumn(const std::string& id) {
 
 DataGrid& DataGrid::setColumnWidth(const std::string& id, float width) {
     if (auto* col = getColumn(id)) {
-        col->width = std::clamp(width, col->minWidth, col->maxWidth);
+        if (assign(col->width, std::clamp(width, col->minWidth, col->maxWidth))) invalidate(DirtyFlags::Paint);
         if (m_gridData->onColumnResizeCallback) {
             m_gridData->onColumnResizeCallback(id, col->width);
         }
@@ -220,85 +1471,344 @@ DataGrid& DataGrid::setColumnWidth(const std::string& id, float width) {
 
 // Row/Data Management
 DataGrid& DataGrid::rows(const std::vector<DataGridRow>& rows) {
-    m_gridData->rows = rows;
-    m_gridData->invalidateCache();
+    if (!rows.empty() || getRowCount() > 0) invalidate(DirtyFlags::Paint);
+    m_gridData->source.reset();
+    m_gridData->dropWindow();
+    m_gridData->rowEdits.clear();
+    m_gridData->store.assign(rows);
+    m_gridData->rowsReset();
     return *this;
 }
 
 DataGrid& DataGrid::addRow(const DataGridRow& row) {
-    m_gridData->rows.push_back(row);
-    m_gridData->invalidateCache();
+    m_gridData->applyRowEdits();
+    m_gridData->store.append(row);
+    m_gridData->rowsAppended(m_gridData->store.rowCount() - 1);
+    invalidate(DirtyFlags::Paint);
+    return *this;
+}
+
+DataGrid& DataGrid::appendRows(const DataGridBatch& batch) {
+    if (batch.rowCount() == 0) return *this;
+    m_gridData->applyRowEdits();
+    size_t first = m_gridData->store.rowCount();
+    m_gridData->store.append(batch);
+    bool widened = std::any_of(batch.columns.begin(), batch.columns.end(),
+                               [](const DataGridBatch::Column& column) { return column.widened; });
+    if (widened) {
+        // Stored cells changed kind, so cached keys and text are stale
+        m_gridData->rowsReset();
+    } else {
+        m_gridData->rowsAppended(first);
+    }
+    invalidate(DirtyFlags::Paint);
     return *this;
 }
 
 DataGrid& DataGrid::removeRow(const std::string& id) {
-    auto it = std::remove_if(m_gridData->rows.begin(), m_gridData->rows.end(),
-        [&id](const DataGridRow& row) { return row.id == id; });
-    m_gridData->rows.erase(it, m_gridData->rows.end());
+    m_gridData->applyRowEdits();
+    std::vector<size_t> removed;
+    m_gridData->store.removeIf([this, &id, &removed](size_t row) {
+        if (m_gridData->store.rowId(row) != id) return false;
+        m_gridData->ungroupRow(row);
+        removed.push_back(row);
+        return true;
+    });
     
-    // Remove from selection
-    auto selIt = std::find(m_gridData->selectedRowIds.begin(), m_gridData->selectedRowIds.end(), id);
-    if (selIt != m_gridData->selectedRowIds.end()) {
-        m_gridData->selectedRowIds.erase(selIt);
-    }
+    m_gridData->selection.erase(id);
     
-    m_gridData->invalidateCache();
+    m_gridData->rowsRemoved(removed);
+    m_gridData->compactStrings();
+    if (!removed.empty()) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
 DataGrid& DataGrid::clearRows() {
-    m_gridData->rows.clear();
-    m_gridData->selectedRowIds.clear();
-    m_gridData->invalidateCache();
+    if (m_gridData->store.rowCount() > 0) invalidate(DirtyFlags::Paint);
+    m_gridData->rowEdits.clear();
+    m_gridData->store.clear();
+    m_gridData->selection.clear();
+    m_gridData->rowsReset();
     return *this;
 }
 
 const std::vector<DataGridRow>& DataGrid::getRows() const {
-    return m_gridData->rows;
+    if (m_gridData->source) {
+        return m_gridData->window;
+    }
+    return m_gridData->materializeRows();
 }
 
 std::vector<DataGridRow> DataGrid::getDisplayedRows() const {
+    if (auto& source = m_gridData->source) {
+        auto result = source->fetchRows(0, source->rowCount());
+        m_gridData->markSelected(result);
+        return result;
+    }
+    
     m_gridData->updateCache();
     std::vector<DataGridRow> result;
     result.reserve(m_gridData->displayedIndices.size());
     for (size_t idx : m_gridData->displayedIndices) {
-        result.push_back(m_gridData->rows[idx]);
+        result.push_back(m_gridData->store.makeRow(idx));
     }
     return result;
 }
 
+std::vector<DataGridRow> DataGrid::getDisplayedRowRange(size_t first, size_t count) const {
+    return m_gridData->displayedRange(first, count);
+}
+
+std::vector<DataGridRow> DataGrid::getVisibleRows() const {
+    int startIndex = 0;
+    int endIndex = 0;
+    getVisibleRowRange(startIndex, endIndex);
+    if (endIndex <= startIndex) return {};
+    
+    if (m_gridData->isGrouped()) {
+        std::vector<DataGridRow> result;
+        for (auto& item : getDisplayedItems(static_cast<size_t>(startIndex),
+                                            static_cast<size_t>(endIndex - startIndex))) {
+            if (!item.isGroupHeader) result.push_back(std::move(item.row));
+        }
+        return result;
+    }
+    return m_gridData->displayedRange(static_cast<size_t>(startIndex),
+                                      static_cast<size_t>(endIndex - startIndex));
+}
+
 DataGridRow* DataGrid::getRow(const std::string& id) {
-    for (auto& row : m_gridData->rows) {
-        if (row.id == id) return &row;
+    if (m_gridData->source) {
+        for (auto& row : m_gridData->window) {
+            if (row.id == id) return &row;
+        }
+        return nullptr;
     }
-    return nullptr;
+    
+    m_gridData->applyRowEdits();
+    size_t index = m_gridData->findRow(id);
+    if (index == DataGridData::NO_ROW) return nullptr;
+    
+    auto [it, inserted] = m_gridData->rowEdits.try_emplace(index);
+    if (inserted) {
+        it->second = m_gridData->store.makeRow(index);
+    }
+    return &it->second;
+}
+
+DataGrid& DataGrid::setCell(const std::string& rowId, const std::string& columnId, const CellValue& value) {
+    m_gridData->applyRowEdits();
+    size_t index = m_gridData->findRow(rowId);
+    if (index == DataGridData::NO_ROW) return *this;
+    
+    auto& store = m_gridData->store;
+    m_gridData->ungroupRow(index);
+    bool changed = store.setCell(index, store.ensureColumn(columnId), value);
+    
+    m_gridData->rowChanged(index);
+    m_gridData->compactStrings();
+    if (changed) invalidate(DirtyFlags::Paint);
+    return *this;
+}
+
+CellValue DataGrid::getCell(const std::string& rowId, const std::string& columnId) const {
+    m_gridData->applyRowEdits();
+    const auto& store = m_gridData->store;
+    size_t index = m_gridData->findRow(rowId);
+    size_t ordinal = store.findColumn(columnId);
+    if (index == DataGridData::NO_ROW || ordinal == DataGridStore::NO_COLUMN) {
+        return CellValue{std::string{}};
+    }
+    return store.getCell(index, ordinal);
 }
 
 size_t DataGrid::getRowCount() const {
-    return m_gridData->rows.size();
+    if (m_gridData->source) {
+        return m_gridData->source->rowCount();
+    }
+    return m_gridData->store.rowCount();
 }
 
 size_t DataGrid::getFilteredRowCount() const {
+    return m_gridData->displayedCount();
+}
+
+// Grouping
+DataGrid& DataGrid::groupBy(const std::string& columnId) {
+    if (!m_gridData->collapsedGroups.empty()) invalidate(DirtyFlags::Paint);
+    if (assign(m_gridData->groupColumnId, columnId)) invalidate(DirtyFlags::Paint);
+    m_gridData->collapsedGroups.clear();
+    m_gridData->invalidateGroups();
+    return *this;
+}
+
+DataGrid& DataGrid::clearGrouping() {
+    return groupBy("");
+}
+
+const std::string& DataGrid::getGroupColumn() const {
+    return m_gridData->groupColumnId;
+}
+
+DataGrid& DataGrid::aggregates(const std::vector<DataGridAggregate>& aggregates) {
+    if (assign(m_gridData->aggregateSpecs, aggregates)) invalidate(DirtyFlags::Paint);
+    m_gridData->invalidateGroups();
+    return *this;
+}
+
+const std::vector<DataGridAggregate>& DataGrid::getAggregates() const {
+    return m_gridData->aggregateSpecs;
+}
+
+std::vector<DataGridGroup> DataGrid::getGroups() const {
+    if (!m_gridData->isGrouped()) return {};
+    
+    // Group order alone is enough here; the row layout waits for getDisplayedItems()
     m_gridData->updateCache();
-    return m_gridData->displayedIndices.size();
+    if (!m_gridData->layoutValid) {
+        m_gridData->orderGroups();
+    }
+    std::vector<DataGridGroup> result;
+    result.reserve(m_gridData->groupOrder.size());
+    for (uint32_t g : m_gridData->groupOrder) {
+        result.push_back(m_gridData->makeGroup(g));
+    }
+    return result;
+}
+
+DataGrid& DataGrid::collapseGroup(const CellValue& key, bool collapsed) {
+    auto& collapsedGroups = m_gridData->collapsedGroups;
+    auto it = std::find(collapsedGroups.begin(), collapsedGroups.end(), key);
+    if (collapsed && it == collapsedGroups.end()) {
+        collapsedGroups.push_back(key);
+    } else if (!collapsed && it != collapsedGroups.end()) {
+        collapsedGroups.erase(it);
+    } else {
+        return *this;
+    }
+    m_gridData->layoutValid = false;
+    invalidate(DirtyFlags::Paint);
+    return *this;
+}
+
+DataGrid& DataGrid::expandGroup(const CellValue& key) {
+    return collapseGroup(key, false);
+}
+
+bool DataGrid::isGroupCollapsed(const CellValue& key) const {
+    return m_gridData->isCollapsed(key);
+}
+
+size_t DataGrid::getDisplayedItemCount() const {
+    return m_gridData->scrollableCount();
+}
+
+std::vector<DataGridDisplayItem> DataGrid::getDisplayedItems(size_t first, size_t count) const {
+    std::vector<DataGridDisplayItem> result;
+    if (!m_gridData->isGrouped()) {
+        for (auto& row : m_gridData->displayedRange(first, count)) {
+            DataGridDisplayItem item;
+            item.row = std::move(row);
+            result.push_back(std::move(item));
+        }
+        return result;
+    }
+    
+    m_gridData->updateCache();
+    m_gridData->updateLayout();
+    const auto& layout = m_gridData->layout;
+    size_t last = first + std::min(count, layout.size() - std::min(first, layout.size()));
+    for (size_t i = first; i < last; ++i) {
+        DataGridDisplayItem item;
+        item.groupIndex = layout[i].group;
+        item.isGroupHeader = layout[i].row == DataGridData::NO_ROW;
+        if (!item.isGroupHeader) {
+            item.row = m_gridData->store.makeRow(layout[i].row);
+        }
+        result.push_back(std::move(item));
+    }
+    return result;
+}
+
+// Data Source
+DataGrid& DataGrid::dataSource(std::shared_ptr<DataGridDataSource> source) {
+    m_gridData->source = std::move(source);
+    m_gridData->invalidateGroups();
+    m_gridData->dropWindow();
+    m_gridData->sendQuery();
+    m_gridData->scrollOffset = 0.0f;
+    invalidate(DirtyFlags::Paint);
+    return *this;
+}
+
+std::shared_ptr<DataGridDataSource> DataGrid::getDataSource() const {
+    return m_gridData->source;
+}
+
+DataGrid& DataGrid::prefetchRows(size_t count) {
+    m_gridData->prefetchRows = count;
+    return *this;
+}
+
+size_t DataGrid::getPrefetchRows() const {
+    return m_gridData->prefetchRows;
+}
+
+DataGrid& DataGrid::refreshDataSource() {
+    m_gridData->dropWindow();
+    invalidate(DirtyFlags::Paint);
+    return *this;
 }
 
 // Sorting
 DataGrid& DataGrid::sortBy(const std::string& columnId, SortDirection direction) {
-    // Clear previous sort indicator
-    for (auto& col : m_gridData->columns) {
-        col.sortDirection = SortDirection::None;
+    std::vector<DataGridSortKey> keys;
+    if (direction != SortDirection::None) {
+        keys.push_back({columnId, direction});
+    }
+    sortBy(keys);
+    
+    if (m_gridData->onSortCallback) {
+        m_gridData->onSortCallback(columnId, direction);
     }
     
-    m_gridData->sortColumnId = columnId;
-    m_gridData->sortDirection = direction;
+    return *this;
+}
+
+DataGrid& DataGrid::sortBy(const std::vector<DataGridSortKey>& keys) {
+    std::vector<DataGridSortKey> sortOrder;
+    for (const auto& key : keys) {
+        bool repeated = std::any_of(sortOrder.begin(), sortOrder.end(),
+            [&key](const DataGridSortKey& existing) { return existing.columnId == key.columnId; });
+        if (key.direction != SortDirection::None && !repeated) {
+            sortOrder.push_back(key);
+        }
+    }
+    if (assign(m_gridData->sortOrder, sortOrder)) invalidate(DirtyFlags::Paint);
     
-    // Set sort indicator on column
-    if (auto* col = getColumn(columnId)) {
-        col->sortDirection = direction;
+    // Sort indicators on the columns
+    for (auto& col : m_gridData->columns) {
+        col.sortDirection = SortDirection::None;
+        for (const auto& key : m_gridData->sortOrder) {
+            if (key.columnId == col.id) col.sortDirection = key.direction;
+        }
     }
     
-    m_gridData->invalidateCache();
+    m_gridData->invalidateOrder();
+    m_gridData->sendQuery();
+    return *this;
+}
+
+DataGrid& DataGrid::thenBy(const std::string& columnId, SortDirection direction) {
+    auto keys = m_gridData->sortOrder;
+    auto it = std::find_if(keys.begin(), keys.end(),
+        [&columnId](const DataGridSortKey& key) { return key.columnId == columnId; });
+    if (it != keys.end()) {
+        it->direction = direction;
+    } else {
+        keys.push_back({columnId, direction});
+    }
+    sortBy(keys);
     
     if (m_gridData->onSortCallback) {
         m_gridData->onSortCallback(columnId, direction);
@@ -308,68 +1818,124 @@ DataGrid& DataGrid::sortBy(const std::string& columnId, SortDirection direction)
 }
 
 DataGrid& DataGrid::clearSort() {
-    for (auto& col : m_gridData->columns) {
-        col.sortDirection = SortDirection::None;
-    }
-    m_gridData->sortColumnId.clear();
-    m_gridData->sortDirection = SortDirection::None;
-    m_gridData->invalidateCache();
-    return *this;
+    return sortBy(std::vector<DataGridSortKey>{});
 }
 
 const std::string& DataGrid::getSortColumn() const {
-    return m_gridData->sortColumnId;
+    static const std::string none;
+    return m_gridData->sortOrder.empty() ? none : m_gridData->sortOrder.front().columnId;
 }
 
 SortDirection DataGrid::getSortDirection() const {
-    return m_gridData->sortDirection;
+    return m_gridData->sortOrder.empty() ? SortDirection::None : m_gridData->sortOrder.front().direction;
+}
+
+const std::vector<DataGridSortKey>& DataGrid::getSortKeys() const {
+    return m_gridData->sortOrder;
+}
+
+DataGrid& DataGrid::sortThreads(size_t count) {
+    m_gridData->sortThreads = count;
+    return *this;
+}
+
+size_t DataGrid::getSortThreads() const {
+    return m_gridData->sortThreads;
 }
 
 // Filtering
 DataGrid& DataGrid::setFilter(const std::string& columnId, const std::string& filterText) {
+    // A filter narrows the current result if the column had none, or if the
+    // new text contains the old one (typing more of a search term)
+    bool narrows = true;
+    for (const auto& f : m_gridData->filters) {
+        if (f.columnId != columnId) continue;
+        narrows = !f.customFilter && !f.expression && !filterText.empty() &&
+            DataGridData::toLower(filterText).find(DataGridData::toLower(f.filterText)) != std::string::npos;
+    }
+    
     // Remove existing filter for this column
-    auto it = std::remove_if(m_gridData->filters.begin(), m_gridData->filters.end(),
-        [&columnId](const DataGridFilter& f) { return f.columnId == columnId; });
-    m_gridData->filters.erase(it, m_gridData->filters.end());
+    bool removed = m_gridData->eraseFilter(columnId);
     
     if (!filterText.empty()) {
         DataGridFilter filter;
         filter.columnId = columnId;
         filter.filterText = filterText;
         m_gridData->filters.push_back(filter);
+        
+        if (narrows) {
+            m_gridData->refineFilter(columnId);
+        } else {
+            m_gridData->invalidateCache();
+        }
+    } else if (removed) {
+        m_gridData->invalidateCache();
     }
-    
-    m_gridData->invalidateCache();
+    m_gridData->sendQuery();
+    if (removed || !filterText.empty()) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
 DataGrid& DataGrid::setFilter(const std::string& columnId, std::function<bool(const CellValue&)> filter) {
-    auto it = std::remove_if(m_gridData->filters.begin(), m_gridData->filters.end(),
-        [&columnId](const DataGridFilter& f) { return f.columnId == columnId; });
-    m_gridData->filters.erase(it, m_gridData->filters.end());
+    bool added = filter != nullptr;
+    bool removed = m_gridData->eraseFilter(columnId);
     
     if (filter) {
         DataGridFilter f;
         f.columnId = columnId;
         f.customFilter = std::move(filter);
         m_gridData->filters.push_back(f);
+        
+        // Only a new predicate is known to narrow; a replaced one may widen
+        if (removed) {
+            m_gridData->invalidateCache();
+        } else {
+            m_gridData->refineFilter(columnId);
+        }
+    } else if (removed) {
+        m_gridData->invalidateCache();
     }
+    m_gridData->sendQuery();
+    if (removed || added) invalidate(DirtyFlags::Paint);
+    return *this;
+}
+
+DataGrid& DataGrid::setFilter(const std::string& name, const DataGridFilterExpr& expression) {
+    bool removed = m_gridData->eraseFilter(name);
+    
+    DataGridFilter filter;
+    filter.columnId = name;
+    filter.expression = std::make_shared<const DataGridFilterExpr>(expression);
+    m_gridData->filters.push_back(std::move(filter));
     
-    m_gridData->invalidateCache();
+    // As with custom filters, only a new expression is known to narrow
+    if (removed) {
+        m_gridData->invalidateCache();
+    } else {
+        m_gridData->refineFilter(name);
+    }
+    m_gridData->sendQuery();
+    invalidate(DirtyFlags::Paint);
     return *this;
 }
 
 DataGrid& DataGrid::clearFilter(const std::string& columnId) {
-    auto it = std::remove_if(m_gridData->filters.begin(), m_gridData->filters.end(),
-        [&columnId](const DataGridFilter& f) { return f.columnId == columnId; });
-    m_gridData->filters.erase(it, m_gridData->filters.end());
-    m_gridData->invalidateCache();
+    if (m_gridData->eraseFilter(columnId)) {
+        m_gridData->invalidateCache();
+        m_gridData->sendQuery();
+        invalidate(DirtyFlags::Paint);
+    }
     return *this;
 }
 
 DataGrid& DataGrid::clearAllFilters() {
-    m_gridData->filters.clear();
-    m_gridData->invalidateCache();
+    if (!m_gridData->filters.empty()) {
+        m_gridData->filters.clear();
+        m_gridData->filterPrograms.clear();
+        m_gridData->invalidateCache();
+        m_gridData->sendQuery();
+        invalidate(DirtyFlags::Paint);
+    }
     return *this;
 }
 
@@ -381,9 +1947,13 @@ const std::vector<DataGridFilter>& DataGrid::getFilters() const {
 // Selection
 DataGrid& DataGrid::multiSelect(bool enabled) {
     m_gridData->multiSelectEnabled = enabled;
-    if (!enabled && m_gridData->selectedRowIds.size() > 1) {
+    if (!enabled && m_gridData->selection.size() > 1) {
         // Keep only first selection
-        m_gridData->selectedRowIds.resize(1);
+        m_gridData->applyRowEdits();
+        DataGridSelectionDelta delta;
+        std::string first = m_gridData->selection.ids().front();
+        m_gridData->removeSelections([&first](const std::string& id) { return id == first; }, delta);
+        if (m_gridData->notifySelection(delta)) invalidate(DirtyFlags::Paint);
     }
     return *this;
 }
@@ -393,79 +1963,115 @@ bool DataGrid::isMultiSelect() const {
 }
 
 DataGrid& DataGrid::selectRow(const std::string& id, bool addToSelection) {
+    m_gridData->applyRowEdits();
+    
+    DataGridSelectionDelta delta;
     if (!addToSelection || !m_gridData->multiSelectEnabled) {
-        m_gridData->selectedRowIds.clear();
+        m_gridData->removeSelections([&id](const std::string& selected) { return selected == id; }, delta);
     }
+    m_gridData->addSelection(id, delta);
     
-    // Check if already selected
-    auto it = std::find(m_gridData->selectedRowIds.begin(), m_gridData->selectedRowIds.end(), id);
-    if (it == m_gridData->selectedRowIds.end()) {
-        m_gridData->selectedRowIds.push_back(id);
+    if (m_gridData->notifySelection(delta)) invalidate(DirtyFlags::Paint);
+    return *this;
+}
+
+DataGrid& DataGrid::selectRange(size_t firstIndex, size_t lastIndex, bool addToSelection) {
+    if (firstIndex > lastIndex) {
+        std::swap(firstIndex, lastIndex);
     }
+    size_t count = m_gridData->displayedCount();
+    if (firstIndex >= count) return *this;
+    lastIndex = std::min(lastIndex, count - 1);
     
-    // Update row selection state
-    for (auto& row : m_gridData->rows) {
-        row.selected = std::find(m_gridData->selectedRowIds.begin(), 
-                                  m_gridData->selectedRowIds.end(), 
-                                  row.id) != m_gridData->selectedRowIds.end();
+    if (!m_gridData->multiSelectEnabled) {
+        firstIndex = lastIndex;
+    }
+    
+    // Ids of the range in display order
+    std::vector<std::string> ids;
+    ids.reserve(lastIndex - firstIndex + 1);
+    if (m_gridData->source) {
+        for (auto& row : m_gridData->displayedRange(firstIndex, lastIndex - firstIndex + 1)) {
+            ids.push_back(std::move(row.id));
+        }
+    } else {
+        m_gridData->applyRowEdits();
+        for (size_t i = firstIndex; i <= lastIndex; ++i) {
+            ids.push_back(m_gridData->store.rowId(m_gridData->displayedIndices[i]));
+        }
     }
     
-    if (m_gridData->onSelectionChangeCallback) {
-        m_gridData->onSelectionChangeCallback(m_gridData->selectedRowIds);
+    DataGridSelectionDelta delta;
+    if (!addToSelection || !m_gridData->multiSelectEnabled) {
+        std::unordered_set<std::string> range(ids.begin(), ids.end());
+        m_gridData->removeSelections([&range](const std::string& id) { return range.count(id) > 0; }, delta);
+    }
+    for (const auto& id : ids) {
+        m_gridData->addSelection(id, delta);
     }
     
+    if (m_gridData->notifySelection(delta)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
 DataGrid& DataGrid::deselectRow(const std::string& id) {
-    auto it = std::find(m_gridData->selectedRowIds.begin(), m_gridData->selectedRowIds.end(), id);
-    if (it != m_gridData->selectedRowIds.end()) {
-        m_gridData->selectedRowIds.erase(it);
-        
-        if (auto* row = getRow(id)) {
-            row->selected = false;
-        }
+    if (m_gridData->selection.erase(id)) {
+        m_gridData->applyRowEdits();
+        m_gridData->setSelectedFlag(id, false);
         
-        if (m_gridData->onSelectionChangeCallback) {
-            m_gridData->onSelectionChangeCallback(m_gridData->selectedRowIds);
-        }
+        DataGridSelectionDelta delta;
+        delta.removed.push_back(id);
+        if (m_gridData->notifySelection(delta)) invalidate(DirtyFlags::Paint);
     }
     return *this;
 }
 
 DataGrid& DataGrid::clearSelection() {
-    for (auto& row : m_gridData->rows) {
-        row.selected = false;
-    }
-    m_gridData->selectedRowIds.clear();
-    
-    if (m_gridData->onSelectionChangeCallback) {
-        m_gridData->onSelectionChangeCallback(m_gridData->selectedRowIds);
-    }
-    
+    m_gridData->applyRowEdits();
+    DataGridSelectionDelta delta;
+    m_gridData->removeSelections([](const std::string&) { return false; }, delta);
+    if (m_gridData->notifySelection(delta)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
+bool DataGrid::isRowSelected(const std::string& id) const {
+    return m_gridData->selection.contains(id);
+}
+
 std::vector<std::string> DataGrid::getSelectedRowIds() const {
-    return m_gridData->selectedRowIds;
+    return m_gridData->selection.ids();
 }
 
 std::vector<const DataGridRow*> DataGrid::getSelectedRows() const {
     std::vector<const DataGridRow*> result;
-    for (const auto& id : m_gridData->selectedRowIds) {
-        for (const auto& row : m_gridData->rows) {
-            if (row.id == id) {
-                result.push_back(&row);
-                break;
+    
+    if (m_gridData->source) {
+        // Only fetched rows are available
+        std::unordered_map<std::string, const DataGridRow*> fetched;
+        for (const auto& row : m_gridData->window) {
+            fetched.try_emplace(row.id, &row);
+        }
+        for (const auto& id : m_gridData->selection.ids()) {
+            if (auto it = fetched.find(id); it != fetched.end()) {
+                result.push_back(it->second);
             }
         }
+        return result;
+    }
+    
+    const auto& rows = m_gridData->materializeRows();
+    for (const auto& id : m_gridData->selection.ids()) {
+        size_t index = m_gridData->findRow(id);
+        if (index != DataGridData::NO_ROW) {
+            result.push_back(&rows[index]);
+        }
     }
     return result;
 }
 
 // Virtual Scrolling
 DataGrid& DataGrid::rowHeight(float height) {
-    m_gridData->rowHeight = height;
+    if (assign(m_gridData->rowHeight, height)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -474,7 +2080,7 @@ float DataGrid::getRowHeight() const {
 }
 
 DataGrid& DataGrid::headerHeight(float height) {
-    m_gridData->headerHeight = height;
+    if (assign(m_gridData->headerHeight, height)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -487,42 +2093,58 @@ float DataGrid::getScrollOffset() const {
 }
 
 DataGrid& DataGrid::scrollTo(float offset) {
-    m_gridData->updateCache();
     float maxScroll = std::max(0.0f, 
-        static_cast<float>(m_gridData->displayedIndices.size()) * m_gridData->rowHeight - 
+        static_cast<float>(m_gridData->scrollableCount()) * m_gridData->rowHeight - 
         (getHeight() - m_gridData->headerHeight));
-    m_gridData->scrollOffset = std::clamp(offset, 0.0f, maxScroll);
+    if (assign(m_gridData->scrollOffset, std::clamp(offset, 0.0f, maxScroll))) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
 DataGrid& DataGrid::scrollToRow(const std::string& id) {
+    if (m_gridData->source) {
+        size_t index = m_gridData->source->indexOf(id);
+        if (index != DataGridDataSource::NOT_FOUND) {
+            scrollTo(static_cast<float>(index) * m_gridData->rowHeight);
+        }
+        return *this;
+    }
+    
     m_gridData->updateCache();
     
-    for (size_t i = 0; i < m_gridData->displayedIndices.size(); ++i) {
-        if (m_gridData->rows[m_gridData->displayedIndices[i]].id == id) {
-            float rowTop = static_cast<float>(i) * m_gridData->rowHeight;
-            scrollTo(rowTop);
-            break;
+    size_t row = m_gridData->findRow(id);
+    if (row == DataGridData::NO_ROW) return *this;
+    
+    if (m_gridData->isGrouped()) {
+        m_gridData->updateLayout();
+        const auto& layout = m_gridData->layout;
+        for (size_t i = 0; i < layout.size(); ++i) {
+            if (layout[i].row == row) {
+                scrollTo(static_cast<float>(i) * m_gridData->rowHeight);
+                break;
+            }
         }
+        return *this;
     }
     
+    size_t position = m_gridData->displayPosition(row);
+    if (position != DataGridData::NO_ROW) {
+        scrollTo(static_cast<float>(position) * m_gridData->rowHeight);
+    }
     return *this;
 }
 
 void DataGrid::getVisibleRowRange(int& startIndex, int& endIndex) const {
-    m_gridData->updateCache();
-    
     float viewHeight = getHeight() - m_gridData->headerHeight;
     startIndex = static_cast<int>(m_gridData->scrollOffset / m_gridData->rowHeight);
     endIndex = static_cast<int>((m_gridData->scrollOffset + viewHeight) / m_gridData->rowHeight) + 1;
     
     startIndex = std::max(0, startIndex);
-    endIndex = std::min(static_cast<int>(m_gridData->displayedIndices.size()), endIndex);
+    endIndex = std::min(static_cast<int>(m_gridData->scrollableCount()), endIndex);
 }
 
 // Appearance
 DataGrid& DataGrid::headerColor(const Color& color) {
-    m_gridData->headerColor = color;
+    if (assign(m_gridData->headerColor, color)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -531,13 +2153,14 @@ const Color& DataGrid::getHeaderColor() const {
 }
 
 DataGrid& DataGrid::alternatingRowColors(const Color& even, const Color& odd) {
-    m_gridData->evenRowColor = even;
-    m_gridData->oddRowColor = odd;
+    bool changed = assign(m_gridData->evenRowColor, even);
+    changed |= assign(m_gridData->oddRowColor, odd);
+    if (changed) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
 DataGrid& DataGrid::hoverColor(const Color& color) {
-    m_gridData->hoverColor = color;
+    if (assign(m_gridData->hoverColor, color)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -546,7 +2169,7 @@ const Color& DataGrid::getHoverColor() const {
 }
 
 DataGrid& DataGrid::selectionColor(const Color& color) {
-    m_gridData->selectionColor = color;
+    if (assign(m_gridData->selectionColor, color)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -555,7 +2178,7 @@ const Color& DataGrid::getSelectionColor() const {
 }
 
 DataGrid& DataGrid::showGridLines(bool show) {
-    m_gridData->gridLinesVisible = show;
+    if (assign(m_gridData->gridLinesVisible, show)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -585,6 +2208,11 @@ DataGrid& DataGrid::onSelectionChange(std::function<void(const std::vector<std::
     return *this;
 }
 
+DataGrid& DataGrid::onSelectionDelta(std::function<void(const DataGridSelectionDelta&)> callback) {
+    m_gridData->onSelectionDeltaCallback = std::move(callback);
+    return *this;
+}
+
 DataGrid& DataGrid::onRowDoubleClick(std::function<void(const DataGridRow&)> callback) {
     m_gridData->onRowDoubleClickCallback = std::move(callback);
     return *this;
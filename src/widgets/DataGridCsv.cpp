@@ -0,0 +1,624 @@
+/**
+ * @file DataGridCsv.cpp
+ * @brief Streaming CSV/TSV loader implementation
+ */
+
+#include "KillerGK/widgets/DataGridCsv.hpp"
+#include "KillerGK/widgets/DataGridStore.hpp"
+#include "KillerGK/core/Error.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cctype>
+#include <charconv>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define KGK_CSV_SSE2
+#endif
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace KillerGK {
+
+namespace {
+
+/// Largest batch, as a multiple of CsvLoadOptions::chunkRows
+constexpr size_t MAX_CHUNK_GROWTH = 64;
+
+// =============================================================================
+// Scanning
+// =============================================================================
+
+/**
+ * @brief Find the first delimiter, CR or LF at or after p (end if none)
+ *
+ * Unquoted fields are scanned 16 bytes at a time with SSE2, or 8 bytes at
+ * a time with word arithmetic elsewhere.
+ */
+const char* findFieldEnd(const char* p, const char* end, char delimiter) {
+#ifdef KGK_CSV_SSE2
+    const __m128i delimiters = _mm_set1_epi8(delimiter);
+    const __m128i newlines = _mm_set1_epi8('\n');
+    const __m128i returns = _mm_set1_epi8('\r');
+    while (end - p >= 16) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i hits = _mm_or_si128(_mm_cmpeq_epi8(bytes, delimiters),
+                       _mm_or_si128(_mm_cmpeq_epi8(bytes, newlines), _mm_cmpeq_epi8(bytes, returns)));
+        int mask = _mm_movemask_epi8(hits);
+        if (mask != 0) {
+            return p + std::countr_zero(static_cast<unsigned>(mask));
+        }
+        p += 16;
+    }
+#else
+    if constexpr (std::endian::native == std::endian::little) {
+        constexpr uint64_t ONES = 0x0101010101010101ull;
+        constexpr uint64_t HIGHS = 0x8080808080808080ull;
+        const uint64_t delimiters = ONES * static_cast<uint8_t>(delimiter);
+        const uint64_t newlines = ONES * '\n';
+        const uint64_t returns = ONES * '\r';
+        // Flags the lowest zero byte exactly; later flags may be spurious
+        auto zeroBytes = [](uint64_t v) { return (v - ONES) & ~v & HIGHS; };
+        while (end - p >= 8) {
+            uint64_t word;
+            std::memcpy(&word, p, sizeof(word));
+            uint64_t hits = zeroBytes(word ^ delimiters) | zeroBytes(word ^ newlines) |
+                            zeroBytes(word ^ returns);
+            if (hits != 0) {
+                return p + std::countr_zero(hits) / 8;
+            }
+            p += 8;
+        }
+    }
+#endif
+    while (p < end && *p != delimiter && *p != '\n' && *p != '\r') {
+        ++p;
+    }
+    return p;
+}
+
+/**
+ * @brief Splits mapped text into records and fields
+ */
+class CsvScanner {
+public:
+    CsvScanner(const char* begin, const char* end, char delimiter)
+        : m_pos(begin), m_end(end), m_delimiter(delimiter) {}
+
+    [[nodiscard]] bool atEnd() const { return m_pos >= m_end; }
+    [[nodiscard]] const char* position() const { return m_pos; }
+
+    /**
+     * @brief Read the next record's fields
+     *
+     * Unquoted fields are views into the file; quoted fields with doubled
+     * quotes are unescaped into scratch storage owned by the scanner and
+     * valid until the next call.
+     */
+    void next(std::vector<std::string_view>& fields) {
+        fields.clear();
+        m_unescaped.clear();
+        m_pendingViews.clear();
+
+        for (;;) {
+            if (m_pos < m_end && *m_pos == '"') {
+                readQuoted(fields);
+            } else {
+                const char* fieldEnd = findFieldEnd(m_pos, m_end, m_delimiter);
+                fields.emplace_back(m_pos, static_cast<size_t>(fieldEnd - m_pos));
+                m_pos = fieldEnd;
+            }
+
+            if (m_pos < m_end && *m_pos == m_delimiter) {
+                ++m_pos;
+                continue;
+            }
+            break;
+        }
+
+        // End of record: CRLF, LF or a lone CR
+        if (m_pos < m_end && *m_pos == '\r') ++m_pos;
+        if (m_pos < m_end && *m_pos == '\n') ++m_pos;
+
+        // Unescaped text is stable now that the record is complete
+        for (auto [field, offset, length] : m_pendingViews) {
+            fields[field] = std::string_view(m_unescaped).substr(offset, length);
+        }
+    }
+
+private:
+    void readQuoted(std::vector<std::string_view>& fields) {
+        const char* start = ++m_pos;
+        const char* quote = findQuote(m_pos);
+
+        if (quote && (quote + 1 == m_end || quote[1] != '"')) {
+            // The common case: no doubled quotes, so the field is a view
+            fields.emplace_back(start, static_cast<size_t>(quote - start));
+        } else {
+            size_t offset = m_unescaped.size();
+            while (quote && quote + 1 < m_end && quote[1] == '"') {
+                m_unescaped.append(m_pos, quote + 1);  // Keep one of the two quotes
+                m_pos = quote + 2;
+                quote = findQuote(m_pos);
+            }
+            m_unescaped.append(m_pos, quote ? quote : m_end);  // Unterminated: take the rest
+            fields.emplace_back();
+            m_pendingViews.push_back({fields.size() - 1, offset, m_unescaped.size() - offset});
+        }
+
+        // Text between the closing quote and the next delimiter ("ab"cd) is dropped
+        m_pos = quote ? findFieldEnd(quote + 1, m_end, m_delimiter) : m_end;
+    }
+
+    const char* findQuote(const char* from) const {
+        return static_cast<const char*>(std::memchr(from, '"', static_cast<size_t>(m_end - from)));
+    }
+
+    struct PendingView {
+        size_t field;
+        size_t offset;
+        size_t length;
+    };
+
+    const char* m_pos;
+    const char* m_end;
+    char m_delimiter;
+    std::string m_unescaped;
+    std::vector<PendingView> m_pendingViews;
+};
+
+// =============================================================================
+// Type inference
+// =============================================================================
+
+bool equalsIgnoreCase(std::string_view text, std::string_view word) {
+    return text.size() == word.size() &&
+           std::equal(text.begin(), text.end(), word.begin(), [](char a, char b) {
+               return std::tolower(static_cast<unsigned char>(a)) == b;
+           });
+}
+
+bool parseBoolean(std::string_view text, bool& value) {
+    if (equalsIgnoreCase(text, "true")) {
+        value = true;
+        return true;
+    }
+    if (equalsIgnoreCase(text, "false")) {
+        value = false;
+        return true;
+    }
+    return false;
+}
+
+bool parseInteger(std::string_view text, int64_t& value) {
+    const char* first = text.data();
+    if (!text.empty() && text[0] == '+') ++first;
+    auto [ptr, ec] = std::from_chars(first, text.data() + text.size(), value);
+    return ec == std::errc() && ptr == text.data() + text.size() && first != ptr;
+}
+
+bool parseNumber(std::string_view text, double& value) {
+    const char* first = text.data();
+    if (!text.empty() && text[0] == '+') ++first;
+    auto [ptr, ec] = std::from_chars(first, text.data() + text.size(), value);
+    return ec == std::errc() && ptr == text.data() + text.size() && first != ptr;
+}
+
+/**
+ * @brief ISO 8601 date, optionally followed by a time (YYYY-MM-DD[Thh:mm...])
+ */
+bool isDate(std::string_view text) {
+    auto digits = [&text](size_t from, size_t count) {
+        for (size_t i = from; i < from + count; ++i) {
+            if (!std::isdigit(static_cast<unsigned char>(text[i]))) return false;
+        }
+        return true;
+    };
+    if (text.size() < 10 || !digits(0, 4) || text[4] != '-' || !digits(5, 2) || text[7] != '-' || !digits(8, 2)) {
+        return false;
+    }
+    if (text.size() == 10) return true;
+    return (text[10] == 'T' || text[10] == ' ') && text.size() >= 16 && digits(11, 2) && text[13] == ':' &&
+           digits(14, 2);
+}
+
+/**
+ * @brief How a column's fields are stored
+ */
+struct ColumnFormat {
+    ColumnType type = ColumnType::String;
+    bool integral = false;    ///< Number column whose sampled values were all integers
+};
+
+/**
+ * @brief Pick the narrowest type that fits every non-empty sampled value
+ */
+ColumnFormat inferFormat(const std::vector<std::string_view>& values) {
+    bool booleans = true;
+    bool integers = true;
+    bool numbers = true;
+    bool dates = true;
+    size_t count = 0;
+
+    for (auto value : values) {
+        if (value.empty()) continue;
+        count++;
+        bool flag;
+        int64_t integer;
+        double number;
+        booleans = booleans && parseBoolean(value, flag);
+        integers = integers && parseInteger(value, integer);
+        numbers = numbers && (integers || parseNumber(value, number));
+        dates = dates && isDate(value);
+    }
+
+    if (count == 0) return {};
+    if (booleans) return {ColumnType::Boolean, false};
+    if (numbers) return {ColumnType::Number, integers};
+    if (dates) return {ColumnType::Date, false};
+    return {};
+}
+
+// =============================================================================
+// File mapping
+// =============================================================================
+
+/**
+ * @brief Read-only memory mapping of the input file
+ */
+struct MappedFile {
+    const char* data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#endif
+
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path) {
+#ifdef _WIN32
+        file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                           OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) return false;
+        size = static_cast<size_t>(fileSize.QuadPart);
+
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) return false;
+
+        data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        return data != nullptr;
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+            ::close(fd);
+            return false;
+        }
+        size = static_cast<size_t>(st.st_size);
+
+        void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);  // The mapping keeps its own reference to the file
+        if (mapped == MAP_FAILED) return false;
+
+        madvise(mapped, size, MADV_SEQUENTIAL);
+        data = static_cast<const char*>(mapped);
+        return true;
+#endif
+    }
+
+    ~MappedFile() {
+#ifdef _WIN32
+        if (data) UnmapViewOfFile(data);
+        if (mapping) CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+#else
+        if (data) munmap(const_cast<char*>(data), size);
+#endif
+    }
+};
+
+} // namespace
+
+// =============================================================================
+// DataGridCsvLoader
+// =============================================================================
+
+struct DataGridCsvLoader::LoaderData {
+    MappedFile file;
+    CsvLoadOptions options;
+    char delimiter = ',';
+    std::vector<DataGridColumn> columns;
+    std::vector<ColumnFormat> formats;
+    size_t idField = static_cast<size_t>(-1);
+    const char* dataStart = nullptr;
+
+    // Parser thread and its output queue
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable queueSpace;      ///< Signalled when batches are taken
+    std::condition_variable queueFilled;     ///< Signalled when a batch is ready or parsing ends
+    std::deque<DataGridBatch> ready;
+    bool parsed = false;
+    bool stopping = false;
+    std::atomic<size_t> parsedBytes{0};
+
+    size_t rowsAppended = 0;
+
+    /// Spans of the batch being built, by text, so repeated values share one
+    struct TextHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view text) const { return std::hash<std::string_view>()(text); }
+    };
+    std::unordered_map<std::string, uint64_t, TextHash, std::equal_to<>> batchText;
+
+    void parse() {
+        CsvScanner scanner(dataStart, file.data + file.size, delimiter);
+        std::vector<std::string_view> fields;
+        size_t record = 0;
+        const size_t firstChunk = std::max<size_t>(1, options.chunkRows);
+
+        while (!scanner.atEnd()) {
+            // Batches grow with the rows loaded, so a sorted grid merges each
+            // into fewer and fewer passes over its display order
+            size_t chunkRows = std::clamp(record / 4, firstChunk, firstChunk * MAX_CHUNK_GROWTH);
+
+            DataGridBatch batch;
+            batch.columns.resize(columns.size());
+            for (size_t c = 0; c < columns.size(); ++c) {
+                batch.columns[c].id = columns[c].id;
+                batch.columns[c].kinds.reserve(chunkRows);
+                batch.columns[c].payload.reserve(chunkRows);
+            }
+            batch.rowIds.reserve(chunkRows);
+            batchText.clear();
+
+            while (batch.rowCount() < chunkRows && !scanner.atEnd()) {
+                scanner.next(fields);
+                if (fields.size() == 1 && fields[0].empty()) continue;  // Blank line
+                record++;
+                addRecord(batch, fields, record);
+            }
+            parsedBytes.store(static_cast<size_t>(scanner.position() - file.data), std::memory_order_relaxed);
+
+            std::unique_lock lock(mutex);
+            queueSpace.wait(lock, [this] { return stopping || ready.size() < std::max<size_t>(1, options.maxQueuedChunks); });
+            if (stopping) return;
+            if (batch.rowCount() > 0) {
+                ready.push_back(std::move(batch));
+            }
+            queueFilled.notify_all();
+        }
+
+        std::lock_guard lock(mutex);
+        parsed = true;
+        queueFilled.notify_all();
+    }
+
+    void addRecord(DataGridBatch& batch, const std::vector<std::string_view>& fields, size_t record) {
+        batch.rowIds.push_back(idField < fields.size() ? std::string(fields[idField]) : std::to_string(record));
+
+        for (size_t c = 0; c < columns.size(); ++c) {
+            auto& column = batch.columns[c];
+            std::string_view field = c < fields.size() ? fields[c] : std::string_view();
+            CellKind kind = CellKind::Empty;
+            uint64_t bits = 0;
+
+            if (!field.empty()) {
+                ColumnFormat& format = formats[c];
+                bool flag;
+                int64_t integer;
+                double number;
+                if (format.type == ColumnType::Boolean && parseBoolean(field, flag)) {
+                    kind = CellKind::Boolean;
+                    bits = flag ? 1 : 0;
+                } else if (format.type == ColumnType::Number && format.integral && parseInteger(field, integer)) {
+                    kind = CellKind::Integer;
+                    bits = static_cast<uint64_t>(integer);
+                } else if (format.type == ColumnType::Number && parseNumber(field, number)) {
+                    if (format.integral) {
+                        // A fraction in a column sampled as integral: the whole column becomes
+                        // fractional so its cells keep sorting as one kind
+                        format.integral = false;
+                        column.widened = true;
+                    }
+                    kind = CellKind::Number;
+                    std::memcpy(&bits, &number, sizeof(bits));
+                } else {
+                    kind = CellKind::String;
+                    auto it = batchText.find(field);
+                    if (it == batchText.end()) {
+                        it = batchText.emplace(field, batch.addText(field)).first;
+                    }
+                    bits = it->second;
+                }
+            }
+            column.kinds.push_back(kind);
+            column.payload.push_back(bits);
+        }
+    }
+
+    void stop() {
+        {
+            std::lock_guard lock(mutex);
+            stopping = true;
+        }
+        queueSpace.notify_all();
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+};
+
+DataGridCsvLoader::DataGridCsvLoader() = default;
+
+DataGridCsvLoader::~DataGridCsvLoader() {
+    close();
+}
+
+bool DataGridCsvLoader::open(const std::string& path, const CsvLoadOptions& options) {
+    close();
+
+    auto data = std::make_unique<LoaderData>();
+    if (!data->file.open(path)) {
+        log(LogLevel::Error, "Failed to open CSV file: " + path);
+        return false;
+    }
+    data->options = options;
+
+    data->delimiter = options.delimiter;
+    if (data->delimiter == '\0') {
+        std::string extension = std::filesystem::path(path).extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        data->delimiter = (extension == ".tsv" || extension == ".tab") ? '\t' : ',';
+    }
+
+    const char* begin = data->file.data;
+    const char* end = data->file.data + data->file.size;
+    if (end - begin >= 3 && std::memcmp(begin, "\xEF\xBB\xBF", 3) == 0) {
+        begin += 3;  // UTF-8 byte order mark
+    }
+
+    // Header
+    CsvScanner scanner(begin, end, data->delimiter);
+    std::vector<std::string_view> fields;
+    std::vector<std::string> names;
+    if (options.hasHeader && !scanner.atEnd()) {
+        scanner.next(fields);
+        names.assign(fields.begin(), fields.end());
+    }
+    data->dataStart = scanner.position();
+
+    // Sample records for type inference; the header may be short of fields
+    std::vector<std::vector<std::string>> sample;
+    while (sample.size() < options.inferRows && !scanner.atEnd()) {
+        scanner.next(fields);
+        if (fields.size() == 1 && fields[0].empty()) continue;
+        sample.emplace_back(fields.begin(), fields.end());
+    }
+    size_t columnCount = names.size();
+    for (const auto& record : sample) {
+        columnCount = std::max(columnCount, record.size());
+    }
+
+    std::unordered_set<std::string> usedIds;
+    for (size_t c = 0; c < columnCount; ++c) {
+        std::string name = c < names.size() ? names[c] : std::string();
+        std::string id = name;
+        if (id.empty() || !usedIds.insert(id).second) {
+            id = "column" + std::to_string(c + 1);
+            usedIds.insert(id);
+        }
+
+        std::vector<std::string_view> values;
+        values.reserve(sample.size());
+        for (const auto& record : sample) {
+            if (c < record.size()) values.push_back(record[c]);
+        }
+        ColumnFormat format = inferFormat(values);
+
+        DataGridColumn column(id, name.empty() ? id : name);
+        column.type = format.type;
+        data->columns.push_back(std::move(column));
+        data->formats.push_back(format);
+
+        if (!options.idColumn.empty() && id == options.idColumn) {
+            data->idField = c;
+        }
+    }
+
+    LoaderData* loader = data.get();
+    data->worker = std::thread([loader] { loader->parse(); });
+    m_data = std::move(data);
+    return true;
+}
+
+void DataGridCsvLoader::close() {
+    if (m_data) {
+        m_data->stop();
+        m_data.reset();
+    }
+}
+
+const std::vector<DataGridColumn>& DataGridCsvLoader::getColumns() const {
+    static const std::vector<DataGridColumn> none;
+    return m_data ? m_data->columns : none;
+}
+
+size_t DataGridCsvLoader::appendTo(DataGrid& grid) {
+    if (!m_data) return 0;
+
+    std::deque<DataGridBatch> batches;
+    {
+        std::lock_guard lock(m_data->mutex);
+        batches.swap(m_data->ready);
+    }
+    m_data->queueSpace.notify_all();
+
+    size_t appended = 0;
+    for (const auto& batch : batches) {
+        grid.appendRows(batch);
+        appended += batch.rowCount();
+    }
+    m_data->rowsAppended += appended;
+    return appended;
+}
+
+size_t DataGridCsvLoader::finish(DataGrid& grid) {
+    if (!m_data) return 0;
+
+    size_t appended = 0;
+    for (;;) {
+        appended += appendTo(grid);
+
+        std::unique_lock lock(m_data->mutex);
+        m_data->queueFilled.wait(lock, [this] { return m_data->parsed || !m_data->ready.empty(); });
+        if (m_data->parsed && m_data->ready.empty()) break;
+    }
+    return appended;
+}
+
+bool DataGridCsvLoader::isFinished() const {
+    if (!m_data) return true;
+    std::lock_guard lock(m_data->mutex);
+    return m_data->parsed && m_data->ready.empty();
+}
+
+float DataGridCsvLoader::getProgress() const {
+    if (!m_data) return 0.0f;
+    if (isFinished()) return 1.0f;
+    return static_cast<float>(m_data->parsedBytes.load(std::memory_order_relaxed)) /
+           static_cast<float>(m_data->file.size);
+}
+
+size_t DataGridCsvLoader::getRowsAppended() const {
+    return m_data ? m_data->rowsAppended : 0;
+}
+
+} // namespace KillerGK
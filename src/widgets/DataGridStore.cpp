@@ -0,0 +1,639 @@
+/**
+ * @file DataGridStore.cpp
+ * @brief Columnar DataGrid storage implementation
+ */
+
+#include "KillerGK/widgets/DataGridStore.hpp"
+#include "KillerGK/core/Error.hpp"
+#include <algorithm>
+#include <cstring>
+#include <optional>
+#include <regex>
+
+namespace KillerGK {
+
+// =============================================================================
+// StringPool
+// =============================================================================
+
+uint32_t StringPool::intern(std::string_view text) {
+    auto it = m_ids.find(text);
+    if (it != m_ids.end()) {
+        addRef(it->second);
+        return it->second;
+    }
+
+    uint32_t id = static_cast<uint32_t>(m_strings.size());
+    const std::string& stored = m_strings.emplace_back(text);
+    m_refs.push_back(1);
+    m_ids.emplace(std::string_view(stored), id);
+    return id;
+}
+
+void StringPool::addRef(uint32_t id) {
+    if (m_refs[id]++ == 0) m_dead--;
+}
+
+void StringPool::release(uint32_t id) {
+    if (--m_refs[id] == 0) m_dead++;
+}
+
+std::vector<uint32_t> StringPool::compact() {
+    std::vector<uint32_t> remap(m_strings.size(), DROPPED);
+    std::deque<std::string> strings;
+    std::vector<uint32_t> refs;
+    for (uint32_t id = 0; id < m_strings.size(); ++id) {
+        if (m_refs[id] == 0) continue;
+        remap[id] = static_cast<uint32_t>(strings.size());
+        strings.push_back(std::move(m_strings[id]));
+        refs.push_back(m_refs[id]);
+    }
+    m_strings = std::move(strings);
+    m_refs = std::move(refs);
+    m_dead = 0;
+
+    // Moving a short string moves its bytes, so the keys are rebuilt
+    m_ids.clear();
+    for (uint32_t id = 0; id < m_strings.size(); ++id) {
+        m_ids.emplace(std::string_view(m_strings[id]), id);
+    }
+    return remap;
+}
+
+void StringPool::clear() {
+    m_ids.clear();
+    m_strings.clear();
+    m_refs.clear();
+    m_dead = 0;
+}
+
+// =============================================================================
+// DataGridStore
+// =============================================================================
+
+namespace {
+
+// Bits of the double equal to an Integer cell's value
+uint64_t integerAsNumber(uint64_t bits) {
+    double value = static_cast<double>(static_cast<int64_t>(bits));
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+} // namespace
+
+double DataGridStore::Column::number(size_t row) const {
+    double value;
+    std::memcpy(&value, &payload[row], sizeof(value));
+    return value;
+}
+
+void DataGridStore::assign(const std::vector<DataGridRow>& rows) {
+    clear();
+
+    m_rowIds.reserve(rows.size());
+    m_selected.reserve(rows.size());
+    m_enabled.reserve(rows.size());
+    m_userData.reserve(rows.size());
+
+    for (const auto& row : rows) {
+        append(row);
+    }
+}
+
+void DataGridStore::append(const DataGridRow& row) {
+    size_t index = m_rowIds.size();
+
+    m_rowIds.push_back(row.id);
+    m_selected.push_back(row.selected ? 1 : 0);
+    m_enabled.push_back(row.enabled ? 1 : 0);
+    m_userData.push_back(row.userData);
+
+    for (auto& column : m_columns) {
+        column.kinds.push_back(CellKind::Empty);
+        column.payload.push_back(0);
+    }
+
+    for (const auto& [columnId, value] : row.cells) {
+        writeCell(m_columns[ensureColumn(columnId)], index, value);
+    }
+}
+
+void DataGridStore::append(const DataGridBatch& batch) {
+    size_t first = m_rowIds.size();
+    size_t count = batch.rowCount();
+
+    m_rowIds.insert(m_rowIds.end(), batch.rowIds.begin(), batch.rowIds.end());
+    m_selected.resize(first + count, 0);
+    m_enabled.resize(first + count, 1);
+    m_userData.resize(first + count);
+
+    for (auto& column : m_columns) {
+        column.kinds.resize(first + count, CellKind::Empty);
+        column.payload.resize(first + count, 0);
+    }
+
+    // Batches usually repeat text, so each span is interned once
+    constexpr uint32_t NOT_INTERNED = static_cast<uint32_t>(-1);
+    std::vector<uint32_t> spanIds(batch.spans.size(), NOT_INTERNED);
+
+    for (const auto& source : batch.columns) {
+        Column& column = m_columns[ensureColumn(source.id)];
+        std::copy(source.kinds.begin(), source.kinds.end(), column.kinds.begin() + first);
+        for (size_t row = 0; row < count; ++row) {
+            uint64_t bits = source.payload[row];
+            if (source.widened && source.kinds[row] == CellKind::Integer) {
+                bits = integerAsNumber(bits);
+                column.kinds[first + row] = CellKind::Number;
+            } else if (source.kinds[row] == CellKind::String) {
+                uint32_t& id = spanIds[bits];
+                if (id == NOT_INTERNED) {
+                    id = m_strings.intern(batch.getText(bits));
+                } else {
+                    m_strings.addRef(id);
+                }
+                bits = id;
+            }
+            column.payload[first + row] = bits;
+        }
+
+        if (source.widened) {
+            for (size_t row = 0; row < first; ++row) {
+                if (column.kinds[row] == CellKind::Integer) {
+                    column.kinds[row] = CellKind::Number;
+                    column.payload[row] = integerAsNumber(column.payload[row]);
+                }
+            }
+        }
+    }
+}
+
+bool DataGridStore::replace(size_t row, const DataGridRow& value) {
+    bool changed = m_rowIds[row] != value.id ||
+                   isSelected(row) != value.selected ||
+                   isEnabled(row) != value.enabled;
+
+    m_rowIds[row] = value.id;
+    m_selected[row] = value.selected ? 1 : 0;
+    m_enabled[row] = value.enabled ? 1 : 0;
+    m_userData[row] = value.userData;
+
+    // Cells present in the row
+    for (const auto& [columnId, cell] : value.cells) {
+        size_t ordinal = ensureColumn(columnId);
+        if (!changed && (kind(row, ordinal) == CellKind::Empty || getCell(row, ordinal) != cell)) {
+            changed = true;
+        }
+        writeCell(m_columns[ordinal], row, cell);
+    }
+
+    // Cells the row no longer has
+    for (size_t ordinal = 0; ordinal < m_columns.size(); ++ordinal) {
+        if (kind(row, ordinal) != CellKind::Empty && !value.cells.count(m_columns[ordinal].id)) {
+            clearCell(row, ordinal);
+            changed = true;
+        }
+    }
+
+    return changed;
+}
+
+size_t DataGridStore::removeIf(const std::function<bool(size_t row)>& predicate) {
+    size_t kept = 0;
+    for (size_t row = 0; row < m_rowIds.size(); ++row) {
+        if (predicate(row)) {
+            for (const auto& column : m_columns) {
+                releaseCell(column, row);
+            }
+            continue;
+        }
+        if (kept != row) {
+            m_rowIds[kept] = std::move(m_rowIds[row]);
+            m_selected[kept] = m_selected[row];
+            m_enabled[kept] = m_enabled[row];
+            m_userData[kept] = std::move(m_userData[row]);
+            for (auto& column : m_columns) {
+                column.kinds[kept] = column.kinds[row];
+                column.payload[kept] = column.payload[row];
+            }
+        }
+        kept++;
+    }
+
+    size_t removed = m_rowIds.size() - kept;
+    m_rowIds.resize(kept);
+    m_selected.resize(kept);
+    m_enabled.resize(kept);
+    m_userData.resize(kept);
+    for (auto& column : m_columns) {
+        column.kinds.resize(kept);
+        column.payload.resize(kept);
+    }
+    return removed;
+}
+
+void DataGridStore::clear() {
+    m_rowIds.clear();
+    m_selected.clear();
+    m_enabled.clear();
+    m_userData.clear();
+    m_columns.clear();
+    m_columnOrdinals.clear();
+    m_strings.clear();
+}
+
+DataGridRow DataGridStore::makeRow(size_t row) const {
+    DataGridRow result(m_rowIds[row]);
+    result.selected = isSelected(row);
+    result.enabled = isEnabled(row);
+    result.userData = m_userData[row];
+
+    for (size_t ordinal = 0; ordinal < m_columns.size(); ++ordinal) {
+        if (kind(row, ordinal) != CellKind::Empty) {
+            result.cells.emplace(m_columns[ordinal].id, getCell(row, ordinal));
+        }
+    }
+    return result;
+}
+
+size_t DataGridStore::findColumn(const std::string& id) const {
+    auto it = m_columnOrdinals.find(id);
+    return it != m_columnOrdinals.end() ? it->second : NO_COLUMN;
+}
+
+size_t DataGridStore::ensureColumn(const std::string& id) {
+    auto [it, inserted] = m_columnOrdinals.try_emplace(id, m_columns.size());
+    if (inserted) {
+        Column column;
+        column.id = id;
+        column.kinds.assign(m_rowIds.size(), CellKind::Empty);
+        column.payload.assign(m_rowIds.size(), 0);
+        m_columns.push_back(std::move(column));
+    }
+    return it->second;
+}
+
+CellValue DataGridStore::getCell(size_t row, size_t ordinal) const {
+    const Column& column = m_columns[ordinal];
+    switch (column.kinds[row]) {
+        case CellKind::String: return m_strings.get(column.stringId(row));
+        case CellKind::Number: return column.number(row);
+        case CellKind::Boolean: return column.boolean(row);
+        case CellKind::Integer: return column.integer(row);
+        case CellKind::Empty: break;
+    }
+    return CellValue{std::string{}};
+}
+
+bool DataGridStore::setCell(size_t row, size_t ordinal, const CellValue& value) {
+    return writeCell(m_columns[ordinal], row, value);
+}
+
+void DataGridStore::clearCell(size_t row, size_t ordinal) {
+    releaseCell(m_columns[ordinal], row);
+    m_columns[ordinal].kinds[row] = CellKind::Empty;
+    m_columns[ordinal].payload[row] = 0;
+}
+
+std::vector<uint32_t> DataGridStore::rankStrings(size_t ordinal) const {
+    const Column& column = m_columns[ordinal];
+    std::vector<uint32_t> ranks(m_strings.size(), UNRANKED);
+
+    // Distinct ids used by this column (marked in the rank table first)
+    std::vector<uint32_t> used;
+    for (size_t row = 0; row < column.kinds.size(); ++row) {
+        if (column.kinds[row] == CellKind::String) {
+            uint32_t id = column.stringId(row);
+            if (ranks[id] == UNRANKED) {
+                ranks[id] = 0;
+                used.push_back(id);
+            }
+        }
+    }
+
+    std::sort(used.begin(), used.end(), [this](uint32_t a, uint32_t b) {
+        return m_strings.get(a) < m_strings.get(b);
+    });
+
+    for (size_t rank = 0; rank < used.size(); ++rank) {
+        ranks[used[rank]] = static_cast<uint32_t>(rank);
+    }
+    return ranks;
+}
+
+bool DataGridStore::compactStrings() {
+    size_t dead = m_strings.deadCount();
+    if (dead < COMPACT_MIN_DEAD || dead < m_strings.size() - dead) {
+        return false;
+    }
+
+    std::vector<uint32_t> remap = m_strings.compact();
+    for (auto& column : m_columns) {
+        for (size_t row = 0; row < column.kinds.size(); ++row) {
+            if (column.kinds[row] == CellKind::String) {
+                column.payload[row] = remap[column.stringId(row)];
+            }
+        }
+    }
+    return true;
+}
+
+bool DataGridStore::writeCell(Column& column, size_t row, const CellValue& value) {
+    uint64_t bits = 0;
+    CellKind kind = CellKind::Empty;
+
+    if (const auto* text = std::get_if<std::string>(&value)) {
+        kind = CellKind::String;
+        bits = m_strings.intern(*text);
+    } else if (const auto* number = std::get_if<double>(&value)) {
+        kind = CellKind::Number;
+        std::memcpy(&bits, number, sizeof(bits));
+    } else if (const auto* flag = std::get_if<bool>(&value)) {
+        kind = CellKind::Boolean;
+        bits = *flag ? 1 : 0;
+    } else if (const auto* integer = std::get_if<int64_t>(&value)) {
+        kind = CellKind::Integer;
+        bits = static_cast<uint64_t>(*integer);
+    }
+
+    // Released after interning, so rewriting the same text never drops it
+    bool changed = column.kinds[row] != kind || column.payload[row] != bits;
+    releaseCell(column, row);
+    column.kinds[row] = kind;
+    column.payload[row] = bits;
+    return changed;
+}
+
+void DataGridStore::releaseCell(const Column& column, size_t row) {
+    if (column.kinds[row] == CellKind::String) {
+        m_strings.release(column.stringId(row));
+    }
+}
+
+// =============================================================================
+// DataGridFilterProgram
+// =============================================================================
+
+struct DataGridFilterProgram::Node {
+    FilterOp op = FilterOp::And;
+    std::string columnId;
+    size_t ordinal = DataGridStore::NO_COLUMN;   ///< Bound on first use
+
+    // Numeric operands, also kept as exact integers when all of them are
+    bool hasNumbers = false;
+    bool integral = false;
+    std::vector<double> numbers;
+    std::vector<int64_t> integers;
+
+    // Text operands, decided once per distinct string of the column
+    bool hasTexts = false;
+    std::vector<std::string> texts;
+    std::optional<std::regex> pattern;
+    std::vector<int8_t> stringMatches;           ///< Per string id: -1 unknown, 0 no, 1 yes
+
+    std::vector<Node> children;
+};
+
+namespace {
+
+using FilterNode = DataGridFilterProgram::Node;
+
+size_t operandCount(FilterOp op) {
+    return op == FilterOp::Between ? 2 : 1;
+}
+
+/**
+ * @brief Numeric test for one operation, resolved at compile time
+ */
+template<FilterOp Op, typename T>
+bool testNumber(T x, const std::vector<T>& operands) {
+    if constexpr (Op == FilterOp::Equal) return x == operands[0];
+    else if constexpr (Op == FilterOp::NotEqual) return x != operands[0];
+    else if constexpr (Op == FilterOp::Less) return x < operands[0];
+    else if constexpr (Op == FilterOp::LessEqual) return x <= operands[0];
+    else if constexpr (Op == FilterOp::Greater) return x > operands[0];
+    else if constexpr (Op == FilterOp::GreaterEqual) return x >= operands[0];
+    else if constexpr (Op == FilterOp::Between) return operands[0] <= x && x <= operands[1];
+    else if constexpr (Op == FilterOp::In) return std::binary_search(operands.begin(), operands.end(), x);
+    else return false;  // Prefix and Regex only apply to text
+}
+
+bool testText(const FilterNode& node, const std::string& text) {
+    const auto& operands = node.texts;
+    switch (node.op) {
+        case FilterOp::Equal: return text == operands[0];
+        case FilterOp::NotEqual: return text != operands[0];
+        case FilterOp::Less: return text < operands[0];
+        case FilterOp::LessEqual: return text <= operands[0];
+        case FilterOp::Greater: return text > operands[0];
+        case FilterOp::GreaterEqual: return text >= operands[0];
+        case FilterOp::Between: return operands[0] <= text && text <= operands[1];
+        case FilterOp::In: return std::binary_search(operands.begin(), operands.end(), text);
+        case FilterOp::Prefix: return text.starts_with(operands[0]);
+        case FilterOp::Regex: return node.pattern && std::regex_search(text, *node.pattern);
+        default: return false;
+    }
+}
+
+/**
+ * @brief Test rows of one column against a comparison
+ *
+ * Instantiated per operation so the inner loop is a plain compare on the
+ * payload for numeric cells and a table lookup for text cells.
+ */
+template<FilterOp Op>
+void scanColumn(FilterNode& node, const DataGridStore& store, const size_t* rows, size_t count, uint8_t* out) {
+    const auto& column = store.column(node.ordinal);
+    const CellKind* kinds = column.kinds.data();
+    const uint64_t* payload = column.payload.data();
+    const bool numeric = node.hasNumbers;
+    const bool integral = node.integral;
+
+    if (node.hasTexts && node.stringMatches.size() < store.strings().size()) {
+        node.stringMatches.resize(store.strings().size(), -1);
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        size_t row = rows ? rows[i] : i;
+        uint64_t bits = payload[row];
+        bool match = false;
+
+        switch (kinds[row]) {
+            case CellKind::Number: {
+                double value;
+                std::memcpy(&value, &bits, sizeof(value));
+                match = numeric && testNumber<Op>(value, node.numbers);
+                break;
+            }
+            case CellKind::Integer:
+            case CellKind::Boolean: {
+                auto value = static_cast<int64_t>(bits);
+                match = numeric && (integral ? testNumber<Op>(value, node.integers)
+                                             : testNumber<Op>(static_cast<double>(value), node.numbers));
+                break;
+            }
+            case CellKind::String: {
+                if (!node.hasTexts) break;
+                int8_t& known = node.stringMatches[static_cast<uint32_t>(bits)];
+                if (known < 0) {
+                    known = testText(node, store.strings().get(static_cast<uint32_t>(bits))) ? 1 : 0;
+                }
+                match = known != 0;
+                break;
+            }
+            case CellKind::Empty:
+                break;
+        }
+        out[i] = match ? 1 : 0;
+    }
+}
+
+void scanLeaf(FilterNode& node, const DataGridStore& store, const size_t* rows, size_t count, uint8_t* out) {
+    switch (node.op) {
+        case FilterOp::Equal: scanColumn<FilterOp::Equal>(node, store, rows, count, out); break;
+        case FilterOp::NotEqual: scanColumn<FilterOp::NotEqual>(node, store, rows, count, out); break;
+        case FilterOp::Less: scanColumn<FilterOp::Less>(node, store, rows, count, out); break;
+        case FilterOp::LessEqual: scanColumn<FilterOp::LessEqual>(node, store, rows, count, out); break;
+        case FilterOp::Greater: scanColumn<FilterOp::Greater>(node, store, rows, count, out); break;
+        case FilterOp::GreaterEqual: scanColumn<FilterOp::GreaterEqual>(node, store, rows, count, out); break;
+        case FilterOp::Between: scanColumn<FilterOp::Between>(node, store, rows, count, out); break;
+        case FilterOp::In: scanColumn<FilterOp::In>(node, store, rows, count, out); break;
+        default: scanColumn<FilterOp::Prefix>(node, store, rows, count, out); break;
+    }
+}
+
+FilterNode compileNode(const DataGridFilterExpr& expression) {
+    FilterNode node;
+    node.op = expression.op;
+
+    if (expression.op == FilterOp::And || expression.op == FilterOp::Or) {
+        for (const auto& child : expression.children) {
+            node.children.push_back(compileNode(child));
+        }
+        return node;
+    }
+
+    node.columnId = expression.columnId;
+    bool integral = true;
+    for (const auto& operand : expression.operands) {
+        if (const auto* text = std::get_if<std::string>(&operand)) {
+            node.texts.push_back(*text);
+        } else if (const auto* number = std::get_if<double>(&operand)) {
+            node.numbers.push_back(*number);
+            integral = false;
+        } else {
+            int64_t value = std::holds_alternative<bool>(operand) ? std::get<bool>(operand)
+                                                                  : std::get<int64_t>(operand);
+            node.numbers.push_back(static_cast<double>(value));
+            node.integers.push_back(value);
+        }
+    }
+
+    // In takes any number of operands of either kind; the rest need exactly
+    // their operand count in one kind
+    if (node.op == FilterOp::In) {
+        std::sort(node.numbers.begin(), node.numbers.end());
+        std::sort(node.integers.begin(), node.integers.end());
+        std::sort(node.texts.begin(), node.texts.end());
+        node.hasNumbers = !node.numbers.empty();
+        node.hasTexts = !node.texts.empty();
+    } else if (node.op == FilterOp::Prefix || node.op == FilterOp::Regex) {
+        node.hasTexts = node.texts.size() == 1;
+    } else {
+        node.hasNumbers = node.numbers.size() == operandCount(node.op);
+        node.hasTexts = node.texts.size() == operandCount(node.op);
+    }
+    node.integral = node.hasNumbers && integral;
+
+    if (node.op == FilterOp::Regex && node.hasTexts) {
+        try {
+            node.pattern.emplace(node.texts[0], std::regex::ECMAScript | std::regex::optimize);
+        } catch (const std::regex_error& e) {
+            log(LogLevel::Warning, "Invalid filter pattern \"" + node.texts[0] + "\": " + e.what());
+        }
+    }
+    return node;
+}
+
+void evaluateNode(FilterNode& node, const DataGridStore& store, const size_t* rows, size_t count, uint8_t* out) {
+    if (node.op != FilterOp::And && node.op != FilterOp::Or) {
+        if (node.ordinal == DataGridStore::NO_COLUMN) {
+            node.ordinal = store.findColumn(node.columnId);
+        }
+        if (node.ordinal == DataGridStore::NO_COLUMN) {
+            std::fill(out, out + count, uint8_t(0));  // No row has the cell
+        } else {
+            scanLeaf(node, store, rows, count, out);
+        }
+        return;
+    }
+
+    // And: later children only test rows still matching; Or: rows not yet matching
+    bool isAnd = node.op == FilterOp::And;
+    if (count == 1) {
+        // Single row (incremental updates): short-circuit without gathering
+        for (auto& child : node.children) {
+            evaluateNode(child, store, rows, 1, out);
+            if ((out[0] != 0) != isAnd) return;
+        }
+        out[0] = isAnd ? 1 : 0;
+        return;
+    }
+    std::fill(out, out + count, uint8_t(isAnd ? 1 : 0));
+
+    std::vector<size_t> pending;
+    std::vector<size_t> positions;
+    std::vector<uint8_t> results;
+    pending.reserve(count);
+    positions.reserve(count);
+    for (auto& child : node.children) {
+        pending.clear();
+        positions.clear();
+        for (size_t i = 0; i < count; ++i) {
+            if ((out[i] != 0) == isAnd) {
+                positions.push_back(i);
+                pending.push_back(rows ? rows[i] : i);
+            }
+        }
+        if (pending.empty()) break;
+
+        results.resize(pending.size());
+        evaluateNode(child, store, pending.data(), pending.size(), results.data());
+        for (size_t k = 0; k < positions.size(); ++k) {
+            out[positions[k]] = results[k];
+        }
+    }
+}
+
+void resetNode(FilterNode& node) {
+    node.ordinal = DataGridStore::NO_COLUMN;
+    node.stringMatches.clear();
+    for (auto& child : node.children) {
+        resetNode(child);
+    }
+}
+
+} // namespace
+
+DataGridFilterProgram::DataGridFilterProgram(const DataGridFilterExpr& expression)
+    : m_root(std::make_unique<Node>(compileNode(expression))) {}
+
+DataGridFilterProgram::~DataGridFilterProgram() = default;
+DataGridFilterProgram::DataGridFilterProgram(DataGridFilterProgram&&) noexcept = default;
+DataGridFilterProgram& DataGridFilterProgram::operator=(DataGridFilterProgram&&) noexcept = default;
+
+bool DataGridFilterProgram::matches(const DataGridStore& store, size_t row) {
+    uint8_t result;
+    evaluateNode(*m_root, store, &row, 1, &result);
+    return result != 0;
+}
+
+void DataGridFilterProgram::evaluate(const DataGridStore& store, const size_t* rows, size_t count, uint8_t* out) {
+    evaluateNode(*m_root, store, rows, count, out);
+}
+
+void DataGridFilterProgram::reset() {
+    resetNode(*m_root);
+}
+
+} // namespace KillerGK
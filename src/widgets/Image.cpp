@@ -4,6 +4,7 @@
  */
 
 #include "KillerGK/widgets/Image.hpp"
+#include "KillerGK/widgets/WidgetArena.hpp"
 #include <algorithm>
 #include <cmath>
 
@@ -47,7 +48,7 @@ struct Image::ImageData {
 
 Image::Image() 
     : Widget()
-    , m_imageData(std::make_shared<ImageData>()) 
+    , m_imageData(WidgetArena::makeShared<ImageData>()) 
 {
     // Images are transparent by default
     backgroundColor(Color::Transparent);
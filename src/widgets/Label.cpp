@@ -4,6 +4,7 @@
  */
 
 #include "KillerGK/widgets/Label.hpp"
+#include "KillerGK/widgets/WidgetArena.hpp"
 
 namespace KillerGK {
 
@@ -46,7 +47,7 @@ struct Label::LabelData {
 
 Label::Label() 
     : Widget()
-    , m_labelData(std::make_shared<LabelData>()) 
+    , m_labelData(WidgetArena::makeShared<LabelData>()) 
 {
     // Labels are transparent by default
     backgroundColor(Color::Transparent);
@@ -58,7 +59,7 @@ Label Label::create() {
 
 // Text Content
 Label& Label::text(const std::string& text) {
-    m_labelData->text = text;
+    if (assign(m_labelData->text, text)) invalidate(DirtyFlags::Layout | DirtyFlags::Paint);
     return *this;
 }
 
@@ -68,7 +69,7 @@ const std::string& Label::getText() const {
 
 // Text Styling
 Label& Label::textColor(const Color& color) {
-    m_labelData->textColor = color;
+    if (assign(m_labelData->textColor, color)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -77,7 +78,7 @@ const Color& Label::getTextColor() const {
 }
 
 Label& Label::fontSize(float size) {
-    m_labelData->fontSize = size;
+    if (assign(m_labelData->fontSize, size)) invalidate(DirtyFlags::Layout | DirtyFlags::Paint);
     return *this;
 }
 
@@ -86,7 +87,7 @@ float Label::getFontSize() const {
 }
 
 Label& Label::fontFamily(const std::string& family) {
-    m_labelData->fontFamily = family;
+    if (assign(m_labelData->fontFamily, family)) invalidate(DirtyFlags::Layout | DirtyFlags::Paint);
     return *this;
 }
 
@@ -95,7 +96,7 @@ const std::string& Label::getFontFamily() const {
 }
 
 Label& Label::fontWeight(FontWeight weight) {
-    m_labelData->fontWeight = weight;
+    if (assign(m_labelData->fontWeight, weight)) invalidate(DirtyFlags::Layout | DirtyFlags::Paint);
     return *this;
 }
 
@@ -104,7 +105,7 @@ FontWeight Label::getFontWeight() const {
 }
 
 Label& Label::fontStyle(FontStyle style) {
-    m_labelData->fontStyle = style;
+    if (assign(m_labelData->fontStyle, style)) invalidate(DirtyFlags::Layout | DirtyFlags::Paint);
     return *this;
 }
 
@@ -113,7 +114,7 @@ FontStyle Label::getFontStyle() const {
 }
 
 Label& Label::lineHeight(float height) {
-    m_labelData->lineHeight = height;
+    if (assign(m_labelData->lineHeight, height)) invalidate(DirtyFlags::Layout | DirtyFlags::Paint);
     return *this;
 }
 
@@ -122,7 +123,7 @@ float Label::getLineHeight() const {
 }
 
 Label& Label::letterSpacing(float spacing) {
-    m_labelData->letterSpacing = spacing;
+    if (assign(m_labelData->letterSpacing, spacing)) invalidate(DirtyFlags::Layout | DirtyFlags::Paint);
     return *this;
 }
 
@@ -132,7 +133,7 @@ float Label::getLetterSpacing() const {
 
 // Alignment
 Label& Label::alignment(TextAlignment align) {
-    m_labelData->alignment = align;
+    if (assign(m_labelData->alignment, align)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -141,7 +142,7 @@ TextAlignment Label::getAlignment() const {
 }
 
 Label& Label::verticalAlignment(VerticalAlignment align) {
-    m_labelData->verticalAlignment = align;
+    if (assign(m_labelData->verticalAlignment, align)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -151,10 +152,11 @@ VerticalAlignment Label::getVerticalAlignment() const {
 
 // Wrapping and Overflow
 Label& Label::wrap(bool enabled) {
-    m_labelData->wrap = enabled;
+    bool changed = assign(m_labelData->wrap, enabled);
     if (enabled) {
-        m_labelData->overflow = TextOverflow::Wrap;
+        changed |= assign(m_labelData->overflow, TextOverflow::Wrap);
     }
+    if (changed) invalidate(DirtyFlags::Layout | DirtyFlags::Paint);
     return *this;
 }
 
@@ -163,8 +165,9 @@ bool Label::isWrapping() const {
 }
 
 Label& Label::overflow(TextOverflow overflow) {
-    m_labelData->overflow = overflow;
-    m_labelData->wrap = (overflow == TextOverflow::Wrap);
+    bool changed = assign(m_labelData->overflow, overflow);
+    changed |= assign(m_labelData->wrap, overflow == TextOverflow::Wrap);
+    if (changed) invalidate(DirtyFlags::Layout | DirtyFlags::Paint);
     return *this;
 }
 
@@ -173,7 +176,7 @@ TextOverflow Label::getOverflow() const {
 }
 
 Label& Label::maxLines(int lines) {
-    m_labelData->maxLines = lines;
+    if (assign(m_labelData->maxLines, lines)) invalidate(DirtyFlags::Layout | DirtyFlags::Paint);
     return *this;
 }
 
@@ -183,7 +186,7 @@ int Label::getMaxLines() const {
 
 // Decoration
 Label& Label::underline(bool enabled) {
-    m_labelData->underline = enabled;
+    if (assign(m_labelData->underline, enabled)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -192,7 +195,7 @@ bool Label::hasUnderline() const {
 }
 
 Label& Label::strikethrough(bool enabled) {
-    m_labelData->strikethrough = enabled;
+    if (assign(m_labelData->strikethrough, enabled)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
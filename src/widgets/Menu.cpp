@@ -4,6 +4,7 @@
  */
 
 #include "KillerGK/widgets/Menu.hpp"
+#include "KillerGK/widgets/WidgetArena.hpp"
 #include <algorithm>
 #include <cctype>
 
@@ -24,7 +25,7 @@ struct MenuBar::MenuBarData {
 
 MenuBar::MenuBar()
     : Widget()
-    , m_menuBarData(std::make_shared<MenuBarData>())
+    , m_menuBarData(WidgetArena::makeShared<MenuBarData>())
 {
     height(28.0f);
     backgroundColor(Color(0.95f, 0.95f, 0.95f, 1.0f));
@@ -127,7 +128,7 @@ struct ContextMenu::ContextMenuData {
 
 ContextMenu::ContextMenu()
     : Widget()
-    , m_contextMenuData(std::make_shared<ContextMenuData>())
+    , m_contextMenuData(WidgetArena::makeShared<ContextMenuData>())
 {
     backgroundColor(Color(1.0f, 1.0f, 1.0f, 1.0f));
     borderWidth(1.0f);
@@ -322,7 +323,7 @@ struct CommandPalette::CommandPaletteData {
 
 CommandPalette::CommandPalette()
     : Widget()
-    , m_paletteData(std::make_shared<CommandPaletteData>())
+    , m_paletteData(WidgetArena::makeShared<CommandPaletteData>())
 {
     backgroundColor(Color(1.0f, 1.0f, 1.0f, 1.0f));
     borderRadius(8.0f);
@@ -4,6 +4,7 @@
  */
 
 #include "KillerGK/widgets/TabControl.hpp"
+#include "KillerGK/widgets/WidgetArena.hpp"
 #include <algorithm>
 
 namespace KillerGK {
@@ -47,7 +48,7 @@ struct TabControl::TabControlData {
 
 TabControl::TabControl()
     : Widget()
-    , m_tabData(std::make_shared<TabControlData>())
+    , m_tabData(WidgetArena::makeShared<TabControlData>())
 {
     backgroundColor(Color(1.0f, 1.0f, 1.0f, 1.0f));
 }
@@ -4,6 +4,7 @@
  */
 
 #include "KillerGK/widgets/TextField.hpp"
+#include "KillerGK/widgets/WidgetArena.hpp"
 #include <algorithm>
 
 namespace KillerGK {
@@ -56,7 +57,7 @@ std::string TextField::TextFieldData::clipboard;
 
 TextField::TextField() 
     : Widget()
-    , m_textFieldData(std::make_shared<TextFieldData>()) 
+    , m_textFieldData(WidgetArena::makeShared<TextFieldData>()) 
 {
     // Set default text field styling
     backgroundColor(Color::White);
@@ -72,12 +73,14 @@ TextField TextField::create() {
 
 // Text Content
 TextField& TextField::text(const std::string& text) {
+    bool changed;
     if (m_textFieldData->maxLength > 0 && 
         text.length() > static_cast<size_t>(m_textFieldData->maxLength)) {
-        m_textFieldData->text = text.substr(0, m_textFieldData->maxLength);
+        changed = assign(m_textFieldData->text, text.substr(0, m_textFieldData->maxLength));
     } else {
-        m_textFieldData->text = text;
+        changed = assign(m_textFieldData->text, text);
     }
+    if (changed) invalidate(DirtyFlags::Paint);
     
     // Ensure cursor is within bounds
     if (m_textFieldData->cursorPos > m_textFieldData->text.length()) {
@@ -102,7 +105,7 @@ const std::string& TextField::getText() const {
 }
 
 TextField& TextField::placeholder(const std::string& placeholder) {
-    m_textFieldData->placeholder = placeholder;
+    if (assign(m_textFieldData->placeholder, placeholder)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -111,7 +114,7 @@ const std::string& TextField::getPlaceholder() const {
 }
 
 TextField& TextField::label(const std::string& label) {
-    m_textFieldData->label = label;
+    if (assign(m_textFieldData->label, label)) invalidate(DirtyFlags::Layout | DirtyFlags::Paint);
     return *this;
 }
 
@@ -121,7 +124,7 @@ const std::string& TextField::getLabel() const {
 
 // Configuration
 TextField& TextField::multiline(bool enabled) {
-    m_textFieldData->isMultiline = enabled;
+    if (assign(m_textFieldData->isMultiline, enabled)) invalidate(DirtyFlags::Layout | DirtyFlags::Paint);
     return *this;
 }
 
@@ -134,7 +137,8 @@ TextField& TextField::maxLength(int length) {
     
     // Truncate existing text if needed
     if (length > 0 && m_textFieldData->text.length() > static_cast<size_t>(length)) {
-        m_textFieldData->text = m_textFieldData->text.substr(0, length);
+        m_textFieldData->text.resize(static_cast<size_t>(length));
+        invalidate(DirtyFlags::Paint);
         if (m_textFieldData->cursorPos > m_textFieldData->text.length()) {
             m_textFieldData->cursorPos = m_textFieldData->text.length();
         }
@@ -148,7 +152,7 @@ int TextField::getMaxLength() const {
 }
 
 TextField& TextField::password(bool isPassword) {
-    m_textFieldData->isPassword = isPassword;
+    if (assign(m_textFieldData->isPassword, isPassword)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -157,7 +161,7 @@ bool TextField::isPassword() const {
 }
 
 TextField& TextField::passwordChar(char maskChar) {
-    m_textFieldData->passwordChar = maskChar;
+    if (assign(m_textFieldData->passwordChar, maskChar)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -176,7 +180,7 @@ bool TextField::isReadOnly() const {
 
 // Prefix/Suffix
 TextField& TextField::prefix(Widget* widget) {
-    m_textFieldData->prefixWidget = widget;
+    if (assign(m_textFieldData->prefixWidget, widget)) invalidate(DirtyFlags::Layout | DirtyFlags::Paint);
     return *this;
 }
 
@@ -185,7 +189,7 @@ Widget* TextField::getPrefix() const {
 }
 
 TextField& TextField::suffix(Widget* widget) {
-    m_textFieldData->suffixWidget = widget;
+    if (assign(m_textFieldData->suffixWidget, widget)) invalidate(DirtyFlags::Layout | DirtyFlags::Paint);
     return *this;
 }
 
@@ -195,7 +199,9 @@ Widget* TextField::getSuffix() const {
 
 // Cursor and Selection
 TextField& TextField::cursorPosition(size_t pos) {
-    m_textFieldData->cursorPos = std::min(pos, m_textFieldData->text.length());
+    if (assign(m_textFieldData->cursorPos, std::min(pos, m_textFieldData->text.length()))) {
+        invalidate(DirtyFlags::Paint);
+    }
     return *this;
 }
 
@@ -204,8 +210,9 @@ size_t TextField::getCursorPosition() const {
 }
 
 TextField& TextField::selection(size_t start, size_t end) {
-    m_textFieldData->selection.start = std::min(start, m_textFieldData->text.length());
-    m_textFieldData->selection.end = std::min(end, m_textFieldData->text.length());
+    TextSelection clamped{std::min(start, m_textFieldData->text.length()),
+                          std::min(end, m_textFieldData->text.length())};
+    if (assign(m_textFieldData->selection, clamped)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -214,12 +221,12 @@ const TextSelection& TextField::getSelection() const {
 }
 
 void TextField::selectAll() {
-    m_textFieldData->selection.start = 0;
-    m_textFieldData->selection.end = m_textFieldData->text.length();
+    TextSelection all{0, m_textFieldData->text.length()};
+    if (assign(m_textFieldData->selection, all)) invalidate(DirtyFlags::Paint);
 }
 
 void TextField::clearSelection() {
-    m_textFieldData->selection = TextSelection{};
+    if (assign(m_textFieldData->selection, TextSelection{})) invalidate(DirtyFlags::Paint);
 }
 
 std::string TextField::getSelectedText() const {
@@ -264,8 +271,11 @@ void TextField::insertText(const std::string& insertText) {
     }
     
     // Insert text at cursor
-    m_textFieldData->text.insert(m_textFieldData->cursorPos, textToInsert);
-    m_textFieldData->cursorPos += textToInsert.length();
+    if (!textToInsert.empty()) {
+        m_textFieldData->text.insert(m_textFieldData->cursorPos, textToInsert);
+        m_textFieldData->cursorPos += textToInsert.length();
+        invalidate(DirtyFlags::Paint);
+    }
     
     // Clear redo history on new action
     m_textFieldData->redoHistory.clear();
@@ -293,12 +303,14 @@ void TextField::deleteText(bool forward) {
         // Delete character after cursor
         if (m_textFieldData->cursorPos < m_textFieldData->text.length()) {
             m_textFieldData->text.erase(m_textFieldData->cursorPos, 1);
+            invalidate(DirtyFlags::Paint);
         }
     } else {
         // Delete character before cursor (backspace)
         if (m_textFieldData->cursorPos > 0) {
             m_textFieldData->cursorPos--;
             m_textFieldData->text.erase(m_textFieldData->cursorPos, 1);
+            invalidate(DirtyFlags::Paint);
         }
     }
     
@@ -351,6 +363,7 @@ void TextField::undo() {
     m_textFieldData->text = prevState.text;
     m_textFieldData->cursorPos = prevState.cursorPos;
     m_textFieldData->selection = prevState.selection;
+    invalidate(DirtyFlags::Paint);
     m_textFieldData->undoHistory.pop_back();
     
     if (m_textFieldData->onChangeCallback) {
@@ -375,6 +388,7 @@ void TextField::redo() {
     m_textFieldData->text = redoState.text;
     m_textFieldData->cursorPos = redoState.cursorPos;
     m_textFieldData->selection = redoState.selection;
+    invalidate(DirtyFlags::Paint);
     m_textFieldData->redoHistory.pop_back();
     
     if (m_textFieldData->onChangeCallback) {
@@ -392,7 +406,7 @@ bool TextField::canRedo() const {
 
 // Styling
 TextField& TextField::textColor(const Color& color) {
-    m_textFieldData->textColor = color;
+    if (assign(m_textFieldData->textColor, color)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -401,7 +415,7 @@ const Color& TextField::getTextColor() const {
 }
 
 TextField& TextField::placeholderColor(const Color& color) {
-    m_textFieldData->placeholderColor = color;
+    if (assign(m_textFieldData->placeholderColor, color)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -410,7 +424,7 @@ const Color& TextField::getPlaceholderColor() const {
 }
 
 TextField& TextField::selectionColor(const Color& color) {
-    m_textFieldData->selectionColor = color;
+    if (assign(m_textFieldData->selectionColor, color)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -419,7 +433,7 @@ const Color& TextField::getSelectionColor() const {
 }
 
 TextField& TextField::cursorColor(const Color& color) {
-    m_textFieldData->cursorColor = color;
+    if (assign(m_textFieldData->cursorColor, color)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
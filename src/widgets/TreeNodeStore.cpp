@@ -0,0 +1,289 @@
+/**
+ * @file TreeNodeStore.cpp
+ * @brief TreeView node storage and id index implementation
+ */
+
+#include "KillerGK/widgets/TreeNodeStore.hpp"
+#include <algorithm>
+
+namespace KillerGK {
+
+// =============================================================================
+// Nodes
+// =============================================================================
+
+void TreeNodeStore::assign(const std::vector<TreeNode>& roots) {
+    m_roots = roots;
+    m_edited = false;
+    m_valid = false;  // Indexed on first lookup
+}
+
+void TreeNodeStore::clear() {
+    m_roots.clear();
+    m_entries.clear();
+    m_freeSlots.clear();
+    m_index.clear();
+    m_valid = true;
+    m_edited = false;
+    m_duplicates = false;
+    m_generation++;
+}
+
+void TreeNodeStore::rebuild() {
+    m_entries.clear();
+    m_freeSlots.clear();
+    m_index.clear();
+    m_duplicates = false;
+
+    // Preorder, so the first of several nodes with one id is the one indexed
+    struct Level {
+        const std::vector<TreeNode>* nodes;
+        uint32_t parent;
+        size_t next;
+    };
+    std::vector<Level> stack{{&m_roots, NO_NODE, 0}};
+    while (!stack.empty()) {
+        Level& level = stack.back();
+        if (level.next == level.nodes->size()) {
+            stack.pop_back();
+            continue;
+        }
+        size_t position = level.next++;
+        const TreeNode& node = (*level.nodes)[position];
+        uint32_t slot = allocate(node.id, level.parent, static_cast<uint32_t>(position));
+        if (!node.children.empty()) {
+            stack.push_back({&node.children, slot, 0});
+        }
+    }
+    m_valid = true;
+    m_edited = false;
+    m_generation++;
+}
+
+uint32_t TreeNodeStore::allocate(const std::string& id, uint32_t parent, uint32_t position) {
+    uint32_t slot;
+    if (!m_freeSlots.empty()) {
+        slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    } else {
+        slot = static_cast<uint32_t>(m_entries.size());
+        m_entries.emplace_back();
+    }
+
+    // A repeated id gets a slot (so its children can be reached) but no key
+    auto [it, inserted] = m_index.try_emplace(id, slot);
+    if (!inserted) {
+        m_duplicates = true;
+    }
+    m_entries[slot] = Entry{&it->first, parent, position};
+    return slot;
+}
+
+void TreeNodeStore::release(uint32_t slot) {
+    Entry& entry = m_entries[slot];
+    auto it = m_index.find(*entry.id);
+    if (it != m_index.end() && it->second == slot) {
+        m_index.erase(it);
+    }
+    entry = Entry{};
+    m_freeSlots.push_back(slot);
+}
+
+// =============================================================================
+// Lookup
+// =============================================================================
+
+uint32_t TreeNodeStore::find(const std::string& id) {
+    if (!m_valid) {
+        rebuild();
+    }
+
+    auto it = m_index.find(id);
+    if (it != m_index.end()) {
+        if (node(it->second)) return it->second;
+    } else if (!m_edited) {
+        return NO_NODE;
+    }
+
+    // The nodes were changed directly since they were indexed
+    rebuild();
+    it = m_index.find(id);
+    return it != m_index.end() ? it->second : NO_NODE;
+}
+
+uint32_t TreeNodeStore::slotOf(const TreeNode& node, uint32_t parent, size_t position) const {
+    auto matches = [&](uint32_t slot) {
+        const Entry& entry = m_entries[slot];
+        return entry.id && entry.parent == parent && entry.position == position && *entry.id == node.id;
+    };
+
+    auto it = m_index.find(node.id);
+    if (it != m_index.end() && matches(it->second)) return it->second;
+    if (!m_duplicates) return NO_NODE;
+
+    // Repeated ids have slots but no key of their own
+    for (uint32_t slot = 0; slot < m_entries.size(); ++slot) {
+        if (matches(slot)) return slot;
+    }
+    return NO_NODE;
+}
+
+TreeNode* TreeNodeStore::node(uint32_t slot) {
+    if (slot >= m_entries.size() || !m_entries[slot].id) return nullptr;
+
+    m_path.clear();
+    for (uint32_t s = slot; s != NO_NODE; s = m_entries[s].parent) {
+        if (m_path.size() > m_entries.size()) return nullptr;  // Stale entries formed a loop
+        m_path.push_back(s);
+    }
+
+    // Walk down from the roots, checking each node is still where it was indexed
+    std::vector<TreeNode>* level = &m_roots;
+    TreeNode* current = nullptr;
+    for (auto it = m_path.rbegin(); it != m_path.rend(); ++it) {
+        const Entry& entry = m_entries[*it];
+        if (!entry.id || entry.position >= level->size()) return nullptr;
+        current = &(*level)[entry.position];
+        if (current->id != *entry.id) return nullptr;
+        level = &current->children;
+    }
+    return current;
+}
+
+size_t TreeNodeStore::depth(uint32_t slot) const {
+    size_t result = 0;
+    for (uint32_t s = m_entries[slot].parent; s != NO_NODE && result <= m_entries.size(); s = m_entries[s].parent) {
+        result++;
+    }
+    return result;
+}
+
+bool TreeNodeStore::contains(uint32_t ancestor, uint32_t slot) const {
+    for (size_t steps = 0; slot != NO_NODE && steps <= m_entries.size(); ++steps) {
+        if (slot == ancestor) return true;
+        slot = m_entries[slot].parent;
+    }
+    return false;
+}
+
+// =============================================================================
+// Structure
+// =============================================================================
+
+std::vector<TreeNode>& TreeNodeStore::siblings(uint32_t parent) {
+    return parent == NO_NODE ? m_roots : node(parent)->children;
+}
+
+void TreeNodeStore::shiftSiblings(std::vector<TreeNode>& nodes, uint32_t parent, size_t from, int delta) {
+    for (size_t position = from; position < nodes.size(); ++position) {
+        auto it = m_index.find(nodes[position].id);
+        Entry* entry = it != m_index.end() ? &m_entries[it->second] : nullptr;
+        if (entry && entry->parent == parent && entry->position == static_cast<uint32_t>(position - delta)) {
+            entry->position = static_cast<uint32_t>(position);
+        } else {
+            m_valid = false;  // A repeated id, or edited directly: re-index on next lookup
+        }
+    }
+}
+
+uint32_t TreeNodeStore::indexSubtree(const TreeNode& node, uint32_t parent, uint32_t position) {
+    uint32_t slot = allocate(node.id, parent, position);
+    for (size_t i = 0; i < node.children.size(); ++i) {
+        indexSubtree(node.children[i], slot, static_cast<uint32_t>(i));
+    }
+    return slot;
+}
+
+void TreeNodeStore::releaseSubtree(uint32_t slot, const TreeNode& node, std::vector<std::string>* removedIds) {
+    for (size_t i = 0; i < node.children.size(); ++i) {
+        const TreeNode& child = node.children[i];
+        auto it = m_index.find(child.id);
+        if (it != m_index.end() && m_entries[it->second].parent == slot &&
+            m_entries[it->second].position == i) {
+            releaseSubtree(it->second, child, removedIds);
+        } else if (removedIds) {
+            removedIds->push_back(child.id);  // Not indexed here; left for the next rebuild
+        }
+    }
+    if (removedIds) {
+        removedIds->push_back(node.id);
+    }
+    release(slot);
+}
+
+uint32_t TreeNodeStore::insert(uint32_t parent, size_t index, TreeNode node) {
+    if (!m_valid) {
+        rebuild();
+    }
+
+    auto& nodes = siblings(parent);
+    size_t position = std::min(index, nodes.size());
+    nodes.insert(nodes.begin() + static_cast<std::ptrdiff_t>(position), std::move(node));
+    shiftSiblings(nodes, parent, position + 1, 1);
+    return indexSubtree(nodes[position], parent, static_cast<uint32_t>(position));
+}
+
+void TreeNodeStore::remove(uint32_t slot, std::vector<std::string>* removedIds) {
+    uint32_t parent = m_entries[slot].parent;
+    size_t position = m_entries[slot].position;
+    auto& nodes = siblings(parent);
+
+    if (m_duplicates) {
+        // Slots of repeated ids share keys with other nodes; start over instead
+        if (removedIds) {
+            std::vector<const TreeNode*> stack{&nodes[position]};
+            while (!stack.empty()) {
+                const TreeNode* current = stack.back();
+                stack.pop_back();
+                removedIds->push_back(current->id);
+                for (const auto& child : current->children) {
+                    stack.push_back(&child);
+                }
+            }
+        }
+        nodes.erase(nodes.begin() + static_cast<std::ptrdiff_t>(position));
+        m_valid = false;
+        return;
+    }
+
+    releaseSubtree(slot, nodes[position], removedIds);
+    nodes.erase(nodes.begin() + static_cast<std::ptrdiff_t>(position));
+    shiftSiblings(nodes, parent, position, -1);
+}
+
+bool TreeNodeStore::move(uint32_t slot, uint32_t parent, size_t index) {
+    if (parent != NO_NODE && contains(slot, parent)) {
+        return false;
+    }
+
+    // Only the moved node's entry and the shifted siblings change: descendants
+    // are addressed relative to it
+    uint32_t oldParent = m_entries[slot].parent;
+    size_t oldPosition = m_entries[slot].position;
+
+    // Path to the new parent, as positions from the roots once the node is taken out
+    std::vector<size_t> path;
+    for (uint32_t s = parent; s != NO_NODE; s = m_entries[s].parent) {
+        size_t position = m_entries[s].position;
+        path.push_back(m_entries[s].parent == oldParent && position > oldPosition ? position - 1 : position);
+    }
+
+    auto& from = siblings(oldParent);
+    TreeNode moving = std::move(from[oldPosition]);
+    from.erase(from.begin() + static_cast<std::ptrdiff_t>(oldPosition));
+    shiftSiblings(from, oldParent, oldPosition, -1);
+
+    std::vector<TreeNode>* to = &m_roots;
+    for (auto it = path.rbegin(); it != path.rend(); ++it) {
+        to = &(*to)[*it].children;
+    }
+    size_t position = std::min(index, to->size());
+    to->insert(to->begin() + static_cast<std::ptrdiff_t>(position), std::move(moving));
+    shiftSiblings(*to, parent, position + 1, 1);
+
+    m_entries[slot].parent = parent;
+    m_entries[slot].position = static_cast<uint32_t>(position);
+    return true;
+}
+
+} // namespace KillerGK
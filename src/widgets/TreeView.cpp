@@ -4,17 +4,108 @@
  */
 
 #include "KillerGK/widgets/TreeView.hpp"
+#include "KillerGK/widgets/TreeNodeStore.hpp"
+#include "KillerGK/widgets/WidgetArena.hpp"
 #include <algorithm>
+#include <atomic>
+#include <limits>
+#include <string_view>
+#include <thread>
+#include <unordered_set>
 
 namespace KillerGK {
 
+namespace {
+
+constexpr uint32_t NO_POSITION = static_cast<uint32_t>(-1);
+
+char lowerAscii(char c) {
+    return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+/**
+ * @brief Snapshot of every loaded node, in preorder, for filtering
+ *
+ * Immutable once built, so a worker thread can match against it while the
+ * nodes themselves change. Nodes are addressed by preorder position.
+ */
+struct TreeFilterIndex {
+    std::vector<uint32_t> slots;             ///< Store slot of each node
+    std::vector<uint32_t> parents;           ///< Parent's position, NO_POSITION for roots
+    std::vector<uint32_t> depths;
+    std::vector<size_t> textOffsets;         ///< Into text; one more than there are nodes
+    std::string text;                        ///< Lower-cased node texts, back to back
+    std::vector<uint32_t> positions;         ///< Position by slot, NO_POSITION if not indexed
+
+    [[nodiscard]] size_t size() const { return slots.size(); }
+
+    [[nodiscard]] std::string_view nodeText(uint32_t position) const {
+        return std::string_view(text).substr(textOffsets[position],
+                                             textOffsets[position + 1] - textOffsets[position]);
+    }
+};
+
+/**
+ * @brief One filter query being matched, on the calling thread or a worker
+ */
+struct TreeFilterJob {
+    std::shared_ptr<const TreeFilterIndex> index;
+    std::string query;                       ///< Lower-cased
+    bool allNodes = true;                    ///< Test every node, or only the candidates
+    std::vector<uint32_t> candidates;        ///< Positions to test, in order
+
+    std::vector<uint32_t> matches;           ///< Positions of matching nodes, in order
+    std::vector<uint32_t> shown;             ///< Matches and their ancestors, in order
+    std::atomic<bool> cancelled{false};
+    std::atomic<bool> done{false};
+    std::thread worker;
+
+    void run() {
+        const TreeFilterIndex& nodes = *index;
+        size_t count = allNodes ? nodes.size() : candidates.size();
+        for (size_t i = 0; i < count; ++i) {
+            if ((i & 4095) == 0 && cancelled.load(std::memory_order_relaxed)) return;
+            auto position = allNodes ? static_cast<uint32_t>(i) : candidates[i];
+            if (nodes.nodeText(position).find(query) != std::string_view::npos) {
+                matches.push_back(position);
+            }
+        }
+
+        // Walk up from each match only until reaching an ancestor already marked
+        std::vector<uint8_t> marked(nodes.size(), 0);
+        for (uint32_t match : matches) {
+            for (uint32_t p = match; p != NO_POSITION && !marked[p]; p = nodes.parents[p]) {
+                marked[p] = 1;
+                shown.push_back(p);
+            }
+        }
+        std::sort(shown.begin(), shown.end());
+        done.store(true, std::memory_order_release);
+    }
+};
+
+} // namespace
+
 // =============================================================================
 // TreeViewData - Internal data structure
 // =============================================================================
 
 struct TreeView::TreeViewData {
-    std::vector<TreeNode> nodes;
-    std::vector<std::string> selectedIds;
+    static constexpr size_t NO_ROW = static_cast<size_t>(-1);
+    
+    /**
+     * @brief A displayed node, by slot
+     */
+    struct Row {
+        uint32_t slot;
+        uint32_t depth;
+    };
+    
+    TreeNodeStore store;
+    ChildLoader childLoader;
+    std::vector<std::string> selectedIds;               ///< In selection order
+    std::unordered_set<std::string> selectedSet;        ///< Same ids, for membership tests
+    bool unlistedSelection = false;                     ///< Nodes were passed in already selected
     bool multiSelectEnabled = false;
     bool dragDropEnabled = true;
     
@@ -30,6 +121,26 @@ struct TreeView::TreeViewData {
     // Scrolling
     float scrollOffset = 0.0f;
     
+    // Displayed rows, maintained incrementally once built
+    std::vector<Row> rows;
+    std::vector<uint32_t> rowSpans;     ///< Per slot: rows taken by a displayed node and its displayed descendants
+    std::vector<uint32_t> rowPath;      ///< Scratch for rowOf()
+    uint64_t rowsGeneration = 0;        ///< Store generation the row slots belong to
+    bool rowsValid = false;
+    
+    // Filtering
+    std::string filterText;                             ///< As given
+    std::string filterQuery;                            ///< Lower-cased; empty when not filtering
+    std::shared_ptr<const TreeFilterIndex> filterIndex;
+    uint64_t filterIndexGeneration = 0;                 ///< Store generation the index slots belong to
+    std::string matchedQuery;                           ///< Query filterMatches were found for
+    std::vector<uint32_t> filterMatches;
+    std::vector<uint32_t> filterShown;                  ///< Positions of the rows, when filterRowsShown
+    std::vector<uint8_t> filterRowMatched;              ///< Per row, when filterRowsShown
+    bool filterRowsShown = false;                       ///< Rows hold a filter result
+    std::unique_ptr<TreeFilterJob> filterJob;
+    size_t backgroundFilterThreshold = 100000;
+    
     // Custom renderer
     NodeRenderer customRenderer;
     
@@ -40,52 +151,32 @@ struct TreeView::TreeViewData {
     std::function<void(const TreeNode&)> onDragStartCallback;
     std::function<void(const TreeDragData&)> onDropCallback;
     
-    // Helper to find node recursively
-    TreeNode* findNodeRecursive(std::vector<TreeNode>& nodeList, const std::string& id) {
-        for (auto& node : nodeList) {
-            if (node.id == id) return &node;
-            if (auto* found = findNodeRecursive(node.children, id)) return found;
-        }
-        return nullptr;
+    ~TreeViewData() {
+        cancelFilterJob();
     }
     
-    const TreeNode* findNodeRecursive(const std::vector<TreeNode>& nodeList, const std::string& id) const {
-        for (const auto& node : nodeList) {
-            if (node.id == id) return &node;
-            if (const auto* found = findNodeRecursive(node.children, id)) return found;
-        }
-        return nullptr;
+    TreeNode* findNode(const std::string& id) {
+        uint32_t slot = store.find(id);
+        return slot != TreeNodeStore::NO_NODE ? store.node(slot) : nullptr;
     }
     
-    // Helper to find parent
-    TreeNode* findParentRecursive(std::vector<TreeNode>& nodeList, const std::string& childId) {
-        for (auto& node : nodeList) {
-            for (const auto& child : node.children) {
-                if (child.id == childId) return &node;
-            }
-            if (auto* found = findParentRecursive(node.children, childId)) return found;
-        }
-        return nullptr;
+    TreeNode* findNode(const std::string& id, uint32_t& slot) {
+        slot = store.find(id);
+        return slot != TreeNodeStore::NO_NODE ? store.node(slot) : nullptr;
     }
     
-    // Helper to remove node
-    bool removeNodeRecursive(std::vector<TreeNode>& nodeList, const std::string& id) {
-        auto it = std::remove_if(nodeList.begin(), nodeList.end(),
-            [&id](const TreeNode& node) { return node.id == id; });
-        if (it != nodeList.end()) {
-            nodeList.erase(it, nodeList.end());
-            return true;
-        }
-        for (auto& node : nodeList) {
-            if (removeNodeRecursive(node.children, id)) return true;
+    // Helper to check for nodes passed in with selected set
+    static bool anySelected(const std::vector<TreeNode>& nodeList) {
+        for (const auto& node : nodeList) {
+            if (node.selected || anySelected(node.children)) return true;
         }
         return false;
     }
     
-    // Helper to expand/collapse recursively
+    // Helper to expand/collapse recursively; nodes with pending children stay collapsed
     void setExpandedRecursive(std::vector<TreeNode>& nodeList, bool expanded) {
         for (auto& node : nodeList) {
-            node.expanded = expanded;
+            node.expanded = expanded && !node.childrenPending;
             setExpandedRecursive(node.children, expanded);
         }
     }
@@ -97,6 +188,516 @@ struct TreeView::TreeViewData {
             clearSelectionRecursive(node.children);
         }
     }
+    
+    /**
+     * @brief Deselect every node, visiting only the selected ones when possible
+     * @return true if any node may have been selected
+     */
+    bool clearSelection() {
+        bool cleared = unlistedSelection || !selectedIds.empty();
+        if (unlistedSelection) {
+            clearSelectionRecursive(store.roots());
+            unlistedSelection = false;
+        } else {
+            for (const auto& id : selectedIds) {
+                if (auto* node = findNode(id)) {
+                    node->selected = false;
+                }
+            }
+        }
+        selectedIds.clear();
+        selectedSet.clear();
+        return cleared;
+    }
+    
+    /**
+     * @brief Replace pending children with the loader's result
+     * @return true if children were loaded
+     */
+    bool loadChildren(uint32_t slot, TreeNode& node) {
+        if (!node.childrenPending || !childLoader) return false;
+        
+        std::vector<TreeNode> children = childLoader(node);
+        node.childrenPending = false;
+        nodesChanged();
+        for (auto& child : children) {
+            if (!unlistedSelection) {
+                unlistedSelection = child.selected || anySelected(child.children);
+            }
+            store.insert(slot, std::numeric_limits<size_t>::max(), std::move(child));
+        }
+        return true;
+    }
+    
+    // =========================================================================
+    // Rows
+    // =========================================================================
+    
+    /**
+     * @brief Check the rows can be updated in place
+     */
+    [[nodiscard]] bool rowsCurrent() const {
+        return rowsValid && filterQuery.empty() && rowsGeneration == store.generation() && store.isValid();
+    }
+    
+    [[nodiscard]] uint32_t span(uint32_t slot) const {
+        return slot < rowSpans.size() ? std::max(rowSpans[slot], 1u) : 1u;
+    }
+    
+    void setSpan(uint32_t slot, size_t count) {
+        if (slot >= rowSpans.size()) {
+            rowSpans.resize(std::max(store.slotCount(), static_cast<size_t>(slot) + 1), 1);
+        }
+        rowSpans[slot] = static_cast<uint32_t>(count);
+    }
+    
+    /**
+     * @brief Add to the spans of a node and its ancestors
+     */
+    void addSpan(uint32_t slot, int64_t delta) {
+        for (size_t steps = 0; slot < rowSpans.size() && steps < rowSpans.size(); ++steps) {
+            rowSpans[slot] = static_cast<uint32_t>(rowSpans[slot] + delta);
+            slot = store.parent(slot);
+        }
+    }
+    
+    /**
+     * @brief Append rows for a displayed node and its displayed descendants
+     * @return false if a node is not where the index has it
+     */
+    bool appendRows(std::vector<Row>& out, const TreeNode& node, uint32_t slot, uint32_t depth) {
+        struct Level {
+            const TreeNode* node;
+            uint32_t slot;
+            size_t firstRow;
+            size_t next;
+        };
+        
+        std::vector<Level> stack{{&node, slot, out.size(), 0}};
+        out.push_back({slot, depth});
+        while (!stack.empty()) {
+            Level& level = stack.back();
+            const TreeNode& current = *level.node;
+            if (!current.expanded || level.next == current.children.size()) {
+                setSpan(level.slot, out.size() - level.firstRow);
+                stack.pop_back();
+                continue;
+            }
+            
+            size_t position = level.next++;
+            const TreeNode& child = current.children[position];
+            uint32_t childSlot = store.slotOf(child, level.slot, position);
+            if (childSlot == TreeNodeStore::NO_NODE) return false;
+            
+            uint32_t childDepth = depth + static_cast<uint32_t>(stack.size());
+            stack.push_back({&child, childSlot, out.size(), 0});
+            out.push_back({childSlot, childDepth});
+        }
+        return true;
+    }
+    
+    bool layoutRows() {
+        rows.clear();
+        const auto& roots = store.roots();
+        for (size_t i = 0; i < roots.size(); ++i) {
+            uint32_t slot = store.slotOf(roots[i], TreeNodeStore::NO_NODE, i);
+            if (slot == TreeNodeStore::NO_NODE || !appendRows(rows, roots[i], slot, 0)) return false;
+        }
+        return true;
+    }
+    
+    /**
+     * @brief Build the rows if they are not up to date
+     */
+    void syncRows() {
+        if (!filterQuery.empty()) {
+            syncFilterRows();
+            return;
+        }
+        if (rowsCurrent()) return;
+        
+        store.validate();
+        if (!layoutRows()) {
+            // Nodes were edited directly since they were indexed
+            store.reindex();
+            layoutRows();
+        }
+        rowsGeneration = store.generation();
+        rowsValid = true;
+        filterRowsShown = false;
+    }
+    
+    size_t invalidateRows() {
+        rowsValid = false;
+        return NO_ROW;
+    }
+    
+    /**
+     * @brief Find a node's row by walking down from its root
+     *
+     * Skips over earlier siblings by their spans, so only the node's
+     * ancestors and their preceding siblings are visited.
+     *
+     * @param place Return the row the node's rows belong at instead of
+     *              requiring them to be listed (for nodes just inserted)
+     * @return Row index, or NO_ROW if an ancestor is collapsed (or the rows
+     *         turned out to be out of date, which invalidates them)
+     */
+    size_t rowOf(uint32_t slot, bool place = false) {
+        rowPath.clear();
+        for (uint32_t s = slot; s != TreeNodeStore::NO_NODE; s = store.parent(s)) {
+            if (rowPath.size() > store.slotCount()) return invalidateRows();
+            rowPath.push_back(s);
+        }
+        
+        const std::vector<TreeNode>* level = &store.roots();
+        size_t row = 0;
+        for (auto it = rowPath.rbegin(); it != rowPath.rend(); ++it) {
+            size_t position = store.position(*it);
+            if (position >= level->size()) return invalidateRows();
+            for (size_t i = 0; i < position; ++i) {
+                if (row >= rows.size()) return invalidateRows();
+                row += span(rows[row].slot);
+            }
+            
+            bool last = it + 1 == rowPath.rend();
+            if (last && place) {
+                return row <= rows.size() ? row : invalidateRows();
+            }
+            if (row >= rows.size() || rows[row].slot != *it) return invalidateRows();
+            if (last) return row;
+            
+            const TreeNode& node = (*level)[position];
+            if (!node.expanded) return NO_ROW;
+            level = &node.children;
+            row++;
+        }
+        return NO_ROW;
+    }
+    
+    /**
+     * @brief Overwrite count rows from first with new ones, shifting the rest once
+     */
+    void spliceRows(size_t first, size_t count, const std::vector<Row>& fresh) {
+        size_t common = std::min(count, fresh.size());
+        std::copy_n(fresh.begin(), common, rows.begin() + static_cast<std::ptrdiff_t>(first));
+        auto at = rows.begin() + static_cast<std::ptrdiff_t>(first + common);
+        if (fresh.size() > count) {
+            rows.insert(at, fresh.begin() + static_cast<std::ptrdiff_t>(common), fresh.end());
+        } else {
+            rows.erase(at, at + static_cast<std::ptrdiff_t>(count - common));
+        }
+    }
+    
+    /**
+     * @brief Lay out a displayed node's rows again (after expanding or collapsing it)
+     */
+    void relayoutRows(uint32_t slot, const TreeNode& node) {
+        if (!rowsCurrent()) return;
+        size_t row = rowOf(slot);
+        if (row == NO_ROW) return;
+        
+        uint32_t oldSpan = span(slot);
+        std::vector<Row> fresh;
+        if (!appendRows(fresh, node, slot, rows[row].depth)) {
+            invalidateRows();
+            return;
+        }
+        spliceRows(row, oldSpan, fresh);
+        addSpan(store.parent(slot), static_cast<int64_t>(fresh.size()) - oldSpan);
+    }
+    
+    /**
+     * @brief Take a node's rows out before it is removed or moved
+     * @param removed Receives the rows (optional)
+     */
+    void hideRows(uint32_t slot, std::vector<Row>* removed = nullptr) {
+        if (!rowsCurrent()) return;
+        size_t row = rowOf(slot);
+        if (row == NO_ROW) return;
+        
+        uint32_t count = span(slot);
+        if (row + count > rows.size()) {
+            invalidateRows();
+            return;
+        }
+        auto first = rows.begin() + static_cast<std::ptrdiff_t>(row);
+        if (removed) {
+            removed->assign(first, first + count);
+        }
+        rows.erase(first, first + count);
+        addSpan(store.parent(slot), -static_cast<int64_t>(count));
+    }
+    
+    /**
+     * @brief Put in rows for a node just inserted or moved
+     * @param moved Rows the node had before it moved, if any
+     */
+    void showRows(uint32_t slot, std::vector<Row>* moved = nullptr) {
+        if (!rowsCurrent()) return;
+        size_t row = rowOf(slot, true);
+        if (row == NO_ROW) return;
+        
+        auto depth = static_cast<uint32_t>(store.depth(slot));
+        std::vector<Row> fresh;
+        if (moved && !moved->empty()) {
+            // Same rows, at the new depth
+            int64_t delta = static_cast<int64_t>(depth) - (*moved)[0].depth;
+            for (auto& r : *moved) {
+                r.depth = static_cast<uint32_t>(r.depth + delta);
+            }
+            fresh = std::move(*moved);
+        } else {
+            const TreeNode* node = store.node(slot);
+            if (!node || !appendRows(fresh, *node, slot, depth)) {
+                invalidateRows();
+                return;
+            }
+        }
+        rows.insert(rows.begin() + static_cast<std::ptrdiff_t>(row), fresh.begin(), fresh.end());
+        addSpan(store.parent(slot), static_cast<int64_t>(fresh.size()));
+    }
+    
+    /**
+     * @brief Get the node on a row, rebuilding the rows if nodes were edited directly
+     */
+    const TreeNode* rowNode(size_t row) {
+        if (const TreeNode* node = store.node(rows[row].slot)) return node;
+        store.reindex();
+        syncRows();
+        return row < rows.size() ? store.node(rows[row].slot) : nullptr;
+    }
+    
+    /**
+     * @brief Get a node's row
+     * @return Row index, or NO_ROW if not displayed
+     */
+    size_t findRow(const std::string& id) {
+        if (!filterQuery.empty()) return findFilterRow(id);
+        
+        for (int attempt = 0; attempt < 2; ++attempt) {
+            uint32_t slot = store.find(id);
+            if (slot == TreeNodeStore::NO_NODE) return NO_ROW;
+            
+            uint64_t generation = store.generation();
+            syncRows();
+            if (store.generation() != generation) continue;  // Re-indexed
+            
+            size_t row = rowOf(slot);
+            if (row != NO_ROW || rowsValid) return row;
+        }
+        return NO_ROW;
+    }
+    
+    // =========================================================================
+    // Filtering
+    // =========================================================================
+    
+    /**
+     * @brief Add every loaded node to a filter index
+     * @return false if a node is not where the store's index has it
+     */
+    bool indexNodes(TreeFilterIndex& index) {
+        struct Level {
+            const std::vector<TreeNode>* nodes;
+            uint32_t parentSlot;
+            uint32_t parentPosition;
+            uint32_t depth;
+            size_t next;
+        };
+        
+        index.textOffsets.push_back(0);
+        std::vector<Level> stack{{&store.roots(), TreeNodeStore::NO_NODE, NO_POSITION, 0, 0}};
+        while (!stack.empty()) {
+            Level& level = stack.back();
+            if (level.next == level.nodes->size()) {
+                stack.pop_back();
+                continue;
+            }
+            
+            size_t position = level.next++;
+            const TreeNode& node = (*level.nodes)[position];
+            uint32_t slot = store.slotOf(node, level.parentSlot, position);
+            if (slot == TreeNodeStore::NO_NODE) return false;
+            
+            auto indexed = static_cast<uint32_t>(index.slots.size());
+            uint32_t depth = level.depth;
+            index.slots.push_back(slot);
+            index.parents.push_back(level.parentPosition);
+            index.depths.push_back(depth);
+            for (char c : node.text) {
+                index.text.push_back(lowerAscii(c));
+            }
+            index.textOffsets.push_back(index.text.size());
+            if (!node.children.empty()) {
+                stack.push_back({&node.children, slot, indexed, depth + 1, 0});
+            }
+        }
+        
+        index.positions.assign(store.slotCount(), NO_POSITION);
+        for (size_t i = 0; i < index.slots.size(); ++i) {
+            index.positions[index.slots[i]] = static_cast<uint32_t>(i);
+        }
+        return true;
+    }
+    
+    void buildFilterIndex() {
+        store.validate();
+        auto index = std::make_shared<TreeFilterIndex>();
+        if (!indexNodes(*index)) {
+            store.reindex();
+            index = std::make_shared<TreeFilterIndex>();
+            indexNodes(*index);
+        }
+        filterIndex = std::move(index);
+        filterIndexGeneration = store.generation();
+        matchedQuery.clear();
+        filterMatches.clear();
+    }
+    
+    void cancelFilterJob() {
+        if (!filterJob) return;
+        filterJob->cancelled = true;
+        if (filterJob->worker.joinable()) {
+            filterJob->worker.join();
+        }
+        filterJob.reset();
+    }
+    
+    /**
+     * @brief Forget filter results after nodes were added, removed, moved or edited
+     */
+    void nodesChanged() {
+        if (!filterIndex && !filterJob) return;
+        cancelFilterJob();
+        filterIndex.reset();
+        matchedQuery.clear();
+        filterMatches.clear();
+        if (!filterQuery.empty()) {
+            rows.clear();
+            filterShown.clear();
+            filterRowMatched.clear();
+            filterRowsShown = false;
+        }
+    }
+    
+    /**
+     * @brief Make a finished job's result the rows
+     */
+    void adoptFilter() {
+        TreeFilterJob& job = *filterJob;
+        if (job.worker.joinable()) {
+            job.worker.join();
+        }
+        
+        matchedQuery = job.query;
+        filterMatches = std::move(job.matches);
+        filterShown = std::move(job.shown);
+        
+        rows.clear();
+        rows.reserve(filterShown.size());
+        filterRowMatched.assign(filterShown.size(), 0);
+        size_t match = 0;
+        for (size_t i = 0; i < filterShown.size(); ++i) {
+            uint32_t position = filterShown[i];
+            rows.push_back({filterIndex->slots[position], filterIndex->depths[position]});
+            if (match < filterMatches.size() && filterMatches[match] == position) {
+                filterRowMatched[i] = 1;
+                match++;
+            }
+        }
+        rowsGeneration = filterIndexGeneration;
+        filterRowsShown = true;
+        filterJob.reset();
+    }
+    
+    void startFilter() {
+        cancelFilterJob();
+        
+        auto job = std::make_unique<TreeFilterJob>();
+        job->index = filterIndex;
+        job->query = filterQuery;
+        if (!matchedQuery.empty() && filterQuery.find(matchedQuery) != std::string::npos) {
+            // Only nodes that matched the shorter query can match this one
+            job->allNodes = false;
+            job->candidates = filterMatches;
+        }
+        size_t count = job->allNodes ? filterIndex->size() : job->candidates.size();
+        filterJob = std::move(job);
+        
+        if (backgroundFilterThreshold != 0 && count >= backgroundFilterThreshold) {
+            TreeFilterJob* pending = filterJob.get();
+            pending->worker = std::thread([pending] { pending->run(); });
+        } else {
+            filterJob->run();
+            adoptFilter();
+        }
+    }
+    
+    /**
+     * @brief Bring the filter rows up to date, without waiting for a worker
+     */
+    void syncFilterRows() {
+        rowsValid = false;
+        if (!filterIndex || filterIndexGeneration != store.generation() || !store.isValid()) {
+            cancelFilterJob();
+            buildFilterIndex();
+        }
+        if (rowsGeneration != store.generation()) {
+            // Slots from before a re-index
+            rows.clear();
+            filterRowsShown = false;
+        }
+        
+        if (filterJob && filterJob->done.load(std::memory_order_acquire)) {
+            adoptFilter();
+        }
+        bool current = filterJob ? filterJob->query == filterQuery : matchedQuery == filterQuery;
+        if (!current) {
+            startFilter();
+        }
+    }
+    
+    size_t findFilterRow(const std::string& id) {
+        uint32_t slot = store.find(id);
+        if (slot == TreeNodeStore::NO_NODE) return NO_ROW;
+        
+        uint64_t generation = store.generation();
+        syncRows();
+        if (store.generation() != generation) {
+            slot = store.find(id);
+            if (slot == TreeNodeStore::NO_NODE) return NO_ROW;
+        }
+        
+        if (!filterRowsShown) {
+            // Still showing the rows from before filtering
+            for (size_t row = 0; row < rows.size(); ++row) {
+                if (rows[row].slot == slot) return row;
+            }
+            return NO_ROW;
+        }
+        if (slot >= filterIndex->positions.size()) return NO_ROW;
+        uint32_t position = filterIndex->positions[slot];
+        auto it = std::lower_bound(filterShown.begin(), filterShown.end(), position);
+        if (it == filterShown.end() || *it != position) return NO_ROW;
+        return static_cast<size_t>(it - filterShown.begin());
+    }
+    
+    /**
+     * @brief Drop ids of removed nodes from the selection
+     */
+    void forgetSelected(const std::vector<std::string>& ids) {
+        bool removed = false;
+        for (const auto& id : ids) {
+            removed = selectedSet.erase(id) > 0 || removed;
+        }
+        if (removed) {
+            selectedIds.erase(
+                std::remove_if(selectedIds.begin(), selectedIds.end(),
+                    [this](const std::string& id) { return !selectedSet.count(id); }),
+                selectedIds.end());
+        }
+    }
 };
 
 // =============================================================================
@@ -105,7 +706,7 @@ struct TreeView::TreeViewData {
 
 TreeView::TreeView()
     : Widget()
-    , m_treeData(std::make_shared<TreeViewData>())
+    , m_treeData(WidgetArena::makeShared<TreeViewData>())
 {
     backgroundColor(Color(1.0f, 1.0f, 1.0f, 1.0f));
 }
@@ -116,62 +717,108 @@ TreeView TreeView::create() {
 
 // Node Management
 TreeView& TreeView::nodes(const std::vector<TreeNode>& nodes) {
-    m_treeData->nodes = nodes;
+    if (!nodes.empty() || !m_treeData->store.roots().empty()) invalidate(DirtyFlags::Paint);
+    m_treeData->store.assign(nodes);
+    m_treeData->nodesChanged();
     m_treeData->selectedIds.clear();
+    m_treeData->selectedSet.clear();
+    m_treeData->unlistedSelection = TreeViewData::anySelected(nodes);
     return *this;
 }
 
 TreeView& TreeView::addNode(const TreeNode& node) {
-    m_treeData->nodes.push_back(node);
+    uint32_t slot = m_treeData->store.insert(TreeNodeStore::NO_NODE, std::numeric_limits<size_t>::max(), node);
+    m_treeData->showRows(slot);
+    m_treeData->nodesChanged();
+    if (!m_treeData->unlistedSelection) {
+        m_treeData->unlistedSelection = node.selected || TreeViewData::anySelected(node.children);
+    }
+    invalidate(DirtyFlags::Paint);
     return *this;
 }
 
 TreeView& TreeView::removeNode(const std::string& id) {
-    m_treeData->removeNodeRecursive(m_treeData->nodes, id);
+    uint32_t slot = m_treeData->store.find(id);
+    if (slot == TreeNodeStore::NO_NODE) return *this;
     
-    // Remove from selection
-    auto it = std::find(m_treeData->selectedIds.begin(), m_treeData->selectedIds.end(), id);
-    if (it != m_treeData->selectedIds.end()) {
-        m_treeData->selectedIds.erase(it);
-    }
+    m_treeData->hideRows(slot);
+    
+    // Remove the subtree from the selection too
+    std::vector<std::string> removedIds;
+    m_treeData->store.remove(slot, m_treeData->selectedSet.empty() ? nullptr : &removedIds);
+    m_treeData->forgetSelected(removedIds);
+    m_treeData->nodesChanged();
+    invalidate(DirtyFlags::Paint);
     
     return *this;
 }
 
 TreeView& TreeView::clearNodes() {
-    m_treeData->nodes.clear();
+    if (!m_treeData->store.roots().empty()) invalidate(DirtyFlags::Paint);
+    m_treeData->store.clear();
+    m_treeData->nodesChanged();
     m_treeData->selectedIds.clear();
+    m_treeData->selectedSet.clear();
+    m_treeData->unlistedSelection = false;
     return *this;
 }
 
 const std::vector<TreeNode>& TreeView::getNodes() const {
-    return m_treeData->nodes;
+    return m_treeData->store.roots();
 }
 
 std::vector<TreeNode>& TreeView::getNodes() {
-    return m_treeData->nodes;
+    m_treeData->store.markEdited();
+    m_treeData->rowsValid = false;
+    m_treeData->nodesChanged();
+    invalidate(DirtyFlags::Paint);
+    return m_treeData->store.roots();
 }
 
 TreeNode* TreeView::findNode(const std::string& id) {
-    return m_treeData->findNodeRecursive(m_treeData->nodes, id);
+    TreeNode* node = m_treeData->findNode(id);
+    if (node) {
+        m_treeData->store.markEdited();
+    }
+    return node;
 }
 
 const TreeNode* TreeView::findNode(const std::string& id) const {
-    return m_treeData->findNodeRecursive(m_treeData->nodes, id);
+    return m_treeData->findNode(id);
 }
 
 TreeNode* TreeView::getParent(const std::string& id) {
-    return m_treeData->findParentRecursive(m_treeData->nodes, id);
+    auto& store = m_treeData->store;
+    uint32_t slot = store.find(id);
+    if (slot == TreeNodeStore::NO_NODE || store.parent(slot) == TreeNodeStore::NO_NODE) {
+        return nullptr;
+    }
+    TreeNode* parent = store.node(store.parent(slot));
+    if (parent) {
+        store.markEdited();
+    }
+    return parent;
+}
+
+TreeView& TreeView::childLoader(ChildLoader loader) {
+    m_treeData->childLoader = std::move(loader);
+    return *this;
 }
 
 
 // Expand/Collapse
 TreeView& TreeView::expand(const std::string& id, bool recursive) {
-    if (auto* node = findNode(id)) {
+    uint32_t slot;
+    if (auto* node = m_treeData->findNode(id, slot)) {
+        bool changed = m_treeData->loadChildren(slot, *node) || !node->expanded || recursive;
         node->expanded = true;
         if (recursive) {
             m_treeData->setExpandedRecursive(node->children, true);
         }
+        if (changed) {
+            m_treeData->relayoutRows(slot, *node);
+            invalidate(DirtyFlags::Paint);
+        }
         if (m_treeData->onExpandCallback) {
             m_treeData->onExpandCallback(*node, true);
         }
@@ -180,11 +827,17 @@ TreeView& TreeView::expand(const std::string& id, bool recursive) {
 }
 
 TreeView& TreeView::collapse(const std::string& id, bool recursive) {
-    if (auto* node = findNode(id)) {
+    uint32_t slot;
+    if (auto* node = m_treeData->findNode(id, slot)) {
+        bool changed = node->expanded;
         node->expanded = false;
         if (recursive) {
             m_treeData->setExpandedRecursive(node->children, false);
         }
+        if (changed) {
+            m_treeData->relayoutRows(slot, *node);
+            invalidate(DirtyFlags::Paint);
+        }
         if (m_treeData->onExpandCallback) {
             m_treeData->onExpandCallback(*node, false);
         }
@@ -193,7 +846,7 @@ TreeView& TreeView::collapse(const std::string& id, bool recursive) {
 }
 
 TreeView& TreeView::toggle(const std::string& id) {
-    if (auto* node = findNode(id)) {
+    if (auto* node = m_treeData->findNode(id)) {
         if (node->expanded) {
             collapse(id);
         } else {
@@ -204,12 +857,16 @@ TreeView& TreeView::toggle(const std::string& id) {
 }
 
 TreeView& TreeView::expandAll() {
-    m_treeData->setExpandedRecursive(m_treeData->nodes, true);
+    m_treeData->setExpandedRecursive(m_treeData->store.roots(), true);
+    m_treeData->rowsValid = false;
+    if (!m_treeData->store.roots().empty()) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
 TreeView& TreeView::collapseAll() {
-    m_treeData->setExpandedRecursive(m_treeData->nodes, false);
+    m_treeData->setExpandedRecursive(m_treeData->store.roots(), false);
+    m_treeData->rowsValid = false;
+    if (!m_treeData->store.roots().empty()) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -220,11 +877,146 @@ bool TreeView::isExpanded(const std::string& id) const {
     return false;
 }
 
+// Rows
+size_t TreeView::getRowCount() const {
+    m_treeData->syncRows();
+    return m_treeData->rows.size();
+}
+
+TreeRow TreeView::getRow(size_t index) const {
+    m_treeData->syncRows();
+    if (index >= m_treeData->rows.size()) return {};
+    const TreeNode* node = m_treeData->rowNode(index);
+    if (!node || index >= m_treeData->rows.size()) return {};
+    bool matched = m_treeData->filterRowsShown && m_treeData->filterRowMatched[index];
+    return TreeRow{node, static_cast<int>(m_treeData->rows[index].depth), matched};
+}
+
+std::vector<TreeRow> TreeView::getRows(size_t first, size_t count) const {
+    auto& data = *m_treeData;
+    data.syncRows();
+    std::vector<TreeRow> result;
+    if (first >= data.rows.size()) return result;
+    
+    count = std::min(count, data.rows.size() - first);
+    result.reserve(count);
+    for (size_t row = first; row < first + count && row < data.rows.size(); ++row) {
+        const TreeNode* node = data.rowNode(row);
+        if (node && row < data.rows.size()) {
+            bool matched = data.filterRowsShown && data.filterRowMatched[row];
+            result.push_back({node, static_cast<int>(data.rows[row].depth), matched});
+        }
+    }
+    return result;
+}
+
+int TreeView::getRowIndex(const std::string& id) const {
+    size_t row = m_treeData->findRow(id);
+    return row != TreeViewData::NO_ROW ? static_cast<int>(row) : -1;
+}
+
+void TreeView::getVisibleRowRange(int& startIndex, int& endIndex) const {
+    float viewHeight = getHeight();
+    startIndex = static_cast<int>(m_treeData->scrollOffset / m_treeData->nodeHeight);
+    endIndex = static_cast<int>((m_treeData->scrollOffset + viewHeight) / m_treeData->nodeHeight) + 1;
+    
+    startIndex = std::max(0, startIndex);
+    endIndex = std::min(static_cast<int>(getRowCount()), endIndex);
+}
+
+std::vector<TreeRow> TreeView::getVisibleRows() const {
+    int startIndex, endIndex;
+    getVisibleRowRange(startIndex, endIndex);
+    if (endIndex <= startIndex) return {};
+    return getRows(static_cast<size_t>(startIndex), static_cast<size_t>(endIndex - startIndex));
+}
+
+TreeView& TreeView::refreshRows() {
+    m_treeData->store.markEdited();
+    m_treeData->rowsValid = false;
+    m_treeData->nodesChanged();
+    invalidate(DirtyFlags::Paint);
+    return *this;
+}
+
+// Filtering
+TreeView& TreeView::filter(const std::string& query) {
+    auto& data = *m_treeData;
+    std::string lowered(query.size(), '\0');
+    std::transform(query.begin(), query.end(), lowered.begin(), lowerAscii);
+    if (lowered.empty()) return clearFilter();
+    
+    data.filterText = query;
+    if (lowered == data.filterQuery) return *this;
+    if (data.filterQuery.empty() && !data.rowsCurrent()) {
+        data.rows.clear();  // Only rows known to be current are kept until the first result
+    }
+    data.filterQuery = std::move(lowered);
+    data.syncRows();
+    invalidate(DirtyFlags::Paint);
+    return *this;
+}
+
+TreeView& TreeView::clearFilter() {
+    auto& data = *m_treeData;
+    if (!data.filterQuery.empty()) invalidate(DirtyFlags::Paint);
+    data.cancelFilterJob();
+    data.filterText.clear();
+    data.filterQuery.clear();
+    data.matchedQuery.clear();
+    data.filterMatches.clear();
+    data.filterShown.clear();
+    data.filterRowMatched.clear();
+    data.filterRowsShown = false;
+    data.rowsValid = false;
+    return *this;
+}
+
+const std::string& TreeView::getFilter() const {
+    return m_treeData->filterText;
+}
+
+size_t TreeView::getFilterMatchCount() const {
+    m_treeData->syncRows();
+    return m_treeData->filterRowsShown ? m_treeData->filterMatches.size() : 0;
+}
+
+bool TreeView::isFilterPending() const {
+    m_treeData->syncRows();
+    return m_treeData->filterJob != nullptr;
+}
+
+TreeView& TreeView::waitForFilter() {
+    auto& data = *m_treeData;
+    data.syncRows();
+    if (data.filterJob) {
+        data.adoptFilter();
+    }
+    return *this;
+}
+
+TreeView& TreeView::backgroundFilterThreshold(size_t nodes) {
+    m_treeData->backgroundFilterThreshold = nodes;
+    return *this;
+}
+
+size_t TreeView::getBackgroundFilterThreshold() const {
+    return m_treeData->backgroundFilterThreshold;
+}
+
 // Selection
 TreeView& TreeView::multiSelect(bool enabled) {
     m_treeData->multiSelectEnabled = enabled;
-    if (!enabled && m_treeData->selectedIds.size() > 1) {
-        m_treeData->selectedIds.resize(1);
+    auto& selectedIds = m_treeData->selectedIds;
+    if (!enabled && selectedIds.size() > 1) {
+        for (size_t i = 1; i < selectedIds.size(); ++i) {
+            if (auto* node = m_treeData->findNode(selectedIds[i])) {
+                node->selected = false;
+            }
+            m_treeData->selectedSet.erase(selectedIds[i]);
+        }
+        selectedIds.resize(1);
+        invalidate(DirtyFlags::Paint);
     }
     return *this;
 }
@@ -234,17 +1026,17 @@ bool TreeView::isMultiSelect() const {
 }
 
 TreeView& TreeView::select(const std::string& id, bool addToSelection) {
+    bool changed = false;
     if (!addToSelection || !m_treeData->multiSelectEnabled) {
-        m_treeData->clearSelectionRecursive(m_treeData->nodes);
-        m_treeData->selectedIds.clear();
+        changed = m_treeData->clearSelection();
     }
     
-    if (auto* node = findNode(id)) {
+    if (auto* node = m_treeData->findNode(id)) {
         node->selected = true;
         
-        auto it = std::find(m_treeData->selectedIds.begin(), m_treeData->selectedIds.end(), id);
-        if (it == m_treeData->selectedIds.end()) {
+        if (m_treeData->selectedSet.insert(id).second) {
             m_treeData->selectedIds.push_back(id);
+            changed = true;
         }
         
         if (m_treeData->onSelectCallback) {
@@ -252,24 +1044,25 @@ TreeView& TreeView::select(const std::string& id, bool addToSelection) {
         }
     }
     
+    if (changed) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
 TreeView& TreeView::deselect(const std::string& id) {
-    if (auto* node = findNode(id)) {
+    if (auto* node = m_treeData->findNode(id)) {
         node->selected = false;
         
-        auto it = std::find(m_treeData->selectedIds.begin(), m_treeData->selectedIds.end(), id);
-        if (it != m_treeData->selectedIds.end()) {
-            m_treeData->selectedIds.erase(it);
+        if (m_treeData->selectedSet.erase(id)) {
+            auto& selectedIds = m_treeData->selectedIds;
+            selectedIds.erase(std::find(selectedIds.begin(), selectedIds.end(), id));
+            invalidate(DirtyFlags::Paint);
         }
     }
     return *this;
 }
 
 TreeView& TreeView::clearSelection() {
-    m_treeData->clearSelectionRecursive(m_treeData->nodes);
-    m_treeData->selectedIds.clear();
+    if (m_treeData->clearSelection()) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -280,7 +1073,7 @@ std::vector<std::string> TreeView::getSelectedIds() const {
 std::vector<const TreeNode*> TreeView::getSelectedNodes() const {
     std::vector<const TreeNode*> result;
     for (const auto& id : m_treeData->selectedIds) {
-        if (const auto* node = findNode(id)) {
+        if (const auto* node = m_treeData->findNode(id)) {
             result.push_back(node);
         }
     }
@@ -298,40 +1091,35 @@ bool TreeView::isDragDropEnabled() const {
 }
 
 TreeView& TreeView::moveNode(const std::string& nodeId, const std::string& newParentId, int index) {
-    // Find and copy the node
-    TreeNode* sourceNode = findNode(nodeId);
-    if (!sourceNode) return *this;
-    
-    TreeNode nodeCopy = *sourceNode;
-    
-    // Remove from current location
-    m_treeData->removeNodeRecursive(m_treeData->nodes, nodeId);
+    auto& store = m_treeData->store;
+    uint32_t slot = store.find(nodeId);
+    if (slot == TreeNodeStore::NO_NODE) return *this;
     
-    // Add to new location
-    if (newParentId.empty()) {
-        // Add to root
-        if (index < 0 || index >= static_cast<int>(m_treeData->nodes.size())) {
-            m_treeData->nodes.push_back(nodeCopy);
-        } else {
-            m_treeData->nodes.insert(m_treeData->nodes.begin() + index, nodeCopy);
-        }
-    } else {
-        // Add to parent
-        if (auto* parent = findNode(newParentId)) {
-            if (index < 0 || index >= static_cast<int>(parent->children.size())) {
-                parent->children.push_back(nodeCopy);
-            } else {
-                parent->children.insert(parent->children.begin() + index, nodeCopy);
-            }
+    uint32_t parent = TreeNodeStore::NO_NODE;
+    if (!newParentId.empty()) {
+        uint64_t generation = store.generation();
+        parent = store.find(newParentId);
+        if (parent == TreeNodeStore::NO_NODE) return *this;
+        if (store.generation() != generation) {
+            slot = store.find(nodeId);  // Re-indexed while looking up the parent
         }
     }
     
+    // Moving a node into its own subtree leaves the tree as is
+    if (parent != TreeNodeStore::NO_NODE && store.contains(slot, parent)) return *this;
+    
+    std::vector<TreeViewData::Row> rows;
+    m_treeData->hideRows(slot, &rows);
+    store.move(slot, parent, index < 0 ? std::numeric_limits<size_t>::max() : static_cast<size_t>(index));
+    m_treeData->showRows(slot, &rows);
+    m_treeData->nodesChanged();
+    invalidate(DirtyFlags::Paint);
     return *this;
 }
 
 // Appearance
 TreeView& TreeView::nodeHeight(float height) {
-    m_treeData->nodeHeight = height;
+    if (assign(m_treeData->nodeHeight, height)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -340,7 +1128,7 @@ float TreeView::getNodeHeight() const {
 }
 
 TreeView& TreeView::indentation(float indent) {
-    m_treeData->indentation = indent;
+    if (assign(m_treeData->indentation, indent)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -349,7 +1137,7 @@ float TreeView::getIndentation() const {
 }
 
 TreeView& TreeView::showExpandIcons(bool show) {
-    m_treeData->showExpandIcons = show;
+    if (assign(m_treeData->showExpandIcons, show)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -358,7 +1146,7 @@ bool TreeView::hasExpandIcons() const {
 }
 
 TreeView& TreeView::showLines(bool show) {
-    m_treeData->showLines = show;
+    if (assign(m_treeData->showLines, show)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -367,7 +1155,7 @@ bool TreeView::hasLines() const {
 }
 
 TreeView& TreeView::hoverColor(const Color& color) {
-    m_treeData->hoverColor = color;
+    if (assign(m_treeData->hoverColor, color)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -376,7 +1164,7 @@ const Color& TreeView::getHoverColor() const {
 }
 
 TreeView& TreeView::selectionColor(const Color& color) {
-    m_treeData->selectionColor = color;
+    if (assign(m_treeData->selectionColor, color)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -427,11 +1215,24 @@ TreeView& TreeView::onDrop(std::function<void(const TreeDragData&)> callback) {
 
 // Scrolling
 TreeView& TreeView::scrollToNode(const std::string& id) {
-    // Calculate node position and scroll to it
-    // This would require traversing the tree and counting visible nodes
-    // For now, just find the node depth
-    if (findNode(id)) {
-        // Implementation would calculate actual position
+    auto& store = m_treeData->store;
+    uint32_t slot = store.find(id);
+    if (slot == TreeNodeStore::NO_NODE) return *this;
+    
+    // Expand collapsed ancestors, outermost first
+    std::vector<std::string> collapsed;
+    for (uint32_t s = store.parent(slot); s != TreeNodeStore::NO_NODE; s = store.parent(s)) {
+        const TreeNode* ancestor = store.node(s);
+        if (!ancestor) break;
+        if (!ancestor->expanded) collapsed.push_back(ancestor->id);
+    }
+    for (auto it = collapsed.rbegin(); it != collapsed.rend(); ++it) {
+        expand(*it);
+    }
+    
+    size_t row = m_treeData->findRow(id);
+    if (row != TreeViewData::NO_ROW) {
+        scrollTo(static_cast<float>(row) * m_treeData->nodeHeight);
     }
     return *this;
 }
@@ -441,7 +1242,7 @@ float TreeView::getScrollOffset() const {
 }
 
 TreeView& TreeView::scrollTo(float offset) {
-    m_treeData->scrollOffset = std::max(0.0f, offset);
+    if (assign(m_treeData->scrollOffset, std::max(0.0f, offset))) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -4,6 +4,7 @@
  */
 
 #include "KillerGK/widgets/Widget.hpp"
+#include "KillerGK/widgets/WidgetArena.hpp"
 #include <limits>
 #include <sstream>
 #include <algorithm>
@@ -61,14 +62,17 @@ struct Widget::WidgetData {
     std::vector<Widget*> children;
 
     // Custom properties
-    std::map<std::string, std::any> customProperties;
+    PropertyStore customProperties;
+
+    // Never drawn yet
+    DirtyFlags dirty = DirtyFlags::Layout | DirtyFlags::Paint;
 };
 
 // =============================================================================
 // Widget Implementation
 // =============================================================================
 
-Widget::Widget() : m_data(std::make_shared<WidgetData>()) {}
+Widget::Widget() : m_data(WidgetArena::makeShared<WidgetData>()) {}
 
 Widget Widget::create() {
     return Widget();
@@ -87,32 +91,32 @@ const std::string& Widget::getId() const {
 
 // Size Properties
 Widget& Widget::width(float value) {
-    m_data->width = value;
+    if (assign(m_data->width, value)) invalidate(DirtyFlags::Layout);
     return *this;
 }
 
 Widget& Widget::height(float value) {
-    m_data->height = value;
+    if (assign(m_data->height, value)) invalidate(DirtyFlags::Layout);
     return *this;
 }
 
 Widget& Widget::minWidth(float value) {
-    m_data->minWidth = value;
+    if (assign(m_data->minWidth, value)) invalidate(DirtyFlags::Layout);
     return *this;
 }
 
 Widget& Widget::maxWidth(float value) {
-    m_data->maxWidth = value;
+    if (assign(m_data->maxWidth, value)) invalidate(DirtyFlags::Layout);
     return *this;
 }
 
 Widget& Widget::minHeight(float value) {
-    m_data->minHeight = value;
+    if (assign(m_data->minHeight, value)) invalidate(DirtyFlags::Layout);
     return *this;
 }
 
 Widget& Widget::maxHeight(float value) {
-    m_data->maxHeight = value;
+    if (assign(m_data->maxHeight, value)) invalidate(DirtyFlags::Layout);
     return *this;
 }
 
@@ -142,32 +146,32 @@ float Widget::getMaxHeight() const {
 
 // Spacing Properties
 Widget& Widget::margin(float all) {
-    m_data->margin = Spacing(all);
+    if (assign(m_data->margin, Spacing(all))) invalidate(DirtyFlags::Layout);
     return *this;
 }
 
 Widget& Widget::margin(float vertical, float horizontal) {
-    m_data->margin = Spacing(vertical, horizontal);
+    if (assign(m_data->margin, Spacing(vertical, horizontal))) invalidate(DirtyFlags::Layout);
     return *this;
 }
 
 Widget& Widget::margin(float top, float right, float bottom, float left) {
-    m_data->margin = Spacing(top, right, bottom, left);
+    if (assign(m_data->margin, Spacing(top, right, bottom, left))) invalidate(DirtyFlags::Layout);
     return *this;
 }
 
 Widget& Widget::padding(float all) {
-    m_data->padding = Spacing(all);
+    if (assign(m_data->padding, Spacing(all))) invalidate(DirtyFlags::Layout);
     return *this;
 }
 
 Widget& Widget::padding(float vertical, float horizontal) {
-    m_data->padding = Spacing(vertical, horizontal);
+    if (assign(m_data->padding, Spacing(vertical, horizontal))) invalidate(DirtyFlags::Layout);
     return *this;
 }
 
 Widget& Widget::padding(float top, float right, float bottom, float left) {
-    m_data->padding = Spacing(top, right, bottom, left);
+    if (assign(m_data->padding, Spacing(top, right, bottom, left))) invalidate(DirtyFlags::Layout);
     return *this;
 }
 
@@ -181,12 +185,12 @@ const Spacing& Widget::getPadding() const {
 
 // Visibility and State
 Widget& Widget::visible(bool value) {
-    m_data->visible = value;
+    if (assign(m_data->visible, value)) invalidate(DirtyFlags::Layout | DirtyFlags::Paint);
     return *this;
 }
 
 Widget& Widget::enabled(bool value) {
-    m_data->enabled = value;
+    if (assign(m_data->enabled, value)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -222,52 +226,52 @@ bool Widget::isPressed() const {
 
 // Styling Properties
 Widget& Widget::backgroundColor(const Color& color) {
-    m_data->backgroundColor = color;
+    if (assign(m_data->backgroundColor, color)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
 Widget& Widget::borderRadius(float radius) {
-    m_data->borderRadius = radius;
+    if (assign(m_data->borderRadius, radius)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
 Widget& Widget::borderWidth(float width) {
-    m_data->borderWidth = width;
+    if (assign(m_data->borderWidth, width)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
 Widget& Widget::borderColor(const Color& color) {
-    m_data->borderColor = color;
+    if (assign(m_data->borderColor, color)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
 Widget& Widget::shadow(float blur, float offsetX, float offsetY, const Color& color) {
-    m_data->shadow = Shadow(blur, offsetX, offsetY, color);
+    if (assign(m_data->shadow, Shadow(blur, offsetX, offsetY, color))) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
 Widget& Widget::shadow(float blur, float offsetX, float offsetY, const Color& color, float spread) {
-    m_data->shadow = Shadow(blur, offsetX, offsetY, color, spread);
+    if (assign(m_data->shadow, Shadow(blur, offsetX, offsetY, color, spread))) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
 Widget& Widget::shadow(const Shadow& shadowConfig) {
-    m_data->shadow = shadowConfig;
+    if (assign(m_data->shadow, shadowConfig)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
 Widget& Widget::shadowEnabled(bool enabled) {
-    m_data->shadow.enabled = enabled;
+    if (assign(m_data->shadow.enabled, enabled)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
 Widget& Widget::opacity(float value) {
-    m_data->opacity = value;
+    if (assign(m_data->opacity, value)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
 Widget& Widget::blur(float radius) {
-    m_data->blurRadius = radius;
+    if (assign(m_data->blurRadius, radius)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
@@ -398,6 +402,7 @@ void Widget::triggerClick() {
 void Widget::setHovered(bool hovered) {
     if (m_data->hovered != hovered) {
         m_data->hovered = hovered;
+        invalidate(DirtyFlags::Paint);
         if (m_data->onHoverCallback) {
             m_data->onHoverCallback(hovered);
         }
@@ -410,6 +415,7 @@ void Widget::setHovered(bool hovered) {
 void Widget::setFocused(bool focused) {
     if (m_data->focused != focused) {
         m_data->focused = focused;
+        invalidate(DirtyFlags::Paint);
         if (m_data->onFocusCallback) {
             m_data->onFocusCallback(focused);
         }
@@ -420,7 +426,7 @@ void Widget::setFocused(bool focused) {
 }
 
 void Widget::setPressed(bool pressed) {
-    m_data->pressed = pressed;
+    if (assign(m_data->pressed, pressed)) invalidate(DirtyFlags::Paint);
 }
 
 // Hierarchy
@@ -441,6 +447,7 @@ void Widget::addChild(Widget* child) {
     if (child) {
         m_data->children.push_back(child);
         child->parent(this);
+        child->invalidate(DirtyFlags::Layout);
     }
 }
 
@@ -450,81 +457,87 @@ void Widget::removeChild(Widget* child) {
         if (it != m_data->children.end()) {
             (*it)->parent(nullptr);
             m_data->children.erase(it);
+            invalidate(DirtyFlags::Layout);
         }
     }
 }
 
 // Property access
 Widget& Widget::setPropertyFloat(const std::string& name, float value) {
-    m_data->customProperties[name] = value;
+    return setPropertyFloat(PropertyKey::intern(name), value);
+}
+
+Widget& Widget::setPropertyFloat(PropertyKey key, float value) {
+    if (m_data->customProperties.setFloat(key, value)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
 Widget& Widget::setPropertyInt(const std::string& name, int value) {
-    m_data->customProperties[name] = value;
+    return setPropertyInt(PropertyKey::intern(name), value);
+}
+
+Widget& Widget::setPropertyInt(PropertyKey key, int value) {
+    if (m_data->customProperties.setInt(key, value)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
 Widget& Widget::setPropertyBool(const std::string& name, bool value) {
-    m_data->customProperties[name] = value;
+    return setPropertyBool(PropertyKey::intern(name), value);
+}
+
+Widget& Widget::setPropertyBool(PropertyKey key, bool value) {
+    if (m_data->customProperties.setBool(key, value)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
 Widget& Widget::setPropertyString(const std::string& name, const std::string& value) {
-    m_data->customProperties[name] = value;
+    return setPropertyString(PropertyKey::intern(name), value);
+}
+
+Widget& Widget::setPropertyString(PropertyKey key, const std::string& value) {
+    if (m_data->customProperties.setString(key, value)) invalidate(DirtyFlags::Paint);
     return *this;
 }
 
+// Names never interned belong to no widget, so lookups need not add them
 float Widget::getPropertyFloat(const std::string& name, float defaultValue) const {
-    auto it = m_data->customProperties.find(name);
-    if (it != m_data->customProperties.end()) {
-        try {
-            return std::any_cast<float>(it->second);
-        } catch (const std::bad_any_cast&) {
-            return defaultValue;
-        }
-    }
-    return defaultValue;
+    return getPropertyFloat(PropertyKey::find(name), defaultValue);
+}
+
+float Widget::getPropertyFloat(PropertyKey key, float defaultValue) const {
+    return m_data->customProperties.getFloat(key, defaultValue);
 }
 
 int Widget::getPropertyInt(const std::string& name, int defaultValue) const {
-    auto it = m_data->customProperties.find(name);
-    if (it != m_data->customProperties.end()) {
-        try {
-            return std::any_cast<int>(it->second);
-        } catch (const std::bad_any_cast&) {
-            return defaultValue;
-        }
-    }
-    return defaultValue;
+    return getPropertyInt(PropertyKey::find(name), defaultValue);
+}
+
+int Widget::getPropertyInt(PropertyKey key, int defaultValue) const {
+    return m_data->customProperties.getInt(key, defaultValue);
 }
 
 bool Widget::getPropertyBool(const std::string& name, bool defaultValue) const {
-    auto it = m_data->customProperties.find(name);
-    if (it != m_data->customProperties.end()) {
-        try {
-            return std::any_cast<bool>(it->second);
-        } catch (const std::bad_any_cast&) {
-            return defaultValue;
-        }
-    }
-    return defaultValue;
+    return getPropertyBool(PropertyKey::find(name), defaultValue);
+}
+
+bool Widget::getPropertyBool(PropertyKey key, bool defaultValue) const {
+    return m_data->customProperties.getBool(key, defaultValue);
 }
 
 std::string Widget::getPropertyString(const std::string& name, const std::string& defaultValue) const {
-    auto it = m_data->customProperties.find(name);
-    if (it != m_data->customProperties.end()) {
-        try {
-            return std::any_cast<std::string>(it->second);
-        } catch (const std::bad_any_cast&) {
-            return defaultValue;
-        }
-    }
-    return defaultValue;
+    return getPropertyString(PropertyKey::find(name), defaultValue);
+}
+
+std::string Widget::getPropertyString(PropertyKey key, const std::string& defaultValue) const {
+    return m_data->customProperties.getString(key, defaultValue);
 }
 
 bool Widget::hasProperty(const std::string& name) const {
-    return m_data->customProperties.find(name) != m_data->customProperties.end();
+    return hasProperty(PropertyKey::find(name));
+}
+
+bool Widget::hasProperty(PropertyKey key) const {
+    return m_data->customProperties.has(key);
 }
 
 
@@ -538,7 +551,7 @@ WidgetState Widget::getState() const {
     state.hovered = m_data->hovered;
     state.pressed = m_data->pressed;
     state.bounds = Rect(0, 0, m_data->width, m_data->height);
-    state.properties = m_data->customProperties;
+    m_data->customProperties.copyTo(state.properties);
     
     // Store standard properties
     state.properties["width"] = m_data->width;
@@ -583,13 +596,41 @@ void Widget::setState(const WidgetState& state) {
         } catch (...) {}
     }
     
-    // Copy custom properties (excluding standard ones)
+    // Copy custom properties (excluding standard ones); values of types
+    // other than float, int, bool and std::string are not kept
     for (const auto& [key, value] : state.properties) {
         if (key != "width" && key != "height" && key != "opacity" && 
             key != "borderRadius" && key != "borderWidth" && key != "blurRadius") {
-            m_data->customProperties[key] = value;
+            m_data->customProperties.set(PropertyKey::intern(key), value);
         }
     }
+    invalidate(DirtyFlags::Layout | DirtyFlags::Paint);
+}
+
+// Invalidation
+void Widget::invalidate(DirtyFlags flags) {
+    m_data->dirty = m_data->dirty | flags;
+
+    // Stop at the first ancestor already marked: clearDirty() cleans whole
+    // subtrees, so its own ancestors are marked as well
+    DirtyFlags up = DirtyFlags::Subtree | (flags & DirtyFlags::Layout ? DirtyFlags::Layout : DirtyFlags::None);
+    for (Widget* ancestor = m_data->parent; ancestor; ancestor = ancestor->m_data->parent) {
+        DirtyFlags& dirty = ancestor->m_data->dirty;
+        if ((dirty | up) == dirty) break;
+        dirty = dirty | up;
+    }
+}
+
+DirtyFlags Widget::getDirty() const {
+    return m_data->dirty;
+}
+
+void Widget::clearDirty() {
+    bool subtree = m_data->dirty & DirtyFlags::Subtree;
+    m_data->dirty = DirtyFlags::None;
+    if (subtree) {
+        for (Widget* child : m_data->children) child->clearDirty();
+    }
 }
 
 // =============================================================================
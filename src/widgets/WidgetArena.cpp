@@ -0,0 +1,111 @@
+/**
+ * @file WidgetArena.cpp
+ * @brief Widget arena implementation
+ */
+
+#include "KillerGK/widgets/WidgetArena.hpp"
+#include <algorithm>
+#include <cstdint>
+
+namespace KillerGK {
+
+namespace {
+
+thread_local WidgetArena* t_currentArena = nullptr;
+
+} // namespace
+
+struct WidgetArena::State {
+    struct Chunk {
+        std::unique_ptr<std::byte[]> memory;
+        size_t size = 0;
+    };
+
+    std::vector<Chunk> chunks;
+    size_t chunk = 0;                   ///< Chunk being filled
+    size_t offset = 0;                  ///< Bytes used in it
+    size_t used = 0;
+    size_t reserved = 0;
+    std::atomic<size_t> live{0};        ///< Blocks may be freed on any thread
+};
+
+WidgetArena::WidgetArena() : m_state(std::make_shared<State>()) {}
+
+WidgetArena::~WidgetArena() = default;
+
+// =============================================================================
+// Scope
+// =============================================================================
+
+WidgetArena::Scope::Scope(WidgetArena& arena) : m_previous(t_currentArena) {
+    t_currentArena = &arena;
+}
+
+WidgetArena::Scope::~Scope() {
+    t_currentArena = m_previous;
+}
+
+WidgetArena* WidgetArena::current() {
+    return t_currentArena;
+}
+
+// =============================================================================
+// Allocation
+// =============================================================================
+
+void* WidgetArena::allocate(State& state, size_t bytes, size_t alignment) {
+    for (;;) {
+        if (state.chunk < state.chunks.size()) {
+            State::Chunk& chunk = state.chunks[state.chunk];
+            auto base = reinterpret_cast<uintptr_t>(chunk.memory.get());
+            size_t start = ((base + state.offset + alignment - 1) & ~(uintptr_t(alignment) - 1)) - base;
+            if (start + bytes <= chunk.size) {
+                state.offset = start + bytes;
+                state.used += bytes;
+                state.live.fetch_add(1, std::memory_order_relaxed);
+                return chunk.memory.get() + start;
+            }
+            // Leave the rest of the chunk unused; blocks stay in creation order.
+            // Only a block too large for an empty chunk gets a new one here
+            if (state.offset > 0) {
+                ++state.chunk;
+                state.offset = 0;
+                continue;
+            }
+        }
+        size_t size = std::max(CHUNK_SIZE, bytes + alignment);
+        State::Chunk chunk{std::make_unique_for_overwrite<std::byte[]>(size), size};
+        state.reserved += size;
+        // A new chunk goes where filling continues, before any chunk still to be reused
+        state.chunks.insert(state.chunks.begin() + static_cast<ptrdiff_t>(std::min(state.chunk, state.chunks.size())),
+                            std::move(chunk));
+        state.offset = 0;
+    }
+}
+
+void WidgetArena::deallocate(State& state) noexcept {
+    // The memory is reused after reset(), or freed with the last reference to the state
+    state.live.fetch_sub(1, std::memory_order_release);
+}
+
+bool WidgetArena::reset() {
+    if (m_state->live.load(std::memory_order_acquire) != 0) return false;
+    m_state->chunk = 0;
+    m_state->offset = 0;
+    m_state->used = 0;
+    return true;
+}
+
+size_t WidgetArena::getLiveCount() const {
+    return m_state->live.load(std::memory_order_relaxed);
+}
+
+size_t WidgetArena::getUsedBytes() const {
+    return m_state->used;
+}
+
+size_t WidgetArena::getReservedBytes() const {
+    return m_state->reserved;
+}
+
+} // namespace KillerGK
@@ -0,0 +1,133 @@
+/**
+ * @file WidgetDamage.cpp
+ * @brief Damage tracking implementation
+ */
+
+#include "KillerGK/widgets/WidgetDamage.hpp"
+#include "KillerGK/widgets/WidgetHitIndex.hpp"
+#include <algorithm>
+
+namespace KillerGK {
+
+namespace {
+
+Rect unite(const Rect& a, const Rect& b) {
+    float left = std::min(a.x, b.x);
+    float top = std::min(a.y, b.y);
+    float right = std::max(a.x + a.width, b.x + b.width);
+    float bottom = std::max(a.y + a.height, b.y + b.height);
+    return Rect(left, top, right - left, bottom - top);
+}
+
+// Unlike Rect::intersects(), rectangles that only touch do not overlap
+bool overlaps(const Rect& a, const Rect& b) {
+    return a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height && b.y < a.y + a.height;
+}
+
+float area(const Rect& rect) {
+    return rect.width * rect.height;
+}
+
+} // namespace
+
+// =============================================================================
+// Collection
+// =============================================================================
+
+bool DamageTracker::collect(Widget& root, const WidgetHitIndex& index) {
+    if (root.isDirty()) {
+        collect(root, index, false);
+        root.clearDirty();
+    }
+    return !empty();
+}
+
+void DamageTracker::collect(Widget& widget, const WidgetHitIndex& index, bool relaid) {
+    DirtyFlags dirty = widget.getDirty();
+    relaid = relaid || (dirty & DirtyFlags::Layout);
+
+    if ((dirty & DirtyFlags::Paint) || relaid) {
+        Widget* key = &widget;
+        if (index.contains(key)) {
+            Rect bounds = index.getBounds(key);
+            auto [drawn, added] = m_drawn.try_emplace(key, bounds);
+            if (added || (dirty & DirtyFlags::Paint) || drawn->second != bounds) {
+                if (!added) add(drawn->second);
+                add(bounds);
+                drawn->second = bounds;
+            }
+        }
+    }
+
+    // Clean subtrees can only have moved, and only if an ancestor was laid out
+    if (relaid || (dirty & DirtyFlags::Subtree)) {
+        for (Widget* child : widget.getChildren()) {
+            if (relaid || child->isDirty()) collect(*child, index, relaid);
+        }
+    }
+}
+
+void DamageTracker::remove(Widget* widget) {
+    auto drawn = m_drawn.find(widget);
+    if (drawn != m_drawn.end()) {
+        add(drawn->second);
+        m_drawn.erase(drawn);
+    }
+}
+
+void DamageTracker::reset() {
+    m_regions.clear();
+    m_drawn.clear();
+}
+
+// =============================================================================
+// Regions
+// =============================================================================
+
+void DamageTracker::add(const Rect& rect) {
+    if (!(rect.width > 0.0f && rect.height > 0.0f)) return;    // Also rejects NaN
+
+    // Absorb every region the damage overlaps, including those the growing
+    // union comes to overlap, so regions never overlap each other
+    Rect merged = rect;
+    for (size_t i = 0; i < m_regions.size();) {
+        if (overlaps(m_regions[i], merged)) {
+            merged = unite(merged, m_regions[i]);
+            m_regions[i] = m_regions.back();
+            m_regions.pop_back();
+            i = 0;
+        } else {
+            ++i;
+        }
+    }
+
+    if (m_regions.size() < MAX_REGIONS) {
+        m_regions.push_back(merged);
+        return;
+    }
+
+    // Too many regions: merge into the one that grows least, which may in
+    // turn overlap others
+    size_t nearest = 0;
+    float nearestGrowth = 0.0f;
+    for (size_t i = 0; i < m_regions.size(); ++i) {
+        float growth = area(unite(m_regions[i], merged)) - area(m_regions[i]);
+        if (i == 0 || growth < nearestGrowth) {
+            nearest = i;
+            nearestGrowth = growth;
+        }
+    }
+    merged = unite(m_regions[nearest], merged);
+    m_regions[nearest] = m_regions.back();
+    m_regions.pop_back();
+    add(merged);
+}
+
+Rect DamageTracker::getBounds() const {
+    if (m_regions.empty()) return Rect();
+    Rect bounds = m_regions.front();
+    for (const Rect& region : m_regions) bounds = unite(bounds, region);
+    return bounds;
+}
+
+} // namespace KillerGK
@@ -0,0 +1,247 @@
+/**
+ * @file WidgetHitIndex.cpp
+ * @brief Widget spatial index implementation
+ */
+
+#include "KillerGK/widgets/WidgetHitIndex.hpp"
+#include "KillerGK/layout/Layout.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace KillerGK {
+
+namespace {
+
+// Bounds are clamped to this range when choosing cells (not when testing
+// them), so the top level's 2^29 pixel cells hold any widget in 2 x 2 cells
+constexpr float kCoordinateLimit = 268435456.0f;   // 2^28
+
+float cellSizeOf(int level) {
+    return std::ldexp(WidgetHitIndex::BASE_CELL_SIZE, level);
+}
+
+int32_t cellOf(float coordinate, float cellSize) {
+    return static_cast<int32_t>(std::floor(std::clamp(coordinate, -kCoordinateLimit, kCoordinateLimit) / cellSize));
+}
+
+// A widget is hidden with any of its ancestors
+bool isShown(const Widget* widget) {
+    for (; widget; widget = widget->getParent()) {
+        if (!widget->isVisible()) return false;
+    }
+    return true;
+}
+
+bool sameCells(const auto& a, const auto& b) {
+    return a.level == b.level && a.firstX == b.firstX && a.firstY == b.firstY && a.lastX == b.lastX &&
+           a.lastY == b.lastY;
+}
+
+} // namespace
+
+size_t WidgetHitIndex::CellHash::operator()(const CellKey& key) const {
+    uint64_t hash = (static_cast<uint64_t>(static_cast<uint32_t>(key.x)) << 32) | static_cast<uint32_t>(key.y);
+    hash ^= static_cast<uint64_t>(key.level) * 0x9E3779B97F4A7C15ull;
+    hash *= 0xFF51AFD7ED558CCDull;
+    return static_cast<size_t>(hash ^ (hash >> 29));
+}
+
+// =============================================================================
+// Bounds
+// =============================================================================
+
+void WidgetHitIndex::locate(Entry& entry) {
+    const Rect& bounds = entry.bounds;
+    float right = bounds.x + bounds.width;
+    float bottom = bounds.y + bounds.height;
+    entry.level = -1;
+    if (!(bounds.width >= 0.0f && bounds.height >= 0.0f) || std::isnan(right) || std::isnan(bottom)) {
+        return;    // Never contains a point
+    }
+
+    // The lowest level whose cells are at least as large as the widget
+    float span = std::min(std::max(bounds.width, bounds.height), kCoordinateLimit);
+    int level = 0;
+    while (level + 1 < LEVELS && cellSizeOf(level) < span) ++level;
+
+    float cellSize = cellSizeOf(level);
+    entry.level = level;
+    entry.firstX = cellOf(bounds.x, cellSize);
+    entry.firstY = cellOf(bounds.y, cellSize);
+    entry.lastX = cellOf(right, cellSize);
+    entry.lastY = cellOf(bottom, cellSize);
+}
+
+void WidgetHitIndex::link(const Entry& entry, uint32_t slot) {
+    if (entry.level < 0) return;
+    for (int32_t y = entry.firstY; y <= entry.lastY; ++y) {
+        for (int32_t x = entry.firstX; x <= entry.lastX; ++x) {
+            m_cells[CellKey{x, y, entry.level}].push_back(slot);
+        }
+    }
+    m_levelCounts[entry.level]++;
+}
+
+void WidgetHitIndex::unlink(const Entry& entry, uint32_t slot) {
+    if (entry.level < 0) return;
+    for (int32_t y = entry.firstY; y <= entry.lastY; ++y) {
+        for (int32_t x = entry.firstX; x <= entry.lastX; ++x) {
+            auto cell = m_cells.find(CellKey{x, y, entry.level});
+            if (cell == m_cells.end()) continue;
+            auto& slots = cell->second;
+            auto it = std::find(slots.begin(), slots.end(), slot);
+            if (it != slots.end()) {
+                *it = slots.back();
+                slots.pop_back();
+            }
+            if (slots.empty()) m_cells.erase(cell);
+        }
+    }
+    m_levelCounts[entry.level]--;
+}
+
+void WidgetHitIndex::update(Widget* widget, const Rect& bounds) {
+    if (!widget) return;
+
+    auto found = m_slots.find(widget);
+    if (found == m_slots.end()) {
+        uint32_t slot;
+        if (!m_free.empty()) {
+            slot = m_free.back();
+            m_free.pop_back();
+        } else {
+            slot = static_cast<uint32_t>(m_entries.size());
+            m_entries.emplace_back();
+        }
+        Entry& entry = m_entries[slot];
+        entry.widget = widget;
+        entry.bounds = bounds;
+        entry.order = m_nextOrder++;
+        locate(entry);
+        link(entry, slot);
+        m_slots.emplace(widget, slot);
+        return;
+    }
+
+    Entry& entry = m_entries[found->second];
+    if (entry.bounds == bounds) return;
+    Entry moved = entry;
+    moved.bounds = bounds;
+    locate(moved);
+    // A move within the same cells leaves them as they are
+    if (!sameCells(moved, entry)) {
+        unlink(entry, found->second);
+        link(moved, found->second);
+    }
+    entry = moved;
+}
+
+void WidgetHitIndex::update(const ILayout& layout) {
+    for (size_t i = 0; i < layout.getChildCount(); ++i) {
+        if (Widget* child = layout.getChild(i)) {
+            update(child, layout.getChildBounds(i));
+        }
+    }
+}
+
+bool WidgetHitIndex::remove(Widget* widget) {
+    auto found = m_slots.find(widget);
+    if (found == m_slots.end()) return false;
+
+    uint32_t slot = found->second;
+    unlink(m_entries[slot], slot);
+    m_entries[slot] = Entry();
+    m_free.push_back(slot);
+    m_slots.erase(found);
+    m_hovered.erase(std::remove(m_hovered.begin(), m_hovered.end(), widget), m_hovered.end());
+    return true;
+}
+
+void WidgetHitIndex::raise(Widget* widget) {
+    auto found = m_slots.find(widget);
+    if (found != m_slots.end()) {
+        m_entries[found->second].order = m_nextOrder++;
+    }
+}
+
+void WidgetHitIndex::clear() {
+    m_entries.clear();
+    m_free.clear();
+    m_slots.clear();
+    m_cells.clear();
+    std::fill(std::begin(m_levelCounts), std::end(m_levelCounts), 0);
+    m_nextOrder = 0;
+    m_hovered.clear();
+}
+
+Rect WidgetHitIndex::getBounds(Widget* widget) const {
+    auto found = m_slots.find(widget);
+    return found != m_slots.end() ? m_entries[found->second].bounds : Rect();
+}
+
+// =============================================================================
+// Queries
+// =============================================================================
+
+Widget* WidgetHitIndex::hitTest(float x, float y) const {
+    if (std::isnan(x) || std::isnan(y)) return nullptr;
+
+    const Entry* best = nullptr;
+    for (int level = 0; level < LEVELS; ++level) {
+        if (m_levelCounts[level] == 0) continue;
+        float cellSize = cellSizeOf(level);
+        auto cell = m_cells.find(CellKey{cellOf(x, cellSize), cellOf(y, cellSize), level});
+        if (cell == m_cells.end()) continue;
+        for (uint32_t slot : cell->second) {
+            const Entry& entry = m_entries[slot];
+            if ((!best || entry.order > best->order) && entry.bounds.contains(x, y) && isShown(entry.widget)) {
+                best = &entry;
+            }
+        }
+    }
+    return best ? best->widget : nullptr;
+}
+
+bool WidgetHitIndex::dispatch(WidgetEvent& event) {
+    Widget* target = hitTest(event.mouseX, event.mouseY);
+    return target && target->dispatchEvent(event);
+}
+
+// =============================================================================
+// Hover
+// =============================================================================
+
+WidgetHitIndex::HoverChange WidgetHitIndex::updateHover(float x, float y) {
+    std::vector<Widget*> hovered;
+    for (Widget* widget = hitTest(x, y); widget; widget = widget->getParent()) {
+        if (contains(widget)) hovered.push_back(widget);
+    }
+    return setHovered(std::move(hovered));
+}
+
+WidgetHitIndex::HoverChange WidgetHitIndex::clearHover() {
+    return setHovered({});
+}
+
+WidgetHitIndex::HoverChange WidgetHitIndex::setHovered(std::vector<Widget*> hovered) {
+    HoverChange change;
+    if (hovered == m_hovered) return change;
+
+    auto in = [](const std::vector<Widget*>& widgets, Widget* widget) {
+        return std::find(widgets.begin(), widgets.end(), widget) != widgets.end();
+    };
+    for (Widget* widget : m_hovered) {
+        if (!in(hovered, widget)) change.left.push_back(widget);
+    }
+    for (auto it = hovered.rbegin(); it != hovered.rend(); ++it) {
+        if (!in(m_hovered, *it)) change.entered.push_back(*it);
+    }
+    m_hovered = std::move(hovered);
+
+    // Callbacks last, in case they change the index
+    for (Widget* widget : change.left) widget->setHovered(false);
+    for (Widget* widget : change.entered) widget->setHovered(true);
+    return change;
+}
+
+} // namespace KillerGK
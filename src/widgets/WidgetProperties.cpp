@@ -0,0 +1,226 @@
+/**
+ * @file WidgetProperties.cpp
+ * @brief Property key interning and property storage implementation
+ */
+
+#include "KillerGK/widgets/WidgetProperties.hpp"
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace KillerGK {
+
+namespace {
+
+const std::string kNoName;
+
+struct NameHash {
+    using is_transparent = void;
+    size_t operator()(std::string_view name) const { return std::hash<std::string_view>{}(name); }
+};
+
+/**
+ * @brief Names by key, and keys by name; names are never removed
+ */
+struct KeyTable {
+    std::shared_mutex mutex;
+    std::unordered_map<std::string, uint32_t, NameHash, std::equal_to<>> ids;
+    std::deque<std::string> names;    ///< Deque, so getName() references stay valid
+};
+
+KeyTable& keyTable() {
+    static KeyTable table;
+    return table;
+}
+
+} // namespace
+
+// =============================================================================
+// PropertyKey
+// =============================================================================
+
+PropertyKey PropertyKey::intern(std::string_view name) {
+    PropertyKey key = find(name);
+    if (key.isValid()) return key;
+
+    KeyTable& table = keyTable();
+    std::unique_lock lock(table.mutex);
+    auto [it, added] = table.ids.try_emplace(std::string(name), static_cast<uint32_t>(table.names.size()));
+    if (added) table.names.push_back(it->first);
+    return PropertyKey(it->second);
+}
+
+PropertyKey PropertyKey::find(std::string_view name) {
+    // Keys never change once interned, so each thread remembers the ones it
+    // has seen and only takes the lock for names new to it
+    thread_local std::unordered_map<std::string, uint32_t, NameHash, std::equal_to<>> known;
+    auto it = known.find(name);
+    if (it != known.end()) return PropertyKey(it->second);
+
+    KeyTable& table = keyTable();
+    std::shared_lock lock(table.mutex);
+    auto found = table.ids.find(name);
+    if (found == table.ids.end()) return PropertyKey();
+    known.emplace(found->first, found->second);
+    return PropertyKey(found->second);
+}
+
+const std::string& PropertyKey::getName() const {
+    if (!isValid()) return kNoName;
+    KeyTable& table = keyTable();
+    std::shared_lock lock(table.mutex);
+    return table.names[m_id];
+}
+
+// =============================================================================
+// PropertyStore
+// =============================================================================
+
+const PropertyStore::Entry* PropertyStore::find(PropertyKey key) const {
+    auto it = std::lower_bound(m_entries.begin(), m_entries.end(), key.getId(),
+                               [](const Entry& entry, uint32_t id) { return entry.key < id; });
+    return it != m_entries.end() && it->key == key.getId() && key.isValid() ? &*it : nullptr;
+}
+
+PropertyStore::Entry& PropertyStore::slot(PropertyKey key, PropertyType type, bool& added) {
+    added = true;   // A new entry, or one that held another type
+    auto it = std::lower_bound(m_entries.begin(), m_entries.end(), key.getId(),
+                               [](const Entry& entry, uint32_t id) { return entry.key < id; });
+    if (it == m_entries.end() || it->key != key.getId()) {
+        Entry entry;
+        entry.key = key.getId();
+        entry.type = type;
+        it = m_entries.insert(it, entry);
+    } else if (it->type != type) {
+        // Replaced by a value of another type
+        if (it->type == PropertyType::String) releaseString(it->string);
+        it->type = type;
+    } else {
+        added = false;
+        return *it;
+    }
+    if (type == PropertyType::String) {
+        it->string = static_cast<uint32_t>(m_strings.size());
+        m_strings.emplace_back();
+    }
+    return *it;
+}
+
+void PropertyStore::releaseString(uint32_t index) {
+    // Move the last string into the freed place
+    auto last = static_cast<uint32_t>(m_strings.size() - 1);
+    if (index != last) {
+        m_strings[index] = std::move(m_strings[last]);
+        for (auto& entry : m_entries) {
+            if (entry.type == PropertyType::String && entry.string == last) {
+                entry.string = index;
+                break;
+            }
+        }
+    }
+    m_strings.pop_back();
+}
+
+bool PropertyStore::setFloat(PropertyKey key, float value) {
+    if (!key.isValid()) return false;
+    bool added;
+    Entry& entry = slot(key, PropertyType::Float, added);
+    if (!added && entry.f == value) return false;
+    entry.f = value;
+    return true;
+}
+
+bool PropertyStore::setInt(PropertyKey key, int value) {
+    if (!key.isValid()) return false;
+    bool added;
+    Entry& entry = slot(key, PropertyType::Int, added);
+    if (!added && entry.i == value) return false;
+    entry.i = value;
+    return true;
+}
+
+bool PropertyStore::setBool(PropertyKey key, bool value) {
+    if (!key.isValid()) return false;
+    bool added;
+    Entry& entry = slot(key, PropertyType::Bool, added);
+    if (!added && entry.b == value) return false;
+    entry.b = value;
+    return true;
+}
+
+bool PropertyStore::setString(PropertyKey key, std::string value) {
+    if (!key.isValid()) return false;
+    bool added;
+    std::string& stored = m_strings[slot(key, PropertyType::String, added).string];
+    if (!added && stored == value) return false;
+    stored = std::move(value);
+    return true;
+}
+
+float PropertyStore::getFloat(PropertyKey key, float defaultValue) const {
+    const Entry* entry = find(key);
+    return entry && entry->type == PropertyType::Float ? entry->f : defaultValue;
+}
+
+int PropertyStore::getInt(PropertyKey key, int defaultValue) const {
+    const Entry* entry = find(key);
+    return entry && entry->type == PropertyType::Int ? entry->i : defaultValue;
+}
+
+bool PropertyStore::getBool(PropertyKey key, bool defaultValue) const {
+    const Entry* entry = find(key);
+    return entry && entry->type == PropertyType::Bool ? entry->b : defaultValue;
+}
+
+const std::string& PropertyStore::getString(PropertyKey key, const std::string& defaultValue) const {
+    const Entry* entry = find(key);
+    return entry && entry->type == PropertyType::String ? m_strings[entry->string] : defaultValue;
+}
+
+bool PropertyStore::remove(PropertyKey key) {
+    const Entry* entry = find(key);
+    if (!entry) return false;
+    if (entry->type == PropertyType::String) releaseString(entry->string);
+    m_entries.erase(m_entries.begin() + (entry - m_entries.data()));
+    return true;
+}
+
+void PropertyStore::clear() {
+    m_entries.clear();
+    m_strings.clear();
+}
+
+// =============================================================================
+// WidgetState conversion
+// =============================================================================
+
+void PropertyStore::copyTo(std::map<std::string, std::any>& properties) const {
+    for (const auto& entry : m_entries) {
+        std::any& value = properties[PropertyKey(entry.key).getName()];
+        switch (entry.type) {
+            case PropertyType::Float: value = entry.f; break;
+            case PropertyType::Int: value = static_cast<int>(entry.i); break;
+            case PropertyType::Bool: value = entry.b; break;
+            case PropertyType::String: value = m_strings[entry.string]; break;
+        }
+    }
+}
+
+bool PropertyStore::set(PropertyKey key, const std::any& value) {
+    if (const auto* f = std::any_cast<float>(&value)) {
+        setFloat(key, *f);
+    } else if (const auto* i = std::any_cast<int>(&value)) {
+        setInt(key, *i);
+    } else if (const auto* b = std::any_cast<bool>(&value)) {
+        setBool(key, *b);
+    } else if (const auto* s = std::any_cast<std::string>(&value)) {
+        setString(key, *s);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+} // namespace KillerGK
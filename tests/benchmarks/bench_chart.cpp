@@ -0,0 +1,415 @@
+/**
+ * @file bench_chart.cpp
+ * @brief Benchmarks for preparing large Chart line series for drawing
+ *
+ * Times getRenderPoints() on series of 10K to 4M points in a 1600 pixel
+ * wide plot, for each decimation mode: the first call, a repeated call
+ * (cached), switching between two zoom levels, and appending a batch of
+ * points to a series on a fixed X axis, as a live feed does.
+ *
+ * A live metric keeping its latest 100K points is timed per tick of 100
+ * new points, through a ChartStream against replacing the series data and
+ * rescanning it for the axis ranges, and with the points pushed from a
+ * producer thread.
+ *
+ * A 5M point series of millisecond timestamps is stored as DataPoints and
+ * as ChartColumns in several layouts, comparing memory, the data range
+ * scan and the first decimation pass, and showing caller-owned arrays
+ * without copying.
+ *
+ * Hover lookups are timed on a 1M point line and a 500K point scatter
+ * plot, against scanning every point, including the first lookup (which
+ * builds the index) and lookups right after appending points.
+ *
+ * Results are printed to stdout; assertions only check that the decimated
+ * output stays within a few points per pixel column and that appending
+ * gives the same points as decimating from scratch.
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "KillerGK/widgets/Chart.hpp"
+#include "KillerGK/widgets/ChartColumns.hpp"
+#include "KillerGK/widgets/ChartStream.hpp"
+
+using namespace KillerGK;
+
+namespace {
+
+constexpr float kPlotWidth = 1600.0f;
+constexpr size_t kSizes[] = {10000, 100000, 1000000, 4000000};
+constexpr size_t kAppendBatch = 1000;
+constexpr int kRepeats = 20;
+constexpr size_t kLiveWindow = 100000;
+constexpr size_t kTickPoints = 100;
+constexpr size_t kTicks = 1000;
+constexpr size_t kReferenceTicks = 50;
+constexpr size_t kColumnPoints = 5000000;
+constexpr size_t kHoverLinePoints = 1000000;
+constexpr size_t kHoverScatterPoints = 500000;
+constexpr size_t kHoverQueries = 10000;
+constexpr size_t kReferenceQueries = 20;
+
+using Clock = std::chrono::steady_clock;
+
+double millisecondsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+/**
+ * @brief A noisy signal sampled at steady x intervals
+ */
+std::vector<DataPoint> makeSignal(size_t count, size_t offset = 0) {
+    std::mt19937 rng(static_cast<unsigned>(11 + offset));
+    std::normal_distribution<double> noise(0.0, 5.0);
+    std::vector<DataPoint> points;
+    points.reserve(count);
+    for (size_t i = offset; i < offset + count; ++i) {
+        double x = static_cast<double>(i);
+        points.emplace_back(x, 100.0 * std::sin(x / 5000.0) + noise(rng));
+    }
+    return points;
+}
+
+Chart makeChart(ChartDecimation mode, double xMin, double xMax) {
+    ChartAxis axis;
+    axis.autoScale = false;
+    axis.min = xMin;
+    axis.max = xMax;
+    auto chart = Chart::create();
+    chart.chartType(ChartType::Line).xAxis(axis).chartPadding(0, 0, 0, 0).decimation(mode);
+    chart.width(kPlotWidth);
+    return chart;
+}
+
+const char* modeName(ChartDecimation mode) {
+    switch (mode) {
+        case ChartDecimation::None: return "None";
+        case ChartDecimation::MinMax: return "MinMax";
+        case ChartDecimation::Lttb: return "Lttb";
+    }
+    return "";
+}
+
+} // namespace
+
+TEST(ChartBenchmark, RenderPoints) {
+    for (size_t size : kSizes) {
+        ChartSeries series("signal", "Signal");
+        series.data = makeSignal(size);
+        double xMax = static_cast<double>(size - 1);
+
+        for (auto mode : {ChartDecimation::None, ChartDecimation::MinMax, ChartDecimation::Lttb}) {
+            auto chart = makeChart(mode, 0.0, xMax);
+            chart.addSeries(series);
+
+            auto start = Clock::now();
+            size_t drawn = chart.getRenderPoints("signal").size();
+            double coldMs = millisecondsSince(start);
+            if (mode != ChartDecimation::None) {
+                EXPECT_LE(drawn, 4 * static_cast<size_t>(kPlotWidth) + 2);
+            }
+
+            start = Clock::now();
+            for (int i = 0; i < kRepeats; ++i) {
+                (void)chart.getRenderPoints("signal");
+            }
+            double cachedUs = millisecondsSince(start) * 1000.0 / kRepeats;
+
+            // Alternate between the whole series and its middle half
+            start = Clock::now();
+            for (int i = 0; i < kRepeats; ++i) {
+                chart.getXAxis().min = i % 2 ? xMax / 4 : 0.0;
+                chart.getXAxis().max = i % 2 ? xMax * 3 / 4 : xMax;
+                (void)chart.getRenderPoints("signal");
+            }
+            double zoomUs = millisecondsSince(start) * 1000.0 / kRepeats;
+
+            std::cout << "[bench] " << size << " points, " << modeName(mode) << ": " << drawn
+                      << " drawn; first " << coldMs << " ms, cached " << cachedUs << " us, zoom toggle "
+                      << zoomUs << " us\n";
+        }
+    }
+}
+
+TEST(ChartBenchmark, AppendToLiveSeries) {
+    // The X axis spans the final size, so the view stays put while points arrive
+    for (size_t size : kSizes) {
+        double xMax = static_cast<double>(size + kAppendBatch * kRepeats);
+        for (auto mode : {ChartDecimation::MinMax, ChartDecimation::Lttb}) {
+            auto chart = makeChart(mode, 0.0, xMax);
+            ChartSeries series("signal", "Signal");
+            series.data = makeSignal(size);
+            chart.addSeries(series);
+            // Growing the vector is not what is being timed
+            chart.getSeriesById("signal")->data.reserve(size + kAppendBatch * kRepeats);
+            (void)chart.getRenderPoints("signal");
+
+            std::vector<std::vector<DataPoint>> batches;
+            for (int i = 0; i < kRepeats; ++i) {
+                batches.push_back(makeSignal(kAppendBatch, size + kAppendBatch * i));
+            }
+
+            auto start = Clock::now();
+            for (const auto& batch : batches) {
+                chart.appendPoints("signal", batch);
+                (void)chart.getRenderPoints("signal");
+            }
+            double appendUs = millisecondsSince(start) * 1000.0 / kRepeats;
+
+            // The previous approach: every change redoes the whole series
+            auto fresh = makeChart(mode, 0.0, xMax);
+            fresh.addSeries(*chart.getSeriesById("signal"));
+            start = Clock::now();
+            const auto& expected = fresh.getRenderPoints("signal");
+            double rebuildUs = millisecondsSince(start) * 1000.0;
+
+            const auto& appended = chart.getRenderPoints("signal");
+            ASSERT_EQ(appended.size(), expected.size());
+            for (size_t i = 0; i < expected.size(); ++i) {
+                EXPECT_EQ(appended[i].index, expected[i].index);
+            }
+
+            std::cout << "[bench] " << size << " points, " << modeName(mode) << ": append " << kAppendBatch
+                      << " + render points " << appendUs << " us, rebuild " << rebuildUs << " us ("
+                      << rebuildUs / appendUs << "x)\n";
+        }
+    }
+}
+
+TEST(ChartBenchmark, LiveMetricStream) {
+    auto points = makeSignal(kLiveWindow + kTickPoints * kTicks);
+    std::vector<std::vector<DataPoint>> ticks;
+    for (size_t t = 0; t < kTicks; ++t) {
+        auto first = points.begin() + static_cast<std::ptrdiff_t>(kLiveWindow + t * kTickPoints);
+        ticks.emplace_back(first, first + static_cast<std::ptrdiff_t>(kTickPoints));
+    }
+    std::vector<DataPoint> initial(points.begin(), points.begin() + static_cast<std::ptrdiff_t>(kLiveWindow));
+    double minX, maxX, minY, maxY;
+
+    // The previous approach: keep the window in a vector and hand it over whole
+    auto chart = Chart::create();
+    chart.addSeries(ChartSeries("live", "Live"));
+    std::vector<DataPoint> window = initial;
+    auto start = Clock::now();
+    for (size_t t = 0; t < kReferenceTicks; ++t) {
+        window.erase(window.begin(), window.begin() + static_cast<std::ptrdiff_t>(kTickPoints));
+        window.insert(window.end(), ticks[t].begin(), ticks[t].end());
+        chart.updateSeriesData("live", window);
+        chart.getDataRange(minX, maxX, minY, maxY);
+    }
+    double referenceUs = millisecondsSince(start) * 1000.0 / kReferenceTicks;
+    double referenceMin = minY;
+    double referenceMax = maxY;
+
+    // Stream, pushed on the same thread
+    auto stream = std::make_shared<ChartStream>(kLiveWindow);
+    auto streamed = Chart::create();
+    streamed.addSeries(ChartSeries("live", "Live")).streamSeries("live", stream);
+    stream->push(initial);
+    streamed.updateStreams();
+    start = Clock::now();
+    for (size_t t = 0; t < kReferenceTicks; ++t) {
+        stream->push(ticks[t]);
+        streamed.updateStreams();
+        streamed.getDataRange(minX, maxX, minY, maxY);
+    }
+    double streamUs = millisecondsSince(start) * 1000.0 / kReferenceTicks;
+    EXPECT_EQ(minY, referenceMin);
+    EXPECT_EQ(maxY, referenceMax);
+    std::cout << "[bench] " << kLiveWindow << " point window, tick of " << kTickPoints
+              << " points + data range: stream " << streamUs << " us, replace data " << referenceUs << " us ("
+              << referenceUs / streamUs << "x)\n";
+
+    // Stream fed by a producer thread; the UI thread only takes points in
+    auto threaded = std::make_shared<ChartStream>(kLiveWindow);
+    auto live = Chart::create();
+    live.addSeries(ChartSeries("live", "Live")).streamSeries("live", threaded);
+    threaded->push(initial);
+    live.updateStreams();
+    uint64_t expected = kLiveWindow + kTicks * kTickPoints;
+    std::thread producer([&]() {
+        for (const auto& tick : ticks) {
+            for (size_t sent = 0; sent < tick.size();) {
+                std::vector<DataPoint> rest(tick.begin() + static_cast<std::ptrdiff_t>(sent), tick.end());
+                sent += threaded->push(rest);
+            }
+        }
+    });
+    size_t frames = 0;
+    double uiMs = 0.0;
+    while (threaded->getTotalCount() < expected) {
+        start = Clock::now();
+        live.updateStreams();
+        live.getDataRange(minX, maxX, minY, maxY);
+        uiMs += millisecondsSince(start);
+        frames++;
+        std::this_thread::yield();
+    }
+    producer.join();
+    std::cout << "[bench]   producer thread, " << kTicks << " ticks taken in over " << frames
+              << " frames: UI thread " << uiMs << " ms in all, "
+              << uiMs * 1e6 / static_cast<double>(kTicks * kTickPoints) << " ns per point\n";
+
+    start = Clock::now();
+    EXPECT_EQ(live.getRenderPoints("live").back().x, points.back().x);
+    std::cout << "[bench]   render points of the full window: " << millisecondsSince(start) << " ms\n";
+}
+
+TEST(ChartBenchmark, ColumnStorage) {
+    std::vector<double> times(kColumnPoints);
+    std::vector<double> values(kColumnPoints);
+    std::mt19937 rng(5);
+    double time = 1.7e12;  // Milliseconds since the epoch
+    for (size_t i = 0; i < kColumnPoints; ++i) {
+        time += 1 + rng() % 20;
+        times[i] = time;
+        values[i] = 100.0 * std::sin(static_cast<double>(i) / 5000.0) + static_cast<double>(rng() % 100) / 10.0;
+    }
+
+    auto measure = [&](const char* name, const ChartSeries& series, size_t bytes) {
+        auto chart = makeChart(ChartDecimation::MinMax, times.front(), times.back());
+        chart.addSeries(series);
+        double minX, maxX, minY, maxY;
+        auto start = Clock::now();
+        chart.getDataRange(minX, maxX, minY, maxY);
+        double rangeMs = millisecondsSince(start);
+        start = Clock::now();
+        size_t drawn = chart.getRenderPoints(series.id).size();
+        double renderMs = millisecondsSince(start);
+        EXPECT_GT(drawn, 0u);
+        std::cout << "[bench]   " << name << ": " << bytes / (1024 * 1024) << " MB, data range " << rangeMs
+                  << " ms, first MinMax pass " << renderMs << " ms\n";
+        return maxY;
+    };
+
+    std::cout << "[bench] " << kColumnPoints << " points\n";
+    double expectedMax;
+    {
+        ChartSeries series("points", "DataPoints");
+        auto start = Clock::now();
+        series.data.reserve(kColumnPoints);
+        for (size_t i = 0; i < kColumnPoints; ++i) {
+            series.data.emplace_back(times[i], values[i]);
+        }
+        double fillMs = millisecondsSince(start);
+        expectedMax = measure("DataPoint vector", series, series.data.capacity() * sizeof(DataPoint));
+        std::cout << "[bench]     (filled in " << fillMs << " ms)\n";
+    }
+
+    struct Layout {
+        const char* name;
+        ChartColumnType x;
+        ChartColumnType y;
+    };
+    for (const auto& layout : {Layout{"columns Float64/Float64", ChartColumnType::Float64, ChartColumnType::Float64},
+                               Layout{"columns Delta32/Float32", ChartColumnType::Delta32, ChartColumnType::Float32}}) {
+        ChartSeries series("columns", layout.name);
+        series.columns = std::make_shared<ChartColumns>(layout.x, layout.y);
+        auto start = Clock::now();
+        series.columns->reserve(kColumnPoints);
+        series.columns->append(times, values);
+        double fillMs = millisecondsSince(start);
+        EXPECT_EQ(series.columns->getXType(), layout.x);
+        EXPECT_EQ(series.columns->x(kColumnPoints - 1), times.back());
+        double maxY = measure(layout.name, series, series.columns->memoryUsage());
+        if (layout.y == ChartColumnType::Float64) {
+            EXPECT_EQ(maxY, expectedMax);
+        }
+        std::cout << "[bench]     (filled in " << fillMs << " ms)\n";
+    }
+
+    ChartSeries series("view", "View");
+    auto start = Clock::now();
+    series.columns = std::make_shared<ChartColumns>();
+    series.columns->viewX(times).viewY(values);
+    double viewUs = millisecondsSince(start) * 1000.0;
+    double maxY = measure("view of caller's arrays", series, series.columns->memoryUsage());
+    EXPECT_EQ(maxY, expectedMax);
+    std::cout << "[bench]     (viewed in " << viewUs << " us)\n";
+}
+
+TEST(ChartBenchmark, HoverHitTest) {
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    ChartSeries line("line", "Line");
+    line.data = makeSignal(kHoverLinePoints);
+    ChartSeries scatter("scatter", "Scatter");
+    for (size_t i = 0; i < kHoverScatterPoints; ++i) {
+        scatter.addPoint(unit(rng) * 1000.0, unit(rng) * 1000.0);
+    }
+
+    for (const auto* series : {&line, &scatter}) {
+        auto chart = Chart::create();
+        chart.chartType(series == &line ? ChartType::Line : ChartType::Scatter).addSeries(*series);
+        chart.width(kPlotWidth).height(900.0f);
+
+        std::vector<std::pair<float, float>> cursor(kHoverQueries);
+        for (auto& [x, y] : cursor) {
+            x = static_cast<float>(unit(rng) * kPlotWidth);
+            y = static_cast<float>(unit(rng) * 900.0);
+        }
+
+        auto start = Clock::now();
+        auto first = chart.hitTest(cursor[0].first, cursor[0].second);
+        double firstMs = millisecondsSince(start);
+
+        start = Clock::now();
+        size_t hits = 0;
+        for (const auto& [x, y] : cursor) {
+            hits += !chart.hitTest(x, y).seriesId.empty();
+        }
+        double indexedUs = millisecondsSince(start) * 1000.0 / kHoverQueries;
+
+        // The previous approach: every point, every mouse move
+        double minX, maxX, minY, maxY;
+        chart.getVisibleXRange(minX, maxX);
+        chart.getVisibleYRange(minY, maxY);
+        double scaleX = (kPlotWidth - 70.0) / (maxX - minX);
+        double scaleY = (900.0 - 60.0) / (maxY - minY);
+        start = Clock::now();
+        for (size_t q = 0; q < kReferenceQueries; ++q) {
+            double queryX = minX + (cursor[q].first - 50.0) / scaleX;
+            double queryY = minY + (900.0 - 40.0 - cursor[q].second) / scaleY;
+            double best = chart.getHitRadius();
+            size_t nearest = static_cast<size_t>(-1);
+            for (size_t i = 0; i < series->data.size(); ++i) {
+                double dx = (series->data[i].x - queryX) * scaleX;
+                double dy = (series->data[i].y - queryY) * scaleY;
+                double distance = std::sqrt(dx * dx + dy * dy);
+                if (distance < best || (distance == best && nearest == static_cast<size_t>(-1))) {
+                    best = distance;
+                    nearest = i;
+                }
+            }
+            auto hit = chart.hitTest(cursor[q].first, cursor[q].second);
+            EXPECT_EQ(hit.seriesId.empty() ? static_cast<size_t>(-1) : hit.index, nearest);
+        }
+        double referenceUs = millisecondsSince(start) * 1000.0 / kReferenceQueries;
+        (void)first;
+
+        // Appending keeps the index: only the new points are taken in
+        chart.getSeriesById(series->id)->data.reserve(series->data.size() + kAppendBatch * kRepeats);
+        start = Clock::now();
+        for (int i = 0; i < kRepeats; ++i) {
+            auto more = makeSignal(kAppendBatch, series->data.size() + kAppendBatch * static_cast<size_t>(i));
+            if (series == &scatter) {
+                for (auto& point : more) point = DataPoint(unit(rng) * 1000.0, unit(rng) * 1000.0);
+            }
+            chart.appendPoints(series->id, more);
+            (void)chart.hitTest(cursor[static_cast<size_t>(i)].first, cursor[static_cast<size_t>(i)].second);
+        }
+        double appendUs = millisecondsSince(start) * 1000.0 / kRepeats;
+
+        std::cout << "[bench] " << series->data.size() << " point " << series->name << ": first hitTest "
+                  << firstMs << " ms, then " << indexedUs << " us (" << hits << "/" << kHoverQueries
+                  << " hits), scan " << referenceUs << " us (" << referenceUs / indexedUs << "x); append "
+                  << kAppendBatch << " + hitTest " << appendUs << " us\n";
+    }
+}
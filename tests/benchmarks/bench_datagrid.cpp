@@ -0,0 +1,671 @@
+/**
+ * @file bench_datagrid.cpp
+ * @brief Benchmarks for DataGrid sorting and filtering
+ *
+ * Sorts and filters grids of 10k, 100k and 1M rows through the public
+ * DataGrid API (columnar storage) and, up to 100k rows, through a reference
+ * implementation of the previous row-map approach that looked every cell up
+ * by column id in each comparison.
+ *
+ * A second benchmark types a search term one key at a time and appends rows
+ * to a sorted grid, comparing the incremental updates against rebuilding the
+ * filtered and sorted view from scratch.
+ *
+ * Sorting by one and two columns is timed on 1M rows with 1, 2, 4 and 8
+ * sort threads; every thread count must produce the same order.
+ *
+ * Selection is measured on a 200k-row grid: shift-click ranges of 10k rows
+ * and ctrl-click selection of 10k rows one by one.
+ *
+ * Grouping a 100k-row grid by city is timed under a live feed of score
+ * updates, reading the group aggregates after every change, against
+ * recomputing the groups each time.
+ *
+ * Typed filter expressions (comparison, prefix, an AND/OR composite) are
+ * timed on 1M rows against the equivalent custom std::function filter and
+ * the text filter.
+ *
+ * A generated 2M-row CSV file is loaded with DataGridCsvLoader, timing the
+ * first screen and the full load against reading it line by line into
+ * DataGridRow objects.
+ *
+ * A third benchmark scrolls through a generated multi-million-row log served
+ * by a DataGridDataSource, checking that the grid only holds a window.
+ *
+ * Results are printed to stdout; assertions only check that sorted output is
+ * ordered and that filter counts match the reference.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "KillerGK/widgets/DataGrid.hpp"
+#include "KillerGK/widgets/DataGridCsv.hpp"
+
+using namespace KillerGK;
+
+namespace {
+
+constexpr size_t kReferenceLimit = 100000;
+
+using Clock = std::chrono::steady_clock;
+
+double millisecondsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+std::vector<DataGridRow> makeRows(size_t count) {
+    static const char* firstNames[] = {
+        "Anna", "Bernd", "Chiara", "Dmitri", "Elif", "Farah", "Goran", "Hana",
+        "Ines", "Jonas", "Kaito", "Lena", "Mateo", "Nadia", "Omar", "Priya"
+    };
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<double> score(-1000.0, 1000.0);
+    std::uniform_int_distribution<int64_t> quantity(0, 100000);
+
+    std::vector<DataGridRow> rows;
+    rows.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        DataGridRow row("row_" + std::to_string(i));
+        // Names repeat (as real data does): 16 first names x 2000 suffixes
+        row.setCell("name", std::string(firstNames[rng() % 16]) + " " + std::to_string(rng() % 2000));
+        row.setCell("score", score(rng));
+        row.setCell("quantity", quantity(rng));
+        row.setCell("city", "City " + std::to_string(rng() % 200));
+        rows.push_back(std::move(row));
+    }
+    return rows;
+}
+
+/**
+ * @brief The previous approach: std::map lookups per cell, per comparison
+ */
+std::vector<size_t> referenceSort(const std::vector<DataGridRow>& rows, const std::string& columnId) {
+    std::vector<size_t> indices(rows.size());
+    for (size_t i = 0; i < indices.size(); ++i) {
+        indices[i] = i;
+    }
+    std::sort(indices.begin(), indices.end(), [&](size_t a, size_t b) {
+        auto itA = rows[a].cells.find(columnId);
+        auto itB = rows[b].cells.find(columnId);
+        if (itA == rows[a].cells.end() || itB == rows[b].cells.end()) {
+            return itA == rows[a].cells.end() && itB != rows[b].cells.end();
+        }
+        return itA->second < itB->second;
+    });
+    return indices;
+}
+
+size_t referenceTextFilter(const std::vector<DataGridRow>& rows, const std::string& columnId,
+                           const std::string& text) {
+    size_t matches = 0;
+    for (const auto& row : rows) {
+        auto it = row.cells.find(columnId);
+        if (it == row.cells.end()) {
+            matches++;
+            continue;
+        }
+        std::string cellText = std::get<std::string>(it->second);
+        std::transform(cellText.begin(), cellText.end(), cellText.begin(),
+            [](unsigned char c) { return std::tolower(c); });
+        if (cellText.find(text) != std::string::npos) {
+            matches++;
+        }
+    }
+    return matches;
+}
+
+template<typename T>
+bool isOrdered(const std::vector<DataGridRow>& rows, const std::string& columnId, bool ascending) {
+    for (size_t i = 1; i < rows.size(); ++i) {
+        const T& prev = std::get<T>(rows[i - 1].cells.at(columnId));
+        const T& curr = std::get<T>(rows[i].cells.at(columnId));
+        if (ascending ? curr < prev : prev < curr) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief A log that exists only as a formula, so it costs no memory
+ */
+class GeneratedLogSource : public DataGridDataSource {
+public:
+    explicit GeneratedLogSource(size_t count) : m_count(count) {}
+
+    size_t rowCount() const override { return m_count; }
+
+    std::vector<DataGridRow> fetchRows(size_t first, size_t count) override {
+        static const char* levels[] = {"DEBUG", "INFO", "WARN", "ERROR"};
+        std::vector<DataGridRow> rows;
+        for (size_t i = first; i < std::min(m_count, first + count); ++i) {
+            DataGridRow row("line_" + std::to_string(i));
+            row.setCell("line", static_cast<int64_t>(i));
+            row.setCell("level", std::string(levels[(i * 7) % 4]));
+            row.setCell("message", "request " + std::to_string(i * 2654435761u % 100000) + " handled");
+            rows.push_back(std::move(row));
+        }
+        fetchedRows += rows.size();
+        fetches++;
+        return rows;
+    }
+
+    size_t fetchedRows = 0;
+    size_t fetches = 0;
+
+private:
+    size_t m_count;
+};
+
+/**
+ * @brief Row ids at regular display positions, to compare orders cheaply
+ */
+std::vector<std::string> sampleOrder(const DataGrid& grid, size_t samples) {
+    std::vector<std::string> ids;
+    size_t count = grid.getFilteredRowCount();
+    for (size_t i = 0; i < samples; ++i) {
+        auto rows = grid.getDisplayedRowRange(i * count / samples, 1);
+        ids.push_back(rows.empty() ? std::string() : rows.front().id);
+    }
+    return ids;
+}
+
+} // namespace
+
+TEST(DataGridBenchmark, SortAndFilter) {
+    for (size_t count : {size_t(10000), size_t(100000), size_t(1000000)}) {
+        auto rows = makeRows(count);
+
+        auto start = Clock::now();
+        auto grid = DataGrid::create();
+        grid.rows(rows);
+        double loadMs = millisecondsSince(start);
+
+        std::cout << "[bench] " << count << " rows (load " << loadMs << " ms)\n";
+
+        // Sorting
+        for (const char* columnId : {"name", "score", "quantity"}) {
+            start = Clock::now();
+            grid.sortBy(columnId, SortDirection::Ascending);
+            size_t shown = grid.getFilteredRowCount();
+            double gridMs = millisecondsSince(start);
+            EXPECT_EQ(shown, count);
+
+            std::cout << "[bench]   sort " << columnId << ": columnar " << gridMs << " ms";
+            if (count <= kReferenceLimit) {
+                start = Clock::now();
+                auto reference = referenceSort(rows, columnId);
+                double referenceMs = millisecondsSince(start);
+                EXPECT_EQ(reference.size(), count);
+                std::cout << ", row-map " << referenceMs << " ms (" << referenceMs / gridMs << "x)";
+            }
+            std::cout << "\n";
+        }
+
+        grid.clearSort();
+
+        // Text filter
+        start = Clock::now();
+        grid.setFilter("name", "NA 1");
+        size_t textMatches = grid.getFilteredRowCount();
+        double textMs = millisecondsSince(start);
+        std::cout << "[bench]   text filter: columnar " << textMs << " ms (" << textMatches << " rows)";
+        if (count <= kReferenceLimit) {
+            start = Clock::now();
+            size_t expected = referenceTextFilter(rows, "name", "na 1");
+            double referenceMs = millisecondsSince(start);
+            EXPECT_EQ(textMatches, expected);
+            std::cout << ", row-map " << referenceMs << " ms (" << referenceMs / textMs << "x)";
+        }
+        std::cout << "\n";
+        grid.clearAllFilters();
+
+        // Custom predicate filter
+        start = Clock::now();
+        grid.setFilter("score", [](const CellValue& value) {
+            return std::holds_alternative<double>(value) && std::get<double>(value) > 500.0;
+        });
+        size_t customMatches = grid.getFilteredRowCount();
+        std::cout << "[bench]   custom filter: columnar " << millisecondsSince(start) << " ms ("
+                  << customMatches << " rows)\n";
+        EXPECT_GT(customMatches, 0u);
+        EXPECT_LT(customMatches, count);
+        grid.clearAllFilters();
+
+        // Order checks last: materializing rows churns the heap and would
+        // distort the timings above
+        if (count <= kReferenceLimit) {
+            grid.sortBy("score", SortDirection::Descending);
+            EXPECT_TRUE(isOrdered<double>(grid.getDisplayedRows(), "score", false));
+            grid.sortBy("name", SortDirection::Ascending);
+            EXPECT_TRUE(isOrdered<std::string>(grid.getDisplayedRows(), "name", true));
+        }
+    }
+}
+
+TEST(DataGridBenchmark, IncrementalUpdates) {
+    const std::string term = "nadia 1";
+
+    for (size_t count : {size_t(100000), size_t(1000000)}) {
+        auto rows = makeRows(count);
+        auto grid = DataGrid::create();
+        grid.rows(rows);
+        grid.sortBy("score", SortDirection::Ascending);
+        (void)grid.getFilteredRowCount();
+
+        std::cout << "[bench] " << count << " rows, sorted by score\n";
+
+        // Each keystroke narrows the previous result
+        auto start = Clock::now();
+        for (size_t length = 1; length <= term.size(); ++length) {
+            grid.setFilter("name", term.substr(0, length));
+            (void)grid.getFilteredRowCount();
+        }
+        double typingMs = millisecondsSince(start);
+        size_t matches = grid.getFilteredRowCount();
+
+        // Rebuilding for every keystroke, as a fresh grid has to
+        start = Clock::now();
+        for (size_t length = 1; length <= term.size(); ++length) {
+            grid.clearAllFilters();
+            grid.setFilter("name", term.substr(0, length));
+            (void)grid.getFilteredRowCount();
+        }
+        double rebuildMs = millisecondsSince(start);
+        EXPECT_EQ(grid.getFilteredRowCount(), matches);
+
+        std::cout << "[bench]   type \"" << term << "\": incremental " << typingMs
+                  << " ms, rebuild " << rebuildMs << " ms (" << rebuildMs / typingMs << "x, "
+                  << matches << " rows)\n";
+        grid.clearAllFilters();
+
+        // Rows added to a sorted grid are placed without a resort
+        constexpr size_t kAppends = 1000;
+        auto extra = makeRows(kAppends);
+        (void)grid.getFilteredRowCount();
+        start = Clock::now();
+        for (const auto& row : extra) {
+            grid.addRow(row);
+            (void)grid.getFilteredRowCount();
+        }
+        double appendMs = millisecondsSince(start);
+
+        grid.clearSort();
+        (void)grid.getFilteredRowCount();
+        start = Clock::now();
+        grid.sortBy("score", SortDirection::Ascending);
+        size_t shown = grid.getFilteredRowCount();
+        double resortMs = millisecondsSince(start);
+        EXPECT_EQ(shown, count + kAppends);
+
+        std::cout << "[bench]   " << kAppends << " sorted appends: " << appendMs / kAppends
+                  << " ms/row, full resort " << resortMs << " ms\n";
+
+        if (count <= kReferenceLimit) {
+            EXPECT_TRUE(isOrdered<double>(grid.getDisplayedRows(), "score", true));
+        }
+    }
+}
+
+TEST(DataGridBenchmark, DataSourceScrolling) {
+    constexpr size_t kLines = 5000000;
+    constexpr int kFrames = 20000;
+    constexpr float kRowHeight = 20.0f;
+
+    auto source = std::make_shared<GeneratedLogSource>(kLines);
+    auto grid = DataGrid::create();
+    grid.rowHeight(kRowHeight).headerHeight(0.0f);
+    grid.height(800.0f);
+    grid.prefetchRows(200).dataSource(source);
+
+    // Scroll a few rows per frame, jumping elsewhere now and then
+    std::mt19937 rng(99);
+    std::uniform_int_distribution<size_t> anyLine(0, kLines - 1);
+    size_t visibleRows = 0;
+    size_t largestWindow = 0;
+
+    auto start = Clock::now();
+    for (int frame = 0; frame < kFrames; ++frame) {
+        if (frame % 1000 == 0) {
+            grid.scrollTo(static_cast<float>(anyLine(rng)) * kRowHeight);
+        } else {
+            grid.scrollTo(grid.getScrollOffset() + 3 * kRowHeight);
+        }
+        visibleRows += grid.getVisibleRows().size();
+        largestWindow = std::max(largestWindow, grid.getRows().size());
+    }
+    double scrollMs = millisecondsSince(start);
+
+    std::cout << "[bench] " << kLines << " row source, " << kFrames << " frames: "
+              << scrollMs * 1000.0 / kFrames << " us/frame, " << source->fetches << " fetches, "
+              << source->fetchedRows << " rows fetched, window <= " << largestWindow << " rows\n";
+
+    EXPECT_EQ(grid.getFilteredRowCount(), kLines);
+    EXPECT_GE(visibleRows, size_t(kFrames) * 40);
+    EXPECT_LE(largestWindow, 41u + 2 * 200u);
+}
+
+TEST(DataGridBenchmark, Selection) {
+    constexpr size_t kRows = 200000;
+    constexpr size_t kRange = 10000;
+
+    auto grid = DataGrid::create();
+    grid.rows(makeRows(kRows)).multiSelect(true);
+    grid.sortBy("score", SortDirection::Ascending);
+
+    size_t deltaRows = 0;
+    grid.onSelectionDelta([&deltaRows](const DataGridSelectionDelta& delta) {
+        deltaRows += delta.added.size() + delta.removed.size();
+    });
+
+    // Shift-click ranges, each replacing the previous one
+    auto start = Clock::now();
+    for (size_t first = 0; first < 10 * kRange; first += kRange) {
+        grid.selectRange(first, first + kRange - 1);
+    }
+    double rangeMs = millisecondsSince(start) / 10;
+    EXPECT_EQ(grid.getSelectedRowIds().size(), kRange);
+
+    // Ctrl-click rows one at a time
+    grid.clearSelection();
+    auto ids = grid.getDisplayedRowRange(kRows / 2, kRange);
+    start = Clock::now();
+    for (const auto& row : ids) {
+        grid.selectRow(row.id, true);
+    }
+    double clickMs = millisecondsSince(start);
+    EXPECT_EQ(grid.getSelectedRowIds().size(), kRange);
+
+    // Deselect them again
+    start = Clock::now();
+    for (size_t i = 0; i < ids.size(); i += 10) {
+        grid.deselectRow(ids[i].id);
+    }
+    double deselectMs = millisecondsSince(start);
+    EXPECT_EQ(grid.getSelectedRowIds().size(), kRange - kRange / 10);
+
+    std::cout << "[bench] " << kRows << " rows: select range of " << kRange << " " << rangeMs
+              << " ms, " << kRange << " ctrl-clicks " << clickMs << " ms, " << kRange / 10
+              << " deselects " << deselectMs << " ms (" << deltaRows << " rows in deltas)\n";
+}
+
+TEST(DataGridBenchmark, ParallelMultiColumnSort) {
+    constexpr size_t kRows = 1000000;
+
+    auto grid = DataGrid::create();
+    grid.rows(makeRows(kRows));
+    std::cout << "[bench] " << kRows << " rows, " << std::thread::hardware_concurrency()
+              << " hardware threads\n";
+
+    const std::vector<std::pair<const char*, std::vector<DataGridSortKey>>> orders = {
+        {"score", {{"score", SortDirection::Ascending}}},
+        {"name", {{"name", SortDirection::Ascending}}},
+        {"city, score desc", {{"city", SortDirection::Ascending}, {"score", SortDirection::Descending}}},
+    };
+
+    for (const auto& [label, keys] : orders) {
+        std::vector<std::string> reference;
+        double sequentialMs = 0.0;
+
+        std::cout << "[bench]   sort " << label << ":";
+        for (size_t threads : {size_t(1), size_t(2), size_t(4), size_t(8)}) {
+            grid.sortThreads(threads).clearSort();
+            (void)grid.getFilteredRowCount();
+
+            auto start = Clock::now();
+            grid.sortBy(keys);
+            (void)grid.getFilteredRowCount();
+            double sortMs = millisecondsSince(start);
+
+            auto order = sampleOrder(grid, 1000);
+            if (threads == 1) {
+                reference = order;
+                sequentialMs = sortMs;
+            }
+            EXPECT_EQ(order, reference);
+            std::cout << "  " << threads << "t " << sortMs << " ms (" << sequentialMs / sortMs << "x)";
+        }
+        std::cout << "\n";
+    }
+}
+
+TEST(DataGridBenchmark, GroupedLiveUpdates) {
+    constexpr size_t kRows = 100000;
+    constexpr size_t kUpdates = 10000;
+    constexpr size_t kRebuilds = 50;
+
+    auto rows = makeRows(kRows);
+    auto grid = DataGrid::create();
+    grid.rows(rows);
+    grid.sortBy("score", SortDirection::Descending);
+    grid.aggregates({{"score", AggregateFunction::Sum},
+                     {"score", AggregateFunction::Average},
+                     {"score", AggregateFunction::Min},
+                     {"score", AggregateFunction::Max}});
+
+    auto start = Clock::now();
+    grid.groupBy("city");
+    size_t groupCount = grid.getGroups().size();
+    double groupMs = millisecondsSince(start);
+    std::cout << "[bench] " << kRows << " rows grouped by city: " << groupCount << " groups in "
+              << groupMs << " ms\n";
+
+    // A live feed: one score changes, the summary is read back
+    std::mt19937 rng(99);
+    std::uniform_real_distribution<double> score(-1000.0, 1000.0);
+    start = Clock::now();
+    for (size_t i = 0; i < kUpdates; ++i) {
+        grid.setCell(rows[rng() % kRows].id, "score", score(rng));
+        (void)grid.getGroups();
+    }
+    double updateMs = millisecondsSince(start);
+
+    // Recomputing every group after each change
+    start = Clock::now();
+    for (size_t i = 0; i < kRebuilds; ++i) {
+        grid.setCell(rows[rng() % kRows].id, "score", score(rng));
+        grid.groupBy("city");
+        (void)grid.getGroups();
+    }
+    double rebuildMs = millisecondsSince(start);
+
+    std::cout << "[bench]   update + read: incremental " << updateMs / kUpdates << " ms, recompute "
+              << rebuildMs / kRebuilds << " ms (" << (rebuildMs / kRebuilds) / (updateMs / kUpdates)
+              << "x)\n";
+
+    // Adding and removing rows moves them between groups
+    auto extra = makeRows(1000);
+    start = Clock::now();
+    for (auto& row : extra) {
+        row.id = "extra_" + row.id;
+        grid.addRow(row);
+    }
+    for (const auto& row : extra) {
+        grid.removeRow(row.id);
+    }
+    (void)grid.getGroups();
+    std::cout << "[bench]   1000 adds + 1000 removes: " << millisecondsSince(start) << " ms\n";
+
+    // Incremental results match a fresh grouping
+    auto incremental = grid.getGroups();
+    grid.groupBy("city");
+    auto rebuilt = grid.getGroups();
+    ASSERT_EQ(incremental.size(), rebuilt.size());
+    for (size_t i = 0; i < rebuilt.size(); ++i) {
+        EXPECT_EQ(incremental[i].key, rebuilt[i].key);
+        EXPECT_EQ(incremental[i].rowCount, rebuilt[i].rowCount);
+        EXPECT_NEAR(incremental[i].aggregates[0], rebuilt[i].aggregates[0], 1e-6);
+        EXPECT_EQ(incremental[i].aggregates[2], rebuilt[i].aggregates[2]);
+        EXPECT_EQ(incremental[i].aggregates[3], rebuilt[i].aggregates[3]);
+    }
+}
+
+TEST(DataGridBenchmark, FilterExpressions) {
+    using F = DataGridFilterExpr;
+    constexpr size_t kRows = 1000000;
+    constexpr int kRuns = 5;
+
+    auto rows = makeRows(kRows);
+    auto grid = DataGrid::create();
+    grid.rows(rows);
+    (void)grid.getFilteredRowCount();
+
+    // Average time to apply a filter and count the rows it keeps
+    auto time = [&grid](const std::function<void(int run)>& apply) {
+        size_t count = 0;
+        auto start = Clock::now();
+        for (int run = 0; run < kRuns; ++run) {
+            grid.clearAllFilters();
+            apply(run);
+            count = grid.getFilteredRowCount();
+        }
+        return std::make_pair(millisecondsSince(start) / kRuns, count);
+    };
+
+    auto [typedMs, typedCount] = time([&grid](int run) {
+        grid.setFilter("high", F::greater("score", 500.0 - run));
+    });
+    auto [customMs, customCount] = time([&grid](int run) {
+        double threshold = 500.0 - run;
+        grid.setFilter("score", [threshold](const CellValue& value) {
+            return std::holds_alternative<double>(value) && std::get<double>(value) > threshold;
+        });
+    });
+    EXPECT_EQ(typedCount, customCount);
+    std::cout << "[bench] " << kRows << " rows, score > 500: expression " << typedMs << " ms, custom filter "
+              << customMs << " ms (" << customMs / typedMs << "x), " << typedCount << " rows\n";
+
+    auto [prefixMs, prefixCount] = time([&grid](int) {
+        grid.setFilter("omar", F::prefix("name", "Omar"));
+    });
+    auto [textMs, textCount] = time([&grid](int) {
+        grid.setFilter("name", "omar");
+    });
+    EXPECT_EQ(prefixCount, textCount);
+    std::cout << "[bench]   name starts with Omar: expression " << prefixMs << " ms, text filter " << textMs
+              << " ms (" << textMs / prefixMs << "x)\n";
+
+    auto [rangeMs, rangeCount] = time([&grid](int) {
+        grid.setFilter("range", F::between("quantity", int64_t(12000), int64_t(12999)));
+    });
+    auto [numericTextMs, numericTextCount] = time([&grid](int) {
+        grid.setFilter("quantity", "12");
+    });
+    std::cout << "[bench]   quantity in [12000, 12999]: expression " << rangeMs << " ms (" << rangeCount
+              << " rows), text filter \"12\" " << numericTextMs << " ms (" << numericTextCount << " rows)\n";
+
+    auto composite = (F::greater("score", 500.0) && F::less("quantity", int64_t(50000))) ||
+                     F::in("city", {std::string("City 7"), std::string("City 42")});
+    auto [compositeMs, compositeCount] = time([&grid, &composite](int) {
+        grid.setFilter("composite", composite);
+    });
+    size_t expected = 0;
+    for (const auto& row : rows) {
+        const auto& city = std::get<std::string>(row.cells.at("city"));
+        if ((std::get<double>(row.cells.at("score")) > 500.0 &&
+             std::get<int64_t>(row.cells.at("quantity")) < 50000) ||
+            city == "City 7" || city == "City 42") {
+            expected++;
+        }
+    }
+    EXPECT_EQ(compositeCount, expected);
+    std::cout << "[bench]   (score > 500 AND quantity < 50000) OR city in {7, 42}: " << compositeMs << " ms, "
+              << compositeCount << " rows\n";
+}
+
+TEST(DataGridBenchmark, CsvLoading) {
+    constexpr size_t kRows = 2000000;
+
+    // A trade log: text, integers, decimals, dates and flags
+    auto path = std::filesystem::temp_directory_path() / "kgk_bench_trades.csv";
+    {
+        std::ofstream out(path, std::ios::binary);
+        std::mt19937 rng(7);
+        out << "id,symbol,quantity,price,date,note,settled\n";
+        for (size_t i = 0; i < kRows; ++i) {
+            out << "t" << i << ",SYM" << rng() % 500 << ',' << rng() % 10000 << ','
+                << (rng() % 1000000) / 100.0 << ",2024-" << 1 + rng() % 12 << "-1" << rng() % 10
+                << ",\"desk " << rng() % 40 << ", book " << rng() % 7 << "\"," << (rng() & 1 ? "true" : "false")
+                << '\n';
+        }
+    }
+    double megabytes = static_cast<double>(std::filesystem::file_size(path)) / (1024.0 * 1024.0);
+
+    // Streaming: the first batch is on screen while the rest is parsed
+    auto start = Clock::now();
+    DataGridCsvLoader loader;
+    CsvLoadOptions options;
+    options.idColumn = "id";
+    ASSERT_TRUE(loader.open(path.string(), options));
+    auto grid = DataGrid::create();
+    grid.columns(loader.getColumns());
+    grid.sortBy("price", SortDirection::Descending);
+    while (loader.appendTo(grid) == 0 && !loader.isFinished()) {
+        std::this_thread::yield();
+    }
+    (void)grid.getVisibleRows();
+    double firstScreenMs = millisecondsSince(start);
+    loader.finish(grid);
+    size_t shown = grid.getFilteredRowCount();
+    double streamMs = millisecondsSince(start);
+    EXPECT_EQ(shown, kRows);
+    EXPECT_EQ(grid.getColumns()[2].type, ColumnType::Number);
+
+    // The previous path: getline, split, a DataGridRow per record, rows()
+    start = Clock::now();
+    std::vector<DataGridRow> rows;
+    {
+        std::ifstream in(path);
+        std::string line;
+        std::getline(in, line);
+        while (std::getline(in, line)) {
+            std::vector<std::string> fields;
+            bool quoted = false;
+            std::string current;
+            for (char c : line) {
+                if (c == '"') quoted = !quoted;
+                else if (c == ',' && !quoted) fields.push_back(std::move(current)), current.clear();
+                else current.push_back(c);
+            }
+            fields.push_back(std::move(current));
+
+            DataGridRow row(fields[0]);
+            row.setCell("symbol", fields[1]);
+            row.setCell("quantity", static_cast<int64_t>(std::stoll(fields[2])));
+            row.setCell("price", std::stod(fields[3]));
+            row.setCell("date", fields[4]);
+            row.setCell("note", fields[5]);
+            row.setCell("settled", fields[6] == "true");
+            rows.push_back(std::move(row));
+        }
+    }
+    auto reference = DataGrid::create();
+    reference.rows(rows);
+    reference.sortBy("price", SortDirection::Descending);
+    EXPECT_EQ(reference.getFilteredRowCount(), kRows);
+    double referenceMs = millisecondsSince(start);
+
+    std::cout << "[bench] CSV " << kRows << " rows, " << megabytes << " MB\n"
+              << "[bench]   streaming: first screen " << firstScreenMs << " ms, all rows " << streamMs
+              << " ms (" << megabytes / (streamMs / 1000.0) << " MB/s)\n"
+              << "[bench]   getline + DataGridRow: " << referenceMs << " ms ("
+              << referenceMs / streamMs << "x)\n";
+
+    auto first = grid.getDisplayedRowRange(0, 1);
+    auto expected = reference.getDisplayedRowRange(0, 1);
+    ASSERT_EQ(first.size(), 1u);
+    EXPECT_EQ(first[0].id, expected[0].id);
+    std::filesystem::remove(path);
+}
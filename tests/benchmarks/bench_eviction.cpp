@@ -0,0 +1,194 @@
+/**
+ * @file bench_eviction.cpp
+ * @brief Stress benchmark for cache eviction with 100k resources
+ *
+ * Drives the EvictionIndex behind ResourceManager through loads, random
+ * accesses and repeated eviction rounds under memory pressure, and compares
+ * candidate selection against the previous approach of copying and sorting
+ * every resource's metadata per eviction.
+ *
+ * Results are printed to stdout; assertions only check that both approaches
+ * pick the same candidates and that the index stays consistent.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "KillerGK/resources/ResourceManager.hpp"
+
+using namespace KillerGK;
+
+namespace {
+
+constexpr size_t kResourceCount = 100000;
+constexpr size_t kAccessCount = 1000000;
+constexpr int kEvictionRounds = 200;
+constexpr size_t kBytesPerRound = 64 * 1024 * 100;    ///< About 100 resources
+constexpr int kSortRounds = 10;
+
+using Clock = std::chrono::steady_clock;
+
+double millisecondsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+std::string resourceKey(size_t i) {
+    return "textures/atlas_" + std::to_string(i) + ".png";
+}
+
+size_t resourceBytes(size_t i) {
+    return (32 + i % 64) * 1024;
+}
+
+const char* policyName(EvictionPolicy policy) {
+    switch (policy) {
+        case EvictionPolicy::LRU: return "LRU ";
+        case EvictionPolicy::LFU: return "LFU ";
+        case EvictionPolicy::FIFO: return "FIFO";
+    }
+    return "?";
+}
+
+/**
+ * @brief The original selection: copy all metadata, sort by policy, take a prefix
+ */
+std::vector<std::string> sortedCandidates(const EvictionIndex& index, EvictionPolicy policy,
+                                          size_t bytesToFree) {
+    std::vector<std::pair<std::string, EvictionIndex::Entry>> resources;
+    index.forEach([&](const std::string& key, const EvictionIndex::Entry& entry) {
+        resources.emplace_back(key, entry);
+    });
+
+    std::stable_sort(resources.begin(), resources.end(), [policy](const auto& a, const auto& b) {
+        switch (policy) {
+            case EvictionPolicy::LRU: return a.second.lastAccessTime < b.second.lastAccessTime;
+            case EvictionPolicy::LFU: return a.second.accessCount < b.second.accessCount;
+            case EvictionPolicy::FIFO: return a.second.loadTime < b.second.loadTime;
+        }
+        return false;
+    });
+
+    std::vector<std::string> candidates;
+    size_t total = 0;
+    for (const auto& [key, entry] : resources) {
+        if (total >= bytesToFree) {
+            break;
+        }
+        candidates.push_back(key);
+        total += entry.memoryUsage;
+    }
+    return candidates;
+}
+
+/**
+ * @brief The value a policy orders by
+ */
+int64_t orderKey(EvictionPolicy policy, const EvictionIndex::Entry& entry) {
+    switch (policy) {
+        case EvictionPolicy::LRU: return entry.lastAccessTime.time_since_epoch().count();
+        case EvictionPolicy::LFU: return static_cast<int64_t>(entry.accessCount);
+        case EvictionPolicy::FIFO: return entry.loadTime.time_since_epoch().count();
+    }
+    return 0;
+}
+
+void populate(EvictionIndex& index) {
+    for (size_t i = 0; i < kResourceCount; ++i) {
+        index.insert(resourceKey(i), ResourceType::Image, resourceBytes(i));
+    }
+}
+
+} // namespace
+
+TEST(EvictionBenchmark, LoadAndAccess100k) {
+    EvictionIndex index;
+
+    auto start = Clock::now();
+    populate(index);
+    double loadMs = millisecondsSince(start);
+
+    std::vector<std::string> keys;
+    keys.reserve(kResourceCount);
+    for (size_t i = 0; i < kResourceCount; ++i) {
+        keys.push_back(resourceKey(i));
+    }
+
+    // Skewed access pattern: a small hot set takes most of the hits
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<size_t> any(0, kResourceCount - 1);
+    std::uniform_int_distribution<size_t> hot(0, kResourceCount / 100 - 1);
+
+    start = Clock::now();
+    for (size_t i = 0; i < kAccessCount; ++i) {
+        index.touch(keys[(i & 3) ? hot(rng) : any(rng)]);
+    }
+    double accessMs = millisecondsSince(start);
+
+    std::cout << "[bench] " << kResourceCount << " resources tracked in " << loadMs << " ms\n";
+    std::cout << "[bench] " << kAccessCount << " accesses in " << accessMs << " ms ("
+              << accessMs * 1e6 / kAccessCount << " ns/access)\n";
+
+    EXPECT_EQ(index.size(), kResourceCount);
+}
+
+TEST(EvictionBenchmark, EvictionUnderMemoryPressure) {
+    std::cout << "[bench] " << kResourceCount << " resources, ~"
+              << kBytesPerRound / (1024 * 1024) << " MiB freed per eviction\n";
+
+    for (auto policy : {EvictionPolicy::LRU, EvictionPolicy::LFU, EvictionPolicy::FIFO}) {
+        EvictionIndex index;
+        populate(index);
+
+        std::mt19937 rng(7);
+        std::uniform_int_distribution<size_t> any(0, kResourceCount - 1);
+        for (size_t i = 0; i < kResourceCount; ++i) {
+            index.touch(resourceKey(any(rng)));
+        }
+
+        // Old approach, measured on a few rounds only since each one sorts everything
+        auto start = Clock::now();
+        std::vector<std::string> sorted;
+        for (int round = 0; round < kSortRounds; ++round) {
+            sorted = sortedCandidates(index, policy, kBytesPerRound);
+        }
+        double sortMs = millisecondsSince(start) / kSortRounds;
+
+        // Timestamps and counts may tie, and tied entries differ in size, so
+        // compare the sort keys over the common prefix rather than the names
+        auto candidates = index.collect(policy, kBytesPerRound);
+        ASSERT_FALSE(candidates.empty());
+        for (size_t i = 0; i < std::min(candidates.size(), sorted.size()); ++i) {
+            EXPECT_EQ(orderKey(policy, *index.find(candidates[i])),
+                      orderKey(policy, *index.find(sorted[i])));
+        }
+
+        // Steady state: evict a batch, then load replacements
+        size_t nextId = kResourceCount;
+        size_t evicted = 0;
+        start = Clock::now();
+        for (int round = 0; round < kEvictionRounds; ++round) {
+            for (const auto& key : index.collect(policy, kBytesPerRound)) {
+                index.erase(key);
+                evicted++;
+            }
+            while (index.size() < kResourceCount) {
+                index.insert(resourceKey(nextId), ResourceType::Image, resourceBytes(nextId));
+                nextId++;
+            }
+        }
+        double indexMs = millisecondsSince(start) / kEvictionRounds;
+
+        std::cout << "[bench]   " << policyName(policy) << "  copy+sort " << sortMs
+                  << " ms/eviction, index " << indexMs << " ms/eviction (incl. reload), "
+                  << sortMs / indexMs << "x\n";
+
+        EXPECT_EQ(index.size(), kResourceCount);
+        EXPECT_GT(evicted, 0u);
+    }
+}
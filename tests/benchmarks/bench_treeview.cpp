@@ -0,0 +1,367 @@
+/**
+ * @file bench_treeview.cpp
+ * @brief Benchmarks for TreeView on file-system sized trees
+ *
+ * Builds a tree of about 1M nodes laid out like a file system (100 folders
+ * of 100 subfolders of 100 files) and times id lookups, parent lookups,
+ * multi-selection and moves through the indexed TreeView, against the
+ * previous approach of searching the nested nodes recursively.
+ *
+ * The same tree, fully expanded, is used to time the displayed rows:
+ * expanding and collapsing folders updates them in place, against walking
+ * the expanded nodes again. A lazily loaded tree shows how few nodes are
+ * built when children are only loaded on expand.
+ *
+ * Type-ahead filtering is timed per keystroke, on the calling thread and
+ * on a worker, against rebuilding a filtered copy of the nodes.
+ *
+ * Results are printed to stdout; assertions only check that both approaches
+ * find the same nodes and that moves preserve the node count.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "KillerGK/widgets/TreeView.hpp"
+
+using namespace KillerGK;
+
+namespace {
+
+constexpr int kFolders = 100;
+constexpr int kSubfolders = 100;
+constexpr int kFiles = 100;
+constexpr size_t kLookups = 100000;
+constexpr size_t kReferenceLookups = 100;
+constexpr size_t kSelections = 10000;
+constexpr size_t kMoves = 10000;
+constexpr size_t kToggles = 1000;
+constexpr size_t kReferenceToggles = 10;
+constexpr size_t kScrolls = 10000;
+
+using Clock = std::chrono::steady_clock;
+
+double millisecondsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+std::string filePath(int folder, int subfolder, int file) {
+    return "/src" + std::to_string(folder) + "/mod" + std::to_string(subfolder) + "/file" +
+           std::to_string(file) + ".cpp";
+}
+
+std::vector<TreeNode> makeFileSystem() {
+    std::vector<TreeNode> roots;
+    roots.reserve(kFolders);
+    for (int f = 0; f < kFolders; ++f) {
+        TreeNode folder("/src" + std::to_string(f), "src" + std::to_string(f));
+        folder.children.reserve(kSubfolders);
+        for (int s = 0; s < kSubfolders; ++s) {
+            TreeNode subfolder(folder.id + "/mod" + std::to_string(s), "mod" + std::to_string(s));
+            subfolder.children.reserve(kFiles);
+            for (int i = 0; i < kFiles; ++i) {
+                subfolder.children.emplace_back(filePath(f, s, i), "file" + std::to_string(i) + ".cpp");
+            }
+            folder.children.push_back(std::move(subfolder));
+        }
+        roots.push_back(std::move(folder));
+    }
+    return roots;
+}
+
+/**
+ * @brief The previous approach: depth-first search of the nested nodes
+ */
+const TreeNode* referenceFind(const std::vector<TreeNode>& nodes, const std::string& id,
+                              const TreeNode** parent = nullptr, const TreeNode* owner = nullptr) {
+    for (const auto& node : nodes) {
+        if (node.id == id) {
+            if (parent) *parent = owner;
+            return &node;
+        }
+        if (const auto* found = referenceFind(node.children, id, parent, &node)) return found;
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Walking the expanded nodes, as a renderer without a row list would
+ */
+void referenceRows(const std::vector<TreeNode>& nodes, int depth, std::vector<TreeRow>& out) {
+    for (const auto& node : nodes) {
+        out.push_back({&node, depth});
+        if (node.expanded) referenceRows(node.children, depth + 1, out);
+    }
+}
+
+/**
+ * @brief The previous approach to filtering: copy the matches and their ancestors
+ */
+std::vector<TreeNode> referenceFilter(const std::vector<TreeNode>& nodes, const std::string& query) {
+    std::vector<TreeNode> result;
+    for (const auto& node : nodes) {
+        auto children = referenceFilter(node.children, query);
+        if (!children.empty() || node.text.find(query) != std::string::npos) {
+            TreeNode copy(node.id, node.text);
+            copy.expanded = true;
+            copy.children = std::move(children);
+            result.push_back(std::move(copy));
+        }
+    }
+    return result;
+}
+
+size_t countNodes(const std::vector<TreeNode>& nodes) {
+    size_t count = nodes.size();
+    for (const auto& node : nodes) {
+        count += countNodes(node.children);
+    }
+    return count;
+}
+
+} // namespace
+
+TEST(TreeViewBenchmark, FileSystemTree) {
+    auto roots = makeFileSystem();
+    size_t nodeCount = countNodes(roots);
+
+    auto tree = TreeView::create();
+    tree.multiSelect(true);
+    auto start = Clock::now();
+    tree.nodes(roots);
+    (void)tree.findNode("/src0");  // Builds the index
+    std::cout << "[bench] " << nodeCount << " nodes: load and index " << millisecondsSince(start) << " ms\n";
+
+    std::mt19937 rng(7);
+    auto randomFile = [&rng]() {
+        return filePath(static_cast<int>(rng() % kFolders), static_cast<int>(rng() % kSubfolders),
+                        static_cast<int>(rng() % kFiles));
+    };
+    std::vector<std::string> ids(kLookups);
+    for (auto& id : ids) {
+        id = randomFile();
+    }
+
+    // Lookups
+    const TreeView& view = tree;
+    start = Clock::now();
+    size_t found = 0;
+    for (const auto& id : ids) {
+        found += view.findNode(id) != nullptr;
+    }
+    double indexedMs = millisecondsSince(start);
+    EXPECT_EQ(found, kLookups);
+
+    start = Clock::now();
+    for (size_t i = 0; i < kReferenceLookups; ++i) {
+        EXPECT_EQ(referenceFind(view.getNodes(), ids[i]), view.findNode(ids[i]));
+    }
+    double referenceMs = millisecondsSince(start);
+    double indexedUs = indexedMs * 1000.0 / kLookups;
+    double referenceUs = referenceMs * 1000.0 / kReferenceLookups;
+    std::cout << "[bench]   findNode: indexed " << indexedUs << " us, recursive " << referenceUs << " us ("
+              << referenceUs / indexedUs << "x)\n";
+
+    start = Clock::now();
+    for (const auto& id : ids) {
+        (void)tree.getParent(id);
+    }
+    std::cout << "[bench]   getParent: " << millisecondsSince(start) * 1000.0 / kLookups << " us\n";
+    for (size_t i = 0; i < kReferenceLookups; ++i) {
+        const TreeNode* parent = nullptr;
+        referenceFind(view.getNodes(), ids[i], &parent);
+        EXPECT_EQ(tree.getParent(ids[i]), parent);
+    }
+
+    // Multi-selection
+    start = Clock::now();
+    for (size_t i = 0; i < kSelections; ++i) {
+        tree.select(ids[i], true);
+    }
+    auto selected = view.getSelectedNodes();
+    double selectMs = millisecondsSince(start);
+    EXPECT_EQ(selected.size(), view.getSelectedIds().size());
+    start = Clock::now();
+    tree.select(ids[0]);
+    std::cout << "[bench]   select " << kSelections << " nodes + getSelectedNodes: " << selectMs
+              << " ms; replace selection: " << millisecondsSince(start) << " ms\n";
+
+    // Moves between folders, as drag and drop does
+    start = Clock::now();
+    for (size_t i = 0; i < kMoves; ++i) {
+        auto target = "/src" + std::to_string(rng() % kFolders) + "/mod" + std::to_string(rng() % kSubfolders);
+        tree.moveNode(ids[i], target, 0);
+    }
+    double moveMs = millisecondsSince(start);
+    std::cout << "[bench]   moveNode: " << moveMs * 1000.0 / kMoves << " us\n";
+    EXPECT_EQ(countNodes(view.getNodes()), nodeCount);
+
+    // Moved nodes are found where they went
+    for (size_t i = 0; i < kReferenceLookups; ++i) {
+        EXPECT_EQ(referenceFind(view.getNodes(), ids[i]), view.findNode(ids[i]));
+    }
+
+    start = Clock::now();
+    for (int s = 0; s < kSubfolders; ++s) {
+        tree.removeNode("/src1/mod" + std::to_string(s));
+    }
+    std::cout << "[bench]   remove " << kSubfolders << " folders: " << millisecondsSince(start) << " ms\n";
+    EXPECT_EQ(view.findNode("/src1/mod0"), nullptr);
+}
+
+TEST(TreeViewBenchmark, DisplayedRows) {
+    auto tree = TreeView::create();
+    tree.nodes(makeFileSystem()).height(800.0f);
+    tree.expandAll();
+    const TreeView& view = tree;
+
+    auto start = Clock::now();
+    size_t rowCount = view.getRowCount();
+    std::cout << "[bench] " << rowCount << " rows: build " << millisecondsSince(start) << " ms\n";
+
+    std::mt19937 rng(11);
+    auto randomFolder = [&rng]() {
+        return "/src" + std::to_string(rng() % kFolders) + "/mod" + std::to_string(rng() % kSubfolders);
+    };
+
+    // Collapse and re-expand folders: rows change in place
+    start = Clock::now();
+    for (size_t i = 0; i < kToggles; ++i) {
+        auto id = randomFolder();
+        tree.collapse(id);
+        (void)view.getVisibleRows();
+        tree.expand(id);
+        (void)view.getVisibleRows();
+    }
+    double incrementalMs = millisecondsSince(start) / (2 * kToggles);
+    EXPECT_EQ(view.getRowCount(), rowCount);
+
+    start = Clock::now();
+    for (size_t i = 0; i < kReferenceToggles; ++i) {
+        std::vector<TreeRow> rows;
+        referenceRows(view.getNodes(), 0, rows);
+        EXPECT_EQ(rows.size(), rowCount);
+    }
+    double referenceMs = millisecondsSince(start) / kReferenceToggles;
+    std::cout << "[bench]   expand/collapse: incremental " << incrementalMs << " ms, walk "
+              << referenceMs << " ms (" << referenceMs / incrementalMs << "x)\n";
+
+    // Scrolling through the rows
+    start = Clock::now();
+    size_t shown = 0;
+    for (size_t i = 0; i < kScrolls; ++i) {
+        tree.scrollTo(static_cast<float>(rng() % rowCount) * view.getNodeHeight());
+        shown += view.getVisibleRows().size();
+    }
+    std::cout << "[bench]   getVisibleRows: " << millisecondsSince(start) * 1000.0 / kScrolls << " us for "
+              << shown / kScrolls << " rows\n";
+
+    // Moves keep the rows up to date too
+    start = Clock::now();
+    for (size_t i = 0; i < kToggles; ++i) {
+        tree.moveNode(filePath(static_cast<int>(rng() % kFolders), static_cast<int>(rng() % kSubfolders), 0),
+                      randomFolder(), 0);
+        (void)view.getVisibleRows();
+    }
+    std::cout << "[bench]   moveNode with rows: " << millisecondsSince(start) * 1000.0 / kToggles << " us\n";
+    std::vector<TreeRow> rows;
+    referenceRows(view.getNodes(), 0, rows);
+    ASSERT_EQ(rows.size(), view.getRowCount());
+    for (size_t i = 0; i < rows.size(); i += rows.size() / 100) {
+        EXPECT_EQ(view.getRow(i).node, rows[i].node);
+    }
+}
+
+TEST(TreeViewBenchmark, LazyChildren) {
+    size_t loaded = 0;
+    auto tree = TreeView::create();
+    tree.childLoader([&loaded](const TreeNode& node) {
+        std::vector<TreeNode> children;
+        children.reserve(kFiles);
+        for (int i = 0; i < kFiles; ++i) {
+            TreeNode child(node.id + "/" + std::to_string(i), std::to_string(i));
+            child.childrenPending = node.id.size() < 10;
+            children.push_back(std::move(child));
+        }
+        loaded += children.size();
+        return children;
+    });
+
+    std::vector<TreeNode> roots;
+    for (int f = 0; f < kFolders; ++f) {
+        TreeNode folder("/" + std::to_string(f), std::to_string(f));
+        folder.childrenPending = true;
+        roots.push_back(std::move(folder));
+    }
+    tree.nodes(roots);
+
+    // Open a few folders the way a user browses
+    std::mt19937 rng(3);
+    auto start = Clock::now();
+    for (int i = 0; i < 50; ++i) {
+        auto folder = "/" + std::to_string(rng() % kFolders);
+        auto subfolder = folder + "/" + std::to_string(rng() % kFiles);
+        tree.expand(folder);
+        tree.expand(subfolder);
+        tree.scrollToNode(subfolder + "/0");
+    }
+    std::cout << "[bench] lazy tree of " << kFolders * kFiles * kFiles << " nodes: loaded " << loaded
+              << " while browsing, " << millisecondsSince(start) << " ms; " << tree.getRowCount() << " rows\n";
+    EXPECT_LT(loaded, static_cast<size_t>(kFolders * kFiles * kFiles));
+}
+
+TEST(TreeViewBenchmark, TypeAheadFilter) {
+    auto roots = makeFileSystem();
+    auto tree = TreeView::create();
+    tree.nodes(roots);
+    const TreeView& view = tree;
+    const std::string typed = "file42.c";
+
+    auto start = Clock::now();
+    tree.backgroundFilterThreshold(0).filter(typed.substr(0, 1));
+    std::cout << "[bench] filter index of " << countNodes(roots) << " nodes + first keystroke: "
+              << millisecondsSince(start) << " ms\n";
+    tree.clearFilter();
+
+    // Each keystroke narrows the previous matches
+    start = Clock::now();
+    for (size_t length = 1; length <= typed.size(); ++length) {
+        tree.filter(typed.substr(0, length));
+        (void)view.getVisibleRows();
+    }
+    double incrementalMs = millisecondsSince(start) / typed.size();
+    size_t rowCount = view.getRowCount();
+    EXPECT_EQ(view.getFilterMatchCount(), static_cast<size_t>(kFolders * kSubfolders));
+
+    start = Clock::now();
+    size_t referenceCount = 0;
+    for (size_t length = 1; length <= typed.size(); ++length) {
+        auto filtered = referenceFilter(roots, typed.substr(0, length));
+        referenceCount = countNodes(filtered);
+    }
+    double referenceMs = millisecondsSince(start) / typed.size();
+    EXPECT_EQ(referenceCount, rowCount);
+    std::cout << "[bench]   per keystroke: narrowing " << incrementalMs << " ms, rebuilding nodes "
+              << referenceMs << " ms (" << referenceMs / incrementalMs << "x)\n";
+
+    // On a worker, keystrokes return at once; the rows catch up
+    tree.clearFilter();
+    tree.backgroundFilterThreshold(1);
+    double blockedMs = 0.0;
+    start = Clock::now();
+    for (size_t length = 1; length <= typed.size(); ++length) {
+        auto keystroke = Clock::now();
+        tree.filter(typed.substr(0, length));
+        (void)view.getVisibleRows();
+        blockedMs += millisecondsSince(keystroke);
+    }
+    tree.waitForFilter();
+    std::cout << "[bench]   worker: " << blockedMs / typed.size() << " ms per keystroke on the caller, "
+              << millisecondsSince(start) << " ms until all rows are shown\n";
+    EXPECT_EQ(view.getRowCount(), rowCount);
+}
@@ -0,0 +1,521 @@
+/**
+ * @file bench_widget.cpp
+ * @brief Benchmarks for Widget custom property access
+ *
+ * Gives 10K widgets 20 custom properties each (floats, ints, bools and
+ * strings) and times setting them, overwriting them and reading them,
+ * by name and by interned PropertyKey, against the previous storage: a
+ * std::map<std::string, std::any> per widget. Heap allocations made while
+ * setting the properties are counted as well.
+ *
+ * A dashboard of 10K tiles in 50 panels is indexed in a WidgetHitIndex,
+ * and hit tests and hover updates along a cursor path are timed against
+ * walking every widget and testing its bounds, along with re-indexing
+ * after a layout pass that moved one panel.
+ *
+ * The same dashboard is redrawn through a DamageTracker: idle frames,
+ * frames where a few tiles change, hover along the cursor path and the
+ * layout pass are timed, with the share of the window each one damages,
+ * against visiting every widget as a full redraw does each frame.
+ *
+ * A 50K-widget tree is built, walked and destroyed with its data on the
+ * heap and in a WidgetArena (fresh, reused after reset(), and with a heap
+ * fragmented by earlier allocations), counting allocations while building.
+ *
+ * Results are printed to stdout; assertions only check that both storages
+ * read back the same values, that both hit tests find the same widgets and
+ * that changed frames have damage and idle frames none, and that trees in
+ * an arena read back as trees on the heap do.
+ */
+
+#include <gtest/gtest.h>
+#include <any>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "KillerGK/widgets/Widget.hpp"
+#include "KillerGK/widgets/WidgetArena.hpp"
+#include "KillerGK/widgets/WidgetDamage.hpp"
+#include "KillerGK/widgets/WidgetHitIndex.hpp"
+
+using namespace KillerGK;
+
+namespace {
+
+std::atomic<size_t> g_allocations{0};
+
+} // namespace
+
+// Counts every allocation. Kept out of line, so GCC does not see malloc()
+// and free() paired with operator new and delete and flag them as mismatched
+[[gnu::noinline]] void* operator new(size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size ? size : 1)) return memory;
+    throw std::bad_alloc();
+}
+
+[[gnu::noinline]] void operator delete(void* memory) noexcept { std::free(memory); }
+[[gnu::noinline]] void operator delete(void* memory, size_t) noexcept { std::free(memory); }
+
+namespace {
+
+constexpr size_t kWidgets = 10000;
+constexpr int kProperties = 20;
+constexpr int kRepeats = 10;
+constexpr int kPanelColumns = 10;
+constexpr int kPanelRows = 5;
+constexpr int kTileColumns = 20;
+constexpr int kTileRows = 10;
+constexpr size_t kQueries = 100000;
+constexpr size_t kReferenceQueries = 1000;
+
+using Clock = std::chrono::steady_clock;
+
+double millisecondsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+/**
+ * @brief The previous storage, with the same lookups as Widget had
+ */
+struct ReferenceProperties {
+    std::map<std::string, std::any> properties;
+
+    float getFloat(const std::string& name, float defaultValue) const {
+        auto it = properties.find(name);
+        if (it != properties.end()) {
+            try {
+                return std::any_cast<float>(it->second);
+            } catch (const std::bad_any_cast&) {
+                return defaultValue;
+            }
+        }
+        return defaultValue;
+    }
+};
+
+// Half the properties are floats, a quarter ints, and the rest bools and strings
+enum class Kind { Float, Int, Bool, String };
+
+Kind kindOf(int property) {
+    switch (property % 4) {
+        case 0:
+        case 1: return Kind::Float;
+        case 2: return Kind::Int;
+        default: return property % 8 == 3 ? Kind::Bool : Kind::String;
+    }
+}
+
+std::string labelOf(int property) {
+    return "label" + std::to_string(property);
+}
+
+Rect panelBounds(int panel, float shift) {
+    return Rect(static_cast<float>(panel % kPanelColumns) * 192.0f + shift,
+                static_cast<float>(panel / kPanelColumns) * 216.0f, 192.0f, 216.0f);
+}
+
+Rect tileBounds(const Rect& panel, int tile) {
+    return Rect(panel.x + 2.0f + static_cast<float>(tile % kTileColumns) * 9.4f,
+                panel.y + 8.0f + static_cast<float>(tile / kTileColumns) * 20.5f, 9.0f, 20.0f);
+}
+
+/**
+ * @brief A window of panels of 192 x 216 pixels over 1920 x 1080, each with a
+ * grid of 9 x 20 pixel tiles; widgets are kept in paint order
+ */
+void buildDashboard(std::vector<Widget>& widgets, std::vector<Rect>& bounds) {
+    const int panels = kPanelColumns * kPanelRows;
+    const int tilesPerPanel = kTileColumns * kTileRows;
+    widgets.reserve(static_cast<size_t>(1 + panels * (1 + tilesPerPanel)));
+    widgets.push_back(Widget::create());
+    bounds.emplace_back(0.0f, 0.0f, 1920.0f, 1080.0f);
+    for (int p = 0; p < panels; ++p) {
+        widgets.push_back(Widget::create());
+        bounds.push_back(panelBounds(p, 0.0f));
+        Widget* panel = &widgets.back();
+        widgets[0].addChild(panel);
+        for (int t = 0; t < tilesPerPanel; ++t) {
+            widgets.push_back(Widget::create());
+            bounds.push_back(tileBounds(bounds[bounds.size() - 1 - static_cast<size_t>(t)], t));
+            panel->addChild(&widgets.back());
+        }
+    }
+}
+
+} // namespace
+
+TEST(WidgetBenchmark, CustomProperties) {
+    std::vector<std::string> names;
+    std::vector<PropertyKey> keys;
+    for (int p = 0; p < kProperties; ++p) {
+        names.push_back("property" + std::to_string(p));
+        keys.push_back(PropertyKey::intern(names.back()));
+    }
+
+    std::vector<ReferenceProperties> reference(kWidgets);
+    std::vector<Widget> widgets;
+    widgets.reserve(kWidgets);
+    for (size_t w = 0; w < kWidgets; ++w) {
+        widgets.push_back(Widget::create());
+    }
+
+    // Setting every property the first time
+    auto setAll = [&](auto&& set) {
+        auto start = Clock::now();
+        size_t before = g_allocations.load();
+        for (size_t w = 0; w < kWidgets; ++w) {
+            for (int p = 0; p < kProperties; ++p) set(w, p);
+        }
+        return std::pair(millisecondsSince(start), g_allocations.load() - before);
+    };
+    auto setReference = [&](size_t w, int p) {
+        auto& properties = reference[w].properties;
+        switch (kindOf(p)) {
+            case Kind::Float: properties[names[p]] = static_cast<float>(w + p); break;
+            case Kind::Int: properties[names[p]] = static_cast<int>(w * p); break;
+            case Kind::Bool: properties[names[p]] = (w + p) % 2 == 0; break;
+            case Kind::String: properties[names[p]] = labelOf(p); break;
+        }
+    };
+    auto setByName = [&](size_t w, int p) {
+        switch (kindOf(p)) {
+            case Kind::Float: widgets[w].setPropertyFloat(names[p], static_cast<float>(w + p)); break;
+            case Kind::Int: widgets[w].setPropertyInt(names[p], static_cast<int>(w * p)); break;
+            case Kind::Bool: widgets[w].setPropertyBool(names[p], (w + p) % 2 == 0); break;
+            case Kind::String: widgets[w].setPropertyString(names[p], labelOf(p)); break;
+        }
+    };
+    auto setByKey = [&](size_t w, int p) {
+        switch (kindOf(p)) {
+            case Kind::Float: widgets[w].setPropertyFloat(keys[p], static_cast<float>(w + p)); break;
+            case Kind::Int: widgets[w].setPropertyInt(keys[p], static_cast<int>(w * p)); break;
+            case Kind::Bool: widgets[w].setPropertyBool(keys[p], (w + p) % 2 == 0); break;
+            case Kind::String: widgets[w].setPropertyString(keys[p], labelOf(p)); break;
+        }
+    };
+
+    auto [referenceSetMs, referenceAllocations] = setAll(setReference);
+    auto [setMs, allocations] = setAll(setByName);
+    std::cout << "[bench] " << kWidgets << " widgets x " << kProperties << " properties\n";
+    std::cout << "[bench]   first set: map<string, any> " << referenceSetMs << " ms, "
+              << static_cast<double>(referenceAllocations) / kWidgets << " allocations per widget; property store "
+              << setMs << " ms, " << static_cast<double>(allocations) / kWidgets << " allocations per widget\n";
+
+    // Overwriting, as an animation does every frame
+    double referenceOverwriteMs = 0.0;
+    double overwriteMs = 0.0;
+    double overwriteKeyMs = 0.0;
+    for (int r = 0; r < kRepeats; ++r) {
+        referenceOverwriteMs += setAll(setReference).first;
+        overwriteMs += setAll(setByName).first;
+        overwriteKeyMs += setAll(setByKey).first;
+    }
+    double accesses = static_cast<double>(kWidgets) * kProperties * kRepeats;
+    std::cout << "[bench]   overwrite: map<string, any> " << referenceOverwriteMs * 1e6 / accesses
+              << " ns, by name " << overwriteMs * 1e6 / accesses << " ns, by key "
+              << overwriteKeyMs * 1e6 / accesses << " ns per property\n";
+
+    // Reading the float properties back
+    std::vector<int> floats;
+    for (int p = 0; p < kProperties; ++p) {
+        if (kindOf(p) == Kind::Float) floats.push_back(p);
+    }
+    auto getAll = [&](auto&& get) {
+        double sum = 0.0;
+        auto start = Clock::now();
+        for (int r = 0; r < kRepeats; ++r) {
+            for (size_t w = 0; w < kWidgets; ++w) {
+                for (int p : floats) sum += get(w, p);
+            }
+        }
+        return std::pair(millisecondsSince(start), sum);
+    };
+    auto [referenceGetMs, referenceSum] = getAll([&](size_t w, int p) {
+        return reference[w].getFloat(names[p], 0.0f);
+    });
+    auto [getMs, nameSum] = getAll([&](size_t w, int p) { return widgets[w].getPropertyFloat(names[p]); });
+    auto [getKeyMs, keySum] = getAll([&](size_t w, int p) { return widgets[w].getPropertyFloat(keys[p]); });
+    double reads = static_cast<double>(kWidgets) * static_cast<double>(floats.size()) * kRepeats;
+    std::cout << "[bench]   get float: map<string, any> " << referenceGetMs * 1e6 / reads << " ns, by name "
+              << getMs * 1e6 / reads << " ns, by key " << getKeyMs * 1e6 / reads << " ns per property\n";
+
+    EXPECT_EQ(nameSum, referenceSum);
+    EXPECT_EQ(keySum, referenceSum);
+    for (size_t w = 0; w < kWidgets; w += 997) {
+        for (int p = 0; p < kProperties; ++p) {
+            const std::any& value = reference[w].properties.at(names[p]);
+            switch (kindOf(p)) {
+                case Kind::Float: EXPECT_EQ(widgets[w].getPropertyFloat(keys[p]), std::any_cast<float>(value)); break;
+                case Kind::Int: EXPECT_EQ(widgets[w].getPropertyInt(keys[p]), std::any_cast<int>(value)); break;
+                case Kind::Bool: EXPECT_EQ(widgets[w].getPropertyBool(keys[p]), std::any_cast<bool>(value)); break;
+                case Kind::String:
+                    EXPECT_EQ(widgets[w].getPropertyString(keys[p]), std::any_cast<std::string>(value));
+                    break;
+            }
+        }
+    }
+}
+
+TEST(WidgetBenchmark, HitTest) {
+    std::vector<Widget> widgets;
+    std::vector<Rect> bounds;
+    buildDashboard(widgets, bounds);
+    const int panels = kPanelColumns * kPanelRows;
+    const int tilesPerPanel = kTileColumns * kTileRows;
+
+    WidgetHitIndex index;
+    auto start = Clock::now();
+    for (size_t i = 0; i < widgets.size(); ++i) index.update(&widgets[i], bounds[i]);
+    double buildMs = millisecondsSince(start);
+
+    // The previous approach: test every widget, keeping the last (topmost) hit
+    auto referenceHitTest = [&](float x, float y) {
+        Widget* hit = nullptr;
+        for (size_t i = 0; i < widgets.size(); ++i) {
+            if (bounds[i].contains(x, y) && widgets[i].isVisible()) hit = &widgets[i];
+        }
+        return hit;
+    };
+
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> windowX(0.0f, 1920.0f);
+    std::uniform_real_distribution<float> windowY(0.0f, 1080.0f);
+    std::vector<std::pair<float, float>> points(kQueries);
+    for (auto& point : points) point = {windowX(rng), windowY(rng)};
+
+    start = Clock::now();
+    size_t hits = 0;
+    for (const auto& [x, y] : points) hits += index.hitTest(x, y) != nullptr;
+    double indexUs = millisecondsSince(start) * 1000.0 / kQueries;
+
+    start = Clock::now();
+    for (size_t q = 0; q < kReferenceQueries; ++q) {
+        auto [x, y] = points[q];
+        EXPECT_EQ(referenceHitTest(x, y), index.hitTest(x, y));
+    }
+    double referenceUs = millisecondsSince(start) * 1000.0 / kReferenceQueries;
+
+    // A cursor sweeping across the window in small steps
+    start = Clock::now();
+    size_t changes = 0;
+    for (size_t q = 0; q < kQueries; ++q) {
+        float x = static_cast<float>(q % 1920);
+        float y = static_cast<float>((q / 1920) * 20 % 1080) + 10.0f;
+        changes += !index.updateHover(x, y).empty();
+    }
+    double hoverUs = millisecondsSince(start) * 1000.0 / kQueries;
+
+    std::cout << "[bench] " << widgets.size() << " widgets (" << hits << " of " << kQueries << " points hit)\n";
+    std::cout << "[bench]   index built in " << buildMs << " ms\n";
+    std::cout << "[bench]   hitTest: index " << indexUs << " us, walking every widget " << referenceUs << " us ("
+              << referenceUs / indexUs << "x)\n";
+    std::cout << "[bench]   updateHover along a cursor path: " << hoverUs << " us per move (" << changes
+              << " moves changed the hovered set)\n";
+
+    // A layout pass moved one panel and its tiles by 40 pixels
+    std::vector<Rect> relaid = bounds;
+    size_t first = 1 + static_cast<size_t>(panels / 2) * (1 + static_cast<size_t>(tilesPerPanel));
+    relaid[first] = panelBounds(panels / 2, 40.0f);
+    for (int t = 0; t < tilesPerPanel; ++t) relaid[first + 1 + static_cast<size_t>(t)] = tileBounds(relaid[first], t);
+    start = Clock::now();
+    for (size_t i = 0; i < widgets.size(); ++i) index.update(&widgets[i], relaid[i]);
+    double relayoutMs = millisecondsSince(start);
+    bounds = relaid;
+    std::cout << "[bench]   re-indexing after a layout pass moving " << 1 + tilesPerPanel << " widgets: "
+              << relayoutMs << " ms, against building the index in " << buildMs << " ms\n";
+    for (size_t q = 0; q < kReferenceQueries; ++q) {
+        auto [x, y] = points[q];
+        EXPECT_EQ(referenceHitTest(x, y), index.hitTest(x, y));
+    }
+}
+
+TEST(WidgetBenchmark, Redraw) {
+    std::vector<Widget> widgets;
+    std::vector<Rect> bounds;
+    buildDashboard(widgets, bounds);
+    const int tilesPerPanel = kTileColumns * kTileRows;
+    Widget& root = widgets[0];
+
+    WidgetHitIndex index;
+    for (size_t i = 0; i < widgets.size(); ++i) index.update(&widgets[i], bounds[i]);
+    DamageTracker damage;
+    damage.collect(root, index);
+    damage.clear();
+    const double windowArea = 1920.0 * 1080.0;
+    auto damagedArea = [&]() {
+        double total = 0.0;
+        for (const Rect& region : damage.getRegions()) total += static_cast<double>(region.width) * region.height;
+        return total;
+    };
+
+    // The previous approach: every frame draws every widget; visiting them
+    // is the least that costs
+    auto start = Clock::now();
+    size_t visible = 0;
+    for (size_t f = 0; f < 100; ++f) {
+        for (const Widget& widget : widgets) visible += widget.isVisible();
+    }
+    double walkUs = millisecondsSince(start) * 1000.0 / 100.0;
+
+    // Idle frames
+    start = Clock::now();
+    size_t damagedFrames = 0;
+    for (size_t f = 0; f < kQueries; ++f) {
+        if (root.isDirty() && damage.collect(root, index)) ++damagedFrames;
+    }
+    double idleNs = millisecondsSince(start) * 1e6 / kQueries;
+    EXPECT_EQ(damagedFrames, 0u);
+
+    // Frames where 10 tiles across the window show new values
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<size_t> anyPanel(0, static_cast<size_t>(kPanelColumns * kPanelRows) - 1);
+    std::uniform_int_distribution<size_t> anyTile(0, static_cast<size_t>(tilesPerPanel) - 1);
+    const int liveFrames = 10000;
+    double liveArea = 0.0;
+    start = Clock::now();
+    for (int f = 0; f < liveFrames; ++f) {
+        for (int t = 0; t < 10; ++t) {
+            size_t w = 2 + anyPanel(rng) * (1 + static_cast<size_t>(tilesPerPanel)) + anyTile(rng);
+            widgets[w].backgroundColor(Color(static_cast<float>(f % 256) / 255.0f, 0.5f, 0.5f));
+        }
+        EXPECT_TRUE(damage.collect(root, index));
+        liveArea += damagedArea();
+        damage.clear();
+    }
+    double liveUs = millisecondsSince(start) * 1000.0 / liveFrames;
+
+    // Frames where the cursor moves over the tiles: hover updates repaint them
+    start = Clock::now();
+    double hoverArea = 0.0;
+    for (size_t q = 0; q < kQueries; ++q) {
+        float x = static_cast<float>(q % 1920);
+        float y = static_cast<float>((q / 1920) * 20 % 1080) + 10.0f;
+        index.updateHover(x, y);
+        damage.collect(root, index);
+        hoverArea += damagedArea();
+        damage.clear();
+    }
+    double hoverUs = millisecondsSince(start) * 1000.0 / kQueries;
+
+    // A layout pass moved one panel and its tiles by 40 pixels
+    const int panels = kPanelColumns * kPanelRows;
+    size_t first = 1 + static_cast<size_t>(panels / 2) * (1 + static_cast<size_t>(tilesPerPanel));
+    widgets[first].width(232.0f);
+    index.update(&widgets[first], panelBounds(panels / 2, 40.0f));
+    for (int t = 0; t < tilesPerPanel; ++t) {
+        index.update(&widgets[first + 1 + static_cast<size_t>(t)], tileBounds(index.getBounds(&widgets[first]), t));
+    }
+    start = Clock::now();
+    EXPECT_TRUE(damage.collect(root, index));
+    double layoutUs = millisecondsSince(start) * 1000.0;
+    double layoutArea = damagedArea();
+    EXPECT_FALSE(root.isDirty());
+
+    std::cout << "[bench] " << widgets.size() << " widgets (" << visible / 100 << " visible)\n";
+    std::cout << "[bench]   idle frame: " << idleNs << " ns, against visiting every widget in " << walkUs << " us\n";
+    std::cout << "[bench]   10 tiles changed: " << liveUs << " us per frame, "
+              << 100.0 * liveArea / liveFrames / windowArea << "% of the window damaged\n";
+    std::cout << "[bench]   hover along a cursor path: " << hoverUs << " us per move, "
+              << 100.0 * hoverArea / kQueries / windowArea << "% of the window damaged\n";
+    std::cout << "[bench]   layout pass moving " << 1 + tilesPerPanel << " widgets: " << layoutUs << " us, "
+              << 100.0 * layoutArea / windowArea << "% of the window damaged\n";
+}
+
+TEST(WidgetBenchmark, Arena) {
+    // 500 panels of 99 tiles under a root: 50K widgets
+    const size_t panels = 500;
+    const size_t tilesPerPanel = 99;
+    const size_t total = 1 + panels * (1 + tilesPerPanel);
+    auto build = [&](std::vector<Widget>& widgets) {
+        widgets.reserve(total);
+        widgets.push_back(Widget::create().width(1920.0f).height(1080.0f));
+        for (size_t p = 0; p < panels; ++p) {
+            widgets.push_back(Widget::create().width(192.0f).height(216.0f).padding(4.0f));
+            Widget* panel = &widgets.back();
+            widgets[0].addChild(panel);
+            for (size_t t = 0; t < tilesPerPanel; ++t) {
+                widgets.push_back(Widget::create()
+                                      .width(9.0f)
+                                      .height(20.0f)
+                                      .backgroundColor(Color(static_cast<float>(t) / 99.0f, 0.5f, 0.5f))
+                                      .borderRadius(2.0f));
+                panel->addChild(&widgets.back());
+            }
+        }
+    };
+    // What a layout or paint pass reads, following the hierarchy
+    auto walk = [](const auto& self, const Widget& widget) -> float {
+        float sum = widget.getWidth() + widget.getBackgroundColor().r;
+        for (const Widget* child : widget.getChildren()) sum += self(self, *child);
+        return sum;
+    };
+    struct Timing {
+        double buildMs = 0.0;
+        double walkMs = 0.0;
+        double destroyMs = 0.0;
+        size_t allocations = 0;
+        float checksum = 0.0f;
+    };
+    auto measure = [&](WidgetArena* arena) {
+        Timing timing;
+        std::vector<Widget> widgets;
+        size_t allocations = g_allocations.load();
+        auto start = Clock::now();
+        if (arena) {
+            WidgetArena::Scope scope(*arena);
+            build(widgets);
+        } else {
+            build(widgets);
+        }
+        timing.buildMs = millisecondsSince(start);
+        timing.allocations = g_allocations.load() - allocations;
+        start = Clock::now();
+        for (int r = 0; r < kRepeats; ++r) timing.checksum += walk(walk, widgets[0]);
+        timing.walkMs = millisecondsSince(start) / kRepeats;
+        start = Clock::now();
+        widgets = std::vector<Widget>();
+        timing.destroyMs = millisecondsSince(start);
+        return timing;
+    };
+    auto report = [](const char* label, const Timing& timing) {
+        std::cout << "[bench]   " << label << ": build " << timing.buildMs << " ms (" << timing.allocations
+                  << " allocations), walk " << timing.walkMs << " ms, destroy " << timing.destroyMs << " ms\n";
+    };
+
+    Timing heap = measure(nullptr);
+    WidgetArena arena;
+    Timing first = measure(&arena);
+    size_t reserved = arena.getReservedBytes();
+    EXPECT_TRUE(arena.reset());
+    Timing reused = measure(&arena);
+    EXPECT_EQ(arena.getReservedBytes(), reserved);
+
+    // A heap after a long session: blocks of mixed sizes freed in between
+    std::vector<void*> churn;
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<size_t> churnSize(16, 1024);
+    for (size_t i = 0; i < total * 4; ++i) churn.push_back(::operator new(churnSize(rng)));
+    for (size_t i = 0; i < churn.size(); i += 2) ::operator delete(churn[i]);
+    Timing fragmentedHeap = measure(nullptr);
+    EXPECT_TRUE(arena.reset());
+    Timing fragmentedArena = measure(&arena);
+    for (size_t i = 1; i < churn.size(); i += 2) ::operator delete(churn[i]);
+
+    std::cout << "[bench] " << total << " widgets in a tree\n";
+    report("heap", heap);
+    report("arena", first);
+    report("arena reused after reset()", reused);
+    report("fragmented heap", fragmentedHeap);
+    report("arena, heap fragmented", fragmentedArena);
+    std::cout << "[bench]   arena holds " << reserved / 1024 << " KiB for " << total << " widgets\n";
+    EXPECT_EQ(heap.checksum, first.checksum);
+    EXPECT_EQ(heap.checksum, fragmentedArena.checksum);
+}
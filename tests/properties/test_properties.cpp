@@ -12,6 +12,7 @@
 #include <algorithm>
 #include <cctype>
 #include <cmath>
+#include <map>
 #include <set>
 
 #include "KillerGK/core/Types.hpp"
@@ -5962,416 +5963,1391 @@ RC_GTEST_PROP(DataGridFilteringProperties, FilterIsCaseInsensitive, ()) {
 
 
 // ============================================================================
-// Property Tests for TreeView Hierarchy Preservation
+// Property Tests for DataGrid Row Storage
 // ============================================================================
 
-#include "KillerGK/widgets/TreeView.hpp"
-
 namespace rc {
 
 /**
- * @brief Generator for valid TreeNode ID strings
+ * @brief Generator for a row with a random subset of mixed-type cells
  */
-inline Gen<std::string> genTreeNodeId() {
-    return gen::map(gen::inRange(1, 100), [](int n) {
-        return "node_" + std::to_string(n);
-    });
+inline Gen<KillerGK::DataGridRow> genMixedDataGridRow(int index) {
+    return gen::map(
+        gen::tuple(genStringCellValue(), genDoubleCellValue(), genInt64CellValue(),
+                   gen::arbitrary<bool>(), gen::inRange(0, 16)),
+        [index](const std::tuple<std::string, double, int64_t, bool, int>& t) {
+            KillerGK::DataGridRow row("row_" + std::to_string(index));
+            int mask = std::get<4>(t);
+            if (mask & 1) row.setCell("name", std::get<0>(t));
+            if (mask & 2) row.setCell("score", std::get<1>(t));
+            if (mask & 4) row.setCell("quantity", std::get<2>(t));
+            if (mask & 8) row.setCell("active", std::get<3>(t));
+            row.enabled = std::get<3>(t);
+            return row;
+        }
+    );
 }
 
+} // namespace rc
+
 /**
- * @brief Generator for valid TreeNode text strings
+ * **Feature: killergk-gui-library, Property 9: DataGrid Sorting Correctness**
+ * 
+ * *For any* set of rows, the row API SHALL present exactly the rows that
+ * were stored (ids, cells, flags) even though cells are held by column, and
+ * edits made through getRow() or setCell() SHALL be visible to later queries.
+ * 
+ * **Validates: Requirements 2.4**
  */
-inline Gen<std::string> genTreeNodeText() {
-    return gen::element(
-        std::string("Root"),
-        std::string("Parent"),
-        std::string("Child"),
-        std::string("Leaf"),
-        std::string("Branch"),
-        std::string("Folder"),
-        std::string("File"),
-        std::string("Item")
-    );
+RC_GTEST_PROP(DataGridSortingProperties, RowViewRoundTripsColumnarStorage, ()) {
+    auto numRows = *gen::inRange(1, 40);
+    std::vector<KillerGK::DataGridRow> rows;
+    for (int i = 0; i < numRows; ++i) {
+        rows.push_back(*genMixedDataGridRow(i));
+    }
+    
+    auto grid = KillerGK::DataGrid::create();
+    grid.rows(rows);
+    
+    const auto& stored = grid.getRows();
+    RC_ASSERT(stored.size() == rows.size());
+    for (size_t i = 0; i < rows.size(); ++i) {
+        RC_ASSERT(stored[i].id == rows[i].id);
+        RC_ASSERT(stored[i].enabled == rows[i].enabled);
+        RC_ASSERT(stored[i].cells == rows[i].cells);
+    }
+    
+    // Edit one row through the view and another cell directly
+    auto target = *gen::inRange(0, numRows);
+    std::string targetId = "row_" + std::to_string(target);
+    auto* view = grid.getRow(targetId);
+    RC_ASSERT(view != nullptr);
+    view->setCell("name", std::string("edited"));
+    view->cells.erase("score");
+    grid.setCell(targetId, "quantity", int64_t{42});
+    
+    RC_ASSERT(grid.getCell(targetId, "name") == KillerGK::CellValue{std::string("edited")});
+    RC_ASSERT(grid.getCell(targetId, "quantity") == KillerGK::CellValue{int64_t{42}});
+    
+    grid.setFilter("name", "edited");
+    auto displayed = grid.getDisplayedRows();
+    bool found = false;
+    for (const auto& row : displayed) {
+        if (row.id == targetId) {
+            found = true;
+            RC_ASSERT(row.cells.count("score") == 0);
+        }
+    }
+    RC_ASSERT(found);
 }
 
 /**
- * @brief Generator for a single TreeNode without children
+ * **Feature: killergk-gui-library, Property 9: DataGrid Sorting Correctness**
+ * 
+ * *For any* column holding a mix of value types and missing cells, sorting
+ * SHALL order missing cells first (ascending) and group values by type,
+ * ordering values of the same type correctly, and descending SHALL be the
+ * exact reverse grouping.
+ * 
+ * **Validates: Requirements 2.4**
  */
-inline Gen<KillerGK::TreeNode> genLeafTreeNode() {
-    return gen::map(
-        gen::tuple(genTreeNodeId(), genTreeNodeText()),
-        [](const std::tuple<std::string, std::string>& t) {
-            return KillerGK::TreeNode(std::get<0>(t), std::get<1>(t));
+RC_GTEST_PROP(DataGridSortingProperties, MixedTypeColumnSortsConsistently, ()) {
+    auto numRows = *gen::inRange(2, 60);
+    std::vector<KillerGK::DataGridRow> rows;
+    for (int i = 0; i < numRows; ++i) {
+        auto row = *genMixedDataGridRow(i);
+        // Move one of the generated values into a shared column
+        auto pick = *gen::inRange(0, 4);
+        const char* source[] = {"name", "score", "quantity", "active"};
+        if (row.cells.count(source[pick])) {
+            row.setCell("mixed", row.getCell(source[pick]));
         }
-    );
+        rows.push_back(row);
+    }
+    
+    auto grid = KillerGK::DataGrid::create();
+    grid.rows(rows);
+    
+    auto direction = *genSortDirection();
+    grid.sortBy("mixed", direction);
+    auto displayed = grid.getDisplayedRows();
+    RC_ASSERT(displayed.size() == rows.size());
+    
+    // Rank: missing, string, double, bool, int64 (reversed for descending)
+    auto typeRank = [](const KillerGK::DataGridRow& row) -> int {
+        auto it = row.cells.find("mixed");
+        return it == row.cells.end() ? 0 : static_cast<int>(it->second.index()) + 1;
+    };
+    
+    for (size_t i = 1; i < displayed.size(); ++i) {
+        int prev = typeRank(displayed[i - 1]);
+        int curr = typeRank(displayed[i]);
+        if (direction == KillerGK::SortDirection::Ascending) {
+            RC_ASSERT(prev <= curr);
+        } else {
+            RC_ASSERT(prev >= curr);
+        }
+        if (prev == curr && prev != 0) {
+            const auto& a = displayed[i - 1].cells.at("mixed");
+            const auto& b = displayed[i].cells.at("mixed");
+            if (direction == KillerGK::SortDirection::Ascending) {
+                RC_ASSERT(!(b < a));
+            } else {
+                RC_ASSERT(!(a < b));
+            }
+        }
+    }
 }
 
 /**
- * @brief Generator for a TreeNode with a specified number of children
+ * **Feature: killergk-gui-library, Property 9: DataGrid Sorting Correctness**
+ * 
+ * *For any* sequence of filter edits (typing and deleting), row additions,
+ * removals, cell edits and sort changes, the displayed rows SHALL be exactly
+ * those of a grid built from scratch with the same rows, filters and sort.
+ * 
+ * **Validates: Requirements 2.4**
  */
-inline Gen<KillerGK::TreeNode> genTreeNodeWithChildren(int numChildren) {
-    return gen::exec([numChildren]() {
-        auto id = *genTreeNodeId();
-        auto text = *genTreeNodeText();
-        KillerGK::TreeNode node(id, text);
+RC_GTEST_PROP(DataGridSortingProperties, IncrementalUpdatesMatchFullRebuild, ()) {
+    auto numRows = *gen::inRange(0, 30);
+    std::vector<KillerGK::DataGridRow> rows;
+    for (int i = 0; i < numRows; ++i) {
+        rows.push_back(*genMixedDataGridRow(i));
+    }
+    
+    auto grid = KillerGK::DataGrid::create();
+    grid.rows(rows);
+    grid.sortBy("name", KillerGK::SortDirection::Ascending);
+    
+    std::string search;
+    int nextRow = numRows;
+    const char* sortColumns[] = {"name", "score", "quantity", "active"};
+    
+    auto numSteps = *gen::inRange(1, 25);
+    for (int step = 0; step < numSteps; ++step) {
+        switch (*gen::inRange(0, 7)) {
+            case 0:  // Type a character
+                search.push_back(*gen::element('a', 'e', 'i', 'o', 'u', 'x'));
+                grid.setFilter("name", search);
+                break;
+            case 1:  // Delete a character
+                if (!search.empty()) search.pop_back();
+                grid.setFilter("name", search);
+                break;
+            case 2:
+                grid.addRow(*genMixedDataGridRow(nextRow++));
+                break;
+            case 3: {
+                if (grid.getRowCount() == 0) break;
+                auto index = static_cast<size_t>(*gen::inRange(0, static_cast<int>(grid.getRowCount())));
+                grid.setCell(grid.getRows()[index].id, "name", *genStringCellValue());
+                break;
+            }
+            case 4: {
+                if (grid.getRowCount() == 0) break;
+                auto index = static_cast<size_t>(*gen::inRange(0, static_cast<int>(grid.getRowCount())));
+                grid.removeRow(grid.getRows()[index].id);
+                break;
+            }
+            case 5:
+                grid.sortBy(sortColumns[*gen::inRange(0, 4)], *genSortDirection());
+                break;
+            default:
+                grid.setFilter("score", [](const KillerGK::CellValue& value) {
+                    return !std::holds_alternative<double>(value) || std::get<double>(value) > 0.0;
+                });
+                break;
+        }
         
-        for (int i = 0; i < numChildren; ++i) {
-            auto childId = id + "_child_" + std::to_string(i);
-            auto childText = *genTreeNodeText();
-            node.addChild(KillerGK::TreeNode(childId, childText));
+        auto fresh = KillerGK::DataGrid::create();
+        fresh.rows(grid.getRows());
+        for (const auto& filter : grid.getFilters()) {
+            if (filter.customFilter) {
+                fresh.setFilter(filter.columnId, filter.customFilter);
+            } else {
+                fresh.setFilter(filter.columnId, filter.filterText);
+            }
         }
+        fresh.sortBy(grid.getSortKeys());
         
-        return node;
-    });
-}
-
-/**
- * @brief Helper function to count total nodes in a tree (including root)
- */
-inline size_t countNodes(const KillerGK::TreeNode& node) {
-    size_t count = 1;
-    for (const auto& child : node.children) {
-        count += countNodes(child);
+        auto incremental = grid.getDisplayedRows();
+        auto rebuilt = fresh.getDisplayedRows();
+        RC_ASSERT(incremental.size() == rebuilt.size());
+        for (size_t i = 0; i < incremental.size(); ++i) {
+            RC_ASSERT(incremental[i].id == rebuilt[i].id);
+        }
+        
+        if (!incremental.empty()) {
+            auto index = static_cast<size_t>(*gen::inRange(0, static_cast<int>(incremental.size())));
+            grid.scrollToRow(incremental[index].id);
+            RC_ASSERT(grid.getScrollOffset() == static_cast<float>(index) * grid.getRowHeight());
+        }
     }
-    return count;
 }
 
 /**
- * @brief Helper function to count total nodes in a TreeView
+ * **Feature: killergk-gui-library, Property 9: DataGrid Sorting Correctness**
+ * 
+ * *For any* set of rows, sorting in either direction SHALL be stable: rows
+ * with equal values in the sort column keep their original relative order.
+ * 
+ * **Validates: Requirements 2.4**
  */
-inline size_t countAllNodes(const std::vector<KillerGK::TreeNode>& nodes) {
-    size_t count = 0;
-    for (const auto& node : nodes) {
-        count += countNodes(node);
+RC_GTEST_PROP(DataGridSortingProperties, SortIsStable, ()) {
+    auto numRows = *gen::inRange(2, 60);
+    std::vector<KillerGK::DataGridRow> rows;
+    for (int i = 0; i < numRows; ++i) {
+        KillerGK::DataGridRow row("row_" + std::to_string(i));
+        row.setCell("group", int64_t{*gen::inRange(0, 4)});
+        row.setCell("order", int64_t{i});
+        rows.push_back(row);
+    }
+    
+    auto grid = KillerGK::DataGrid::create();
+    grid.rows(rows);
+    
+    for (auto direction : {KillerGK::SortDirection::Ascending, KillerGK::SortDirection::Descending}) {
+        grid.sortBy("group", direction);
+        auto displayed = grid.getDisplayedRows();
+        RC_ASSERT(displayed.size() == rows.size());
+        
+        for (size_t i = 1; i < displayed.size(); ++i) {
+            if (displayed[i - 1].getCell("group") == displayed[i].getCell("group")) {
+                RC_ASSERT(std::get<int64_t>(displayed[i - 1].getCell("order")) <
+                          std::get<int64_t>(displayed[i].getCell("order")));
+            }
+        }
     }
-    return count;
 }
 
 /**
- * @brief Helper function to collect all node IDs from a tree
+ * **Feature: killergk-gui-library, Property 9: DataGrid Sorting Correctness**
+ * 
+ * *For any* sequence of row additions, removals, edits and filter changes,
+ * the incrementally maintained groups SHALL match groups and aggregates
+ * recomputed from the displayed rows, and the display items SHALL list each
+ * group's header followed by its rows (unless collapsed) in display order.
+ * 
+ * **Validates: Requirements 2.4**
  */
-inline void collectNodeIds(const KillerGK::TreeNode& node, std::set<std::string>& ids) {
-    ids.insert(node.id);
-    for (const auto& child : node.children) {
-        collectNodeIds(child, ids);
+RC_GTEST_PROP(DataGridSortingProperties, GroupAggregatesMatchReference, ()) {
+    auto numRows = *gen::inRange(0, 40);
+    std::vector<KillerGK::DataGridRow> rows;
+    for (int i = 0; i < numRows; ++i) {
+        rows.push_back(*genMixedDataGridRow(i));
+    }
+    
+    auto grid = KillerGK::DataGrid::create();
+    grid.rows(rows);
+    grid.sortBy("score", KillerGK::SortDirection::Ascending);
+    grid.groupBy("active");
+    grid.aggregates({{"score", KillerGK::AggregateFunction::Count},
+                     {"score", KillerGK::AggregateFunction::Sum},
+                     {"score", KillerGK::AggregateFunction::Average},
+                     {"score", KillerGK::AggregateFunction::Min},
+                     {"quantity", KillerGK::AggregateFunction::Max}});
+    
+    std::string search;
+    int nextRow = numRows;
+    
+    auto numSteps = *gen::inRange(1, 25);
+    for (int step = 0; step < numSteps; ++step) {
+        auto all = grid.getRows();
+        auto pickId = [&all]() {
+            return all[static_cast<size_t>(*gen::inRange(0, static_cast<int>(all.size())))].id;
+        };
+        
+        switch (*gen::inRange(0, 8)) {
+            case 0:
+                grid.addRow(*genMixedDataGridRow(nextRow++));
+                break;
+            case 1:
+                if (!all.empty()) grid.removeRow(pickId());
+                break;
+            case 2:
+                if (!all.empty()) grid.setCell(pickId(), "score", *genDoubleCellValue());
+                break;
+            case 3:
+                if (!all.empty()) grid.setCell(pickId(), "active", *gen::arbitrary<bool>());
+                break;
+            case 4:  // Edit through a row pointer
+                if (!all.empty()) {
+                    auto* row = grid.getRow(pickId());
+                    row->setCell("quantity", *genInt64CellValue());
+                    row->cells.erase("score");
+                }
+                break;
+            case 5:
+                search = *gen::element(std::string(), std::string("a"), std::string("e"), search + "a");
+                grid.setFilter("name", search);
+                break;
+            case 6:
+                grid.sortBy(*gen::element(std::string("name"), std::string("score")), *genSortDirection());
+                break;
+            default:
+                grid.collapseGroup(*gen::arbitrary<bool>(), !grid.isGroupCollapsed(true));
+                break;
+        }
+        
+        // Reference groups from the displayed rows, keyed by (has value, value)
+        struct Reference {
+            std::vector<std::string> ids;
+            std::vector<double> scores;
+            std::vector<double> quantities;
+        };
+        std::map<std::pair<bool, bool>, Reference> reference;
+        for (const auto& row : grid.getDisplayedRows()) {
+            auto active = row.cells.find("active");
+            bool hasActive = active != row.cells.end();
+            auto& group = reference[std::make_pair(hasActive, hasActive && std::get<bool>(active->second))];
+            group.ids.push_back(row.id);
+            if (row.cells.count("score")) group.scores.push_back(std::get<double>(row.getCell("score")));
+            if (row.cells.count("quantity")) {
+                group.quantities.push_back(static_cast<double>(std::get<int64_t>(row.getCell("quantity"))));
+            }
+        }
+        
+        auto groups = grid.getGroups();
+        RC_ASSERT(groups.size() == reference.size());
+        
+        auto near = [](double a, double b) {
+            return std::abs(a - b) <= 1e-6 * (1.0 + std::abs(a) + std::abs(b));
+        };
+        size_t g = 0;
+        for (const auto& [key, expected] : reference) {
+            const auto& group = groups[g++];
+            RC_ASSERT(group.hasKey == key.first);
+            if (key.first) RC_ASSERT(std::get<bool>(group.key) == key.second);
+            RC_ASSERT(group.rowCount == expected.ids.size());
+            RC_ASSERT(group.aggregates.size() == 5u);
+            
+            double sum = 0.0;
+            for (double score : expected.scores) sum += score;
+            RC_ASSERT(group.aggregates[0] == static_cast<double>(expected.scores.size()));
+            RC_ASSERT(near(group.aggregates[1], sum));
+            if (expected.scores.empty()) {
+                RC_ASSERT(std::isnan(group.aggregates[2]));
+                RC_ASSERT(std::isnan(group.aggregates[3]));
+            } else {
+                RC_ASSERT(near(group.aggregates[2], sum / expected.scores.size()));
+                RC_ASSERT(group.aggregates[3] == *std::min_element(expected.scores.begin(), expected.scores.end()));
+            }
+            if (expected.quantities.empty()) {
+                RC_ASSERT(std::isnan(group.aggregates[4]));
+            } else {
+                RC_ASSERT(group.aggregates[4] ==
+                          *std::max_element(expected.quantities.begin(), expected.quantities.end()));
+            }
+        }
+        
+        // Display items: header, then the group's rows in display order
+        std::vector<std::string> expectedItems;
+        g = 0;
+        for (const auto& [key, expected] : reference) {
+            expectedItems.push_back("#" + std::to_string(g));
+            if (!groups[g].collapsed) {
+                expectedItems.insert(expectedItems.end(), expected.ids.begin(), expected.ids.end());
+            }
+            g++;
+        }
+        auto items = grid.getDisplayedItems(0, grid.getDisplayedItemCount());
+        RC_ASSERT(items.size() == expectedItems.size());
+        for (size_t i = 0; i < items.size(); ++i) {
+            RC_ASSERT((items[i].isGroupHeader ? "#" + std::to_string(items[i].groupIndex) : items[i].row.id) ==
+                      expectedItems[i]);
+        }
+        for (size_t i = 0; i < items.size(); ++i) {
+            if (items[i].isGroupHeader) continue;
+            grid.scrollToRow(items[i].row.id);
+            RC_ASSERT(grid.getScrollOffset() == static_cast<float>(i) * grid.getRowHeight());
+        }
     }
 }
 
 /**
- * @brief Helper function to collect all node IDs from a TreeView
+ * **Feature: killergk-gui-library, Property 9: DataGrid Sorting Correctness**
+ * 
+ * *For any* rows and any list of sort keys, the displayed order SHALL match
+ * a stable sort by the first key, ties broken by the following keys in turn,
+ * with missing cells ordered first for ascending keys and last for
+ * descending ones.
+ * 
+ * **Validates: Requirements 2.4**
  */
-inline std::set<std::string> collectAllNodeIds(const std::vector<KillerGK::TreeNode>& nodes) {
-    std::set<std::string> ids;
-    for (const auto& node : nodes) {
-        collectNodeIds(node, ids);
+RC_GTEST_PROP(DataGridSortingProperties, MultiColumnSortMatchesReference, ()) {
+    static const char* columns[] = {"group", "name", "rank"};
+    auto numRows = *gen::inRange(0, 80);
+    std::vector<KillerGK::DataGridRow> rows;
+    for (int i = 0; i < numRows; ++i) {
+        KillerGK::DataGridRow row("row_" + std::to_string(i));
+        // Small value ranges so that ties are common
+        if (*gen::inRange(0, 8) != 0) row.setCell("group", int64_t{*gen::inRange(0, 3)});
+        if (*gen::inRange(0, 8) != 0) row.setCell("name", std::string(1, *gen::element('a', 'b', 'c')));
+        if (*gen::inRange(0, 8) != 0) row.setCell("rank", static_cast<double>(*gen::inRange(0, 4)));
+        rows.push_back(row);
+    }
+    
+    std::vector<KillerGK::DataGridSortKey> keys;
+    auto numKeys = *gen::inRange(1, 4);
+    for (int k = 0; k < numKeys; ++k) {
+        keys.push_back({columns[*gen::inRange(0, 3)],
+                        *gen::element(KillerGK::SortDirection::Ascending, KillerGK::SortDirection::Descending)});
+    }
+    
+    auto grid = KillerGK::DataGrid::create();
+    grid.rows(rows).sortBy(keys);
+    
+    // Reference: the first occurrence of each column counts
+    std::vector<KillerGK::DataGridSortKey> effective;
+    for (const auto& key : keys) {
+        bool seen = std::any_of(effective.begin(), effective.end(),
+            [&key](const KillerGK::DataGridSortKey& e) { return e.columnId == key.columnId; });
+        if (!seen) effective.push_back(key);
+    }
+    RC_ASSERT(grid.getSortKeys().size() == effective.size());
+    
+    auto expected = rows;
+    std::stable_sort(expected.begin(), expected.end(),
+        [&effective](const KillerGK::DataGridRow& a, const KillerGK::DataGridRow& b) {
+            for (const auto& key : effective) {
+                auto itA = a.cells.find(key.columnId);
+                auto itB = b.cells.find(key.columnId);
+                bool hasA = itA != a.cells.end();
+                bool hasB = itB != b.cells.end();
+                bool ascending = key.direction == KillerGK::SortDirection::Ascending;
+                if (hasA != hasB) return ascending ? hasB : hasA;
+                if (!hasA || itA->second == itB->second) continue;
+                return ascending ? itA->second < itB->second : itB->second < itA->second;
+            }
+            return false;
+        });
+    
+    auto displayed = grid.getDisplayedRows();
+    RC_ASSERT(displayed.size() == expected.size());
+    for (size_t i = 0; i < displayed.size(); ++i) {
+        RC_ASSERT(displayed[i].id == expected[i].id);
     }
-    return ids;
 }
 
 /**
- * @brief Helper function to verify parent-child relationships
+ * **Feature: killergk-gui-library, Property 9: DataGrid Sorting Correctness**
+ * 
+ * *For any* sequence of row selections, range selections, deselections and
+ * row removals on a sorted grid, the selection SHALL match a reference model,
+ * row flags SHALL agree with it, and the deltas reported SHALL account for
+ * every change.
+ * 
+ * **Validates: Requirements 2.4**
  */
-inline bool verifyParentChildRelationship(const KillerGK::TreeNode& parent, const std::string& childId) {
-    for (const auto& child : parent.children) {
-        if (child.id == childId) return true;
-        if (verifyParentChildRelationship(child, childId)) return true;
+RC_GTEST_PROP(DataGridSortingProperties, SelectionMatchesModel, ()) {
+    auto numRows = *gen::inRange(1, 60);
+    std::vector<KillerGK::DataGridRow> rows;
+    for (int i = 0; i < numRows; ++i) {
+        rows.push_back(*genMixedDataGridRow(i));
+    }
+    
+    auto grid = KillerGK::DataGrid::create();
+    grid.rows(rows).multiSelect(true);
+    grid.sortBy("score", KillerGK::SortDirection::Descending);
+    
+    std::vector<std::string> model;
+    std::set<std::string> fromDeltas;
+    grid.onSelectionDelta([&fromDeltas](const KillerGK::DataGridSelectionDelta& delta) {
+        for (const auto& id : delta.removed) {
+            RC_ASSERT(fromDeltas.erase(id) == 1);
+        }
+        for (const auto& id : delta.added) {
+            RC_ASSERT(fromDeltas.insert(id).second);
+        }
+    });
+    
+    auto modelAdd = [&model](const std::string& id) {
+        if (std::find(model.begin(), model.end(), id) == model.end()) model.push_back(id);
+    };
+    
+    auto numSteps = *gen::inRange(1, 30);
+    for (int step = 0; step < numSteps; ++step) {
+        auto displayed = grid.getDisplayedRows();
+        if (displayed.empty()) break;
+        auto pick = [&displayed]() {
+            return static_cast<size_t>(*gen::inRange(0, static_cast<int>(displayed.size())));
+        };
+        
+        switch (*gen::inRange(0, 6)) {
+            case 0: {
+                auto index = pick();
+                bool add = *gen::arbitrary<bool>();
+                if (!add) model.clear();
+                modelAdd(displayed[index].id);
+                grid.selectRow(displayed[index].id, add);
+                break;
+            }
+            case 1: {
+                auto first = pick();
+                auto last = pick();
+                bool add = *gen::arbitrary<bool>();
+                std::vector<std::string> range;
+                for (size_t i = std::min(first, last); i <= std::max(first, last); ++i) {
+                    range.push_back(displayed[i].id);
+                }
+                if (!add) {
+                    model.erase(std::remove_if(model.begin(), model.end(), [&range](const std::string& id) {
+                        return std::find(range.begin(), range.end(), id) == range.end();
+                    }), model.end());
+                }
+                for (const auto& id : range) modelAdd(id);
+                grid.selectRange(first, last, add);
+                break;
+            }
+            case 2: {
+                auto id = displayed[pick()].id;
+                model.erase(std::remove(model.begin(), model.end(), id), model.end());
+                grid.deselectRow(id);
+                break;
+            }
+            case 3: {
+                auto id = displayed[pick()].id;
+                model.erase(std::remove(model.begin(), model.end(), id), model.end());
+                fromDeltas.erase(id);  // Removal is not a selection change
+                grid.removeRow(id);
+                break;
+            }
+            case 4:
+                model.clear();
+                grid.clearSelection();
+                break;
+            default:
+                grid.addRow(*genMixedDataGridRow(numRows + step));
+                break;
+        }
+        
+        RC_ASSERT(grid.getSelectedRowIds() == model);
+        RC_ASSERT(fromDeltas == std::set<std::string>(model.begin(), model.end()));
+        for (const auto& row : grid.getRows()) {
+            bool selected = std::find(model.begin(), model.end(), row.id) != model.end();
+            RC_ASSERT(row.selected == selected);
+            RC_ASSERT(grid.isRowSelected(row.id) == selected);
+        }
+        auto selectedRows = grid.getSelectedRows();
+        RC_ASSERT(selectedRows.size() == model.size());
+        for (size_t i = 0; i < model.size(); ++i) {
+            RC_ASSERT(selectedRows[i]->id == model[i]);
+        }
     }
-    return false;
 }
 
-} // namespace rc
+
+#include "KillerGK/widgets/DataGridStore.hpp"
+#include <optional>
 
 /**
- * **Feature: killergk-gui-library, Property 11: TreeView Hierarchy Preservation**
- * 
- * *For any* TreeView with any hierarchical data, expand/collapse operations 
- * SHALL preserve the parent-child relationships and data integrity.
+ * **Feature: killergk-gui-library, Property 9: DataGrid Sorting Correctness**
  * 
- * This test verifies that:
- * 1. Expanding a node preserves all node IDs in the tree
- * 2. Expanding a node preserves the total node count
- * 3. Parent-child relationships remain intact after expand
+ * *For any* sequence of text cells overwritten and cleared, the string pool
+ * SHALL keep fewer dead strings than the larger of COMPACT_MIN_DEAD and the
+ * live strings once compacted, every cell SHALL keep its text, and a grid
+ * sorted, filtered and grouped by the churned column SHALL display the same
+ * rows as a grid built from its final rows.
  * 
- * **Validates: Requirements 2.5**
+ * **Validates: Requirements 2.4**
  */
-RC_GTEST_PROP(TreeViewHierarchyProperties, ExpandPreservesHierarchy, ()) {
-    // Generate a tree with 1-3 root nodes, each with 1-4 children
-    auto numRoots = *gen::inRange(1, 4);
-    std::vector<KillerGK::TreeNode> rootNodes;
-    
-    for (int i = 0; i < numRoots; ++i) {
-        auto numChildren = *gen::inRange(1, 5);
-        auto node = *genTreeNodeWithChildren(numChildren);
-        node.id = "root_" + std::to_string(i);  // Ensure unique root IDs
-        rootNodes.push_back(node);
+RC_GTEST_PROP(DataGridSortingProperties, StringChurnCompactsPool, ()) {
+    auto numRows = *gen::inRange(1, 20);
+    std::vector<KillerGK::DataGridRow> rows;
+    for (int i = 0; i < numRows; ++i) {
+        KillerGK::DataGridRow row("row_" + std::to_string(i));
+        row.setCell("name", "v" + std::to_string(i % 3));
+        rows.push_back(row);
     }
     
-    // Create TreeView and add nodes
-    auto tree = KillerGK::TreeView::create();
-    tree.nodes(rootNodes);
-    
-    // Collect original state
-    auto originalIds = collectAllNodeIds(tree.getNodes());
-    size_t originalCount = countAllNodes(tree.getNodes());
+    KillerGK::DataGridStore store;
+    store.assign(rows);
+    size_t ordinal = store.findColumn("name");
+    std::vector<std::optional<std::string>> model(rows.size());
+    for (size_t i = 0; i < rows.size(); ++i) model[i] = "v" + std::to_string(i % 3);
+    
+    auto writes = *gen::inRange(0, 3000);
+    for (int w = 0; w < writes; ++w) {
+        auto row = static_cast<size_t>(*gen::inRange(0, numRows));
+        if (*gen::inRange(0, 10) == 0) {
+            store.clearCell(row, ordinal);
+            model[row].reset();
+        } else {
+            // Mostly new text, so dead strings pile up
+            std::string text = "w" + std::to_string(*gen::inRange(0, 100000));
+            store.setCell(row, ordinal, text);
+            model[row] = text;
+        }
+        store.compactStrings();
+    }
     
-    // Select a random root to expand
-    auto expandIndex = *gen::inRange(0, numRoots);
-    std::string nodeToExpand = "root_" + std::to_string(expandIndex);
+    std::set<std::string> live;
+    for (size_t row = 0; row < model.size(); ++row) {
+        if (model[row]) {
+            live.insert(*model[row]);
+            RC_ASSERT(store.getCell(row, ordinal) == KillerGK::CellValue{*model[row]});
+        } else {
+            RC_ASSERT(store.kind(row, ordinal) == KillerGK::CellKind::Empty);
+        }
+    }
+    RC_ASSERT(store.strings().size() - store.strings().deadCount() == live.size());
+    RC_ASSERT(store.strings().deadCount() < std::max(KillerGK::DataGridStore::COMPACT_MIN_DEAD, live.size()));
     
-    // Expand the node
-    tree.expand(nodeToExpand);
-    
-    // Verify hierarchy is preserved
-    auto afterExpandIds = collectAllNodeIds(tree.getNodes());
-    size_t afterExpandCount = countAllNodes(tree.getNodes());
-    
-    // All original IDs should still exist
-    RC_ASSERT(originalIds == afterExpandIds);
-    
-    // Total node count should be unchanged
-    RC_ASSERT(originalCount == afterExpandCount);
-    
-    // The expanded node should be marked as expanded
-    RC_ASSERT(tree.isExpanded(nodeToExpand));
+    // The grid rebuilds what is keyed by string id when its store compacts
+    auto grid = KillerGK::DataGrid::create();
+    grid.rows(rows);
+    grid.sortBy("name", *genSortDirection());
+    grid.setFilter("name", "1");
+    grid.setFilter("prefix", KillerGK::DataGridFilterExpr::prefix("name", "w"));
+    grid.groupBy("name");
+    
+    int changes = *gen::inRange(0, 2 * static_cast<int>(KillerGK::DataGridStore::COMPACT_MIN_DEAD) + 200);
+    for (int c = 0; c < changes; ++c) {
+        std::string id = "row_" + std::to_string(*gen::inRange(0, numRows));
+        grid.setCell(id, "name", "w" + std::to_string(c));
+        if (c % 256 != 0 && c + 1 != changes) continue;
+        
+        auto fresh = KillerGK::DataGrid::create();
+        fresh.rows(grid.getRows());
+        fresh.sortBy(grid.getSortKeys());
+        fresh.setFilter("name", "1");
+        fresh.setFilter("prefix", KillerGK::DataGridFilterExpr::prefix("name", "w"));
+        fresh.groupBy("name");
+        
+        RC_ASSERT(grid.getDisplayedItemCount() == fresh.getDisplayedItemCount());
+        auto items = grid.getDisplayedItems(0, grid.getDisplayedItemCount());
+        auto expected = fresh.getDisplayedItems(0, fresh.getDisplayedItemCount());
+        for (size_t i = 0; i < items.size(); ++i) {
+            RC_ASSERT(items[i].isGroupHeader == expected[i].isGroupHeader);
+            RC_ASSERT(items[i].row.id == expected[i].row.id);
+        }
+    }
 }
 
+// ============================================================================
+// Property Tests for DataGrid Data Sources
+// ============================================================================
+
 /**
- * **Feature: killergk-gui-library, Property 11: TreeView Hierarchy Preservation**
- * 
- * *For any* TreeView with any hierarchical data, expand/collapse operations 
- * SHALL preserve the parent-child relationships and data integrity.
- * 
- * This test verifies that:
- * 1. Collapsing a node preserves all node IDs in the tree
- * 2. Collapsing a node preserves the total node count
- * 3. Parent-child relationships remain intact after collapse
- * 
- * **Validates: Requirements 2.5**
+ * @brief In-memory data source that sorts and filters like the grid does
+ *
+ * Tracks how many rows each fetch returned so tests can check that the grid
+ * only pulls what it needs.
  */
-RC_GTEST_PROP(TreeViewHierarchyProperties, CollapsePreservesHierarchy, ()) {
-    // Generate a tree with 1-3 root nodes, each with 1-4 children
-    auto numRoots = *gen::inRange(1, 4);
-    std::vector<KillerGK::TreeNode> rootNodes;
-    
-    for (int i = 0; i < numRoots; ++i) {
-        auto numChildren = *gen::inRange(1, 5);
-        auto node = *genTreeNodeWithChildren(numChildren);
-        node.id = "root_" + std::to_string(i);
-        node.expanded = true;  // Start expanded
-        rootNodes.push_back(node);
-    }
-    
-    // Create TreeView and add nodes
-    auto tree = KillerGK::TreeView::create();
-    tree.nodes(rootNodes);
+class TestGridDataSource : public KillerGK::DataGridDataSource {
+public:
+    explicit TestGridDataSource(std::vector<KillerGK::DataGridRow> rows)
+        : m_rows(std::move(rows)), m_view(m_rows) {}
     
-    // Collect original state
-    auto originalIds = collectAllNodeIds(tree.getNodes());
-    size_t originalCount = countAllNodes(tree.getNodes());
+    size_t rowCount() const override { return m_view.size(); }
     
-    // Select a random root to collapse
-    auto collapseIndex = *gen::inRange(0, numRoots);
-    std::string nodeToCollapse = "root_" + std::to_string(collapseIndex);
+    std::vector<KillerGK::DataGridRow> fetchRows(size_t first, size_t count) override {
+        std::vector<KillerGK::DataGridRow> result;
+        for (size_t i = first; i < std::min(m_view.size(), first + count); ++i) {
+            result.push_back(m_view[i]);
+        }
+        largestFetch = std::max(largestFetch, result.size());
+        return result;
+    }
     
-    // Collapse the node
-    tree.collapse(nodeToCollapse);
+    void setQuery(const KillerGK::DataGridQuery& query) override {
+        queries++;
+        m_view.clear();
+        for (const auto& row : m_rows) {
+            bool passes = true;
+            for (const auto& filter : query.filters) {
+                auto it = row.cells.find(filter.columnId);
+                if (it == row.cells.end()) continue;
+                if (filter.customFilter) {
+                    passes = passes && filter.customFilter(it->second);
+                } else if (const auto* text = std::get_if<std::string>(&it->second)) {
+                    passes = passes && toLower(*text).find(toLower(filter.filterText)) != std::string::npos;
+                }
+            }
+            if (passes) m_view.push_back(row);
+        }
+        
+        // Stable sorts from the last key to the first give multi-key order
+        for (auto key = query.sortKeys.rbegin(); key != query.sortKeys.rend(); ++key) {
+            bool ascending = key->direction == KillerGK::SortDirection::Ascending;
+            const std::string& columnId = key->columnId;
+            std::stable_sort(m_view.begin(), m_view.end(),
+                [&](const KillerGK::DataGridRow& a, const KillerGK::DataGridRow& b) {
+                    auto itA = a.cells.find(columnId);
+                    auto itB = b.cells.find(columnId);
+                    bool hasA = itA != a.cells.end();
+                    bool hasB = itB != b.cells.end();
+                    if (hasA != hasB) return ascending ? hasB : hasA;
+                    if (!hasA) return false;
+                    return ascending ? itA->second < itB->second : itB->second < itA->second;
+                });
+        }
+    }
     
-    // Verify hierarchy is preserved
-    auto afterCollapseIds = collectAllNodeIds(tree.getNodes());
-    size_t afterCollapseCount = countAllNodes(tree.getNodes());
+    size_t indexOf(const std::string& id) const override {
+        for (size_t i = 0; i < m_view.size(); ++i) {
+            if (m_view[i].id == id) return i;
+        }
+        return NOT_FOUND;
+    }
     
-    // All original IDs should still exist
-    RC_ASSERT(originalIds == afterCollapseIds);
+    size_t largestFetch = 0;
+    int queries = 0;
     
-    // Total node count should be unchanged
-    RC_ASSERT(originalCount == afterCollapseCount);
+private:
+    static std::string toLower(std::string text) {
+        std::transform(text.begin(), text.end(), text.begin(),
+            [](unsigned char c) { return std::tolower(c); });
+        return text;
+    }
     
-    // The collapsed node should be marked as collapsed
-    RC_ASSERT(!tree.isExpanded(nodeToCollapse));
-}
+    std::vector<KillerGK::DataGridRow> m_rows;
+    std::vector<KillerGK::DataGridRow> m_view;
+};
 
 /**
- * **Feature: killergk-gui-library, Property 11: TreeView Hierarchy Preservation**
+ * **Feature: killergk-gui-library, Property 9: DataGrid Sorting Correctness**
  * 
- * *For any* TreeView with any hierarchical data, expand/collapse operations 
- * SHALL preserve the parent-child relationships and data integrity.
+ * *For any* rows served by a data source, any range of displayed rows SHALL
+ * equal the same range of a grid holding those rows, under the same sort and
+ * filter, while the grid holds no more than the requested range plus the
+ * prefetch margin on each side.
  * 
- * This test verifies that:
- * 1. Toggle operation preserves all node IDs
- * 2. Toggle operation preserves total node count
- * 3. Toggle changes the expanded state correctly
+ * **Validates: Requirements 2.4**
+ */
+RC_GTEST_PROP(DataGridSortingProperties, DataSourceRangesMatchOwnedRows, ()) {
+    auto numRows = *gen::inRange(0, 200);
+    std::vector<KillerGK::DataGridRow> rows;
+    for (int i = 0; i < numRows; ++i) {
+        rows.push_back(*genMixedDataGridRow(i));
+    }
+    auto prefetch = static_cast<size_t>(*gen::inRange(0, 20));
+    
+    auto source = std::make_shared<TestGridDataSource>(rows);
+    auto sourced = KillerGK::DataGrid::create();
+    sourced.prefetchRows(prefetch).dataSource(source);
+    auto owned = KillerGK::DataGrid::create();
+    owned.rows(rows);
+    
+    if (*gen::arbitrary<bool>()) {
+        auto direction = *gen::element(KillerGK::SortDirection::Ascending, KillerGK::SortDirection::Descending);
+        sourced.sortBy("name", direction);
+        owned.sortBy("name", direction);
+    }
+    if (*gen::arbitrary<bool>()) {
+        std::string text(1, *gen::element('a', 'e', 'i', '1', '_'));
+        sourced.setFilter("name", text);
+        owned.setFilter("name", text);
+    }
+    RC_ASSERT(sourced.getFilteredRowCount() == owned.getFilteredRowCount());
+    
+    size_t largestRange = 1;
+    auto numRanges = *gen::inRange(1, 10);
+    for (int r = 0; r < numRanges; ++r) {
+        auto first = static_cast<size_t>(*gen::inRange(0, numRows + 5));
+        auto count = static_cast<size_t>(*gen::inRange(0, 30));
+        largestRange = std::max(largestRange, count);
+        
+        auto fromSource = sourced.getDisplayedRowRange(first, count);
+        auto fromOwned = owned.getDisplayedRowRange(first, count);
+        RC_ASSERT(fromSource.size() == fromOwned.size());
+        for (size_t i = 0; i < fromSource.size(); ++i) {
+            RC_ASSERT(fromSource[i].id == fromOwned[i].id);
+            RC_ASSERT(fromSource[i].cells == fromOwned[i].cells);
+        }
+        
+        // The window only grows to cover the largest range requested
+        RC_ASSERT(sourced.getRows().size() <= largestRange + 2 * prefetch);
+        RC_ASSERT(source->largestFetch <= largestRange + 2 * prefetch);
+    }
+}
+
+/**
+ * **Feature: killergk-gui-library, Property 9: DataGrid Sorting Correctness**
  * 
- * **Validates: Requirements 2.5**
+ * *For any* scroll position over a data source, the visible rows SHALL be
+ * the rows at the visible range, scrolling within the prefetched window SHALL
+ * not fetch again, and sort changes SHALL reach the source.
+ * 
+ * **Validates: Requirements 2.4**
  */
-RC_GTEST_PROP(TreeViewHierarchyProperties, TogglePreservesHierarchy, ()) {
-    // Generate a tree with 1-3 root nodes, each with 1-4 children
-    auto numRoots = *gen::inRange(1, 4);
-    std::vector<KillerGK::TreeNode> rootNodes;
-    
-    for (int i = 0; i < numRoots; ++i) {
-        auto numChildren = *gen::inRange(1, 5);
-        auto node = *genTreeNodeWithChildren(numChildren);
-        node.id = "root_" + std::to_string(i);
-        node.expanded = *gen::arbitrary<bool>();  // Random initial state
-        rootNodes.push_back(node);
+RC_GTEST_PROP(DataGridSortingProperties, DataSourceScrollsWithinWindow, ()) {
+    auto numRows = *gen::inRange(50, 2000);
+    std::vector<KillerGK::DataGridRow> rows;
+    for (int i = 0; i < numRows; ++i) {
+        KillerGK::DataGridRow row("row_" + std::to_string(i));
+        row.setCell("line", int64_t{i});
+        rows.push_back(row);
     }
     
-    // Create TreeView and add nodes
-    auto tree = KillerGK::TreeView::create();
-    tree.nodes(rootNodes);
-    
-    // Collect original state
-    auto originalIds = collectAllNodeIds(tree.getNodes());
-    size_t originalCount = countAllNodes(tree.getNodes());
-    
-    // Select a random root to toggle
-    auto toggleIndex = *gen::inRange(0, numRoots);
-    std::string nodeToToggle = "root_" + std::to_string(toggleIndex);
-    
-    // Get initial expanded state
-    bool wasExpanded = tree.isExpanded(nodeToToggle);
+    auto source = std::make_shared<TestGridDataSource>(rows);
+    auto grid = KillerGK::DataGrid::create();
+    grid.rowHeight(20.0f).headerHeight(0.0f);
+    grid.height(200.0f);
+    grid.prefetchRows(40).dataSource(source);
+    RC_ASSERT(source->queries == 1);
     
-    // Toggle the node
-    tree.toggle(nodeToToggle);
+    auto offset = static_cast<float>(*gen::inRange(0, numRows * 20));
+    grid.scrollTo(offset);
     
-    // Verify hierarchy is preserved
-    auto afterToggleIds = collectAllNodeIds(tree.getNodes());
-    size_t afterToggleCount = countAllNodes(tree.getNodes());
+    int startIndex = 0;
+    int endIndex = 0;
+    grid.getVisibleRowRange(startIndex, endIndex);
+    auto visible = grid.getVisibleRows();
+    RC_ASSERT(visible.size() == static_cast<size_t>(endIndex - startIndex));
+    for (size_t i = 0; i < visible.size(); ++i) {
+        RC_ASSERT(visible[i].id == "row_" + std::to_string(startIndex + static_cast<int>(i)));
+    }
     
-    // All original IDs should still exist
-    RC_ASSERT(originalIds == afterToggleIds);
+    // A small scroll stays inside the prefetch margin
+    auto fetched = source->largestFetch;
+    source->largestFetch = 0;
+    grid.scrollTo(grid.getScrollOffset() + 20.0f);
+    (void)grid.getVisibleRows();
+    RC_ASSERT(source->largestFetch == 0);
+    RC_ASSERT(fetched <= 11 + 2 * 40);  // Visible rows plus the margins
     
-    // Total node count should be unchanged
-    RC_ASSERT(originalCount == afterToggleCount);
+    grid.sortBy("line", KillerGK::SortDirection::Descending);
+    RC_ASSERT(source->queries == 2);
+    auto top = grid.getDisplayedRowRange(0, 1);
+    RC_ASSERT(top.size() == 1);
+    RC_ASSERT(top[0].id == "row_" + std::to_string(numRows - 1));
     
-    // The expanded state should be toggled
-    RC_ASSERT(tree.isExpanded(nodeToToggle) == !wasExpanded);
+    grid.scrollToRow("row_0");
+    grid.getVisibleRowRange(startIndex, endIndex);
+    RC_ASSERT(endIndex == numRows);
 }
 
+
+// ============================================================================
+// Property Tests for DataGrid Filter Expressions
+// ============================================================================
+
+#include <regex>
+
+namespace rc {
+
 /**
- * **Feature: killergk-gui-library, Property 11: TreeView Hierarchy Preservation**
- * 
- * *For any* TreeView with any hierarchical data, expand/collapse operations 
- * SHALL preserve the parent-child relationships and data integrity.
- * 
- * This test verifies that:
- * 1. ExpandAll preserves all node IDs
- * 2. ExpandAll preserves total node count
- * 3. All nodes are expanded after ExpandAll
- * 
- * **Validates: Requirements 2.5**
+ * @brief Random operand for a column of genMixedDataGridRow, sometimes of another kind
  */
-RC_GTEST_PROP(TreeViewHierarchyProperties, ExpandAllPreservesHierarchy, ()) {
-    // Generate a tree with 1-3 root nodes, each with 1-4 children
-    auto numRoots = *gen::inRange(1, 4);
-    std::vector<KillerGK::TreeNode> rootNodes;
-    std::vector<std::string> rootIds;
-    
-    for (int i = 0; i < numRoots; ++i) {
-        auto numChildren = *gen::inRange(1, 5);
-        auto node = *genTreeNodeWithChildren(numChildren);
-        node.id = "root_" + std::to_string(i);
-        node.expanded = false;  // Start collapsed
-        rootIds.push_back(node.id);
-        rootNodes.push_back(node);
+inline KillerGK::CellValue genFilterOperand(const std::string& columnId) {
+    switch (*gen::inRange(0, 8)) {
+        case 0: return *genStringCellValue();
+        case 1: return *genDoubleCellValue();
+        case 2: return *genInt64CellValue();
+        case 3: return *gen::arbitrary<bool>();
+        default: break;
     }
+    if (columnId == "name") return *genStringCellValue();
+    if (columnId == "score") return *genDoubleCellValue();
+    if (columnId == "quantity") return *genInt64CellValue();
+    return *gen::arbitrary<bool>();
+}
+
+/**
+ * @brief Random filter expression over the columns of genMixedDataGridRow
+ */
+inline KillerGK::DataGridFilterExpr genFilterExpr(int depth) {
+    using F = KillerGK::DataGridFilterExpr;
+    using KillerGK::FilterOp;
     
-    // Create TreeView and add nodes
-    auto tree = KillerGK::TreeView::create();
-    tree.nodes(rootNodes);
-    
-    // Collect original state
-    auto originalIds = collectAllNodeIds(tree.getNodes());
-    size_t originalCount = countAllNodes(tree.getNodes());
-    
-    // Expand all nodes
-    tree.expandAll();
+    if (depth > 0 && *gen::inRange(0, 3) == 0) {
+        std::vector<F> children;
+        auto numChildren = *gen::inRange(0, 4);
+        for (int i = 0; i < numChildren; ++i) {
+            children.push_back(genFilterExpr(depth - 1));
+        }
+        return *gen::arbitrary<bool>() ? F::allOf(std::move(children)) : F::anyOf(std::move(children));
+    }
+    
+    auto columnId = *gen::element(std::string("name"), std::string("score"),
+                                  std::string("quantity"), std::string("active"), std::string("missing"));
+    auto op = static_cast<FilterOp>(*gen::inRange(0, static_cast<int>(FilterOp::Regex) + 1));
+    switch (op) {
+        case FilterOp::Between: {
+            auto low = genFilterOperand(columnId);
+            auto high = low.index() == 0 ? KillerGK::CellValue(*genStringCellValue())
+                                         : KillerGK::CellValue(*genDoubleCellValue());
+            return F::between(columnId, low, high);
+        }
+        case FilterOp::In: {
+            std::vector<KillerGK::CellValue> values;
+            auto numValues = *gen::inRange(0, 5);
+            for (int i = 0; i < numValues; ++i) {
+                values.push_back(genFilterOperand(columnId));
+            }
+            return F::in(columnId, std::move(values));
+        }
+        case FilterOp::Prefix:
+            return F::prefix(columnId, *gen::element(std::string(), std::string("A"), std::string("Bob_"),
+                                                     std::string("Eve_1")));
+        case FilterOp::Regex:
+            return F::regex(columnId, *gen::element(std::string("^C"), std::string("_[0-4]$"),
+                                                    std::string("e_9"), std::string("(")));
+        default:
+            return F::compare(op, columnId, {genFilterOperand(columnId)});
+    }
+}
+
+} // namespace rc
+
+/**
+ * @brief Straightforward evaluation of a filter expression against a row's cells
+ */
+static bool referenceFilterMatches(const KillerGK::DataGridFilterExpr& expr, const KillerGK::DataGridRow& row) {
+    using KillerGK::FilterOp;
+    if (expr.op == FilterOp::And || expr.op == FilterOp::Or) {
+        for (const auto& child : expr.children) {
+            if (referenceFilterMatches(child, row) != (expr.op == FilterOp::And)) return expr.op == FilterOp::Or;
+        }
+        return expr.op == FilterOp::And;
+    }
     
-    // Verify hierarchy is preserved
-    auto afterExpandIds = collectAllNodeIds(tree.getNodes());
-    size_t afterExpandCount = countAllNodes(tree.getNodes());
+    auto cell = row.cells.find(expr.columnId);
+    if (cell == row.cells.end()) return false;
     
-    // All original IDs should still exist
-    RC_ASSERT(originalIds == afterExpandIds);
+    // Operands of the cell's kind: text for text cells, numbers otherwise
+    bool isText = std::holds_alternative<std::string>(cell->second);
+    auto asNumber = [](const KillerGK::CellValue& v) {
+        if (const auto* d = std::get_if<double>(&v)) return *d;
+        if (const auto* i = std::get_if<int64_t>(&v)) return static_cast<double>(*i);
+        return std::get<bool>(v) ? 1.0 : 0.0;
+    };
+    std::vector<KillerGK::CellValue> operands;
+    for (const auto& operand : expr.operands) {
+        if (std::holds_alternative<std::string>(operand) == isText) operands.push_back(operand);
+    }
     
-    // Total node count should be unchanged
-    RC_ASSERT(originalCount == afterExpandCount);
+    if (expr.op == FilterOp::In) {
+        for (const auto& operand : operands) {
+            if (isText ? std::get<std::string>(operand) == std::get<std::string>(cell->second)
+                       : asNumber(operand) == asNumber(cell->second)) {
+                return true;
+            }
+        }
+        return false;
+    }
+    size_t needed = expr.op == FilterOp::Between ? 2 : 1;
+    if (operands.size() != needed || operands.size() != expr.operands.size()) return false;
+    
+    if (isText) {
+        const auto& text = std::get<std::string>(cell->second);
+        const auto& a = std::get<std::string>(operands[0]);
+        switch (expr.op) {
+            case FilterOp::Equal: return text == a;
+            case FilterOp::NotEqual: return text != a;
+            case FilterOp::Less: return text < a;
+            case FilterOp::LessEqual: return text <= a;
+            case FilterOp::Greater: return text > a;
+            case FilterOp::GreaterEqual: return text >= a;
+            case FilterOp::Between: return a <= text && text <= std::get<std::string>(operands[1]);
+            case FilterOp::Prefix: return text.starts_with(a);
+            case FilterOp::Regex:
+                try {
+                    return std::regex_search(text, std::regex(a));
+                } catch (const std::regex_error&) {
+                    return false;
+                }
+            default: return false;
+        }
+    }
     
-    // All root nodes should be expanded
-    for (const auto& rootId : rootIds) {
-        RC_ASSERT(tree.isExpanded(rootId));
+    double x = asNumber(cell->second);
+    double a = asNumber(operands[0]);
+    switch (expr.op) {
+        case FilterOp::Equal: return x == a;
+        case FilterOp::NotEqual: return x != a;
+        case FilterOp::Less: return x < a;
+        case FilterOp::LessEqual: return x <= a;
+        case FilterOp::Greater: return x > a;
+        case FilterOp::GreaterEqual: return x >= a;
+        case FilterOp::Between: return a <= x && x <= asNumber(operands[1]);
+        default: return false;
     }
 }
 
 /**
- * **Feature: killergk-gui-library, Property 11: TreeView Hierarchy Preservation**
- * 
- * *For any* TreeView with any hierarchical data, expand/collapse operations 
- * SHALL preserve the parent-child relationships and data integrity.
+ * **Feature: killergk-gui-library, Property 10: DataGrid Filtering Correctness**
  * 
- * This test verifies that:
- * 1. CollapseAll preserves all node IDs
- * 2. CollapseAll preserves total node count
- * 3. All nodes are collapsed after CollapseAll
+ * *For any* set of rows and any typed filter expressions, combined with a
+ * text filter and followed by row additions, removals and edits, the
+ * displayed rows SHALL be exactly the rows matching every expression and
+ * the text filter.
  * 
- * **Validates: Requirements 2.5**
+ * **Validates: Requirements 2.4**
  */
-RC_GTEST_PROP(TreeViewHierarchyProperties, CollapseAllPreservesHierarchy, ()) {
-    // Generate a tree with 1-3 root nodes, each with 1-4 children
-    auto numRoots = *gen::inRange(1, 4);
-    std::vector<KillerGK::TreeNode> rootNodes;
-    std::vector<std::string> rootIds;
-    
-    for (int i = 0; i < numRoots; ++i) {
-        auto numChildren = *gen::inRange(1, 5);
-        auto node = *genTreeNodeWithChildren(numChildren);
-        node.id = "root_" + std::to_string(i);
-        node.expanded = true;  // Start expanded
-        rootIds.push_back(node.id);
-        rootNodes.push_back(node);
+RC_GTEST_PROP(DataGridFilteringProperties, FilterExpressionsMatchReference, ()) {
+    auto numRows = *gen::inRange(0, 60);
+    std::vector<KillerGK::DataGridRow> rows;
+    for (int i = 0; i < numRows; ++i) {
+        rows.push_back(*genMixedDataGridRow(i));
     }
     
-    // Create TreeView and add nodes
-    auto tree = KillerGK::TreeView::create();
-    tree.nodes(rootNodes);
+    auto grid = KillerGK::DataGrid::create();
+    grid.rows(rows);
     
-    // Collect original state
-    auto originalIds = collectAllNodeIds(tree.getNodes());
-    size_t originalCount = countAllNodes(tree.getNodes());
+    std::map<std::string, KillerGK::DataGridFilterExpr> expressions;
+    std::string search;
+    int nextRow = numRows;
     
-    // Collapse all nodes
-    tree.collapseAll();
+    auto numSteps = *gen::inRange(1, 20);
+    for (int step = 0; step < numSteps; ++step) {
+        auto all = grid.getRows();
+        auto pickId = [&all]() {
+            return all[static_cast<size_t>(*gen::inRange(0, static_cast<int>(all.size())))].id;
+        };
+        
+        switch (*gen::inRange(0, 8)) {
+            case 0:
+            case 1: {
+                auto name = *gen::element(std::string("f1"), std::string("f2"));
+                auto expr = genFilterExpr(2);
+                grid.setFilter(name, expr);
+                expressions.insert_or_assign(name, expr);
+                break;
+            }
+            case 2:
+                if (!expressions.empty()) {
+                    grid.clearFilter(expressions.begin()->first);
+                    expressions.erase(expressions.begin());
+                }
+                break;
+            case 3:
+                search = *gen::element(std::string(), std::string("a"), std::string("_1"));
+                grid.setFilter("name", search);
+                break;
+            case 4:
+                grid.addRow(*genMixedDataGridRow(nextRow++));
+                break;
+            case 5:
+                if (!all.empty()) grid.removeRow(pickId());
+                break;
+            case 6:
+                if (!all.empty()) grid.setCell(pickId(), "score", *genDoubleCellValue());
+                break;
+            default:
+                if (!all.empty()) grid.setCell(pickId(), "name", *genStringCellValue());
+                break;
+        }
+        
+        std::vector<std::string> expected;
+        for (const auto& row : grid.getRows()) {
+            // Text filters are case-insensitive and ignore rows without the cell
+            bool matches = true;
+            if (auto name = row.cells.find("name"); !search.empty() && name != row.cells.end()) {
+                auto text = std::get<std::string>(name->second);
+                std::transform(text.begin(), text.end(), text.begin(),
+                               [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+                matches = text.find(search) != std::string::npos;
+            }
+            for (const auto& [name, expr] : expressions) {
+                matches = matches && referenceFilterMatches(expr, row);
+            }
+            if (matches) expected.push_back(row.id);
+        }
+        std::vector<std::string> actual;
+        for (const auto& row : grid.getDisplayedRows()) {
+            actual.push_back(row.id);
+        }
+        std::sort(expected.begin(), expected.end());
+        std::sort(actual.begin(), actual.end());
+        RC_ASSERT(actual == expected);
+    }
+}
+
+
+// ============================================================================
+// Property Tests for DataGrid CSV Loading
+// ============================================================================
+
+#include "KillerGK/widgets/DataGridCsv.hpp"
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+
+/**
+ * **Feature: killergk-gui-library, Property 9: DataGrid Sorting Correctness**
+ * 
+ * *For any* table of text, integer, decimal and boolean fields written as
+ * CSV or TSV (quoting fields that contain delimiters, quotes or line
+ * breaks), loading it in chunks SHALL reproduce every row and cell in file
+ * order, with numeric and boolean columns inferred as such, and a fraction
+ * in a column sampled as integral SHALL turn the whole column into numbers
+ * that sort by value.
+ * 
+ * **Validates: Requirements 2.4**
+ */
+RC_GTEST_PROP(DataGridSortingProperties, CsvLoadRoundTripsFields, ()) {
+    auto numRows = *gen::inRange(0, 80);
+    char delimiter = *gen::element(',', '\t');
+    std::string lineEnd = *gen::element(std::string("\n"), std::string("\r\n"));
+    
+    struct Record {
+        std::string name;
+        int64_t amount;
+        double price;
+        bool flag;
+        int64_t mixed;
+        bool whole;     ///< mixed is written as an integer, else with a fraction of .5
+    };
+    std::vector<Record> records;
+    for (int i = 0; i < numRows; ++i) {
+        // Long enough to cross the scanner's 16-byte blocks; never numeric
+        std::string name;
+        auto length = *gen::inRange(0, 40);
+        for (int c = 0; c < length; ++c) {
+            name.push_back(*gen::element('a', 'b', ' ', ',', '\t', '"', '\n', '\r'));
+        }
+        if (!name.empty()) name.insert(name.begin(), 'n');
+        records.push_back({name, *gen::arbitrary<int64_t>(),
+                           *gen::inRange(-100000, 100000) / 8.0 + 0.0625, *gen::arbitrary<bool>(),
+                           *gen::inRange<int64_t>(-1000, 1000), *gen::arbitrary<bool>()});
+    }
+    
+    auto field = [delimiter](const std::string& text) {
+        if (text.find_first_of(std::string("\"\r\n") + delimiter) == std::string::npos) return text;
+        std::string quoted = "\"";
+        for (char c : text) {
+            if (c == '"') quoted.push_back('"');
+            quoted.push_back(c);
+        }
+        return quoted + "\"";
+    };
+    auto number = [](double value) {
+        char buffer[64];
+        auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        return std::string(buffer, result.ptr);
+    };
     
-    // Verify hierarchy is preserved
-    auto afterCollapseIds = collectAllNodeIds(tree.getNodes());
-    size_t afterCollapseCount = countAllNodes(tree.getNodes());
+    std::string text = std::string("id") + delimiter + "name" + delimiter + "amount" + delimiter +
+                       "price" + delimiter + "flag" + delimiter + "mixed" + lineEnd;
+    for (size_t i = 0; i < records.size(); ++i) {
+        const auto& record = records[i];
+        text += "r" + std::to_string(i) + delimiter + field(record.name) + delimiter +
+                std::to_string(record.amount) + delimiter + number(record.price) + delimiter +
+                (record.flag ? "TRUE" : "false") + delimiter +
+                (record.whole ? std::to_string(record.mixed) : number(record.mixed + 0.5)) + lineEnd;
+    }
     
-    // All original IDs should still exist
-    RC_ASSERT(originalIds == afterCollapseIds);
+    auto path = std::filesystem::temp_directory_path() / "kgk_csv_property.csv";
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << text;
+    }
     
-    // Total node count should be unchanged
-    RC_ASSERT(originalCount == afterCollapseCount);
+    KillerGK::CsvLoadOptions options;
+    options.delimiter = delimiter;
+    options.idColumn = "id";
+    options.inferRows = static_cast<size_t>(*gen::inRange(1, 20));
+    options.chunkRows = static_cast<size_t>(*gen::inRange(1, 10));
+    options.maxQueuedChunks = static_cast<size_t>(*gen::inRange(1, 3));
     
-    // All root nodes should be collapsed
-    for (const auto& rootId : rootIds) {
-        RC_ASSERT(!tree.isExpanded(rootId));
+    KillerGK::DataGridCsvLoader loader;
+    RC_ASSERT(loader.open(path.string(), options));
+    
+    const auto& columns = loader.getColumns();
+    RC_ASSERT(columns.size() == 6u);
+    RC_ASSERT(columns[1].id == "name");
+    if (numRows > 0) {
+        RC_ASSERT(columns[2].type == KillerGK::ColumnType::Number);
+        RC_ASSERT(columns[3].type == KillerGK::ColumnType::Number);
+        RC_ASSERT(columns[4].type == KillerGK::ColumnType::Boolean);
+        RC_ASSERT(columns[5].type == KillerGK::ColumnType::Number);
+    }
+    
+    // Integers stay integers unless the column holds a fraction anywhere
+    bool anyFraction = std::any_of(records.begin(), records.end(),
+                                   [](const Record& record) { return !record.whole; });
+    
+    auto grid = KillerGK::DataGrid::create();
+    grid.columns(columns);
+    grid.sortBy("price", KillerGK::SortDirection::Ascending);
+    loader.appendTo(grid);
+    loader.finish(grid);
+    RC_ASSERT(loader.isFinished());
+    RC_ASSERT(loader.getRowsAppended() == records.size());
+    loader.close();
+    std::filesystem::remove(path);
+    
+    const auto& rows = grid.getRows();
+    RC_ASSERT(rows.size() == records.size());
+    for (size_t i = 0; i < rows.size(); ++i) {
+        const auto& record = records[i];
+        RC_ASSERT(rows[i].id == "r" + std::to_string(i));
+        if (record.name.empty()) {
+            RC_ASSERT(rows[i].cells.count("name") == 0u);
+        } else {
+            RC_ASSERT(std::get<std::string>(rows[i].getCell("name")) == record.name);
+        }
+        RC_ASSERT(std::get<int64_t>(rows[i].getCell("amount")) == record.amount);
+        RC_ASSERT(std::get<double>(rows[i].getCell("price")) == record.price);
+        RC_ASSERT(std::get<bool>(rows[i].getCell("flag")) == record.flag);
+        if (!anyFraction) {
+            RC_ASSERT(std::get<int64_t>(rows[i].getCell("mixed")) == record.mixed);
+        } else {
+            RC_ASSERT(std::get<double>(rows[i].getCell("mixed")) == record.mixed + (record.whole ? 0.0 : 0.5));
+        }
+    }
+    
+    // Chunks were merged into the sorted order as they arrived
+    auto displayed = grid.getDisplayedRows();
+    for (size_t i = 1; i < displayed.size(); ++i) {
+        RC_ASSERT(std::get<double>(displayed[i - 1].getCell("price")) <=
+                  std::get<double>(displayed[i].getCell("price")));
+    }
+    
+    // Whole and fractional values of the mixed column sort as one sequence
+    bool ascending = *gen::arbitrary<bool>();
+    grid.sortBy("mixed", ascending ? KillerGK::SortDirection::Ascending : KillerGK::SortDirection::Descending);
+    auto mixedValue = [](const KillerGK::DataGridRow& row) {
+        const auto& cell = row.getCell("mixed");
+        return std::holds_alternative<int64_t>(cell) ? static_cast<double>(std::get<int64_t>(cell))
+                                                     : std::get<double>(cell);
+    };
+    displayed = grid.getDisplayedRows();
+    RC_ASSERT(displayed.size() == records.size());
+    for (size_t i = 1; i < displayed.size(); ++i) {
+        double before = mixedValue(displayed[i - 1]);
+        double after = mixedValue(displayed[i]);
+        RC_ASSERT(ascending ? before <= after : before >= after);
+    }
+}
+
+
+// ============================================================================
+// Property Tests for TreeView Hierarchy Preservation
+// ============================================================================
+
+#include "KillerGK/widgets/TreeView.hpp"
+
+namespace rc {
+
+/**
+ * @brief Generator for valid TreeNode ID strings
+ */
+inline Gen<std::string> genTreeNodeId() {
+    return gen::map(gen::inRange(1, 100), [](int n) {
+        return "node_" + std::to_string(n);
+    });
+}
+
+/**
+ * @brief Generator for valid TreeNode text strings
+ */
+inline Gen<std::string> genTreeNodeText() {
+    return gen::element(
+        std::string("Root"),
+        std::string("Parent"),
+        std::string("Child"),
+        std::string("Leaf"),
+        std::string("Branch"),
+        std::string("Folder"),
+        std::string("File"),
+        std::string("Item")
+    );
+}
+
+/**
+ * @brief Generator for a single TreeNode without children
+ */
+inline Gen<KillerGK::TreeNode> genLeafTreeNode() {
+    return gen::map(
+        gen::tuple(genTreeNodeId(), genTreeNodeText()),
+        [](const std::tuple<std::string, std::string>& t) {
+            return KillerGK::TreeNode(std::get<0>(t), std::get<1>(t));
+        }
+    );
+}
+
+/**
+ * @brief Generator for a TreeNode with a specified number of children
+ */
+inline Gen<KillerGK::TreeNode> genTreeNodeWithChildren(int numChildren) {
+    return gen::exec([numChildren]() {
+        auto id = *genTreeNodeId();
+        auto text = *genTreeNodeText();
+        KillerGK::TreeNode node(id, text);
+        
+        for (int i = 0; i < numChildren; ++i) {
+            auto childId = id + "_child_" + std::to_string(i);
+            auto childText = *genTreeNodeText();
+            node.addChild(KillerGK::TreeNode(childId, childText));
+        }
+        
+        return node;
+    });
+}
+
+/**
+ * @brief Helper function to count total nodes in a tree (including root)
+ */
+inline size_t countNodes(const KillerGK::TreeNode& node) {
+    size_t count = 1;
+    for (const auto& child : node.children) {
+        count += countNodes(child);
+    }
+    return count;
+}
+
+/**
+ * @brief Helper function to count total nodes in a TreeView
+ */
+inline size_t countAllNodes(const std::vector<KillerGK::TreeNode>& nodes) {
+    size_t count = 0;
+    for (const auto& node : nodes) {
+        count += countNodes(node);
+    }
+    return count;
+}
+
+/**
+ * @brief Helper function to collect all node IDs from a tree
+ */
+inline void collectNodeIds(const KillerGK::TreeNode& node, std::set<std::string>& ids) {
+    ids.insert(node.id);
+    for (const auto& child : node.children) {
+        collectNodeIds(child, ids);
+    }
+}
+
+/**
+ * @brief Helper function to collect all node IDs from a TreeView
+ */
+inline std::set<std::string> collectAllNodeIds(const std::vector<KillerGK::TreeNode>& nodes) {
+    std::set<std::string> ids;
+    for (const auto& node : nodes) {
+        collectNodeIds(node, ids);
+    }
+    return ids;
+}
+
+/**
+ * @brief Helper function to verify parent-child relationships
+ */
+inline bool verifyParentChildRelationship(const KillerGK::TreeNode& parent, const std::string& childId) {
+    for (const auto& child : parent.children) {
+        if (child.id == childId) return true;
+        if (verifyParentChildRelationship(child, childId)) return true;
     }
+    return false;
 }
 
+} // namespace rc
+
 /**
  * **Feature: killergk-gui-library, Property 11: TreeView Hierarchy Preservation**
  * 
- * *For any* TreeView with any hierarchical data, selection operations 
+ * *For any* TreeView with any hierarchical data, expand/collapse operations 
  * SHALL preserve the parent-child relationships and data integrity.
  * 
  * This test verifies that:
- * 1. Selecting a node preserves all node IDs
- * 2. Selecting a node preserves total node count
- * 3. The selected node is correctly marked
+ * 1. Expanding a node preserves all node IDs in the tree
+ * 2. Expanding a node preserves the total node count
+ * 3. Parent-child relationships remain intact after expand
  * 
  * **Validates: Requirements 2.5**
  */
-RC_GTEST_PROP(TreeViewHierarchyProperties, SelectionPreservesHierarchy, ()) {
+RC_GTEST_PROP(TreeViewHierarchyProperties, ExpandPreservesHierarchy, ()) {
     // Generate a tree with 1-3 root nodes, each with 1-4 children
     auto numRoots = *gen::inRange(1, 4);
     std::vector<KillerGK::TreeNode> rootNodes;
@@ -6379,7 +7355,7 @@ RC_GTEST_PROP(TreeViewHierarchyProperties, SelectionPreservesHierarchy, ()) {
     for (int i = 0; i < numRoots; ++i) {
         auto numChildren = *gen::inRange(1, 5);
         auto node = *genTreeNodeWithChildren(numChildren);
-        node.id = "root_" + std::to_string(i);
+        node.id = "root_" + std::to_string(i);  // Ensure unique root IDs
         rootNodes.push_back(node);
     }
     
@@ -6391,118 +7367,105 @@ RC_GTEST_PROP(TreeViewHierarchyProperties, SelectionPreservesHierarchy, ()) {
     auto originalIds = collectAllNodeIds(tree.getNodes());
     size_t originalCount = countAllNodes(tree.getNodes());
     
-    // Select a random root
-    auto selectIndex = *gen::inRange(0, numRoots);
-    std::string nodeToSelect = "root_" + std::to_string(selectIndex);
+    // Select a random root to expand
+    auto expandIndex = *gen::inRange(0, numRoots);
+    std::string nodeToExpand = "root_" + std::to_string(expandIndex);
     
-    // Select the node
-    tree.select(nodeToSelect);
+    // Expand the node
+    tree.expand(nodeToExpand);
     
     // Verify hierarchy is preserved
-    auto afterSelectIds = collectAllNodeIds(tree.getNodes());
-    size_t afterSelectCount = countAllNodes(tree.getNodes());
+    auto afterExpandIds = collectAllNodeIds(tree.getNodes());
+    size_t afterExpandCount = countAllNodes(tree.getNodes());
     
     // All original IDs should still exist
-    RC_ASSERT(originalIds == afterSelectIds);
+    RC_ASSERT(originalIds == afterExpandIds);
     
     // Total node count should be unchanged
-    RC_ASSERT(originalCount == afterSelectCount);
+    RC_ASSERT(originalCount == afterExpandCount);
     
-    // The selected node should be in the selection
-    auto selectedIds = tree.getSelectedIds();
-    RC_ASSERT(std::find(selectedIds.begin(), selectedIds.end(), nodeToSelect) != selectedIds.end());
+    // The expanded node should be marked as expanded
+    RC_ASSERT(tree.isExpanded(nodeToExpand));
 }
 
 /**
  * **Feature: killergk-gui-library, Property 11: TreeView Hierarchy Preservation**
  * 
- * *For any* TreeView with any hierarchical data, moveNode operations 
- * SHALL preserve the total node count (no nodes lost or duplicated).
+ * *For any* TreeView with any hierarchical data, expand/collapse operations 
+ * SHALL preserve the parent-child relationships and data integrity.
  * 
  * This test verifies that:
- * 1. Moving a node preserves total node count
- * 2. The moved node exists in its new location
- * 3. The moved node no longer exists in its old location
+ * 1. Collapsing a node preserves all node IDs in the tree
+ * 2. Collapsing a node preserves the total node count
+ * 3. Parent-child relationships remain intact after collapse
  * 
  * **Validates: Requirements 2.5**
  */
-RC_GTEST_PROP(TreeViewHierarchyProperties, MoveNodePreservesNodeCount, ()) {
-    // Create a tree with 2 root nodes, each with 2 children
+RC_GTEST_PROP(TreeViewHierarchyProperties, CollapsePreservesHierarchy, ()) {
+    // Generate a tree with 1-3 root nodes, each with 1-4 children
+    auto numRoots = *gen::inRange(1, 4);
     std::vector<KillerGK::TreeNode> rootNodes;
     
-    KillerGK::TreeNode root1("root_0", "Root 0");
-    root1.addChild(KillerGK::TreeNode("root_0_child_0", "Child 0"));
-    root1.addChild(KillerGK::TreeNode("root_0_child_1", "Child 1"));
-    rootNodes.push_back(root1);
-    
-    KillerGK::TreeNode root2("root_1", "Root 1");
-    root2.addChild(KillerGK::TreeNode("root_1_child_0", "Child 0"));
-    root2.addChild(KillerGK::TreeNode("root_1_child_1", "Child 1"));
-    rootNodes.push_back(root2);
+    for (int i = 0; i < numRoots; ++i) {
+        auto numChildren = *gen::inRange(1, 5);
+        auto node = *genTreeNodeWithChildren(numChildren);
+        node.id = "root_" + std::to_string(i);
+        node.expanded = true;  // Start expanded
+        rootNodes.push_back(node);
+    }
     
     // Create TreeView and add nodes
     auto tree = KillerGK::TreeView::create();
     tree.nodes(rootNodes);
     
-    // Count original nodes
+    // Collect original state
+    auto originalIds = collectAllNodeIds(tree.getNodes());
     size_t originalCount = countAllNodes(tree.getNodes());
     
-    // Move a child from root_0 to root_1
-    tree.moveNode("root_0_child_0", "root_1");
+    // Select a random root to collapse
+    auto collapseIndex = *gen::inRange(0, numRoots);
+    std::string nodeToCollapse = "root_" + std::to_string(collapseIndex);
     
-    // Count nodes after move
-    size_t afterMoveCount = countAllNodes(tree.getNodes());
+    // Collapse the node
+    tree.collapse(nodeToCollapse);
     
-    // Total node count should be unchanged
-    RC_ASSERT(originalCount == afterMoveCount);
+    // Verify hierarchy is preserved
+    auto afterCollapseIds = collectAllNodeIds(tree.getNodes());
+    size_t afterCollapseCount = countAllNodes(tree.getNodes());
     
-    // The moved node should exist under root_1
-    auto* root1After = tree.findNode("root_1");
-    RC_ASSERT(root1After != nullptr);
-    bool foundInNewParent = false;
-    for (const auto& child : root1After->children) {
-        if (child.id == "root_0_child_0") {
-            foundInNewParent = true;
-            break;
-        }
-    }
-    RC_ASSERT(foundInNewParent);
+    // All original IDs should still exist
+    RC_ASSERT(originalIds == afterCollapseIds);
     
-    // The moved node should not exist under root_0
-    auto* root0After = tree.findNode("root_0");
-    RC_ASSERT(root0After != nullptr);
-    bool foundInOldParent = false;
-    for (const auto& child : root0After->children) {
-        if (child.id == "root_0_child_0") {
-            foundInOldParent = true;
-            break;
-        }
-    }
-    RC_ASSERT(!foundInOldParent);
+    // Total node count should be unchanged
+    RC_ASSERT(originalCount == afterCollapseCount);
+    
+    // The collapsed node should be marked as collapsed
+    RC_ASSERT(!tree.isExpanded(nodeToCollapse));
 }
 
 /**
  * **Feature: killergk-gui-library, Property 11: TreeView Hierarchy Preservation**
  * 
- * *For any* TreeView with any hierarchical data, removeNode operations 
- * SHALL correctly remove the node and its descendants.
+ * *For any* TreeView with any hierarchical data, expand/collapse operations 
+ * SHALL preserve the parent-child relationships and data integrity.
  * 
  * This test verifies that:
- * 1. Removing a node decreases the total count appropriately
- * 2. The removed node no longer exists in the tree
- * 3. Other nodes remain intact
+ * 1. Toggle operation preserves all node IDs
+ * 2. Toggle operation preserves total node count
+ * 3. Toggle changes the expanded state correctly
  * 
  * **Validates: Requirements 2.5**
  */
-RC_GTEST_PROP(TreeViewHierarchyProperties, RemoveNodeUpdatesHierarchy, ()) {
-    // Generate a tree with 2-4 root nodes, each with 1-3 children
-    auto numRoots = *gen::inRange(2, 5);
+RC_GTEST_PROP(TreeViewHierarchyProperties, TogglePreservesHierarchy, ()) {
+    // Generate a tree with 1-3 root nodes, each with 1-4 children
+    auto numRoots = *gen::inRange(1, 4);
     std::vector<KillerGK::TreeNode> rootNodes;
     
     for (int i = 0; i < numRoots; ++i) {
-        auto numChildren = *gen::inRange(1, 4);
+        auto numChildren = *gen::inRange(1, 5);
         auto node = *genTreeNodeWithChildren(numChildren);
         node.id = "root_" + std::to_string(i);
+        node.expanded = *gen::arbitrary<bool>();  // Random initial state
         rootNodes.push_back(node);
     }
     
@@ -6514,55 +7477,57 @@ RC_GTEST_PROP(TreeViewHierarchyProperties, RemoveNodeUpdatesHierarchy, ()) {
     auto originalIds = collectAllNodeIds(tree.getNodes());
     size_t originalCount = countAllNodes(tree.getNodes());
     
-    // Select a random root to remove
-    auto removeIndex = *gen::inRange(0, numRoots);
-    std::string nodeToRemove = "root_" + std::to_string(removeIndex);
+    // Select a random root to toggle
+    auto toggleIndex = *gen::inRange(0, numRoots);
+    std::string nodeToToggle = "root_" + std::to_string(toggleIndex);
     
-    // Count nodes in the subtree being removed
-    auto* nodePtr = tree.findNode(nodeToRemove);
-    RC_PRE(nodePtr != nullptr);
-    size_t removedCount = countNodes(*nodePtr);
+    // Get initial expanded state
+    bool wasExpanded = tree.isExpanded(nodeToToggle);
     
-    // Remove the node
-    tree.removeNode(nodeToRemove);
+    // Toggle the node
+    tree.toggle(nodeToToggle);
     
-    // Verify the node is removed
-    RC_ASSERT(tree.findNode(nodeToRemove) == nullptr);
+    // Verify hierarchy is preserved
+    auto afterToggleIds = collectAllNodeIds(tree.getNodes());
+    size_t afterToggleCount = countAllNodes(tree.getNodes());
     
-    // Verify node count decreased correctly
-    size_t afterRemoveCount = countAllNodes(tree.getNodes());
-    RC_ASSERT(afterRemoveCount == originalCount - removedCount);
+    // All original IDs should still exist
+    RC_ASSERT(originalIds == afterToggleIds);
     
-    // Verify other nodes still exist
-    auto afterRemoveIds = collectAllNodeIds(tree.getNodes());
-    for (const auto& id : afterRemoveIds) {
-        RC_ASSERT(originalIds.count(id) > 0);
-    }
+    // Total node count should be unchanged
+    RC_ASSERT(originalCount == afterToggleCount);
+    
+    // The expanded state should be toggled
+    RC_ASSERT(tree.isExpanded(nodeToToggle) == !wasExpanded);
 }
 
 /**
  * **Feature: killergk-gui-library, Property 11: TreeView Hierarchy Preservation**
  * 
- * *For any* TreeView with any hierarchical data, recursive expand operations 
- * SHALL preserve the parent-child relationships and expand all descendants.
+ * *For any* TreeView with any hierarchical data, expand/collapse operations 
+ * SHALL preserve the parent-child relationships and data integrity.
  * 
  * This test verifies that:
- * 1. Recursive expand preserves all node IDs
- * 2. Recursive expand preserves total node count
- * 3. All descendants are expanded
+ * 1. ExpandAll preserves all node IDs
+ * 2. ExpandAll preserves total node count
+ * 3. All nodes are expanded after ExpandAll
  * 
  * **Validates: Requirements 2.5**
  */
-RC_GTEST_PROP(TreeViewHierarchyProperties, RecursiveExpandPreservesHierarchy, ()) {
-    // Create a tree with nested structure
-    KillerGK::TreeNode root("root", "Root");
-    KillerGK::TreeNode child1("child1", "Child 1");
-    child1.addChild(KillerGK::TreeNode("grandchild1", "Grandchild 1"));
-    child1.addChild(KillerGK::TreeNode("grandchild2", "Grandchild 2"));
-    root.addChild(child1);
-    root.addChild(KillerGK::TreeNode("child2", "Child 2"));
+RC_GTEST_PROP(TreeViewHierarchyProperties, ExpandAllPreservesHierarchy, ()) {
+    // Generate a tree with 1-3 root nodes, each with 1-4 children
+    auto numRoots = *gen::inRange(1, 4);
+    std::vector<KillerGK::TreeNode> rootNodes;
+    std::vector<std::string> rootIds;
     
-    std::vector<KillerGK::TreeNode> rootNodes = {root};
+    for (int i = 0; i < numRoots; ++i) {
+        auto numChildren = *gen::inRange(1, 5);
+        auto node = *genTreeNodeWithChildren(numChildren);
+        node.id = "root_" + std::to_string(i);
+        node.expanded = false;  // Start collapsed
+        rootIds.push_back(node.id);
+        rootNodes.push_back(node);
+    }
     
     // Create TreeView and add nodes
     auto tree = KillerGK::TreeView::create();
@@ -6572,8 +7537,8 @@ RC_GTEST_PROP(TreeViewHierarchyProperties, RecursiveExpandPreservesHierarchy, ()
     auto originalIds = collectAllNodeIds(tree.getNodes());
     size_t originalCount = countAllNodes(tree.getNodes());
     
-    // Expand root recursively
-    tree.expand("root", true);
+    // Expand all nodes
+    tree.expandAll();
     
     // Verify hierarchy is preserved
     auto afterExpandIds = collectAllNodeIds(tree.getNodes());
@@ -6585,8 +7550,2196 @@ RC_GTEST_PROP(TreeViewHierarchyProperties, RecursiveExpandPreservesHierarchy, ()
     // Total node count should be unchanged
     RC_ASSERT(originalCount == afterExpandCount);
     
-    // Root should be expanded
-    RC_ASSERT(tree.isExpanded("root"));
+    // All root nodes should be expanded
+    for (const auto& rootId : rootIds) {
+        RC_ASSERT(tree.isExpanded(rootId));
+    }
+}
+
+/**
+ * **Feature: killergk-gui-library, Property 11: TreeView Hierarchy Preservation**
+ * 
+ * *For any* TreeView with any hierarchical data, expand/collapse operations 
+ * SHALL preserve the parent-child relationships and data integrity.
+ * 
+ * This test verifies that:
+ * 1. CollapseAll preserves all node IDs
+ * 2. CollapseAll preserves total node count
+ * 3. All nodes are collapsed after CollapseAll
+ * 
+ * **Validates: Requirements 2.5**
+ */
+RC_GTEST_PROP(TreeViewHierarchyProperties, CollapseAllPreservesHierarchy, ()) {
+    // Generate a tree with 1-3 root nodes, each with 1-4 children
+    auto numRoots = *gen::inRange(1, 4);
+    std::vector<KillerGK::TreeNode> rootNodes;
+    std::vector<std::string> rootIds;
+    
+    for (int i = 0; i < numRoots; ++i) {
+        auto numChildren = *gen::inRange(1, 5);
+        auto node = *genTreeNodeWithChildren(numChildren);
+        node.id = "root_" + std::to_string(i);
+        node.expanded = true;  // Start expanded
+        rootIds.push_back(node.id);
+        rootNodes.push_back(node);
+    }
+    
+    // Create TreeView and add nodes
+    auto tree = KillerGK::TreeView::create();
+    tree.nodes(rootNodes);
+    
+    // Collect original state
+    auto originalIds = collectAllNodeIds(tree.getNodes());
+    size_t originalCount = countAllNodes(tree.getNodes());
+    
+    // Collapse all nodes
+    tree.collapseAll();
+    
+    // Verify hierarchy is preserved
+    auto afterCollapseIds = collectAllNodeIds(tree.getNodes());
+    size_t afterCollapseCount = countAllNodes(tree.getNodes());
+    
+    // All original IDs should still exist
+    RC_ASSERT(originalIds == afterCollapseIds);
+    
+    // Total node count should be unchanged
+    RC_ASSERT(originalCount == afterCollapseCount);
+    
+    // All root nodes should be collapsed
+    for (const auto& rootId : rootIds) {
+        RC_ASSERT(!tree.isExpanded(rootId));
+    }
+}
+
+/**
+ * **Feature: killergk-gui-library, Property 11: TreeView Hierarchy Preservation**
+ * 
+ * *For any* TreeView with any hierarchical data, selection operations 
+ * SHALL preserve the parent-child relationships and data integrity.
+ * 
+ * This test verifies that:
+ * 1. Selecting a node preserves all node IDs
+ * 2. Selecting a node preserves total node count
+ * 3. The selected node is correctly marked
+ * 
+ * **Validates: Requirements 2.5**
+ */
+RC_GTEST_PROP(TreeViewHierarchyProperties, SelectionPreservesHierarchy, ()) {
+    // Generate a tree with 1-3 root nodes, each with 1-4 children
+    auto numRoots = *gen::inRange(1, 4);
+    std::vector<KillerGK::TreeNode> rootNodes;
+    
+    for (int i = 0; i < numRoots; ++i) {
+        auto numChildren = *gen::inRange(1, 5);
+        auto node = *genTreeNodeWithChildren(numChildren);
+        node.id = "root_" + std::to_string(i);
+        rootNodes.push_back(node);
+    }
+    
+    // Create TreeView and add nodes
+    auto tree = KillerGK::TreeView::create();
+    tree.nodes(rootNodes);
+    
+    // Collect original state
+    auto originalIds = collectAllNodeIds(tree.getNodes());
+    size_t originalCount = countAllNodes(tree.getNodes());
+    
+    // Select a random root
+    auto selectIndex = *gen::inRange(0, numRoots);
+    std::string nodeToSelect = "root_" + std::to_string(selectIndex);
+    
+    // Select the node
+    tree.select(nodeToSelect);
+    
+    // Verify hierarchy is preserved
+    auto afterSelectIds = collectAllNodeIds(tree.getNodes());
+    size_t afterSelectCount = countAllNodes(tree.getNodes());
+    
+    // All original IDs should still exist
+    RC_ASSERT(originalIds == afterSelectIds);
+    
+    // Total node count should be unchanged
+    RC_ASSERT(originalCount == afterSelectCount);
+    
+    // The selected node should be in the selection
+    auto selectedIds = tree.getSelectedIds();
+    RC_ASSERT(std::find(selectedIds.begin(), selectedIds.end(), nodeToSelect) != selectedIds.end());
+}
+
+/**
+ * **Feature: killergk-gui-library, Property 11: TreeView Hierarchy Preservation**
+ * 
+ * *For any* TreeView with any hierarchical data, moveNode operations 
+ * SHALL preserve the total node count (no nodes lost or duplicated).
+ * 
+ * This test verifies that:
+ * 1. Moving a node preserves total node count
+ * 2. The moved node exists in its new location
+ * 3. The moved node no longer exists in its old location
+ * 
+ * **Validates: Requirements 2.5**
+ */
+RC_GTEST_PROP(TreeViewHierarchyProperties, MoveNodePreservesNodeCount, ()) {
+    // Create a tree with 2 root nodes, each with 2 children
+    std::vector<KillerGK::TreeNode> rootNodes;
+    
+    KillerGK::TreeNode root1("root_0", "Root 0");
+    root1.addChild(KillerGK::TreeNode("root_0_child_0", "Child 0"));
+    root1.addChild(KillerGK::TreeNode("root_0_child_1", "Child 1"));
+    rootNodes.push_back(root1);
+    
+    KillerGK::TreeNode root2("root_1", "Root 1");
+    root2.addChild(KillerGK::TreeNode("root_1_child_0", "Child 0"));
+    root2.addChild(KillerGK::TreeNode("root_1_child_1", "Child 1"));
+    rootNodes.push_back(root2);
+    
+    // Create TreeView and add nodes
+    auto tree = KillerGK::TreeView::create();
+    tree.nodes(rootNodes);
+    
+    // Count original nodes
+    size_t originalCount = countAllNodes(tree.getNodes());
+    
+    // Move a child from root_0 to root_1
+    tree.moveNode("root_0_child_0", "root_1");
+    
+    // Count nodes after move
+    size_t afterMoveCount = countAllNodes(tree.getNodes());
+    
+    // Total node count should be unchanged
+    RC_ASSERT(originalCount == afterMoveCount);
+    
+    // The moved node should exist under root_1
+    auto* root1After = tree.findNode("root_1");
+    RC_ASSERT(root1After != nullptr);
+    bool foundInNewParent = false;
+    for (const auto& child : root1After->children) {
+        if (child.id == "root_0_child_0") {
+            foundInNewParent = true;
+            break;
+        }
+    }
+    RC_ASSERT(foundInNewParent);
+    
+    // The moved node should not exist under root_0
+    auto* root0After = tree.findNode("root_0");
+    RC_ASSERT(root0After != nullptr);
+    bool foundInOldParent = false;
+    for (const auto& child : root0After->children) {
+        if (child.id == "root_0_child_0") {
+            foundInOldParent = true;
+            break;
+        }
+    }
+    RC_ASSERT(!foundInOldParent);
+}
+
+/**
+ * **Feature: killergk-gui-library, Property 11: TreeView Hierarchy Preservation**
+ * 
+ * *For any* TreeView with any hierarchical data, removeNode operations 
+ * SHALL correctly remove the node and its descendants.
+ * 
+ * This test verifies that:
+ * 1. Removing a node decreases the total count appropriately
+ * 2. The removed node no longer exists in the tree
+ * 3. Other nodes remain intact
+ * 
+ * **Validates: Requirements 2.5**
+ */
+RC_GTEST_PROP(TreeViewHierarchyProperties, RemoveNodeUpdatesHierarchy, ()) {
+    // Generate a tree with 2-4 root nodes, each with 1-3 children
+    auto numRoots = *gen::inRange(2, 5);
+    std::vector<KillerGK::TreeNode> rootNodes;
+    
+    for (int i = 0; i < numRoots; ++i) {
+        auto numChildren = *gen::inRange(1, 4);
+        auto node = *genTreeNodeWithChildren(numChildren);
+        node.id = "root_" + std::to_string(i);
+        rootNodes.push_back(node);
+    }
+    
+    // Create TreeView and add nodes
+    auto tree = KillerGK::TreeView::create();
+    tree.nodes(rootNodes);
+    
+    // Collect original state
+    auto originalIds = collectAllNodeIds(tree.getNodes());
+    size_t originalCount = countAllNodes(tree.getNodes());
+    
+    // Select a random root to remove
+    auto removeIndex = *gen::inRange(0, numRoots);
+    std::string nodeToRemove = "root_" + std::to_string(removeIndex);
+    
+    // Count nodes in the subtree being removed
+    auto* nodePtr = tree.findNode(nodeToRemove);
+    RC_PRE(nodePtr != nullptr);
+    size_t removedCount = countNodes(*nodePtr);
+    
+    // Remove the node
+    tree.removeNode(nodeToRemove);
+    
+    // Verify the node is removed
+    RC_ASSERT(tree.findNode(nodeToRemove) == nullptr);
+    
+    // Verify node count decreased correctly
+    size_t afterRemoveCount = countAllNodes(tree.getNodes());
+    RC_ASSERT(afterRemoveCount == originalCount - removedCount);
+    
+    // Verify other nodes still exist
+    auto afterRemoveIds = collectAllNodeIds(tree.getNodes());
+    for (const auto& id : afterRemoveIds) {
+        RC_ASSERT(originalIds.count(id) > 0);
+    }
+}
+
+/**
+ * **Feature: killergk-gui-library, Property 11: TreeView Hierarchy Preservation**
+ * 
+ * *For any* TreeView with any hierarchical data, recursive expand operations 
+ * SHALL preserve the parent-child relationships and expand all descendants.
+ * 
+ * This test verifies that:
+ * 1. Recursive expand preserves all node IDs
+ * 2. Recursive expand preserves total node count
+ * 3. All descendants are expanded
+ * 
+ * **Validates: Requirements 2.5**
+ */
+RC_GTEST_PROP(TreeViewHierarchyProperties, RecursiveExpandPreservesHierarchy, ()) {
+    // Create a tree with nested structure
+    KillerGK::TreeNode root("root", "Root");
+    KillerGK::TreeNode child1("child1", "Child 1");
+    child1.addChild(KillerGK::TreeNode("grandchild1", "Grandchild 1"));
+    child1.addChild(KillerGK::TreeNode("grandchild2", "Grandchild 2"));
+    root.addChild(child1);
+    root.addChild(KillerGK::TreeNode("child2", "Child 2"));
+    
+    std::vector<KillerGK::TreeNode> rootNodes = {root};
+    
+    // Create TreeView and add nodes
+    auto tree = KillerGK::TreeView::create();
+    tree.nodes(rootNodes);
+    
+    // Collect original state
+    auto originalIds = collectAllNodeIds(tree.getNodes());
+    size_t originalCount = countAllNodes(tree.getNodes());
+    
+    // Expand root recursively
+    tree.expand("root", true);
+    
+    // Verify hierarchy is preserved
+    auto afterExpandIds = collectAllNodeIds(tree.getNodes());
+    size_t afterExpandCount = countAllNodes(tree.getNodes());
+    
+    // All original IDs should still exist
+    RC_ASSERT(originalIds == afterExpandIds);
+    
+    // Total node count should be unchanged
+    RC_ASSERT(originalCount == afterExpandCount);
+    
+    // Root should be expanded
+    RC_ASSERT(tree.isExpanded("root"));
+}
+
+/**
+ * @brief Preorder search, as TreeView did before nodes were indexed
+ */
+static KillerGK::TreeNode* referenceFindNode(std::vector<KillerGK::TreeNode>& nodes, const std::string& id,
+                                             KillerGK::TreeNode** parent = nullptr,
+                                             KillerGK::TreeNode* owner = nullptr) {
+    for (auto& node : nodes) {
+        if (node.id == id) {
+            if (parent) *parent = owner;
+            return &node;
+        }
+        if (auto* found = referenceFindNode(node.children, id, parent, &node)) return found;
+    }
+    return nullptr;
+}
+
+static bool sameStructure(const std::vector<KillerGK::TreeNode>& a, const std::vector<KillerGK::TreeNode>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].id != b[i].id || a[i].selected != b[i].selected || !sameStructure(a[i].children, b[i].children)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * **Feature: killergk-gui-library, Property 11: TreeView Hierarchy Preservation**
+ * 
+ * *For any* sequence of node additions, removals, moves, selections and
+ * edits made directly through node pointers, the tree SHALL match a nested
+ * reference model, and indexed lookups (findNode, getParent,
+ * getSelectedNodes) SHALL return the same nodes as searching the tree.
+ * 
+ * **Validates: Requirements 2.5**
+ */
+RC_GTEST_PROP(TreeViewHierarchyProperties, IndexedLookupsMatchReference, ()) {
+    int nextId = 0;
+    std::vector<std::string> ids;
+    auto makeNode = [&nextId, &ids]() {
+        KillerGK::TreeNode node("n_" + std::to_string(nextId++), *genTreeNodeText());
+        ids.push_back(node.id);
+        return node;
+    };
+    std::function<KillerGK::TreeNode(int)> makeSubtree = [&](int depth) {
+        auto node = makeNode();
+        auto numChildren = depth > 0 ? *gen::inRange(0, 4) : 0;
+        for (int i = 0; i < numChildren; ++i) {
+            node.addChild(makeSubtree(depth - 1));
+        }
+        return node;
+    };
+    
+    std::vector<KillerGK::TreeNode> model;
+    auto numRoots = *gen::inRange(0, 4);
+    for (int i = 0; i < numRoots; ++i) {
+        model.push_back(makeSubtree(3));
+    }
+    
+    auto tree = KillerGK::TreeView::create();
+    tree.multiSelect(true);
+    tree.nodes(model);
+    std::vector<std::string> selected;
+    
+    auto numSteps = *gen::inRange(1, 30);
+    for (int step = 0; step < numSteps; ++step) {
+        auto pickId = [&ids]() {
+            return ids[static_cast<size_t>(*gen::inRange(0, static_cast<int>(ids.size())))];
+        };
+        
+        switch (ids.empty() ? 0 : *gen::inRange(0, 8)) {
+            case 0: {
+                auto node = makeSubtree(2);
+                tree.addNode(node);
+                model.push_back(node);
+                break;
+            }
+            case 1: {
+                auto id = pickId();
+                tree.removeNode(id);
+                KillerGK::TreeNode* parent = nullptr;
+                if (auto* node = referenceFindNode(model, id, &parent)) {
+                    std::set<std::string> removed;
+                    collectNodeIds(*node, removed);
+                    auto& siblings = parent ? parent->children : model;
+                    siblings.erase(siblings.begin() + (node - siblings.data()));
+                    selected.erase(std::remove_if(selected.begin(), selected.end(),
+                        [&removed](const std::string& s) { return removed.count(s) > 0; }), selected.end());
+                }
+                break;
+            }
+            case 2: {
+                auto id = pickId();
+                auto newParentId = *gen::arbitrary<bool>() ? std::string() : pickId();
+                auto index = *gen::inRange(-1, 4);
+                tree.moveNode(id, newParentId, index);
+                
+                KillerGK::TreeNode* parent = nullptr;
+                auto* node = referenceFindNode(model, id, &parent);
+                auto* target = newParentId.empty() ? nullptr : referenceFindNode(model, newParentId);
+                bool intoSelf = node && target && (node == target || referenceFindNode(node->children, newParentId));
+                if (!node || (!newParentId.empty() && !target) || intoSelf) break;
+                
+                auto copy = *node;
+                auto& from = parent ? parent->children : model;
+                from.erase(from.begin() + (node - from.data()));
+                auto& to = newParentId.empty() ? model : referenceFindNode(model, newParentId)->children;
+                auto position = index < 0 ? to.size() : std::min(to.size(), static_cast<size_t>(index));
+                to.insert(to.begin() + static_cast<std::ptrdiff_t>(position), copy);
+                break;
+            }
+            case 3: {
+                auto id = pickId();
+                bool add = *gen::arbitrary<bool>();
+                tree.select(id, add);
+                if (!add) {
+                    for (const auto& s : selected) {
+                        if (auto* node = referenceFindNode(model, s)) node->selected = false;
+                    }
+                    selected.clear();
+                }
+                if (auto* node = referenceFindNode(model, id)) {
+                    node->selected = true;
+                    if (std::find(selected.begin(), selected.end(), id) == selected.end()) selected.push_back(id);
+                }
+                break;
+            }
+            case 4: {
+                auto id = pickId();
+                tree.deselect(id);
+                if (auto* node = referenceFindNode(model, id)) {
+                    node->selected = false;
+                    selected.erase(std::remove(selected.begin(), selected.end(), id), selected.end());
+                }
+                break;
+            }
+            case 5: {  // Add a child through a node pointer
+                auto id = pickId();
+                auto child = makeNode();
+                if (auto* node = tree.findNode(id)) {
+                    node->children.insert(node->children.begin(), child);
+                    referenceFindNode(model, id)->children.insert(
+                        referenceFindNode(model, id)->children.begin(), child);
+                }
+                break;
+            }
+            case 6:  // Drop a root through the node vector
+                if (!tree.getNodes().empty()) {
+                    std::set<std::string> removed;
+                    collectNodeIds(model.front(), removed);
+                    tree.getNodes().erase(tree.getNodes().begin());
+                    model.erase(model.begin());
+                    selected.erase(std::remove_if(selected.begin(), selected.end(),
+                        [&removed](const std::string& s) { return removed.count(s) > 0; }), selected.end());
+                }
+                break;
+            default:
+                tree.clearSelection();
+                for (const auto& s : selected) {
+                    if (auto* node = referenceFindNode(model, s)) node->selected = false;
+                }
+                selected.clear();
+                break;
+        }
+        
+        const auto& view = tree;
+        RC_ASSERT(sameStructure(view.getNodes(), model));
+        
+        auto& nodes = tree.getNodes();
+        for (const auto& id : ids) {
+            KillerGK::TreeNode* parent = nullptr;
+            auto* expected = referenceFindNode(nodes, id, &parent);
+            RC_ASSERT(view.findNode(id) == expected);
+            RC_ASSERT(tree.findNode(id) == expected);
+            if (expected) RC_ASSERT(tree.getParent(id) == parent);
+        }
+        RC_ASSERT(tree.findNode("missing") == nullptr);
+        
+        for (const auto* node : view.getSelectedNodes()) {
+            RC_ASSERT(node == referenceFindNode(nodes, node->id));
+            RC_ASSERT(node->selected);
+        }
+    }
+}
+
+/**
+ * @brief Displayed rows as (id, depth), by walking the expanded nodes
+ */
+static void referenceRows(const std::vector<KillerGK::TreeNode>& nodes, int depth,
+                          std::vector<std::pair<std::string, int>>& out) {
+    for (const auto& node : nodes) {
+        out.emplace_back(node.id, depth);
+        if (node.expanded) referenceRows(node.children, depth + 1, out);
+    }
+}
+
+/**
+ * @brief Deterministic lazy children: a few per node, pending down to a bounded depth
+ */
+static std::vector<KillerGK::TreeNode> loadTestChildren(const KillerGK::TreeNode& node) {
+    std::vector<KillerGK::TreeNode> children;
+    size_t count = std::hash<std::string>{}(node.id) % 4;
+    for (size_t i = 0; i < count; ++i) {
+        KillerGK::TreeNode child(node.id + "." + std::to_string(i), "Loaded");
+        child.childrenPending = node.id.size() < 12;
+        children.push_back(child);
+    }
+    return children;
+}
+
+/**
+ * **Feature: killergk-gui-library, Property 11: TreeView Hierarchy Preservation**
+ * 
+ * *For any* sequence of expands, collapses, lazy child loads, additions,
+ * removals and moves, the displayed rows SHALL be exactly the nodes whose
+ * ancestors are all expanded, in preorder with their depths, and each
+ * node's row index SHALL match its position in that list.
+ * 
+ * **Validates: Requirements 2.5**
+ */
+RC_GTEST_PROP(TreeViewHierarchyProperties, RowsMatchExpandedNodes, ()) {
+    int nextId = 0;
+    std::vector<std::string> ids;
+    std::function<KillerGK::TreeNode(int)> makeSubtree = [&](int depth) {
+        KillerGK::TreeNode node("n_" + std::to_string(nextId++), "Node");
+        ids.push_back(node.id);
+        node.expanded = *gen::arbitrary<bool>();
+        auto numChildren = depth > 0 ? *gen::inRange(0, 4) : 0;
+        for (int i = 0; i < numChildren; ++i) {
+            node.addChild(makeSubtree(depth - 1));
+        }
+        node.childrenPending = numChildren == 0 && *gen::arbitrary<bool>();
+        return node;
+    };
+    
+    std::function<void(std::vector<KillerGK::TreeNode>&, bool)> setExpanded =
+        [&](std::vector<KillerGK::TreeNode>& nodes, bool expanded) {
+            for (auto& node : nodes) {
+                node.expanded = expanded && !node.childrenPending;
+                setExpanded(node.children, expanded);
+            }
+        };
+    auto expandModel = [&](KillerGK::TreeNode& node, bool recursive) {
+        if (node.childrenPending) {
+            for (const auto& child : loadTestChildren(node)) {
+                node.children.push_back(child);
+                ids.push_back(child.id);
+            }
+            node.childrenPending = false;
+        }
+        node.expanded = true;
+        if (recursive) setExpanded(node.children, true);
+    };
+    
+    std::vector<KillerGK::TreeNode> model;
+    auto numRoots = *gen::inRange(0, 4);
+    for (int i = 0; i < numRoots; ++i) {
+        model.push_back(makeSubtree(3));
+    }
+    
+    auto tree = KillerGK::TreeView::create();
+    tree.childLoader(loadTestChildren);
+    tree.nodes(model);
+    
+    auto numSteps = *gen::inRange(1, 30);
+    for (int step = 0; step < numSteps; ++step) {
+        auto pickId = [&ids]() {
+            return ids[static_cast<size_t>(*gen::inRange(0, static_cast<int>(ids.size())))];
+        };
+        
+        switch (ids.empty() ? 0 : *gen::inRange(0, 9)) {
+            case 0: {
+                auto node = makeSubtree(2);
+                tree.addNode(node);
+                model.push_back(node);
+                break;
+            }
+            case 1: {
+                auto id = pickId();
+                tree.removeNode(id);
+                KillerGK::TreeNode* parent = nullptr;
+                if (auto* node = referenceFindNode(model, id, &parent)) {
+                    auto& siblings = parent ? parent->children : model;
+                    siblings.erase(siblings.begin() + (node - siblings.data()));
+                }
+                break;
+            }
+            case 2: {
+                auto id = pickId();
+                auto newParentId = *gen::arbitrary<bool>() ? std::string() : pickId();
+                auto index = *gen::inRange(-1, 4);
+                tree.moveNode(id, newParentId, index);
+                
+                KillerGK::TreeNode* parent = nullptr;
+                auto* node = referenceFindNode(model, id, &parent);
+                auto* target = newParentId.empty() ? nullptr : referenceFindNode(model, newParentId);
+                bool intoSelf = node && target && (node == target || referenceFindNode(node->children, newParentId));
+                if (!node || (!newParentId.empty() && !target) || intoSelf) break;
+                
+                auto copy = *node;
+                auto& from = parent ? parent->children : model;
+                from.erase(from.begin() + (node - from.data()));
+                auto& to = newParentId.empty() ? model : referenceFindNode(model, newParentId)->children;
+                auto position = index < 0 ? to.size() : std::min(to.size(), static_cast<size_t>(index));
+                to.insert(to.begin() + static_cast<std::ptrdiff_t>(position), copy);
+                break;
+            }
+            case 3:
+            case 4: {
+                auto id = pickId();
+                bool recursive = *gen::inRange(0, 4) == 0;
+                tree.expand(id, recursive);
+                if (auto* node = referenceFindNode(model, id)) expandModel(*node, recursive);
+                break;
+            }
+            case 5: {
+                auto id = pickId();
+                bool recursive = *gen::inRange(0, 4) == 0;
+                tree.collapse(id, recursive);
+                if (auto* node = referenceFindNode(model, id)) {
+                    node->expanded = false;
+                    if (recursive) setExpanded(node->children, false);
+                }
+                break;
+            }
+            case 6: {
+                auto id = pickId();
+                tree.scrollToNode(id);
+                std::vector<KillerGK::TreeNode*> path;
+                for (auto* node = referenceFindNode(model, id); node; ) {
+                    path.push_back(node);
+                    KillerGK::TreeNode* parent = nullptr;
+                    referenceFindNode(model, node->id, &parent);
+                    node = parent;
+                }
+                for (size_t i = path.size(); i-- > 1; ) {
+                    if (!path[i]->expanded) expandModel(*path[i], false);
+                }
+                if (!path.empty()) RC_ASSERT(tree.getRowIndex(id) >= 0);
+                break;
+            }
+            case 7: {  // Flip a flag through a node pointer
+                auto id = pickId();
+                if (auto* node = tree.findNode(id)) {
+                    node->expanded = !node->expanded;
+                    referenceFindNode(model, id)->expanded = node->expanded;
+                    tree.refreshRows();
+                }
+                break;
+            }
+            default:
+                if (*gen::arbitrary<bool>()) {
+                    tree.collapseAll();
+                    setExpanded(model, false);
+                } else {
+                    tree.expandAll();
+                    setExpanded(model, true);
+                }
+                break;
+        }
+        
+        std::vector<std::pair<std::string, int>> expected;
+        referenceRows(model, 0, expected);
+        RC_ASSERT(tree.getRowCount() == expected.size());
+        
+        auto rows = tree.getRows(0, expected.size());
+        RC_ASSERT(rows.size() == expected.size());
+        std::map<std::string, int> rowIndex;
+        for (size_t i = 0; i < rows.size(); ++i) {
+            RC_ASSERT(rows[i].node->id == expected[i].first);
+            RC_ASSERT(rows[i].depth == expected[i].second);
+            rowIndex[expected[i].first] = static_cast<int>(i);
+        }
+        for (const auto& id : ids) {
+            auto it = rowIndex.find(id);
+            RC_ASSERT(tree.getRowIndex(id) == (it != rowIndex.end() ? it->second : -1));
+        }
+    }
+}
+
+/**
+ * @brief Filter rows as (id, depth, matched): matches and their ancestors, in preorder
+ */
+static bool referenceFilterRows(const std::vector<KillerGK::TreeNode>& nodes, const std::string& query, int depth,
+                                std::vector<std::tuple<std::string, int, bool>>& out) {
+    bool any = false;
+    for (const auto& node : nodes) {
+        std::string text = node.text;
+        std::transform(text.begin(), text.end(), text.begin(),
+                       [](char c) { return static_cast<char>(std::tolower(static_cast<unsigned char>(c))); });
+        bool matched = text.find(query) != std::string::npos;
+        
+        size_t at = out.size();
+        out.emplace_back(node.id, depth, matched);
+        bool below = referenceFilterRows(node.children, query, depth + 1, out);
+        if (!matched && !below) out.erase(out.begin() + static_cast<std::ptrdiff_t>(at));
+        any = any || matched || below;
+    }
+    return any;
+}
+
+/**
+ * **Feature: killergk-gui-library, Property 11: TreeView Hierarchy Preservation**
+ * 
+ * *For any* sequence of filter queries (extended, shortened or replaced,
+ * matched on the calling thread or a worker) interleaved with expands and
+ * structural changes, the rows SHALL be exactly the matching nodes and
+ * their ancestors, in preorder, with matches flagged; clearing the filter
+ * SHALL show the expanded nodes again.
+ * 
+ * **Validates: Requirements 2.5**
+ */
+RC_GTEST_PROP(TreeViewHierarchyProperties, FilterRowsMatchReference, ()) {
+    int nextId = 0;
+    std::vector<std::string> ids;
+    auto genChar = gen::element('a', 'b', 'A', 'B', ' ');
+    auto makeText = [&genChar](int maxLength) {
+        return *gen::container<std::string>(static_cast<size_t>(*gen::inRange(0, maxLength + 1)), genChar);
+    };
+    std::function<KillerGK::TreeNode(int)> makeSubtree = [&](int depth) {
+        KillerGK::TreeNode node("n_" + std::to_string(nextId++), makeText(4));
+        ids.push_back(node.id);
+        node.expanded = *gen::arbitrary<bool>();
+        auto numChildren = depth > 0 ? *gen::inRange(0, 4) : 0;
+        for (int i = 0; i < numChildren; ++i) {
+            node.addChild(makeSubtree(depth - 1));
+        }
+        return node;
+    };
+    
+    std::vector<KillerGK::TreeNode> model;
+    auto numRoots = *gen::inRange(0, 4);
+    for (int i = 0; i < numRoots; ++i) {
+        model.push_back(makeSubtree(3));
+    }
+    
+    auto tree = KillerGK::TreeView::create();
+    tree.nodes(model);
+    tree.backgroundFilterThreshold(*gen::element<size_t>(0, 1, 20));
+    std::string query;
+    
+    auto numSteps = *gen::inRange(1, 30);
+    for (int step = 0; step < numSteps; ++step) {
+        auto pickId = [&ids]() {
+            return ids[static_cast<size_t>(*gen::inRange(0, static_cast<int>(ids.size())))];
+        };
+        
+        switch (ids.empty() ? 0 : *gen::inRange(0, 8)) {
+            case 0: {
+                auto node = makeSubtree(2);
+                tree.addNode(node);
+                model.push_back(node);
+                break;
+            }
+            case 1: {
+                auto id = pickId();
+                tree.removeNode(id);
+                KillerGK::TreeNode* parent = nullptr;
+                if (auto* node = referenceFindNode(model, id, &parent)) {
+                    auto& siblings = parent ? parent->children : model;
+                    siblings.erase(siblings.begin() + (node - siblings.data()));
+                }
+                break;
+            }
+            case 2: {
+                auto id = pickId();
+                tree.expand(id);
+                if (auto* node = referenceFindNode(model, id)) node->expanded = true;
+                break;
+            }
+            case 3:
+            case 4:  // Type ahead
+                query += *genChar;
+                tree.filter(query);
+                break;
+            case 5:  // Backspace
+                if (!query.empty()) query.pop_back();
+                tree.filter(query);
+                break;
+            case 6:
+                query = makeText(2);
+                tree.filter(query);
+                break;
+            default:
+                query.clear();
+                tree.clearFilter();
+                break;
+        }
+        RC_ASSERT(tree.getFilter() == query);
+        
+        if (*gen::arbitrary<bool>()) {
+            // Rows may still be the previous result, but never point at removed nodes
+            for (const auto& row : tree.getRows(0, tree.getRowCount())) {
+                RC_ASSERT(row.node == tree.findNode(row.node->id));
+            }
+        }
+        tree.waitForFilter();
+        RC_ASSERT(!tree.isFilterPending());
+        
+        std::string lowered = query;
+        std::transform(lowered.begin(), lowered.end(), lowered.begin(),
+                       [](char c) { return static_cast<char>(std::tolower(static_cast<unsigned char>(c))); });
+        std::vector<std::tuple<std::string, int, bool>> expected;
+        if (query.empty()) {
+            std::vector<std::pair<std::string, int>> unfiltered;
+            referenceRows(model, 0, unfiltered);
+            for (const auto& [id, depth] : unfiltered) expected.emplace_back(id, depth, false);
+        } else {
+            referenceFilterRows(model, lowered, 0, expected);
+        }
+        
+        auto rows = tree.getRows(0, tree.getRowCount());
+        RC_ASSERT(rows.size() == expected.size());
+        size_t matches = 0;
+        for (size_t i = 0; i < rows.size(); ++i) {
+            RC_ASSERT(rows[i].node->id == std::get<0>(expected[i]));
+            RC_ASSERT(rows[i].depth == std::get<1>(expected[i]));
+            RC_ASSERT(rows[i].matched == std::get<2>(expected[i]));
+            RC_ASSERT(tree.getRowIndex(rows[i].node->id) == static_cast<int>(i));
+            matches += rows[i].matched;
+        }
+        RC_ASSERT(tree.getFilterMatchCount() == matches);
+    }
+}
+
+// ============================================================================
+// Property Tests for Chart Decimation
+// ============================================================================
+
+#include "KillerGK/widgets/Chart.hpp"
+
+/**
+ * @brief Points with x in ascending order (repeats allowed) and arbitrary y
+ */
+static std::vector<KillerGK::DataPoint> genSortedPoints(int maxCount) {
+    std::vector<KillerGK::DataPoint> points;
+    auto count = *gen::inRange(0, maxCount);
+    double x = *gen::inRange(-50.0, 50.0);
+    for (int i = 0; i < count; ++i) {
+        x += *gen::inRange(0, 4) == 0 ? 0.0 : *gen::inRange(0.0, 2.0);
+        points.emplace_back(x, *gen::inRange(-1000.0, 1000.0));
+    }
+    return points;
+}
+
+/**
+ * @brief A line chart with a fixed x-range and one pixel column per unit of width
+ */
+static KillerGK::Chart makeDecimatedChart(double xMin, double xMax, float width, KillerGK::ChartDecimation mode) {
+    KillerGK::ChartAxis axis;
+    axis.autoScale = false;
+    axis.min = xMin;
+    axis.max = xMax;
+    auto chart = KillerGK::Chart::create();
+    chart.chartType(KillerGK::ChartType::Line).xAxis(axis).chartPadding(0, 0, 0, 0).decimation(mode);
+    chart.width(width);
+    return chart;
+}
+
+static size_t decimationColumn(double x, double xMin, double xMax, size_t columns) {
+    if (!(xMax - xMin > 0.0)) return 0;
+    double position = (x - xMin) / (xMax - xMin) * static_cast<double>(columns);
+    return std::min(static_cast<size_t>(std::max(position, 0.0)), columns - 1);
+}
+
+/**
+ * **Feature: killergk-gui-library, Property 26: Chart Decimation Fidelity**
+ * 
+ * *For any* series in x order and any visible x-range, MinMax render points
+ * SHALL be data points in series order that include the lowest and highest
+ * point of every pixel column and the nearest point outside the range on
+ * each side, and LTTB SHALL keep one point from each non-empty column.
+ * 
+ * **Validates: Requirements 2.6**
+ */
+RC_GTEST_PROP(ChartDecimationProperties, RenderPointsKeepColumnExtremes, ()) {
+    auto points = genSortedPoints(400);
+    double xMin = *gen::inRange(-60.0, 200.0);
+    double xMax = xMin + *gen::inRange(0.0, 200.0);
+    auto width = static_cast<float>(*gen::inRange(1, 120));
+    auto columns = static_cast<size_t>(width);
+    
+    KillerGK::ChartSeries series("s", "Series");
+    series.data = points;
+    
+    auto chart = makeDecimatedChart(xMin, xMax, width, KillerGK::ChartDecimation::MinMax);
+    chart.addSeries(series);
+    const auto& rendered = chart.getRenderPoints("s");
+    
+    for (size_t i = 0; i < rendered.size(); ++i) {
+        RC_ASSERT(rendered[i].index < points.size());
+        RC_ASSERT(rendered[i].x == points[rendered[i].index].x);
+        RC_ASSERT(rendered[i].y == points[rendered[i].index].y);
+        if (i > 0) RC_ASSERT(rendered[i - 1].index < rendered[i].index);
+    }
+    auto kept = [&rendered](size_t index) {
+        return std::any_of(rendered.begin(), rendered.end(),
+                           [index](const KillerGK::ChartRenderPoint& p) { return p.index == index; });
+    };
+    
+    // Per-column extremes, and neighbours of the range
+    std::map<size_t, std::pair<double, double>> extremes;
+    size_t before = points.size();
+    size_t after = points.size();
+    for (size_t i = 0; i < points.size(); ++i) {
+        double x = points[i].x;
+        if (x < xMin) {
+            before = i;
+        } else if (x <= xMax) {
+            auto column = decimationColumn(x, xMin, xMax, columns);
+            auto [it, inserted] = extremes.try_emplace(column, points[i].y, points[i].y);
+            it->second.first = std::min(it->second.first, points[i].y);
+            it->second.second = std::max(it->second.second, points[i].y);
+        } else if (after == points.size()) {
+            after = i;
+        }
+    }
+    if (before < points.size()) RC_ASSERT(kept(before));
+    if (after < points.size()) RC_ASSERT(kept(after));
+    for (const auto& [column, range] : extremes) {
+        bool low = false;
+        bool high = false;
+        for (const auto& p : rendered) {
+            if (p.x < xMin || p.x > xMax || decimationColumn(p.x, xMin, xMax, columns) != column) continue;
+            low = low || p.y == range.first;
+            high = high || p.y == range.second;
+        }
+        RC_ASSERT(low && high);
+    }
+    RC_ASSERT(rendered.size() <= 4 * extremes.size() + 2);
+    
+    // LTTB: at most one point per column besides the ends
+    chart.decimation(KillerGK::ChartDecimation::Lttb);
+    const auto& lttb = chart.getRenderPoints("s");
+    std::map<size_t, int> perColumn;
+    for (const auto& p : lttb) {
+        RC_ASSERT(p.x == points[p.index].x && p.y == points[p.index].y);
+        if (p.x >= xMin && p.x <= xMax) perColumn[decimationColumn(p.x, xMin, xMax, columns)]++;
+    }
+    for (const auto& [column, count] : perColumn) {
+        RC_ASSERT(extremes.count(column) > 0);
+        RC_ASSERT(count <= 3);
+    }
+    RC_ASSERT(lttb.size() <= extremes.size() + 4);
+}
+
+/**
+ * **Feature: killergk-gui-library, Property 26: Chart Decimation Fidelity**
+ * 
+ * *For any* series built up by appending batches of points, with render
+ * points requested between batches and the zoom level switched back and
+ * forth, the render points SHALL equal those computed from scratch for the
+ * final data; series out of x order SHALL render every point.
+ * 
+ * **Validates: Requirements 2.6**
+ */
+RC_GTEST_PROP(ChartDecimationProperties, AppendedPointsMatchFreshDecimation, ()) {
+    auto points = genSortedPoints(600);
+    double xMin = *gen::inRange(-60.0, 200.0);
+    double xMax = xMin + *gen::inRange(0.0, 300.0);
+    auto width = static_cast<float>(*gen::inRange(1, 80));
+    auto mode = *gen::element(KillerGK::ChartDecimation::None, KillerGK::ChartDecimation::MinMax,
+                              KillerGK::ChartDecimation::Lttb);
+    
+    auto chart = makeDecimatedChart(xMin, xMax, width, mode);
+    chart.addSeries(KillerGK::ChartSeries("s", "Series"));
+    size_t added = 0;
+    while (added < points.size()) {
+        auto batch = std::min(points.size() - added, static_cast<size_t>(*gen::inRange(1, 100)));
+        std::vector<KillerGK::DataPoint> chunk(points.begin() + static_cast<std::ptrdiff_t>(added),
+                                               points.begin() + static_cast<std::ptrdiff_t>(added + batch));
+        if (*gen::arbitrary<bool>()) {
+            chart.appendPoints("s", chunk);
+        } else {
+            auto& data = chart.getSeriesById("s")->data;
+            data.insert(data.end(), chunk.begin(), chunk.end());
+        }
+        added += batch;
+        
+        (void)chart.getRenderPoints("s");
+        if (*gen::inRange(0, 4) == 0) {
+            // Another zoom level, then back
+            chart.getXAxis().max = xMax + 10.0;
+            (void)chart.getRenderPoints("s");
+            chart.getXAxis().max = xMax;
+        }
+    }
+    
+    auto fresh = makeDecimatedChart(xMin, xMax, width, mode);
+    KillerGK::ChartSeries series("s", "Series");
+    series.data = points;
+    fresh.addSeries(series);
+    
+    const auto& incremental = chart.getRenderPoints("s");
+    const auto& expected = fresh.getRenderPoints("s");
+    RC_ASSERT(incremental.size() == expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        RC_ASSERT(incremental[i].index == expected[i].index);
+    }
+    
+    // Out of order: every point
+    if (points.size() >= 2 && points.front().x < points.back().x) {
+        std::swap(points.front(), points.back());
+        chart.updateSeriesData("s", points);
+        RC_ASSERT(chart.getRenderPoints("s").size() == points.size());
+    }
+}
+
+// ============================================================================
+// Property Tests for Chart Streaming
+// ============================================================================
+
+#include "KillerGK/widgets/ChartStream.hpp"
+#include <deque>
+#include <thread>
+
+/**
+ * @brief Check a stream's window and ranges against the points it should hold
+ */
+static void checkStreamWindow(const KillerGK::ChartStream& stream, const std::deque<std::pair<double, double>>& expected) {
+    RC_ASSERT(stream.size() == expected.size());
+    double minX = std::numeric_limits<double>::max();
+    double maxX = std::numeric_limits<double>::lowest();
+    double minY = minX;
+    double maxY = maxX;
+    bool hasX = false;
+    bool hasY = false;
+    for (size_t i = 0; i < expected.size(); ++i) {
+        auto [x, y] = expected[i];
+        RC_ASSERT((stream.x(i) == x || (std::isnan(x) && std::isnan(stream.x(i)))));
+        RC_ASSERT((stream.y(i) == y || (std::isnan(y) && std::isnan(stream.y(i)))));
+        if (!std::isnan(x)) {
+            hasX = true;
+            minX = std::min(minX, x);
+            maxX = std::max(maxX, x);
+        }
+        if (!std::isnan(y)) {
+            hasY = true;
+            minY = std::min(minY, y);
+            maxY = std::max(maxY, y);
+        }
+    }
+    double lowX = 0, highX = 0, lowY = 0, highY = 0;
+    bool found = stream.getRange(lowX, highX, lowY, highY);
+    RC_ASSERT(found == (hasX && hasY));
+    if (found) {
+        RC_ASSERT(lowX == minX && highX == maxX);
+        RC_ASSERT(lowY == minY && highY == maxY);
+    }
+}
+
+/**
+ * **Feature: killergk-gui-library, Property 27: Chart Stream Window**
+ * 
+ * *For any* sequence of pushes, updates and clears, a stream SHALL hold the
+ * latest points taken in by update(), up to its capacity and oldest first,
+ * and report their lowest and highest x and y; pushes that do not fit the
+ * staging queue SHALL be dropped and counted.
+ * 
+ * **Validates: Requirements 2.6**
+ */
+RC_GTEST_PROP(ChartStreamProperties, WindowHoldsLatestPoints, ()) {
+    auto capacity = static_cast<size_t>(*gen::inRange(1, 40));
+    auto stagingCapacity = static_cast<size_t>(*gen::inRange(0, 40));
+    KillerGK::ChartStream stream(capacity, stagingCapacity);
+    
+    std::deque<std::pair<double, double>> window;
+    std::vector<std::pair<double, double>> staged;
+    uint64_t dropped = 0;
+    uint64_t total = 0;
+    auto genValue = []() {
+        // Few distinct values, so ties are common; NaN now and then
+        return *gen::inRange(0, 20) == 0 ? std::nan("") : static_cast<double>(*gen::inRange(-5, 5));
+    };
+    
+    auto steps = *gen::inRange(1, 60);
+    for (int step = 0; step < steps; ++step) {
+        auto action = *gen::inRange(0, 10);
+        if (action < 3) {
+            double x = genValue();
+            double y = genValue();
+            if (stream.push(x, y)) {
+                staged.emplace_back(x, y);
+            } else {
+                dropped++;
+            }
+        } else if (action < 6) {
+            std::vector<KillerGK::DataPoint> batch;
+            auto count = *gen::inRange(0, 30);
+            for (int i = 0; i < count; ++i) {
+                batch.emplace_back(genValue(), genValue());
+            }
+            size_t accepted = stream.push(batch);
+            for (size_t i = 0; i < accepted; ++i) {
+                staged.emplace_back(batch[i].x, batch[i].y);
+            }
+            dropped += batch.size() - accepted;
+        } else if (action < 9) {
+            RC_ASSERT(stream.update() == staged.size());
+            for (const auto& point : staged) {
+                window.push_back(point);
+                if (window.size() > capacity) window.pop_front();
+            }
+            total += staged.size();
+            staged.clear();
+        } else {
+            stream.clear();
+            window.clear();
+        }
+        RC_ASSERT(stream.getDroppedCount() == dropped);
+        RC_ASSERT(stream.getTotalCount() == total);
+        checkStreamWindow(stream, window);
+    }
+}
+
+/**
+ * **Feature: killergk-gui-library, Property 27: Chart Stream Window**
+ * 
+ * *For any* number of points pushed in batches from a producer thread while
+ * the chart takes them in, the streamed series SHALL end up showing the
+ * latest points in order, and the chart's data range SHALL be that of the
+ * window.
+ * 
+ * **Validates: Requirements 2.6**
+ */
+RC_GTEST_PROP(ChartStreamProperties, ProducerThreadFeedsChart, ()) {
+    auto capacity = static_cast<size_t>(*gen::inRange(1, 500));
+    auto count = static_cast<size_t>(*gen::inRange(0, 5000));
+    auto batchSize = static_cast<size_t>(*gen::inRange(1, 64));
+    
+    auto stream = std::make_shared<KillerGK::ChartStream>(capacity, 64);
+    auto chart = KillerGK::Chart::create();
+    chart.addSeries(KillerGK::ChartSeries("live", "Live")).streamSeries("live", stream);
+    RC_ASSERT(chart.getStream("live") == stream);
+    
+    auto valueAt = [](size_t i) { return std::sin(static_cast<double>(i)) * static_cast<double>(i % 97); };
+    std::thread producer([&]() {
+        std::vector<KillerGK::DataPoint> batch;
+        for (size_t sent = 0; sent < count;) {
+            batch.clear();
+            for (size_t i = sent; i < std::min(count, sent + batchSize); ++i) {
+                batch.emplace_back(static_cast<double>(i), valueAt(i));
+            }
+            // Retry what did not fit instead of dropping it
+            sent += stream->push(batch);
+            std::this_thread::yield();
+        }
+    });
+    while (stream->getTotalCount() < count) {
+        chart.updateStreams();
+        (void)chart.getRenderPoints("live");
+    }
+    producer.join();
+    RC_ASSERT(!chart.updateStreams());
+    
+    size_t shown = std::min(count, capacity);
+    const auto& points = chart.getRenderPoints("live");
+    RC_ASSERT(points.size() == shown);
+    for (size_t i = 0; i < shown; ++i) {
+        size_t sequence = count - shown + i;
+        RC_ASSERT(points[i].x == static_cast<double>(sequence));
+        RC_ASSERT(points[i].y == valueAt(sequence));
+    }
+    
+    if (shown > 0) {
+        double minX, maxX, minY, maxY;
+        chart.getDataRange(minX, maxX, minY, maxY);
+        RC_ASSERT(minX == points.front().x);
+        RC_ASSERT(maxX == points.back().x);
+        
+        double visibleMin, visibleMax;
+        chart.getVisibleXRange(visibleMin, visibleMax);
+        RC_ASSERT(visibleMin == minX && visibleMax == maxX);
+    }
+}
+
+// ============================================================================
+// Property Tests for Chart Column Storage
+// ============================================================================
+
+#include "KillerGK/widgets/ChartColumns.hpp"
+
+/**
+ * @brief The value a column of a type gives back for a stored value
+ */
+static double storedValue(KillerGK::ChartColumnType type, double value) {
+    return type == KillerGK::ChartColumnType::Float32 ? static_cast<double>(static_cast<float>(value)) : value;
+}
+
+static bool sameValue(double a, double b) {
+    return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+/**
+ * **Feature: killergk-gui-library, Property 28: Chart Column Storage**
+ * 
+ * *For any* points appended one at a time, as arrays or as DataPoints, in
+ * any column types, the columns SHALL give back each value as stored by
+ * its type (Delta32 whole steps exactly, switching to Float64 for values
+ * it cannot hold), keep exactly the non-empty labels, and report the range
+ * of the values.
+ * 
+ * **Validates: Requirements 2.6**
+ */
+RC_GTEST_PROP(ChartColumnsProperties, ColumnsKeepValuesAndLabels, ()) {
+    auto xType = *gen::element(KillerGK::ChartColumnType::Float64, KillerGK::ChartColumnType::Float32,
+                               KillerGK::ChartColumnType::Delta32);
+    auto yType = *gen::element(KillerGK::ChartColumnType::Float64, KillerGK::ChartColumnType::Float32,
+                               KillerGK::ChartColumnType::Delta32);
+    // y values are multiples of 1/8, so Delta32 steps of 1/8 hold them exactly
+    KillerGK::ChartColumns columns(xType, yType, 1.0, 0.125);
+    
+    // Whole numbers, mostly ascending like timestamps, with the odd jump,
+    // step back or NaN
+    std::vector<KillerGK::DataPoint> expected;
+    double time = *gen::inRange(-1000, 1000);
+    auto odds = *gen::element(100, 100000);
+    auto nextX = [&time, odds]() {
+        auto kind = *gen::inRange(0, odds);
+        if (kind == 0) return std::nan("");
+        if (kind == 1) return time - 5.0;
+        time += kind == 2 ? 1e10 : static_cast<double>(*gen::inRange(0, 1000));
+        return time;
+    };
+    auto nextY = []() {
+        return *gen::inRange(0, 50) == 0 ? std::nan("") : static_cast<double>(*gen::inRange(-100000, 100000)) / 8.0;
+    };
+    
+    auto steps = *gen::inRange(0, 12);
+    for (int step = 0; step < steps; ++step) {
+        auto count = static_cast<size_t>(*gen::inRange(0, 3000));
+        auto how = *gen::inRange(0, 3);
+        std::vector<double> xs;
+        std::vector<double> ys;
+        std::vector<KillerGK::DataPoint> points;
+        for (size_t i = 0; i < count; ++i) {
+            KillerGK::DataPoint point(nextX(), nextY());
+            if (*gen::inRange(0, 100) == 0) point.label = "p" + std::to_string(expected.size());
+            if (how != 2) point.label.clear();
+            xs.push_back(point.x);
+            ys.push_back(point.y);
+            points.push_back(point);
+            expected.push_back(point);
+        }
+        if (how == 0) {
+            for (size_t i = 0; i < count; ++i) columns.append(xs[i], ys[i]);
+        } else if (how == 1) {
+            columns.append(xs, ys);
+        } else {
+            columns.append(points);
+        }
+    }
+    
+    RC_ASSERT(columns.size() == expected.size());
+    size_t labels = 0;
+    for (size_t i = 0; i < expected.size(); ++i) {
+        RC_ASSERT(sameValue(columns.x(i), storedValue(columns.getXType(), expected[i].x)));
+        RC_ASSERT(sameValue(columns.y(i), storedValue(columns.getYType(), expected[i].y)));
+        RC_ASSERT(columns.label(i) == expected[i].label);
+        RC_ASSERT(columns.point(i).label == expected[i].label);
+        labels += !expected[i].label.empty();
+    }
+    RC_ASSERT(columns.getLabelCount() == labels);
+    if (xType != KillerGK::ChartColumnType::Delta32) RC_ASSERT(columns.getXType() == xType);
+    if (yType != KillerGK::ChartColumnType::Delta32) RC_ASSERT(columns.getYType() == yType);
+    
+    double minX = std::numeric_limits<double>::infinity(), maxX = -minX, minY = minX, maxY = -minX;
+    bool hasX = false, hasY = false;
+    for (size_t i = 0; i < columns.size(); ++i) {
+        if (!std::isnan(columns.x(i))) {
+            hasX = true;
+            minX = std::min(minX, columns.x(i));
+            maxX = std::max(maxX, columns.x(i));
+        }
+        if (!std::isnan(columns.y(i))) {
+            hasY = true;
+            minY = std::min(minY, columns.y(i));
+            maxY = std::max(maxY, columns.y(i));
+        }
+    }
+    double lowX = 0, highX = 0, lowY = 0, highY = 0;
+    RC_ASSERT(columns.getRange(lowX, highX, lowY, highY) == (hasX && hasY));
+    if (hasX && hasY) {
+        RC_ASSERT(lowX == minX && highX == maxX && lowY == minY && highY == maxY);
+    }
+    
+    // Relabel and unlabel
+    if (!expected.empty()) {
+        auto index = static_cast<size_t>(*gen::inRange<size_t>(0, expected.size()));
+        columns.setLabel(index, "changed");
+        RC_ASSERT(columns.label(index) == "changed");
+        columns.setLabel(index, "");
+        RC_ASSERT(columns.label(index).empty());
+        RC_ASSERT(columns.getLabelCount() == labels - !expected[index].label.empty());
+    }
+}
+
+/**
+ * **Feature: killergk-gui-library, Property 28: Chart Column Storage**
+ * 
+ * *For any* series, a chart SHALL draw the same render points and report
+ * the same data range from Float64 columns, and from columns viewing the
+ * caller's arrays, as from DataPoints; appending to viewed columns SHALL
+ * copy the arrays and leave them untouched.
+ * 
+ * **Validates: Requirements 2.6**
+ */
+RC_GTEST_PROP(ChartColumnsProperties, ColumnsRenderLikeDataPoints, ()) {
+    auto points = genSortedPoints(400);
+    if (*gen::inRange(0, 5) == 0 && points.size() >= 2) std::swap(points.front(), points.back());
+    double xMin = *gen::inRange(-60.0, 200.0);
+    double xMax = xMin + *gen::inRange(0.0, 300.0);
+    auto width = static_cast<float>(*gen::inRange(1, 80));
+    auto mode = *gen::element(KillerGK::ChartDecimation::None, KillerGK::ChartDecimation::MinMax,
+                              KillerGK::ChartDecimation::Lttb);
+    
+    std::vector<double> xs;
+    std::vector<double> ys;
+    for (const auto& point : points) {
+        xs.push_back(point.x);
+        ys.push_back(point.y);
+    }
+    auto owned = std::make_shared<KillerGK::ChartColumns>();
+    owned->append(xs, ys);
+    auto viewed = std::make_shared<KillerGK::ChartColumns>();
+    viewed->viewX(xs).viewY(ys);
+    RC_ASSERT(viewed->isView());
+    RC_ASSERT(viewed->memoryUsage() == 0);
+    
+    auto chart = makeDecimatedChart(xMin, xMax, width, mode);
+    chart.getXAxis().autoScale = *gen::arbitrary<bool>();
+    KillerGK::ChartSeries plain("plain", "Plain");
+    plain.data = points;
+    KillerGK::ChartSeries compact("owned", "Owned");
+    compact.columns = owned;
+    KillerGK::ChartSeries view("viewed", "Viewed");
+    view.columns = viewed;
+    chart.addSeries(plain).addSeries(compact).addSeries(view);
+    
+    // Append after a first render, through the chart and directly
+    std::vector<KillerGK::DataPoint> more;
+    double x = points.empty() ? 0.0 : points.back().x;
+    for (int i = *gen::inRange(0, 20); i > 0; --i) {
+        x += 1.0;
+        more.emplace_back(x, static_cast<double>(i));
+    }
+    (void)chart.getRenderPoints("plain");
+    (void)chart.getRenderPoints("owned");
+    (void)chart.getRenderPoints("viewed");
+    chart.appendPoints("plain", more).appendPoints("owned", more).appendPoints("viewed", more);
+    RC_ASSERT(!viewed->isView());
+    RC_ASSERT(xs.size() == points.size());
+    
+    const auto& expected = chart.getRenderPoints("plain");
+    for (const char* id : {"owned", "viewed"}) {
+        const auto& actual = chart.getRenderPoints(id);
+        RC_ASSERT(actual.size() == expected.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            RC_ASSERT(actual[i].index == expected[i].index);
+            RC_ASSERT(actual[i].x == expected[i].x && actual[i].y == expected[i].y);
+        }
+    }
+    
+    double minX, maxX, minY, maxY;
+    chart.getDataRange(minX, maxX, minY, maxY);
+    auto reference = makeDecimatedChart(xMin, xMax, width, mode);
+    plain.data.insert(plain.data.end(), more.begin(), more.end());
+    reference.addSeries(plain);
+    double refMinX, refMaxX, refMinY, refMaxY;
+    reference.getDataRange(refMinX, refMaxX, refMinY, refMaxY);
+    RC_ASSERT(minX == refMinX && maxX == refMaxX && minY == refMinY && maxY == refMaxY);
+}
+
+// ============================================================================
+// Property Tests for Chart Hit Testing
+// ============================================================================
+
+/**
+ * @brief Nearest point by scanning every series, as hitTest() defines it
+ */
+static KillerGK::ChartHit referenceHitTest(KillerGK::Chart& chart, float x, float y) {
+    KillerGK::ChartHit result;
+    double minX, maxX, minY, maxY;
+    chart.getVisibleXRange(minX, maxX);
+    chart.getVisibleYRange(minY, maxY);
+    float plotWidth = chart.getWidth() - 10.0f - 20.0f;
+    float plotHeight = chart.getHeight() - 5.0f - 15.0f;
+    double scaleX = maxX > minX ? plotWidth / (maxX - minX) : 0.0;
+    double scaleY = maxY > minY ? plotHeight / (maxY - minY) : 0.0;
+    double queryX = scaleX > 0.0 ? minX + (x - 20.0f) / scaleX : minX;
+    double queryY = scaleY > 0.0 ? minY + (5.0f + plotHeight - y) / scaleY : minY;
+    
+    double best = chart.getHitRadius();
+    for (const auto& series : chart.getSeries()) {
+        size_t count = series.columns ? series.columns->size() : series.data.size();
+        for (size_t i = 0; i < count; ++i) {
+            double px = series.columns ? series.columns->x(i) : series.data[i].x;
+            double py = series.columns ? series.columns->y(i) : series.data[i].y;
+            double dx = (px - queryX) * scaleX;
+            double dy = (py - queryY) * scaleY;
+            double distance = std::sqrt(dx * dx + dy * dy);
+            if (result.seriesId.empty() ? distance <= best : distance < best) {
+                best = distance;
+                result.seriesId = series.id;
+                result.index = i;
+                result.distance = static_cast<float>(distance);
+            }
+        }
+    }
+    return result;
+}
+
+/**
+ * **Feature: killergk-gui-library, Property 29: Chart Hit Testing**
+ * 
+ * *For any* line or scatter series, in x order or not, stored as points or
+ * columns and grown by appending, hitTest() SHALL find the same point as
+ * scanning every point for the nearest one on screen within the hit
+ * radius.
+ * 
+ * **Validates: Requirements 2.6**
+ */
+RC_GTEST_PROP(ChartHitTestProperties, HitTestFindsNearestPoint, ()) {
+    auto chart = KillerGK::Chart::create();
+    chart.chartType(*gen::element(KillerGK::ChartType::Line, KillerGK::ChartType::Scatter))
+         .chartPadding(5.0f, 10.0f, 15.0f, 20.0f)
+         .hitRadius(static_cast<float>(*gen::inRange(1, 40)));
+    chart.width(static_cast<float>(*gen::inRange(40, 800))).height(static_cast<float>(*gen::inRange(30, 600)));
+    if (*gen::arbitrary<bool>()) {
+        KillerGK::ChartAxis axis;
+        axis.autoScale = false;
+        axis.min = *gen::inRange(-100.0, 0.0);
+        axis.max = *gen::inRange(1.0, 100.0);
+        chart.yAxis(axis);
+    }
+    
+    auto genPoints = []() {
+        auto kind = *gen::inRange(0, 3);
+        if (kind == 0) return genSortedPoints(700);
+        std::vector<KillerGK::DataPoint> points(static_cast<size_t>(*gen::inRange(0, 700)));
+        for (auto& point : points) {
+            // Coarse values, so equally near points are common
+            point = KillerGK::DataPoint(*gen::inRange(-50, 50), *gen::inRange(-50, 50));
+            if (*gen::inRange(0, 100) == 0) point.y = std::nan("");
+        }
+        if (kind == 1) {
+            // In x order but crowded in x, so widening on x alone gives up
+            for (auto& point : points) point.x = *gen::inRange(0, 3);
+            std::sort(points.begin(), points.end(),
+                      [](const KillerGK::DataPoint& a, const KillerGK::DataPoint& b) { return a.x < b.x; });
+        }
+        return points;
+    };
+    auto seriesCount = *gen::inRange(1, 4);
+    for (int s = 0; s < seriesCount; ++s) {
+        KillerGK::ChartSeries series("s" + std::to_string(s), "Series");
+        if (*gen::arbitrary<bool>()) {
+            series.columns = std::make_shared<KillerGK::ChartColumns>();
+            series.columns->append(genPoints());
+        } else {
+            series.data = genPoints();
+        }
+        chart.addSeries(series);
+    }
+    
+    auto rounds = *gen::inRange(1, 4);
+    for (int round = 0; round < rounds; ++round) {
+        double minY, maxY, dataMinX, dataMaxX, dataMinY, dataMaxY;
+        chart.getVisibleYRange(minY, maxY);
+        chart.getDataRange(dataMinX, dataMaxX, dataMinY, dataMaxY);
+        if (chart.getYAxis().autoScale) RC_ASSERT(minY == dataMinY && maxY == dataMaxY);
+        
+        for (int q = 0; q < 30; ++q) {
+            auto x = static_cast<float>(*gen::inRange(0.0, static_cast<double>(chart.getWidth())));
+            auto y = static_cast<float>(*gen::inRange(0.0, static_cast<double>(chart.getHeight())));
+            auto hit = chart.hitTest(x, y);
+            auto expected = referenceHitTest(chart, x, y);
+            RC_ASSERT(hit.seriesId == expected.seriesId);
+            if (!expected.seriesId.empty()) {
+                RC_ASSERT(hit.index == expected.index);
+                RC_ASSERT(hit.distance == expected.distance);
+            }
+        }
+        
+        // Grow a series, through the chart or directly
+        const auto& id = chart.getSeries()[static_cast<size_t>(*gen::inRange(0, seriesCount))].id;
+        auto more = genPoints();
+        if (*gen::arbitrary<bool>()) {
+            chart.appendPoints(id, more);
+        } else if (auto* series = chart.getSeriesById(id); series->columns) {
+            series->columns->append(more);
+        } else {
+            series->data.insert(series->data.end(), more.begin(), more.end());
+        }
+    }
+}
+
+/**
+ * **Feature: killergk-gui-library, Property 29: Chart Hit Testing**
+ * 
+ * *For any* cursor path over a chart, each change of hovered point SHALL
+ * call the hover callback with false for the point left and then with true
+ * for the point reached, and clicks SHALL report the point under the
+ * cursor.
+ * 
+ * **Validates: Requirements 2.6**
+ */
+RC_GTEST_PROP(ChartHitTestProperties, HoverCallbacksFollowCursor, ()) {
+    auto chart = KillerGK::Chart::create();
+    chart.chartType(KillerGK::ChartType::Scatter).chartPadding(5.0f, 10.0f, 15.0f, 20.0f).hitRadius(15.0f);
+    chart.width(200.0f).height(150.0f);
+    KillerGK::ChartSeries series("s", "Series");
+    auto count = *gen::inRange(0, 30);
+    for (int i = 0; i < count; ++i) {
+        series.addPoint(*gen::inRange(0, 20), *gen::inRange(0, 20));
+    }
+    chart.addSeries(series);
+    
+    std::vector<std::pair<KillerGK::DataPoint, bool>> events;
+    std::vector<KillerGK::DataPoint> clicks;
+    chart.onPointHover([&events](const KillerGK::ChartSeries&, const KillerGK::DataPoint& point, bool entered) {
+        events.emplace_back(point, entered);
+    });
+    chart.onPointClick([&clicks](const KillerGK::ChartSeries&, const KillerGK::DataPoint& point) {
+        clicks.push_back(point);
+    });
+    
+    auto moves = *gen::inRange(1, 40);
+    for (int m = 0; m < moves; ++m) {
+        auto x = static_cast<float>(*gen::inRange(0, 200));
+        auto y = static_cast<float>(*gen::inRange(0, 150));
+        auto before = chart.getHoveredPoint();
+        events.clear();
+        bool changed = chart.handleMouseMove(x, y);
+        auto after = chart.getHoveredPoint();
+        auto hit = chart.hitTest(x, y);
+        RC_ASSERT(after.seriesId == hit.seriesId && after.index == hit.index);
+        RC_ASSERT(changed == (before.seriesId != after.seriesId || before.index != after.index));
+        
+        std::vector<std::pair<KillerGK::DataPoint, bool>> expected;
+        if (changed && !before.seriesId.empty()) expected.emplace_back(series.data[before.index], false);
+        if (changed && !after.seriesId.empty()) expected.emplace_back(series.data[after.index], true);
+        RC_ASSERT(events.size() == expected.size());
+        for (size_t i = 0; i < events.size(); ++i) {
+            RC_ASSERT(events[i].first.x == expected[i].first.x && events[i].first.y == expected[i].first.y);
+            RC_ASSERT(events[i].second == expected[i].second);
+        }
+        
+        clicks.clear();
+        RC_ASSERT(chart.handleMouseClick(x, y) == !hit.seriesId.empty());
+        RC_ASSERT(clicks.size() == (hit.seriesId.empty() ? 0u : 1u));
+    }
+    
+    events.clear();
+    bool hovering = !chart.getHoveredPoint().seriesId.empty();
+    chart.handleMouseLeave();
+    RC_ASSERT(chart.getHoveredPoint().seriesId.empty());
+    RC_ASSERT(events.size() == (hovering ? 1u : 0u));
+}
+
+// ============================================================================
+// Property Tests for Widget Property Storage
+// ============================================================================
+
+#include "KillerGK/widgets/WidgetProperties.hpp"
+
+/**
+ * @brief Random property value of a random type, as the old std::any map held it
+ */
+static std::any genPropertyValue() {
+    switch (*gen::inRange(0, 4)) {
+        case 0: return *genFloatInRange(-1000.0f, 1000.0f);
+        case 1: return *gen::inRange(-1000, 1000);
+        case 2: return *gen::arbitrary<bool>();
+        default: return "text_" + std::to_string(*gen::inRange(0, 1000));
+    }
+}
+
+/**
+ * **Feature: killergk-gui-library, Property 30: Widget Property Storage**
+ * 
+ * *For any* sequence of property writes and removals, with values of any of
+ * the four types and names reused across types, a PropertyStore SHALL read
+ * back exactly what a name → std::any map holding the same writes would:
+ * the last value written under the name when its type matches, and the
+ * default otherwise.
+ * 
+ * **Validates: Requirements 1.1, 1.2**
+ */
+RC_GTEST_PROP(WidgetPropertyStorage, StoreMatchesAnyMap, ()) {
+    const std::vector<std::string> names = {"alpha", "beta", "gamma", "delta", "epsilon", "zeta"};
+    KillerGK::PropertyStore store;
+    std::map<std::string, std::any> reference;
+    
+    auto steps = *gen::inRange(1, 80);
+    for (int step = 0; step < steps; ++step) {
+        const std::string& name = names[static_cast<size_t>(*gen::inRange(0, 6))];
+        auto key = KillerGK::PropertyKey::intern(name);
+        if (*gen::inRange(0, 5) == 0) {
+            RC_ASSERT(store.remove(key) == (reference.erase(name) > 0));
+        } else {
+            std::any value = genPropertyValue();
+            RC_ASSERT(store.set(key, value));
+            reference[name] = value;
+        }
+        
+        RC_ASSERT(store.size() == reference.size());
+        for (const auto& other : names) {
+            auto otherKey = KillerGK::PropertyKey::find(other);
+            auto it = reference.find(other);
+            RC_ASSERT(store.has(otherKey) == (it != reference.end()));
+            const std::any* value = it != reference.end() ? &it->second : nullptr;
+            RC_ASSERT(store.getFloat(otherKey, -1.5f) ==
+                      (value && value->type() == typeid(float) ? std::any_cast<float>(*value) : -1.5f));
+            RC_ASSERT(store.getInt(otherKey, -7) ==
+                      (value && value->type() == typeid(int) ? std::any_cast<int>(*value) : -7));
+            RC_ASSERT(store.getBool(otherKey, true) ==
+                      (value && value->type() == typeid(bool) ? std::any_cast<bool>(*value) : true));
+            RC_ASSERT(store.getString(otherKey, "none") ==
+                      (value && value->type() == typeid(std::string) ? std::any_cast<std::string>(*value)
+                                                                     : std::string("none")));
+        }
+    }
+    
+    std::map<std::string, std::any> copied;
+    store.copyTo(copied);
+    RC_ASSERT(copied.size() == reference.size());
+    for (const auto& [name, value] : reference) {
+        auto it = copied.find(name);
+        RC_ASSERT(it != copied.end());
+        RC_ASSERT(it->second.type() == value.type());
+    }
+    
+    // Names never interned match no property
+    RC_ASSERT(!KillerGK::PropertyKey::find("never interned property").isValid());
+    RC_ASSERT(!store.has(KillerGK::PropertyKey::find("never interned property")));
+}
+
+/**
+ * **Feature: killergk-gui-library, Property 30: Widget Property Storage**
+ * 
+ * *For any* widget, properties set by name and by interned key SHALL be the
+ * same properties, and SHALL survive getState() and setState() into another
+ * widget with their types.
+ * 
+ * **Validates: Requirements 1.1, 1.2, 19.1**
+ */
+RC_GTEST_PROP(WidgetPropertyStorage, NamesAndKeysShareProperties, ()) {
+    auto count = *gen::inRange(1, 30);
+    KillerGK::Widget widget = KillerGK::Widget::create();
+    std::map<std::string, std::any> reference;
+    
+    for (int i = 0; i < count; ++i) {
+        std::string name = "prop_" + std::to_string(*gen::inRange(0, 40));
+        auto key = KillerGK::PropertyKey::intern(name);
+        RC_ASSERT(key.getName() == name);
+        RC_ASSERT(KillerGK::PropertyKey::intern(name) == key);
+        
+        bool byKey = *gen::arbitrary<bool>();
+        std::any value = genPropertyValue();
+        if (value.type() == typeid(float)) {
+            float v = std::any_cast<float>(value);
+            if (byKey) widget.setPropertyFloat(key, v); else widget.setPropertyFloat(name, v);
+        } else if (value.type() == typeid(int)) {
+            int v = std::any_cast<int>(value);
+            if (byKey) widget.setPropertyInt(key, v); else widget.setPropertyInt(name, v);
+        } else if (value.type() == typeid(bool)) {
+            bool v = std::any_cast<bool>(value);
+            if (byKey) widget.setPropertyBool(key, v); else widget.setPropertyBool(name, v);
+        } else {
+            std::string v = std::any_cast<std::string>(value);
+            if (byKey) widget.setPropertyString(key, v); else widget.setPropertyString(name, v);
+        }
+        reference[name] = value;
+    }
+    
+    KillerGK::Widget restored = KillerGK::Widget::create();
+    restored.setState(widget.getState());
+    for (const KillerGK::Widget* w : {&widget, &restored}) {
+        for (const auto& [name, value] : reference) {
+            auto key = KillerGK::PropertyKey::find(name);
+            RC_ASSERT(w->hasProperty(name) && w->hasProperty(key));
+            if (value.type() == typeid(float)) {
+                RC_ASSERT(w->getPropertyFloat(name) == std::any_cast<float>(value));
+                RC_ASSERT(w->getPropertyFloat(key) == std::any_cast<float>(value));
+                RC_ASSERT(w->getPropertyInt(key, -1) == -1);
+            } else if (value.type() == typeid(int)) {
+                RC_ASSERT(w->getPropertyInt(name) == std::any_cast<int>(value));
+                RC_ASSERT(w->getPropertyInt(key) == std::any_cast<int>(value));
+                RC_ASSERT(w->getPropertyFloat(key, -1.0f) == -1.0f);
+            } else if (value.type() == typeid(bool)) {
+                RC_ASSERT(w->getPropertyBool(name) == std::any_cast<bool>(value));
+                RC_ASSERT(w->getPropertyBool(key) == std::any_cast<bool>(value));
+                RC_ASSERT(w->getPropertyString(key, "none") == "none");
+            } else {
+                RC_ASSERT(w->getPropertyString(name) == std::any_cast<std::string>(value));
+                RC_ASSERT(w->getPropertyString(key) == std::any_cast<std::string>(value));
+                RC_ASSERT(w->getPropertyBool(key, true) == true);
+            }
+        }
+    }
+}
+
+// ============================================================================
+// Property Tests for Widget Hit Testing
+// ============================================================================
+
+#include "KillerGK/widgets/WidgetHitIndex.hpp"
+#include "KillerGK/layout/Layout.hpp"
+
+/**
+ * @brief Random widget bounds, from a few pixels to larger than a window
+ */
+static KillerGK::Rect genWidgetBounds() {
+    float size = *gen::element(4.0f, 40.0f, 200.0f, 1500.0f);
+    auto x = static_cast<float>(*gen::inRange(-200, 2000));
+    auto y = static_cast<float>(*gen::inRange(-200, 1200));
+    auto width = static_cast<float>(*gen::inRange(0, static_cast<int>(size)));
+    auto height = static_cast<float>(*gen::inRange(0, static_cast<int>(size)));
+    return KillerGK::Rect(x, y, width, height);
+}
+
+/**
+ * **Feature: killergk-gui-library, Property 31: Widget Hit Testing**
+ * 
+ * *For any* nested widgets added, moved, raised, hidden and removed in any
+ * order, hitTest() SHALL return the widget containing the point that was
+ * added (or raised) last among those neither hidden nor inside a hidden
+ * ancestor, as testing every widget's bounds would, including points on
+ * the edges of the bounds.
+ * 
+ * **Validates: Requirements 11.2**
+ */
+RC_GTEST_PROP(WidgetHitIndexProperties, HitTestFindsTopmostWidget, ()) {
+    auto count = *gen::inRange(1, 60);
+    std::vector<KillerGK::Widget> widgets;
+    widgets.reserve(static_cast<size_t>(count));
+    for (int i = 0; i < count; ++i) widgets.push_back(KillerGK::Widget::create());
+    // Some widgets are children of earlier ones, so hiding a parent hides them
+    for (int i = 1; i < count; ++i) {
+        if (*gen::inRange(0, 3) == 0) {
+            widgets[static_cast<size_t>(*gen::inRange(0, i))].addChild(&widgets[static_cast<size_t>(i)]);
+        }
+    }
+    auto shown = [](KillerGK::Widget* widget) {
+        for (; widget; widget = widget->getParent()) {
+            if (!widget->isVisible()) return false;
+        }
+        return true;
+    };
+    
+    KillerGK::WidgetHitIndex index;
+    std::map<KillerGK::Widget*, std::pair<KillerGK::Rect, uint64_t>> reference;
+    uint64_t order = 0;
+    
+    auto steps = *gen::inRange(1, 150);
+    for (int step = 0; step < steps; ++step) {
+        KillerGK::Widget* widget = &widgets[static_cast<size_t>(*gen::inRange(0, count))];
+        switch (*gen::inRange(0, 6)) {
+            case 0:
+            case 1:
+            case 2: {
+                KillerGK::Rect bounds = genWidgetBounds();
+                index.update(widget, bounds);
+                auto it = reference.find(widget);
+                if (it == reference.end()) {
+                    reference[widget] = {bounds, order++};
+                } else {
+                    it->second.first = bounds;
+                }
+                break;
+            }
+            case 3:
+                index.raise(widget);
+                if (reference.count(widget)) reference[widget].second = order++;
+                break;
+            case 4:
+                RC_ASSERT(index.remove(widget) == (reference.erase(widget) > 0));
+                break;
+            default:
+                widget->visible(!widget->isVisible());
+                break;
+        }
+        RC_ASSERT(index.size() == reference.size());
+        
+        std::vector<std::pair<float, float>> points;
+        for (int q = 0; q < 8; ++q) {
+            points.emplace_back(static_cast<float>(*gen::inRange(-300, 2200)),
+                                static_cast<float>(*gen::inRange(-300, 1400)));
+        }
+        // Corners of an indexed widget, which Rect::contains includes
+        if (!reference.empty()) {
+            const KillerGK::Rect& bounds = reference.begin()->second.first;
+            points.emplace_back(bounds.x, bounds.y);
+            points.emplace_back(bounds.x + bounds.width, bounds.y + bounds.height);
+        }
+        for (auto [x, y] : points) {
+            KillerGK::Widget* expected = nullptr;
+            uint64_t best = 0;
+            for (const auto& [candidate, placement] : reference) {
+                if (placement.first.contains(x, y) && shown(candidate) &&
+                    (!expected || placement.second > best)) {
+                    expected = candidate;
+                    best = placement.second;
+                }
+            }
+            RC_ASSERT(index.hitTest(x, y) == expected);
+        }
+    }
+}
+
+/**
+ * **Feature: killergk-gui-library, Property 31: Widget Hit Testing**
+ * 
+ * *For any* cursor path over nested widgets, the hovered widgets SHALL be
+ * the topmost widget under the cursor and its indexed ancestors; each move
+ * SHALL report exactly the widgets that left and entered that set and
+ * update their hover state, and widgets laid out by a layout SHALL be indexed at
+ * their computed bounds.
+ * 
+ * **Validates: Requirements 11.2**
+ */
+RC_GTEST_PROP(WidgetHitIndexProperties, HoverFollowsTopmostAndAncestors, ()) {
+    // Panels in a row, each with a column of tiles
+    auto panelCount = *gen::inRange(1, 5);
+    auto tileCount = *gen::inRange(1, 6);
+    std::vector<KillerGK::Widget> panels;
+    std::vector<KillerGK::Widget> tiles;
+    panels.reserve(static_cast<size_t>(panelCount));
+    tiles.reserve(static_cast<size_t>(panelCount * tileCount));
+    for (int p = 0; p < panelCount; ++p) panels.push_back(KillerGK::Widget::create().width(100).height(400));
+    for (int p = 0; p < panelCount; ++p) {
+        for (int t = 0; t < tileCount; ++t) {
+            tiles.push_back(KillerGK::Widget::create().width(80).height(50));
+            panels[static_cast<size_t>(p)].addChild(&tiles.back());
+        }
+    }
+    
+    KillerGK::WidgetHitIndex index;
+    KillerGK::AbsoluteImpl row;
+    std::vector<KillerGK::Widget*> panelPointers;
+    for (int p = 0; p < panelCount; ++p) {
+        auto& panel = panels[static_cast<size_t>(p)];
+        panel.setPropertyFloat("x", 120.0f * static_cast<float>(p)).setPropertyFloat("y", 10.0f);
+        panelPointers.push_back(&panel);
+    }
+    row.setChildren(panelPointers);
+    row.layout(KillerGK::LayoutConstraints::loose(1000.0f, 1000.0f));
+    index.update(row);
+    for (int p = 0; p < panelCount; ++p) {
+        RC_ASSERT(index.getBounds(&panels[static_cast<size_t>(p)]) == row.getChildBounds(static_cast<size_t>(p)));
+        for (int t = 0; t < tileCount; ++t) {
+            const KillerGK::Rect& panel = row.getChildBounds(static_cast<size_t>(p));
+            float tileY = panel.y + 10.0f + 60.0f * static_cast<float>(t);
+            index.update(&tiles[static_cast<size_t>(p * tileCount + t)],
+                         KillerGK::Rect(panel.x + 10.0f, tileY, 80.0f, 50.0f));
+        }
+    }
+    
+    std::set<KillerGK::Widget*> hovered;
+    auto moves = *gen::inRange(1, 30);
+    for (int m = 0; m < moves; ++m) {
+        float x = static_cast<float>(*gen::inRange(-20, 120 * panelCount));
+        float y = static_cast<float>(*gen::inRange(0, 420));
+        auto change = index.updateHover(x, y);
+        
+        std::set<KillerGK::Widget*> expected;
+        for (KillerGK::Widget* w = index.hitTest(x, y); w; w = w->getParent()) expected.insert(w);
+        RC_ASSERT(index.getHovered() == index.hitTest(x, y));
+        
+        std::set<KillerGK::Widget*> left(change.left.begin(), change.left.end());
+        std::set<KillerGK::Widget*> entered(change.entered.begin(), change.entered.end());
+        for (KillerGK::Widget* w : hovered) RC_ASSERT(left.count(w) == (expected.count(w) == 0 ? 1u : 0u));
+        for (KillerGK::Widget* w : expected) RC_ASSERT(entered.count(w) == (hovered.count(w) == 0 ? 1u : 0u));
+        RC_ASSERT(left.size() + entered.size() == change.left.size() + change.entered.size());
+        
+        // Entered outermost first; every widget's hover state follows the set
+        if (change.entered.size() == 2) RC_ASSERT(change.entered[1]->getParent() == change.entered[0]);
+        for (auto& panel : panels) RC_ASSERT(panel.isHovered() == (expected.count(&panel) > 0));
+        for (auto& tile : tiles) RC_ASSERT(tile.isHovered() == (expected.count(&tile) > 0));
+        hovered = expected;
+    }
+    
+    auto change = index.clearHover();
+    RC_ASSERT(change.left.size() == hovered.size() && change.entered.empty());
+    RC_ASSERT(index.getHovered() == nullptr);
+    for (KillerGK::Widget* w : hovered) RC_ASSERT(!w->isHovered());
+}
+
+// ============================================================================
+// Property Tests for Widget Invalidation
+// ============================================================================
+
+#include "KillerGK/widgets/WidgetDamage.hpp"
+
+/**
+ * **Feature: killergk-gui-library, Property 32: Widget Invalidation**
+ * 
+ * *For any* widget in a tree and any setter changing one of its values,
+ * including setters of widget subclasses, the widget SHALL be marked
+ * Layout for size, spacing, visibility and sized content and Paint for
+ * styling and state, its ancestors SHALL be marked Subtree (and
+ * Layout for a layout change) and no other widget SHALL be marked; setting
+ * the value it already has SHALL mark nothing.
+ * 
+ * **Validates: Requirements 1.1, 1.2**
+ */
+RC_GTEST_PROP(WidgetInvalidationProperties, SettersMarkWidgetAndAncestors, ()) {
+    using KillerGK::DirtyFlags;
+    
+    // A chain of widgets, and a sibling branch off the root
+    auto depth = *gen::inRange(1, 7);
+    std::vector<KillerGK::Widget> chain;
+    chain.reserve(static_cast<size_t>(depth));
+    for (int i = 0; i < depth; ++i) {
+        chain.push_back(KillerGK::Widget::create());
+        if (i > 0) chain[static_cast<size_t>(i - 1)].addChild(&chain.back());
+    }
+    auto sibling = KillerGK::Widget::create();
+    chain[0].addChild(&sibling);
+    // A label at the end of the chain, for the setters of a subclass
+    auto label = KillerGK::Label::create();
+    chain.back().addChild(&label);
+    RC_ASSERT(sibling.getDirty() == (DirtyFlags::Layout | DirtyFlags::Paint));
+    RC_ASSERT(chain[0].getDirty() & DirtyFlags::Subtree);
+    chain[0].clearDirty();
+    RC_ASSERT(!sibling.isDirty() && !label.isDirty());
+    for (auto& widget : chain) RC_ASSERT(!widget.isDirty());
+    
+    auto op = *gen::inRange(0, 12);
+    auto target = op >= 10 ? chain.size() : static_cast<size_t>(*gen::inRange(0, depth));
+    KillerGK::Widget& widget = op >= 10 ? static_cast<KillerGK::Widget&>(label) : chain[target];
+    auto value = static_cast<float>(*gen::inRange(1, 100));
+    auto apply = [&]() {
+        switch (op) {
+            case 0: widget.width(value); break;
+            case 1: widget.margin(value, 0.0f); break;
+            case 2: widget.maxHeight(value); break;
+            case 3: widget.backgroundColor(KillerGK::Color(value / 100.0f, 0.0f, 0.0f)); break;
+            case 4: widget.opacity(value / 100.0f); break;
+            case 5: widget.shadow(value, 0.0f, 2.0f, KillerGK::Color::Black); break;
+            case 6: widget.visible(false); break;
+            case 7: widget.setPropertyFloat("weight", value); break;
+            case 8: widget.setPropertyString("label", std::to_string(value)); break;
+            case 9: widget.setHovered(true); break;
+            case 10: label.text(std::to_string(value)); break;
+            default: label.textColor(KillerGK::Color(0.0f, value / 100.0f, 0.0f)); break;
+        }
+    };
+    DirtyFlags expected = op < 3 ? DirtyFlags::Layout
+                        : op == 6 || op == 10 ? DirtyFlags::Layout | DirtyFlags::Paint
+                        : DirtyFlags::Paint;
+    apply();
+    
+    RC_ASSERT(widget.getDirty() == expected);
+    DirtyFlags up = expected & DirtyFlags::Layout ? DirtyFlags::Subtree | DirtyFlags::Layout : DirtyFlags::Subtree;
+    for (size_t i = 0; i < target; ++i) RC_ASSERT(chain[i].getDirty() == up);
+    for (size_t i = target + 1; i < chain.size(); ++i) RC_ASSERT(!chain[i].isDirty());
+    RC_ASSERT(!sibling.isDirty());
+    if (op < 10) RC_ASSERT(!label.isDirty());
+    
+    chain[0].clearDirty();
+    apply();
+    for (auto& w : chain) RC_ASSERT(!w.isDirty());
+    RC_ASSERT(!label.isDirty());
+}
+
+/**
+ * **Feature: killergk-gui-library, Property 32: Widget Invalidation**
+ * 
+ * *For any* frames of widgets repainted, moved by layout and removed, the
+ * damaged regions SHALL cover the bounds of every repainted widget and
+ * both the old and new bounds of every moved widget, and the place of
+ * every removed widget; regions SHALL not overlap, there SHALL be no more
+ * than MAX_REGIONS of them, every widget SHALL be clean afterwards and a
+ * frame with no changes SHALL have no damage.
+ * 
+ * **Validates: Requirements 1.1, 1.2**
+ */
+RC_GTEST_PROP(WidgetInvalidationProperties, DamageCoversChangedWidgets, ()) {
+    auto count = *gen::inRange(1, 40);
+    auto root = KillerGK::Widget::create();
+    std::vector<KillerGK::Widget> children;
+    children.reserve(static_cast<size_t>(count));
+    KillerGK::WidgetHitIndex index;
+    KillerGK::DamageTracker damage;
+    
+    // Whole pixels, so region containment is exact
+    auto genBounds = []() {
+        return KillerGK::Rect(static_cast<float>(*gen::inRange(0, 900)), static_cast<float>(*gen::inRange(0, 900)),
+                              static_cast<float>(*gen::inRange(1, 100)), static_cast<float>(*gen::inRange(1, 100)));
+    };
+    index.update(&root, KillerGK::Rect(0.0f, 0.0f, 1000.0f, 1000.0f));
+    for (int i = 0; i < count; ++i) {
+        children.push_back(KillerGK::Widget::create());
+        root.addChild(&children.back());
+        index.update(&children.back(), genBounds());
+    }
+    
+    auto covered = [&](const KillerGK::Rect& rect) {
+        for (const auto& region : damage.getRegions()) {
+            if (region.x <= rect.x && region.y <= rect.y && rect.x + rect.width <= region.x + region.width &&
+                rect.y + rect.height <= region.y + region.height) {
+                return true;
+            }
+        }
+        return false;
+    };
+    auto checkRegions = [&]() {
+        const auto& regions = damage.getRegions();
+        RC_ASSERT(regions.size() <= KillerGK::DamageTracker::MAX_REGIONS);
+        for (size_t i = 0; i < regions.size(); ++i) {
+            for (size_t j = i + 1; j < regions.size(); ++j) {
+                const auto& a = regions[i];
+                const auto& b = regions[j];
+                RC_ASSERT(!(a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height &&
+                            b.y < a.y + a.height));
+            }
+        }
+    };
+    
+    // The first frame draws everything
+    RC_ASSERT(damage.collect(root, index));
+    checkRegions();
+    RC_ASSERT(covered(KillerGK::Rect(0.0f, 0.0f, 1000.0f, 1000.0f)));
+    damage.clear();
+    RC_ASSERT(!damage.collect(root, index));
+    
+    std::set<KillerGK::Widget*> removed;
+    auto frames = *gen::inRange(1, 6);
+    for (int frame = 0; frame < frames; ++frame) {
+        // Where each widget was drawn, and the widgets changed since
+        std::map<KillerGK::Widget*, KillerGK::Rect> drawn;
+        for (auto& child : children) drawn[&child] = index.getBounds(&child);
+        std::set<KillerGK::Widget*> changed;
+        auto changes = *gen::inRange(0, 6);
+        for (int c = 0; c < changes; ++c) {
+            KillerGK::Widget* child = &children[static_cast<size_t>(*gen::inRange(0, count))];
+            if (removed.count(child)) continue;
+            changed.insert(child);
+            switch (*gen::inRange(0, 3)) {
+                case 0:
+                    child->backgroundColor(KillerGK::Color(static_cast<float>(frame * 8 + c + 1) / 64.0f, 0.0f, 0.0f));
+                    break;
+                case 1:
+                    // A layout pass moved it
+                    child->width(child->getWidth() + 1.0f);
+                    index.update(child, genBounds());
+                    break;
+                default:
+                    root.removeChild(child);
+                    index.remove(child);
+                    damage.remove(child);
+                    removed.insert(child);
+                    break;
+            }
+        }
+        std::vector<KillerGK::Rect> expected;
+        for (KillerGK::Widget* child : changed) {
+            expected.push_back(drawn[child]);
+            if (!removed.count(child)) expected.push_back(index.getBounds(child));
+        }
+        
+        RC_ASSERT(damage.collect(root, index) == !expected.empty());
+        checkRegions();
+        for (const auto& rect : expected) RC_ASSERT(covered(rect));
+        RC_ASSERT(!root.isDirty());
+        for (auto& child : children) RC_ASSERT(removed.count(&child) > 0 || !child.isDirty());
+        damage.clear();
+    }
+}
+
+// ============================================================================
+// Property Tests for Widget Arena
+// ============================================================================
+
+#include "KillerGK/widgets/WidgetArena.hpp"
+
+/**
+ * @brief Build a tree of configured widgets from parent indices and sizes
+ */
+static void buildArenaTree(std::vector<KillerGK::Widget>& widgets, const std::vector<int>& parents,
+                           const std::vector<int>& sizes) {
+    widgets.reserve(parents.size());
+    for (size_t i = 0; i < parents.size(); ++i) {
+        widgets.push_back(KillerGK::Widget::create()
+            .id("w" + std::to_string(i))
+            .width(static_cast<float>(sizes[i]))
+            .opacity(static_cast<float>(sizes[i] % 10) / 10.0f)
+            .setPropertyInt("index", static_cast<int>(i))
+            .setPropertyString("label", std::string(static_cast<size_t>(sizes[i] % 40), 'x')));
+        if (parents[i] >= 0) widgets[static_cast<size_t>(parents[i])].addChild(&widgets.back());
+    }
+}
+
+/**
+ * **Feature: killergk-gui-library, Property 33: Widget Arena**
+ * 
+ * *For any* tree of widgets built while an arena is current, the widgets
+ * SHALL hold the same state and hierarchy as the same tree built on the
+ * heap; the arena SHALL count one live block per widget, refuse reset()
+ * while any widget lives, and reuse its chunks for a rebuilt tree without
+ * reserving more memory. Widgets SHALL stay valid after the arena object
+ * is destroyed.
+ * 
+ * **Validates: Requirements 1.1, 1.2**
+ */
+RC_GTEST_PROP(WidgetArenaProperties, ArenaTreesMatchHeapTrees, ()) {
+    auto count = *gen::inRange(1, 2000);    // Up to several chunks
+    std::vector<int> parents;
+    std::vector<int> sizes;
+    for (int i = 0; i < count; ++i) {
+        parents.push_back(i == 0 ? -1 : *gen::inRange(0, i));
+        sizes.push_back(*gen::inRange(0, 1000));
+    }
+    
+    std::vector<KillerGK::Widget> heap;
+    buildArenaTree(heap, parents, sizes);
+    RC_ASSERT(KillerGK::WidgetArena::current() == nullptr);
+    
+    auto arena = std::make_unique<KillerGK::WidgetArena>();
+    auto arenaWidgets = std::make_unique<std::vector<KillerGK::Widget>>();
+    {
+        KillerGK::WidgetArena::Scope scope(*arena);
+        RC_ASSERT(KillerGK::WidgetArena::current() == arena.get());
+        buildArenaTree(*arenaWidgets, parents, sizes);
+    }
+    RC_ASSERT(KillerGK::WidgetArena::current() == nullptr);
+    RC_ASSERT(arena->getLiveCount() == static_cast<size_t>(count));
+    RC_ASSERT(arena->getUsedBytes() <= arena->getReservedBytes());
+    RC_ASSERT(!arena->reset());
+    
+    auto matches = [&](const std::vector<KillerGK::Widget>& built) {
+        for (size_t i = 0; i < heap.size(); ++i) {
+            RC_ASSERT(built[i].getState() == heap[i].getState());
+            RC_ASSERT(built[i].getPropertyString("label") == heap[i].getPropertyString("label"));
+            RC_ASSERT(built[i].getChildren().size() == heap[i].getChildren().size());
+            int parent = parents[i];
+            RC_ASSERT(built[i].getParent() == (parent < 0 ? nullptr : &built[static_cast<size_t>(parent)]));
+        }
+    };
+    matches(*arenaWidgets);
+    
+    // Rebuilt in the same chunks once the first tree is gone
+    size_t reserved = arena->getReservedBytes();
+    arenaWidgets->clear();
+    RC_ASSERT(arena->getLiveCount() == 0u);
+    RC_ASSERT(arena->reset());
+    RC_ASSERT(arena->getUsedBytes() == 0u);
+    {
+        KillerGK::WidgetArena::Scope scope(*arena);
+        buildArenaTree(*arenaWidgets, parents, sizes);
+    }
+    RC_ASSERT(arena->getReservedBytes() == reserved);
+    
+    // Widgets outlive the arena object
+    arena.reset();
+    matches(*arenaWidgets);
+    (*arenaWidgets)[0].width(1.0f).setPropertyFloat("after", 2.0f);
+    RC_ASSERT((*arenaWidgets)[0].getPropertyFloat("after") == 2.0f);
+}
+
+/**
+ * **Feature: killergk-gui-library, Property 33: Widget Arena**
+ * 
+ * *For any* nesting of arena scopes, widgets SHALL be allocated from the
+ * innermost active arena, and each scope SHALL restore the arena current
+ * before it.
+ * 
+ * **Validates: Requirements 1.1, 1.2**
+ */
+RC_GTEST_PROP(WidgetArenaProperties, ScopesNest, ()) {
+    auto depth = *gen::inRange(1, 5);
+    std::vector<std::unique_ptr<KillerGK::WidgetArena>> arenas;
+    std::vector<std::unique_ptr<KillerGK::WidgetArena::Scope>> scopes;
+    std::vector<KillerGK::Widget> widgets;
+    widgets.reserve(static_cast<size_t>(depth) * 8);
+    std::vector<size_t> expected(static_cast<size_t>(depth), 0);
+    
+    for (int d = 0; d < depth; ++d) {
+        arenas.push_back(std::make_unique<KillerGK::WidgetArena>());
+        scopes.push_back(std::make_unique<KillerGK::WidgetArena::Scope>(*arenas.back()));
+        auto made = static_cast<size_t>(*gen::inRange(0, 4));
+        for (size_t i = 0; i < made; ++i) widgets.push_back(KillerGK::Widget::create());
+        expected[static_cast<size_t>(d)] += made;
+    }
+    for (int d = depth - 1; d >= 0; --d) {
+        RC_ASSERT(KillerGK::WidgetArena::current() == arenas[static_cast<size_t>(d)].get());
+        scopes.pop_back();
+        if (d > 0) {
+            widgets.push_back(KillerGK::Widget::create());
+            expected[static_cast<size_t>(d - 1)]++;
+        }
+    }
+    RC_ASSERT(KillerGK::WidgetArena::current() == nullptr);
+    for (int d = 0; d < depth; ++d) {
+        RC_ASSERT(arenas[static_cast<size_t>(d)]->getLiveCount() == expected[static_cast<size_t>(d)]);
+    }
 }
 
 // ============================================================================
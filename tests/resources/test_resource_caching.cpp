@@ -17,9 +17,18 @@
 #include <gtest/gtest.h>
 #include <rapidcheck.h>
 #include <rapidcheck/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
+#include "KillerGK/resources/CRC32.hpp"
 #include "KillerGK/resources/ResourceManager.hpp"
 
 using namespace KillerGK;
@@ -661,3 +670,557 @@ RC_GTEST_PROP(ResourceMemoryProperties, MemoryBreakdownIsConsistent, ()) {
     RC_ASSERT(totalUsage == 0);
     RC_ASSERT(breakdownSum == 0);
 }
+
+/**
+ * **Feature: killergk-gui-library, Property 13: Resource Memory Management**
+ * 
+ * *For any* sequence of loads, accesses, reloads and removals, the eviction
+ * index SHALL offer candidates in exactly the order the policy defines and
+ * SHALL stop as soon as the requested bytes are covered.
+ * 
+ * LRU orders by last use, FIFO by load, and LFU by access count with ties
+ * broken by the time each entry reached its count.
+ * 
+ * **Validates: Requirements 12.2, 12.5**
+ */
+RC_GTEST_PROP(ResourceMemoryProperties, EvictionIndexFollowsPolicy, ()) {
+    struct Expected {
+        size_t memoryUsage = 0;
+        size_t accessCount = 0;
+        int loadTick = 0;
+        int useTick = 0;
+        int countTick = 0;
+    };
+    
+    EvictionIndex index;
+    std::unordered_map<std::string, Expected> model;
+    
+    auto operationCount = *gen::inRange(1, 200);
+    for (int tick = 0; tick < operationCount; ++tick) {
+        std::string key = "res_" + std::to_string(*gen::inRange(0, 24));
+        auto operation = *gen::inRange(0, 4);
+        auto it = model.find(key);
+        
+        if (operation == 0 || it == model.end()) {
+            size_t bytes = *gen::inRange<size_t>(1, 4096);
+            index.insert(key, ResourceType::Image, bytes);
+            model[key] = Expected{bytes, 1, tick, tick, tick};
+        } else if (operation == 1) {
+            index.touch(key);
+            it->second.accessCount++;
+            it->second.useTick = tick;
+            it->second.countTick = tick;
+        } else if (operation == 2) {
+            size_t bytes = *gen::inRange<size_t>(1, 4096);
+            index.refresh(key, bytes);
+            it->second.memoryUsage = bytes;
+            it->second.useTick = tick;
+        } else {
+            RC_ASSERT(index.erase(key));
+            model.erase(it);
+        }
+    }
+    
+    RC_ASSERT(index.size() == model.size());
+    
+    for (auto policy : {EvictionPolicy::LRU, EvictionPolicy::LFU, EvictionPolicy::FIFO}) {
+        std::vector<std::string> expected;
+        for (const auto& [key, entry] : model) {
+            expected.push_back(key);
+        }
+        std::sort(expected.begin(), expected.end(), [&](const auto& a, const auto& b) {
+            const auto& x = model[a];
+            const auto& y = model[b];
+            switch (policy) {
+                case EvictionPolicy::LRU: return x.useTick < y.useTick;
+                case EvictionPolicy::FIFO: return x.loadTick < y.loadTick;
+                default:
+                    return x.accessCount != y.accessCount ? x.accessCount < y.accessCount
+                                                          : x.countTick < y.countTick;
+            }
+        });
+        
+        RC_ASSERT(index.collect(policy, SIZE_MAX) == expected);
+        
+        // A partial request takes the shortest prefix covering the bytes
+        size_t bytesToFree = *gen::inRange<size_t>(0, 16384);
+        auto candidates = index.collect(policy, bytesToFree);
+        size_t covered = 0;
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            RC_ASSERT(candidates[i] == expected[i]);
+            RC_ASSERT(covered < bytesToFree);
+            covered += model[candidates[i]].memoryUsage;
+        }
+        RC_ASSERT(covered >= bytesToFree || candidates.size() == expected.size());
+    }
+}
+
+// ============================================================================
+// Property Tests for Async Loading
+// ============================================================================
+
+/**
+ * **Feature: killergk-gui-library, Property 12: Resource Caching Consistency**
+ * 
+ * *For any* batch of async preload requests, including duplicate paths and
+ * mixed priorities, every request SHALL receive exactly one completion
+ * callback and no load SHALL remain pending once uploads are processed.
+ * 
+ * This test verifies that:
+ * 1. Duplicate paths are merged into a single in-flight load
+ * 2. Each preloadAsync call still gets its own callback per path
+ * 3. processPendingUploads drains all in-flight loads
+ * 
+ * **Validates: Requirements 12.1**
+ */
+RC_GTEST_PROP(ResourceCachingProperties, AsyncPreloadCompletesEveryRequest, ()) {
+    auto& rm = ResourceManager::instance();
+    rm.initialize();
+    rm.clearCache();
+    rm.setLoaderThreadCount(*gen::inRange<size_t>(1, 5));
+    
+    // Paths that do not exist: decode fails, but completion must still be reported
+    auto numPaths = *gen::inRange(1, 20);
+    std::vector<std::string> paths;
+    for (int i = 0; i < numPaths; ++i) {
+        paths.push_back("missing_async_" + std::to_string(*gen::inRange(0, 8)) + ".png");
+    }
+    
+    auto numBatches = *gen::inRange(1, 4);
+    std::atomic<int> callbacks{0};
+    for (int b = 0; b < numBatches; ++b) {
+        auto priority = *gen::element(LoadPriority::Low, LoadPriority::Normal, LoadPriority::High);
+        rm.preloadAsync(paths, [&callbacks](const std::string&, bool) { callbacks++; }, priority);
+    }
+    
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (rm.getPendingLoadCount() > 0 && std::chrono::steady_clock::now() < deadline) {
+        rm.processPendingUploads();
+        std::this_thread::yield();
+    }
+    
+    RC_ASSERT(rm.getPendingLoadCount() == 0u);
+    RC_ASSERT(callbacks.load() == numPaths * numBatches);
+    
+    rm.setLoaderThreadCount(0);
+}
+
+/**
+ * **Feature: killergk-gui-library, Property 12: Resource Caching Consistency**
+ * 
+ * *For any* number of threads queueing async preloads while another thread
+ * resizes the loader pool, every request SHALL still receive exactly one
+ * completion callback.
+ * 
+ * **Validates: Requirements 12.1**
+ */
+RC_GTEST_PROP(ResourceCachingProperties, AsyncPreloadFromManyThreads, ()) {
+    auto& rm = ResourceManager::instance();
+    rm.initialize();
+    rm.clearCache();
+    rm.setLoaderThreadCount(0);
+    
+    auto numThreads = *gen::inRange(2, 6);
+    auto perThread = *gen::inRange(1, 10);
+    auto resizes = *gen::inRange(1, 5);
+    std::atomic<int> callbacks{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; ++t) {
+        threads.emplace_back([&rm, &callbacks, t, perThread]() {
+            for (int i = 0; i < perThread; ++i) {
+                std::string path = "missing_threaded_" + std::to_string(t) + "_" + std::to_string(i) + ".png";
+                rm.preloadAsync({path}, [&callbacks](const std::string&, bool) { callbacks++; });
+            }
+        });
+    }
+    threads.emplace_back([&rm, resizes]() {
+        for (int i = 0; i < resizes; ++i) {
+            rm.setLoaderThreadCount(static_cast<size_t>(i % 3 + 1));
+        }
+    });
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (rm.getPendingLoadCount() > 0 && std::chrono::steady_clock::now() < deadline) {
+        rm.processPendingUploads();
+        std::this_thread::yield();
+    }
+    
+    RC_ASSERT(rm.getPendingLoadCount() == 0u);
+    RC_ASSERT(callbacks.load() == numThreads * perThread);
+    
+    rm.setLoaderThreadCount(0);
+}
+
+// ============================================================================
+// Property Tests for Asset Bundles
+// ============================================================================
+
+/**
+ * **Feature: killergk-gui-library, Property 12: Resource Caching Consistency**
+ * 
+ * *For any* set of entries saved to a bundle, a memory-mapped load of that
+ * bundle SHALL return byte-identical data for every entry, uncompressed
+ * entries SHALL be served without copying, and views SHALL stay valid
+ * after the bundle is edited (which detaches it from the mapping).
+ * 
+ * **Validates: Requirements 12.1**
+ */
+RC_GTEST_PROP(ResourceCachingProperties, MappedBundleRoundTrip, ()) {
+    auto numEntries = *gen::inRange(1, 8);
+    std::vector<std::vector<uint8_t>> payloads;
+    auto bundle = AssetBundle::create();
+    for (int i = 0; i < numEntries; ++i) {
+        auto payload = *gen::container<std::vector<uint8_t>>(gen::inRange<uint8_t>(0, 4));
+        payload.push_back(static_cast<uint8_t>(i));  // Never empty
+        bundle->addData("entry_" + std::to_string(i), payload);
+        payloads.push_back(std::move(payload));
+    }
+    
+    bool compress = *gen::arbitrary<bool>();
+    auto path = (std::filesystem::temp_directory_path() / "kgk_mapped_roundtrip.kgkb").string();
+    RC_ASSERT(bundle->save(path, compress));
+    
+    auto mapped = AssetBundle::loadMapped(path);
+    RC_ASSERT(mapped != nullptr);
+    RC_ASSERT(mapped->getFileCount() == static_cast<size_t>(numEntries));
+    
+    std::vector<BundleData> views;
+    for (int i = 0; i < numEntries; ++i) {
+        std::string name = "entry_" + std::to_string(i);
+        auto view = mapped->getView(name);
+        RC_ASSERT(view.toVector() == payloads[i]);
+        
+        const BundleEntry* entry = mapped->getEntry(name);
+        RC_ASSERT(entry != nullptr);
+        if (!entry->compressed) {
+            RC_ASSERT(view.isZeroCopy());
+        }
+        views.push_back(std::move(view));
+    }
+    
+    RC_ASSERT(mapped->addData("added", {1, 2, 3}));
+    RC_ASSERT(!mapped->isMapped());
+    mapped.reset();
+    for (int i = 0; i < numEntries; ++i) {
+        RC_ASSERT(views[i].toVector() == payloads[i]);
+    }
+    views.clear();
+    std::filesystem::remove(path);
+}
+
+/**
+ * **Feature: killergk-gui-library, Property 12: Resource Caching Consistency**
+ * 
+ * *For any* entry saved with block compression, reading any byte range
+ * SHALL return exactly the corresponding bytes of the original data.
+ * 
+ * **Validates: Requirements 12.1**
+ */
+RC_GTEST_PROP(ResourceCachingProperties, CompressedBundleRangeReads, ()) {
+    // Mix runs and noise so some blocks compress and some are stored raw
+    std::vector<uint8_t> payload;
+    auto segments = *gen::inRange(1, 16);
+    for (int i = 0; i < segments; ++i) {
+        if (*gen::arbitrary<bool>()) {
+            auto run = *gen::inRange<size_t>(1, 3000);
+            payload.insert(payload.end(), run, *gen::arbitrary<uint8_t>());
+        } else {
+            auto noise = *gen::container<std::vector<uint8_t>>(gen::arbitrary<uint8_t>());
+            payload.insert(payload.end(), noise.begin(), noise.end());
+        }
+    }
+    RC_PRE(!payload.empty());
+    
+    auto bundle = AssetBundle::create();
+    bundle->addData("data.bin", payload);
+    
+    auto blockSize = *gen::inRange<size_t>(64, 4096);
+    auto path = (std::filesystem::temp_directory_path() / "kgk_block_ranges.kgkb").string();
+    RC_ASSERT(bundle->save(path, true, blockSize));
+    
+    auto loaded = AssetBundle::load(path);
+    RC_ASSERT(loaded != nullptr);
+    RC_ASSERT(loaded->getData("data.bin") == payload);
+    
+    auto offset = *gen::inRange<size_t>(0, payload.size());
+    auto length = *gen::inRange<size_t>(0, payload.size() + 1);
+    auto range = loaded->getRange("data.bin", offset, length);
+    size_t expected = std::min(length, payload.size() - offset);
+    RC_ASSERT(range.size() == expected);
+    RC_ASSERT(std::equal(range.span().begin(), range.span().end(), payload.begin() + offset));
+    
+    loaded.reset();
+    std::filesystem::remove(path);
+}
+
+/**
+ * **Feature: killergk-gui-library, Property 12: Resource Caching Consistency**
+ * 
+ * *For any* byte sequence, every CRC32 backend supported on this CPU SHALL
+ * produce the same checksum as the table reference, and extending a
+ * checksum with update() SHALL equal checksumming the whole sequence.
+ * 
+ * **Validates: Requirements 12.1**
+ */
+RC_GTEST_PROP(ResourceCachingProperties, CRC32BackendsAgree, ()) {
+    auto data = *gen::container<std::vector<uint8_t>>(gen::arbitrary<uint8_t>());
+    auto padding = *gen::container<std::vector<uint8_t>>(*gen::inRange<size_t>(0, 256),
+                                                         gen::arbitrary<uint8_t>());
+    data.insert(data.end(), padding.begin(), padding.end());
+    
+    uint32_t reference = CRC32::computeWith(CRC32::Backend::Table, data.data(), data.size());
+    RC_ASSERT(CRC32::compute(data.data(), data.size()) == reference);
+    
+    for (auto backend : {CRC32::Backend::Slicing8, CRC32::Backend::PCLMUL, CRC32::Backend::ARMv8}) {
+        RC_ASSERT(CRC32::computeWith(backend, data.data(), data.size()) == reference);
+    }
+    
+    auto split = *gen::inRange<size_t>(0, data.size() + 1);
+    uint32_t head = CRC32::compute(data.data(), split);
+    RC_ASSERT(CRC32::update(head, data.data() + split, data.size() - split) == reference);
+}
+
+/**
+ * Version 1 bundles (whole-entry RLE compression) remain readable.
+ */
+TEST(ResourceCachingTests, LegacyBundleStillLoads) {
+    const std::string name = "legacy.txt";
+    const std::vector<uint8_t> expected = {'A', 'A', 'A', 'A', 'A', 'A', 'A', 'A', 'A', 'A', 'x', 'y', 'z'};
+    const std::vector<uint8_t> rle = {0x80 | 10, 'A', 3, 'x', 'y', 'z'};
+    
+    // Borrow the bundle's own checksum for the expected bytes
+    auto reference = AssetBundle::create();
+    reference->addData(name, expected);
+    uint32_t checksum = reference->getEntry(name)->checksum;
+    
+    BundleHeader header;
+    header.version = 1;
+    header.fileCount = 1;
+    header.flags = static_cast<uint32_t>(BundleFlags::Compressed);
+    uint32_t pathLen = static_cast<uint32_t>(name.size());
+    uint64_t offset = 0;
+    uint64_t size = rle.size();
+    uint64_t originalSize = expected.size();
+    bool compressed = true;
+    header.dataOffset = sizeof(BundleHeader) + sizeof(pathLen) + pathLen + 3 * sizeof(uint64_t) +
+                        sizeof(checksum) + sizeof(compressed);
+    header.totalSize = header.dataOffset + rle.size();
+    
+    auto path = (std::filesystem::temp_directory_path() / "kgk_legacy_v1.kgkb").string();
+    {
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(&pathLen), sizeof(pathLen));
+        file.write(name.data(), pathLen);
+        file.write(reinterpret_cast<const char*>(&offset), sizeof(offset));
+        file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+        file.write(reinterpret_cast<const char*>(&originalSize), sizeof(originalSize));
+        file.write(reinterpret_cast<const char*>(&checksum), sizeof(checksum));
+        file.write(reinterpret_cast<const char*>(&compressed), sizeof(compressed));
+        file.write(reinterpret_cast<const char*>(rle.data()), rle.size());
+    }
+    
+    auto legacy = AssetBundle::loadMapped(path);
+    ASSERT_NE(legacy, nullptr);
+    EXPECT_EQ(legacy->getData(name), expected);
+    EXPECT_EQ(legacy->getRange(name, 9, 3).toVector(), std::vector<uint8_t>({'A', 'x', 'y'}));
+    
+    // Re-saving upgrades the bundle to the current format
+    auto upgradedPath = (std::filesystem::temp_directory_path() / "kgk_legacy_v2.kgkb").string();
+    ASSERT_TRUE(legacy->save(upgradedPath));
+    auto upgraded = AssetBundle::load(upgradedPath);
+    ASSERT_NE(upgraded, nullptr);
+    EXPECT_EQ(upgraded->getData(name), expected);
+    
+    legacy.reset();
+    upgraded.reset();
+    std::filesystem::remove(path);
+    std::filesystem::remove(upgradedPath);
+}
+
+/**
+ * A header claiming more files than its entry table could hold is rejected
+ * without reserving space for them.
+ */
+TEST(ResourceCachingTests, CorruptFileCountIsRejected) {
+    auto bundle = AssetBundle::create();
+    bundle->addData("a.txt", {'a'});
+    auto path = (std::filesystem::temp_directory_path() / "kgk_corrupt_count.kgkb").string();
+    ASSERT_TRUE(bundle->save(path));
+    
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        BundleHeader header;
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        header.fileCount = 0xFFFFFFFFu;
+        file.seekp(0);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+    
+    EXPECT_EQ(AssetBundle::load(path), nullptr);
+    auto mapped = AssetBundle::loadMapped(path);
+    ASSERT_NE(mapped, nullptr);
+    EXPECT_FALSE(mapped->contains("a.txt"));
+    EXPECT_TRUE(mapped->getFileList().empty());
+    
+    mapped.reset();
+    std::filesystem::remove(path);
+}
+
+/**
+ * In FirstAccess mode an entry failing its checksum is checked once; the
+ * failure is remembered rather than re-hashed on every read.
+ */
+TEST(ResourceCachingTests, FailedChecksumIsRemembered) {
+    auto bundle = AssetBundle::create();
+    bundle->addData("a.txt", {'a', 'b', 'c', 'd'});
+    auto path = (std::filesystem::temp_directory_path() / "kgk_bad_checksum.kgkb").string();
+    ASSERT_TRUE(bundle->save(path));
+    
+    {
+        // The entry's bytes end the file
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(-1, std::ios::end);
+        file.put('x');
+    }
+    
+    auto loaded = AssetBundle::load(path);
+    ASSERT_NE(loaded, nullptr);
+    ASSERT_EQ(loaded->getVerification(), BundleVerification::FirstAccess);
+    ASSERT_FALSE(loaded->getEntry("a.txt")->failed);
+    
+    testing::internal::CaptureStderr();
+    loaded->getView("a.txt");
+    loaded->getView("a.txt");
+    loaded->getRange("a.txt", 0, 2);
+    std::string logged = testing::internal::GetCapturedStderr();
+    
+    EXPECT_TRUE(loaded->getEntry("a.txt")->failed);
+    EXPECT_FALSE(loaded->getEntry("a.txt")->verified);
+    size_t warnings = 0;
+    for (size_t at = logged.find("Checksum mismatch"); at != std::string::npos;
+         at = logged.find("Checksum mismatch", at + 1)) {
+        ++warnings;
+    }
+    EXPECT_EQ(warnings, 1u);
+    
+    // An explicit check still runs, and still fails
+    EXPECT_FALSE(loaded->verifyAll());
+    
+    loaded.reset();
+    std::filesystem::remove(path);
+}
+
+// ============================================================================
+// Property Tests for File Watching
+// ============================================================================
+
+/**
+ * **Feature: killergk-gui-library, Property 12: Resource Caching Consistency**
+ * 
+ * *For any* set of files modified under a watched directory, with either
+ * the event backend or sharded polling, the FileWatcher SHALL report each
+ * modified file exactly once and no unmodified file, however many times
+ * each file was written.
+ * 
+ * **Validates: Requirements 12.1**
+ */
+RC_GTEST_PROP(ResourceCachingProperties, FileWatcherReportsEachChangeOnce, ()) {
+    namespace fs = std::filesystem;
+    
+    auto root = fs::temp_directory_path() / "kgk_file_watcher";
+    fs::remove_all(root);
+    fs::create_directories(root / "nested");
+    
+    auto fileCount = *gen::inRange(1, 12);
+    std::vector<std::string> files;
+    for (int i = 0; i < fileCount; ++i) {
+        auto path = root / (i % 2 ? "nested" : "") / ("file_" + std::to_string(i) + ".txt");
+        std::ofstream(path) << "initial";
+        files.push_back(path.string());
+    }
+    
+    FileWatcher watcher;
+    watcher.setForcePolling(*gen::arbitrary<bool>());
+    watcher.setDebounceInterval(std::chrono::milliseconds(0));
+    watcher.setPollInterval(std::chrono::milliseconds(0));
+    watcher.setPollBudget(*gen::inRange<size_t>(1, 8));
+    
+    std::vector<std::string> reported;
+    watcher.watchDirectory(root.string(), [&reported](const std::string& path) {
+        reported.push_back(fs::path(path).lexically_normal().string());
+    });
+    
+    // Let polling record its baseline
+    for (int i = 0; i < 32; ++i) {
+        watcher.update();
+    }
+    RC_ASSERT(reported.empty());
+    
+    std::vector<std::string> modified;
+    for (const auto& file : files) {
+        if (!*gen::arbitrary<bool>()) continue;
+        auto writes = *gen::inRange(1, 4);
+        for (int w = 0; w < writes; ++w) {
+            std::ofstream(file, std::ios::app) << "change " << w;
+        }
+        // Make the change visible to polling even on coarse timestamps
+        fs::last_write_time(file, fs::last_write_time(file) + std::chrono::seconds(5));
+        modified.push_back(fs::path(file).lexically_normal().string());
+    }
+    
+    for (int i = 0; i < 32; ++i) {
+        watcher.update();
+    }
+    
+    std::sort(reported.begin(), reported.end());
+    std::sort(modified.begin(), modified.end());
+    RC_ASSERT(reported == modified);
+    
+    watcher.clearAll();
+    fs::remove_all(root);
+}
+
+/**
+ * A watched directory that is deleted and created again is watched again
+ * by the event backend, so later changes in it are reported.
+ */
+TEST(ResourceCachingTests, FileWatcherRewatchesRecreatedDirectory) {
+    namespace fs = std::filesystem;
+    
+    auto root = fs::temp_directory_path() / "kgk_file_watcher_recreated";
+    fs::remove_all(root);
+    fs::create_directories(root / "nested");
+    
+    FileWatcher watcher;
+    if (!watcher.isEventDriven()) {
+        GTEST_SKIP() << "No event backend on this platform";
+    }
+    watcher.setDebounceInterval(std::chrono::milliseconds(0));
+    watcher.setPollInterval(std::chrono::milliseconds(0));
+    
+    std::vector<std::string> reported;
+    watcher.watchDirectory(root.string(), [&reported](const std::string& path) {
+        reported.push_back(fs::path(path).filename().string());
+    });
+    watcher.update();
+    
+    fs::remove_all(root);
+    watcher.update();
+    fs::create_directories(root);
+    for (int i = 0; i < 4; ++i) {
+        watcher.update();
+    }
+    
+    std::ofstream(root / "after.txt") << "written";
+    for (int i = 0; i < 4; ++i) {
+        watcher.update();
+    }
+    EXPECT_EQ(reported, std::vector<std::string>({"after.txt"}));
+    
+    watcher.clearAll();
+    fs::remove_all(root);
+}